@@ -0,0 +1,491 @@
+/*
+ * Copyright (C) 2026 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+/*
+ * rxpollbench.c
+ *
+ * Host model of the Gem Rx path of the lwIP adapter, see readme.txt.
+ *
+ * A single core receives frames at a fixed rate into a Gem Rx ring and
+ * runs the Rx interrupt handler and the input thread of
+ * xemacpsif_dma.c/xemacpsif.c. The adapter code is not built: each step
+ * is charged an assumed cost (COST_*), so the figures printed are those of
+ * the model, not measurements. Two settings are compared:
+ * - irq:  emac_rx_poll_budget 0, the Rx handler processes the ring
+ * - poll: budgeted polling with interrupts only disabled around the Rx
+ *         ring and receive queue updates of emacps_process_rx_bds()
+ *
+ * What the model checks is the sequencing: no frame is left in the ring
+ * with the Rx interrupt masked, and the polling pass only disables
+ * interrupts for one batch of BDs at a time. As on Gem, a frame completed
+ * while the Rx interrupt is masked does not raise it once unmasked.
+ *
+ * Usage: rxpollbench [-t ms] [-b budget]
+ *
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 1.00  agt  10/17/26 First release
+ *                     Drop the old polling pass, label the output as a
+ *                     model with assumed step costs
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "bench.h"
+
+typedef unsigned int u32_t;
+typedef unsigned long long u64_t;
+
+#define N_RX_DESC		64	/* XLWIP_CONFIG_N_RX_DESC default */
+#define RX_BD_BATCH		16	/* as in xemacpsif_dma.c */
+#define INPUT_BATCH		16	/* XEMACPSIF_INPUT_BATCH */
+#define RECV_Q_SIZE		4096	/* PQ_QUEUE_SIZE, one Rx queue */
+#define FIFO_SIZE		8192	/* >= N_RX_DESC and RECV_Q_SIZE */
+#define DRAIN_FRAMES		40	/* frames per burst, drain test */
+
+/*
+ * Assumed cost of each step in ns. These are not measured; they only set
+ * the relative weight of the steps in the model.
+ */
+#define COST_IRQ		500	/* Rx interrupt entry, status, exit */
+#define COST_WAKE		300	/* input thread wake up */
+#define COST_BD			40	/* FromHwRx and detach, per BD */
+#define COST_FRAME		30	/* pbuf_realloc and stats, per frame */
+#define COST_ENQ		15	/* spsc_enqueue, per frame */
+#define COST_ALLOC		500	/* pbuf_alloc and invalidate, per BD */
+#define COST_ATTACH		60	/* BdRingAlloc, ToHw, BD words */
+#define COST_REARM		80	/* unmask and frame ready check */
+#define COST_INPUT		1200	/* lwIP input of a UDP frame */
+
+enum { MODE_IRQ, MODE_POLL, MODE_COUNT };
+static const char *mode_names[] = { "irq", "poll" };
+
+/* arrival times of the frames in the Rx ring or the receive queue */
+typedef struct {
+	u64_t t[FIFO_SIZE];
+	u32_t head;
+	u32_t len;
+} fifo_t;
+
+/* results of one run */
+typedef struct {
+	u64_t offered;
+	u64_t delivered;
+	u64_t drop_hw;		/* no Rx BD armed */
+	u64_t drop_q;		/* receive queue full */
+	u64_t irqs;
+	u64_t lat_sum;		/* arrival to lwIP input */
+	u64_t off_max;		/* longest stretch with interrupts off */
+	u64_t poll_lat_sum;	/* Rx interrupt to poll pass */
+	u64_t poll_wakeups;
+	int stranded;		/* frames left or Rx interrupt left masked */
+} result_t;
+
+static int mode;
+static u32_t budget = 64;
+static u64_t duration_ms = 20;
+
+static u64_t now;
+static u64_t next_arrival, period, arrival_end;
+static u32_t armed;		/* BDs owned by the hardware */
+static fifo_t ring_fifo;	/* completed BDs not yet taken */
+static fifo_t recv_q;
+static int masked, irq_raised, pending, signalled, in_irq;
+static u32_t irq_off;
+static u64_t off_start, poll_irq_time;
+static result_t res;
+
+static void fifo_push(fifo_t *f, u64_t t)
+{
+	f->t[(f->head + f->len) % FIFO_SIZE] = t;
+	f->len++;
+}
+
+static u64_t fifo_pop(fifo_t *f)
+{
+	u64_t t = f->t[f->head];
+
+	f->head = (f->head + 1) % FIFO_SIZE;
+	f->len--;
+	return t;
+}
+
+static u32_t min_u32(u32_t a, u32_t b)
+{
+	return (a < b) ? a : b;
+}
+
+/* A frame arrives: it takes an armed BD and raises the Rx interrupt */
+static void arrive(void)
+{
+	res.offered++;
+	if (armed == 0) {
+		res.drop_hw++;
+		return;
+	}
+	armed--;
+	fifo_push(&ring_fifo, now);
+	if (!masked) {
+		irq_raised = 1;
+	}
+}
+
+/* Moves the time on by ns, receiving the frames arriving meanwhile */
+static void advance(u64_t ns)
+{
+	u64_t end = now + ns;
+
+	while ((next_arrival <= end) && (next_arrival < arrival_end)) {
+		now = next_arrival;
+		arrive();
+		next_arrival += period;
+	}
+	now = end;
+}
+
+static void take_irq(void);
+
+/* SYS_ARCH_PROTECT(), nests */
+static void protect(void)
+{
+	if (irq_off++ == 0) {
+		off_start = now;
+	}
+}
+
+/* SYS_ARCH_UNPROTECT(), a raised interrupt is taken right away */
+static void unprotect(void)
+{
+	if (--irq_off == 0) {
+		if (now - off_start > res.off_max) {
+			res.off_max = now - off_start;
+		}
+		take_irq();
+	}
+}
+
+/* Runs ns of work, interrupts are taken when it is done if enabled */
+static void work(u64_t ns)
+{
+	advance(ns);
+	if (irq_off == 0) {
+		take_irq();
+	}
+}
+
+/* emacps_process_rx_bds(), at most RX_BD_BATCH BDs per critical section */
+static u32_t process_rx_bds(u32_t limit)
+{
+	u32_t n_processed = 0;
+	u32_t n, k;
+	u64_t t;
+
+	while (n_processed < limit) {
+		protect();
+		n = min_u32(min_u32(limit - n_processed, RX_BD_BATCH),
+				ring_fifo.len);
+		work((u64_t)COST_BD * (n ? n : 1));
+		if (n == 0) {
+			unprotect();
+			break;
+		}
+		unprotect();
+
+		work((u64_t)COST_FRAME * n);
+
+		protect();
+		work((u64_t)COST_ENQ * n);
+		for (k = 0; k < n; k++) {
+			t = fifo_pop(&ring_fifo);
+			if (recv_q.len < RECV_Q_SIZE) {
+				fifo_push(&recv_q, t);
+			} else {
+				res.drop_q++;
+			}
+		}
+		unprotect();
+
+		/* refill, BDs not armed nor completed are free */
+		while (armed + ring_fifo.len < N_RX_DESC) {
+			work(COST_ALLOC);
+			protect();
+			work(COST_ATTACH);
+			armed++;
+			unprotect();
+		}
+		n_processed += n;
+	}
+
+	return n_processed;
+}
+
+/* emacps_rxq_handler() */
+static void rx_handler(void)
+{
+	u64_t tstart = now;
+
+	protect();
+	res.irqs++;
+	work(COST_IRQ);
+	if (mode == MODE_IRQ) {
+		if (process_rx_bds(0xFFFFFFFF) != 0) {
+			signalled = 1;
+		}
+	} else {
+		masked = 1;
+		if (!pending) {
+			pending = 1;
+			poll_irq_time = tstart;
+		}
+		signalled = 1;
+	}
+	unprotect();
+}
+
+static void take_irq(void)
+{
+	if (in_irq) {
+		return;
+	}
+	in_irq = 1;
+	while (irq_raised && (irq_off == 0)) {
+		irq_raised = 0;
+		rx_handler();
+	}
+	in_irq = 0;
+}
+
+static void poll_latency(void)
+{
+	if (poll_irq_time != 0) {
+		res.poll_lat_sum += now - poll_irq_time;
+		res.poll_wakeups++;
+		poll_irq_time = 0;
+	}
+}
+
+/* emacps_rx_poll() */
+static void rx_poll(void)
+{
+	u32_t n;
+	int repoll = 0;
+
+	if (!pending) {
+		return;
+	}
+	poll_latency();
+	n = process_rx_bds(budget);
+	if (n < budget) {
+		protect();
+		work(COST_REARM);
+		masked = 0;
+		if (ring_fifo.len != 0) {
+			masked = 1;
+			repoll = 1;
+		} else {
+			pending = 0;
+		}
+		unprotect();
+	}
+	if (repoll) {
+		signalled = 1;
+	}
+}
+
+/* xemacpsif_input_queue() of the FreeRTOS build */
+static void input(void)
+{
+	u32_t n;
+
+	while (1) {
+		if ((mode == MODE_POLL) && (recv_q.len < INPUT_BATCH)) {
+			rx_poll();
+		}
+		n = min_u32(recv_q.len, INPUT_BATCH);
+		if (n == 0) {
+			return;
+		}
+		while (n--) {
+			res.lat_sum += now - fifo_pop(&recv_q);
+			res.delivered++;
+			work(COST_INPUT);
+		}
+	}
+}
+
+/*
+ * Offers a frame every period_ns until end_ns, then runs until the input
+ * thread has nothing left to do
+ */
+static void run(int run_mode, u64_t period_ns, u64_t end_ns, result_t *r)
+{
+	mode = run_mode;
+	memset(&res, 0, sizeof(res));
+	memset(&ring_fifo, 0, sizeof(ring_fifo));
+	memset(&recv_q, 0, sizeof(recv_q));
+	now = 0;
+	period = period_ns;
+	next_arrival = period;
+	arrival_end = end_ns;
+	armed = N_RX_DESC;
+	masked = irq_raised = pending = signalled = in_irq = 0;
+	irq_off = 0;
+	poll_irq_time = 0;
+
+	while (1) {
+		if (!signalled) {
+			/* idle until the next frame */
+			if (next_arrival >= arrival_end) {
+				break;
+			}
+			advance(next_arrival - now);
+			take_irq();
+			continue;
+		}
+		signalled = 0;
+		work(COST_WAKE);
+		input();
+	}
+
+	res.stranded = (ring_fifo.len != 0) || (recv_q.len != 0) ||
+			masked || pending ||
+			(res.offered != res.delivered + res.drop_hw + res.drop_q);
+	*r = res;
+}
+
+static void print_result(int run_mode, u64_t pps, const result_t *r)
+{
+	printf("%-9s %5llu %9llu %8llu %8llu %8.1f %9.1f %8.2f %8.2f\n",
+			mode_names[run_mode], pps / 1000,
+			(r->delivered * 1000) / duration_ms / 1000,
+			r->drop_hw, r->drop_q,
+			r->offered ? (1000.0 * r->irqs) / r->offered : 0.0,
+			r->delivered ? (r->lat_sum / 1000.0) / r->delivered : 0.0,
+			r->off_max / 1000.0,
+			r->poll_wakeups ? (r->poll_lat_sum / 1000.0) /
+					r->poll_wakeups : 0.0);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "usage: %s [-t ms] [-b budget]\n", prog);
+	exit(2);
+}
+
+int main(int argc, char **argv)
+{
+	static const u64_t loads[] = { 100000, 400000, 800000, 1488000 };
+	result_t r[MODE_COUNT][sizeof(loads) / sizeof(loads[0])];
+	result_t drain;
+	u64_t bound, p;
+	u32_t l;
+	int m, ok;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:b:")) != -1) {
+		switch (opt) {
+		case 't':
+			duration_ms = (u64_t)atoi(optarg);
+			break;
+		case 'b':
+			budget = (u32_t)atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if ((duration_ms == 0) || (budget == 0)) {
+		usage(argv[0]);
+	}
+
+	printf("Model of the Gem Rx path with assumed step costs (COST_*), "
+			"not measurements\n");
+	printf("budget %u, %u Rx BDs, %llu ms simulated per run\n\n", budget,
+			N_RX_DESC, duration_ms);
+	printf("%-9s %5s %9s %8s %8s %8s %9s %8s %8s\n", "mode", "kpps",
+			"out kpps", "drop_hw", "drop_q", "irq/1k", "lat(us)",
+			"off(us)", "poll(us)");
+	for (l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+		for (m = MODE_IRQ; m < MODE_COUNT; m++) {
+			run(m, 1000000000ULL / loads[l],
+					duration_ms * 1000000ULL, &r[m][l]);
+			print_result(m, loads[l], &r[m][l]);
+		}
+	}
+	printf("\n");
+
+	ok = 1;
+	for (l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+		for (m = MODE_IRQ; m < MODE_COUNT; m++) {
+			ok &= !r[m][l].stranded;
+		}
+	}
+	check("no frame left behind, Rx interrupt unmasked at the end", ok);
+
+	/*
+	 * Short bursts at periods a few ns apart, so that the last frame of
+	 * some burst completes while the Rx interrupt is masked and no frame
+	 * follows to raise it
+	 */
+	ok = 1;
+	for (p = 1500; p < 3500; p += 3) {
+		run(MODE_POLL, p, p * DRAIN_FRAMES + 1, &drain);
+		ok &= !drain.stranded;
+	}
+	check("no frame left behind after short bursts", ok);
+
+	/* the longest critical section of the polling pass: a polling Rx
+	 * interrupt or one batch of BDs */
+	bound = COST_IRQ;
+	if ((u64_t)COST_BD * RX_BD_BATCH > bound) {
+		bound = (u64_t)COST_BD * RX_BD_BATCH;
+	}
+	ok = 1;
+	for (l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+		ok &= (r[MODE_POLL][l].off_max <= bound);
+	}
+	check("poll keeps interrupts off for at most one batch", ok);
+
+	l = sizeof(loads) / sizeof(loads[0]) - 1;
+	check("model: poll inputs no fewer frames than irq, overload",
+			r[MODE_POLL][l].delivered >= r[MODE_IRQ][l].delivered);
+	check("model: fewer Rx interrupts with poll than irq, overload",
+			r[MODE_POLL][l].irqs < r[MODE_IRQ][l].irqs);
+
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	return 0;
+}
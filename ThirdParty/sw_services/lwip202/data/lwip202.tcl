@@ -637,6 +637,16 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define PBUF_POOL_SIZE $pbuf_pool_size"
 	puts $lwipopts_fd "\#define PBUF_POOL_BUFSIZE $pbuf_pool_bufsize"
 	puts $lwipopts_fd "\#define PBUF_LINK_HLEN $pbuf_link_hlen"
+	# Gem Rx buffer recycling hands custom pbufs to the stack
+	set emac_rx_pbuf_recycle [common::get_property CONFIG.emac_rx_pbuf_recycle $libhandle]
+	# so does large send, for the per frame header copies
+	set emac_tcp_lso_size [common::get_property CONFIG.emac_tcp_lso_size $libhandle]
+	# Gem Rx queues always refill from their own recycling pools
+	set emac_rx_queues [common::get_property CONFIG.emac_rx_queues $libhandle]
+	if {$emac_rx_pbuf_recycle == true || $emac_tcp_lso_size > 0 ||
+	    $emac_rx_queues > 1} {
+		puts $lwipopts_fd "\#define LWIP_SUPPORT_CUSTOM_PBUF 1"
+	}
 	puts $lwipopts_fd ""
 
 	# ARP options
@@ -710,6 +720,27 @@ proc generate_lwip_opts {libhandle} {
 	puts $lwipopts_fd "\#define TCP_SYNMAXRTX $tcp_synmaxrtx"
 	puts $lwipopts_fd "\#define TCP_QUEUE_OOSEQ $tcp_queue_ooseq"
 	puts $lwipopts_fd "\#define TCP_SND_QUEUELEN   16 * TCP_SND_BUF/TCP_MSS"
+	set tcp_lso_size [common::get_property CONFIG.emac_tcp_lso_size $libhandle]
+	if {$tcp_lso_size > 65535} {
+		error "ERROR: emac_tcp_lso_size must not exceed 65535" "" "mdt_error"
+	}
+	# a large segment is queued whole, each of its frames taking a Tx BD
+	# for the replicated headers and at least one for the payload
+	set n_tx_desc [common::get_property CONFIG.n_tx_descriptors $libhandle]
+	set lso_frames [expr ($tcp_lso_size + $tcp_mss - 1) / $tcp_mss]
+	if {$tcp_lso_size > 0 && [expr 2 * $lso_frames] > $n_tx_desc} {
+		error "ERROR: emac_tcp_lso_size needs [expr 2 * $lso_frames] Tx BDs, more than n_tx_descriptors ($n_tx_desc)" "" "mdt_error"
+	}
+	if {$tcp_lso_size > 0} {
+		puts $lwipopts_fd "\#define LWIP_TCP_LSO 1"
+	}
+
+	# with per netif checksum control the lwIP checksum code stays compiled
+	# in and every adapter turns off the paths its hardware offloads
+	set csum_per_netif 0
+	if {[common::get_property CONFIG.emac_csum_ctrl_per_netif $libhandle] == true} {
+		set csum_per_netif 1
+	}
 
 	set have_ethonzynq 0
 	foreach emac $emac_periphs_list {
@@ -731,9 +762,9 @@ proc generate_lwip_opts {libhandle} {
 				"" "mdt_error"
 			} else {
 				set tx_full_csum [expr ![common::get_property CONFIG.tcp_ip_tx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP $tx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_IP $tx_full_csum"
+				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP [expr $tx_full_csum | $csum_per_netif]"
+				puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP [expr $tx_full_csum | $csum_per_netif]"
+				puts $lwipopts_fd "\#define CHECKSUM_GEN_IP [expr $tx_full_csum | $csum_per_netif]"
 			}
 		}
 		set rx_full_csum_temp [common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]
@@ -743,9 +774,9 @@ proc generate_lwip_opts {libhandle} {
 				"" "mdt_error"
 			} else {
 				set rx_full_csum [expr ![common::get_property CONFIG.tcp_ip_rx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP $rx_full_csum"
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP $rx_full_csum"
+				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP [expr $rx_full_csum | $csum_per_netif]"
+				puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP [expr $rx_full_csum | $csum_per_netif]"
+				puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP [expr $rx_full_csum | $csum_per_netif]"
 			}
 		}
 
@@ -756,7 +787,7 @@ proc generate_lwip_opts {libhandle} {
 				"" "mdt_error"
 			} else {
 				set tx_csum [expr ![common::get_property CONFIG.tcp_tx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP $tx_csum"
+				puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP [expr $tx_csum | $csum_per_netif]"
 			}
 		}
 		set rx_csum_temp [common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]
@@ -766,7 +797,7 @@ proc generate_lwip_opts {libhandle} {
 				"" "mdt_error"
 			} else {
 				set rx_csum [expr ![common::get_property CONFIG.tcp_rx_checksum_offload $libhandle]]
-				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP $rx_csum"
+				puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP [expr $rx_csum | $csum_per_netif]"
 			}
 		}
 
@@ -803,16 +834,19 @@ proc generate_lwip_opts {libhandle} {
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  1"
 			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	1"
 		} else {
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	0"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	0"
-			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  0"
-			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	0"
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_TCP 	$csum_per_netif"
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_UDP 	$csum_per_netif"
+			puts $lwipopts_fd "\#define CHECKSUM_GEN_IP  	$csum_per_netif"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_TCP  $csum_per_netif"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_UDP  $csum_per_netif"
+			puts $lwipopts_fd "\#define CHECKSUM_CHECK_IP 	$csum_per_netif"
 			puts $lwipopts_fd "\#define LWIP_FULL_CSUM_OFFLOAD_RX  1"
 			puts $lwipopts_fd "\#define LWIP_FULL_CSUM_OFFLOAD_TX  1"
 		}
 	}
+	if {$csum_per_netif == 1} {
+		puts $lwipopts_fd "\#define LWIP_CHECKSUM_CTRL_PER_NETIF 1"
+	}
 
 	puts $lwipopts_fd ""
 
@@ -1462,6 +1496,18 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_COALESCE $ncoalesce"
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
+		set rx_budget [common::get_property CONFIG.emac_rx_poll_budget $libhandle]
+		if {$rx_budget > 0} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET $rx_budget"
+		}
+		set lso_size [common::get_property CONFIG.emac_tcp_lso_size $libhandle]
+		if {$lso_size > 0} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_TCP_LSO_SIZE $lso_size"
+		}
+		set rx_stats [common::get_property CONFIG.emac_rx_stats $libhandle]
+		if {$rx_stats == true} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_STATS 1"
+		}
 		puts $fd ""
 	}
 	if {$have_ps_ethernet == 1} {
@@ -1471,6 +1517,31 @@ proc generate_adapterconfig_include {libhandle} {
 		puts $fd "\#define XLWIP_CONFIG_N_TX_DESC $ndesc"
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
+		set rx_budget [common::get_property CONFIG.emac_rx_poll_budget $libhandle]
+		if {$rx_budget > 0} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET $rx_budget"
+		}
+		set lso_size [common::get_property CONFIG.emac_tcp_lso_size $libhandle]
+		if {$lso_size > 0} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_TCP_LSO_SIZE $lso_size"
+		}
+		set rx_recycle [common::get_property CONFIG.emac_rx_pbuf_recycle $libhandle]
+		set rx_queues [common::get_property CONFIG.emac_rx_queues $libhandle]
+		if {$rx_queues < 1 || $rx_queues > 2} {
+			error "ERROR: emac_rx_queues must be 1 or 2" "" "mdt_error"
+		}
+		# with several Rx queues each queue refills from its own pool,
+		# so bulk traffic can not drain the buffers of the others
+		if {$rx_recycle == true || $rx_queues > 1} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE 1"
+		}
+		if {$rx_queues > 1} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_QUEUES $rx_queues"
+		}
+		set rx_stats [common::get_property CONFIG.emac_rx_stats $libhandle]
+		if {$rx_stats == true} {
+			puts $fd "\#define XLWIP_CONFIG_EMAC_RX_STATS 1"
+		}
 		puts $fd ""
 	}
 
@@ -53,6 +53,7 @@ struct xemac_s {
 	enum xemac_types type;
 	int  topology_index;
 	void *state;
+	u32_t offload_caps;	/* XOFFLOAD_* capabilities, see xoffload.h */
 #if !NO_SYS
     sys_sem_t sem_rx_data_available;
 #endif
@@ -65,6 +65,18 @@ extern "C" {
 #define INTC_DIST_BASE_ADDR     XPAR_SCUGIC_0_DIST_BASEADDR
 #endif
 
+/* Max number of packets xaxiemacif_input() takes from a receive queue at once */
+#ifndef XAXIEMACIF_INPUT_BATCH
+#define XAXIEMACIF_INPUT_BATCH	16
+#endif
+
+/* Initial Rx poll budget (AXI DMA only), 0 processes the Rx BDs in the
+ * interrupt handler
+ */
+#ifndef XLWIP_CONFIG_EMAC_RX_POLL_BUDGET
+#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET	0
+#endif
+
 void 	xaxiemacif_setmac(u32_t index, u8_t *addr);
 u8_t*	xaxiemacif_getmac(u32_t index);
 err_t 	xaxiemacif_init(struct netif *netif);
@@ -77,6 +89,19 @@ unsigned phy_setup_axiemac (XAxiEthernet *xaxiemacp);
 /* xaxiemacif_hw.c */
 void 	xaxiemac_error_handler(XAxiEthernet * Temac);
 
+/* Rx path statistics (AXI DMA only), see xaxiemacif_get_rx_stats() */
+typedef struct {
+	u32_t rx_packets;	/* frames passed to lwIP */
+	u64_t rx_bytes;		/* bytes passed to lwIP */
+	u32_t rx_isr_count;	/* Rx handler invocations */
+	u64_t rx_isr_ticks;	/* XTime ticks spent in the Rx handler/poll */
+	u32_t rx_refill_fail;	/* Rx BDs that could not be refilled */
+	u32_t rx_poll_passes;	/* budgeted polling passes */
+	u32_t rx_poll_wakeups;	/* Rx interrupts that started polling */
+	u64_t rx_poll_latency_ticks; /* XTime ticks from Rx interrupt to poll */
+	u64_t rx_lock_max_ticks; /* longest Rx critical section, XTime ticks */
+} xaxiemacif_rx_stats_t;
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
@@ -91,12 +116,27 @@ typedef struct {
 	XAxiEthernet axi_ethernet;
 
 	/* queue to store overflow packets */
-	pq_queue_t *recv_q;
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	/* one receive queue per Rx channel, indexed by ChanId - 1 */
+	spsc_queue_t *recv_q[XMCDMA_MAX_CHAN_PER_DEVICE];
+	u32_t recv_q_next;
+	/* Rx channels are serviced in weighted order by the driver scheduler */
+	XMcdma_Sched rx_sched;
+#else
+	spsc_queue_t *recv_q;
+#endif
 	pq_queue_t *send_q;
 
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
 	void *tx_bdspace;
+
+	/* budgeted Rx polling (AXI DMA only), see axidma_rx_poll() */
+	u32_t rx_poll_budget;
+	volatile u32_t rx_poll_pending;
+	u64_t rx_poll_irq_time;
+
+	xaxiemacif_rx_stats_t rx_stats;
 } xaxiemacif_s;
 
 extern xaxiemacif_s xaxiemacif;
@@ -115,12 +155,24 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring);
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
 XStatus init_axi_mcdma(struct xemac_s *xemac);
 XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
+XStatus axi_mcdma_set_rx_chan_weight(xaxiemacif_s *xaxiemacif, u32 ChanId,
+				     u32 quantum, u32 budget);
 #else
 XStatus init_axi_dma(struct xemac_s *xemac);
 XStatus axidma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
+u32 axidma_rx_poll(struct xemac_s *xemac);
+XStatus axidma_set_rx_coalesce(xaxiemacif_s *xaxiemacif, u32 count, u32 delay);
 #endif
 #endif
 
+/* xaxiemacif.c */
+void xaxiemacif_set_rx_poll_budget(struct netif *netif, u32_t budget);
+XStatus xaxiemacif_set_rx_coalesce(struct netif *netif, u32_t count, u32_t delay);
+XStatus xaxiemacif_set_rx_chan_weight(struct netif *netif, u32_t chan,
+				      u32_t quantum, u32_t budget);
+void xaxiemacif_get_rx_stats(struct netif *netif, xaxiemacif_rx_stats_t *stats);
+void xaxiemacif_reset_rx_stats(struct netif *netif);
+
 #ifdef __cplusplus
 }
 #endif
@@ -85,30 +85,114 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/* Max number of packets xemacpsif_input() takes from the receive queue at once */
+#ifndef XEMACPSIF_INPUT_BATCH
+#define XEMACPSIF_INPUT_BATCH	16
+#endif
+
+/* Initial Rx poll budget, 0 processes the Rx BDs in the interrupt handler */
+#ifndef XLWIP_CONFIG_EMAC_RX_POLL_BUDGET
+#define XLWIP_CONFIG_EMAC_RX_POLL_BUDGET	0
+#endif
+
+/* Number of Gem Rx priority queues used. Queue 1 only exists on the Gem of
+ * Zynq UltraScale+ MPSoC, on Zynq all frames are received on queue 0.
+ */
+#ifndef XLWIP_CONFIG_EMAC_RX_QUEUES
+#define XLWIP_CONFIG_EMAC_RX_QUEUES	1
+#endif
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
 s32_t 	xemacpsif_input(struct netif *netif);
+s32_t	xemacpsif_input_queue(struct netif *netif, u32_t queue);
 
 /* xaxiemacif_hw.c */
 void 	xemacps_error_handler(XEmacPs * Temac);
 
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+/* Rx buffer of the recycle pool. The custom pbuf must be the first member,
+ * the pbuf handed to lwIP is cast back to the buffer when it is freed.
+ */
+typedef struct xemacpsif_rx_buf {
+	struct pbuf_custom pc;
+	struct xemacpsif_rx_buf *next;
+	void *pool;		/* xemacpsif_rx_pool_t the buffer belongs to */
+	u8_t *payload;		/* cache line aligned DMA buffer */
+	u32_t dma_len;		/* bytes written by the DMA in the last frame */
+} xemacpsif_rx_buf_t;
+
+/* Pool of pre-invalidated Rx buffers used to refill the Rx BDs */
+typedef struct {
+	xemacpsif_rx_buf_t *free_list;
+	u32_t free_cnt;
+	u32_t invalidate;	/* buffers need cache maintenance */
+} xemacpsif_rx_pool_t;
+#endif
+
+/* Rx path statistics, see xemacpsif_get_rx_stats() */
+typedef struct {
+	u32_t rx_packets;	/* frames passed to lwIP */
+	u64_t rx_bytes;		/* bytes passed to lwIP */
+	u32_t rx_isr_count;	/* Rx handler invocations */
+	u64_t rx_isr_ticks;	/* XTime ticks spent in the Rx handler/poll */
+	u32_t rx_refill_fail;	/* Rx BDs that could not be refilled */
+	u32_t rx_poll_passes;	/* budgeted polling passes */
+	u32_t rx_poll_wakeups;	/* Rx interrupts that started polling */
+	u64_t rx_poll_latency_ticks; /* XTime ticks from Rx interrupt to poll */
+	u64_t rx_lock_max_ticks; /* longest Rx critical section, XTime ticks */
+} xemacpsif_rx_stats_t;
+
+/* Receive side of one Gem Rx priority queue. Every queue has its own BD
+ * ring, Rx buffers and receive queue, so that it can be serviced by its own
+ * input thread, see xemacpsif_input_queue().
+ */
+typedef struct {
+	XEmacPs_BdRing *rxring;	/* the driver's RxBdRing for queue 0 */
+	XEmacPs_BdRing q_rxring;	/* BD ring of the other queues */
+	void *rx_bdspace;
+	UINTPTR *rx_pbufs;	/* pbuf attached to each Rx BD */
+
+	/* queue to store received packets */
+	spsc_queue_t *recv_q;
+
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+	xemacpsif_rx_pool_t rx_pool;
+#endif
+	xemacpsif_rx_stats_t rx_stats;
+
+	/* budgeted Rx polling, see emacps_rx_poll() */
+	volatile u32_t rx_poll_pending;
+	u64_t rx_poll_irq_time;
+
+	/* queue is serviced by its own thread, see xemacpsif_rxq_dedicate() */
+	u32_t dedicated;
+#if !NO_SYS
+	sys_sem_t sem_rx_data_available;
+#endif
+} xemacpsif_rxq_t;
+
 /* structure within each netif, encapsulating all information required for
  * using a particular temac instance
  */
 typedef struct {
 	XEmacPs emacps;
 
-	/* queue to store overflow packets */
-	pq_queue_t *recv_q;
 	pq_queue_t *send_q;
 
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
-	void *rx_bdspace;
 	void *tx_bdspace;
 
 	unsigned int last_rx_frms_cntr;
 
+	/* Rx priority queues, rxq[0] receives all frames no screener steers
+	 * to another queue */
+	xemacpsif_rxq_t rxq[XLWIP_CONFIG_EMAC_RX_QUEUES];
+	u32_t n_rxq;		/* queues in use, 1 on Zynq */
+
+	u32_t rx_poll_budget;
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
@@ -123,8 +207,10 @@ void detect_phy(XEmacPs *xemacpsp);
 void emacps_send_handler(void *arg);
 XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
 void emacps_recv_handler(void *arg);
+void emacps_recv_q1_handler(void *arg);
+u32_t emacps_rx_poll(struct xemac_s *xemac, xemacpsif_rxq_t *rxq);
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
-void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
+void setup_rx_bds(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq);
 void HandleTxErrors(struct xemac_s *xemac);
 void HandleEmacPsError(struct xemac_s *xemac);
 XEmacPs_Config *xemacps_lookup_config(unsigned mac_base);
@@ -138,6 +224,25 @@ void init_emacps_on_error (xemacpsif_s *xemacps, struct netif *netif);
 void clean_dma_txdescs(struct xemac_s *xemac);
 void resetrx_on_no_rxdata(xemacpsif_s *xemacpsif);
 void reset_dma(struct xemac_s *xemac);
+void init_rx_pool(xemacpsif_s *xemacpsif);
+
+/* xemacpsif.c */
+void xemacpsif_get_rx_stats(struct netif *netif, xemacpsif_rx_stats_t *stats);
+void xemacpsif_reset_rx_stats(struct netif *netif);
+void xemacpsif_set_rx_poll_budget(struct netif *netif, u32_t budget);
+void xemacpsif_get_rxq_stats(struct netif *netif, u32_t queue,
+		xemacpsif_rx_stats_t *stats);
+u32_t xemacpsif_rx_queues(struct netif *netif);
+void xemacpsif_rxq_dedicate(struct netif *netif, u32_t queue);
+#if !NO_SYS
+void xemacpsif_rxq_wait(struct netif *netif, u32_t queue);
+#endif
+err_t xemacpsif_steer_ethertype(struct netif *netif, u8_t index,
+		u16_t ethertype, u32_t queue);
+err_t xemacpsif_steer_udp_port(struct netif *netif, u8_t index,
+		u16_t port, u32_t queue);
+err_t xemacpsif_steer_dstc(struct netif *netif, u8_t index,
+		u8_t dstc, u32_t queue);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2018 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#ifndef __XOFFLOAD_H_
+#define __XOFFLOAD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+
+#include "netif/xadapter.h"
+
+/*
+ * Offload capabilities of an adapter. The checksum bits use the values of
+ * the matching NETIF_CHECKSUM_* flags, so a capability turns off exactly
+ * one lwIP checksum path.
+ */
+#define XOFFLOAD_CSUM_TX_IP	0x0001U
+#define XOFFLOAD_CSUM_TX_UDP	0x0002U
+#define XOFFLOAD_CSUM_TX_TCP	0x0004U
+#define XOFFLOAD_CSUM_RX_IP	0x0100U
+#define XOFFLOAD_CSUM_RX_UDP	0x0200U
+#define XOFFLOAD_CSUM_RX_TCP	0x0400U
+#define XOFFLOAD_CSUM_MASK	0xFFFFU
+/* the adapter splits large TCP segments itself (LWIP_TCP_LSO) */
+#define XOFFLOAD_TCP_LSO	0x10000U
+
+#define XOFFLOAD_CSUM_TX_ALL	(XOFFLOAD_CSUM_TX_IP | XOFFLOAD_CSUM_TX_UDP | \
+				 XOFFLOAD_CSUM_TX_TCP)
+#define XOFFLOAD_CSUM_RX_ALL	(XOFFLOAD_CSUM_RX_IP | XOFFLOAD_CSUM_RX_UDP | \
+				 XOFFLOAD_CSUM_RX_TCP)
+
+/* largest header (ethernet + IPv4 + TCP, with options) replicated per frame */
+#define XOFFLOAD_MAX_HDR_SIZE	(SIZEOF_ETH_HDR + 60 + 60)
+
+void	xoffload_set_caps(struct netif *netif, struct xemac_s *xemac,
+							u32_t caps);
+u32_t	xoffload_get_caps(struct netif *netif);
+err_t	xoffload_lso_output(struct netif *netif, struct pbuf *p,
+			err_t (*xmit)(struct netif *netif, struct pbuf *frame),
+			s32_t (*tx_space)(struct netif *netif));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -47,6 +47,28 @@ int 		pq_enqueue(pq_queue_t *q, void *p);
 void*		pq_dequeue(pq_queue_t *q);
 int		pq_qlength(pq_queue_t *q);
 
+/*
+ * Single producer/single consumer ring used to hand received packets from
+ * the Rx interrupt handler to the lwIP input path. The producer only writes
+ * head and the consumer only writes tail, so neither side has to mask
+ * interrupts. head and tail are free running and live in separate cache
+ * lines; the ring size is a power of two.
+ */
+#define SPSC_CACHE_LINE_SIZE	64
+
+typedef struct {
+	volatile unsigned int head __attribute__ ((aligned (SPSC_CACHE_LINE_SIZE)));
+	volatile unsigned int tail __attribute__ ((aligned (SPSC_CACHE_LINE_SIZE)));
+	unsigned int mask __attribute__ ((aligned (SPSC_CACHE_LINE_SIZE)));
+	void **data;
+} spsc_queue_t;
+
+spsc_queue_t*	spsc_create_queue(int size);
+int		spsc_enqueue(spsc_queue_t *q, void *p);
+void*		spsc_dequeue(spsc_queue_t *q);
+int		spsc_dequeue_bulk(spsc_queue_t *q, void **p, int n);
+int		spsc_qlength(spsc_queue_t *q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,6 +46,7 @@
 #include "netif/xaxiemacif.h"
 #include "netif/xadapter.h"
 #include "netif/xpqueue.h"
+#include "netif/xoffload.h"
 
 #include "xaxiemacif_fifo.h"
 #include "xaxiemacif_hw.h"
@@ -123,6 +124,36 @@ static err_t _unbuffered_low_level_output(xaxiemacif_s *xaxiemacif,
 
 }
 
+#if LWIP_TCP_LSO
+/*
+ * low_level_tx_space():
+ *
+ * Returns the Tx BDs free for the frames of a large segment, after
+ * reclaiming the ones already sent. Large send is only offered with
+ * AXI DMA.
+ *
+ */
+static s32_t low_level_tx_space(struct netif *netif)
+{
+	s32_t freecnt = 0;
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA
+	SYS_ARCH_DECL_PROTECT(lev);
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	if (XAxiEthernet_IsDma(&xaxiemacif->axi_ethernet)) {
+		SYS_ARCH_PROTECT(lev);
+		process_sent_bds(XAxiDma_GetTxRing(&xaxiemacif->axidma));
+		freecnt = is_tx_space_available(xaxiemacif);
+		SYS_ARCH_UNPROTECT(lev);
+	}
+#else
+	(void)netif;
+#endif
+	return freecnt;
+}
+#endif
+
 /*
  * low_level_output():
  *
@@ -139,6 +170,13 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
         struct xemac_s *xemac = (struct xemac_s *)(netif->state);
         xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
 
+#if LWIP_TCP_LSO
+	/* large TCP segments go out as mtu sized frames */
+	if (p->tot_len > netif->mtu + SIZEOF_ETH_HDR)
+		return xoffload_lso_output(netif, p, low_level_output,
+						low_level_tx_space);
+#endif
+
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA
 	/*
 	 * With AXI Ethernet on Zynq, we observed unexplained delays for
@@ -183,23 +221,37 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 /*
  * low_level_input():
  *
- * Should allocate a pbuf and transfer the bytes of the incoming
- * packet from the interface into the pbuf.
+ * Moves up to max packets received by the Rx handler(s) from the receive
+ * queue(s) into pkts. The receive queues are single producer/single
+ * consumer rings, so this does not need to run with interrupts masked.
+ * With MCDMA there is one queue per Rx channel; the channels are served
+ * round robin, one batch at a time.
  *
  */
-static struct pbuf *low_level_input(struct netif *netif)
+static int low_level_input(struct netif *netif, struct pbuf **pkts, int max)
 {
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
-	struct pbuf *p;
-
-	/* see if there is data to process */
-	if (pq_qlength(xaxiemacif->recv_q) == 0)
-		return NULL;
-
-	/* return one packet from receive q */
-	p = (struct pbuf *)pq_dequeue(xaxiemacif->recv_q);
-	return p;
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	u32_t chan_cnt = xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt;
+	u32_t i, chan;
+	int n;
+
+	for (i = 0; i < chan_cnt; i++) {
+		chan = xaxiemacif->recv_q_next;
+		if (++xaxiemacif->recv_q_next >= chan_cnt)
+			xaxiemacif->recv_q_next = 0;
+		if (xaxiemacif->recv_q[chan] == NULL)
+			continue;
+		n = spsc_dequeue_bulk(xaxiemacif->recv_q[chan],
+				(void **)pkts, max);
+		if (n)
+			return n;
+	}
+	return 0;
+#else
+	return spsc_dequeue_bulk(xaxiemacif->recv_q, (void **)pkts, max);
+#endif
 }
 
 /*
@@ -226,65 +278,119 @@ static err_t xaxiemacif_output(struct netif *netif, struct pbuf *p,
  * should handle the actual reception of bytes from the network
  * interface.
  *
- * Returns the number of packets read (max 1 packet on success,
- * 0 if there are no packets)
+ * Packets are taken from the receive queue in batches of up to
+ * XAXIEMACIF_INPUT_BATCH. In budgeted polling mode (AXI DMA) the Rx ring
+ * is polled whenever less than a batch is queued. Returns the number of
+ * packets read (0 if there are no packets)
  *
  */
 
 int xaxiemacif_input(struct netif *netif)
 {
+#if !defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO) && \
+	!defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA)
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+#endif
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
-	SYS_ARCH_DECL_PROTECT(lev);
+	struct pbuf *pkts[XAXIEMACIF_INPUT_BATCH];
+	int n_pkts, i;
+	int n_read = 0;
 
 #if !NO_SYS
 	while (1)
 #endif
 	{
-		/* move received packet into a new pbuf */
-		SYS_ARCH_PROTECT(lev);
-		p = low_level_input(netif);
-		SYS_ARCH_UNPROTECT(lev);
+#if !defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO) && \
+	!defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA)
+		if (spsc_qlength(xaxiemacif->recv_q) < XAXIEMACIF_INPUT_BATCH)
+			axidma_rx_poll(xemac);
+#endif
+		n_pkts = low_level_input(netif, pkts, XAXIEMACIF_INPUT_BATCH);
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL)
-			return 0;
+		if (n_pkts == 0)
+			return n_read;
+		n_read += n_pkts;
+
+		for (i = 0; i < n_pkts; i++) {
+			p = pkts[i];
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
+			/* points to packet payload, which starts with an Ethernet header */
+			ethhdr = p->payload;
 
 #if LINK_STATS
-		lwip_stats.link.recv++;
+			lwip_stats.link.recv++;
 #endif /* LINK_STATS */
 
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
+			switch (htons(ethhdr->type)) {
+				/* IP or ARP packet? */
+				case ETHTYPE_IP:
+				case ETHTYPE_ARP:
 #if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
+				/*IPv6 Packet?*/
+				case ETHTYPE_IPV6:
 #endif
 #if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
+					/* PPPoE packet? */
+				case ETHTYPE_PPPOEDISC:
+				case ETHTYPE_PPPOE:
 #endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xaxiemacif_input: IP input error\r\n"));
+					/* full packet send to tcpip_thread to process */
+					if (netif->input(p, netif) != ERR_OK) {
+						LWIP_DEBUGF(NETIF_DEBUG, ("xaxiemacif_input: IP input error\r\n"));
+						pbuf_free(p);
+						p = NULL;
+					}
+					break;
+
+				default:
 					pbuf_free(p);
 					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
+					break;
+			}
 		}
 	}
-	return 1;
+	return n_read;
+}
+
+/*
+ * The checksum offloads of the core are usable only if the adapter was
+ * built for them: full offload is switched on per Tx BD, partial offload
+ * needs the pseudo header seed in the Tx BD and the Rx checksum verified
+ * by the adapter. Only the DMA and MCDMA paths do that. Large sends are
+ * gathered by the AXI DMA Tx BDs.
+ */
+static u32_t xaxiemacif_offload_caps(xaxiemacif_s *xaxiemacif)
+{
+	XAxiEthernet *axi_ethernet = &xaxiemacif->axi_ethernet;
+	u32_t caps = 0;
+
+	if (XAxiEthernet_IsFifo(axi_ethernet))
+		return 0;
+
+#if LWIP_FULL_CSUM_OFFLOAD_TX==1
+	if (XAxiEthernet_IsTxFullCsum(axi_ethernet))
+		caps |= XOFFLOAD_CSUM_TX_ALL;
+#endif
+#if LWIP_PARTIAL_CSUM_OFFLOAD_TX==1
+	if (XAxiEthernet_IsTxPartialCsum(axi_ethernet))
+		caps |= XOFFLOAD_CSUM_TX_TCP;
+#endif
+#if LWIP_FULL_CSUM_OFFLOAD_RX==1
+	if (XAxiEthernet_IsRxFullCsum(axi_ethernet))
+		caps |= XOFFLOAD_CSUM_RX_ALL;
+#endif
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+	if (XAxiEthernet_IsRxPartialCsum(axi_ethernet))
+		caps |= XOFFLOAD_CSUM_RX_TCP;
+#endif
+#if LWIP_TCP_LSO && defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA)
+	if (XAxiEthernet_IsDma(axi_ethernet))
+		caps |= XOFFLOAD_TCP_LSO;
+#endif
+	return caps;
 }
 
 static err_t low_level_init(struct netif *netif)
@@ -311,9 +417,19 @@ static err_t low_level_init(struct netif *netif)
 	xemac->type = xemac_type_axi_ethernet;
 
 	xaxiemacif->send_q = NULL;
-	xaxiemacif->recv_q = pq_create_queue();
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	/* per channel receive queues are created by init_axi_mcdma() */
+	memset(xaxiemacif->recv_q, 0, sizeof(xaxiemacif->recv_q));
+	xaxiemacif->recv_q_next = 0;
+#else
+	xaxiemacif->recv_q = spsc_create_queue(PQ_QUEUE_SIZE);
 	if (!xaxiemacif->recv_q)
 		return ERR_MEM;
+#endif
+	xaxiemacif->rx_poll_budget = XLWIP_CONFIG_EMAC_RX_POLL_BUDGET;
+	xaxiemacif->rx_poll_pending = 0;
+	xaxiemacif->rx_poll_irq_time = 0;
+	memset(&xaxiemacif->rx_stats, 0, sizeof(xaxiemacif->rx_stats));
 
 	/* maximum transfer unit */
 #ifdef USE_JUMBO_FRAMES
@@ -375,6 +491,7 @@ static err_t low_level_init(struct netif *netif)
 
 	/* initialize the mac */
 	init_axiemac(xaxiemacif, netif);
+	xoffload_set_caps(netif, xemac, xaxiemacif_offload_caps(xaxiemacif));
 
 	/* replace the state in netif (currently the emac baseaddress)
 	 * with the mac instance pointer.
@@ -688,3 +805,99 @@ xaxiemacif_init(struct netif *netif)
 
 	return ERR_OK;
 }
+
+/*
+ * xaxiemacif_set_rx_poll_budget():
+ *
+ * Sets the max number of Rx BDs processed per polling pass. A non zero
+ * budget moves the Rx BD processing out of the interrupt handler into
+ * xaxiemacif_input(); 0 goes back to processing in the interrupt handler.
+ * Only the AXI DMA configuration polls, the budget is ignored otherwise.
+ *
+ */
+
+void xaxiemacif_set_rx_poll_budget(struct netif *netif, u32_t budget)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	xaxiemacif->rx_poll_budget = budget;
+}
+
+/*
+ * xaxiemacif_set_rx_coalesce():
+ *
+ * Updates the AXI DMA Rx interrupt coalescing count (1 - 255) and delay
+ * timer (0 - 255) at run time. Returns XST_FAILURE for other DMA types or
+ * out of range values.
+ *
+ */
+
+XStatus xaxiemacif_set_rx_coalesce(struct netif *netif, u32_t count, u32_t delay)
+{
+#if !defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_FIFO) && \
+	!defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA)
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	return axidma_set_rx_coalesce(xaxiemacif, count, delay);
+#else
+	return XST_FAILURE;
+#endif
+}
+
+/*
+ * xaxiemacif_set_rx_chan_weight():
+ *
+ * Sets the weight of an MCDMA Rx channel (1 based). Each scheduler round the
+ * channel may service up to quantum Rx BDs, and at most budget BDs in one
+ * go, so busy channels can no longer starve the others. Returns XST_FAILURE
+ * for other DMA types.
+ *
+ */
+
+XStatus xaxiemacif_set_rx_chan_weight(struct netif *netif, u32_t chan,
+				      u32_t quantum, u32_t budget)
+{
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+
+	return axi_mcdma_set_rx_chan_weight(xaxiemacif, chan, quantum, budget);
+#else
+	return XST_FAILURE;
+#endif
+}
+
+/*
+ * xaxiemacif_get_rx_stats():
+ *
+ * Returns a snapshot of the Rx path counters of the interface. The
+ * counters are only updated in the AXI DMA configuration, when the library
+ * is built with emac_rx_stats enabled; the ticks are XTime_GetTime() ticks
+ * (COUNTS_PER_SECOND per second), MicroBlaze has no global timer and
+ * leaves them 0.
+ *
+ */
+
+void xaxiemacif_get_rx_stats(struct netif *netif, xaxiemacif_rx_stats_t *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	*stats = xaxiemacif->rx_stats;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+void xaxiemacif_reset_rx_stats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	memset(&xaxiemacif->rx_stats, 0, sizeof(xaxiemacif->rx_stats));
+	SYS_ARCH_UNPROTECT(lev);
+}
@@ -28,6 +28,8 @@
  *
  */
 
+#include <string.h>
+
 #include "lwipopts.h"
 
 #if !NO_SYS
@@ -44,6 +46,7 @@
 #endif
 
 #include "lwip/stats.h"
+#include "lwip/sys.h"
 #include "lwip/inet_chksum.h"
 
 #include "netif/xadapter.h"
@@ -83,6 +86,29 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XAXIDMA_BD_MINIMUM_ALIGNMENT*2)
 
+/* Rx BDs taken from the Rx ring per critical section */
+#define RX_BD_BATCH	16
+
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+#if defined (__MICROBLAZE__)
+/* no global timer, the tick counters of the Rx statistics stay 0 */
+static inline u64_t axidma_rx_time(void)
+{
+	return 0;
+}
+#else
+#include "xtime_l.h"
+
+static inline u64_t axidma_rx_time(void)
+{
+	XTime t;
+
+	XTime_GetTime(&t);
+	return (u64_t)t;
+}
+#endif
+#endif
+
 #if XPAR_INTC_0_HAS_FAST == 1
 /*********** Function Prototypes *********************************************/
 /*
@@ -296,17 +322,35 @@ static void axidma_send_handler(void *arg)
 #endif
 }
 
-static void setup_rx_bds(XAxiDma_BdRing *rxring)
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+/* records the longest Rx critical section, started at tlock */
+static inline void axidma_rx_lock_ticks(xaxiemacif_s *xaxiemacif, u64_t tlock)
+{
+	u64_t tnow = axidma_rx_time();
+
+	if (tnow - tlock > xaxiemacif->rx_stats.rx_lock_max_ticks) {
+		xaxiemacif->rx_stats.rx_lock_max_ticks = tnow - tlock;
+	}
+}
+#endif
+
+/*
+ * Refills the free Rx BDs. The pbufs are allocated, and their payload
+ * invalidated, with interrupts enabled; only attaching a pbuf to a BD is
+ * protected, against the error path of the Rx handler refilling the ring.
+ */
+static void setup_rx_bds(xaxiemacif_s *xaxiemacif, XAxiDma_BdRing *rxring)
 {
 	XAxiDma_Bd *rxbd;
-	s32_t n_bds;
 	XStatus status;
 	struct pbuf *p;
 	u32 bdsts;
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	u64_t tlock;
+#endif
 
-	n_bds = XAxiDma_BdRingGetFreeCnt(rxring);
-	while (n_bds > 0) {
-		n_bds--;
+	while (XAxiDma_BdRingGetFreeCnt(rxring) > 0) {
 #ifdef USE_JUMBO_FRAMES
 		p = pbuf_alloc(PBUF_RAW, XAE_MAX_JUMBO_FRAME_SIZE, PBUF_POOL);
 #else
@@ -316,12 +360,27 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+			xaxiemacif->rx_stats.rx_refill_fail +=
+					XAxiDma_BdRingGetFreeCnt(rxring);
 #endif
 			printf("unable to alloc pbuf in recv_handler\r\n");
 			return;
 		}
+#if defined(__aarch64__)
+		XCACHE_INVALIDATE_DCACHE_RANGE((UINTPTR)p->payload, (UINTPTR)XAE_MAX_FRAME_SIZE);
+#else
+		XCACHE_FLUSH_DCACHE_RANGE(p, sizeof *p);
+#endif
+
+		SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		tlock = axidma_rx_time();
+#endif
 		status = XAxiDma_BdRingAlloc(rxring, 1, &rxbd);
 		if (status != XST_SUCCESS) {
+			SYS_ARCH_UNPROTECT(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
 			pbuf_free(p);
 			return;
@@ -340,16 +399,15 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 #if !defined (__MICROBLAZE__)
 		dsb();
 #endif
-#if defined(__aarch64__)
-		XCACHE_INVALIDATE_DCACHE_RANGE((UINTPTR)p->payload, (UINTPTR)XAE_MAX_FRAME_SIZE);
-#else
-		XCACHE_FLUSH_DCACHE_RANGE(p, sizeof *p);
+#if !defined(__aarch64__)
 		XCACHE_FLUSH_DCACHE_RANGE(rxbd, sizeof *rxbd);
 #endif
 
 		/* Enqueue to HW */
 		status = XAxiDma_BdRingToHw(rxring, 1, rxbd);
 		if (status != XST_SUCCESS) {
+			XAxiDma_BdRingUnAlloc(rxring, 1, rxbd);
+			SYS_ARCH_UNPROTECT(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("Error committing RxBD to hardware: "));
 			if (status == XST_DMA_SG_LIST_ERROR) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("XST_DMA_SG_LIST_ERROR: this function was called out of sequence with XAxiDma_BdRingAlloc()\r\n"));
@@ -358,20 +416,144 @@ static void setup_rx_bds(XAxiDma_BdRing *rxring)
 				LWIP_DEBUGF(NETIF_DEBUG, ("set of BDs was rejected because the first BD did not have its start-of-packet bit set, or the last BD did not have its end-of-packet bit set, or any one of the BD set has 0 as length value\r\n"));
 			}
 			pbuf_free(p);
-			XAxiDma_BdRingUnAlloc(rxring, 1, rxbd);
 			return;
 		}
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		axidma_rx_lock_ticks(xaxiemacif, tlock);
+#endif
+		SYS_ARCH_UNPROTECT(lev);
 	}
 }
 
-static void axidma_recv_handler(void *arg)
+/*
+ * Processes up to budget received BDs: hands the frames to the receive
+ * queue and refills the Rx ring. Returns the number of BDs processed.
+ * Interrupts are only disabled while BDs are taken from the Rx ring, at
+ * most RX_BD_BATCH at a time. The pbufs, and the BD words the checksum
+ * check needs, are detached from the ring before interrupts are enabled
+ * again, as the error path of the Rx handler refills the ring. The frames
+ * are put on the receive queue with interrupts enabled: while a polling
+ * pass is pending the Rx handler leaves the ring to it, so the queue has a
+ * single producer.
+ */
+static u32 axidma_process_rx_bds(xaxiemacif_s *xaxiemacif, u32 budget)
 {
-	struct pbuf *p;
-	u32 irq_status, i, timeOut;
+	struct pbuf *pkts[RX_BD_BATCH];
+	u32 rx_bytes[RX_BD_BATCH];
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+	XAxiDma_Bd rx_bds[RX_BD_BATCH];
+#endif
+	u32 i, n_bds, bd_processed;
+	u32 n_processed = 0;
 	XAxiDma_Bd *rxbd, *rxbdset;
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	u64_t tlock;
+#endif
+
+	while (n_processed < budget) {
+
+		n_bds = budget - n_processed;
+		if (n_bds > RX_BD_BATCH)
+			n_bds = RX_BD_BATCH;
+
+		SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		tlock = axidma_rx_time();
+#endif
+		bd_processed = XAxiDma_BdRingFromHw(rxring, n_bds, &rxbdset);
+		if (bd_processed == 0) {
+			SYS_ARCH_UNPROTECT(lev);
+			break;
+		}
+
+		for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
+			pkts[i] = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
+			rx_bytes[i] = extract_packet_len(rxbd);
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+			memcpy(rx_bds[i], rxbd, sizeof(XAxiDma_Bd));
+#endif
+			rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+		}
+		/* free up the BD's */
+		XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		axidma_rx_lock_ticks(xaxiemacif, tlock);
+#endif
+		SYS_ARCH_UNPROTECT(lev);
+
+		for (i = 0; i < bd_processed; i++) {
+			/* Adjust the buffer size to the actual number of bytes received.*/
+			pbuf_realloc(pkts[i], rx_bytes[i]);
+
+#ifdef USE_JUMBO_FRAMES
+#ifndef __aarch64__
+			XCACHE_INVALIDATE_DCACHE_RANGE(pkts[i]->payload,
+						XAE_MAX_JUMBO_FRAME_SIZE);
+#endif
+#else
+#ifndef __aarch64__
+			XCACHE_INVALIDATE_DCACHE_RANGE(pkts[i]->payload,
+						XAE_MAX_FRAME_SIZE);
+#endif
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+			xaxiemacif->rx_stats.rx_packets++;
+			xaxiemacif->rx_stats.rx_bytes += rx_bytes[i];
+#endif
+
+#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
+			/* Verify for partial checksum offload case */
+			if (!is_checksum_valid(&rx_bds[i], pkts[i])) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
+				/* lwIP does not check an offloaded checksum again */
+#if LINK_STATS
+				lwip_stats.link.chkerr++;
+				lwip_stats.link.drop++;
+#endif
+				pbuf_free(pkts[i]);
+			} else
+#endif
+			/* store it in the receive queue,
+			 * where it'll be processed by a different handler
+			 */
+			if (spsc_enqueue(xaxiemacif->recv_q, (void*)pkts[i]) < 0) {
+#if LINK_STATS
+				lwip_stats.link.memerr++;
+				lwip_stats.link.drop++;
+#endif
+				pbuf_free(pkts[i]);
+			}
+		}
+
+		/* return all the processed bd's back to the stack */
+		setup_rx_bds(xaxiemacif, rxring);
+		n_processed += bd_processed;
+	}
+
+	return n_processed;
+}
+
+/* a received frame is waiting in the Rx ring */
+static inline u32 axidma_rx_frame_ready(XAxiDma_BdRing *rxring)
+{
+	if (rxring->HwCnt == 0)
+		return 0;
+	XAXIDMA_CACHE_INVALIDATE(rxring->HwHead);
+	return (XAxiDma_BdGetSts(rxring->HwHead) &
+					XAXIDMA_BD_STS_COMPLETE_MASK) != 0;
+}
+
+static void axidma_recv_handler(void *arg)
+{
+	u32 irq_status, timeOut;
 	struct xemac_s *xemac;
 	xaxiemacif_s *xaxiemacif;
 	XAxiDma_BdRing *rxring;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	u64_t tstart = axidma_rx_time();
+#endif
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
@@ -391,10 +573,11 @@ static void axidma_recv_handler(void *arg)
 
 	/* If error interrupt is asserted, raise error flag, reset the
 	 * hardware to recover from the error, and return with no further
-	 * processing.
+	 * processing. A pending polling pass keeps the ring and finds the
+	 * BDs completed before the reset.
 	 */
 	if ((irq_status & XAXIDMA_IRQ_ERROR_MASK)) {
-		setup_rx_bds(rxring);
+		setup_rx_bds(xaxiemacif, rxring);
 		xil_printf("%s: Error: axidma error interrupt is asserted\r\n",
 			__FUNCTION__);
 		XAxiDma_Reset(&xaxiemacif->axidma);
@@ -405,73 +588,140 @@ static void axidma_recv_handler(void *arg)
 			}
 			timeOut -= 1;
 		}
-		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
 		XAxiDma_Resume(&xaxiemacif->axidma);
-#ifdef OS_IS_FREERTOS
-		xInsideISR--;
-#endif
-		return;
 	}
 	/* If Reception done interrupt is asserted, call RX call back function
 	 * to handle the processed BDs and then raise the according flag.
 	 */
-	if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
-		u32 bd_processed;
-		u32 rx_bytes;
-
-		bd_processed = XAxiDma_BdRingFromHw(rxring, XAXIDMA_ALL_BDS, &rxbdset);
-
-		for (i = 0, rxbd = rxbdset; i < bd_processed; i++) {
-			p = (struct pbuf *)(UINTPTR)XAxiDma_BdGetId(rxbd);
-			/* Adjust the buffer size to the actual number of bytes received.*/
-			rx_bytes = extract_packet_len(rxbd);
-			pbuf_realloc(p, rx_bytes);
-
-#ifdef USE_JUMBO_FRAMES
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload,
-							XAE_MAX_JUMBO_FRAME_SIZE);
-#endif
-#else
-#ifndef __aarch64__
-			XCACHE_INVALIDATE_DCACHE_RANGE(p->payload, XAE_MAX_FRAME_SIZE);
-#endif
-#endif
-
-#if LWIP_PARTIAL_CSUM_OFFLOAD_RX==1
-			/* Verify for partial checksum offload case */
-			if (!is_checksum_valid(rxbd, p)) {
-				LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
-			}
-#endif
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
+	else if (irq_status & (XAXIDMA_IRQ_DELAY_MASK | XAXIDMA_IRQ_IOC_MASK)) {
+		if ((xaxiemacif->rx_poll_budget != 0) ||
+					xaxiemacif->rx_poll_pending) {
+			/*
+			 * Budgeted polling: keep the completion interrupts
+			 * masked and leave the BD processing to
+			 * axidma_rx_poll(), called from xaxiemacif_input(). A
+			 * pass still pending after polling was turned off also
+			 * owns the ring until it completes.
 			 */
-			if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
-#if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+			if (!xaxiemacif->rx_poll_pending) {
+				xaxiemacif->rx_poll_pending = 1;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+				xaxiemacif->rx_stats.rx_poll_wakeups++;
+				xaxiemacif->rx_poll_irq_time = tstart;
 #endif
-				pbuf_free(p);
 			}
-			rxbd = (XAxiDma_Bd *)XAxiDma_BdRingNext(rxring, rxbd);
+		} else {
+			axidma_process_rx_bds(xaxiemacif, XAXIDMA_ALL_BDS);
 		}
-		/* free up the BD's */
-		XAxiDma_BdRingFree(rxring, bd_processed, rxbdset);
-		/* return all the processed bd's back to the stack */
-		/* setup_rx_bds -> use XAxiDma_BdRingGetFreeCnt */
-		setup_rx_bds(rxring);
 #if !NO_SYS
 		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
 	}
-	XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+	if (xaxiemacif->rx_poll_pending)
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ERROR_MASK);
+	else
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	xaxiemacif->rx_stats.rx_isr_count++;
+	xaxiemacif->rx_stats.rx_isr_ticks += axidma_rx_time() - tstart;
+#endif
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
 
 }
 
+/*
+ * axidma_rx_poll():
+ *
+ * One pass of budgeted polling, called from xaxiemacif_input() after the
+ * Rx handler masked the completion interrupts. Processes up to
+ * rx_poll_budget BDs; when fewer BDs than that were ready the ring is
+ * drained and the completion interrupts are unmasked again. The pass runs
+ * with interrupts enabled, axidma_process_rx_bds() only disables them
+ * while BDs are taken from and given back to the Rx ring.
+ * Returns the number of BDs processed.
+ */
+u32 axidma_rx_poll(struct xemac_s *xemac)
+{
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	u32 budget;
+	u32 n_processed;
+	u32 repoll = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	u64_t tstart;
+#endif
+
+	if (!xaxiemacif->rx_poll_pending)
+		return 0;
+
+	/* polling may have been turned off while a pass was pending */
+	budget = xaxiemacif->rx_poll_budget;
+	if (budget == 0)
+		budget = XLWIP_CONFIG_N_RX_DESC;
+
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	tstart = axidma_rx_time();
+	if (xaxiemacif->rx_poll_irq_time != 0) {
+		xaxiemacif->rx_stats.rx_poll_latency_ticks +=
+				tstart - xaxiemacif->rx_poll_irq_time;
+		xaxiemacif->rx_poll_irq_time = 0;
+	}
+#endif
+	n_processed = axidma_process_rx_bds(xaxiemacif, budget);
+	if (n_processed < budget) {
+		/*
+		 * With coalescing a frame completed while the completion
+		 * interrupts were masked may not raise them once unmasked, so
+		 * the status is cleared, and when a frame is waiting the
+		 * interrupts are masked again and another pass is scheduled.
+		 */
+		SYS_ARCH_PROTECT(lev);
+		XAxiDma_BdRingAckIrq(rxring, XAXIDMA_IRQ_DELAY_MASK |
+						XAXIDMA_IRQ_IOC_MASK);
+		XAxiDma_BdRingIntEnable(rxring, XAXIDMA_IRQ_ALL_MASK);
+		if (axidma_rx_frame_ready(rxring)) {
+			XAxiDma_BdRingIntDisable(rxring, XAXIDMA_IRQ_DELAY_MASK |
+						XAXIDMA_IRQ_IOC_MASK);
+			repoll = 1;
+		} else {
+			xaxiemacif->rx_poll_pending = 0;
+		}
+		SYS_ARCH_UNPROTECT(lev);
+	}
+#if !NO_SYS
+	if (repoll)
+		sys_sem_signal(&xemac->sem_rx_data_available);
+#else
+	(void)repoll;
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	xaxiemacif->rx_stats.rx_poll_passes++;
+	xaxiemacif->rx_stats.rx_isr_ticks += axidma_rx_time() - tstart;
+#endif
+
+	return n_processed;
+}
+
+/*
+ * Updates the Rx interrupt coalescing count and delay timer of the DMA.
+ * See XAxiDma_BdRingSetCoalesce() for the valid ranges.
+ */
+XStatus axidma_set_rx_coalesce(xaxiemacif_s *xaxiemacif, u32 count, u32 delay)
+{
+	XAxiDma_BdRing *rxring = XAxiDma_GetRxRing(&xaxiemacif->axidma);
+	XStatus status;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	status = XAxiDma_BdRingSetCoalesce(rxring, count, delay);
+	SYS_ARCH_UNPROTECT(lev);
+
+	return status;
+}
+
 s32_t is_tx_space_available(xaxiemacif_s *emac)
 {
 	XAxiDma_BdRing *txring;
@@ -127,7 +127,7 @@ xllfifo_recv_handler(struct xemac_s *xemac)
 #endif
 
 		/* store it in the receive queue, where it'll be processed by xemacif input thread */
-		if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
+		if (spsc_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
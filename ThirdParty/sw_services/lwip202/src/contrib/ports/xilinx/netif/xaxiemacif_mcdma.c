@@ -385,7 +385,12 @@ static void axi_mcdma_recv_error_handler(void *CallBackRef, u32 ChanId)
 	return;
 }
 
-static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
+/*
+ * Rx channel service callback of the MCDMA scheduler: moves at most bd_limit
+ * received frames of the channel to its receive queue and returns how many
+ * it moved. Fewer than bd_limit means the channel is drained.
+ */
+static u32 axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId, u32 bd_limit)
 {
 	struct pbuf *p;
 	u32 i, rx_bytes, ProcessedBdCnt;
@@ -401,7 +406,7 @@ static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
 
 	Rx_Chan = XMcdma_GetMcdmaRxChan(McDmaInstPtr, ChanId);
 
-	ProcessedBdCnt = XMcdma_BdChainFromHW(Rx_Chan, XMCDMA_ALL_BDS, &rxbdset);
+	ProcessedBdCnt = XMcdma_BdChainFromHW(Rx_Chan, bd_limit, &rxbdset);
 
 	for (i = 0, rxbd = rxbdset; i < ProcessedBdCnt; i++) {
 
@@ -419,12 +424,18 @@ static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
 		/* Verify for partial checksum offload case */
 		if (!is_checksum_valid(rxbd, p)) {
 			LWIP_DEBUGF(NETIF_DEBUG, ("Incorrect csum as calculated by the hw\r\n"));
-		}
+			/* lwIP does not check an offloaded checksum again */
+#if LINK_STATS
+			lwip_stats.link.chkerr++;
+			lwip_stats.link.drop++;
+#endif
+			pbuf_free(p);
+		} else
 #endif
 		/* store it in the receive queue,
 		 * where it'll be processed by a different handler
 		 */
-		if (pq_enqueue(xaxiemacif->recv_q, (void*)p) < 0) {
+		if (spsc_enqueue(xaxiemacif->recv_q[ChanId - 1], (void*)p) < 0) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
@@ -434,18 +445,21 @@ static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
 		rxbd = (XMcdma_Bd *)XMcdma_BdChainNextBd(Rx_Chan, rxbd);
 	}
 
-	/* free up the BD's */
-	XMcdma_BdChainFree(Rx_Chan, ProcessedBdCnt, rxbdset);
+	if (ProcessedBdCnt) {
+		/* free up the BD's */
+		XMcdma_BdChainFree(Rx_Chan, ProcessedBdCnt, rxbdset);
 
-	/* return all the processed bd's back to the stack */
-	setup_rx_bds(Rx_Chan, Rx_Chan->BdCnt);
+		/* return all the processed bd's back to the stack */
+		setup_rx_bds(Rx_Chan, Rx_Chan->BdCnt);
 #if !NO_SYS
-	sys_sem_signal(&xemac->sem_rx_data_available);
+		sys_sem_signal(&xemac->sem_rx_data_available);
 #endif
+	}
 
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
+	return ProcessedBdCnt;
 }
 
 s32_t is_tx_space_available(xaxiemacif_s *xaxiemacif)
@@ -627,8 +641,8 @@ void axi_mcdma_register_handlers(struct xemac_s *xemac, u8 ChanId)
 
 	XScuGic_RegisterHandler(xtopologyp->scugic_baseaddr,
 			xaxiemacif->axi_ethernet.Config.AxiMcDmaRxIntr[ChanId - 1],
-			(Xil_InterruptHandler)XMcdma_IntrHandler,
-			McDmaInstPtr);
+			(Xil_InterruptHandler)XMcdma_SchedIntrHandler,
+			&xaxiemacif->rx_sched);
 
 	XScuGic_RegisterHandler(xtopologyp->scugic_baseaddr,
 			xaxiemacif->axi_ethernet.Config.AxiMcDmaTxIntr[ChanId - 1],
@@ -672,6 +686,18 @@ XStatus axi_mcdma_setup_rx_chan(struct xemac_s *xemac, u32_t ChanId)
 	/* RX chan configurations */
 	Rx_Chan = XMcdma_GetMcdmaRxChan(&xaxiemacif->aximcdma, ChanId);
 
+	/* Each Rx channel has its own receive queue, the total size of the
+	 * queues is that of a single queue without MCDMA.
+	 */
+	if (!xaxiemacif->recv_q[ChanId - 1]) {
+		xaxiemacif->recv_q[ChanId - 1] = spsc_create_queue(PQ_QUEUE_SIZE /
+			xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt);
+		if (!xaxiemacif->recv_q[ChanId - 1]) {
+			xil_printf("Rx queue create failed for chan %d\r\n", ChanId);
+			return XST_FAILURE;
+		}
+	}
+
 	/* Disable all interrupts */
 	XMcdma_IntrDisable(Rx_Chan, XMCDMA_IRQ_ALL_MASK);
 
@@ -684,9 +710,9 @@ XStatus axi_mcdma_setup_rx_chan(struct xemac_s *xemac, u32_t ChanId)
 
 	xaxiemacif->rx_bdspace += (XLWIP_CONFIG_N_RX_DESC * sizeof(XMcdma_Bd));
 
-	/* Setup Interrupt System and register callbacks */
-	XMcdma_SetCallBack(&xaxiemacif->aximcdma, XMCDMA_HANDLER_DONE,
-			(void *)axi_mcdma_recv_handler, xemac);
+	/* Setup Interrupt System and register callbacks. Rx completions are
+	 * serviced through the channel scheduler set up in init_axi_mcdma().
+	 */
 	XMcdma_SetCallBack(&xaxiemacif->aximcdma, XMCDMA_HANDLER_ERROR,
 			(void *)axi_mcdma_recv_error_handler, xemac);
 
@@ -820,6 +846,20 @@ XStatus init_axi_mcdma(struct xemac_s *xemac)
 		return XST_FAILURE;
 	}
 
+	/* Rx channels are serviced in deficit round robin order, so that a
+	 * busy channel cannot starve the others.
+	 */
+	status = XMcdma_SchedInitialize(&xaxiemacif->rx_sched,
+			&xaxiemacif->aximcdma, XMCDMA_DEV_TO_MEM,
+			xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt);
+	if (status != XST_SUCCESS) {
+		xil_printf("%s@%d: Error: MCDMA Rx scheduler init failed\r\n",
+				__FILE__, __LINE__);
+		return XST_FAILURE;
+	}
+	XMcdma_SchedSetHandler(&xaxiemacif->rx_sched, axi_mcdma_recv_handler,
+			xemac);
+
 	/* Setup Rx/Tx chan and Interrupts */
 	for (ChanId = 1;
 		ChanId <= xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt;
@@ -844,3 +884,11 @@ XStatus init_axi_mcdma(struct xemac_s *xemac)
 	}
 	return XST_SUCCESS;
 }
+
+XStatus axi_mcdma_set_rx_chan_weight(xaxiemacif_s *xaxiemacif, u32 ChanId,
+				     u32 quantum, u32 budget)
+{
+	/* Every Rx BD holds a whole frame, see setup_rx_bds() */
+	return XMcdma_SchedSetWeight(&xaxiemacif->rx_sched, ChanId, quantum,
+				     budget, 1);
+}
@@ -61,6 +61,7 @@
 #include "xstatus.h"
 
 #include "netif/xpqueue.h"
+#include "netif/xoffload.h"
 
 #include "xlwipconfig.h"
 #include "xparameters.h"
@@ -612,6 +613,8 @@ static err_t low_level_init(struct netif *netif)
 	 */
 	xemac->type = xemac_type_xps_emaclite;
 	xemac->state = (void *)xemacliteif;
+	/* emaclite has no offloads, lwIP does all the checksums */
+	xoffload_set_caps(netif, xemac, 0);
 	netif->state = (void *)xemac;
 
 	xemacliteif->instance = xemaclitep;
@@ -46,6 +46,7 @@
 #include "netif/xemacpsif.h"
 #include "netif/xadapter.h"
 #include "netif/xpqueue.h"
+#include "netif/xoffload.h"
 #include "xparameters.h"
 #include "xuartps.h"
 #include "xscugic.h"
@@ -113,6 +114,30 @@ static err_t _unbuffered_low_level_output(xemacpsif_s *xemacpsif,
 
 }
 
+#if LWIP_TCP_LSO
+/*
+ * low_level_tx_space():
+ *
+ * Returns the Tx BDs free for the frames of a large segment, after
+ * reclaiming the ones already sent.
+ *
+ */
+static s32_t low_level_tx_space(struct netif *netif)
+{
+	SYS_ARCH_DECL_PROTECT(lev);
+	s32_t freecnt;
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	SYS_ARCH_PROTECT(lev);
+	process_sent_bds(xemacpsif, &(XEmacPs_GetTxRing(&xemacpsif->emacps)));
+	freecnt = is_tx_space_available(xemacpsif);
+	SYS_ARCH_UNPROTECT(lev);
+
+	return freecnt;
+}
+#endif
+
 /*
  * low_level_output():
  *
@@ -132,6 +157,13 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 
+#if LWIP_TCP_LSO
+	/* large TCP segments go out as mtu sized frames */
+	if (p->tot_len > netif->mtu + SIZEOF_ETH_HDR)
+		return xoffload_lso_output(netif, p, low_level_output,
+						low_level_tx_space);
+#endif
+
 	SYS_ARCH_PROTECT(lev);
 
 	/* check if space is available to send */
@@ -159,23 +191,15 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 /*
  * low_level_input():
  *
- * Should allocate a pbuf and transfer the bytes of the incoming
- * packet from the interface into the pbuf.
+ * Moves up to max packets received by the Rx handler from the receive
+ * queue of an Rx queue into pkts. The receive queue is a single
+ * producer/single consumer ring, so this does not need to run with
+ * interrupts masked.
  *
  */
-static struct pbuf * low_level_input(struct netif *netif)
+static s32_t low_level_input(xemacpsif_rxq_t *rxq, struct pbuf **pkts, s32_t max)
 {
-	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
-	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
-	struct pbuf *p;
-
-	/* see if there is data to process */
-	if (pq_qlength(xemacpsif->recv_q) == 0)
-		return NULL;
-
-	/* return one packet from receive q */
-	p = (struct pbuf *)pq_dequeue(xemacpsif->recv_q);
-	return p;
+	return spsc_dequeue_bulk(rxq->recv_q, (void **)pkts, max);
 }
 
 /*
@@ -198,71 +222,119 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
  * xemacpsif_input():
  *
  * This function should be called when a packet is ready to be read
- * from the interface. It uses the function low_level_input() that
- * should handle the actual reception of bytes from the network
- * interface.
- *
- * Returns the number of packets read (max 1 packet on success,
- * 0 if there are no packets)
+ * from the interface. It services Rx queue 0 and every other Rx queue
+ * that is not serviced by a thread of its own, see
+ * xemacpsif_input_queue(). Returns the number of packets read (0 if
+ * there are no packets)
  *
  */
 
 s32_t xemacpsif_input(struct netif *netif)
 {
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	s32_t n_read;
+	u32_t q;
+
+	n_read = xemacpsif_input_queue(netif, 0);
+	for (q = 1; q < xemacpsif->n_rxq; q++) {
+		if (!xemacpsif->rxq[q].dedicated) {
+			n_read += xemacpsif_input_queue(netif, q);
+		}
+	}
+	return n_read;
+}
+
+/*
+ * xemacpsif_input_queue():
+ *
+ * Hands the packets received on one Rx queue to lwIP. It uses the function
+ * low_level_input() that should handle the actual reception of bytes from
+ * the network interface.
+ *
+ * Packets are taken from the receive queue in batches of up to
+ * XEMACPSIF_INPUT_BATCH. In budgeted polling mode the Rx ring is polled
+ * whenever less than a batch is queued, so frames wait in the ring rather
+ * than in the queue under load.
+ *
+ * Different Rx queues can be serviced concurrently, from threads on
+ * different cores, as long as netif->input is tcpip_input(); with NO_SYS
+ * all the queues must be serviced from the same context. Returns the
+ * number of packets read (0 if there are no packets)
+ *
+ */
+
+s32_t xemacpsif_input_queue(struct netif *netif, u32_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	xemacpsif_rxq_t *rxq;
 	struct eth_hdr *ethhdr;
 	struct pbuf *p;
-	SYS_ARCH_DECL_PROTECT(lev);
+	struct pbuf *pkts[XEMACPSIF_INPUT_BATCH];
+	s32_t n_pkts, i;
+	s32_t n_read = 0;
+
+	if (queue >= xemacpsif->n_rxq) {
+		return 0;
+	}
+	rxq = &xemacpsif->rxq[queue];
 
 #ifdef OS_IS_FREERTOS
 	while (1)
 #endif
 	{
-		/* move received packet into a new pbuf */
-		SYS_ARCH_PROTECT(lev);
-		p = low_level_input(netif);
-		SYS_ARCH_UNPROTECT(lev);
+		if (spsc_qlength(rxq->recv_q) < XEMACPSIF_INPUT_BATCH) {
+			emacps_rx_poll(xemac, rxq);
+		}
+		n_pkts = low_level_input(rxq, pkts, XEMACPSIF_INPUT_BATCH);
 
 		/* no packet could be read, silently ignore this */
-		if (p == NULL) {
-			return 0;
+		if (n_pkts == 0) {
+			return n_read;
 		}
-
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-	#if LINK_STATS
-		lwip_stats.link.recv++;
-	#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-	#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-	#endif
-	#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-	#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+		n_read += n_pkts;
+
+		for (i = 0; i < n_pkts; i++) {
+			p = pkts[i];
+
+			/* points to packet payload, which starts with an Ethernet header */
+			ethhdr = p->payload;
+
+		#if LINK_STATS
+			lwip_stats.link.recv++;
+		#endif /* LINK_STATS */
+
+			switch (htons(ethhdr->type)) {
+				/* IP or ARP packet? */
+				case ETHTYPE_IP:
+				case ETHTYPE_ARP:
+		#if LWIP_IPV6
+				/*IPv6 Packet?*/
+				case ETHTYPE_IPV6:
+		#endif
+		#if PPPOE_SUPPORT
+					/* PPPoE packet? */
+				case ETHTYPE_PPPOEDISC:
+				case ETHTYPE_PPPOE:
+		#endif /* PPPOE_SUPPORT */
+					/* full packet send to tcpip_thread to process */
+					if (netif->input(p, netif) != ERR_OK) {
+						LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+						pbuf_free(p);
+						p = NULL;
+					}
+					break;
+
+				default:
 					pbuf_free(p);
 					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
+					break;
+			}
 		}
 	}
 
-	return 1;
+	return n_read;
 }
 
 
@@ -281,12 +353,33 @@ void vTimerCallback( TimerHandle_t pxTimer )
 }
  #endif
 
+/*
+ * Gem inserts and checks IP, UDP and TCP checksums when the checksum
+ * offload options are set; large sends are split in software and gathered
+ * by the Tx BDs.
+ */
+static u32_t xemacpsif_offload_caps(xemacpsif_s *xemacpsif)
+{
+	u32_t options = XEmacPs_GetOptions(&xemacpsif->emacps);
+	u32_t caps = 0;
+
+	if (options & XEMACPS_TX_CHKSUM_ENABLE_OPTION)
+		caps |= XOFFLOAD_CSUM_TX_ALL;
+	if (options & XEMACPS_RX_CHKSUM_ENABLE_OPTION)
+		caps |= XOFFLOAD_CSUM_RX_ALL;
+#if LWIP_TCP_LSO
+	caps |= XOFFLOAD_TCP_LSO;
+#endif
+	return caps;
+}
+
 static err_t low_level_init(struct netif *netif)
 {
 	UINTPTR mac_address = (UINTPTR)(netif->state);
 	struct xemac_s *xemac;
 	xemacpsif_s *xemacpsif;
 	u32 dmacrreg;
+	u32_t i;
 
 	s32_t status = XST_SUCCESS;
 
@@ -309,9 +402,6 @@ static err_t low_level_init(struct netif *netif)
 	xemac->type = xemac_type_emacps;
 
 	xemacpsif->send_q = NULL;
-	xemacpsif->recv_q = pq_create_queue();
-	if (!xemacpsif->recv_q)
-		return ERR_MEM;
 
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
@@ -351,8 +441,34 @@ static err_t low_level_init(struct netif *netif)
 		xil_printf("In %s:EmacPs Configuration Failed....\r\n", __func__);
 	}
 
+	/* Rx priority queue 1 only exists on Zynq UltraScale+ MPSoC */
+	if (xemacpsif->emacps.Version > 2) {
+		xemacpsif->n_rxq = XLWIP_CONFIG_EMAC_RX_QUEUES;
+	} else {
+		xemacpsif->n_rxq = 1;
+	}
+	/* Each Rx queue has its own receive queue, the total size of the
+	 * queues is that of a single queue, as for AXI MCDMA, so that the
+	 * queues of all the interfaces fit in the shared pool.
+	 */
+	for (i = 0; i < xemacpsif->n_rxq; i++) {
+		memset(&xemacpsif->rxq[i], 0, sizeof(xemacpsif->rxq[i]));
+		xemacpsif->rxq[i].recv_q = spsc_create_queue(PQ_QUEUE_SIZE /
+			xemacpsif->n_rxq);
+		if (!xemacpsif->rxq[i].recv_q)
+			return ERR_MEM;
+#if !NO_SYS
+		sys_sem_new(&xemacpsif->rxq[i].sem_rx_data_available, 0);
+#endif
+	}
+	xemacpsif->rx_poll_budget = XLWIP_CONFIG_EMAC_RX_POLL_BUDGET;
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+	init_rx_pool(xemacpsif);
+#endif
+
 	/* initialize the mac */
 	init_emacps(xemacpsif, netif);
+	xoffload_set_caps(netif, xemac, xemacpsif_offload_caps(xemacpsif));
 
 	dmacrreg = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
 														XEMACPS_DMACR_OFFSET);
@@ -733,3 +849,265 @@ void xemacpsif_resetrx_on_no_rxdata(struct netif *netif)
 
 	resetrx_on_no_rxdata(xemacpsif);
 }
+
+/*
+ * xemacpsif_get_rx_stats():
+ *
+ * Returns a snapshot of the Rx path counters of the interface. The
+ * counters are only updated when the library is built with
+ * emac_rx_stats enabled; rx_isr_ticks is in XTime_GetTime() ticks
+ * (COUNTS_PER_SECOND per second). rx_lock_max_ticks is the max over the
+ * Rx queues.
+ *
+ */
+
+void xemacpsif_get_rx_stats(struct netif *netif, xemacpsif_rx_stats_t *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	xemacpsif_rx_stats_t *qs;
+	u32_t q;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	memset(stats, 0, sizeof(*stats));
+	SYS_ARCH_PROTECT(lev);
+	for (q = 0; q < xemacpsif->n_rxq; q++) {
+		qs = &xemacpsif->rxq[q].rx_stats;
+		stats->rx_packets += qs->rx_packets;
+		stats->rx_bytes += qs->rx_bytes;
+		stats->rx_isr_count += qs->rx_isr_count;
+		stats->rx_isr_ticks += qs->rx_isr_ticks;
+		stats->rx_refill_fail += qs->rx_refill_fail;
+		stats->rx_poll_passes += qs->rx_poll_passes;
+		stats->rx_poll_wakeups += qs->rx_poll_wakeups;
+		stats->rx_poll_latency_ticks += qs->rx_poll_latency_ticks;
+		if (qs->rx_lock_max_ticks > stats->rx_lock_max_ticks) {
+			stats->rx_lock_max_ticks = qs->rx_lock_max_ticks;
+		}
+	}
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/*
+ * xemacpsif_get_rxq_stats():
+ *
+ * As xemacpsif_get_rx_stats(), for a single Rx queue. The counters of a
+ * queue that is not in use read as 0.
+ *
+ */
+
+void xemacpsif_get_rxq_stats(struct netif *netif, u32_t queue,
+		xemacpsif_rx_stats_t *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (queue >= xemacpsif->n_rxq) {
+		memset(stats, 0, sizeof(*stats));
+		return;
+	}
+	SYS_ARCH_PROTECT(lev);
+	*stats = xemacpsif->rxq[queue].rx_stats;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+void xemacpsif_reset_rx_stats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	u32_t q;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	for (q = 0; q < xemacpsif->n_rxq; q++) {
+		memset(&xemacpsif->rxq[q].rx_stats, 0,
+				sizeof(xemacpsif->rxq[q].rx_stats));
+	}
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/*
+ * xemacpsif_set_rx_poll_budget():
+ *
+ * Sets the max number of Rx BDs processed per polling pass. A non zero
+ * budget moves the Rx BD processing out of the interrupt handler into
+ * xemacpsif_input(); 0 goes back to processing in the interrupt handler.
+ *
+ */
+
+void xemacpsif_set_rx_poll_budget(struct netif *netif, u32_t budget)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	xemacpsif->rx_poll_budget = budget;
+}
+
+/*
+ * xemacpsif_rx_queues():
+ *
+ * Returns the number of Rx queues in use, XLWIP_CONFIG_EMAC_RX_QUEUES on
+ * Zynq UltraScale+ MPSoC and 1 on Zynq.
+ *
+ */
+
+u32_t xemacpsif_rx_queues(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	return xemacpsif->n_rxq;
+}
+
+/*
+ * xemacpsif_rxq_dedicate():
+ *
+ * Takes an Rx queue, other than queue 0, out of xemacpsif_input(). The
+ * caller services the queue from then on with xemacpsif_input_queue(),
+ * typically from a thread of its own waiting in xemacpsif_rxq_wait().
+ *
+ */
+
+void xemacpsif_rxq_dedicate(struct netif *netif, u32_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	if ((queue > 0) && (queue < xemacpsif->n_rxq)) {
+		xemacpsif->rxq[queue].dedicated = 1;
+	}
+}
+
+#if !NO_SYS
+/*
+ * xemacpsif_rxq_wait():
+ *
+ * Blocks until packets were received on a dedicated Rx queue.
+ *
+ */
+
+void xemacpsif_rxq_wait(struct netif *netif, u32_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	sys_sem_wait(&xemacpsif->rxq[queue].sem_rx_data_available);
+}
+#endif
+
+#define XEMACPSIF_SCR_ETHTYPE	0
+#define XEMACPSIF_SCR_UDP_PORT	1
+#define XEMACPSIF_SCR_DSTC	2
+
+/*
+ * Programs screener index to steer the frames matching value to an Rx
+ * queue. Screeners can only be programmed with the Gem stopped: wait for
+ * the pending transmissions, stop the Gem, program the screener, and
+ * restart with the DMA pointers reset, as done for the multicast filter
+ * updates.
+ */
+static err_t xemacpsif_set_screener(struct netif *netif, u32_t type,
+		u8_t index, u16_t value, u32_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	XEmacPs *emacps = &xemacpsif->emacps;
+	XEmacPs_BdRing *txring;
+	LONG status;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if (queue >= xemacpsif->n_rxq) {
+		return ERR_ARG;
+	}
+	if (type == XEMACPSIF_SCR_ETHTYPE) {
+		if ((index >= XEMACPS_SCRT2_NUM) ||
+				(index >= XEMACPS_SCRT2_ETHT_NUM)) {
+			return ERR_ARG;
+		}
+	} else if (index >= XEMACPS_SCRT1_NUM) {
+		return ERR_ARG;
+	}
+
+	txring = &(XEmacPs_GetTxRing(emacps));
+
+	/* Wait till all sent packets are acknowledged from HW */
+	while(txring->HwCnt);
+
+	SYS_ARCH_PROTECT(lev);
+
+	XEmacPs_Stop(emacps);
+
+	switch (type) {
+		case XEMACPSIF_SCR_ETHTYPE:
+			status = XEmacPs_SetType2EtherType(emacps, index, value);
+			if (status == XST_SUCCESS) {
+				status = XEmacPs_SetType2Screener(emacps, index,
+						(u8)queue, 0, index, 0,
+						XEMACPS_SCR_ETHT_EN);
+			}
+			break;
+		case XEMACPSIF_SCR_UDP_PORT:
+			status = XEmacPs_SetType1Screener(emacps, index,
+					(u8)queue, 0, value, XEMACPS_SCR_UDP_EN);
+			break;
+		default:
+			status = XEmacPs_SetType1Screener(emacps, index,
+					(u8)queue, (u8)value, 0,
+					XEMACPS_SCR_DSTC_EN);
+			break;
+	}
+
+	reset_dma(xemac);
+	XEmacPs_Start(emacps);
+
+	SYS_ARCH_UNPROTECT(lev);
+
+	return (status == XST_SUCCESS) ? ERR_OK : ERR_IF;
+}
+
+/*
+ * xemacpsif_steer_ethertype():
+ *
+ * Steers the frames of an ethertype, e.g. 0x88F7 for PTP, to an Rx queue,
+ * using type 2 screener and ethertype register index.
+ *
+ */
+
+err_t xemacpsif_steer_ethertype(struct netif *netif, u8_t index,
+		u16_t ethertype, u32_t queue)
+{
+	return xemacpsif_set_screener(netif, XEMACPSIF_SCR_ETHTYPE, index,
+			ethertype, queue);
+}
+
+/*
+ * xemacpsif_steer_udp_port():
+ *
+ * Steers the UDP datagrams for a destination port, e.g. 319 and 320 for
+ * PTP over UDP, to an Rx queue, using type 1 screener index.
+ *
+ */
+
+err_t xemacpsif_steer_udp_port(struct netif *netif, u8_t index,
+		u16_t port, u32_t queue)
+{
+	return xemacpsif_set_screener(netif, XEMACPSIF_SCR_UDP_PORT, index,
+			port, queue);
+}
+
+/*
+ * xemacpsif_steer_dstc():
+ *
+ * Steers the IP packets with a DS (IPv4) or TC (IPv6) field to an Rx
+ * queue, using type 1 screener index. Type 1 screeners are shared with
+ * xemacpsif_steer_udp_port().
+ *
+ */
+
+err_t xemacpsif_steer_dstc(struct netif *netif, u8_t index,
+		u8_t dstc, u32_t queue)
+{
+	return xemacpsif_set_screener(netif, XEMACPSIF_SCR_DSTC, index,
+			dstc, queue);
+}
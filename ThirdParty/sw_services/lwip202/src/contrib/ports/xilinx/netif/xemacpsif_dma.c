@@ -53,6 +53,7 @@
 #include "semphr.h"
 #include "timers.h"
 #endif
+#include "xtime_l.h"
 
 
 #define INTC_BASE_ADDR		XPAR_SCUGIC_0_CPU_BASEADDR
@@ -61,12 +62,64 @@
 /* Byte alignment of BDs */
 #define BD_ALIGNMENT (XEMACPS_DMABD_MINIMUM_ALIGNMENT*2)
 
+/* Every Rx queue refills from its own pool, see lwip202.tcl */
+#if (XLWIP_CONFIG_EMAC_RX_QUEUES > 1) && !defined(XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE)
+#error "Several Gem Rx queues require XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE"
+#endif
+
+/* Rx BDs of all the Rx queues of one interface */
+#define N_RX_PBUFS_PER_EMAC	(XLWIP_CONFIG_EMAC_RX_QUEUES * XLWIP_CONFIG_N_RX_DESC)
+
 /* A max of 4 different ethernet interfaces are supported */
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
-static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+static UINTPTR rx_pbufs_storage[4*N_RX_PBUFS_PER_EMAC];
 
 static s32_t emac_intr_num;
 
+#ifdef ZYNQMP_USE_JUMBO
+#define RX_FRAME_SIZE	MAX_FRAME_SIZE_JUMBO
+#else
+#define RX_FRAME_SIZE	XEMACPS_MAX_FRAME_SIZE
+#endif
+
+/* Rx BDs taken from the Rx ring per critical section */
+#define RX_BD_BATCH	16
+
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+/******************************************************************************
+ * Rx buffer recycling.
+ *
+ * Instead of allocating a PBUF_POOL pbuf and invalidating a full frame for
+ * every Rx BD refill, the Rx BDs are refilled from a per-interface pool of
+ * cache line aligned buffers. The buffers are handed to lwIP as custom
+ * PBUF_REF pbufs; when lwIP frees them they go back on the free list of the
+ * pool. The pool is invalidated once at start up and, on refill, a buffer
+ * is only invalidated over the part the CPU may have pulled into the cache
+ * while processing the previous frame. When the pool runs dry (lwIP holding
+ * on to many received frames) the refill falls back to PBUF_POOL.
+ * Each Rx queue has its own pool, so a queue whose frames are held by a
+ * slow consumer does not starve the other queues.
+ *********************************************************************************/
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "Rx pbuf recycling requires LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+#ifndef XEMACPSIF_RX_POOL_SIZE
+#define XEMACPSIF_RX_POOL_SIZE	(2 * XLWIP_CONFIG_N_RX_DESC)
+#endif
+
+#define RX_BUF_ALIGNMENT	64
+#define RX_BUF_ROUNDUP(len)	(((len) + RX_BUF_ALIGNMENT - 1) & \
+					~(RX_BUF_ALIGNMENT - 1))
+#define RX_BUF_SIZE		RX_BUF_ROUNDUP(RX_FRAME_SIZE)
+
+#define N_RX_POOLS	(XPAR_XEMACPS_NUM_INSTANCES * XLWIP_CONFIG_EMAC_RX_QUEUES)
+
+static xemacpsif_rx_buf_t rx_pool_bufs[N_RX_POOLS * XEMACPSIF_RX_POOL_SIZE];
+static u8_t rx_pool_space[N_RX_POOLS * XEMACPSIF_RX_POOL_SIZE][RX_BUF_SIZE]
+				__attribute__ ((aligned (RX_BUF_ALIGNMENT)));
+#endif
+
 /******************************************************************************
  * Each BD is of 8 bytes of size and the BDs (BD chain) need to be  put
  * at uncached memory location. If they are not put at uncached
@@ -175,22 +228,129 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 #endif
 #ifdef XPAR_XEMACPS_1_BASEADDR
 	if (xemacpsif->emacps.Config.BaseAddress == XPAR_XEMACPS_1_BASEADDR) {
-		index = XLWIP_CONFIG_N_RX_DESC;
+		index = N_RX_PBUFS_PER_EMAC;
 	}
 #endif
 #ifdef XPAR_XEMACPS_2_BASEADDR
 	if (xemacpsif->emacps.Config.BaseAddress == XPAR_XEMACPS_2_BASEADDR) {
-		index = 2 * XLWIP_CONFIG_N_RX_DESC;
+		index = 2 * N_RX_PBUFS_PER_EMAC;
 	}
 #endif
 #ifdef XPAR_XEMACPS_3_BASEADDR
 	if (xemacpsif->emacps.Config.BaseAddress == XPAR_XEMACPS_3_BASEADDR) {
-		index = 3 * XLWIP_CONFIG_N_RX_DESC;
+		index = 3 * N_RX_PBUFS_PER_EMAC;
 	}
 #endif
 	return index;
 }
 
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+static void rx_pool_free_custom(struct pbuf *p)
+{
+	xemacpsif_rx_buf_t *buf = (xemacpsif_rx_buf_t *)p;
+	xemacpsif_rx_pool_t *pool = (xemacpsif_rx_pool_t *)buf->pool;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	buf->next = pool->free_list;
+	pool->free_list = buf;
+	pool->free_cnt++;
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+static void init_rxq_pool(xemacpsif_s *xemacpsif, u32_t queue)
+{
+	xemacpsif_rx_pool_t *pool = &xemacpsif->rxq[queue].rx_pool;
+	xemacpsif_rx_buf_t *buf;
+	u32_t base;
+	u32_t i;
+
+	base = ((xemacpsif->emacps.Config.DeviceId * XLWIP_CONFIG_EMAC_RX_QUEUES)
+			+ queue) * XEMACPSIF_RX_POOL_SIZE;
+
+	pool->free_list = NULL;
+	pool->free_cnt = 0;
+	pool->invalidate = (xemacpsif->emacps.Config.IsCacheCoherent == 0);
+
+	for (i = 0; i < XEMACPSIF_RX_POOL_SIZE; i++) {
+		buf = &rx_pool_bufs[base + i];
+		buf->pc.custom_free_function = rx_pool_free_custom;
+		buf->pool = pool;
+		buf->payload = rx_pool_space[base + i];
+		buf->dma_len = 0;
+		buf->next = pool->free_list;
+		pool->free_list = buf;
+		pool->free_cnt++;
+	}
+
+	if (pool->invalidate) {
+		Xil_DCacheInvalidateRange((UINTPTR)rx_pool_space[base],
+				(UINTPTR)(XEMACPSIF_RX_POOL_SIZE * RX_BUF_SIZE));
+	}
+}
+
+/*
+ * init_rx_pool():
+ *
+ * Builds the free lists of Rx buffers for the Rx queues of this interface
+ * and invalidates them once. Must be called once, before init_dma().
+ */
+void init_rx_pool(xemacpsif_s *xemacpsif)
+{
+	u32_t q;
+
+	for (q = 0; q < xemacpsif->n_rxq; q++) {
+		init_rxq_pool(xemacpsif, q);
+	}
+}
+#endif
+
+/*
+ * Returns a pbuf whose payload can be handed to an Rx BD, with the
+ * payload already invalidated when the GEM is not cache coherent.
+ */
+static struct pbuf *alloc_rx_pbuf(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq)
+{
+	struct pbuf *p;
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+	xemacpsif_rx_pool_t *pool = &rxq->rx_pool;
+	xemacpsif_rx_buf_t *buf;
+	u32_t len;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	buf = pool->free_list;
+	if (buf != NULL) {
+		pool->free_list = buf->next;
+		pool->free_cnt--;
+	}
+	SYS_ARCH_UNPROTECT(lev);
+
+	if (buf != NULL) {
+		/*
+		 * Only the lines covering the previous frame can be in the
+		 * cache. One extra line is dropped to cover a prefetch past
+		 * the end of the frame.
+		 */
+		if (pool->invalidate && (buf->dma_len != 0)) {
+			len = RX_BUF_ROUNDUP(buf->dma_len) + RX_BUF_ALIGNMENT;
+			if (len > RX_BUF_SIZE) {
+				len = RX_BUF_SIZE;
+			}
+			Xil_DCacheInvalidateRange((UINTPTR)buf->payload, (UINTPTR)len);
+		}
+		buf->dma_len = 0;
+		return pbuf_alloced_custom(PBUF_RAW, RX_FRAME_SIZE, PBUF_REF,
+				&buf->pc, buf->payload, RX_BUF_SIZE);
+	}
+#endif
+	p = pbuf_alloc(PBUF_RAW, RX_FRAME_SIZE, PBUF_POOL);
+	if ((p != NULL) && (xemacpsif->emacps.Config.IsCacheCoherent == 0)) {
+		Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)RX_FRAME_SIZE);
+	}
+	return p;
+}
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -365,42 +525,65 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 	return status;
 }
 
-void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+/* records the longest Rx critical section, started at tlock */
+static inline void rxq_lock_ticks(xemacpsif_rxq_t *rxq, XTime tlock)
 {
+	XTime tnow;
+
+	XTime_GetTime(&tnow);
+	if ((u64_t)(tnow - tlock) > rxq->rx_stats.rx_lock_max_ticks) {
+		rxq->rx_stats.rx_lock_max_ticks = (u64_t)(tnow - tlock);
+	}
+}
+#endif
+
+/*
+ * Refills the free BDs of an Rx queue. The pbufs are allocated, and their
+ * payload invalidated, with interrupts enabled; only attaching a pbuf to a
+ * BD is protected, against the error handler resetting the Rx ring.
+ */
+void setup_rx_bds(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq)
+{
+	XEmacPs_BdRing *rxring = rxq->rxring;
 	XEmacPs_Bd *rxbd;
 	XStatus status;
 	struct pbuf *p;
-	u32_t freebds;
 	u32_t bdindex;
 	u32 *temp;
-	u32_t index;
-
-	index = get_base_index_rxpbufsstorage (xemacpsif);
-
-	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
-	while (freebds > 0) {
-		freebds--;
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
-#else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime tlock;
 #endif
+
+	while (XEmacPs_BdRingGetFreeCnt(rxring) > 0) {
+		p = alloc_rx_pbuf(xemacpsif, rxq);
 		if (!p) {
 #if LINK_STATS
 			lwip_stats.link.memerr++;
 			lwip_stats.link.drop++;
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+			rxq->rx_stats.rx_refill_fail += XEmacPs_BdRingGetFreeCnt(rxring);
 #endif
 			printf("unable to alloc pbuf in recv_handler\r\n");
 			return;
 		}
+		SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		XTime_GetTime(&tlock);
+#endif
 		status = XEmacPs_BdRingAlloc(rxring, 1, &rxbd);
 		if (status != XST_SUCCESS) {
+			SYS_ARCH_UNPROTECT(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("setup_rx_bds: Error allocating RxBD\r\n"));
 			pbuf_free(p);
 			return;
 		}
 		status = XEmacPs_BdRingToHw(rxring, 1, rxbd);
 		if (status != XST_SUCCESS) {
+			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
+			SYS_ARCH_UNPROTECT(lev);
 			LWIP_DEBUGF(NETIF_DEBUG, ("Error committing RxBD to hardware: "));
 			if (status == XST_DMA_SG_LIST_ERROR) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("XST_DMA_SG_LIST_ERROR: this function was called out of sequence with XEmacPs_BdRingAlloc()\r\n"));
@@ -410,18 +593,8 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 			}
 
 			pbuf_free(p);
-			XEmacPs_BdRingUnAlloc(rxring, 1, rxbd);
 			return;
 		}
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
 		bdindex = XEMACPS_BD_TO_INDEX(rxring, rxbd);
 		temp = (u32 *)rxbd;
 		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
@@ -434,92 +607,345 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 		dsb();
 
 		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+		rxq->rx_pbufs[bdindex] = (UINTPTR)p;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		rxq_lock_ticks(rxq, tlock);
+#endif
+		SYS_ARCH_UNPROTECT(lev);
 	}
 }
 
-void emacps_recv_handler(void *arg)
+/*
+ * Processes up to budget received BDs of an Rx queue: hands the frames to
+ * the receive queue of the Rx queue and refills its Rx ring. Returns the
+ * number of BDs processed.
+ * Interrupts are only disabled while BDs are taken from the Rx ring and
+ * while frames are put on the receive queue, at most RX_BD_BATCH BDs at a
+ * time. The pbufs are detached from the ring before interrupts are enabled
+ * again, so that an error handler resetting the ring does not free them.
+ */
+static u32_t emacps_process_rx_bds(xemacpsif_s *xemacpsif,
+		xemacpsif_rxq_t *rxq, u32_t budget)
 {
-	struct pbuf *p;
+	struct pbuf *pkts[RX_BD_BATCH];
+	s32_t rx_bytes[RX_BD_BATCH];
 	XEmacPs_Bd *rxbdset, *curbdptr;
-	struct xemac_s *xemac;
-	xemacpsif_s *xemacpsif;
-	XEmacPs_BdRing *rxring;
+	XEmacPs_BdRing *rxring = rxq->rxring;
 	volatile s32_t bd_processed;
-	s32_t rx_bytes, k;
+	s32_t k;
 	u32_t bdindex;
-	u32_t regval;
-	u32_t index;
-	u32_t gigeversion;
-
-	xemac = (struct xemac_s *)(arg);
-	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
-
-#ifdef OS_IS_FREERTOS
-	xInsideISR++;
+	u32_t n_bds;
+	u32_t n_processed = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime tlock;
 #endif
 
-	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
-	/*
-	 * If Reception done interrupt is asserted, call RX call back function
-	 * to handle the processed BDs and then raise the according flag.
-	 */
-	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
-	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
-	if (gigeversion <= 2) {
-			resetrx_on_no_rxdata(xemacpsif);
-	}
+	while (n_processed < budget) {
 
-	while(1) {
+		n_bds = budget - n_processed;
+		if (n_bds > RX_BD_BATCH) {
+			n_bds = RX_BD_BATCH;
+		}
 
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
+		SYS_ARCH_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		XTime_GetTime(&tlock);
+#endif
+		bd_processed = XEmacPs_BdRingFromHwRx(rxring, n_bds, &rxbdset);
 		if (bd_processed <= 0) {
+			SYS_ARCH_UNPROTECT(lev);
 			break;
 		}
 
 		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
 
 			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+			pkts[k] = (struct pbuf *)rxq->rx_pbufs[bdindex];
+			rxq->rx_pbufs[bdindex] = 0;
+#ifdef ZYNQMP_USE_JUMBO
+			rx_bytes[k] = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
+#else
+			rx_bytes[k] = XEmacPs_BdGetLength(curbdptr);
+#endif
+			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+		}
+		/* free up the BD's */
+		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+		rxq_lock_ticks(rxq, tlock);
+#endif
+		SYS_ARCH_UNPROTECT(lev);
 
+		for (k = 0; k < bd_processed; k++) {
 			/*
 			 * Adjust the buffer size to the actual number of bytes received.
 			 */
-#ifdef ZYNQMP_USE_JUMBO
-			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
-#else
-			rx_bytes = XEmacPs_BdGetLength(curbdptr);
+			pbuf_realloc(pkts[k], rx_bytes[k]);
+#ifdef XLWIP_CONFIG_EMAC_RX_PBUF_RECYCLE
+			if (pkts[k]->flags & PBUF_FLAG_IS_CUSTOM) {
+				((xemacpsif_rx_buf_t *)pkts[k])->dma_len = rx_bytes[k];
+			}
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+			rxq->rx_stats.rx_packets++;
+			rxq->rx_stats.rx_bytes += rx_bytes[k];
 #endif
-			pbuf_realloc(p, rx_bytes);
+		}
 
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+		/* store them in the receive queue,
+		 * where they'll be processed by a different handler
+		 */
+		SYS_ARCH_PROTECT(lev);
+		for (k = 0; k < bd_processed; k++) {
+			if (spsc_enqueue(rxq->recv_q, (void*)pkts[k]) < 0) {
 #if LINK_STATS
 				lwip_stats.link.memerr++;
 				lwip_stats.link.drop++;
 #endif
-				pbuf_free(p);
+				pbuf_free(pkts[k]);
 			}
-			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
 		}
-		/* free up the BD's */
-		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
-		setup_rx_bds(xemacpsif, rxring);
+		SYS_ARCH_UNPROTECT(lev);
+
+		setup_rx_bds(xemacpsif, rxq);
+		n_processed += bd_processed;
+	}
+
+	return n_processed;
+}
+
+/* a received frame is waiting in the Rx ring of an Rx queue */
+static inline u32_t rxq_frame_ready(xemacpsif_rxq_t *rxq)
+{
+	XEmacPs_BdRing *rxring = rxq->rxring;
+
+	return (rxring->HwCnt != 0) && (XEmacPs_BdIsRxNew(rxring->HwHead) != 0);
+}
+
+/* Rx interrupt of an Rx queue, queue 0 signals through the Rx status
+ * register, queue 1 through the interrupt Q1 status register */
+static inline void rxq_intr_disable(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq)
+{
+	if (rxq == &xemacpsif->rxq[0]) {
+		XEmacPs_IntDisable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	} else {
+		XEmacPs_IntQ1Disable(&xemacpsif->emacps, XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+
+static inline void rxq_intr_enable(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq)
+{
+	if (rxq == &xemacpsif->rxq[0]) {
+		XEmacPs_IntEnable(&xemacpsif->emacps, XEMACPS_IXR_FRAMERX_MASK);
+	} else {
+		XEmacPs_IntQ1Enable(&xemacpsif->emacps, XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
+}
+
 #if !NO_SYS
+/* wakes up the thread servicing the Rx queue */
+static inline void rxq_signal(struct xemac_s *xemac, xemacpsif_rxq_t *rxq)
+{
+	if (rxq->dedicated) {
+		sys_sem_signal(&rxq->sem_rx_data_available);
+	} else {
 		sys_sem_signal(&xemac->sem_rx_data_available);
+	}
+}
+#endif
+
+/*
+ * Rx interrupt handling common to all the Rx queues: either hands the
+ * received frames to the receive queue or, in budgeted polling mode, masks
+ * the Rx interrupt of the queue and leaves that to emacps_rx_poll().
+ */
+static void emacps_rxq_handler(struct xemac_s *xemac, xemacpsif_rxq_t *rxq,
+		u64_t tstart)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	if ((xemacpsif->rx_poll_budget != 0) || rxq->rx_poll_pending) {
+		/*
+		 * Budgeted polling: mask further Rx interrupts and leave the
+		 * BD processing to emacps_rx_poll(), called from
+		 * xemacpsif_input_queue(). A pass still pending after polling
+		 * was turned off also owns the ring until it completes.
+		 */
+		rxq_intr_disable(xemacpsif, rxq);
+		if (!rxq->rx_poll_pending) {
+			rxq->rx_poll_pending = 1;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+			rxq->rx_poll_irq_time = tstart;
+#endif
+		}
+#if !NO_SYS
+		rxq_signal(xemac, rxq);
+#endif
+	} else if (emacps_process_rx_bds(xemacpsif, rxq, 0xFFFFFFFF) != 0) {
+#if !NO_SYS
+		rxq_signal(xemac, rxq);
 #endif
 	}
+}
+
+void emacps_recv_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	u32_t regval;
+	u32_t gigeversion;
+	XTime tstart = 0;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime tend;
+
+	XTime_GetTime(&tstart);
+#endif
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
 
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+
+	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+	/*
+	 * If Reception done interrupt is asserted, call RX call back function
+	 * to handle the processed BDs and then raise the according flag.
+	 */
+	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET);
+	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_RXSR_OFFSET, regval);
+	if (gigeversion <= 2) {
+			resetrx_on_no_rxdata(xemacpsif);
+	}
+
+	emacps_rxq_handler(xemac, &xemacpsif->rxq[0], tstart);
+
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime_GetTime(&tend);
+	xemacpsif->rxq[0].rx_stats.rx_isr_count++;
+	xemacpsif->rxq[0].rx_stats.rx_isr_ticks += (u64_t)(tend - tstart);
+#endif
 #ifdef OS_IS_FREERTOS
 	xInsideISR--;
 #endif
 	return;
 }
 
+#if XLWIP_CONFIG_EMAC_RX_QUEUES > 1
+/*
+ * Rx handler of Gem priority queue 1, the driver has already cleared the
+ * interrupt Q1 status. Also called when queue 1 ran out of Rx BDs, which
+ * refills the ring.
+ */
+void emacps_recv_q1_handler(void *arg)
+{
+	struct xemac_s *xemac;
+	xemacpsif_s *xemacpsif;
+	XTime tstart = 0;
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime tend;
+
+	XTime_GetTime(&tstart);
+#endif
+
+	xemac = (struct xemac_s *)(arg);
+	xemacpsif = (xemacpsif_s *)(xemac->state);
+
+#ifdef OS_IS_FREERTOS
+	xInsideISR++;
+#endif
+
+	emacps_rxq_handler(xemac, &xemacpsif->rxq[1], tstart);
+	/* no frame may have been taken when the ring ran out of BDs */
+	setup_rx_bds(xemacpsif, &xemacpsif->rxq[1]);
+
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime_GetTime(&tend);
+	xemacpsif->rxq[1].rx_stats.rx_isr_count++;
+	xemacpsif->rxq[1].rx_stats.rx_isr_ticks += (u64_t)(tend - tstart);
+#endif
+#ifdef OS_IS_FREERTOS
+	xInsideISR--;
+#endif
+}
+#endif
+
+/*
+ * emacps_rx_poll():
+ *
+ * One pass of budgeted polling of an Rx queue, called from
+ * xemacpsif_input_queue() after the Rx handler masked the Rx interrupt of
+ * the queue. Processes up to rx_poll_budget BDs; when fewer BDs than that
+ * were ready the ring is drained and the Rx interrupt is unmasked again.
+ * The pass runs with interrupts enabled, emacps_process_rx_bds() only
+ * disables them around the Rx ring and receive queue updates.
+ * Returns the number of BDs processed.
+ */
+u32_t emacps_rx_poll(struct xemac_s *xemac, xemacpsif_rxq_t *rxq)
+{
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	u32_t budget;
+	u32_t n_processed;
+	u32_t repoll = 0;
+	SYS_ARCH_DECL_PROTECT(lev);
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime tstart, tend;
+#endif
+
+	if (!rxq->rx_poll_pending) {
+		return 0;
+	}
+
+	/* polling may have been turned off while a pass was pending */
+	budget = xemacpsif->rx_poll_budget;
+	if (budget == 0) {
+		budget = XLWIP_CONFIG_N_RX_DESC;
+	}
+
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime_GetTime(&tstart);
+	if (rxq->rx_poll_irq_time != 0) {
+		rxq->rx_stats.rx_poll_latency_ticks +=
+				(u64_t)(tstart - rxq->rx_poll_irq_time);
+		rxq->rx_stats.rx_poll_wakeups++;
+		rxq->rx_poll_irq_time = 0;
+	}
+#endif
+	n_processed = emacps_process_rx_bds(xemacpsif, rxq, budget);
+	if (n_processed < budget) {
+		/*
+		 * Frames completed while the Rx interrupt was masked do not
+		 * raise it once unmasked, so when one is waiting the interrupt
+		 * is masked again and another pass is scheduled.
+		 */
+		SYS_ARCH_PROTECT(lev);
+		rxq_intr_enable(xemacpsif, rxq);
+		if (rxq_frame_ready(rxq)) {
+			rxq_intr_disable(xemacpsif, rxq);
+			repoll = 1;
+		} else {
+			rxq->rx_poll_pending = 0;
+		}
+		SYS_ARCH_UNPROTECT(lev);
+	}
+#if !NO_SYS
+	if (repoll) {
+		rxq_signal(xemac, rxq);
+	}
+#else
+	(void)repoll;
+#endif
+#ifdef XLWIP_CONFIG_EMAC_RX_STATS
+	XTime_GetTime(&tend);
+	rxq->rx_stats.rx_poll_passes++;
+	rxq->rx_stats.rx_isr_ticks += (u64_t)(tend - tstart);
+#endif
+
+	return n_processed;
+}
+
 void clean_dma_txdescs(struct xemac_s *xemac)
 {
 	XEmacPs_Bd bdtemplate;
@@ -540,21 +966,106 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
 }
 
-XStatus init_dma(struct xemac_s *xemac)
+/*
+ * Creates the Rx BD ring of an Rx queue in its BD space and attaches an Rx
+ * buffer to every BD.
+ */
+static XStatus init_rx_ring(xemacpsif_s *xemacpsif, xemacpsif_rxq_t *rxq)
 {
 	XEmacPs_Bd bdtemplate;
-	XEmacPs_BdRing *rxringptr, *txringptr;
+	XEmacPs_BdRing *rxringptr = rxq->rxring;
 	XEmacPs_Bd *rxbd;
 	struct pbuf *p;
 	XStatus status;
 	s32_t i;
 	u32_t bdindex;
+	u32 *temp;
+
+	LWIP_DEBUGF(NETIF_DEBUG, ("rxringptr: 0x%08x\r\n", rxringptr));
+	LWIP_DEBUGF(NETIF_DEBUG, ("rx_bdspace: %p \r\n", rxq->rx_bdspace));
+
+	/*
+	 * Setup RxBD space.
+	 *
+	 * Setup a BD template for the Rx channel. This template will be copied to
+	 * every RxBD. We will not have to explicitly set these again.
+	 */
+	XEmacPs_BdClear(&bdtemplate);
+
+	/*
+	 * Create the RxBD ring
+	 */
+
+	status = XEmacPs_BdRingCreate(rxringptr, (UINTPTR) rxq->rx_bdspace,
+				(UINTPTR) rxq->rx_bdspace, BD_ALIGNMENT,
+				     XLWIP_CONFIG_N_RX_DESC);
+
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up RxBD space\r\n"));
+		return XST_FAILURE;
+	}
+
+	status = XEmacPs_BdRingClone(rxringptr, &bdtemplate, XEMACPS_RECV);
+	if (status != XST_SUCCESS) {
+		LWIP_DEBUGF(NETIF_DEBUG, ("Error initializing RxBD space\r\n"));
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Allocate RX descriptors, 1 RxBD at a time.
+	 */
+	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
+		p = alloc_rx_pbuf(xemacpsif, rxq);
+		if (!p) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			printf("unable to alloc pbuf in init_dma\r\n");
+			return XST_FAILURE;
+		}
+		status = XEmacPs_BdRingAlloc(rxringptr, 1, &rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating RxBD\r\n"));
+			pbuf_free(p);
+			return XST_FAILURE;
+		}
+		/* Enqueue to HW */
+		status = XEmacPs_BdRingToHw(rxringptr, 1, rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error: committing RxBD to HW\r\n"));
+			pbuf_free(p);
+			XEmacPs_BdRingUnAlloc(rxringptr, 1, rxbd);
+			return XST_FAILURE;
+		}
+
+		bdindex = XEMACPS_BD_TO_INDEX(rxringptr, rxbd);
+		temp = (u32 *)rxbd;
+		*temp = 0;
+		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
+			*temp = 0x00000002;
+		}
+		temp++;
+		*temp = 0;
+		dsb();
+		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
+
+		rxq->rx_pbufs[bdindex] = (UINTPTR)p;
+	}
+	return XST_SUCCESS;
+}
+
+XStatus init_dma(struct xemac_s *xemac)
+{
+	XEmacPs_Bd bdtemplate;
+	XEmacPs_BdRing *txringptr;
+	XStatus status;
 	volatile UINTPTR tempaddress;
 	u32_t index;
 	u32_t gigeversion;
+	u32_t q;
 	XEmacPs_Bd *bdtxterminate;
-	XEmacPs_Bd *bdrxterminate;
-	u32 *temp;
+	XEmacPs_Bd *bdrxterminate = NULL;
 
 	/*
 	 * Disable L1 prefetch if the processor type is Cortex A53. It is
@@ -599,61 +1110,56 @@ XStatus init_dma(struct xemac_s *xemac)
 		bd_space_attr_set = 1;
 	}
 
-	rxringptr = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 	txringptr = &XEmacPs_GetTxRing(&xemacpsif->emacps);
-	LWIP_DEBUGF(NETIF_DEBUG, ("rxringptr: 0x%08x\r\n", rxringptr));
 	LWIP_DEBUGF(NETIF_DEBUG, ("txringptr: 0x%08x\r\n", txringptr));
 
-	/* Allocate 64k for Rx and Tx bds each to take care of extreme cases */
+	/*
+	 * Allocate 64k for Rx and Tx bds each to take care of extreme cases.
+	 * With priority queues, the space after the Tx bds holds the Rx bds
+	 * of queue 1, or the dummy BD parking queue 1 when it is not used.
+	 */
 	tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
-	xemacpsif->rx_bdspace = (void *)tempaddress;
+	xemacpsif->rxq[0].rx_bdspace = (void *)tempaddress;
 	bd_space_index += 0x10000;
 	tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
 	xemacpsif->tx_bdspace = (void *)tempaddress;
 	bd_space_index += 0x10000;
 	if (gigeversion > 2) {
 		tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
-		bdrxterminate = (XEmacPs_Bd *)tempaddress;
+		if (xemacpsif->n_rxq > 1) {
+			xemacpsif->rxq[1].rx_bdspace = (void *)tempaddress;
+		} else {
+			bdrxterminate = (XEmacPs_Bd *)tempaddress;
+		}
 		bd_space_index += 0x10000;
 		tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
 		bdtxterminate = (XEmacPs_Bd *)tempaddress;
 		bd_space_index += 0x10000;
 	}
 
-	LWIP_DEBUGF(NETIF_DEBUG, ("rx_bdspace: %p \r\n", xemacpsif->rx_bdspace));
 	LWIP_DEBUGF(NETIF_DEBUG, ("tx_bdspace: %p \r\n", xemacpsif->tx_bdspace));
 
-	if (!xemacpsif->rx_bdspace || !xemacpsif->tx_bdspace) {
+	if (!xemacpsif->rxq[0].rx_bdspace || !xemacpsif->tx_bdspace) {
 		xil_printf("%s@%d: Error: Unable to allocate memory for TX/RX buffer descriptors",
 				__FILE__, __LINE__);
 		return ERR_IF;
 	}
 
 	/*
-	 * Setup RxBD space.
-	 *
-	 * Setup a BD template for the Rx channel. This template will be copied to
-	 * every RxBD. We will not have to explicitly set these again.
+	 * Create the Rx BD rings, queue 0 uses the ring of the driver
+	 * instance.
 	 */
-	XEmacPs_BdClear(&bdtemplate);
-
-	/*
-	 * Create the RxBD ring
-	 */
-
-	status = XEmacPs_BdRingCreate(rxringptr, (UINTPTR) xemacpsif->rx_bdspace,
-				(UINTPTR) xemacpsif->rx_bdspace, BD_ALIGNMENT,
-				     XLWIP_CONFIG_N_RX_DESC);
-
-	if (status != XST_SUCCESS) {
-		LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up RxBD space\r\n"));
-		return ERR_IF;
-	}
-
-	status = XEmacPs_BdRingClone(rxringptr, &bdtemplate, XEMACPS_RECV);
-	if (status != XST_SUCCESS) {
-		LWIP_DEBUGF(NETIF_DEBUG, ("Error initializing RxBD space\r\n"));
-		return ERR_IF;
+	for (q = 0; q < xemacpsif->n_rxq; q++) {
+		if (q == 0) {
+			xemacpsif->rxq[q].rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
+		} else {
+			xemacpsif->rxq[q].rxring = &xemacpsif->rxq[q].q_rxring;
+		}
+		xemacpsif->rxq[q].rx_pbufs = &rx_pbufs_storage[index +
+					(q * XLWIP_CONFIG_N_RX_DESC)];
+		if (init_rx_ring(xemacpsif, &xemacpsif->rxq[q]) != XST_SUCCESS) {
+			return ERR_IF;
+		}
 	}
 
 	XEmacPs_BdClear(&bdtemplate);
@@ -675,61 +1181,10 @@ XStatus init_dma(struct xemac_s *xemac)
 		return ERR_IF;
 	}
 
-	/*
-	 * Allocate RX descriptors, 1 RxBD at a time.
-	 */
-	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
-#else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
-#endif
-		if (!p) {
-#if LINK_STATS
-			lwip_stats.link.memerr++;
-			lwip_stats.link.drop++;
-#endif
-			printf("unable to alloc pbuf in init_dma\r\n");
-			return ERR_IF;
-		}
-		status = XEmacPs_BdRingAlloc(rxringptr, 1, &rxbd);
-		if (status != XST_SUCCESS) {
-			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating RxBD\r\n"));
-			pbuf_free(p);
-			return ERR_IF;
-		}
-		/* Enqueue to HW */
-		status = XEmacPs_BdRingToHw(rxringptr, 1, rxbd);
-		if (status != XST_SUCCESS) {
-			LWIP_DEBUGF(NETIF_DEBUG, ("Error: committing RxBD to HW\r\n"));
-			pbuf_free(p);
-			XEmacPs_BdRingUnAlloc(rxringptr, 1, rxbd);
-			return ERR_IF;
-		}
-
-		bdindex = XEMACPS_BD_TO_INDEX(rxringptr, rxbd);
-		temp = (u32 *)rxbd;
-		*temp = 0;
-		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
-			*temp = 0x00000002;
-		}
-		temp++;
-		*temp = 0;
-		dsb();
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
-		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
-
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
-	}
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
+	if (xemacpsif->n_rxq > 1) {
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->rxq[1].rxring->BaseBdAddr, 1, XEMACPS_RECV);
+	}
 	if (gigeversion > 2) {
 		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
 	}else {
@@ -739,17 +1194,19 @@ XStatus init_dma(struct xemac_s *xemac)
 	{
 		/*
 		 * This version of GEM supports priority queuing and the current
-		 * dirver is using tx priority queue 1 and normal rx queue for
-		 * packet transmit and receive. The below code ensure that the
-		 * other queue pointers are parked to known state for avoiding
-		 * the controller to malfunction by fetching the descriptors
-		 * from these queues.
+		 * dirver is using tx priority queue 1 and normal rx queue (and
+		 * rx priority queue 1 when enabled) for packet transmit and
+		 * receive. The below code ensure that the other queue pointers
+		 * are parked to known state for avoiding the controller to
+		 * malfunction by fetching the descriptors from these queues.
 		 */
-		XEmacPs_BdClear(bdrxterminate);
-		XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
-						XEMACPS_RXBUF_WRAP_MASK));
-		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
-				   (UINTPTR)bdrxterminate);
+		if (bdrxterminate != NULL) {
+			XEmacPs_BdClear(bdrxterminate);
+			XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
+							XEMACPS_RXBUF_WRAP_MASK));
+			XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
+					   (UINTPTR)bdrxterminate);
+		}
 		XEmacPs_BdClear(bdtxterminate);
 		XEmacPs_BdSetStatus(bdtxterminate, (XEMACPS_TXBUF_USED_MASK |
 						XEMACPS_TXBUF_WRAP_MASK));
@@ -827,10 +1284,14 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 		}
 	}
 
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_TX_DESC); index++) {
-		p = (struct pbuf *)rx_pbufs_storage[index];
-		pbuf_free(p);
-
+	index1 = get_base_index_rxpbufsstorage (xemacpsif);
+	for (index = index1; index < (index1 + (s32_t)(xemacpsif->n_rxq *
+				XLWIP_CONFIG_N_RX_DESC)); index++) {
+		if (rx_pbufs_storage[index] != 0) {
+			p = (struct pbuf *)rx_pbufs_storage[index];
+			pbuf_free(p);
+			rx_pbufs_storage[index] = 0;
+		}
 	}
 }
 
@@ -855,12 +1316,15 @@ void reset_dma(struct xemac_s *xemac)
 {
 	u8 txqueuenum;
 	u32_t gigeversion;
+	u32_t q;
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	XEmacPs_BdRing *txringptr = &XEmacPs_GetTxRing(&xemacpsif->emacps);
-	XEmacPs_BdRing *rxringptr = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 
 	XEmacPs_BdRingPtrReset(txringptr, xemacpsif->tx_bdspace);
-	XEmacPs_BdRingPtrReset(rxringptr, xemacpsif->rx_bdspace);
+	for (q = 0; q < xemacpsif->n_rxq; q++) {
+		XEmacPs_BdRingPtrReset(xemacpsif->rxq[q].rxring,
+				xemacpsif->rxq[q].rx_bdspace);
+	}
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
 	if (gigeversion > 2) {
@@ -870,6 +1334,9 @@ void reset_dma(struct xemac_s *xemac)
 	}
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
+	if (xemacpsif->n_rxq > 1) {
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->rxq[1].rxring->BaseBdAddr, 1, XEMACPS_RECV);
+	}
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
 }
 
@@ -189,6 +189,14 @@ void setup_isr (struct xemac_s *xemac)
 	XEmacPs_SetHandler(&xemacpsif->emacps, XEMACPS_HANDLER_ERROR,
 				    (void *) emacps_error_handler,
 				    (void *) xemac);
+
+#if XLWIP_CONFIG_EMAC_RX_QUEUES > 1
+	if (xemacpsif->n_rxq > 1) {
+		XEmacPs_SetHandler(&xemacpsif->emacps, XEMACPS_HANDLER_DMARECVQ1,
+					(void *) emacps_recv_q1_handler,
+					(void *) xemac);
+	}
+#endif
 }
 
 void start_emacps (xemacpsif_s *xemacps)
@@ -216,15 +224,14 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 {
 	struct xemac_s *xemac;
 	xemacpsif_s   *xemacpsif;
-	XEmacPs_BdRing *rxring;
 	XEmacPs_BdRing *txring;
+	u32_t q;
 #ifdef OS_IS_FREERTOS
 	xInsideISR++;
 #endif
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 	txring = &XEmacPs_GetTxRing(&xemacpsif->emacps);
 
 	if (ErrorWord != 0) {
@@ -237,12 +244,18 @@ void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord)
 			if (ErrorWord & XEMACPS_RXSR_RXOVR_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive over run\r\n"));
 				emacps_recv_handler(arg);
-				setup_rx_bds(xemacpsif, rxring);
+				/* any Rx queue may have run out of BDs */
+				for (q = 0; q < xemacpsif->n_rxq; q++) {
+					setup_rx_bds(xemacpsif, &xemacpsif->rxq[q]);
+				}
 			}
 			if (ErrorWord & XEMACPS_RXSR_BUFFNA_MASK) {
 				LWIP_DEBUGF(NETIF_DEBUG, ("Receive buffer not available\r\n"));
 				emacps_recv_handler(arg);
-				setup_rx_bds(xemacpsif, rxring);
+				/* any Rx queue may have run out of BDs */
+				for (q = 0; q < xemacpsif->n_rxq; q++) {
+					setup_rx_bds(xemacpsif, &xemacpsif->rxq[q]);
+				}
 			}
 			break;
 			case XEMACPS_SEND:
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2018 Xilinx, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * This file is part of the lwIP TCP/IP stack.
+ *
+ */
+
+#include <string.h>
+
+#include "lwipopts.h"
+#include "xlwipconfig.h"
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/mem.h"
+#include "lwip/pbuf.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/stats.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/tcp.h"
+#include "netif/xadapter.h"
+#include "netif/xoffload.h"
+#include "xil_printf.h"
+
+#if LWIP_TCP_LSO && !LWIP_SUPPORT_CUSTOM_PBUF
+#error "TCP large send needs LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+/*
+ * Records the offload capabilities of an adapter and makes lwIP skip the
+ * checksum paths the hardware covers. Without LWIP_CHECKSUM_CTRL_PER_NETIF
+ * the checksum paths are fixed at compile time, so only warn if one was
+ * compiled out that this adapter does not offload.
+ */
+void xoffload_set_caps(struct netif *netif, struct xemac_s *xemac, u32_t caps)
+{
+	xemac->offload_caps = caps;
+
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+	NETIF_SET_CHECKSUM_CTRL(netif,
+		(u16_t)(NETIF_CHECKSUM_ENABLE_ALL & ~(caps & XOFFLOAD_CSUM_MASK)));
+#else
+	if ((!CHECKSUM_GEN_IP && !(caps & XOFFLOAD_CSUM_TX_IP)) ||
+		(!CHECKSUM_GEN_UDP && !(caps & XOFFLOAD_CSUM_TX_UDP)) ||
+		(!CHECKSUM_GEN_TCP && !(caps & XOFFLOAD_CSUM_TX_TCP)) ||
+		(!CHECKSUM_CHECK_IP && !(caps & XOFFLOAD_CSUM_RX_IP)) ||
+		(!CHECKSUM_CHECK_UDP && !(caps & XOFFLOAD_CSUM_RX_UDP)) ||
+		(!CHECKSUM_CHECK_TCP && !(caps & XOFFLOAD_CSUM_RX_TCP))) {
+		xil_printf("%s: checksum disabled in lwIP but not offloaded "
+				"(caps 0x%x)\r\n", __func__, (unsigned)caps);
+	}
+#endif
+
+#if LWIP_TCP_LSO && defined(XLWIP_CONFIG_EMAC_TCP_LSO_SIZE)
+	if (caps & XOFFLOAD_TCP_LSO) {
+		netif->lso_max = XLWIP_CONFIG_EMAC_TCP_LSO_SIZE;
+	}
+#endif
+}
+
+u32_t xoffload_get_caps(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+
+	return xemac->offload_caps;
+}
+
+#if LWIP_TCP_LSO
+/*
+ * Header of one frame cut out of a large segment. It is the first pbuf of
+ * the frame and holds a reference on the large segment, whose payload the
+ * following PBUF_REF pbufs point into; the reference is dropped when the
+ * adapter frees the frame after transmission.
+ */
+typedef struct {
+	struct pbuf_custom pc;
+	struct pbuf *seg;
+	struct pbuf *next;	/* next frame of the segment not sent yet */
+	u8_t hdr[XOFFLOAD_MAX_HDR_SIZE] __attribute__ ((aligned(4)));
+} xoffload_hdr_t;
+
+static void xoffload_hdr_free(struct pbuf *p)
+{
+	xoffload_hdr_t *h = (xoffload_hdr_t *)p;
+
+	pbuf_free(h->seg);
+	mem_free(h);
+}
+
+/*
+ * Builds one frame: a copy of the headers followed by len payload bytes
+ * starting at offset *off of pbuf *q, as PBUF_REF pbufs that point into
+ * the segment or, with copy set, copied into one PBUF_RAM pbuf. Advances
+ * *q and *off past the payload taken.
+ */
+static struct pbuf *xoffload_lso_frame(struct pbuf *seg, u16_t hdr_len,
+				struct pbuf **q, u16_t *off, u16_t len, u8_t copy)
+{
+	xoffload_hdr_t *h;
+	struct pbuf *frame, *r = NULL;
+	u16_t n, done = 0;
+
+	h = (xoffload_hdr_t *)mem_malloc(sizeof(*h));
+	if (h == NULL)
+		return NULL;
+	MEMCPY(h->hdr, seg->payload, hdr_len);
+	h->pc.custom_free_function = xoffload_hdr_free;
+	h->seg = seg;
+	h->next = NULL;
+	pbuf_ref(seg);
+	frame = pbuf_alloced_custom(PBUF_RAW, hdr_len, PBUF_REF, &h->pc,
+						h->hdr, sizeof(h->hdr));
+
+	if (copy) {
+		r = pbuf_alloc(PBUF_RAW, len, PBUF_RAM);
+		if (r == NULL) {
+			pbuf_free(frame);
+			return NULL;
+		}
+		pbuf_cat(frame, r);
+	}
+	while (len > 0) {
+		while (*off == (*q)->len) {
+			*q = (*q)->next;
+			*off = 0;
+		}
+		n = LWIP_MIN(len, (u16_t)((*q)->len - *off));
+		if (copy) {
+			MEMCPY((u8_t *)r->payload + done,
+				(u8_t *)(*q)->payload + *off, n);
+			done += n;
+		} else {
+			r = pbuf_alloc(PBUF_RAW, n, PBUF_REF);
+			if (r == NULL) {
+				pbuf_free(frame);
+				return NULL;
+			}
+			r->payload = (u8_t *)(*q)->payload + *off;
+			pbuf_cat(frame, r);
+		}
+		*off += n;
+		len -= n;
+	}
+	return frame;
+}
+
+/*
+ * Frees the frames of a segment that were not handed to the adapter.
+ */
+static void xoffload_lso_free(struct pbuf *frame)
+{
+	struct pbuf *next;
+
+	while (frame != NULL) {
+		next = ((xoffload_hdr_t *)frame)->next;
+		pbuf_free(frame);
+		frame = next;
+	}
+}
+
+/*
+ * Cuts the payload of segment p into frames of at most mss bytes, each with
+ * its own fixed up copy of the hdr_len bytes of headers. Returns the list
+ * of frames in *frames and the number of pbufs, i.e. Tx BDs, they take in
+ * *n_bds; ERR_MEM if a frame could not be allocated.
+ */
+static err_t xoffload_lso_split(struct netif *netif, struct pbuf *p,
+			u16_t hdr_len, u16_t iphdr_len, u16_t mss, u8_t copy,
+			struct pbuf **frames, s32_t *n_bds)
+{
+	struct ip_hdr *iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+	struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + iphdr_len);
+	struct pbuf *frame, **tail = frames, *q = p;
+	u32_t caps = xoffload_get_caps(netif);
+	u32_t seqno = lwip_ntohl(tcphdr->seqno);
+	u16_t remaining = p->tot_len - hdr_len;
+	u16_t off = hdr_len;
+	u16_t id = lwip_ntohs(IPH_ID(iphdr));
+	u16_t flags = TCPH_FLAGS(tcphdr);
+	u16_t len;
+
+	*frames = NULL;
+	*n_bds = 0;
+	while (remaining > 0) {
+		len = LWIP_MIN(mss, remaining);
+		frame = xoffload_lso_frame(p, hdr_len, &q, &off, len, copy);
+		if (frame == NULL) {
+			xoffload_lso_free(*frames);
+			*frames = NULL;
+			return ERR_MEM;
+		}
+		*tail = frame;
+		tail = &((xoffload_hdr_t *)frame)->next;
+		*n_bds += pbuf_clen(frame);
+		remaining -= len;
+
+		iphdr = (struct ip_hdr *)((u8_t *)frame->payload + SIZEOF_ETH_HDR);
+		tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + iphdr_len);
+		IPH_LEN_SET(iphdr, lwip_htons(hdr_len - SIZEOF_ETH_HDR + len));
+		IPH_ID_SET(iphdr, lwip_htons(id));
+		IPH_CHKSUM_SET(iphdr, 0);
+		if (!(caps & XOFFLOAD_CSUM_TX_IP)) {
+			IPH_CHKSUM_SET(iphdr, inet_chksum(iphdr, iphdr_len));
+		}
+		tcphdr->seqno = lwip_htonl(seqno);
+		TCPH_FLAGS_SET(tcphdr, remaining ? (flags & ~(TCP_FIN | TCP_PSH)) :
+						flags);
+		tcphdr->chksum = 0;
+		if (!(caps & XOFFLOAD_CSUM_TX_TCP)) {
+			u16_t tcp_len = hdr_len - SIZEOF_ETH_HDR - iphdr_len + len;
+			ip4_addr_t src, dest;
+
+			ip4_addr_copy(src, iphdr->src);
+			ip4_addr_copy(dest, iphdr->dest);
+			pbuf_header(frame, -(s16_t)(SIZEOF_ETH_HDR + iphdr_len));
+			tcphdr->chksum = inet_chksum_pseudo(frame, IP_PROTO_TCP,
+							tcp_len, &src, &dest);
+			pbuf_header_force(frame, (s16_t)(SIZEOF_ETH_HDR + iphdr_len));
+		}
+
+		seqno += len;
+		id++;
+	}
+	return ERR_OK;
+}
+
+/*
+ * Splits a TCP segment larger than the mtu into mtu sized frames and
+ * passes them to xmit. Headers are replicated and fixed up per frame (IP
+ * length and id, TCP sequence number, FIN/PSH only on the last frame).
+ * The frames normally point into the segment, so the scatter-gather DMA
+ * gathers the payload without a copy. A segment whose payload is chained
+ * from so many small pbufs that its frames would need more Tx BDs than the
+ * ring has is split again with the payload of each frame copied into one
+ * pbuf, two Tx BDs per frame as lwip202.tcl checks the lso size against.
+ * Checksums the hardware does not insert are computed here.
+ *
+ * The segment goes out whole or not at all: lwIP retransmits a segment
+ * that failed with ERR_MEM, so sending only some of its frames would
+ * duplicate them. All frames are therefore built first, and nothing is
+ * sent unless tx_space reports a free Tx BD for every pbuf of them. Only
+ * the lwIP thread queues Tx BDs, so they cannot be taken in between.
+ */
+err_t xoffload_lso_output(struct netif *netif, struct pbuf *p,
+			err_t (*xmit)(struct netif *netif, struct pbuf *frame),
+			s32_t (*tx_space)(struct netif *netif))
+{
+	struct eth_hdr *ethhdr = (struct eth_hdr *)p->payload;
+	struct ip_hdr *iphdr;
+	struct tcp_hdr *tcphdr;
+	struct pbuf *frame, *frames;
+	s32_t n_bds;
+	u16_t iphdr_len, hdr_len, mss;
+	err_t err;
+
+	iphdr = (struct ip_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR);
+	if ((p->len < SIZEOF_ETH_HDR + IP_HLEN) ||
+		(ethhdr->type != PP_HTONS(ETHTYPE_IP)) ||
+		(IPH_PROTO(iphdr) != IP_PROTO_TCP)) {
+		goto drop;
+	}
+	iphdr_len = IPH_HL(iphdr) * 4;
+	tcphdr = (struct tcp_hdr *)((u8_t *)iphdr + iphdr_len);
+	if (p->len < SIZEOF_ETH_HDR + iphdr_len + TCP_HLEN) {
+		goto drop;
+	}
+	hdr_len = SIZEOF_ETH_HDR + iphdr_len + TCPH_HDRLEN(tcphdr) * 4;
+	if ((p->len < hdr_len) || (hdr_len > XOFFLOAD_MAX_HDR_SIZE) ||
+		(netif->mtu <= hdr_len - SIZEOF_ETH_HDR)) {
+		goto drop;
+	}
+	mss = netif->mtu - (hdr_len - SIZEOF_ETH_HDR);
+
+	err = xoffload_lso_split(netif, p, hdr_len, iphdr_len, mss, 0,
+						&frames, &n_bds);
+	if ((err == ERR_OK) && (n_bds > XLWIP_CONFIG_N_TX_DESC)) {
+		/* too many payload pbufs to gather, copy them */
+		xoffload_lso_free(frames);
+		err = xoffload_lso_split(netif, p, hdr_len, iphdr_len, mss, 1,
+						&frames, &n_bds);
+	}
+	if (err != ERR_OK) {
+#if LINK_STATS
+		lwip_stats.link.memerr++;
+		lwip_stats.link.drop++;
+#endif
+		return err;
+	}
+	if (n_bds > XLWIP_CONFIG_N_TX_DESC) {
+		/* netif->lso_max is larger than lwip202.tcl allows */
+		xoffload_lso_free(frames);
+		goto drop;
+	}
+	if (n_bds > tx_space(netif)) {
+		xoffload_lso_free(frames);
+#if LINK_STATS
+		lwip_stats.link.drop++;
+#endif
+		return ERR_MEM;
+	}
+
+	while (frames != NULL) {
+		frame = frames;
+		frames = ((xoffload_hdr_t *)frame)->next;
+		err = xmit(netif, frame);
+		pbuf_free(frame);
+		if (err != ERR_OK) {
+			xoffload_lso_free(frames);
+			return err;
+		}
+	}
+	return ERR_OK;
+
+drop:
+	/* only TCP/IPv4 segments that fit the Tx ring are split */
+	LWIP_DEBUGF(NETIF_DEBUG, ("xoffload_lso_output: cannot segment\r\n"));
+#if LINK_STATS
+	lwip_stats.link.drop++;
+#endif
+	return ERR_IF;
+}
+#endif /* LWIP_TCP_LSO */
@@ -30,13 +30,32 @@
 
 #include <stdlib.h>
 
+#include "lwip/mem.h"
 #include "netif/xpqueue.h"
 #include "xil_printf.h"
 
 #define NUM_QUEUES	2
 
+/*
+ * Total number of entries shared by all the spsc queues: PQ_QUEUE_SIZE for
+ * each of NUM_QUEUES interfaces, an interface with several Rx queues
+ * splits its share between them.
+ */
+#ifndef SPSC_POOL_SIZE
+#define SPSC_POOL_SIZE	(NUM_QUEUES * PQ_QUEUE_SIZE)
+#endif
+
+/*
+ * Orders the accesses to a ring entry against the update of head/tail;
+ * the producer may run on another core than the consumer.
+ */
+#define SPSC_BARRIER()	__sync_synchronize()
+
 pq_queue_t pq_queue[NUM_QUEUES];
 
+static void *spsc_pool[SPSC_POOL_SIZE];
+static int spsc_pool_used;
+
 pq_queue_t *
 pq_create_queue()
 {
@@ -91,3 +110,106 @@ pq_qlength(pq_queue_t *q)
 {
 	return q->len;
 }
+
+/*
+ * spsc_create_queue():
+ *
+ * Creates a ring with at least size entries (rounded up to a power of
+ * two). Any number of queues can be created as long as their entries fit
+ * in SPSC_POOL_SIZE.
+ */
+spsc_queue_t *
+spsc_create_queue(int size)
+{
+	spsc_queue_t *q;
+	int entries = 1;
+
+	while (entries < size)
+		entries <<= 1;
+
+	if (spsc_pool_used + entries > SPSC_POOL_SIZE) {
+		xil_printf("ERR: spsc queue pool exhausted\n\r");
+		return NULL;
+	}
+
+	q = mem_malloc(sizeof *q);
+	if (!q)
+		return q;
+
+	q->data = &spsc_pool[spsc_pool_used];
+	spsc_pool_used += entries;
+	q->mask = entries - 1;
+	q->head = q->tail = 0;
+
+	return q;
+}
+
+/* Producer side, typically the Rx interrupt handler */
+int
+spsc_enqueue(spsc_queue_t *q, void *p)
+{
+	unsigned int head = q->head;
+
+	if (head - q->tail > q->mask)
+		return -1;
+
+	q->data[head & q->mask] = p;
+	/* publish the entry before the new head */
+	SPSC_BARRIER();
+	q->head = head + 1;
+
+	return 0;
+}
+
+/* Consumer side */
+void*
+spsc_dequeue(spsc_queue_t *q)
+{
+	unsigned int tail = q->tail;
+	void *p;
+
+	if (tail == q->head)
+		return NULL;
+
+	/* read the entry only after head has been seen */
+	SPSC_BARRIER();
+	p = q->data[tail & q->mask];
+	/* release the slot only after the entry has been read */
+	SPSC_BARRIER();
+	q->tail = tail + 1;
+
+	return p;
+}
+
+/*
+ * spsc_dequeue_bulk():
+ *
+ * Dequeues up to n entries into p with a single update of tail. Returns
+ * the number of entries dequeued.
+ */
+int
+spsc_dequeue_bulk(spsc_queue_t *q, void **p, int n)
+{
+	unsigned int tail = q->tail;
+	unsigned int avail = q->head - tail;
+	int i;
+
+	if (avail == 0)
+		return 0;
+	if ((unsigned int)n > avail)
+		n = avail;
+
+	SPSC_BARRIER();
+	for (i = 0; i < n; i++)
+		p[i] = q->data[(tail + i) & q->mask];
+	SPSC_BARRIER();
+	q->tail = tail + n;
+
+	return n;
+}
+
+int
+spsc_qlength(spsc_queue_t *q)
+{
+	return q->head - q->tail;
+}
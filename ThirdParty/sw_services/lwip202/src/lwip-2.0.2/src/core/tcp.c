@@ -1967,6 +1967,33 @@ tcp_eff_send_mss_impl(u16_t sendmss, const ip_addr_t *dest
 }
 #endif /* TCP_CALCULATE_EFF_SEND_MSS */
 
+#if LWIP_TCP_LSO
+/**
+ * Enables large segments for a pcb if its outgoing netif segments TCP itself
+ * and the negotiated MSS equals the one derived from that netif's mtu (the
+ * netif splits at its own mtu, so a smaller peer MSS must not be exceeded).
+ * Called once the MSS is known, i.e. when the connection gets established.
+ */
+void
+tcp_lso_update(struct tcp_pcb *pcb)
+{
+  struct netif *outif;
+
+  pcb->lso_mss = 0;
+#if LWIP_IPV6
+  if (IP_IS_V6(&pcb->remote_ip)) {
+    return;
+  }
+#endif /* LWIP_IPV6 */
+  outif = ip_route(&pcb->local_ip, &pcb->remote_ip);
+  if ((outif == NULL) || (outif->lso_max <= outif->mtu) ||
+      (pcb->mss != (u16_t)(outif->mtu - IP_HLEN - TCP_HLEN))) {
+    return;
+  }
+  pcb->lso_mss = outif->lso_max - IP_HLEN - TCP_HLEN;
+}
+#endif /* LWIP_TCP_LSO */
+
 /** Helper function for tcp_netif_ip_addr_changed() that iterates a pcb list */
 static void
 tcp_netif_ip_addr_changed_pcblist(const ip_addr_t* old_addr, struct tcp_pcb* pcb_list)
@@ -393,7 +393,7 @@ tcp_write(struct tcp_pcb *pcb, const void *arg, u16_t len, u8_t apiflags)
 #endif /* TCP_CHECKSUM_ON_COPY */
   err_t err;
   /* don't allocate segments bigger than half the maximum window we ever received */
-  u16_t mss_local = LWIP_MIN(pcb->mss, TCPWND_MIN16(pcb->snd_wnd_max/2));
+  u16_t mss_local = LWIP_MIN(TCP_SEG_LIMIT(pcb), TCPWND_MIN16(pcb->snd_wnd_max/2));
   mss_local = mss_local ? mss_local : pcb->mss;
 
 #if LWIP_NETIF_TX_SINGLE_PBUF
@@ -1021,6 +1021,17 @@ tcp_output(struct tcp_pcb *pcb)
 
   seg = pcb->unsent;
 
+#if LWIP_TCP_LSO
+  /* A large segment may exceed cwnd while nothing is in flight to open it
+     further: let it go as long as the receiver's window allows. */
+  if ((pcb->lso_mss != 0) && (pcb->unacked == NULL) && (seg != NULL)) {
+    u32_t seg_end = lwip_ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len;
+    if ((seg_end > wnd) && (seg_end <= pcb->snd_wnd)) {
+      wnd = seg_end;
+    }
+  }
+#endif /* LWIP_TCP_LSO */
+
   /* If the TF_ACK_NOW flag is set and no data will be sent (either
    * because the ->unsent queue is empty or because the window does
    * not allow it), construct an empty ACK segment and send it.
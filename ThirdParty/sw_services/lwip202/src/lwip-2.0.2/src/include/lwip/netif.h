@@ -297,6 +297,11 @@ struct netif {
 #endif /* LWIP_CHECKSUM_CTRL_PER_NETIF*/
   /** maximum transfer unit (in bytes) */
   u16_t mtu;
+#if LWIP_TCP_LSO
+  /** largest IPv4/TCP datagram (in bytes) the driver segments itself,
+   * 0 if large send is not supported */
+  u16_t lso_max;
+#endif /* LWIP_TCP_LSO */
   /** number of bytes used in hwaddr */
   u8_t hwaddr_len;
   /** link level hardware address of this interface */
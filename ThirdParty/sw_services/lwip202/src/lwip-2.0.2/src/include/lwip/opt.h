@@ -1294,6 +1294,18 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * LWIP_TCP_LSO==1: let tcp_write() build segments larger than the MSS for
+ * connections routed over a netif that sets netif->lso_max. Such a netif
+ * must split every IPv4/TCP datagram larger than its mtu into frames of
+ * (mtu - IP header - TCP header) payload bytes before transmission.
+ * Large segments are only built when the negotiated MSS equals the MSS
+ * derived from the netif mtu, so the netif never needs to know the peer MSS.
+ */
+#if !defined LWIP_TCP_LSO || defined __DOXYGEN__
+#define LWIP_TCP_LSO                    0
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
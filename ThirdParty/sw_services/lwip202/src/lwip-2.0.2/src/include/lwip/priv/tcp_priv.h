@@ -474,6 +474,15 @@ u16_t tcp_eff_send_mss_impl(u16_t sendmss, const ip_addr_t *dest
 #endif /* LWIP_IPV6 || LWIP_IPV4_SRC_ROUTING */
 #endif /* TCP_CALCULATE_EFF_SEND_MSS */
 
+#if LWIP_TCP_LSO
+void tcp_lso_update(struct tcp_pcb *pcb);
+/** Largest segment tcp_write() may build for this pcb */
+#define TCP_SEG_LIMIT(pcb) (((pcb)->lso_mss > (pcb)->mss) ? (pcb)->lso_mss : (pcb)->mss)
+#else /* LWIP_TCP_LSO */
+#define tcp_lso_update(pcb)
+#define TCP_SEG_LIMIT(pcb) ((pcb)->mss)
+#endif /* LWIP_TCP_LSO */
+
 #if LWIP_CALLBACK_API
 err_t tcp_recv_null(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err);
 #endif /* LWIP_CALLBACK_API */
@@ -243,6 +243,9 @@ struct tcp_pcb {
   s16_t rtime;
 
   u16_t mss;   /* maximum segment size */
+#if LWIP_TCP_LSO
+  u16_t lso_mss; /* largest segment handed to a large send netif, 0 if unused */
+#endif /* LWIP_TCP_LSO */
 
   /* RTT (round trip time) estimation variables */
   u32_t rttest; /* RTT estimate in 500ms ticks */
@@ -0,0 +1,515 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file bdbench.c
+*		Host benchmark of the AXI DMA BD commit paths. xaxidma_bdring.c
+*		and xaxidma_bd.c are built for Linux against a transmit ring in
+*		memory. The data cache maintenance functions and the register
+*		accesses of the driver are defined here and count the BD cache
+*		flushes and the writes of the tail descriptor register that
+*		the driver really makes, so the cost of committing BDs one
+*		packet per call with XAxiDma_BdRingToHw(), a burst per call
+*		with XAxiDma_BdRingToHw() and a burst per call with
+*		XAxiDma_BdRingToHwBatch() can be compared.
+*
+*		The tests check that a batched commit flushes exactly the BDs
+*		of the set, in one range or in two when the set wraps around
+*		the end of the ring, writes the tail descriptor register once
+*		with the last BD of the set, and leaves a rejected set and a
+*		halted channel untouched.
+*
+*		Usage: bdbench [-r ring_bds] [-p packets]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 9.8   agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include "xaxidma_bdring.h"
+#include "bench.h"
+
+#define BENCH_MAX_BDS		1024	/* Largest ring */
+#define BENCH_MAX_FLUSHES	4096	/* Flush ranges recorded per commit */
+#define BENCH_PKT_LEN		64	/* Bytes of a packet, one BD each */
+#define BENCH_MAX_LEN		0x3FFFFFF	/* Length field of the BDs */
+
+/* Commit methods */
+#define COMMIT_PER_PKT		0	/* XAxiDma_BdRingToHw() per packet */
+#define COMMIT_TOHW		1	/* XAxiDma_BdRingToHw() per burst */
+#define COMMIT_BATCH		2	/* XAxiDma_BdRingToHwBatch() per burst */
+
+static const char *MethodName[] = {
+	"ToHw per packet", "ToHw per burst", "ToHwBatch per burst"
+};
+
+static const int Bursts[] = { 1, 4, 16, 64 };
+
+/* BD memory of the ring, BDs are 64 byte aligned */
+static u8 BdMem[BENCH_MAX_BDS * XAXIDMA_BD_MINIMUM_ALIGNMENT]
+			__attribute__ ((aligned(XAXIDMA_BD_MINIMUM_ALIGNMENT)));
+
+/* Register space of the transmit channel */
+static u32 ChanRegs[XAXIDMA_RX_OFFSET / 4];
+
+/* Counters of the driver calls into the BSP */
+typedef struct {
+	u64 Flushes;		/* Xil_DCacheFlushRange() calls */
+	u64 FlushBytes;		/* Bytes flushed */
+	u64 Invalidates;	/* Xil_DCacheInvalidateRange() calls */
+	u64 TailWrites;		/* Writes of the tail descriptor register */
+} BspCounts;
+
+static BspCounts Counts;
+static UINTPTR FlushAddr[BENCH_MAX_FLUSHES];	/* Ranges since the last */
+static u32 FlushLen[BENCH_MAX_FLUSHES];		/* ResetRanges() */
+static u32 NumRanges;
+static u32 TailValue;
+
+static XAxiDma_BdRing Ring;
+static int RingBds = 256;
+static int Packets = 100000;
+
+/*****************************************************************************/
+/*
+* BSP functions called by the driver
+*/
+void Xil_DCacheFlushRange(INTPTR adr, INTPTR len)
+{
+	Counts.Flushes++;
+	Counts.FlushBytes += (u64)len;
+	if (NumRanges < BENCH_MAX_FLUSHES) {
+		FlushAddr[NumRanges] = (UINTPTR)adr;
+		FlushLen[NumRanges] = (u32)len;
+		NumRanges++;
+	}
+}
+
+void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+	Counts.Invalidates++;
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	return ChanRegs[(Addr - (UINTPTR)ChanRegs) / 4];
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	if (Addr == (UINTPTR)ChanRegs + XAXIDMA_TDESC_OFFSET) {
+		Counts.TailWrites++;
+		TailValue = Value;
+	}
+	ChanRegs[(Addr - (UINTPTR)ChanRegs) / 4] = Value;
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+	va_list Args;
+
+	va_start(Args, ctrl1);
+	vprintf(ctrl1, Args);
+	va_end(Args);
+}
+
+/*****************************************************************************/
+/*
+* Sets up a running transmit channel with a ring of NumBds BDs. The flushes
+* of XAxiDma_BdRingCreate() are not counted.
+*/
+static void SetupRing(int NumBds)
+{
+	memset(&Ring, 0, sizeof(Ring));
+	memset(ChanRegs, 0, sizeof(ChanRegs));
+	Ring.ChanBase = (UINTPTR)ChanRegs;
+	Ring.IsRxChannel = 0;
+	Ring.MaxTransferLen = BENCH_MAX_LEN;
+
+	if (XAxiDma_BdRingCreate(&Ring, (UINTPTR)BdMem, (UINTPTR)BdMem,
+				 XAXIDMA_BD_MINIMUM_ALIGNMENT, NumBds) !=
+	    XST_SUCCESS) {
+		fprintf(stderr, "XAxiDma_BdRingCreate failed\n");
+		exit(1);
+	}
+	/* As after XAxiDma_BdRingStart() */
+	Ring.RunState = AXIDMA_CHANNEL_NOT_HALTED;
+	memset(&Counts, 0, sizeof(Counts));
+}
+
+/*****************************************************************************/
+/*
+* Allocates NumBd BDs and fills them with single BD packets. A set whose
+* last BD has no end of frame is made with NoEof.
+*/
+static XAxiDma_Bd *PrepareBds(int NumBd, int NoEof)
+{
+	XAxiDma_Bd *BdPtr, *CurBdPtr;
+	int Index;
+
+	if (XAxiDma_BdRingAlloc(&Ring, NumBd, &BdPtr) != XST_SUCCESS) {
+		fprintf(stderr, "XAxiDma_BdRingAlloc failed\n");
+		exit(1);
+	}
+
+	CurBdPtr = BdPtr;
+	for (Index = 0; Index < NumBd; Index++) {
+		(void)XAxiDma_BdSetLength(CurBdPtr, BENCH_PKT_LEN,
+					  Ring.MaxTransferLen);
+		XAxiDma_BdSetCtrl(CurBdPtr, XAXIDMA_BD_CTRL_TXSOF_MASK |
+			(((Index == NumBd - 1) && NoEof) ? 0 :
+			 XAXIDMA_BD_CTRL_TXEOF_MASK));
+		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET,
+				XAXIDMA_BD_STS_COMPLETE_MASK);
+		CurBdPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(&Ring, CurBdPtr);
+	}
+
+	return BdPtr;
+}
+
+/*****************************************************************************/
+/*
+* Commits a prepared set with the given method.
+*/
+static int CommitBds(int Method, int NumBd, XAxiDma_Bd *BdPtr)
+{
+	int Index;
+	int Status = XST_SUCCESS;
+
+	switch (Method) {
+	case COMMIT_PER_PKT:
+		for (Index = 0; (Index < NumBd) && (Status == XST_SUCCESS);
+		     Index++) {
+			Status = XAxiDma_BdRingToHw(&Ring, 1, BdPtr);
+			BdPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(&Ring, BdPtr);
+		}
+		break;
+	case COMMIT_TOHW:
+		Status = XAxiDma_BdRingToHw(&Ring, NumBd, BdPtr);
+		break;
+	default:
+		Status = XAxiDma_BdRingToHwBatch(&Ring, NumBd, BdPtr);
+		break;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/*
+* Plays the DMA engine: completes every BD handed to hardware and returns
+* them to the free group.
+*/
+static void CompleteBds(void)
+{
+	XAxiDma_Bd *BdPtr, *CurBdPtr;
+	int NumBd, Index;
+
+	CurBdPtr = Ring.HwHead;
+	for (Index = 0; Index < Ring.HwCnt; Index++) {
+		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET,
+				XAXIDMA_BD_STS_COMPLETE_MASK | BENCH_PKT_LEN);
+		CurBdPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(&Ring, CurBdPtr);
+	}
+
+	NumBd = XAxiDma_BdRingFromHw(&Ring, XAXIDMA_ALL_BDS, &BdPtr);
+	if ((NumBd > 0) &&
+	    (XAxiDma_BdRingFree(&Ring, NumBd, BdPtr) != XST_SUCCESS)) {
+		fprintf(stderr, "XAxiDma_BdRingFree failed\n");
+		exit(1);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Tells whether the recorded flush ranges cover the BDs of a set, each of
+* them once, and nothing else.
+*/
+static int RangesCoverSet(int NumBd, XAxiDma_Bd *BdPtr)
+{
+	static u8 Hits[BENCH_MAX_BDS];
+	UINTPTR Addr;
+	u32 Range;
+	int Index;
+
+	memset(Hits, 0, sizeof(Hits));
+	for (Range = 0; Range < NumRanges; Range++) {
+		if ((FlushAddr[Range] < Ring.FirstBdAddr) ||
+		    (FlushAddr[Range] + FlushLen[Range] >
+		     Ring.LastBdAddr + XAXIDMA_BD_HW_NUM_BYTES)) {
+			return 0;
+		}
+		/* A BD is covered if its hardware words are */
+		for (Addr = Ring.FirstBdAddr; Addr <= Ring.LastBdAddr;
+		     Addr += Ring.Separation) {
+			if ((Addr >= FlushAddr[Range]) &&
+			    (Addr + XAXIDMA_BD_HW_NUM_BYTES <=
+			     FlushAddr[Range] + FlushLen[Range])) {
+				Hits[(Addr - Ring.FirstBdAddr) /
+				     Ring.Separation]++;
+			}
+		}
+	}
+
+	Addr = (UINTPTR)BdPtr;
+	for (Index = 0; Index < NumBd; Index++) {
+		if (Hits[(Addr - Ring.FirstBdAddr) / Ring.Separation] != 1) {
+			return 0;
+		}
+		Hits[(Addr - Ring.FirstBdAddr) / Ring.Separation] = 0;
+		Addr = (UINTPTR)XAxiDma_BdRingNext(&Ring, (XAxiDma_Bd *)Addr);
+	}
+	for (Index = 0; Index < Ring.AllCnt; Index++) {
+		if (Hits[Index] != 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/*****************************************************************************/
+/*
+* Batched commits of every size up to the ring, starting at every position
+* of a small ring so that all wrap cases are seen.
+*/
+static void test_batch_ranges(void)
+{
+	XAxiDma_Bd *BdPtr, *LastBdPtr;
+	int NumBd, Start, Wraps, Index;
+	int Ok = 1, CountOk = 1, TailOk = 1;
+	BspCounts Before;
+
+	SetupRing(16);
+	for (NumBd = 1; NumBd <= 16; NumBd++) {
+		for (Start = 0; Start < 16; Start++) {
+			BdPtr = PrepareBds(NumBd, 0);
+			LastBdPtr = BdPtr;
+			for (Index = 1; Index < NumBd; Index++) {
+				LastBdPtr = (XAxiDma_Bd *)
+					XAxiDma_BdRingNext(&Ring, LastBdPtr);
+			}
+			Wraps = ((UINTPTR)LastBdPtr < (UINTPTR)BdPtr);
+
+			NumRanges = 0;
+			Before = Counts;
+			if (CommitBds(COMMIT_BATCH, NumBd, BdPtr) !=
+			    XST_SUCCESS) {
+				Ok = 0;
+			}
+			if (!RangesCoverSet(NumBd, BdPtr)) {
+				Ok = 0;
+			}
+			if (Counts.Flushes - Before.Flushes !=
+			    (u64)(Wraps ? 2 : 1)) {
+				CountOk = 0;
+			}
+			if ((Counts.TailWrites - Before.TailWrites != 1) ||
+			    (TailValue != (u32)((UINTPTR)LastBdPtr &
+						XAXIDMA_DESC_LSB_MASK))) {
+				TailOk = 0;
+			}
+			CompleteBds();
+
+			/* Move the start by one BD */
+			BdPtr = PrepareBds(1, 0);
+			(void)CommitBds(COMMIT_BATCH, 1, BdPtr);
+			CompleteBds();
+		}
+	}
+
+	check("batch: flush ranges cover exactly the set", Ok);
+	check("batch: one flush, two when the set wraps", CountOk);
+	check("batch: one tail write with the last BD", TailOk);
+}
+
+/*****************************************************************************/
+/*
+* XAxiDma_BdRingToHw() flushes every BD on its own.
+*/
+static void test_tohw_counts(void)
+{
+	XAxiDma_Bd *BdPtr;
+	BspCounts Before;
+	int Ok = 1;
+	int Round;
+
+	SetupRing(64);
+	for (Round = 0; Round < 10; Round++) {
+		BdPtr = PrepareBds(40, 0);
+		NumRanges = 0;
+		Before = Counts;
+		(void)CommitBds(COMMIT_TOHW, 40, BdPtr);
+		if ((Counts.Flushes - Before.Flushes != 40) ||
+		    (Counts.TailWrites - Before.TailWrites != 1) ||
+		    !RangesCoverSet(40, BdPtr)) {
+			Ok = 0;
+		}
+		CompleteBds();
+	}
+
+	check("tohw: one flush per BD, one tail write", Ok);
+}
+
+/*****************************************************************************/
+/*
+* A rejected set and a halted channel.
+*/
+static void test_no_commit(void)
+{
+	XAxiDma_Bd *BdPtr;
+	BspCounts Before;
+	u8 Copy[16 * XAXIDMA_BD_MINIMUM_ALIGNMENT];
+	int Status;
+
+	SetupRing(16);
+	BdPtr = PrepareBds(8, 1);
+	memcpy(Copy, BdMem, sizeof(Copy));
+	Before = Counts;
+	Status = XAxiDma_BdRingToHwBatch(&Ring, 8, BdPtr);
+	check("batch: set without EOF rejected, BDs untouched",
+	      (Status == XST_FAILURE) &&
+	      (Counts.Flushes == Before.Flushes) &&
+	      (Counts.TailWrites == Before.TailWrites) &&
+	      (memcmp(Copy, BdMem, sizeof(Copy)) == 0) &&
+	      (Ring.PreCnt == 8) && (Ring.HwCnt == 0));
+
+	SetupRing(16);
+	Ring.RunState = AXIDMA_CHANNEL_HALTED;
+	BdPtr = PrepareBds(8, 0);
+	Status = XAxiDma_BdRingToHwBatch(&Ring, 8, BdPtr);
+	check("batch: halted channel, no tail write",
+	      (Status == XST_SUCCESS) && (Counts.TailWrites == 0) &&
+	      (Ring.HwCnt == 8));
+}
+
+/*****************************************************************************/
+/*
+* Sends Packets single BD packets in bursts and reports the BSP calls of
+* the commits per BD.
+*/
+static void bench_method(int Method, int Burst)
+{
+	XAxiDma_Bd *BdPtr;
+	BspCounts Commit = { 0, 0, 0, 0 };
+	BspCounts Before;
+	double Start, Ns = 0;
+	int Sent = 0;
+	int Status = XST_SUCCESS;
+
+	SetupRing(RingBds);
+	while (Sent < Packets) {
+		BdPtr = PrepareBds(Burst, 0);
+
+		Before = Counts;
+		NumRanges = 0;
+		Start = now_ns();
+		Status |= CommitBds(Method, Burst, BdPtr);
+		Ns += now_ns() - Start;
+		Commit.Flushes += Counts.Flushes - Before.Flushes;
+		Commit.FlushBytes += Counts.FlushBytes - Before.FlushBytes;
+		Commit.TailWrites += Counts.TailWrites - Before.TailWrites;
+
+		CompleteBds();
+		Sent += Burst;
+	}
+
+	printf("%-20s %5d %10.3f %10.1f %10.3f %10.1f%s\n",
+	       MethodName[Method], Burst,
+	       (double)Commit.Flushes / Sent,
+	       (double)Commit.FlushBytes / Sent,
+	       (double)Commit.TailWrites / Sent,
+	       Ns / Sent,
+	       (Status != XST_SUCCESS) ? "  (commit failed)" : "");
+	if (Status != XST_SUCCESS) {
+		check_failures++;
+	}
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-r ring_bds] [-p packets]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Opt, Method;
+	u32 Index;
+
+	while ((Opt = getopt(argc, argv, "r:p:")) != -1) {
+		switch (Opt) {
+		case 'r':
+			RingBds = atoi(optarg);
+			break;
+		case 'p':
+			Packets = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if ((RingBds < Bursts[sizeof(Bursts) / sizeof(Bursts[0]) - 1]) ||
+	    (RingBds > BENCH_MAX_BDS) || (Packets <= 0)) {
+		usage(argv[0]);
+	}
+
+	test_batch_ranges();
+	test_tohw_counts();
+	test_no_commit();
+
+	printf("\n%d packets of one BD, ring of %d BDs, per BD committed:\n",
+	       Packets, RingBds);
+	printf("%-20s %5s %10s %10s %10s %10s\n", "method", "burst",
+	       "flushes", "bytes", "tail wr", "host ns");
+	for (Index = 0; Index < sizeof(Bursts) / sizeof(Bursts[0]); Index++) {
+		for (Method = COMMIT_PER_PKT; Method <= COMMIT_BATCH;
+		     Method++) {
+			bench_method(Method, Bursts[Index]);
+		}
+	}
+
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	return 0;
+}
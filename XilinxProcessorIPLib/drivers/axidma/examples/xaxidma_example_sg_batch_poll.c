@@ -0,0 +1,698 @@
+/******************************************************************************
+*
+* Copyright (C) 2010 - 2018 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xaxidma_example_sg_batch_poll.c
+ *
+ * This file demonstrates how to use XAxiDma_BdRingToHwBatch() on the Xilinx
+ * AXI DMA core (AXIDMA) configured in Scatter Gather Mode, and compares the
+ * cost of committing BDs with it against XAxiDma_BdRingToHw().
+ *
+ * Bursts of NUMBER_OF_PACKETS small packets are sent through the loopback
+ * and the receive ring is replenished after each burst. Both the transmit
+ * commit and the receive replenish are timed, first using
+ * XAxiDma_BdRingToHw() and then using XAxiDma_BdRingToHwBatch(). At the end
+ * the average number of timer ticks per committed BD is printed for both
+ * methods. The BD cache flushes and tail descriptor writes of both methods
+ * are counted by the host benchmark in ../bench.
+ *
+ * This code assumes a loopback hardware widget is connected to the AXI DMA
+ * core for data packet loopback.
+ *
+ * Timing is only reported on ARM processors, where the global timer is used
+ * through XTime_GetTime(). On other processors the example only checks that
+ * both methods transfer the packets correctly.
+ *
+ * Make sure that MEMORY_BASE is defined properly as per the HW system.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 9.8   agt  10/17/26 First release
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+/***************************** Include Files *********************************/
+#include "xaxidma.h"
+#include "xparameters.h"
+#include "xdebug.h"
+
+#ifdef __aarch64__
+#include "xil_mmu.h"
+#endif
+
+#if defined(__arm__) || defined(__aarch64__)
+#include "xtime_l.h"
+#endif
+
+#ifndef DEBUG
+extern void xil_printf(const char *format, ...);
+#endif
+
+/******************** Constant Definitions **********************************/
+
+/*
+ * Device hardware build related constants.
+ */
+#define DMA_DEV_ID		XPAR_AXIDMA_0_DEVICE_ID
+
+#ifdef XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR		XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#elif XPAR_MIG7SERIES_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG7SERIES_0_BASEADDR
+#elif XPAR_MIG_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG_0_BASEADDR
+#elif XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR	XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#endif
+
+#ifndef DDR_BASE_ADDR
+#warning CHECK FOR THE VALID DDR ADDRESS IN XPARAMETERS.H, \
+		DEFAULT SET TO 0x01000000
+#define MEM_BASE_ADDR		0x01000000
+#else
+#define MEM_BASE_ADDR		(DDR_BASE_ADDR + 0x1000000)
+#endif
+
+#define TX_BD_SPACE_BASE	(MEM_BASE_ADDR)
+#define TX_BD_SPACE_HIGH	(MEM_BASE_ADDR + 0x0000FFFF)
+#define RX_BD_SPACE_BASE	(MEM_BASE_ADDR + 0x00010000)
+#define RX_BD_SPACE_HIGH	(MEM_BASE_ADDR + 0x0001FFFF)
+#define TX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00100000)
+#define RX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00300000)
+
+#define MAX_PKT_LEN		0x40
+#define NUMBER_OF_PACKETS	256
+#define NUMBER_OF_BURSTS	16
+#define TEST_START_VALUE	0xC
+
+/*
+ * Methods used to commit BDs to hardware
+ */
+#define COMMIT_PER_BD		0
+#define COMMIT_BATCH		1
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * Commit statistics gathered for one commit method
+ */
+typedef struct {
+	u64 Ticks;		/* Timer ticks spent in the commit calls */
+	u32 Bds;		/* Number of BDs committed */
+} CommitStats;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#if defined(__arm__) || defined(__aarch64__)
+#define GET_TIME(TimePtr)	XTime_GetTime(TimePtr)
+#else
+#define GET_TIME(TimePtr)	(*(TimePtr) = 0)
+typedef u64 XTime;
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static int RxSetup(XAxiDma * AxiDmaInstPtr);
+static int TxSetup(XAxiDma * AxiDmaInstPtr);
+static int CommitBds(XAxiDma_BdRing * RingPtr, int NumBd,
+			XAxiDma_Bd * BdPtr, int Method, CommitStats *Stats);
+static int RefillRx(XAxiDma * AxiDmaInstPtr, int Method, CommitStats *Stats);
+static int SendBurst(XAxiDma * AxiDmaInstPtr, int Method,
+			CommitStats *Stats);
+static int WaitBurst(XAxiDma * AxiDmaInstPtr);
+static void PrintStats(const char *Name, CommitStats *Stats);
+
+/************************** Variable Definitions *****************************/
+/*
+ * Device instance definitions
+ */
+XAxiDma AxiDma;
+
+/*****************************************************************************/
+/**
+*
+* Main function
+*
+* This function sets up the DMA engine, runs NUMBER_OF_BURSTS bursts through
+* the loopback with each commit method and prints the commit statistics.
+*
+* @param	None
+*
+* @return
+*		- XST_SUCCESS if test passes
+*		- XST_FAILURE if test fails.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+	int Method;
+	int Burst;
+	XAxiDma_Config *Config;
+	CommitStats Stats[2];
+
+	xil_printf("\r\n--- Entering main() --- \r\n");
+
+#ifdef __aarch64__
+	Xil_SetTlbAttributes(TX_BD_SPACE_BASE, NORM_NONCACHE);
+	Xil_SetTlbAttributes(RX_BD_SPACE_BASE, NORM_NONCACHE);
+#endif
+
+	Config = XAxiDma_LookupConfig(DMA_DEV_ID);
+	if (!Config) {
+		xil_printf("No config found for %d\r\n", DMA_DEV_ID);
+
+		return XST_FAILURE;
+	}
+
+	/* Initialize DMA engine */
+	Status = XAxiDma_CfgInitialize(&AxiDma, Config);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Initialization failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	if(!XAxiDma_HasSg(&AxiDma)) {
+		xil_printf("Device configured as Simple mode \r\n");
+
+		return XST_FAILURE;
+	}
+
+	Status = TxSetup(&AxiDma);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = RxSetup(&AxiDma);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	memset(Stats, 0, sizeof(Stats));
+
+	for (Method = COMMIT_PER_BD; Method <= COMMIT_BATCH; Method++) {
+		for (Burst = 0; Burst < NUMBER_OF_BURSTS; Burst++) {
+			Status = SendBurst(&AxiDma, Method, &Stats[Method]);
+			if (Status != XST_SUCCESS) {
+				goto Fail;
+			}
+
+			Status = WaitBurst(&AxiDma);
+			if (Status != XST_SUCCESS) {
+				goto Fail;
+			}
+
+			Status = RefillRx(&AxiDma, Method, &Stats[Method]);
+			if (Status != XST_SUCCESS) {
+				goto Fail;
+			}
+		}
+	}
+
+	PrintStats("XAxiDma_BdRingToHw     ", &Stats[COMMIT_PER_BD]);
+	PrintStats("XAxiDma_BdRingToHwBatch", &Stats[COMMIT_BATCH]);
+
+	xil_printf("Successfully ran AXI DMA SG Batch Polling Example\r\n");
+	xil_printf("--- Exiting main() --- \r\n");
+
+	return XST_SUCCESS;
+
+Fail:
+	xil_printf("AXI DMA SG Batch Polling Example Failed\r\n");
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up RX channel of the DMA engine and gives all the RX BDs
+* to the hardware.
+*
+* @param	AxiDmaInstPtr is the pointer to the instance of the DMA engine.
+*
+* @return	XST_SUCCESS if the setup is successful, XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int RxSetup(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *RxRingPtr;
+	int Status;
+	XAxiDma_Bd BdTemplate;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *BdCurPtr;
+	u32 BdCount;
+	UINTPTR RxBufferPtr;
+	u32 Index;
+
+	RxRingPtr = XAxiDma_GetRxRing(AxiDmaInstPtr);
+
+	/* Disable all RX interrupts before RxBD space setup */
+	XAxiDma_BdRingIntDisable(RxRingPtr, XAXIDMA_IRQ_ALL_MASK);
+
+	/* Setup Rx BD space */
+	BdCount = XAxiDma_BdRingCntCalc(XAXIDMA_BD_MINIMUM_ALIGNMENT,
+				RX_BD_SPACE_HIGH - RX_BD_SPACE_BASE + 1);
+
+	Status = XAxiDma_BdRingCreate(RxRingPtr, RX_BD_SPACE_BASE,
+				RX_BD_SPACE_BASE,
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, BdCount);
+	if (Status != XST_SUCCESS) {
+		xil_printf("RX create BD ring failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	XAxiDma_BdClear(&BdTemplate);
+	Status = XAxiDma_BdRingClone(RxRingPtr, &BdTemplate);
+	if (Status != XST_SUCCESS) {
+		xil_printf("RX clone BD failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Every BD owns a fixed receive buffer for the lifetime of the ring,
+	 * so replenishing the ring only needs to commit the BDs again
+	 */
+	Status = XAxiDma_BdRingAlloc(RxRingPtr, BdCount, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("RX alloc BD failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	BdCurPtr = BdPtr;
+	RxBufferPtr = RX_BUFFER_BASE;
+	for (Index = 0; Index < BdCount; Index++) {
+		Status = XAxiDma_BdSetBufAddr(BdCurPtr, RxBufferPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Rx set buffer addr failed %d\r\n", Status);
+
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_BdSetLength(BdCurPtr, MAX_PKT_LEN,
+				RxRingPtr->MaxTransferLen);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Rx set length failed %d\r\n", Status);
+
+			return XST_FAILURE;
+		}
+
+		XAxiDma_BdSetCtrl(BdCurPtr, 0);
+		XAxiDma_BdSetId(BdCurPtr, RxBufferPtr);
+
+		RxBufferPtr += MAX_PKT_LEN;
+		BdCurPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(RxRingPtr,
+								BdCurPtr);
+	}
+
+	Status = XAxiDma_BdRingToHwBatch(RxRingPtr, BdCount, BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("RX submit hw failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Start RX DMA channel */
+	Status = XAxiDma_BdRingStart(RxRingPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("RX start hw failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up the TX channel of a DMA engine and fills the transmit
+* buffers with a known pattern.
+*
+* @param	AxiDmaInstPtr is the instance pointer to the DMA engine.
+*
+* @return	XST_SUCCESS if the setup is successful, XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int TxSetup(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	XAxiDma_Bd BdTemplate;
+	int Status;
+	u32 BdCount;
+	u8 *TxPacket;
+	u8 Value;
+	int Index;
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+
+	/* Disable all TX interrupts before TxBD space setup */
+	XAxiDma_BdRingIntDisable(TxRingPtr, XAXIDMA_IRQ_ALL_MASK);
+
+	/* Setup TxBD space  */
+	BdCount = XAxiDma_BdRingCntCalc(XAXIDMA_BD_MINIMUM_ALIGNMENT,
+				TX_BD_SPACE_HIGH - TX_BD_SPACE_BASE + 1);
+
+	Status = XAxiDma_BdRingCreate(TxRingPtr, TX_BD_SPACE_BASE,
+				TX_BD_SPACE_BASE,
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, BdCount);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed create BD ring in txsetup\r\n");
+
+		return XST_FAILURE;
+	}
+
+	XAxiDma_BdClear(&BdTemplate);
+	Status = XAxiDma_BdRingClone(TxRingPtr, &BdTemplate);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed bdring clone in txsetup %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Create pattern in the packets to transmit */
+	TxPacket = (u8 *)TX_BUFFER_BASE;
+	Value = TEST_START_VALUE;
+	for (Index = 0; Index < MAX_PKT_LEN * NUMBER_OF_PACKETS; Index++) {
+		TxPacket[Index] = Value;
+		Value = (Value + 1) & 0xFF;
+	}
+
+	Xil_DCacheFlushRange((UINTPTR)TxPacket,
+			MAX_PKT_LEN * NUMBER_OF_PACKETS);
+
+	/* Start the TX channel */
+	Status = XAxiDma_BdRingStart(TxRingPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("failed start bdring txsetup %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function commits a set of BDs to the hardware with the given method and
+* accumulates the time spent.
+*
+* @param	RingPtr is the BD ring the set belongs to.
+* @param	NumBd is the number of BDs in the set.
+* @param	BdPtr is the first BD of the set.
+* @param	Method is COMMIT_PER_BD or COMMIT_BATCH.
+* @param	Stats is the statistics block to be updated.
+*
+* @return	The status returned by the commit function.
+*
+* @note		None.
+*
+******************************************************************************/
+static int CommitBds(XAxiDma_BdRing * RingPtr, int NumBd,
+			XAxiDma_Bd * BdPtr, int Method, CommitStats *Stats)
+{
+	XTime Start;
+	XTime End;
+	int Status;
+
+	GET_TIME(&Start);
+	if (Method == COMMIT_BATCH) {
+		Status = XAxiDma_BdRingToHwBatch(RingPtr, NumBd, BdPtr);
+	}
+	else {
+		Status = XAxiDma_BdRingToHw(RingPtr, NumBd, BdPtr);
+	}
+	GET_TIME(&End);
+
+	Stats->Ticks += (u64)(End - Start);
+	Stats->Bds += NumBd;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function transmits NUMBER_OF_PACKETS single-BD packets, committing all
+* of them with one call.
+*
+* @param	AxiDmaInstPtr points to the DMA engine instance
+* @param	Method is COMMIT_PER_BD or COMMIT_BATCH.
+* @param	Stats is the statistics block to be updated.
+*
+* @return	- XST_SUCCESS if the DMA accepts the packets successfully,
+*		- XST_FAILURE otherwise.
+*
+* @note     None.
+*
+******************************************************************************/
+static int SendBurst(XAxiDma * AxiDmaInstPtr, int Method, CommitStats *Stats)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *BdCurPtr;
+	UINTPTR BufferAddr;
+	int Status;
+	int Index;
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+
+	Status = XAxiDma_BdRingAlloc(TxRingPtr, NUMBER_OF_PACKETS, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Failed tx bd alloc\r\n");
+		return XST_FAILURE;
+	}
+
+	BufferAddr = TX_BUFFER_BASE;
+	BdCurPtr = BdPtr;
+	for (Index = 0; Index < NUMBER_OF_PACKETS; Index++) {
+		Status = XAxiDma_BdSetBufAddr(BdCurPtr, BufferAddr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Tx set buffer addr failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_BdSetLength(BdCurPtr, MAX_PKT_LEN,
+					TxRingPtr->MaxTransferLen);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Tx set length failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		XAxiDma_BdSetCtrl(BdCurPtr, XAXIDMA_BD_CTRL_TXSOF_MASK |
+					XAXIDMA_BD_CTRL_TXEOF_MASK);
+		XAxiDma_BdSetId(BdCurPtr, BufferAddr);
+
+		BufferAddr += MAX_PKT_LEN;
+		BdCurPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(TxRingPtr,
+								BdCurPtr);
+	}
+
+	Status = CommitBds(TxRingPtr, NUMBER_OF_PACKETS, BdPtr, Method, Stats);
+	if (Status != XST_SUCCESS) {
+		xil_printf("to hw failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function waits until a burst has been transmitted and received, checks
+* the received data and frees all the BDs of the burst.
+*
+* @param	AxiDmaInstPtr points to the DMA engine instance
+*
+* @return	- XST_SUCCESS if the burst completed and the data is correct,
+*		- XST_FAILURE otherwise.
+*
+* @note     None.
+*
+******************************************************************************/
+static int WaitBurst(XAxiDma * AxiDmaInstPtr)
+{
+	XAxiDma_BdRing *TxRingPtr;
+	XAxiDma_BdRing *RxRingPtr;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *BdCurPtr;
+	int ProcessedBdCount;
+	int Done;
+	int Index;
+	int Status;
+	u8 *RxPacket;
+	u8 *TxPacket;
+	int Offset;
+
+	TxRingPtr = XAxiDma_GetTxRing(AxiDmaInstPtr);
+	RxRingPtr = XAxiDma_GetRxRing(AxiDmaInstPtr);
+
+	Done = 0;
+	while (Done < NUMBER_OF_PACKETS) {
+		ProcessedBdCount = XAxiDma_BdRingFromHw(TxRingPtr,
+						XAXIDMA_ALL_BDS, &BdPtr);
+		if (ProcessedBdCount == 0) {
+			continue;
+		}
+
+		Status = XAxiDma_BdRingFree(TxRingPtr, ProcessedBdCount,
+						BdPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Failed to free %d tx BDs %d\r\n",
+				ProcessedBdCount, Status);
+			return XST_FAILURE;
+		}
+		Done += ProcessedBdCount;
+	}
+
+	Done = 0;
+	while (Done < NUMBER_OF_PACKETS) {
+		ProcessedBdCount = XAxiDma_BdRingFromHw(RxRingPtr,
+						XAXIDMA_ALL_BDS, &BdPtr);
+		if (ProcessedBdCount == 0) {
+			continue;
+		}
+
+		BdCurPtr = BdPtr;
+		for (Index = 0; Index < ProcessedBdCount; Index++) {
+			RxPacket = (u8 *)(UINTPTR)XAxiDma_BdGetId(BdCurPtr);
+			TxPacket = (u8 *)(UINTPTR)(TX_BUFFER_BASE +
+					((Done + Index) * MAX_PKT_LEN));
+
+#ifndef __aarch64__
+			Xil_DCacheInvalidateRange((UINTPTR)RxPacket,
+							MAX_PKT_LEN);
+#endif
+			for (Offset = 0; Offset < MAX_PKT_LEN; Offset++) {
+				if (RxPacket[Offset] != TxPacket[Offset]) {
+					xil_printf("Data error %d/%d\r\n",
+						Done + Index, Offset);
+					return XST_FAILURE;
+				}
+			}
+
+			BdCurPtr = (XAxiDma_Bd *)XAxiDma_BdRingNext(RxRingPtr,
+								BdCurPtr);
+		}
+
+		Status = XAxiDma_BdRingFree(RxRingPtr, ProcessedBdCount,
+						BdPtr);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Failed to free %d rx BDs %d\r\n",
+				ProcessedBdCount, Status);
+			return XST_FAILURE;
+		}
+		Done += ProcessedBdCount;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function gives all the free RX BDs back to the hardware with the given
+* commit method.
+*
+* @param	AxiDmaInstPtr points to the DMA engine instance
+* @param	Method is COMMIT_PER_BD or COMMIT_BATCH.
+* @param	Stats is the statistics block to be updated.
+*
+* @return	- XST_SUCCESS if the BDs were committed,
+*		- XST_FAILURE otherwise.
+*
+* @note     None.
+*
+******************************************************************************/
+static int RefillRx(XAxiDma * AxiDmaInstPtr, int Method, CommitStats *Stats)
+{
+	XAxiDma_BdRing *RxRingPtr;
+	XAxiDma_Bd *BdPtr;
+	int FreeBdCount;
+	int Status;
+
+	RxRingPtr = XAxiDma_GetRxRing(AxiDmaInstPtr);
+
+	FreeBdCount = XAxiDma_BdRingGetFreeCnt(RxRingPtr);
+	Status = XAxiDma_BdRingAlloc(RxRingPtr, FreeBdCount, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("bd alloc failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = CommitBds(RxRingPtr, FreeBdCount, BdPtr, Method, Stats);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Submit %d rx BDs failed %d\r\n", FreeBdCount,
+				Status);
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the statistics gathered for one commit method.
+*
+* @param	Name is the name of the commit method.
+* @param	Stats is the statistics block to print.
+*
+* @return	None.
+*
+* @note     None.
+*
+******************************************************************************/
+static void PrintStats(const char *Name, CommitStats *Stats)
+{
+	if (Stats->Bds == 0) {
+		return;
+	}
+
+#if defined(__arm__) || defined(__aarch64__)
+	xil_printf("%s: %d BDs, %d ticks/100 BDs\r\n",
+		Name, Stats->Bds, (u32)((Stats->Ticks * 100) / Stats->Bds));
+#else
+	xil_printf("%s: %d BDs\r\n", Name, Stats->Bds);
+#endif
+}
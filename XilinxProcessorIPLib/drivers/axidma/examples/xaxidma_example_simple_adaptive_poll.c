@@ -0,0 +1,398 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xaxidma_example_simple_adaptive_poll.c
+ *
+ * This file demonstrates the adaptive completion polling of the xaxidma
+ * driver for small simple mode transfers. Each round trip submits a receive
+ * and a send transfer with XAxiDma_PollTransfer() and waits for both with
+ * XAxiDma_PollWait(), which spins on the status register for a calibrated
+ * window of SPIN_WINDOW_NS and then falls back to yielding. At the end the
+ * completion latency histogram of the receive channel is printed.
+ *
+ * This code assumes a loopback hardware widget is connected to the AXI DMA
+ * core for data packet loopback.
+ *
+ * Latencies are measured in global timer ticks on ARM processors, where
+ * XTime_GetTime() is available. On other processors no time source is set
+ * and latencies are reported in status register reads.
+ *
+ * Make sure that MEMORY_BASE is defined properly as per the HW system.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 9.8   agt  10/17/26 First release
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+/***************************** Include Files *********************************/
+#include "xaxidma.h"
+#include "xparameters.h"
+#include "xdebug.h"
+
+#if defined(__arm__) || defined(__aarch64__)
+#include "xtime_l.h"
+#endif
+
+#ifndef DEBUG
+extern void xil_printf(const char *format, ...);
+#endif
+
+/******************** Constant Definitions **********************************/
+
+/*
+ * Device hardware build related constants.
+ */
+#define DMA_DEV_ID		XPAR_AXIDMA_0_DEVICE_ID
+
+#ifdef XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR		XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#elif XPAR_MIG7SERIES_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG7SERIES_0_BASEADDR
+#elif XPAR_MIG_0_BASEADDR
+#define DDR_BASE_ADDR	XPAR_MIG_0_BASEADDR
+#elif XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR	XPAR_PSU_DDR_0_S_AXI_BASEADDR
+#endif
+
+#ifndef DDR_BASE_ADDR
+#warning CHECK FOR THE VALID DDR ADDRESS IN XPARAMETERS.H, \
+		DEFAULT SET TO 0x01000000
+#define MEM_BASE_ADDR		0x01000000
+#else
+#define MEM_BASE_ADDR		(DDR_BASE_ADDR + 0x1000000)
+#endif
+
+#define TX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00100000)
+#define RX_BUFFER_BASE		(MEM_BASE_ADDR + 0x00300000)
+
+#define MAX_PKT_LEN		0x40
+#define NUMBER_OF_TRANSFERS	1000
+#define TEST_START_VALUE	0xC
+
+/*
+ * Spin window before the waits start to yield
+ */
+#define SPIN_WINDOW_NS		2000
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+
+/************************** Function Prototypes ******************************/
+
+int XAxiDma_AdaptivePollExample(u16 DeviceId);
+static int CheckData(u8 Start);
+static void PrintStats(const char *Name, XAxiDma_Poll *PollPtr);
+#if defined(__arm__) || defined(__aarch64__)
+static u32 GetTicks(void *TimeRef);
+#endif
+
+/************************** Variable Definitions *****************************/
+/*
+ * Device instance definitions
+ */
+XAxiDma AxiDma;
+
+static XAxiDma_Poll TxPoll;
+static XAxiDma_Poll RxPoll;
+
+/*****************************************************************************/
+/**
+* The entry point for this example. It invokes the example function,
+* and reports the execution status.
+*
+* @param	None.
+*
+* @return
+*		- XST_SUCCESS if example finishes successfully
+*		- XST_FAILURE if example fails.
+*
+* @note		None.
+*
+******************************************************************************/
+int main()
+{
+	int Status;
+
+	xil_printf("\r\n--- Entering main() --- \r\n");
+
+	Status = XAxiDma_AdaptivePollExample(DMA_DEV_ID);
+
+	if (Status != XST_SUCCESS) {
+		xil_printf("XAxiDma_AdaptivePoll Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran XAxiDma_AdaptivePoll Example\r\n");
+
+	xil_printf("--- Exiting main() --- \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* The example runs NUMBER_OF_TRANSFERS loopback round trips with adaptive
+* completion polling and prints the latency statistics of both channels.
+*
+* @param	DeviceId is the Device Id of the XAxiDma instance
+*
+* @return
+*		- XST_SUCCESS if example finishes successfully
+*		- XST_FAILURE if error occurs
+*
+* @note		None
+*
+******************************************************************************/
+int XAxiDma_AdaptivePollExample(u16 DeviceId)
+{
+	XAxiDma_Config *CfgPtr;
+	int Status;
+	int Index;
+	int Byte;
+	u8 *TxBufferPtr;
+	u8 Value;
+
+	TxBufferPtr = (u8 *)TX_BUFFER_BASE;
+
+	CfgPtr = XAxiDma_LookupConfig(DeviceId);
+	if (!CfgPtr) {
+		xil_printf("No config found for %d\r\n", DeviceId);
+		return XST_FAILURE;
+	}
+
+	Status = XAxiDma_CfgInitialize(&AxiDma, CfgPtr);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Initialization failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	if (XAxiDma_HasSg(&AxiDma)) {
+		xil_printf("Device configured as SG mode \r\n");
+		return XST_FAILURE;
+	}
+
+	/* Disable interrupts, completions are polled
+	 */
+	XAxiDma_IntrDisable(&AxiDma, XAXIDMA_IRQ_ALL_MASK,
+						XAXIDMA_DEVICE_TO_DMA);
+	XAxiDma_IntrDisable(&AxiDma, XAXIDMA_IRQ_ALL_MASK,
+						XAXIDMA_DMA_TO_DEVICE);
+
+	Status = XAxiDma_PollInitialize(&TxPoll, &AxiDma,
+						XAXIDMA_DMA_TO_DEVICE);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Tx poll initialization failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	Status = XAxiDma_PollInitialize(&RxPoll, &AxiDma,
+						XAXIDMA_DEVICE_TO_DMA);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Rx poll initialization failed %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+#if defined(__arm__) || defined(__aarch64__)
+	XAxiDma_PollSetTimeSource(&TxPoll, GetTicks, NULL);
+	XAxiDma_PollSetTimeSource(&RxPoll, GetTicks, NULL);
+
+	XAxiDma_PollCalibrate(&TxPoll,
+		(u32)((COUNTS_PER_SECOND / 1000000) * SPIN_WINDOW_NS / 1000));
+	XAxiDma_PollCalibrate(&RxPoll,
+		(u32)((COUNTS_PER_SECOND / 1000000) * SPIN_WINDOW_NS / 1000));
+#endif
+
+	xil_printf("Spin window Tx %d Rx %d status reads\r\n",
+		TxPoll.SpinCount, RxPoll.SpinCount);
+
+	for (Index = 0; Index < NUMBER_OF_TRANSFERS; Index++) {
+		Value = (u8)(TEST_START_VALUE + Index);
+		for (Byte = 0; Byte < MAX_PKT_LEN; Byte++) {
+			TxBufferPtr[Byte] = Value++;
+		}
+
+		Xil_DCacheFlushRange((UINTPTR)TX_BUFFER_BASE, MAX_PKT_LEN);
+#ifdef __aarch64__
+		Xil_DCacheFlushRange((UINTPTR)RX_BUFFER_BASE, MAX_PKT_LEN);
+#endif
+
+		Status = XAxiDma_PollTransfer(&RxPoll, RX_BUFFER_BASE,
+						MAX_PKT_LEN);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_PollTransfer(&TxPoll, TX_BUFFER_BASE,
+						MAX_PKT_LEN);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_PollWait(&TxPoll);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Tx wait failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		Status = XAxiDma_PollWait(&RxPoll);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Rx wait failed %d\r\n", Status);
+			return XST_FAILURE;
+		}
+
+		Status = CheckData((u8)(TEST_START_VALUE + Index));
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	PrintStats("Tx", &TxPoll);
+	PrintStats("Rx", &RxPoll);
+
+	return XST_SUCCESS;
+}
+
+#if defined(__arm__) || defined(__aarch64__)
+/*****************************************************************************/
+/*
+*
+* Time source of the adaptive polling, the low word of the global timer.
+*
+* @param	TimeRef is unused.
+*
+* @return	The current global timer ticks.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 GetTicks(void *TimeRef)
+{
+	XTime Now;
+
+	(void)TimeRef;
+	XTime_GetTime(&Now);
+
+	return (u32)Now;
+}
+#endif
+
+/*****************************************************************************/
+/*
+*
+* This function prints the completion statistics of a channel.
+*
+* @param	Name is the channel name to print.
+* @param	PollPtr is the polling state of the channel.
+*
+* @return	None.
+*
+* @note		Bucket n of the histogram holds latencies from 2^(n-1)
+*		up to 2^n - 1, the last bucket everything above.
+*
+******************************************************************************/
+static void PrintStats(const char *Name, XAxiDma_Poll *PollPtr)
+{
+	XAxiDma_PollStats Stats;
+	int Bucket;
+
+	XAxiDma_PollGetStats(PollPtr, &Stats);
+	if (Stats.Count == 0) {
+		return;
+	}
+
+	xil_printf("%s: %d transfers, %d spun, %d yielded, %d yields\r\n",
+		Name, Stats.Count, Stats.Spun, Stats.Yielded, Stats.Yields);
+	xil_printf("%s: latency min %d avg %d max %d\r\n", Name,
+		Stats.LatencyMin, (u32)(Stats.LatencySum / Stats.Count),
+		Stats.LatencyMax);
+
+	for (Bucket = 0; Bucket < XAXIDMA_POLL_HIST_BUCKETS; Bucket++) {
+		if (Stats.Hist[Bucket] == 0) {
+			continue;
+		}
+
+		if (Bucket == (XAXIDMA_POLL_HIST_BUCKETS - 1)) {
+			xil_printf("  >= %d: %d\r\n", 1 << (Bucket - 1),
+				Stats.Hist[Bucket]);
+		}
+		else {
+			xil_printf("  < %d: %d\r\n", 1 << Bucket,
+				Stats.Hist[Bucket]);
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+*
+* This function checks data buffer after the DMA transfer is finished.
+*
+* @param	Start is the value of the first byte sent.
+*
+* @return
+*		- XST_SUCCESS if validation is successful.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int CheckData(u8 Start)
+{
+	u8 *RxPacket;
+	int Index;
+	u8 Value = Start;
+
+	RxPacket = (u8 *) RX_BUFFER_BASE;
+
+#ifndef __aarch64__
+	Xil_DCacheInvalidateRange((UINTPTR)RxPacket, MAX_PKT_LEN);
+#endif
+
+	for (Index = 0; Index < MAX_PKT_LEN; Index++) {
+		if (RxPacket[Index] != Value) {
+			xil_printf("Data error %d: %x/%x\r\n",
+			Index, (unsigned int)RxPacket[Index],
+				(unsigned int)Value);
+
+			return XST_FAILURE;
+		}
+		Value++;
+	}
+
+	return XST_SUCCESS;
+}
@@ -204,6 +204,21 @@
 * interrupt ID. The driver provides APIs to enable/disable interrupt,
 * and tune the interrupt frequency regarding to packet processing frequency.
 *
+* <b> Adaptive Polling </b>
+*
+* For short simple mode transfers an interrupt round trip can take longer
+* than the transfer itself. XAxiDma_PollTransfer() and XAxiDma_PollWait()
+* wait for completion without interrupts. XAxiDma_PollWait() first spins on
+* the status register for a window of XAxiDma_Poll.SpinCount reads, which
+* XAxiDma_PollCalibrate() derives from a window in time source ticks, and
+* then falls back to calling a yield function between reads. The yield
+* function is supplied by the application, e.g. one calling taskYIELD()
+* under FreeRTOS or executing WFE where an event source is available. The
+* default only issues a processor yield hint.
+*
+* Every completion is recorded in a log2 latency histogram with minimum,
+* maximum and sum, see XAxiDma_PollStats.
+*
 * <b> Software Initialization </b>
 *
 *
@@ -248,6 +263,11 @@
 * The user application uses XAxiDma_BdRingToHw() to submit BDs to the hardware
 * to start DMA transfers.
 *
+* When many BDs are submitted at once, XAxiDma_BdRingToHwBatch() can be used
+* instead. It flushes the whole BD set with one cache range operation (two if
+* the set wraps around the end of the ring) rather than one per BD, and
+* updates the tail descriptor register once for the set.
+*
 * For both channels, if the DMA engine is currently stopped (using
 * XAxiDma_Pause()), the newly added BDs will be accepted but not processed
 * until the DMA engine is started, using XAxiDma_BdRingStart(), or resumed,
@@ -285,6 +305,12 @@
 * - One for SG polling mode (xaxidma_poll_multi_pkts.c), multiple BD/packets transfer
 * - One for simple polling mode (xaxidma_example_simple_poll.c)
 * - One for simple Interrupt mode (xaxidma_example_simple_intr.c)
+* - One for SG polling mode (xaxidma_example_sg_batch_poll.c), comparing the
+*   cost of committing BDs with XAxiDma_BdRingToHw() and
+*   XAxiDma_BdRingToHwBatch()
+* - One for simple polling mode (xaxidma_example_simple_adaptive_poll.c),
+*   waiting with the adaptive completion polling and printing the latency
+*   histograms
 *
 * <b> Address Translation </b>
 *
@@ -473,6 +499,10 @@
 * 9.6  rsp   01/11/18 Fixed CR#976392 In XAxiDma struct use UINTPTR for RegBase.
 *                     In XAxiDma_LookupConfigBaseAddr() use UINTPTR for Baseaddr.
 * 9.7  rsp   04/25/18 Add SgLengthWidth member in dma config structure. CR #1000474
+* 9.8  agt   10/17/26 Added XAxiDma_BdRingToHwBatch() to commit a set of BDs
+*                     with range cache flushes and a single tail update.
+*      agt   10/17/26 Added adaptive spin/yield completion polling with
+*                     latency histograms in xaxidma_poll.c.
 * </pre>
 *
 ******************************************************************************/
@@ -495,6 +525,13 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/** @name Adaptive polling
+ * @{
+ */
+#define XAXIDMA_POLL_HIST_BUCKETS	16	/**< Latency histogram buckets */
+#define XAXIDMA_POLL_DEF_SPIN		256	/**< Default spin window, in
+						  *  status register reads */
+/*@}*/
 
 /**************************** Type Definitions *******************************/
 
@@ -518,6 +555,52 @@ typedef struct XAxiDma {
 	int AddrWidth;		  /**< Address Width */
 } XAxiDma;
 
+/**
+ * Time source of the adaptive polling, returns a free running tick count
+ */
+typedef u32 (*XAxiDma_PollTimeFn)(void *TimeRef);
+
+/**
+ * Yield function called by the adaptive polling once the spin window is over
+ */
+typedef void (*XAxiDma_PollYieldFn)(void *YieldRef);
+
+/**
+ * Completion latency statistics of the adaptive polling. Latencies are in
+ * ticks of the time source, or in status register reads if there is none.
+ * Hist[0] counts latencies of 0, Hist[n] latencies from 2^(n-1) up to
+ * 2^n - 1 and the last bucket everything above.
+ */
+typedef struct {
+	u32 Count;		/**< Completed transfers */
+	u32 Spun;		/**< Completed within the spin window */
+	u32 Yielded;		/**< Completed after yielding */
+	u32 Yields;		/**< Calls of the yield function */
+	u32 Timeouts;		/**< Waits given up */
+	u32 Errors;		/**< Transfers completed with DMA errors */
+	u32 LatencyMin;		/**< Smallest completion latency */
+	u32 LatencyMax;		/**< Largest completion latency */
+	u64 LatencySum;		/**< Sum of all completion latencies */
+	u32 Hist[XAXIDMA_POLL_HIST_BUCKETS]; /**< Latency histogram */
+} XAxiDma_PollStats;
+
+/**
+ * Adaptive completion polling of one simple mode channel
+ */
+typedef struct {
+	XAxiDma *InstancePtr;	/**< DMA engine of the channel */
+	int Direction;		/**< Channel, XAXIDMA_DMA_TO_DEVICE or
+				  *  XAXIDMA_DEVICE_TO_DMA */
+	u32 SpinCount;		/**< Status reads before yielding */
+	u32 MaxYields;		/**< Yields before giving up, 0 for no limit */
+	XAxiDma_PollTimeFn TimeFn;	/**< Time source, may be NULL */
+	void *TimeRef;		/**< Passed to the time source */
+	XAxiDma_PollYieldFn YieldFn;	/**< Yield function, may be NULL */
+	void *YieldRef;		/**< Passed to the yield function */
+	u32 StartTime;		/**< Submission time of the transfer */
+	XAxiDma_PollStats Stats;	/**< Completion statistics */
+} XAxiDma_Poll;
+
 /**
  * The configuration structure for AXI DMA engine
  *
@@ -753,6 +836,23 @@ u32 XAxiDma_SimpleTransfer(XAxiDma *InstancePtr, UINTPTR BuffAddr, u32 Length,
 int XAxiDma_SelectKeyHole(XAxiDma *InstancePtr, int Direction, int Select);
 int XAxiDma_SelectCyclicMode(XAxiDma *InstancePtr, int Direction, int Select);
 int XAxiDma_Selftest(XAxiDma * InstancePtr);
+
+/*
+ * Adaptive completion polling functions in xaxidma_poll.c
+ */
+int XAxiDma_PollInitialize(XAxiDma_Poll *PollPtr, XAxiDma *InstancePtr,
+	int Direction);
+void XAxiDma_PollSetTimeSource(XAxiDma_Poll *PollPtr,
+	XAxiDma_PollTimeFn TimeFn, void *TimeRef);
+void XAxiDma_PollSetYield(XAxiDma_Poll *PollPtr, XAxiDma_PollYieldFn YieldFn,
+	void *YieldRef, u32 MaxYields);
+int XAxiDma_PollCalibrate(XAxiDma_Poll *PollPtr, u32 WindowTicks);
+u32 XAxiDma_PollTransfer(XAxiDma_Poll *PollPtr, UINTPTR BuffAddr,
+	u32 Length);
+int XAxiDma_PollWait(XAxiDma_Poll *PollPtr);
+void XAxiDma_PollGetStats(XAxiDma_Poll *PollPtr, XAxiDma_PollStats *StatsPtr);
+void XAxiDma_PollResetStats(XAxiDma_Poll *PollPtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,9 @@
 * 9.6   rsp  01/11/18  Use UINTPTR for all RegBase instances CR#976392
 *       rsp  01/17/18  Use virtual address for register read/write.
 *                      In _BdRingCreate() assign VA to BdaRestart CR#976392
+* 9.8   agt  10/17/26  Added XAxiDma_BdRingToHwBatch() which commits a set of
+*                      BDs with at most two range cache flushes and a single
+*                      tail descriptor update.
 *
 * </pre>
 ******************************************************************************/
@@ -163,6 +166,7 @@
     }
 
 /************************** Function Prototypes ******************************/
+static void XAxiDma_BdRingUpdateTail(XAxiDma_BdRing * RingPtr);
 
 /************************** Variable Definitions *****************************/
 
@@ -1023,7 +1027,6 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 	int i;
 	u32 BdCr;
 	u32 BdSts;
-	int RingIndex = RingPtr->RingIndex;
 
 	if (NumBd < 0) {
 
@@ -1121,49 +1124,230 @@ int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 
 	/* If it is running, signal the engine to begin processing */
 	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
-			if (RingPtr->Cyclic) {
-				XAxiDma_WriteReg(RingPtr->ChanBase,
-						 XAXIDMA_TDESC_OFFSET,
-						 (u32)XAXIDMA_VIRT_TO_PHYS(RingPtr->CyclicBd));
-				if (RingPtr->Addr_ext)
-					XAxiDma_WriteReg(RingPtr->ChanBase,
-							 XAXIDMA_TDESC_MSB_OFFSET,
-							 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->CyclicBd)));
-				return XST_SUCCESS;
-			}
+		XAxiDma_BdRingUpdateTail(RingPtr);
+	}
 
-			if (RingPtr->IsRxChannel) {
-				if (!RingIndex) {
-					XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
-					if (RingPtr->Addr_ext)
-						XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
-				}
-				else {
-					XAxiDma_WriteReg(RingPtr->ChanBase,
-						(XAXIDMA_RX_TDESC0_OFFSET +
-						(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-						(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK ));
-					if (RingPtr->Addr_ext)
-						XAxiDma_WriteReg(RingPtr->ChanBase,
-							(XAXIDMA_RX_TDESC0_MSB_OFFSET +
-							(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
-							UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
-				}
-			}
-			else {
-				XAxiDma_WriteReg(RingPtr->ChanBase,
-							XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
-				if (RingPtr->Addr_ext)
-					XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
-								UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
-			}
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Enqueue a set of BDs to hardware that were previously allocated by
+ * XAxiDma_BdRingAlloc(), performing the cache maintenance for the whole set
+ * at once. The semantics and the checks are the same as for
+ * XAxiDma_BdRingToHw(), but instead of flushing each BD individually, the
+ * status words of all the BDs in the set are updated first and then the BD
+ * memory is flushed with one range flush, or two if the set wraps around the
+ * end of the ring. The tail descriptor register is written once for the
+ * whole set.
+ *
+ * This is the preferred way of committing large numbers of BDs (for example
+ * when replenishing a receive ring), as it replaces one cache maintenance
+ * operation per BD with at most two per call.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs in the set.
+ * @param	BdSetPtr is the first BD of the set to commit to hardware.
+ *
+ * @return
+ *		- XST_SUCCESS if the set of BDs was accepted and enqueued to
+ *		hardware
+ *		- XST_INVALID_PARAM if passed in NumBd is negative
+ *		- XST_FAILURE if the set of BDs was rejected because the first
+ *		BD does not have its start-of-packet bit set, or the last BD
+ *		does not have its end-of-packet bit set, or any one of the BDs
+ *		has 0 length. No BD is modified in this case.
+ *		- XST_DMA_SG_LIST_ERROR if this function was called out of
+ *		sequence with XAxiDma_BdRingAlloc()
+ *
+ * @note	This function should not be preempted by another XAxiDma ring
+ *		function call that modifies the BD space. It is the caller's
+ *		responsibility to provide a mutual exclusion mechanism.
+ *
+ *		This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingToHwBatch(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
+{
+	XAxiDma_Bd *CurBdPtr;
+	XAxiDma_Bd *LastBdPtr;
+	int i;
+	u32 BdSts;
+
+	if (NumBd < 0) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingToHwBatch: negative BD "
+			"number %d\r\n", NumBd);
+
+		return XST_INVALID_PARAM;
+	}
+
+	/* If the commit set is empty, do nothing */
+	if (NumBd == 0) {
+		return XST_SUCCESS;
+	}
+
+	/* Make sure we are in sync with XAxiDma_BdRingAlloc() */
+	if ((RingPtr->PreCnt < NumBd) || (RingPtr->PreHead != BdSetPtr)) {
+
+		xdbg_printf(XDBG_DEBUG_ERROR, "Bd ring has problems\r\n");
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	/* In case of Tx channel, the first BD should have been marked
+	 * as start-of-frame and the last BD as end-of-frame
+	 */
+	LastBdPtr = BdSetPtr;
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, LastBdPtr, NumBd - 1);
+
+	if (!(RingPtr->IsRxChannel)) {
+		if (!(XAxiDma_BdGetCtrl(BdSetPtr) &
+				XAXIDMA_BD_CTRL_TXSOF_MASK)) {
+
+			xdbg_printf(XDBG_DEBUG_ERROR, "Tx first BD does not "
+							"have SOF\r\n");
+
+			return XST_FAILURE;
+		}
+
+		if (!(XAxiDma_BdGetCtrl(LastBdPtr) &
+				XAXIDMA_BD_CTRL_TXEOF_MASK)) {
+
+			xdbg_printf(XDBG_DEBUG_ERROR, "Tx last BD does not "
+							"have EOF\r\n");
+
+			return XST_FAILURE;
+		}
+	}
+
+	/* Validate the whole set before touching any of the BDs, so that a
+	 * rejected set is left exactly as the caller prepared it
+	 */
+	CurBdPtr = BdSetPtr;
+	for (i = 0; i < NumBd; i++) {
+
+		/* Make sure the length value in the BD is non-zero. */
+		if (XAxiDma_BdGetLength(CurBdPtr,
+				RingPtr->MaxTransferLen) == 0) {
+
+			xdbg_printf(XDBG_DEBUG_ERROR, "0 length bd\r\n");
+
+			return XST_FAILURE;
+		}
+
+		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr,
+								CurBdPtr));
+	}
+
+	/* Clear the completed status bit of every BD in the set, without
+	 * any cache maintenance in between
+	 */
+	CurBdPtr = BdSetPtr;
+	for (i = 0; i < NumBd; i++) {
+		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
+		BdSts &= ~XAXIDMA_BD_STS_COMPLETE_MASK;
+		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
+
+		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr,
+								CurBdPtr));
+	}
+
+	/* Flush the set so DMA core could see the updates. A set that wraps
+	 * around the end of the ring is flushed as two ranges.
+	 */
+	if ((UINTPTR)LastBdPtr >= (UINTPTR)BdSetPtr) {
+		XAXIDMA_CACHE_FLUSH_RANGE(BdSetPtr,
+			((UINTPTR)LastBdPtr - (UINTPTR)BdSetPtr) +
+			XAXIDMA_BD_HW_NUM_BYTES);
+	}
+	else {
+		XAXIDMA_CACHE_FLUSH_RANGE(BdSetPtr,
+			(RingPtr->LastBdAddr - (UINTPTR)BdSetPtr) +
+			XAXIDMA_BD_HW_NUM_BYTES);
+		XAXIDMA_CACHE_FLUSH_RANGE(RingPtr->FirstBdAddr,
+			((UINTPTR)LastBdPtr - RingPtr->FirstBdAddr) +
+			XAXIDMA_BD_HW_NUM_BYTES);
+	}
+	DATA_SYNC;
+
+	/* This set has completed pre-processing, adjust ring pointers and
+	 * counters
+	 */
+	XAXIDMA_RING_SEEKAHEAD(RingPtr, RingPtr->PreHead, NumBd);
+	RingPtr->PreCnt -= NumBd;
+	RingPtr->HwTail = LastBdPtr;
+	RingPtr->HwCnt += NumBd;
+
+	/* If it is running, signal the engine to begin processing */
+	if (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED) {
+		XAxiDma_BdRingUpdateTail(RingPtr);
 	}
 
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+ * Write the tail descriptor register of the channel so that the hardware
+ * processes all the BDs up to and including RingPtr->HwTail. For cyclic
+ * mode the tail descriptor is set to the cyclic BD instead.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @return	None
+ *
+ * @note	This function is used internally by XAxiDma_BdRingToHw() and
+ *		XAxiDma_BdRingToHwBatch() and can be used only when DMA is in
+ *		SG mode.
+ *
+ *****************************************************************************/
+static void XAxiDma_BdRingUpdateTail(XAxiDma_BdRing * RingPtr)
+{
+	int RingIndex = RingPtr->RingIndex;
+
+	if (RingPtr->Cyclic) {
+		XAxiDma_WriteReg(RingPtr->ChanBase,
+				 XAXIDMA_TDESC_OFFSET,
+				 (u32)XAXIDMA_VIRT_TO_PHYS(RingPtr->CyclicBd));
+		if (RingPtr->Addr_ext)
+			XAxiDma_WriteReg(RingPtr->ChanBase,
+					 XAXIDMA_TDESC_MSB_OFFSET,
+					 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->CyclicBd)));
+		return;
+	}
+
+	if (RingPtr->IsRxChannel) {
+		if (!RingIndex) {
+			XAxiDma_WriteReg(RingPtr->ChanBase,
+					XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+			if (RingPtr->Addr_ext)
+				XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
+						 UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+		}
+		else {
+			XAxiDma_WriteReg(RingPtr->ChanBase,
+				(XAXIDMA_RX_TDESC0_OFFSET +
+				(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
+				(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK ));
+			if (RingPtr->Addr_ext)
+				XAxiDma_WriteReg(RingPtr->ChanBase,
+					(XAXIDMA_RX_TDESC0_MSB_OFFSET +
+					(RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET),
+					UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+		}
+	}
+	else {
+		XAxiDma_WriteReg(RingPtr->ChanBase,
+					XAXIDMA_TDESC_OFFSET, (XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail) & XAXIDMA_DESC_LSB_MASK));
+		if (RingPtr->Addr_ext)
+			XAxiDma_WriteReg(RingPtr->ChanBase, XAXIDMA_TDESC_MSB_OFFSET,
+						UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(RingPtr->HwTail)));
+	}
+}
+
 /*****************************************************************************/
 /**
  * Returns a set of BD(s) that have been processed by hardware. The returned
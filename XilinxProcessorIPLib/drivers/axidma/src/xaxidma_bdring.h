@@ -65,6 +65,7 @@
 *		       backward compatibility.
 * 9.2   vak  15/04/16  Fixed the compilation warnings in axidma driver
 * 9.7   rsp  01/11/18  Use UINTPTR instead of u32 for ChanBase CR#976392
+* 9.8   agt  10/17/26  Added XAxiDma_BdRingToHwBatch().
 *
 * </pre>
 *
@@ -521,6 +522,8 @@ int XAxiDma_BdRingUnAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
 		XAxiDma_Bd * BdSetPtr);
 int XAxiDma_BdRingToHw(XAxiDma_BdRing * RingPtr, int NumBd,
 		XAxiDma_Bd * BdSetPtr);
+int XAxiDma_BdRingToHwBatch(XAxiDma_BdRing * RingPtr, int NumBd,
+		XAxiDma_Bd * BdSetPtr);
 int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 		XAxiDma_Bd ** BdSetPtr);
 int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
@@ -0,0 +1,450 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_poll.c
+* @addtogroup axidma_v9_8
+* @{
+*
+* Contains the adaptive completion polling of simple mode transfers. A wait
+* spins on the channel status register for a calibrated number of reads and
+* then alternates between status reads and calls of a yield function. Every
+* completion is recorded in the latency statistics of the channel.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 9.8   agt  10/17/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xaxidma.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * Status register reads timed by XAxiDma_PollCalibrate()
+ */
+#define XAXIDMA_POLL_CAL_READS		64
+
+/*
+ * Status bits which end a wait
+ */
+#define XAXIDMA_POLL_DONE_MASK		(XAXIDMA_IDLE_MASK | \
+					 XAXIDMA_HALTED_MASK | \
+					 XAXIDMA_ERR_ALL_MASK)
+
+/**************************** Type Definitions *******************************/
+
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Default yield, a hint to the processor that this is a spin loop
+ */
+#if defined (__aarch64__) || defined (__arm__)
+#define XAxiDma_PollRelax()	__asm__ __volatile__ ("yield" ::: "memory")
+#else
+#define XAxiDma_PollRelax()
+#endif
+
+/************************** Function Prototypes ******************************/
+
+static void XAxiDma_PollRecord(XAxiDma_Poll *PollPtr, u32 Latency);
+
+/************************** Variable Definitions *****************************/
+
+
+/*****************************************************************************/
+/**
+*
+* Initializes the adaptive polling of one simple mode channel.
+*
+* @param	PollPtr is a pointer to the polling state to initialize.
+* @param	InstancePtr is a pointer to the initialized XAxiDma instance.
+* @param	Direction is the channel, valid values are
+*			- XAXIDMA_DMA_TO_DEVICE.
+*			- XAXIDMA_DEVICE_TO_DMA.
+*
+* @return
+*		- XST_SUCCESS if the polling state is initialized.
+*		- XST_FAILURE if the engine is in scatter gather mode.
+*		- XST_INVALID_PARAM if the channel is not in the hardware.
+*
+* @note		The spin window defaults to XAXIDMA_POLL_DEF_SPIN reads,
+*		without time source, yield function and timeout.
+*
+******************************************************************************/
+int XAxiDma_PollInitialize(XAxiDma_Poll *PollPtr, XAxiDma *InstancePtr,
+	int Direction)
+{
+	Xil_AssertNonvoid(PollPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->Initialized);
+
+	if (XAxiDma_HasSg(InstancePtr)) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "Polling needs simple mode\r\n");
+
+		return XST_FAILURE;
+	}
+
+	if (((Direction == XAXIDMA_DMA_TO_DEVICE) && !InstancePtr->HasMm2S) ||
+	    ((Direction == XAXIDMA_DEVICE_TO_DMA) && !InstancePtr->HasS2Mm) ||
+	    ((Direction != XAXIDMA_DMA_TO_DEVICE) &&
+	     (Direction != XAXIDMA_DEVICE_TO_DMA))) {
+		return XST_INVALID_PARAM;
+	}
+
+	memset(PollPtr, 0, sizeof(XAxiDma_Poll));
+
+	PollPtr->InstancePtr = InstancePtr;
+	PollPtr->Direction = Direction;
+	PollPtr->SpinCount = XAXIDMA_POLL_DEF_SPIN;
+	PollPtr->Stats.LatencyMin = 0xFFFFFFFFU;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the time source used for the spin window calibration and the
+* completion latencies.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	TimeFn returns a free running tick count, NULL to measure
+*		latencies in status register reads.
+* @param	TimeRef is passed to TimeFn.
+*
+* @return	None.
+*
+* @note		The tick count may wrap, only differences are used.
+*
+******************************************************************************/
+void XAxiDma_PollSetTimeSource(XAxiDma_Poll *PollPtr,
+	XAxiDma_PollTimeFn TimeFn, void *TimeRef)
+{
+	Xil_AssertVoid(PollPtr != NULL);
+
+	PollPtr->TimeFn = TimeFn;
+	PollPtr->TimeRef = TimeRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the function called between status reads once the spin window is
+* over, e.g. one calling taskYIELD() under FreeRTOS or executing WFE.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	YieldFn is the yield function, NULL for a processor hint only.
+* @param	YieldRef is passed to YieldFn.
+* @param	MaxYields is the number of yields after which a wait gives up,
+*		0 to wait without limit.
+*
+* @return	None.
+*
+* @note		A WFE based yield function needs an event source such as the
+*		generic timer event stream or an enabled DMA interrupt, the
+*		completion of a polled transfer does not signal an event.
+*
+******************************************************************************/
+void XAxiDma_PollSetYield(XAxiDma_Poll *PollPtr, XAxiDma_PollYieldFn YieldFn,
+	void *YieldRef, u32 MaxYields)
+{
+	Xil_AssertVoid(PollPtr != NULL);
+
+	PollPtr->YieldFn = YieldFn;
+	PollPtr->YieldRef = YieldRef;
+	PollPtr->MaxYields = MaxYields;
+}
+
+/*****************************************************************************/
+/**
+*
+* Derives the spin window from a duration. The cost of a status register
+* read is measured with the time source and SpinCount is set to the number
+* of reads that fit in the window.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	WindowTicks is the spin window in ticks of the time source.
+*
+* @return
+*		- XST_SUCCESS if the spin window is set.
+*		- XST_FAILURE if no time source is set.
+*
+* @note		Calibrate with the same cache and bus configuration that the
+*		transfers run with.
+*
+******************************************************************************/
+int XAxiDma_PollCalibrate(XAxiDma_Poll *PollPtr, u32 WindowTicks)
+{
+	UINTPTR ChanBase;
+	u64 SpinCount;
+	u32 Start;
+	u32 Elapsed;
+	int Index;
+
+	Xil_AssertNonvoid(PollPtr != NULL);
+
+	if (PollPtr->TimeFn == NULL) {
+		return XST_FAILURE;
+	}
+
+	ChanBase = PollPtr->InstancePtr->RegBase +
+			(XAXIDMA_RX_OFFSET * PollPtr->Direction);
+
+	Start = PollPtr->TimeFn(PollPtr->TimeRef);
+	for (Index = 0; Index < XAXIDMA_POLL_CAL_READS; Index++) {
+		(void)XAxiDma_ReadReg(ChanBase, XAXIDMA_SR_OFFSET);
+	}
+	Elapsed = PollPtr->TimeFn(PollPtr->TimeRef) - Start;
+
+	if (Elapsed == 0) {
+		Elapsed = 1;
+	}
+
+	SpinCount = ((u64)WindowTicks * XAXIDMA_POLL_CAL_READS) / Elapsed;
+	if (SpinCount == 0) {
+		SpinCount = 1;
+	}
+	else if (SpinCount > 0xFFFFFFFFU) {
+		SpinCount = 0xFFFFFFFFU;
+	}
+
+	PollPtr->SpinCount = (u32)SpinCount;
+
+	xdbg_printf(XDBG_DEBUG_GENERAL, "Poll: %d ticks per %d reads, spin %d\r\n",
+		Elapsed, XAXIDMA_POLL_CAL_READS, PollPtr->SpinCount);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Submits a simple mode transfer on the channel and records its start time
+* for the latency statistics.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	BuffAddr is the address of the source/destination buffer.
+* @param	Length is the length of the transfer.
+*
+* @return	The status of XAxiDma_SimpleTransfer().
+*
+* @note		Complete the transfer with XAxiDma_PollWait().
+*
+******************************************************************************/
+u32 XAxiDma_PollTransfer(XAxiDma_Poll *PollPtr, UINTPTR BuffAddr,
+	u32 Length)
+{
+	Xil_AssertNonvoid(PollPtr != NULL);
+
+	if (PollPtr->TimeFn != NULL) {
+		PollPtr->StartTime = PollPtr->TimeFn(PollPtr->TimeRef);
+	}
+
+	return XAxiDma_SimpleTransfer(PollPtr->InstancePtr, BuffAddr, Length,
+			PollPtr->Direction);
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits for the transfer submitted with XAxiDma_PollTransfer() to complete.
+* The status register is read SpinCount times back to back, after that the
+* yield function is called before every further read.
+*
+* @param	PollPtr is a pointer to the polling state.
+*
+* @return
+*		- XST_SUCCESS if the transfer completed.
+*		- XST_DMA_ERROR if the channel stopped on an error.
+*		- XST_DEVICE_BUSY if MaxYields was reached, the transfer is
+*		  still in progress.
+*
+* @note		The completion interrupt status is acknowledged, so the
+*		channel interrupts are expected to be disabled.
+*
+******************************************************************************/
+int XAxiDma_PollWait(XAxiDma_Poll *PollPtr)
+{
+	UINTPTR ChanBase;
+	u32 Status;
+	u32 Reads = 0;
+	u32 Yields = 0;
+	u32 Latency;
+
+	Xil_AssertNonvoid(PollPtr != NULL);
+
+	ChanBase = PollPtr->InstancePtr->RegBase +
+			(XAXIDMA_RX_OFFSET * PollPtr->Direction);
+
+	while (1) {
+		Status = XAxiDma_ReadReg(ChanBase, XAXIDMA_SR_OFFSET);
+		Reads++;
+
+		if (Status & XAXIDMA_POLL_DONE_MASK) {
+			break;
+		}
+
+		if (Reads < PollPtr->SpinCount) {
+			continue;
+		}
+
+		if ((PollPtr->MaxYields != 0) &&
+		    (Yields >= PollPtr->MaxYields)) {
+			PollPtr->Stats.Yields += Yields;
+			PollPtr->Stats.Timeouts++;
+
+			return XST_DEVICE_BUSY;
+		}
+
+		if (PollPtr->YieldFn != NULL) {
+			PollPtr->YieldFn(PollPtr->YieldRef);
+		}
+		else {
+			XAxiDma_PollRelax();
+		}
+		Yields++;
+	}
+
+	PollPtr->Stats.Yields += Yields;
+
+	if (Status & (XAXIDMA_HALTED_MASK | XAXIDMA_ERR_ALL_MASK)) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "Poll: channel error %x\r\n",
+			Status);
+		PollPtr->Stats.Errors++;
+
+		return XST_DMA_ERROR;
+	}
+
+	XAxiDma_IntrAckIrq(PollPtr->InstancePtr, XAXIDMA_IRQ_IOC_MASK,
+		PollPtr->Direction);
+
+	if (PollPtr->TimeFn != NULL) {
+		Latency = PollPtr->TimeFn(PollPtr->TimeRef) -
+				PollPtr->StartTime;
+	}
+	else {
+		Latency = Reads;
+	}
+
+	if (Yields == 0) {
+		PollPtr->Stats.Spun++;
+	}
+	else {
+		PollPtr->Stats.Yielded++;
+	}
+	XAxiDma_PollRecord(PollPtr, Latency);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies the completion statistics of the channel.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	StatsPtr is the structure to contain the statistics.
+*
+* @return	None.
+*
+* @note		The average latency is LatencySum / Count.
+*
+******************************************************************************/
+void XAxiDma_PollGetStats(XAxiDma_Poll *PollPtr, XAxiDma_PollStats *StatsPtr)
+{
+	Xil_AssertVoid(PollPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	memcpy(StatsPtr, &PollPtr->Stats, sizeof(XAxiDma_PollStats));
+}
+
+/*****************************************************************************/
+/**
+*
+* Clears the completion statistics of the channel.
+*
+* @param	PollPtr is a pointer to the polling state.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XAxiDma_PollResetStats(XAxiDma_Poll *PollPtr)
+{
+	Xil_AssertVoid(PollPtr != NULL);
+
+	memset(&PollPtr->Stats, 0, sizeof(XAxiDma_PollStats));
+	PollPtr->Stats.LatencyMin = 0xFFFFFFFFU;
+}
+
+/*****************************************************************************/
+/*
+*
+* Adds a completion latency to the statistics.
+*
+* @param	PollPtr is a pointer to the polling state.
+* @param	Latency is the completion latency.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XAxiDma_PollRecord(XAxiDma_Poll *PollPtr, u32 Latency)
+{
+	XAxiDma_PollStats *StatsPtr = &PollPtr->Stats;
+	u32 Bucket = 0;
+	u32 Value = Latency;
+
+	while ((Value != 0) && (Bucket < (XAXIDMA_POLL_HIST_BUCKETS - 1))) {
+		Value >>= 1;
+		Bucket++;
+	}
+
+	StatsPtr->Hist[Bucket]++;
+	StatsPtr->Count++;
+	StatsPtr->LatencySum += Latency;
+	if (Latency < StatsPtr->LatencyMin) {
+		StatsPtr->LatencyMin = Latency;
+	}
+	if (Latency > StatsPtr->LatencyMax) {
+		StatsPtr->LatencyMax = Latency;
+	}
+}
+/** @} */
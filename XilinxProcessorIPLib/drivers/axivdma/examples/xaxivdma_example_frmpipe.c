@@ -0,0 +1,567 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xaxivdma_example_frmpipe.c
+ *
+ * This example demonstrates how to use the frame pipeline layer of the AXI
+ * Video DMA driver. The write channel captures into a ring of three frame
+ * stores and the read channel displays the newest complete frame, so that a
+ * frame is never read and written at the same time. The main loop borrows
+ * ready frames from the pipeline, marks them in place and queues them for
+ * display, and finally prints the pipeline statistics.
+ *
+ * Like xaxivdma_example_intr.c this example does not work by itself. It needs
+ * a video source IP on the S2MM side and a video sink IP on the MM2S side.
+ *
+ * @note
+ * The values of DDR_BASE_ADDR and DDR_HIGH_ADDR should be as per the HW system.
+ * The hardware has to be built in direct register mode with at least three
+ * frame stores.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -------------------------------------------------------
+ * 6.6   agt  10/17/26 First release
+ * </pre>
+ *
+ * ***************************************************************************
+ */
+
+#include "xaxivdma.h"
+#include "xparameters.h"
+#include "xil_exception.h"
+#include "xil_cache.h"
+#include "xil_printf.h"
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+#include "xintc.h"
+#else
+#include "xscugic.h"
+#endif
+
+/******************** Constant Definitions **********************************/
+
+/*
+ * Device related constants. These need to defined as per the HW system.
+ */
+#define DMA_DEVICE_ID		XPAR_AXIVDMA_0_DEVICE_ID
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+#define INTC_DEVICE_ID		XPAR_INTC_0_DEVICE_ID
+#define WRITE_INTR_ID		XPAR_INTC_0_AXIVDMA_0_S2MM_INTROUT_VEC_ID
+#define READ_INTR_ID		XPAR_INTC_0_AXIVDMA_0_MM2S_INTROUT_VEC_ID
+#else
+#define INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
+#define WRITE_INTR_ID		XPAR_FABRIC_AXIVDMA_0_S2MM_INTROUT_VEC_ID
+#define READ_INTR_ID		XPAR_FABRIC_AXIVDMA_0_MM2S_INTROUT_VEC_ID
+#endif
+
+#ifdef XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#define DDR_BASE_ADDR		XPAR_AXI_7SDDR_0_S_AXI_BASEADDR
+#elif XPAR_MIG7SERIES_0_BASEADDR
+#define DDR_BASE_ADDR		XPAR_MIG7SERIES_0_BASEADDR
+#elif XPAR_MIG_0_BASEADDR
+#define DDR_BASE_ADDR		XPAR_MIG_0_BASEADDR
+#else
+#warning CHECK FOR THE VALID DDR ADDRESS IN XPARAMETERS.H, \
+			DEFAULT SET TO 0x01000000
+#define DDR_BASE_ADDR		0x10000000
+#endif
+
+#define MEM_BASE_ADDR		(DDR_BASE_ADDR + 0x01000000)
+
+/* Frame size related constants
+ */
+#define FRAME_HORIZONTAL_LEN	0x1E00	/* 1920 pixels, each pixel 4 bytes */
+#define FRAME_VERTICAL_LEN	0x438	/* 1080 pixels */
+#define FRAME_SIZE		(FRAME_HORIZONTAL_LEN * FRAME_VERTICAL_LEN)
+
+/* Number of frame stores in the pipeline, three is triple buffering
+ */
+#define NUM_PIPE_FRAMES		3
+
+/* Number of frames the main loop processes before the example ends
+ */
+#define NUM_TEST_FRAMES		300
+
+/* Number of lines of the marker drawn into every processed frame
+ */
+#define MARKER_LINES		8
+
+/*
+ * Device instance definitions
+ */
+XAxiVdma AxiVdma;
+static XAxiVdma_FrmPipe FrmPipe;
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+static XIntc Intc;	/* Instance of the Interrupt Controller */
+#else
+static XScuGic Intc;	/* Instance of the Interrupt Controller */
+#endif
+
+/* DMA channel setup
+ */
+static XAxiVdma_DmaSetup ReadCfg;
+static XAxiVdma_DmaSetup WriteCfg;
+
+/* Frame ready notification from the pipeline
+ */
+static volatile int FrameReady;
+
+/******************* Function Prototypes ************************************/
+
+static void ChannelSetup(XAxiVdma_DmaSetup *CfgPtr);
+static void ProcessFrame(UINTPTR Addr, u32 Count);
+static void PrintStats(XAxiVdma_FrmPipe *PipePtr);
+
+static int SetupIntrSystem(XAxiVdma *AxiVdmaPtr, u16 ReadIntrId,
+				u16 WriteIntrId);
+
+static void DisableIntrSystem(u16 ReadIntrId, u16 WriteIntrId);
+
+static void FrameReadyCallBack(void *CallbackRef, u32 FrameIndex);
+
+/*****************************************************************************/
+/**
+*
+* Main function
+*
+* This function sets up the DMA engine and the frame pipeline, starts both
+* channels and processes NUM_TEST_FRAMES captured frames before it prints
+* the pipeline statistics.
+*
+* @return
+*		- XST_SUCCESS if example finishes successfully
+*		- XST_FAILURE if example fails.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+	XAxiVdma_Config *Config;
+	UINTPTR FrameAddr[NUM_PIPE_FRAMES];
+	UINTPTR Addr;
+	u32 FrameIndex;
+	u32 Count;
+	u32 Index;
+
+	xil_printf("\r\n--- Entering main() --- \r\n");
+
+	Config = XAxiVdma_LookupConfig(DMA_DEVICE_ID);
+	if (!Config) {
+		xil_printf(
+		    "No video DMA found for ID %d\r\n", DMA_DEVICE_ID);
+
+		return XST_FAILURE;
+	}
+
+	Status = XAxiVdma_CfgInitialize(&AxiVdma, Config, Config->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+		    "Configuration Initialization failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Frame stores of the pipeline, these are physical addresses
+	 */
+	for (Index = 0; Index < NUM_PIPE_FRAMES; Index++) {
+		FrameAddr[Index] = MEM_BASE_ADDR + Index * FRAME_SIZE;
+	}
+
+	Status = XAxiVdma_FrmPipeInitialize(&FrmPipe, &AxiVdma, FrameAddr,
+			NUM_PIPE_FRAMES, XAXIVDMA_FRMPIPE_LATEST);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+		    "Frame pipeline initialization failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	XAxiVdma_FrmPipeSetReadyCallBack(&FrmPipe, FrameReadyCallBack, NULL);
+
+	Status = SetupIntrSystem(&AxiVdma, READ_INTR_ID, WRITE_INTR_ID);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+		    "Setup interrupt system failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	ChannelSetup(&WriteCfg);
+	ChannelSetup(&ReadCfg);
+
+	Status = XAxiVdma_FrmPipeStart(&FrmPipe, &WriteCfg, &ReadCfg);
+	if (Status != XST_SUCCESS) {
+		xil_printf(
+		    "Frame pipeline start failed %d\r\n", Status);
+
+		return XST_FAILURE;
+	}
+
+	/* Borrow every ready frame, mark it and queue it for display. The
+	 * channels keep running on the other frame stores meanwhile.
+	 */
+	Count = 0;
+	while (Count < NUM_TEST_FRAMES) {
+		while (!FrameReady) {
+		}
+		FrameReady = 0;
+
+		Status = XAxiVdma_FrmPipeLend(&FrmPipe, &FrameIndex, &Addr);
+		if (Status != XST_SUCCESS) {
+			/* Already taken by the display */
+			continue;
+		}
+
+		ProcessFrame(Addr, Count);
+
+		Status = XAxiVdma_FrmPipeSubmit(&FrmPipe, FrameIndex);
+		if (Status != XST_SUCCESS) {
+			xil_printf("Frame submit failed %d\r\n", Status);
+			break;
+		}
+
+		Count++;
+	}
+
+	XAxiVdma_FrmPipeStop(&FrmPipe);
+	DisableIntrSystem(READ_INTR_ID, WRITE_INTR_ID);
+
+	PrintStats(&FrmPipe);
+
+	if ((Status != XST_SUCCESS) || (FrmPipe.Stats.Errors != 0)) {
+		xil_printf("Frame pipeline Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran Frame pipeline Example\r\n");
+
+	xil_printf("--- Exiting main() --- \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function fills in the channel setup. The frame store, park and frame
+* counter fields are set by the frame pipeline.
+*
+* @param	CfgPtr is the channel setup to fill in.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void ChannelSetup(XAxiVdma_DmaSetup *CfgPtr)
+{
+	CfgPtr->VertSizeInput = FRAME_VERTICAL_LEN;
+	CfgPtr->HoriSizeInput = FRAME_HORIZONTAL_LEN;
+
+	CfgPtr->Stride = FRAME_HORIZONTAL_LEN;
+	CfgPtr->FrameDelay = 0;
+
+	CfgPtr->EnableSync = 0;  /* No Gen-Lock */
+	CfgPtr->PointNum = 0;    /* No Gen-Lock */
+	CfgPtr->GenLockRepeat = 0;
+
+	/* Set Vertical Flip state to IP default */
+	CfgPtr->EnableVFlip = 1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function processes a borrowed frame in place. It draws a marker on
+* the top lines of the frame whose width follows the frame count.
+*
+* @param	Addr is the start address of the frame.
+* @param	Count is the number of frames processed so far.
+*
+* @return	None.
+*
+* @note		The frame is read from and written back to memory, so the
+*		cache lines of the marker are invalidated before and flushed
+*		after the update.
+*
+******************************************************************************/
+static void ProcessFrame(UINTPTR Addr, u32 Count)
+{
+	u32 *LinePtr;
+	u32 Width;
+	u32 Line;
+	u32 Pixel;
+
+	Width = (Count % (FRAME_HORIZONTAL_LEN / 4)) + 1;
+
+	Xil_DCacheInvalidateRange(Addr, FRAME_HORIZONTAL_LEN * MARKER_LINES);
+
+	for (Line = 0; Line < MARKER_LINES; Line++) {
+		LinePtr = (u32 *)(Addr + Line * FRAME_HORIZONTAL_LEN);
+		for (Pixel = 0; Pixel < Width; Pixel++) {
+			LinePtr[Pixel] = ~LinePtr[Pixel];
+		}
+	}
+
+	Xil_DCacheFlushRange(Addr, FRAME_HORIZONTAL_LEN * MARKER_LINES);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function prints the frame pipeline statistics.
+*
+* @param	PipePtr is the frame pipeline.
+*
+* @return	None.
+*
+* @note		Latencies are in frame periods of the write channel.
+*
+******************************************************************************/
+static void PrintStats(XAxiVdma_FrmPipe *PipePtr)
+{
+	XAxiVdma_FrmPipeStats Stats;
+	u32 Average = 0;
+
+	XAxiVdma_FrmPipeGetStats(PipePtr, &Stats);
+
+	if (Stats.LatencyCnt != 0) {
+		Average = (u32)(Stats.LatencySum / Stats.LatencyCnt);
+	}
+
+	xil_printf("Captured %d Displayed %d Lent %d\r\n",
+	    Stats.Captured, Stats.Displayed, Stats.Lent);
+	xil_printf("Dropped %d Repeated %d Late %d Errors %d\r\n",
+	    Stats.Dropped, Stats.Repeated, Stats.Late, Stats.Errors);
+	if (Stats.LatencyCnt != 0) {
+		xil_printf("Latency min %d avg %d max %d frames\r\n",
+		    Stats.LatencyMin, Average, Stats.LatencyMax);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up the interrupt system so interrupts can occur for the
+* DMA. The frame pipeline installs its own channel callbacks, the driver
+* interrupt handlers are connected as usual.
+*
+* @param	AxiVdmaPtr is the pointer to the instance of the DMA engine
+* @param	ReadIntrId is the read channel Interrupt ID.
+* @param	WriteIntrId is the write channel Interrupt ID.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+******************************************************************************/
+static int SetupIntrSystem(XAxiVdma *AxiVdmaPtr, u16 ReadIntrId,
+				u16 WriteIntrId)
+{
+	int Status;
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+	XIntc *IntcInstancePtr =&Intc;
+
+
+	/* Initialize the interrupt controller and connect the ISRs */
+	Status = XIntc_Initialize(IntcInstancePtr, INTC_DEVICE_ID);
+	if (Status != XST_SUCCESS) {
+
+		xil_printf( "Failed init intc\r\n");
+		return XST_FAILURE;
+	}
+
+	Status = XIntc_Connect(IntcInstancePtr, ReadIntrId,
+	         (XInterruptHandler)XAxiVdma_ReadIntrHandler, AxiVdmaPtr);
+	if (Status != XST_SUCCESS) {
+
+		xil_printf(
+		    "Failed read channel connect intc %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	Status = XIntc_Connect(IntcInstancePtr, WriteIntrId,
+	         (XInterruptHandler)XAxiVdma_WriteIntrHandler, AxiVdmaPtr);
+	if (Status != XST_SUCCESS) {
+
+		xil_printf(
+		    "Failed write channel connect intc %d\r\n", Status);
+		return XST_FAILURE;
+	}
+
+	/* Start the interrupt controller */
+	Status = XIntc_Start(IntcInstancePtr, XIN_REAL_MODE);
+	if (Status != XST_SUCCESS) {
+
+		xil_printf( "Failed to start intc\r\n");
+		return XST_FAILURE;
+	}
+
+	/* Enable interrupts from the hardware */
+	XIntc_Enable(IntcInstancePtr, ReadIntrId);
+	XIntc_Enable(IntcInstancePtr, WriteIntrId);
+
+	Xil_ExceptionInit();
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XIntc_InterruptHandler,
+			(void *)IntcInstancePtr);
+
+	Xil_ExceptionEnable();
+
+#else
+
+	XScuGic *IntcInstancePtr = &Intc;	/* Instance of the Interrupt Controller */
+	XScuGic_Config *IntcConfig;
+
+
+	/*
+	 * Initialize the interrupt controller driver so that it is ready to
+	 * use.
+	 */
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (NULL == IntcConfig) {
+		return XST_FAILURE;
+	}
+
+	Status = XScuGic_CfgInitialize(IntcInstancePtr, IntcConfig,
+					IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XScuGic_SetPriorityTriggerType(IntcInstancePtr, ReadIntrId, 0xA0, 0x3);
+	XScuGic_SetPriorityTriggerType(IntcInstancePtr, WriteIntrId, 0xA0, 0x3);
+
+	/*
+	 * Connect the device driver handler that will be called when an
+	 * interrupt for the device occurs, the handler defined above performs
+	 * the specific interrupt processing for the device.
+	 */
+	Status = XScuGic_Connect(IntcInstancePtr, ReadIntrId,
+				(Xil_InterruptHandler)XAxiVdma_ReadIntrHandler,
+				AxiVdmaPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	Status = XScuGic_Connect(IntcInstancePtr, WriteIntrId,
+				(Xil_InterruptHandler)XAxiVdma_WriteIntrHandler,
+				AxiVdmaPtr);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	/*
+	 * Enable the interrupt for the DMA device.
+	 */
+	XScuGic_Enable(IntcInstancePtr, ReadIntrId);
+	XScuGic_Enable(IntcInstancePtr, WriteIntrId);
+
+	Xil_ExceptionInit();
+
+	/*
+	 * Connect the interrupt controller interrupt handler to the hardware
+	 * interrupt handling logic in the processor.
+	 */
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_IRQ_INT,
+				(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+				IntcInstancePtr);
+
+
+	/*
+	 * Enable interrupts in the Processor.
+	 */
+	Xil_ExceptionEnable();
+
+
+#endif
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function disables the interrupts
+*
+* @param	ReadIntrId is interrupt ID associated w/ DMA read channel
+* @param	WriteIntrId is interrupt ID associated w/ DMA write channel
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void DisableIntrSystem(u16 ReadIntrId, u16 WriteIntrId)
+{
+
+#ifdef XPAR_INTC_0_DEVICE_ID
+	XIntc *IntcInstancePtr =&Intc;
+
+	/* Disconnect the interrupts for the DMA TX and RX channels */
+	XIntc_Disconnect(IntcInstancePtr, ReadIntrId);
+	XIntc_Disconnect(IntcInstancePtr, WriteIntrId);
+#else
+	XScuGic *IntcInstancePtr = &Intc;
+
+	XScuGic_Disable(IntcInstancePtr, ReadIntrId);
+	XScuGic_Disable(IntcInstancePtr, WriteIntrId);
+
+	XScuGic_Disconnect(IntcInstancePtr, ReadIntrId);
+	XScuGic_Disconnect(IntcInstancePtr, WriteIntrId);
+#endif
+}
+
+/*****************************************************************************/
+/*
+ * Ready callback of the frame pipeline, called from the write channel
+ * interrupt when a captured frame becomes ready.
+ *
+ * @param	CallbackRef is the call back reference pointer
+ * @param	FrameIndex is the index of the ready frame
+ *
+ * @return	None
+*
+******************************************************************************/
+static void FrameReadyCallBack(void *CallbackRef, u32 FrameIndex)
+{
+	(void)CallbackRef;
+	(void)FrameIndex;
+
+	FrameReady = 1;
+}
@@ -121,6 +121,20 @@
 * Each channel has two interrupt callback functions. One for IOC and delay
 * interrupt, or general interrupt; one for error interrupt.
 *
+* <b>Frame Pipeline</b>
+*
+* XAxiVdma_FrmPipeInitialize() and XAxiVdma_FrmPipeStart() put both
+* channels into park mode over a ring of N frame stores and rotate the frames
+* from the frame count interrupts. The write channel always parks on a free
+* frame. A completed frame becomes ready and the read channel is moved to the
+* oldest ready frame at the end of each frame it displayed. Ready frames can
+* be lent to the application without copying (XAxiVdma_FrmPipeLend()) and
+* handed back, or submitted for display (XAxiVdma_FrmPipeSubmit()). Captured,
+* displayed, dropped, repeated and late frames, and the capture to display
+* latency are counted in XAxiVdma_FrmPipeStats. The pipeline replaces Gen-Lock
+* with its park pointer control, so the setups passed to
+* XAxiVdma_FrmPipeStart() must not enable Gen-Lock.
+*
 * <b>Reset</b>
 *
 * Reset a DMA channel causes the channel enter the following state:
@@ -298,6 +312,8 @@
 *                     definitions of axivdma in xparameters.h
 *       ms   08/07/17 Fixed compilation warnings in xaxivdma_sinit.c
 * 6.6   rsp  07/02/18 Add vertical flip states in config structures
+* 6.6   agt  10/17/26 Added frame pipeline layer (XAxiVdma_FrmPipe*) in
+*                     xaxivdma_frmpipe.c
 *
 * </pre>
 *
@@ -377,6 +393,23 @@ extern "C" {
 #define XST_VDMA_MISMATCH_ERROR 1430
 #endif
 
+/**
+ * Frame pipeline constants
+ */
+#define XAXIVDMA_FRMPIPE_MAX_FRAMES	(XAXIVDMA_FRM_MAX + 1)
+					/**< Frames a park pointer can reach */
+#define XAXIVDMA_FRMPIPE_MIN_FRAMES	3   /**< Writer, reader and spare */
+#define XAXIVDMA_FRMPIPE_NO_FRAME	0xFFFFFFFFU /**< No frame index */
+
+#define XAXIVDMA_FRMPIPE_LATEST		0   /**< Only newest ready frame kept */
+#define XAXIVDMA_FRMPIPE_QUEUED		1   /**< Ready frames kept in order */
+
+#define XAXIVDMA_FRMPIPE_FREE		0   /**< Frame is unused */
+#define XAXIVDMA_FRMPIPE_WRITING	1   /**< Write channel parks on it */
+#define XAXIVDMA_FRMPIPE_READY		2   /**< Complete, not consumed */
+#define XAXIVDMA_FRMPIPE_READING	3   /**< Read channel parks on it */
+#define XAXIVDMA_FRMPIPE_LENT		4   /**< Owned by the application */
+
 /**************************** Type Definitions *******************************/
 
 /*****************************************************************************/
@@ -512,6 +545,55 @@ typedef struct {
     void *ErrRef;                         /**< Call back ref */
 } XAxiVdma_ChannelCallBack;
 
+/*****************************************************************************/
+/**
+ * Time source of the frame pipeline latency counters.
+ *
+ * @param   TimeRef is the reference given with the time source.
+ *
+ * @return  A free running time stamp in any unit.
+ *****************************************************************************/
+typedef u32 (*XAxiVdma_FrmPipeTimeFn) (void *TimeRef);
+
+/*****************************************************************************/
+/**
+ * Callback type for a frame of the frame pipeline becoming ready.
+ *
+ * @param   CallBackRef is the reference given with the callback.
+ * @param   FrameIndex is the index of the ready frame.
+ *****************************************************************************/
+typedef void (*XAxiVdma_FrmPipeCallBack) (void *CallBackRef, u32 FrameIndex);
+
+/**
+ * One frame store of the frame pipeline.
+ */
+typedef struct {
+    UINTPTR Addr;       /**< Start address of the frame store */
+    u32 State;          /**< XAXIVDMA_FRMPIPE_FREE .. _LENT */
+    u32 Seq;            /**< Sequence number of the frame content */
+    u32 Stamp;          /**< Time the frame content became ready */
+    u32 IsStamped;      /**< Stamp is valid */
+} XAxiVdma_FrmPipeFrame;
+
+/**
+ * Frame pipeline counters. Latencies are in the unit of the time source,
+ * in frame periods when no time source is set.
+ */
+typedef struct {
+    u32 Captured;       /**< Frames completed by the write channel */
+    u32 Displayed;      /**< Frames handed to the read channel */
+    u32 Lent;           /**< Ready frames lent to the application */
+    u32 Dropped;        /**< Ready frames overwritten before use */
+    u32 Repeated;       /**< Read frames shown again, nothing was ready */
+    u32 Late;           /**< Frames consumed above the late limit */
+    u32 Errors;         /**< Channel error interrupts */
+    u32 LatencyLast;    /**< Latency of the last consumed frame */
+    u32 LatencyMin;     /**< Minimum latency */
+    u32 LatencyMax;     /**< Maximum latency */
+    u64 LatencySum;     /**< Sum of all latencies */
+    u32 LatencyCnt;     /**< Number of latencies in the sum */
+} XAxiVdma_FrmPipeStats;
+
 /**
  * The XAxiVdma driver instance data.
  */
@@ -538,6 +620,36 @@ typedef struct {
 	int AddrWidth;		  /**< Address Width */
 } XAxiVdma;
 
+/**
+ * The frame pipeline instance data. It drives the park pointers of both
+ * channels of one XAxiVdma instance.
+ */
+typedef struct {
+    XAxiVdma *InstancePtr;      /**< VDMA the pipeline works on */
+    int IsReady;                /**< Pipeline is initialized */
+    int IsStarted;              /**< Channels are running */
+    u32 NumFrames;              /**< Frames in the ring */
+    u32 Policy;                 /**< XAXIVDMA_FRMPIPE_LATEST or _QUEUED */
+    XAxiVdma_FrmPipeFrame Frame[XAXIVDMA_FRMPIPE_MAX_FRAMES];
+                                /**< Frame stores */
+    u8 Ready[XAXIVDMA_FRMPIPE_MAX_FRAMES];
+                                /**< Ready frames, oldest first */
+    u32 ReadyHead;              /**< Index of the oldest ready frame */
+    u32 ReadyCnt;               /**< Number of ready frames */
+    u32 WriteFrame;             /**< Write channel park frame */
+    u32 ReadFrame;              /**< Read channel park frame */
+    u32 HasWrite;               /**< Write channel is part of the pipe */
+    u32 HasRead;                /**< Read channel is part of the pipe */
+    u32 Seq;                    /**< Sequence number of the next frame */
+    u32 FrameClock;             /**< Frame periods, default time source */
+    u32 LateLimit;              /**< Latency above which a frame is late */
+    XAxiVdma_FrmPipeTimeFn TimeFn;      /**< Optional time source */
+    void *TimeRef;                      /**< Time source reference */
+    XAxiVdma_FrmPipeCallBack ReadyCallBack;  /**< Optional ready callback */
+    void *ReadyRef;                          /**< Ready callback reference */
+    XAxiVdma_FrmPipeStats Stats;        /**< Counters */
+} XAxiVdma_FrmPipe;
+
 
 /************************** Function Prototypes ******************************/
 /* Initialization */
@@ -610,6 +722,27 @@ int XAxiVdma_SetCallBack(XAxiVdma * InstancePtr, u32 HandlerType,
         void *CallBackFunc, void *CallBackRef, u16 Direction);
 int XAxiVdma_Selftest(XAxiVdma * InstancePtr);
 
+/* Frame pipeline */
+int XAxiVdma_FrmPipeInitialize(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma *InstancePtr, UINTPTR *FrameAddr, u32 NumFrames,
+        u32 Policy);
+void XAxiVdma_FrmPipeSetTimeSource(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeTimeFn TimeFn, void *TimeRef, u32 LateLimit);
+void XAxiVdma_FrmPipeSetReadyCallBack(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeCallBack CallBackFunc, void *CallBackRef);
+int XAxiVdma_FrmPipeStart(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_DmaSetup *WriteCfgPtr, XAxiVdma_DmaSetup *ReadCfgPtr);
+void XAxiVdma_FrmPipeStop(XAxiVdma_FrmPipe *PipePtr);
+int XAxiVdma_FrmPipeLend(XAxiVdma_FrmPipe *PipePtr, u32 *FrameIndexPtr,
+        UINTPTR *AddrPtr);
+int XAxiVdma_FrmPipeAcquire(XAxiVdma_FrmPipe *PipePtr, u32 *FrameIndexPtr,
+        UINTPTR *AddrPtr);
+int XAxiVdma_FrmPipeSubmit(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex);
+int XAxiVdma_FrmPipeReturn(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex);
+void XAxiVdma_FrmPipeGetStats(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeStats *StatsPtr);
+void XAxiVdma_FrmPipeResetStats(XAxiVdma_FrmPipe *PipePtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,975 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xaxivdma_frmpipe.c
+* @addtogroup axivdma_v6_6
+* @{
+*
+* Implementation of the frame pipeline layer. The pipeline runs the channels
+* of one VDMA in park mode and moves their park pointers over a ring of frame
+* stores from the frame count interrupts, so that the write channel never
+* writes into a frame which is being read or is lent to the application.
+*
+* Park pointer updates take effect at the next frame start. The frame count
+* interrupts therefore have to be serviced within the vertical blanking,
+* otherwise a channel works on its old frame for one more frame period.
+*
+* Gen-Lock is not supported; XAxiVdma_FrmPipeStart() rejects a setup with
+* EnableSync set. Gen-Lock lets the hardware pick the frame of the slave
+* channel from the frame pointer of its master over the whole circular
+* frame store ring. The pipeline takes frames out of that ring while they
+* are ready, queued or lent to the application, and Gen-Lock has no way to
+* skip them. The park pointers, moved by software at each frame count
+* interrupt, give the same guarantee that the two channels never work on
+* the same frame, and honour the frame ownership as well. The channels
+* therefore run free, and the frame count interrupts are their only
+* synchronization.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 6.6   agt  10/17/26 First release
+*                     Reject Gen-Lock setups in XAxiVdma_FrmPipeStart()
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xaxivdma.h"
+#include "xaxivdma_i.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XAXIVDMA_FRMPIPE_INTR_MASK	(XAXIVDMA_IXR_FRMCNT_MASK | \
+					 XAXIVDMA_IXR_ERROR_MASK)
+
+/************************** Function Prototypes ******************************/
+
+static void XAxiVdma_FrmPipeLock(XAxiVdma_FrmPipe *PipePtr);
+static void XAxiVdma_FrmPipeUnlock(XAxiVdma_FrmPipe *PipePtr);
+static void XAxiVdma_FrmPipePark(XAxiVdma_FrmPipe *PipePtr, u16 Direction,
+        u32 FrameIndex);
+static u32 XAxiVdma_FrmPipeNow(XAxiVdma_FrmPipe *PipePtr);
+static u32 XAxiVdma_FrmPipeFindFree(XAxiVdma_FrmPipe *PipePtr);
+static void XAxiVdma_FrmPipePush(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex);
+static u32 XAxiVdma_FrmPipePop(XAxiVdma_FrmPipe *PipePtr);
+static void XAxiVdma_FrmPipeDropReady(XAxiVdma_FrmPipe *PipePtr);
+static void XAxiVdma_FrmPipeConsume(XAxiVdma_FrmPipe *PipePtr,
+        u32 FrameIndex);
+static int XAxiVdma_FrmPipeStartChannel(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_DmaSetup *CfgPtr, u16 Direction, u32 FrameIndex);
+static void XAxiVdma_FrmPipeWriteCallBack(void *CallBackRef, u32 Mask);
+static void XAxiVdma_FrmPipeReadCallBack(void *CallBackRef, u32 Mask);
+static void XAxiVdma_FrmPipeErrCallBack(void *CallBackRef, u32 Mask);
+
+/*****************************************************************************/
+/**
+ * Initialize a frame pipeline over a set of frame stores
+ *
+ * @param PipePtr is the pointer to the frame pipeline to initialize
+ * @param InstancePtr is the pointer to an initialized DMA engine
+ * @param FrameAddr is the array of frame store start addresses, physical
+ *        addresses
+ * @param NumFrames is the number of frame stores in FrameAddr
+ * @param Policy is XAXIVDMA_FRMPIPE_LATEST to keep only the newest ready
+ *        frame, for the lowest latency, or XAXIVDMA_FRMPIPE_QUEUED to keep
+ *        every ready frame until it is displayed or the writer needs it
+ *
+ * @return
+ * - XST_SUCCESS if the pipeline is initialized
+ * - XST_INVALID_PARAM if the number of frames or the policy is not valid
+ *
+ * @note
+ * NumFrames has to be within XAXIVDMA_FRMPIPE_MIN_FRAMES and the number of
+ * frame stores of the hardware, which is at most XAXIVDMA_FRMPIPE_MAX_FRAMES.
+ *****************************************************************************/
+int XAxiVdma_FrmPipeInitialize(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma *InstancePtr, UINTPTR *FrameAddr, u32 NumFrames,
+        u32 Policy)
+{
+	u32 Index;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XAXIVDMA_DEVICE_READY);
+	Xil_AssertNonvoid(FrameAddr != NULL);
+
+	if ((NumFrames < XAXIVDMA_FRMPIPE_MIN_FRAMES) ||
+	    (NumFrames > XAXIVDMA_FRMPIPE_MAX_FRAMES) ||
+	    (NumFrames > (u32)InstancePtr->MaxNumFrames)) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "Invalid number of pipeline frames %d\r\n", NumFrames);
+
+		return XST_INVALID_PARAM;
+	}
+
+	if ((Policy != XAXIVDMA_FRMPIPE_LATEST) &&
+	    (Policy != XAXIVDMA_FRMPIPE_QUEUED)) {
+		return XST_INVALID_PARAM;
+	}
+
+	memset(PipePtr, 0, sizeof(XAxiVdma_FrmPipe));
+
+	PipePtr->InstancePtr = InstancePtr;
+	PipePtr->NumFrames = NumFrames;
+	PipePtr->Policy = Policy;
+	PipePtr->WriteFrame = XAXIVDMA_FRMPIPE_NO_FRAME;
+	PipePtr->ReadFrame = XAXIVDMA_FRMPIPE_NO_FRAME;
+	PipePtr->LateLimit = 1;
+	PipePtr->Stats.LatencyMin = 0xFFFFFFFFU;
+
+	for (Index = 0; Index < NumFrames; Index++) {
+		PipePtr->Frame[Index].Addr = FrameAddr[Index];
+		PipePtr->Frame[Index].State = XAXIVDMA_FRMPIPE_FREE;
+	}
+
+	PipePtr->IsReady = XAXIVDMA_DEVICE_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Set the time source of the latency counters
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param TimeFn is the time source, NULL to count latencies in frame periods
+ *        of the write channel (of the read channel if there is no writer)
+ * @param TimeRef is passed to TimeFn
+ * @param LateLimit is the latency above which a consumed frame is counted
+ *        as late, in the unit of the time source
+ *
+ * @return
+ *   None
+ *
+ * @note
+ * The default is no time source and a late limit of one frame period.
+ *****************************************************************************/
+void XAxiVdma_FrmPipeSetTimeSource(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeTimeFn TimeFn, void *TimeRef, u32 LateLimit)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+	PipePtr->TimeFn = TimeFn;
+	PipePtr->TimeRef = TimeRef;
+	PipePtr->LateLimit = LateLimit;
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+}
+
+/*****************************************************************************/
+/**
+ * Set the callback invoked from the write interrupt when a frame is ready
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param CallBackFunc is the callback, NULL to disable it
+ * @param CallBackRef is passed to the callback
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmPipeSetReadyCallBack(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeCallBack CallBackFunc, void *CallBackRef)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+	PipePtr->ReadyCallBack = CallBackFunc;
+	PipePtr->ReadyRef = CallBackRef;
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+}
+
+/*****************************************************************************/
+/**
+ * Start the channels of a frame pipeline
+ *
+ * The write channel is parked on frame 0 and the read channel on the next
+ * frame. Both channels get a frame count of one, the pipeline callbacks and
+ * the frame count and error interrupts enabled.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param WriteCfgPtr is the setup of the write channel, NULL if frames are
+ *        produced by the application only
+ * @param ReadCfgPtr is the setup of the read channel, NULL if frames are
+ *        consumed by the application only
+ *
+ * @return
+ * - XST_SUCCESS if the channels are started
+ * - XST_INVALID_PARAM if both setups are NULL or a setup enables Gen-Lock
+ * - XST_NO_FEATURE if the hardware is in scatter gather mode
+ * - XST_DEVICE_NOT_FOUND if a requested channel is not in the hardware
+ * - Error codes of XAxiVdma_SetFrameCounter() and the channel start
+ *
+ * @note
+ * The park mode, frame store, frame counter and Gen-Lock repeat fields of
+ * the setups are overwritten. EnableSync has to be 0, see the file header
+ * for why the pipeline does not use Gen-Lock. The application connects XAxiVdma_WriteIntrHandler() and
+ * XAxiVdma_ReadIntrHandler() to the interrupt system as usual.
+ *****************************************************************************/
+int XAxiVdma_FrmPipeStart(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_DmaSetup *WriteCfgPtr, XAxiVdma_DmaSetup *ReadCfgPtr)
+{
+	XAxiVdma *InstancePtr;
+	XAxiVdma_FrameCounter FrmCnt;
+	int Status;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	InstancePtr = PipePtr->InstancePtr;
+
+	if ((WriteCfgPtr == NULL) && (ReadCfgPtr == NULL)) {
+		return XST_INVALID_PARAM;
+	}
+
+	if (((WriteCfgPtr != NULL) && WriteCfgPtr->EnableSync) ||
+	    ((ReadCfgPtr != NULL) && ReadCfgPtr->EnableSync)) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "Frame pipeline does not support Gen-Lock\r\n");
+
+		return XST_INVALID_PARAM;
+	}
+
+	if (InstancePtr->HasSG) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "Frame pipeline needs direct register mode\r\n");
+
+		return XST_NO_FEATURE;
+	}
+
+	if (((WriteCfgPtr != NULL) && !InstancePtr->HasS2Mm) ||
+	    ((ReadCfgPtr != NULL) && !InstancePtr->HasMm2S)) {
+		return XST_DEVICE_NOT_FOUND;
+	}
+
+	PipePtr->HasWrite = (WriteCfgPtr != NULL) ? 1 : 0;
+	PipePtr->HasRead = (ReadCfgPtr != NULL) ? 1 : 0;
+
+	FrmCnt.ReadFrameCount = 1;
+	FrmCnt.ReadDelayTimerCount = 0;
+	FrmCnt.WriteFrameCount = 1;
+	FrmCnt.WriteDelayTimerCount = 0;
+	Status = XAxiVdma_SetFrameCounter(InstancePtr, &FrmCnt);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	if (PipePtr->HasWrite) {
+		XAxiVdma_SetCallBack(InstancePtr, XAXIVDMA_HANDLER_GENERAL,
+		    (void *)XAxiVdma_FrmPipeWriteCallBack, PipePtr,
+		    XAXIVDMA_WRITE);
+		XAxiVdma_SetCallBack(InstancePtr, XAXIVDMA_HANDLER_ERROR,
+		    (void *)XAxiVdma_FrmPipeErrCallBack, PipePtr,
+		    XAXIVDMA_WRITE);
+
+		PipePtr->WriteFrame = 0;
+		PipePtr->Frame[0].State = XAXIVDMA_FRMPIPE_WRITING;
+		Status = XAxiVdma_FrmPipeStartChannel(PipePtr, WriteCfgPtr,
+		    XAXIVDMA_WRITE, 0);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	if (PipePtr->HasRead) {
+		XAxiVdma_SetCallBack(InstancePtr, XAXIVDMA_HANDLER_GENERAL,
+		    (void *)XAxiVdma_FrmPipeReadCallBack, PipePtr,
+		    XAXIVDMA_READ);
+		XAxiVdma_SetCallBack(InstancePtr, XAXIVDMA_HANDLER_ERROR,
+		    (void *)XAxiVdma_FrmPipeErrCallBack, PipePtr,
+		    XAXIVDMA_READ);
+
+		PipePtr->ReadFrame = PipePtr->HasWrite;
+		PipePtr->Frame[PipePtr->ReadFrame].State =
+		    XAXIVDMA_FRMPIPE_READING;
+		Status = XAxiVdma_FrmPipeStartChannel(PipePtr, ReadCfgPtr,
+		    XAXIVDMA_READ, PipePtr->ReadFrame);
+		if (Status != XST_SUCCESS) {
+			return Status;
+		}
+	}
+
+	PipePtr->IsStarted = 1;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Stop the channels of a frame pipeline
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ *   None
+ *
+ * @note
+ * Frames stay in their state; lent frames may still be returned.
+ *****************************************************************************/
+void XAxiVdma_FrmPipeStop(XAxiVdma_FrmPipe *PipePtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	if (PipePtr->HasWrite) {
+		XAxiVdma_IntrDisable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_WRITE);
+		XAxiVdma_DmaStop(PipePtr->InstancePtr, XAXIVDMA_WRITE);
+	}
+
+	if (PipePtr->HasRead) {
+		XAxiVdma_IntrDisable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_READ);
+		XAxiVdma_DmaStop(PipePtr->InstancePtr, XAXIVDMA_READ);
+	}
+
+	PipePtr->IsStarted = 0;
+}
+
+/*****************************************************************************/
+/**
+ * Lend the oldest ready frame to the application
+ *
+ * The frame is taken out of the rotation until it is handed back with
+ * XAxiVdma_FrmPipeReturn() or XAxiVdma_FrmPipeSubmit(). No data is copied.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndexPtr returns the index of the lent frame
+ * @param AddrPtr returns the start address of the lent frame, may be NULL
+ *
+ * @return
+ * - XST_SUCCESS if a frame was lent
+ * - XST_NO_DATA if no frame is ready
+ *
+ * @note
+ * The application is responsible for the cache maintenance of the frame.
+ *****************************************************************************/
+int XAxiVdma_FrmPipeLend(XAxiVdma_FrmPipe *PipePtr, u32 *FrameIndexPtr,
+        UINTPTR *AddrPtr)
+{
+	u32 FrameIndex;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+	Xil_AssertNonvoid(FrameIndexPtr != NULL);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+
+	if (PipePtr->ReadyCnt == 0) {
+		XAxiVdma_FrmPipeUnlock(PipePtr);
+
+		return XST_NO_DATA;
+	}
+
+	FrameIndex = XAxiVdma_FrmPipePop(PipePtr);
+	PipePtr->Frame[FrameIndex].State = XAXIVDMA_FRMPIPE_LENT;
+	PipePtr->Stats.Lent++;
+	XAxiVdma_FrmPipeConsume(PipePtr, FrameIndex);
+
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+
+	*FrameIndexPtr = FrameIndex;
+	if (AddrPtr != NULL) {
+		*AddrPtr = PipePtr->Frame[FrameIndex].Addr;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Take a free frame out of the rotation for the application to fill
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndexPtr returns the index of the frame
+ * @param AddrPtr returns the start address of the frame, may be NULL
+ *
+ * @return
+ * - XST_SUCCESS if a frame was taken
+ * - XST_NO_DATA if no frame is free
+ *
+ * @note
+ * The frame is time stamped when it is submitted.
+ *****************************************************************************/
+int XAxiVdma_FrmPipeAcquire(XAxiVdma_FrmPipe *PipePtr, u32 *FrameIndexPtr,
+        UINTPTR *AddrPtr)
+{
+	u32 FrameIndex;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+	Xil_AssertNonvoid(FrameIndexPtr != NULL);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+
+	FrameIndex = XAxiVdma_FrmPipeFindFree(PipePtr);
+	if (FrameIndex == XAXIVDMA_FRMPIPE_NO_FRAME) {
+		XAxiVdma_FrmPipeUnlock(PipePtr);
+
+		return XST_NO_DATA;
+	}
+
+	PipePtr->Frame[FrameIndex].State = XAXIVDMA_FRMPIPE_LENT;
+	PipePtr->Frame[FrameIndex].IsStamped = 0;
+
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+
+	*FrameIndexPtr = FrameIndex;
+	if (AddrPtr != NULL) {
+		*AddrPtr = PipePtr->Frame[FrameIndex].Addr;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Hand a frame owned by the application back as ready for display
+ *
+ * Captured frames keep their capture time stamp, frames obtained with
+ * XAxiVdma_FrmPipeAcquire() are stamped now.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndex is the index of a lent or acquired frame
+ *
+ * @return
+ * - XST_SUCCESS if the frame is queued for display
+ * - XST_INVALID_PARAM if the frame is not owned by the application
+ *
+ * @note
+ * The application has to flush the frame from the data cache first.
+ *****************************************************************************/
+int XAxiVdma_FrmPipeSubmit(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex)
+{
+	XAxiVdma_FrmPipeFrame *FramePtr;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	if ((FrameIndex >= PipePtr->NumFrames) ||
+	    (PipePtr->Frame[FrameIndex].State != XAXIVDMA_FRMPIPE_LENT)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+
+	FramePtr = &PipePtr->Frame[FrameIndex];
+	if (!FramePtr->IsStamped) {
+		FramePtr->Seq = PipePtr->Seq++;
+		FramePtr->Stamp = XAxiVdma_FrmPipeNow(PipePtr);
+		FramePtr->IsStamped = 1;
+	}
+
+	if (PipePtr->Policy == XAXIVDMA_FRMPIPE_LATEST) {
+		XAxiVdma_FrmPipeDropReady(PipePtr);
+	}
+	XAxiVdma_FrmPipePush(PipePtr, FrameIndex);
+
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Hand a frame owned by the application back to the free frames
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndex is the index of a lent or acquired frame
+ *
+ * @return
+ * - XST_SUCCESS if the frame is free again
+ * - XST_INVALID_PARAM if the frame is not owned by the application
+ *****************************************************************************/
+int XAxiVdma_FrmPipeReturn(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex)
+{
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	if ((FrameIndex >= PipePtr->NumFrames) ||
+	    (PipePtr->Frame[FrameIndex].State != XAXIVDMA_FRMPIPE_LENT)) {
+		return XST_INVALID_PARAM;
+	}
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+	PipePtr->Frame[FrameIndex].State = XAXIVDMA_FRMPIPE_FREE;
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Get a consistent copy of the frame pipeline counters
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param StatsPtr is the structure to contain the counters
+ *
+ * @return
+ *   None
+ *
+ * @note
+ * The average latency is LatencySum / LatencyCnt.
+ *****************************************************************************/
+void XAxiVdma_FrmPipeGetStats(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_FrmPipeStats *StatsPtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+	memcpy(StatsPtr, &PipePtr->Stats, sizeof(XAxiVdma_FrmPipeStats));
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+}
+
+/*****************************************************************************/
+/**
+ * Clear the frame pipeline counters
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+void XAxiVdma_FrmPipeResetStats(XAxiVdma_FrmPipe *PipePtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PipePtr->IsReady == XAXIVDMA_DEVICE_READY);
+
+	XAxiVdma_FrmPipeLock(PipePtr);
+	memset(&PipePtr->Stats, 0, sizeof(XAxiVdma_FrmPipeStats));
+	PipePtr->Stats.LatencyMin = 0xFFFFFFFFU;
+	XAxiVdma_FrmPipeUnlock(PipePtr);
+}
+
+/*****************************************************************************/
+/*
+ * Mask the pipeline interrupts of both channels. Interrupts raised in the
+ * meantime stay pending and are serviced by XAxiVdma_FrmPipeUnlock().
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeLock(XAxiVdma_FrmPipe *PipePtr)
+{
+	if (!PipePtr->IsStarted) {
+		return;
+	}
+
+	if (PipePtr->HasWrite) {
+		XAxiVdma_IntrDisable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_WRITE);
+	}
+	if (PipePtr->HasRead) {
+		XAxiVdma_IntrDisable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_READ);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Unmask the pipeline interrupts of both channels.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeUnlock(XAxiVdma_FrmPipe *PipePtr)
+{
+	if (!PipePtr->IsStarted) {
+		return;
+	}
+
+	if (PipePtr->HasWrite) {
+		XAxiVdma_IntrEnable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_WRITE);
+	}
+	if (PipePtr->HasRead) {
+		XAxiVdma_IntrEnable(PipePtr->InstancePtr,
+		    XAXIVDMA_FRMPIPE_INTR_MASK, XAXIVDMA_READ);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Point the park reference of one channel to a frame. The channel switches
+ * to it at its next frame start.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param Direction is the channel, XAXIVDMA_READ or XAXIVDMA_WRITE
+ * @param FrameIndex is the frame to park on
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipePark(XAxiVdma_FrmPipe *PipePtr, u16 Direction,
+        u32 FrameIndex)
+{
+	u32 RegValue;
+
+	RegValue = XAxiVdma_ReadReg(PipePtr->InstancePtr->BaseAddr,
+	    XAXIVDMA_PARKPTR_OFFSET);
+
+	if (Direction == XAXIVDMA_READ) {
+		RegValue &= ~XAXIVDMA_PARKPTR_READREF_MASK;
+		RegValue |= FrameIndex & XAXIVDMA_PARKPTR_READREF_MASK;
+	}
+	else {
+		RegValue &= ~XAXIVDMA_PARKPTR_WRTREF_MASK;
+		RegValue |= (FrameIndex << XAXIVDMA_WRTREF_SHIFT) &
+		    XAXIVDMA_PARKPTR_WRTREF_MASK;
+	}
+
+	XAxiVdma_WriteReg(PipePtr->InstancePtr->BaseAddr,
+	    XAXIVDMA_PARKPTR_OFFSET, RegValue);
+}
+
+/*****************************************************************************/
+/*
+ * Read the time source of the pipeline.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ * The current time stamp
+ *****************************************************************************/
+static u32 XAxiVdma_FrmPipeNow(XAxiVdma_FrmPipe *PipePtr)
+{
+	if (PipePtr->TimeFn != NULL) {
+		return PipePtr->TimeFn(PipePtr->TimeRef);
+	}
+
+	return PipePtr->FrameClock;
+}
+
+/*****************************************************************************/
+/*
+ * Find the free frame with the lowest index.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ * The frame index, XAXIVDMA_FRMPIPE_NO_FRAME if no frame is free
+ *****************************************************************************/
+static u32 XAxiVdma_FrmPipeFindFree(XAxiVdma_FrmPipe *PipePtr)
+{
+	u32 Index;
+
+	for (Index = 0; Index < PipePtr->NumFrames; Index++) {
+		if (PipePtr->Frame[Index].State == XAXIVDMA_FRMPIPE_FREE) {
+			return Index;
+		}
+	}
+
+	return XAXIVDMA_FRMPIPE_NO_FRAME;
+}
+
+/*****************************************************************************/
+/*
+ * Append a frame to the ready frames.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndex is the frame that became ready
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipePush(XAxiVdma_FrmPipe *PipePtr, u32 FrameIndex)
+{
+	u32 Slot;
+
+	Slot = (PipePtr->ReadyHead + PipePtr->ReadyCnt) %
+	    XAXIVDMA_FRMPIPE_MAX_FRAMES;
+	PipePtr->Ready[Slot] = (u8)FrameIndex;
+	PipePtr->ReadyCnt++;
+	PipePtr->Frame[FrameIndex].State = XAXIVDMA_FRMPIPE_READY;
+}
+
+/*****************************************************************************/
+/*
+ * Remove the oldest frame from the ready frames.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ * The frame index, the caller sets its new state
+ *
+ * @note
+ * There must be at least one ready frame.
+ *****************************************************************************/
+static u32 XAxiVdma_FrmPipePop(XAxiVdma_FrmPipe *PipePtr)
+{
+	u32 FrameIndex;
+
+	FrameIndex = PipePtr->Ready[PipePtr->ReadyHead];
+	PipePtr->ReadyHead = (PipePtr->ReadyHead + 1) %
+	    XAXIVDMA_FRMPIPE_MAX_FRAMES;
+	PipePtr->ReadyCnt--;
+
+	return FrameIndex;
+}
+
+/*****************************************************************************/
+/*
+ * Free all ready frames, they are counted as dropped.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeDropReady(XAxiVdma_FrmPipe *PipePtr)
+{
+	u32 FrameIndex;
+
+	while (PipePtr->ReadyCnt != 0) {
+		FrameIndex = XAxiVdma_FrmPipePop(PipePtr);
+		PipePtr->Frame[FrameIndex].State = XAXIVDMA_FRMPIPE_FREE;
+		PipePtr->Stats.Dropped++;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Account the latency of a frame leaving the ready frames.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param FrameIndex is the frame being displayed or lent
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeConsume(XAxiVdma_FrmPipe *PipePtr,
+        u32 FrameIndex)
+{
+	XAxiVdma_FrmPipeStats *StatsPtr = &PipePtr->Stats;
+	u32 Latency;
+
+	if (!PipePtr->Frame[FrameIndex].IsStamped) {
+		return;
+	}
+
+	Latency = XAxiVdma_FrmPipeNow(PipePtr) -
+	    PipePtr->Frame[FrameIndex].Stamp;
+
+	StatsPtr->LatencyLast = Latency;
+	if (Latency < StatsPtr->LatencyMin) {
+		StatsPtr->LatencyMin = Latency;
+	}
+	if (Latency > StatsPtr->LatencyMax) {
+		StatsPtr->LatencyMax = Latency;
+	}
+	StatsPtr->LatencySum += Latency;
+	StatsPtr->LatencyCnt++;
+
+	if (Latency > PipePtr->LateLimit) {
+		StatsPtr->Late++;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Configure and start one channel of the pipeline in park mode.
+ *
+ * @param PipePtr is the pointer to the frame pipeline to work on
+ * @param CfgPtr is the channel setup from the application
+ * @param Direction is the channel, XAXIVDMA_READ or XAXIVDMA_WRITE
+ * @param FrameIndex is the frame to park on first
+ *
+ * @return
+ * - XST_SUCCESS if the channel is started
+ * - Error code of the channel start otherwise
+ *****************************************************************************/
+static int XAxiVdma_FrmPipeStartChannel(XAxiVdma_FrmPipe *PipePtr,
+        XAxiVdma_DmaSetup *CfgPtr, u16 Direction, u32 FrameIndex)
+{
+	int Index;
+	int Status;
+
+	CfgPtr->EnableCircularBuf = 0;
+	CfgPtr->EnableFrameCounter = 0;
+	CfgPtr->GenLockRepeat = 0;
+	CfgPtr->FixedFrameStoreAddr = (int)FrameIndex;
+
+	/* Unused frame stores of the hardware alias the first frame */
+	for (Index = 0; Index < XAXIVDMA_MAX_FRAMESTORE; Index++) {
+		CfgPtr->FrameStoreStartAddr[Index] =
+		    ((u32)Index < PipePtr->NumFrames) ?
+		    PipePtr->Frame[Index].Addr : PipePtr->Frame[0].Addr;
+	}
+
+	if (Direction == XAXIVDMA_WRITE) {
+		Status = XAxiVdma_StartWriteFrame(PipePtr->InstancePtr,
+		    CfgPtr);
+	}
+	else {
+		Status = XAxiVdma_StartReadFrame(PipePtr->InstancePtr,
+		    CfgPtr);
+	}
+	if (Status != XST_SUCCESS) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "Frame pipeline channel start failed %d\r\n", Status);
+
+		return Status;
+	}
+
+	XAxiVdma_IntrEnable(PipePtr->InstancePtr, XAXIVDMA_FRMPIPE_INTR_MASK,
+	    Direction);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/*
+ * Frame count callback of the write channel. The completed frame becomes
+ * ready and the channel is parked on a free frame. Without a free frame the
+ * oldest ready frame is reused, and when every other frame is owned by the
+ * application the channel keeps writing into the completed frame.
+ *
+ * @param CallBackRef is the frame pipeline
+ * @param Mask is the pending interrupts
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeWriteCallBack(void *CallBackRef, u32 Mask)
+{
+	XAxiVdma_FrmPipe *PipePtr = (XAxiVdma_FrmPipe *)CallBackRef;
+	XAxiVdma_FrmPipeFrame *FramePtr;
+	u32 Done;
+	u32 Next;
+
+	if (!(Mask & XAXIVDMA_IXR_FRMCNT_MASK)) {
+		return;
+	}
+
+	PipePtr->FrameClock++;
+	PipePtr->Stats.Captured++;
+	Done = PipePtr->WriteFrame;
+
+	if (PipePtr->Policy == XAXIVDMA_FRMPIPE_LATEST) {
+		XAxiVdma_FrmPipeDropReady(PipePtr);
+	}
+
+	Next = XAxiVdma_FrmPipeFindFree(PipePtr);
+	if ((Next == XAXIVDMA_FRMPIPE_NO_FRAME) && (PipePtr->ReadyCnt != 0)) {
+		Next = XAxiVdma_FrmPipePop(PipePtr);
+		PipePtr->Stats.Dropped++;
+	}
+	if (Next == XAXIVDMA_FRMPIPE_NO_FRAME) {
+		PipePtr->Stats.Dropped++;
+
+		return;
+	}
+
+	PipePtr->Frame[Next].State = XAXIVDMA_FRMPIPE_WRITING;
+	PipePtr->WriteFrame = Next;
+	XAxiVdma_FrmPipePark(PipePtr, XAXIVDMA_WRITE, Next);
+
+	FramePtr = &PipePtr->Frame[Done];
+	FramePtr->Seq = PipePtr->Seq++;
+	FramePtr->Stamp = XAxiVdma_FrmPipeNow(PipePtr);
+	FramePtr->IsStamped = 1;
+	XAxiVdma_FrmPipePush(PipePtr, Done);
+
+	if (PipePtr->ReadyCallBack != NULL) {
+		PipePtr->ReadyCallBack(PipePtr->ReadyRef, Done);
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Frame count callback of the read channel. The channel moves on to the
+ * oldest ready frame and its previous frame is freed. Without a ready frame
+ * the current frame is shown again.
+ *
+ * @param CallBackRef is the frame pipeline
+ * @param Mask is the pending interrupts
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeReadCallBack(void *CallBackRef, u32 Mask)
+{
+	XAxiVdma_FrmPipe *PipePtr = (XAxiVdma_FrmPipe *)CallBackRef;
+	u32 Next;
+
+	if (!(Mask & XAXIVDMA_IXR_FRMCNT_MASK)) {
+		return;
+	}
+
+	if (!PipePtr->HasWrite) {
+		PipePtr->FrameClock++;
+	}
+
+	if (PipePtr->ReadyCnt == 0) {
+		PipePtr->Stats.Repeated++;
+
+		return;
+	}
+
+	Next = XAxiVdma_FrmPipePop(PipePtr);
+	PipePtr->Frame[PipePtr->ReadFrame].State = XAXIVDMA_FRMPIPE_FREE;
+	PipePtr->Frame[Next].State = XAXIVDMA_FRMPIPE_READING;
+	PipePtr->ReadFrame = Next;
+	XAxiVdma_FrmPipePark(PipePtr, XAXIVDMA_READ, Next);
+
+	PipePtr->Stats.Displayed++;
+	XAxiVdma_FrmPipeConsume(PipePtr, Next);
+}
+
+/*****************************************************************************/
+/*
+ * Error callback of both channels. Errors are counted; recovering the
+ * channel is left to the application.
+ *
+ * @param CallBackRef is the frame pipeline
+ * @param Mask is the pending error interrupts
+ *
+ * @return
+ *   None
+ *****************************************************************************/
+static void XAxiVdma_FrmPipeErrCallBack(void *CallBackRef, u32 Mask)
+{
+	XAxiVdma_FrmPipe *PipePtr = (XAxiVdma_FrmPipe *)CallBackRef;
+
+	(void)Mask;
+	PipePtr->Stats.Errors++;
+}
+/** @} */
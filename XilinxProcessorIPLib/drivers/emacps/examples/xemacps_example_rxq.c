@@ -0,0 +1,506 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xemacps_example_rxq.c
+*
+* Implements an example that steers received frames to the GEM Rx priority
+* queues with a type 2 screener.
+*
+* The example programs ethertype register 0 with EMACPS_RXQ_STEER_TYPE and
+* points type 2 screener 0 at it, with Rx queue 1 as the destination. It then
+* sends frames alternately with that ethertype and with a plain length
+* field in PHY loopback. Frames with the steered ethertype must arrive on
+* queue 1 and all other frames must arrive on queue 0.
+*
+* Both queues are serviced by polling the BD rings, so no interrupt
+* controller set up is required. Applications that want interrupts on
+* queue 1 register a XEMACPS_HANDLER_DMARECVQ1 callback before starting the
+* device.
+*
+* The Rx priority queues and screeners are only available on GEM versions
+* above 2 (Zynq UltraScale+ MPSoC). The example reports success without
+* doing anything on other devices.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.8   agt  10/17/26 First release
+*
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+#include <string.h>
+#include "xemacps_example.h"
+
+/*************************** Constant Definitions ***************************/
+
+#define EMACPS_DEVICE_ID	XPAR_XEMACPS_0_DEVICE_ID
+
+#define RXBD_CNT		8	/* Number of RxBDs per queue */
+#define TXBD_CNT		8	/* Number of TxBDs */
+
+#define NUM_FRAMES		16	/* Frames sent in each direction */
+#define PAYLOAD_SIZE		100	/* Payload size of every frame */
+
+#define EMACPS_RXQ_STEER_TYPE	0x88B5	/* Local experimental ethertype */
+
+#define POLL_TIMEOUT		1000000U
+
+/*
+ * Buffer descriptor space. Queue 0 and queue 1 Rx rings each get a 64 KB
+ * region below the Tx ring.
+ */
+#define RXBD_SPACE_BYTES XEmacPs_BdRingMemCalc(XEMACPS_BD_ALIGNMENT, RXBD_CNT)
+#define TXBD_SPACE_BYTES XEmacPs_BdRingMemCalc(XEMACPS_BD_ALIGNMENT, TXBD_CNT)
+
+#define RXQ0_BD_LIST_START_ADDRESS	0x0FF00000
+#define RXQ1_BD_LIST_START_ADDRESS	0x0FF10000
+#define TX_BD_LIST_START_ADDRESS	0x0FF70000
+
+/*************************** Variable Definitions ***************************/
+
+EthernetFrame TxFrame;		/* Transmit buffer */
+
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+u8 RxBuf[XEMACPS_MAX_RXQ][RXBD_CNT][XEMACPS_RX_BUF_SIZE];
+XEmacPs_Bd BdTxTerminate;
+#pragma data_alignment = 4
+#else
+u8 RxBuf[XEMACPS_MAX_RXQ][RXBD_CNT][XEMACPS_RX_BUF_SIZE]
+	__attribute__ ((aligned(64)));
+XEmacPs_Bd BdTxTerminate __attribute__ ((aligned(64)));
+#endif
+
+XEmacPs_BdRing RxQ1BdRing;	/* Queue 1 ring, queue 0 is in the instance */
+
+u32 FramesRxQ[XEMACPS_MAX_RXQ];	/* Frames received on each queue */
+
+/*************************** Function Prototypes ****************************/
+
+LONG EmacPsRxQueueExample(XEmacPs *EmacPsInstancePtr, u16 EmacPsDeviceId);
+
+static LONG EmacPsRxqSetupRing(XEmacPs *EmacPsInstancePtr,
+			       XEmacPs_BdRing *RingPtr, UINTPTR BdSpace,
+			       u32 QueueNum);
+static LONG EmacPsRxqSendFrame(XEmacPs *EmacPsInstancePtr, u16 FrameType);
+static LONG EmacPsRxqPoll(XEmacPs *EmacPsInstancePtr,
+			  XEmacPs_BdRing *RingPtr, u32 QueueNum);
+
+/****************************************************************************/
+/**
+*
+* This is the main function for the Rx queue example. This function is not
+* included if the example is generated from the TestAppGen test tool.
+*
+* @param	None.
+*
+* @return	XST_SUCCESS to indicate success, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+****************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	LONG Status;
+
+	xil_printf("Entering into main() \r\n");
+
+	Status = EmacPsRxQueueExample(&EmacPsInstance, EMACPS_DEVICE_ID);
+
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Emacps Rx queue Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran Emacps Rx queue Example\r\n");
+	return XST_SUCCESS;
+}
+#endif
+
+/****************************************************************************/
+/**
+*
+* This function sets up queue 0 and queue 1 Rx rings, programs a type 2
+* screener to steer EMACPS_RXQ_STEER_TYPE frames to queue 1 and checks that
+* looped back frames land on the expected queue.
+*
+* @param	EmacPsInstancePtr is a pointer to the instance of the EmacPs
+*		driver.
+* @param	EmacPsDeviceId is Device ID of the EmacPs Device , typically
+*		XPAR_<EMACPS_instance>_DEVICE_ID value from xparameters.h.
+*
+* @return	XST_SUCCESS to indicate success, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+*****************************************************************************/
+LONG EmacPsRxQueueExample(XEmacPs *EmacPsInstancePtr, u16 EmacPsDeviceId)
+{
+	LONG Status;
+	XEmacPs_Config *Config;
+	XEmacPs_Bd BdTemplate;
+	u32 Index;
+	u32 Timeout;
+
+	Config = XEmacPs_LookupConfig(EmacPsDeviceId);
+	Status = XEmacPs_CfgInitialize(EmacPsInstancePtr, Config,
+					Config->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error in initialize");
+		return XST_FAILURE;
+	}
+
+	if (EmacPsInstancePtr->Version <= 2) {
+		xil_printf("Rx priority queues are not supported, skipping\r\n");
+		return XST_SUCCESS;
+	}
+
+	Status = XEmacPs_SetMacAddress(EmacPsInstancePtr, EmacPsMAC, 1);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error setting MAC address");
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Rx rings for queue 0 (held by the instance) and queue 1
+	 */
+	Status = EmacPsRxqSetupRing(EmacPsInstancePtr,
+				    &(XEmacPs_GetRxRing(EmacPsInstancePtr)),
+				    (UINTPTR)RXQ0_BD_LIST_START_ADDRESS, 0);
+	Status |= EmacPsRxqSetupRing(EmacPsInstancePtr, &RxQ1BdRing,
+				     (UINTPTR)RXQ1_BD_LIST_START_ADDRESS, 1);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	/*
+	 * Tx ring on priority queue 1, with queue 0 parked on a terminating
+	 * BD as done by the interrupt DMA example.
+	 */
+	XEmacPs_BdClear(&BdTemplate);
+	XEmacPs_BdSetStatus(&BdTemplate, XEMACPS_TXBUF_USED_MASK);
+	Status = XEmacPs_BdRingCreate(&(XEmacPs_GetTxRing(EmacPsInstancePtr)),
+				      (UINTPTR)TX_BD_LIST_START_ADDRESS,
+				      (UINTPTR)TX_BD_LIST_START_ADDRESS,
+				      XEMACPS_BD_ALIGNMENT, TXBD_CNT);
+	Status |= XEmacPs_BdRingClone(&(XEmacPs_GetTxRing(EmacPsInstancePtr)),
+				      &BdTemplate, XEMACPS_SEND);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error setting up TxBD space");
+		return XST_FAILURE;
+	}
+
+	XEmacPs_BdClear(&BdTxTerminate);
+	XEmacPs_BdSetStatus(&BdTxTerminate, (XEMACPS_TXBUF_USED_MASK |
+					XEMACPS_TXBUF_WRAP_MASK));
+	XEmacPs_Out32((Config->BaseAddress + XEMACPS_TXQBASE_OFFSET),
+		       (UINTPTR)&BdTxTerminate);
+	if (Config->IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange((UINTPTR)(&BdTxTerminate), 64);
+	}
+	XEmacPs_SetQueuePtr(EmacPsInstancePtr,
+			    EmacPsInstancePtr->TxBdRing.BaseBdAddr, 1,
+			    XEMACPS_SEND);
+
+	/*
+	 * Steer the experimental ethertype to Rx queue 1. Screeners can only
+	 * be programmed while the device is stopped.
+	 */
+	Status = XEmacPs_SetType2EtherType(EmacPsInstancePtr, 0,
+					   EMACPS_RXQ_STEER_TYPE);
+	Status |= XEmacPs_SetType2Screener(EmacPsInstancePtr, 0, 1, 0, 0, 0,
+					   XEMACPS_SCR_ETHT_EN);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error programming screener");
+		return XST_FAILURE;
+	}
+
+	XEmacPs_SetMdioDivisor(EmacPsInstancePtr, MDC_DIV_224);
+	EmacPsUtilEnterLoopback(EmacPsInstancePtr, EMACPS_LOOPBACK_SPEED_1G);
+	XEmacPs_SetOperatingSpeed(EmacPsInstancePtr, EMACPS_LOOPBACK_SPEED_1G);
+
+	FramesRxQ[0] = 0;
+	FramesRxQ[1] = 0;
+
+	XEmacPs_Start(EmacPsInstancePtr);
+
+	for (Index = 0; Index < (2 * NUM_FRAMES); Index++) {
+		Status = EmacPsRxqSendFrame(EmacPsInstancePtr,
+				((Index & 1U) != 0U) ? EMACPS_RXQ_STEER_TYPE :
+				PAYLOAD_SIZE);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+
+		/*
+		 * Wait for the frame on either queue
+		 */
+		for (Timeout = 0; Timeout < POLL_TIMEOUT; Timeout++) {
+			if (EmacPsRxqPoll(EmacPsInstancePtr,
+				&(XEmacPs_GetRxRing(EmacPsInstancePtr)), 0) +
+			    EmacPsRxqPoll(EmacPsInstancePtr,
+				&RxQ1BdRing, 1) != 0) {
+				break;
+			}
+		}
+		if (Timeout == POLL_TIMEOUT) {
+			EmacPsUtilErrorTrap("Timed out waiting for Rx frame");
+			Status = XST_FAILURE;
+			break;
+		}
+	}
+
+	XEmacPs_Stop(EmacPsInstancePtr);
+
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("Rx queue 0: %d frames, Rx queue 1: %d frames\r\n",
+		   FramesRxQ[0], FramesRxQ[1]);
+
+	if ((FramesRxQ[0] != NUM_FRAMES) || (FramesRxQ[1] != NUM_FRAMES)) {
+		EmacPsUtilErrorTrap("Frames were not steered as programmed");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function creates an Rx BD ring, fills every BD with a buffer and
+* points the given hardware queue at it.
+*
+* @param	EmacPsInstancePtr is a pointer to the instance of the EmacPs
+*		driver.
+* @param	RingPtr is the ring to set up.
+* @param	BdSpace is the BD memory for the ring.
+* @param	QueueNum is the Rx queue the ring is used for.
+*
+* @return	XST_SUCCESS to indicate success, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+*****************************************************************************/
+static LONG EmacPsRxqSetupRing(XEmacPs *EmacPsInstancePtr,
+			       XEmacPs_BdRing *RingPtr, UINTPTR BdSpace,
+			       u32 QueueNum)
+{
+	LONG Status;
+	XEmacPs_Bd BdTemplate;
+	XEmacPs_Bd *BdPtr;
+	XEmacPs_Bd *CurBdPtr;
+	u32 Index;
+
+	XEmacPs_BdClear(&BdTemplate);
+	Status = XEmacPs_BdRingCreate(RingPtr, BdSpace, BdSpace,
+				      XEMACPS_BD_ALIGNMENT, RXBD_CNT);
+	Status |= XEmacPs_BdRingClone(RingPtr, &BdTemplate, XEMACPS_RECV);
+	Status |= XEmacPs_BdRingAlloc(RingPtr, RXBD_CNT, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error setting up RxBD space");
+		return XST_FAILURE;
+	}
+
+	CurBdPtr = BdPtr;
+	for (Index = 0; Index < RXBD_CNT; Index++) {
+		XEmacPs_BdSetAddressRx(CurBdPtr,
+				       (UINTPTR)RxBuf[QueueNum][Index]);
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	Status = XEmacPs_BdRingToHw(RingPtr, RXBD_CNT, BdPtr);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error committing RxBDs to HW");
+		return XST_FAILURE;
+	}
+
+	if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange(BdSpace, RXBD_SPACE_BYTES);
+		Xil_DCacheInvalidateRange((UINTPTR)RxBuf[QueueNum],
+					  sizeof(RxBuf[QueueNum]));
+	}
+
+	XEmacPs_SetQueuePtr(EmacPsInstancePtr, RingPtr->BaseBdAddr, QueueNum,
+			    XEMACPS_RECV);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function sends a single frame with the given type/length field and
+* waits for the transmission to complete.
+*
+* @param	EmacPsInstancePtr is a pointer to the instance of the EmacPs
+*		driver.
+* @param	FrameType is the type/length field of the frame.
+*
+* @return	XST_SUCCESS to indicate success, otherwise XST_FAILURE.
+*
+* @note		None.
+*
+*****************************************************************************/
+static LONG EmacPsRxqSendFrame(XEmacPs *EmacPsInstancePtr, u16 FrameType)
+{
+	LONG Status;
+	XEmacPs_BdRing *TxRingPtr = &(XEmacPs_GetTxRing(EmacPsInstancePtr));
+	XEmacPs_Bd *BdPtr;
+	u32 Timeout;
+
+	EmacPsUtilFrameHdrFormatMAC(&TxFrame, EmacPsMAC);
+	EmacPsUtilFrameHdrFormatType(&TxFrame, FrameType);
+	EmacPsUtilFrameSetPayloadData(&TxFrame, PAYLOAD_SIZE);
+	if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange((UINTPTR)&TxFrame,
+				     XEMACPS_HDR_SIZE + PAYLOAD_SIZE);
+	}
+
+	Status = XEmacPs_BdRingAlloc(TxRingPtr, 1, &BdPtr);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error allocating TxBD");
+		return XST_FAILURE;
+	}
+
+	XEmacPs_BdSetAddressTx(BdPtr, (UINTPTR)&TxFrame);
+	XEmacPs_BdSetLength(BdPtr, XEMACPS_HDR_SIZE + PAYLOAD_SIZE);
+	XEmacPs_BdClearTxUsed(BdPtr);
+	XEmacPs_BdSetLast(BdPtr);
+
+	Status = XEmacPs_BdRingToHw(TxRingPtr, 1, BdPtr);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error committing TxBD to HW");
+		return XST_FAILURE;
+	}
+	if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange((UINTPTR)BdPtr, 64);
+	}
+
+	XEmacPs_Transmit(EmacPsInstancePtr);
+
+	for (Timeout = 0; Timeout < POLL_TIMEOUT; Timeout++) {
+		if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)BdPtr, 64);
+		}
+		if (XEmacPs_BdRingFromHwTx(TxRingPtr, 1, &BdPtr) != 0U) {
+			break;
+		}
+	}
+	if (Timeout == POLL_TIMEOUT) {
+		EmacPsUtilErrorTrap("Timed out waiting for Tx completion");
+		return XST_FAILURE;
+	}
+
+	Status = XEmacPs_BdRingFree(TxRingPtr, 1, BdPtr);
+	if (Status != XST_SUCCESS) {
+		EmacPsUtilErrorTrap("Error freeing up TxBDs");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function collects the frames received on a queue, checks them and
+* hands the buffers back to hardware.
+*
+* @param	EmacPsInstancePtr is a pointer to the instance of the EmacPs
+*		driver.
+* @param	RingPtr is the Rx ring of the queue.
+* @param	QueueNum is the Rx queue number.
+*
+* @return	Number of frames collected from the queue.
+*
+* @note		None.
+*
+*****************************************************************************/
+static LONG EmacPsRxqPoll(XEmacPs *EmacPsInstancePtr,
+			  XEmacPs_BdRing *RingPtr, u32 QueueNum)
+{
+	XEmacPs_Bd *BdPtr;
+	XEmacPs_Bd *CurBdPtr;
+	u32 NumBds;
+	u32 Index;
+	UINTPTR BufAddr;
+
+	if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheInvalidateRange(RingPtr->BaseBdAddr, RXBD_SPACE_BYTES);
+	}
+
+	NumBds = XEmacPs_BdRingFromHwRx(RingPtr, RXBD_CNT, &BdPtr);
+	if (NumBds == 0U) {
+		return 0;
+	}
+
+	CurBdPtr = BdPtr;
+	for (Index = 0; Index < NumBds; Index++) {
+		BufAddr = (UINTPTR)XEmacPs_BdGetBufAddr(CurBdPtr) &
+			  XEMACPS_RXBUF_ADD_MASK;
+		if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange(BufAddr, XEMACPS_RX_BUF_SIZE);
+		}
+		/*
+		 * The steered frames carry an ethertype rather than a length,
+		 * so compare the whole frame instead of using
+		 * EmacPsUtilFrameVerify().
+		 */
+		if (memcmp(&TxFrame, (void *)BufAddr,
+			   XEMACPS_HDR_SIZE + PAYLOAD_SIZE) != 0) {
+			EmacPsUtilErrorTrap("Data mismatch");
+		}
+		FramesRxQ[QueueNum]++;
+
+		/*
+		 * Hand the buffer straight back with the used bit cleared
+		 */
+		XEmacPs_BdClearRxNew(CurBdPtr);
+		CurBdPtr = XEmacPs_BdRingNext(RingPtr, CurBdPtr);
+	}
+
+	(void)XEmacPs_BdRingFree(RingPtr, NumBds, BdPtr);
+	(void)XEmacPs_BdRingAlloc(RingPtr, NumBds, &BdPtr);
+	(void)XEmacPs_BdRingToHw(RingPtr, NumBds, BdPtr);
+	if (EmacPsInstancePtr->Config.IsCacheCoherent == 0) {
+		Xil_DCacheFlushRange(RingPtr->BaseBdAddr, RXBD_SPACE_BYTES);
+	}
+
+	return (LONG)NumBds;
+}
@@ -52,6 +52,7 @@
 *                    its config structure.
 * 3.8  hk   09/17/18 Cleanup stale comments.
 * 3.8  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
+* 3.8  agt  10/17/26 Program the Rx Q1 base address and buffer size.
 *
 * </pre>
 ******************************************************************************/
@@ -113,6 +114,7 @@ LONG XEmacPs_CfgInitialize(XEmacPs *InstancePtr, XEmacPs_Config * CfgPtr,
 	InstancePtr->SendHandler = ((XEmacPs_Handler)((void*)XEmacPs_StubHandler));
 	InstancePtr->RecvHandler = ((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
 	InstancePtr->ErrorHandler = ((XEmacPs_ErrHandler)(void*)XEmacPs_StubHandler);
+	InstancePtr->RecvQ1Handler = ((XEmacPs_Handler)(void*)XEmacPs_StubHandler);
 
 	/* Reset the hardware and set default options */
 	InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
@@ -204,9 +206,15 @@ void XEmacPs_Start(XEmacPs *InstancePtr)
 	XEMACPS_IXR_RX_ERR_MASK | (u32)XEMACPS_IXR_FRAMERX_MASK |
 	(u32)XEMACPS_IXR_TXCOMPL_MASK));
 
-	/* Enable TX Q1 Interrupts */
-	if (InstancePtr->Version > 2)
-		XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_ALL_MASK);
+	/* Enable TX Q1 Interrupts, RX Q1 ones only when a handler is set */
+	if (InstancePtr->Version > 2) {
+		XEmacPs_IntQ1Enable(InstancePtr, ((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK |
+				(u32)XEMACPS_INTQ1SR_TXERR_MASK));
+		if (InstancePtr->RecvQ1Handler !=
+			((XEmacPs_Handler)(void*)XEmacPs_StubHandler)) {
+			XEmacPs_IntQ1Enable(InstancePtr, XEMACPS_INTQ1_IXR_RX_MASK);
+		}
+	}
 
 	/* Mark as started */
 	InstancePtr->IsStarted = XIL_COMPONENT_IS_STARTED;
@@ -361,6 +369,13 @@ void XEmacPs_Reset(XEmacPs *InstancePtr)
 			(u32)XEMACPS_DMACR_ADDR_WIDTH_64 |
 #endif
 			(u32)XEMACPS_DMACR_INCR16_AHB_BURST));
+		/* Rx queue 1 buffers are sized as the queue 0 ones */
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BUFSIZE_OFFSET,
+			((((u32)XEMACPS_RX_BUF_SIZE / (u32)XEMACPS_RX_BUF_UNIT) +
+			(((((u32)XEMACPS_RX_BUF_SIZE %
+			(u32)XEMACPS_RX_BUF_UNIT))!=(u32)0) ? 1U : 0U)) &
+			(u32)XEMACPS_RXQ1BUFSIZE_MASK));
 	}
 
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
@@ -435,7 +450,8 @@ void XEmacPs_StubHandler(void)
 *
 * @param	InstancePtr is a pointer to the instance to be worked on.
 * @param	QPtr is the address of the Queue to be written
-* @param	QueueNum is the Buffer Queue Index
+* @param	QueueNum is the Buffer Queue Index, 0 or 1 (priority queue 1 on
+*		GEM versions above 2)
 * @param	Direction indicates Transmit/Recive
 *
 * @note
@@ -467,9 +483,15 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 		}
 	}
 	 else {
-		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
-			XEMACPS_TXQ1BASE_OFFSET,
-			(QPtr & ULONG64_LO_MASK));
+		if (Direction == XEMACPS_SEND) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_TXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		}
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
@@ -328,6 +328,8 @@
  *		       Add API XEmacPs_BdRingPtrReset() to reset pointers
  * 3.8   hk   07/19/18 Fixed CPP, GCC and doxygen warnings - CR-1006327
  *	 hk   09/17/18 Fix PTP interrupt masks and cleanup comments.
+ *	 agt  10/17/26 Add Rx priority queue 1 handler and type 1/type 2
+ *		       screener APIs for steering frames to Rx queues.
  *
  * </pre>
  *
@@ -454,6 +456,27 @@ extern "C" {
 #define XEMACPS_HANDLER_DMASEND 1U
 #define XEMACPS_HANDLER_DMARECV 2U
 #define XEMACPS_HANDLER_ERROR   3U
+#define XEMACPS_HANDLER_DMARECVQ1 4U
+/*@}*/
+
+/** @name Rx priority queues and screeners
+ *
+ * Frames are received on queue 0 unless a screener matches them. Queue 1
+ * and the screeners are available on GEM versions above 2 (Zynq
+ * UltraScale+ MPSoC).
+ * @{
+ */
+#define XEMACPS_MAX_RXQ         2U	/**< Rx queues incl. queue 0 */
+#define XEMACPS_SCRT1_NUM       4U	/**< Type 1 screeners */
+#define XEMACPS_SCRT2_NUM       4U	/**< Type 2 screeners */
+#define XEMACPS_SCRT2_ETHT_NUM  4U	/**< Type 2 ethertype registers */
+#define XEMACPS_SCRT2_CMP_NUM   4U	/**< Type 2 compare registers */
+
+#define XEMACPS_SCR_DSTC_EN     0x00000001U /**< Type 1: match DS/TC */
+#define XEMACPS_SCR_UDP_EN      0x00000002U /**< Type 1: match UDP port */
+#define XEMACPS_SCR_VLAN_EN     0x00000004U /**< Type 2: match VLAN prio */
+#define XEMACPS_SCR_ETHT_EN     0x00000008U /**< Type 2: match ethertype */
+#define XEMACPS_SCR_CMPA_EN     0x00000010U /**< Type 2: match compare */
 /*@}*/
 
 /* Constants to determine the configuration of the hardware device. They are
@@ -552,6 +575,9 @@ typedef struct XEmacPs_Instance {
 
 	XEmacPs_ErrHandler ErrorHandler;
 	void *ErrorRef;
+
+	XEmacPs_Handler RecvQ1Handler;	/* Rx priority queue 1 */
+	void *RecvQ1Ref;
 	u32 Version;
 	u32 RxBufMask;
 	u32 MaxMtuSize;
@@ -796,6 +822,16 @@ LONG XEmacPs_PhyWrite(XEmacPs *InstancePtr, u32 PhyAddress,
 		      u32 RegisterNum, u16 PhyData);
 LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
 
+LONG XEmacPs_SetType1Screener(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			      u8 DsTc, u16 UdpPort, u32 Flags);
+LONG XEmacPs_SetType2Screener(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			      u8 VlanPrio, u8 EthTypeIndex, u8 CompareIndex,
+			      u32 Flags);
+LONG XEmacPs_SetType2EtherType(XEmacPs *InstancePtr, u8 Index,
+			       u16 EtherType);
+LONG XEmacPs_SetType2Compare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+			     u16 Mask, u8 OffsetType, u8 Offset);
+
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
 
@@ -48,6 +48,8 @@
  * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
  * 3.0   hk   02/20/15 Added support for jumbo frames.
  * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+ * 3.8   agt  10/17/26 Added type 1 and type 2 screener APIs. Keep the Rx Q1
+ *                     buffer size in step with the jumbo frame option.
  * </pre>
  *****************************************************************************/
 
@@ -431,6 +433,218 @@ LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+ * Set a type 1 screener. Received frames whose IP DS/TC field and/or UDP
+ * destination port match the enabled fields of the screener are placed on
+ * Rx queue QueueNum instead of queue 0. The device must be stopped before
+ * calling this function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to set (0 to XEMACPS_SCRT1_NUM - 1).
+ * @param QueueNum is the Rx queue matching frames are placed on.
+ * @param DsTc is the IPv4 DS or IPv6 TC field to match.
+ * @param UdpPort is the UDP destination port to match.
+ * @param Flags selects the fields to match, XEMACPS_SCR_DSTC_EN and/or
+ *        XEMACPS_SCR_UDP_EN. A screener with no field enabled never matches.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType1Screener(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			      u8 DsTc, u16 UdpPort, u32 Flags)
+{
+	u32 Reg;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCRT1_NUM);
+	Xil_AssertNonvoid(QueueNum < (u8)XEMACPS_MAX_RXQ);
+
+	if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		Reg = ((u32)QueueNum & XEMACPS_SCRT1_QUEUE_MASK) |
+			(((u32)DsTc << XEMACPS_SCRT1_DSTC_SHIFT) &
+			 XEMACPS_SCRT1_DSTC_MASK) |
+			(((u32)UdpPort << XEMACPS_SCRT1_UDP_SHIFT) &
+			 XEMACPS_SCRT1_UDP_MASK);
+		if ((Flags & XEMACPS_SCR_DSTC_EN) != 0x00000000U) {
+			Reg |= XEMACPS_SCRT1_DSTC_EN_MASK;
+		}
+		if ((Flags & XEMACPS_SCR_UDP_EN) != 0x00000000U) {
+			Reg |= XEMACPS_SCRT1_UDP_EN_MASK;
+		}
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT1_OFFSET + ((u32)Index * (u32)4)), Reg);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Set a type 2 screener. Received frames that match all the enabled fields
+ * of the screener, the VLAN priority, the ethertype held in a type 2
+ * ethertype register and a type 2 compare, are placed on Rx queue QueueNum
+ * instead of queue 0. The device must be stopped before calling this
+ * function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to set (0 to XEMACPS_SCRT2_NUM - 1).
+ * @param QueueNum is the Rx queue matching frames are placed on.
+ * @param VlanPrio is the VLAN priority to match.
+ * @param EthTypeIndex is the ethertype register to match, see
+ *        XEmacPs_SetType2EtherType().
+ * @param CompareIndex is the compare register to match, see
+ *        XEmacPs_SetType2Compare().
+ * @param Flags selects the fields to match, any of XEMACPS_SCR_VLAN_EN,
+ *        XEMACPS_SCR_ETHT_EN and XEMACPS_SCR_CMPA_EN. A screener with no
+ *        field enabled never matches.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType2Screener(XEmacPs *InstancePtr, u8 Index, u8 QueueNum,
+			      u8 VlanPrio, u8 EthTypeIndex, u8 CompareIndex,
+			      u32 Flags)
+{
+	u32 Reg;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCRT2_NUM);
+	Xil_AssertNonvoid(QueueNum < (u8)XEMACPS_MAX_RXQ);
+	Xil_AssertNonvoid(VlanPrio <= 7U);
+	Xil_AssertNonvoid(EthTypeIndex < (u8)XEMACPS_SCRT2_ETHT_NUM);
+	Xil_AssertNonvoid(CompareIndex < (u8)XEMACPS_SCRT2_CMP_NUM);
+
+	if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		Reg = ((u32)QueueNum & XEMACPS_SCRT2_QUEUE_MASK) |
+			(((u32)VlanPrio << XEMACPS_SCRT2_VLANPRI_SHIFT) &
+			 XEMACPS_SCRT2_VLANPRI_MASK) |
+			(((u32)EthTypeIndex << XEMACPS_SCRT2_ETHT_SHIFT) &
+			 XEMACPS_SCRT2_ETHT_MASK) |
+			(((u32)CompareIndex << XEMACPS_SCRT2_CMPA_SHIFT) &
+			 XEMACPS_SCRT2_CMPA_MASK);
+		if ((Flags & XEMACPS_SCR_VLAN_EN) != 0x00000000U) {
+			Reg |= XEMACPS_SCRT2_VLAN_EN_MASK;
+		}
+		if ((Flags & XEMACPS_SCR_ETHT_EN) != 0x00000000U) {
+			Reg |= XEMACPS_SCRT2_ETHT_EN_MASK;
+		}
+		if ((Flags & XEMACPS_SCR_CMPA_EN) != 0x00000000U) {
+			Reg |= XEMACPS_SCRT2_CMPA_EN_MASK;
+		}
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_OFFSET + ((u32)Index * (u32)4)), Reg);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Set a type 2 ethertype register, used by the type 2 screeners that have
+ * XEMACPS_SCR_ETHT_EN set. The device must be stopped before calling this
+ * function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the register to set (0 to XEMACPS_SCRT2_ETHT_NUM - 1).
+ * @param EtherType is the ethertype to match, e.g. 0x88F7 for PTP.
+ *
+ * @return
+ * - XST_SUCCESS if the ethertype was set successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType2EtherType(XEmacPs *InstancePtr, u8 Index,
+			       u16 EtherType)
+{
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCRT2_ETHT_NUM);
+
+	if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_ETHT_OFFSET + ((u32)Index * (u32)4)),
+			(u32)EtherType);
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * Set a type 2 compare register, used by the type 2 screeners that have
+ * XEMACPS_SCR_CMPA_EN set. The compare matches when the 16 bits at Offset
+ * bytes from the selected point in the frame, ANDed with Mask, equal Value.
+ * The device must be stopped before calling this function.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the register to set (0 to XEMACPS_SCRT2_CMP_NUM - 1).
+ * @param Value is the value to compare with.
+ * @param Mask selects the bits that are compared.
+ * @param OffsetType is where Offset counts from, one of
+ *        XEMACPS_SCRT2_CMP_FRAME, XEMACPS_SCRT2_CMP_ETHTYPE,
+ *        XEMACPS_SCRT2_CMP_IPHDR and XEMACPS_SCRT2_CMP_L4HDR.
+ * @param Offset is the byte offset of the compared 16 bits (0 to 127).
+ *
+ * @return
+ * - XST_SUCCESS if the compare was set successfully
+ * - XST_DEVICE_IS_STARTED if the device has not yet been stopped
+ * - XST_NO_FEATURE if the GEM has no priority queues
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetType2Compare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+			     u16 Mask, u8 OffsetType, u8 Offset)
+{
+	u32 RegOffset;
+	LONG Status;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCRT2_CMP_NUM);
+	Xil_AssertNonvoid(OffsetType <= (u8)XEMACPS_SCRT2_CMP_L4HDR);
+	Xil_AssertNonvoid(Offset <= (u8)XEMACPS_SCRT2_CMP_OFST_MASK);
+
+	if (InstancePtr->IsStarted == (u32)XIL_COMPONENT_IS_STARTED) {
+		Status = (LONG)(XST_DEVICE_IS_STARTED);
+	} else if (InstancePtr->Version <= 2) {
+		Status = (LONG)(XST_NO_FEATURE);
+	} else {
+		RegOffset = (u32)Index * (u32)8;
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_CMPW0_OFFSET + RegOffset),
+			(((u32)Value << XEMACPS_SCRT2_CMP_VAL_SHIFT) |
+			 (u32)Mask));
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_CMPW1_OFFSET + RegOffset),
+			(((u32)Offset & XEMACPS_SCRT2_CMP_OFST_MASK) |
+			 (((u32)OffsetType << XEMACPS_SCRT2_CMP_TYPE_SHIFT) &
+			  XEMACPS_SCRT2_CMP_TYPE_MASK)));
+		Status = (LONG)(XST_SUCCESS);
+	}
+	return Status;
+}
+
 /*****************************************************************************/
 /**
  * Set options for the driver/device. The driver should be stopped with
@@ -536,6 +750,12 @@ LONG XEmacPs_SetOptions(XEmacPs *InstancePtr, u32 Options)
 			(u32)(XEMACPS_DMACR_RXBUF_MASK));
 		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
 			XEMACPS_DMACR_OFFSET, Reg);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BUFSIZE_OFFSET,
+			((((u32)XEMACPS_RX_BUF_SIZE_JUMBO / (u32)XEMACPS_RX_BUF_UNIT) +
+			(((((u32)XEMACPS_RX_BUF_SIZE_JUMBO %
+			(u32)XEMACPS_RX_BUF_UNIT))!=(u32)0) ? 1U : 0U)) &
+			(u32)XEMACPS_RXQ1BUFSIZE_MASK));
 		InstancePtr->MaxMtuSize = XEMACPS_MTU_JUMBO;
 		InstancePtr->MaxFrameSize = XEMACPS_MTU_JUMBO +
 					XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE;
@@ -701,6 +921,12 @@ LONG XEmacPs_ClearOptions(XEmacPs *InstancePtr, u32 Options)
 			(u32)(XEMACPS_DMACR_RXBUF_MASK));
 		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
 			XEMACPS_DMACR_OFFSET, Reg);
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XEMACPS_RXQ1BUFSIZE_OFFSET,
+			((((u32)XEMACPS_RX_BUF_SIZE / (u32)XEMACPS_RX_BUF_UNIT) +
+			(((((u32)XEMACPS_RX_BUF_SIZE %
+			(u32)XEMACPS_RX_BUF_UNIT))!=(u32)0) ? 1U : 0U)) &
+			(u32)XEMACPS_RXQ1BUFSIZE_MASK));
 		InstancePtr->MaxMtuSize = XEMACPS_MTU;
 		InstancePtr->MaxFrameSize = XEMACPS_MTU +
 					XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE;
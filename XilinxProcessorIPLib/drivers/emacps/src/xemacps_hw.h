@@ -58,6 +58,8 @@
 * 3.1  hk   08/10/15 Update upper 32 bit tx and rx queue ptr register offsets.
 * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
 * 3.8  hk   09/17/18 Fix PTP interrupt masks.
+* 3.8  agt  10/17/26 Add Rx Q1 buffer size, screener register offsets and
+*                    Rx Q1 interrupt masks.
 * </pre>
 *
 ******************************************************************************/
@@ -299,6 +301,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -309,6 +313,16 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
+#define XEMACPS_SCRT1_OFFSET         0x00000500U /**< Screening type 1
+							reg 0 */
+#define XEMACPS_SCRT2_OFFSET         0x00000540U /**< Screening type 2
+							reg 0 */
+#define XEMACPS_SCRT2_ETHT_OFFSET    0x000006E0U /**< Screening type 2
+							ethertype reg 0 */
+#define XEMACPS_SCRT2_CMPW0_OFFSET   0x00000700U /**< Screening type 2
+							compare 0 word 0 */
+#define XEMACPS_SCRT2_CMPW1_OFFSET   0x00000704U /**< Screening type 2
+							compare 0 word 1 */
 
 /* Define some bit positions for registers. */
 
@@ -460,10 +474,75 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXUSED_MASK	0x00000004U /**< Rx used bit read */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Receive completed OK */
+
+#define XEMACPS_INTQ1_IXR_RX_MASK	((u32)XEMACPS_INTQ1SR_RXCOMPL_MASK | \
+					 (u32)XEMACPS_INTQ1SR_RXUSED_MASK)
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
-					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
+					 (u32)XEMACPS_INTQ1SR_TXERR_MASK | \
+					 (u32)XEMACPS_INTQ1_IXR_RX_MASK)
+
+/*@}*/
+
+/**
+ * @name Rx Q1 buffer size register bit definitions
+ * @{
+ */
+#define XEMACPS_RXQ1BUFSIZE_MASK	0x000000FFU /**< Buffer size in
+						      XEMACPS_RX_BUF_UNIT */
+/*@}*/
+
+/**
+ * @name Screening type 1 register bit definitions
+ * A received frame that matches the enabled fields is routed to the queue
+ * @{
+ */
+#define XEMACPS_SCRT1_QUEUE_MASK	0x0000000FU /**< Rx queue number */
+#define XEMACPS_SCRT1_DSTC_MASK		0x00000FF0U /**< IP DS/TC field */
+#define XEMACPS_SCRT1_DSTC_SHIFT	4U
+#define XEMACPS_SCRT1_UDP_MASK		0x0FFFF000U /**< UDP destination port */
+#define XEMACPS_SCRT1_UDP_SHIFT		12U
+#define XEMACPS_SCRT1_DSTC_EN_MASK	0x10000000U /**< Match DS/TC field */
+#define XEMACPS_SCRT1_UDP_EN_MASK	0x20000000U /**< Match UDP port */
+/*@}*/
 
+/**
+ * @name Screening type 2 register bit definitions
+ * A received frame that matches all the enabled fields is routed to the
+ * queue
+ * @{
+ */
+#define XEMACPS_SCRT2_QUEUE_MASK	0x0000000FU /**< Rx queue number */
+#define XEMACPS_SCRT2_VLANPRI_MASK	0x00000070U /**< VLAN priority */
+#define XEMACPS_SCRT2_VLANPRI_SHIFT	4U
+#define XEMACPS_SCRT2_VLAN_EN_MASK	0x00000100U /**< Match VLAN priority */
+#define XEMACPS_SCRT2_ETHT_MASK		0x00000E00U /**< Ethertype reg index */
+#define XEMACPS_SCRT2_ETHT_SHIFT	9U
+#define XEMACPS_SCRT2_ETHT_EN_MASK	0x00001000U /**< Match ethertype */
+#define XEMACPS_SCRT2_CMPA_MASK		0x0003E000U /**< Compare A index */
+#define XEMACPS_SCRT2_CMPA_SHIFT	13U
+#define XEMACPS_SCRT2_CMPA_EN_MASK	0x00040000U /**< Match compare A */
+/*@}*/
+
+/**
+ * @name Screening type 2 compare register bit definitions
+ * Word 0 holds the value and mask of the 16 bit compare, word 1 where
+ * in the frame the compare is done
+ * @{
+ */
+#define XEMACPS_SCRT2_CMP_MASK_MASK	0x0000FFFFU /**< Compare mask */
+#define XEMACPS_SCRT2_CMP_VAL_MASK	0xFFFF0000U /**< Compare value */
+#define XEMACPS_SCRT2_CMP_VAL_SHIFT	16U
+#define XEMACPS_SCRT2_CMP_OFST_MASK	0x0000007FU /**< Offset in bytes */
+#define XEMACPS_SCRT2_CMP_TYPE_MASK	0x00000180U /**< Offset base */
+#define XEMACPS_SCRT2_CMP_TYPE_SHIFT	7U
+
+#define XEMACPS_SCRT2_CMP_FRAME		0U /**< From start of frame */
+#define XEMACPS_SCRT2_CMP_ETHTYPE	1U /**< From after the ethertype */
+#define XEMACPS_SCRT2_CMP_IPHDR		2U /**< From after the IP header */
+#define XEMACPS_SCRT2_CMP_L4HDR		3U /**< From after the TCP/UDP header */
 /*@}*/
 
 /**
@@ -55,6 +55,8 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   hk   07/27/15 Do not call error handler with '0' error code when
 *                     there is no error. CR# 869403
+* 3.8   agt  10/17/26 Dispatch Rx priority queue 1 completions to the
+*                     XEMACPS_HANDLER_DMARECVQ1 handler.
 * </pre>
 ******************************************************************************/
 
@@ -83,8 +85,8 @@
  *
  * @param InstancePtr is a pointer to the instance to be worked on.
  * @param HandlerType indicates what interrupt handler type is.
- *        XEMACPS_HANDLER_DMASEND, XEMACPS_HANDLER_DMARECV and
- *        XEMACPS_HANDLER_ERROR.
+ *        XEMACPS_HANDLER_DMASEND, XEMACPS_HANDLER_DMARECV,
+ *        XEMACPS_HANDLER_ERROR and XEMACPS_HANDLER_DMARECVQ1.
  * @param FuncPointer is the pointer to the callback function
  * @param CallBackRef is the upper layer callback reference passed back when
  *        when the callback function is invoked.
@@ -122,6 +124,11 @@ LONG XEmacPs_SetHandler(XEmacPs *InstancePtr, u32 HandlerType,
 		InstancePtr->ErrorHandler = ((XEmacPs_ErrHandler)(void *)FuncPointer);
 		InstancePtr->ErrorRef = CallBackRef;
 		break;
+	case XEMACPS_HANDLER_DMARECVQ1:
+		Status = (LONG)(XST_SUCCESS);
+		InstancePtr->RecvQ1Handler = ((XEmacPs_Handler)(void *)FuncPointer);
+		InstancePtr->RecvQ1Ref = CallBackRef;
+		break;
 	default:
 		Status = (LONG)(XST_INVALID_PARAM);
 		break;
@@ -181,6 +188,26 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 		InstancePtr->RecvHandler(InstancePtr->RecvRef);
 	}
 
+	/* Receive Q1 complete or Q1 buffer not available interrupt */
+	if ((InstancePtr->Version > 2) &&
+			((RegQ1ISR & XEMACPS_INTQ1_IXR_RX_MASK) != 0x00000000U)) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   (RegQ1ISR & XEMACPS_INTQ1_IXR_RX_MASK));
+
+		/* Flush the frame waiting for a Q1 buffer out of Rx SRAM,
+		 * as for queue 0 (CR # 692702), so queue 0 is not blocked */
+		if ((RegQ1ISR & XEMACPS_INTQ1SR_RXUSED_MASK) != 0x00000000U) {
+			RegCtrl =
+			XEmacPs_ReadReg(InstancePtr->Config.BaseAddress,
+						XEMACPS_NWCTRL_OFFSET);
+			RegCtrl |= (u32)XEMACPS_NWCTRL_FLUSH_DPRAM_MASK;
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+					XEMACPS_NWCTRL_OFFSET, RegCtrl);
+		}
+		InstancePtr->RecvQ1Handler(InstancePtr->RecvQ1Ref);
+	}
+
 	/* Transmit Q1 complete interrupt */
 	if ((InstancePtr->Version > 2) &&
 			((RegQ1ISR & XEMACPS_INTQ1SR_TXCOMPL_MASK) != 0x00000000U)) {
@@ -0,0 +1,538 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file sha1bench.c
+*		Host tests and KSV list benchmark of the SHA-1 used for the
+*		HDCP 1.x repeater V' value.
+*
+*		sha1.c of the driver is linked next to sha1_ref.c, the RFC 3174
+*		code it replaced (ref_ prefix, see Makefile). The tests check
+*		- the FIPS 180-1 examples with both
+*		- streaming with random split points and source alignment
+*		  against the one-shot reference
+*		- SHA1InputKsv() against the KSVs converted to octets, for KSV
+*		  lists of 0 to 127 devices at all block offsets
+*		- the error codes
+*		and then time the V' computation per KSV.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sha1.h"
+#include "bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define MAX_STREAM_SIZE		1000	/* Largest message of the stream test */
+#define MAX_KSVS		127	/* Largest KSV list of a repeater */
+#define KSV_FIFO_READ		15	/* Bytes per KSV FIFO read of DP */
+
+/**************************** Type Definitions *******************************/
+
+/* FIPS 180-1 example */
+typedef struct {
+	const char *Name;
+	const char *Message;
+	uint32_t Repeat;
+	const char *Hash;
+} ShaVector;
+
+/* One way of hashing the KSV list, see bench() */
+typedef void (*KsvMethod)(const uint64_t *KsvList, int Count,
+		uint8_t *Digest);
+
+/************************** Function Prototypes ******************************/
+
+/* The reference build of sha1_ref.c */
+int ref_SHA1Reset(SHA1Context *);
+int ref_SHA1Input(SHA1Context *, const uint8_t *, unsigned int);
+int ref_SHA1Result(SHA1Context *, uint8_t Message_Digest[SHA1HashSize]);
+
+/************************** Variable Definitions *****************************/
+
+static const ShaVector ShaVectors[] = {
+	{ "empty", "", 1, "da39a3ee5e6b4b0d3255bfef95601890afd80709" },
+	{ "abc", "abc", 1, "a9993e364706816aba3e25717850c26c9cd0d89d" },
+	{ "448 bits",
+	  "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+	  "84983e441c3bd26ebaae4aa1f95129e5e54670f1" },
+	{ "million a", "a", 1000000,
+	  "34aa973cd4c4daa4f61eeb2bdbad27316534016f" },
+};
+
+/* Binfo and Mo that end the message of V' */
+static const uint8_t Trailer[10] = {
+	0x7f, 0x07, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88
+};
+
+static uint32_t RandState = 0x2545F491;
+
+/*****************************************************************************/
+/*
+* xorshift32, the tests are repeatable
+*/
+static uint32_t rand32(void)
+{
+	RandState ^= RandState << 13;
+	RandState ^= RandState >> 17;
+	RandState ^= RandState << 5;
+	return RandState;
+}
+
+/* Compares a digest with a hex string */
+static int match_hex(const uint8_t *Hash, const char *Hex)
+{
+	char Str[2 * SHA1HashSize + 1];
+	int i;
+
+	for (i = 0; i < SHA1HashSize; i++) {
+		sprintf(&Str[2 * i], "%02x", Hash[i]);
+	}
+	return strcmp(Str, Hex) == 0;
+}
+
+/* The KSV as it is sent in the KSV FIFO, least significant byte first */
+static void ksv_to_buf(uint8_t *Buf, uint64_t Ksv)
+{
+	int i;
+
+	for (i = 0; i < SHA1KsvSize; i++) {
+		Buf[i] = (uint8_t)Ksv;
+		Ksv >>= 8;
+	}
+}
+
+/*****************************************************************************/
+/*
+* FIPS 180-1 examples. The million a are streamed in pieces of 1000 bytes.
+*/
+static void test_vectors(void)
+{
+	static uint8_t Buffer[1000];
+	SHA1Context Ctx;
+	uint8_t Hash[SHA1HashSize];
+	char Name[64];
+	size_t v;
+	uint32_t i;
+	int Ref;
+
+	memset(Buffer, 'a', sizeof(Buffer));
+
+	for (Ref = 0; Ref < 2; Ref++) {
+		for (v = 0; v < sizeof(ShaVectors) / sizeof(ShaVectors[0]); v++) {
+			const uint8_t *Msg = (const uint8_t *)ShaVectors[v].Message;
+			unsigned Size = strlen(ShaVectors[v].Message);
+			uint32_t Parts = 1;
+
+			if (ShaVectors[v].Repeat > 1) {
+				Msg = Buffer;
+				Size = sizeof(Buffer);
+				Parts = ShaVectors[v].Repeat / Size;
+			}
+			if (Ref) {
+				ref_SHA1Reset(&Ctx);
+				for (i = 0; i < Parts; i++) {
+					ref_SHA1Input(&Ctx, Msg, Size);
+				}
+				ref_SHA1Result(&Ctx, Hash);
+			} else {
+				SHA1Reset(&Ctx);
+				for (i = 0; i < Parts; i++) {
+					SHA1Input(&Ctx, Msg, Size);
+				}
+				SHA1Result(&Ctx, Hash);
+			}
+			snprintf(Name, sizeof(Name), "%s %s",
+					Ref ? "reference" : "sha1", ShaVectors[v].Name);
+			check(Name, match_hex(Hash, ShaVectors[v].Hash));
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+* Streaming with up to four random split points and a random source
+* alignment compared with the reference for all lengths up to
+* MAX_STREAM_SIZE.
+*/
+static void test_stream(void)
+{
+	static uint8_t Message[MAX_STREAM_SIZE + 4];
+	uint8_t Expected[SHA1HashSize];
+	uint8_t Hash[SHA1HashSize];
+	SHA1Context Ctx;
+	unsigned Size, Done, Part, Offset;
+	int Ok = 1;
+	int Split;
+
+	for (Size = 0; Size <= MAX_STREAM_SIZE; Size++) {
+		Offset = rand32() & 3;
+		for (Done = 0; Done < Size; Done++) {
+			Message[Offset + Done] = (uint8_t)rand32();
+		}
+		ref_SHA1Reset(&Ctx);
+		ref_SHA1Input(&Ctx, &Message[Offset], Size);
+		ref_SHA1Result(&Ctx, Expected);
+
+		SHA1Reset(&Ctx);
+		Done = 0;
+		for (Split = 0; Split < 4 && Done < Size; Split++) {
+			Part = rand32() % (Size - Done + 1);
+			SHA1Input(&Ctx, &Message[Offset + Done], Part);
+			Done += Part;
+		}
+		SHA1Input(&Ctx, &Message[Offset + Done], Size - Done);
+		SHA1Result(&Ctx, Hash);
+		Ok &= memcmp(Hash, Expected, sizeof(Hash)) == 0;
+	}
+	check("stream with random splits, 0 to 1000 bytes", Ok);
+}
+
+/*****************************************************************************/
+/*
+* The V' message of KSV lists of 0 to MAX_KSVS devices, after 0 to 63 bytes
+* so that the KSVs cross the block boundary at every offset: SHA1InputKsv()
+* and KSV FIFO reads of 15 bytes against the reference. The KSVs have
+* random bits above bit 39, which must be ignored.
+*/
+static void test_ksv(void)
+{
+	static uint8_t List[MAX_KSVS * SHA1KsvSize];
+	uint64_t KsvList[MAX_KSVS];
+	uint8_t Prefix[64];
+	uint8_t Expected[SHA1HashSize];
+	uint8_t Hash[SHA1HashSize];
+	SHA1Context Ctx;
+	int OkKsv = 1;
+	int OkFifo = 1;
+	int Count, Skip, i;
+
+	for (i = 0; i < (int)sizeof(Prefix); i++) {
+		Prefix[i] = (uint8_t)rand32();
+	}
+
+	for (Count = 0; Count <= MAX_KSVS; Count++) {
+		for (i = 0; i < Count; i++) {
+			KsvList[i] = ((uint64_t)rand32() << 32) | rand32();
+			ksv_to_buf(&List[i * SHA1KsvSize], KsvList[i]);
+		}
+		for (Skip = 0; Skip < 64; Skip++) {
+			ref_SHA1Reset(&Ctx);
+			ref_SHA1Input(&Ctx, Prefix, Skip);
+			ref_SHA1Input(&Ctx, List, Count * SHA1KsvSize);
+			ref_SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+			ref_SHA1Result(&Ctx, Expected);
+
+			SHA1Reset(&Ctx);
+			SHA1Input(&Ctx, Prefix, Skip);
+			for (i = 0; i < Count; i++) {
+				SHA1InputKsv(&Ctx, KsvList[i]);
+			}
+			SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+			SHA1Result(&Ctx, Hash);
+			OkKsv &= memcmp(Hash, Expected, sizeof(Hash)) == 0;
+
+			SHA1Reset(&Ctx);
+			SHA1Input(&Ctx, Prefix, Skip);
+			for (i = 0; i < Count * SHA1KsvSize; i += KSV_FIFO_READ) {
+				int Part = Count * SHA1KsvSize - i;
+
+				if (Part > KSV_FIFO_READ) {
+					Part = KSV_FIFO_READ;
+				}
+				SHA1Input(&Ctx, &List[i], Part);
+			}
+			SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+			SHA1Result(&Ctx, Hash);
+			OkFifo &= memcmp(Hash, Expected, sizeof(Hash)) == 0;
+		}
+	}
+	check("SHA1InputKsv, 0 to 127 KSVs at all offsets", OkKsv);
+	check("KSV FIFO reads of 15 bytes", OkFifo);
+}
+
+/*****************************************************************************/
+/*
+* Error codes of the RFC 3174 interface, which did not change.
+*/
+static void test_errors(void)
+{
+	uint8_t Hash[SHA1HashSize];
+	uint8_t Again[SHA1HashSize];
+	SHA1Context Ctx;
+	int Ok;
+
+	Ok = SHA1Reset(NULL) == shaNull;
+	Ok &= SHA1Input(NULL, Trailer, 1) == shaNull;
+	Ok &= SHA1InputKsv(NULL, 0) == shaNull;
+	SHA1Reset(&Ctx);
+	Ok &= SHA1Input(&Ctx, NULL, 1) == shaNull;
+	Ok &= SHA1Input(&Ctx, NULL, 0) == shaSuccess;
+	Ok &= SHA1Result(&Ctx, NULL) == shaNull;
+	check("null pointers", Ok);
+
+	SHA1Reset(&Ctx);
+	SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+	Ok = SHA1Result(&Ctx, Hash) == shaSuccess;
+	Ok &= SHA1Result(&Ctx, Again) == shaSuccess;
+	Ok &= memcmp(Hash, Again, sizeof(Hash)) == 0;
+	check("SHA1Result twice", Ok);
+
+	Ok = SHA1InputKsv(&Ctx, 0x1122334455ull) == shaStateError;
+	Ok &= SHA1Result(&Ctx, Hash) == shaStateError;
+	SHA1Reset(&Ctx);
+	SHA1Result(&Ctx, Hash);
+	Ok &= SHA1Input(&Ctx, Trailer, 1) == shaStateError;
+	Ok &= SHA1Result(&Ctx, Hash) == shaStateError;
+	check("input after SHA1Result", Ok);
+}
+
+/*****************************************************************************/
+/*
+* The ways of computing V' that are timed. All hash the same message: the
+* KSV list, Binfo and Mo.
+*/
+
+/* Reference code, one SHA1Input() per KSV as the receiver did before */
+static void v_reference(const uint64_t *KsvList, int Count, uint8_t *Digest)
+{
+	SHA1Context Ctx;
+	uint8_t Buf[SHA1KsvSize];
+	int i;
+
+	ref_SHA1Reset(&Ctx);
+	for (i = 0; i < Count; i++) {
+		ksv_to_buf(Buf, KsvList[i]);
+		ref_SHA1Input(&Ctx, Buf, SHA1KsvSize);
+	}
+	ref_SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+	ref_SHA1Result(&Ctx, Digest);
+}
+
+/* One SHA1Input() per KSV */
+static void v_input(const uint64_t *KsvList, int Count, uint8_t *Digest)
+{
+	SHA1Context Ctx;
+	uint8_t Buf[SHA1KsvSize];
+	int i;
+
+	SHA1Reset(&Ctx);
+	for (i = 0; i < Count; i++) {
+		ksv_to_buf(Buf, KsvList[i]);
+		SHA1Input(&Ctx, Buf, SHA1KsvSize);
+	}
+	SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+	SHA1Result(&Ctx, Digest);
+}
+
+/* SHA1InputKsv(), the receiver */
+static void v_ksv(const uint64_t *KsvList, int Count, uint8_t *Digest)
+{
+	SHA1Context Ctx;
+	int i;
+
+	SHA1Reset(&Ctx);
+	for (i = 0; i < Count; i++) {
+		SHA1InputKsv(&Ctx, KsvList[i]);
+	}
+	SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+	SHA1Result(&Ctx, Digest);
+}
+
+/* The KSV list as read from the FIFO, 15 bytes (DP) or all at once (HDMI) */
+static uint8_t FifoList[MAX_KSVS * SHA1KsvSize];
+
+static void v_fifo(const uint64_t *KsvList, int Count, uint8_t *Digest,
+		int ReadSize)
+{
+	SHA1Context Ctx;
+	int Size = Count * SHA1KsvSize;
+	int i;
+
+	(void)KsvList;
+	SHA1Reset(&Ctx);
+	for (i = 0; i < Size; i += ReadSize) {
+		SHA1Input(&Ctx, &FifoList[i],
+				(Size - i) < ReadSize ? (Size - i) : ReadSize);
+	}
+	SHA1Input(&Ctx, Trailer, sizeof(Trailer));
+	SHA1Result(&Ctx, Digest);
+}
+
+static void v_fifo_dp(const uint64_t *KsvList, int Count, uint8_t *Digest)
+{
+	v_fifo(KsvList, Count, Digest, KSV_FIFO_READ);
+}
+
+static void v_fifo_hdmi(const uint64_t *KsvList, int Count, uint8_t *Digest)
+{
+	v_fifo(KsvList, Count, Digest, sizeof(FifoList));
+}
+
+/*****************************************************************************/
+/*
+* Times V' for KSV lists of 1, 16, 64 and 127 devices and the hash of
+* 16384 bytes. MHz converts ns to cycles on hosts without a time stamp
+* counter, 0 leaves the cycles out.
+*/
+static void bench(int Count, double Mhz)
+{
+	static const int Ksvs[] = { 1, 16, 64, MAX_KSVS };
+	static const struct { const char *Name; KsvMethod Method; } Methods[] = {
+		{ "reference", v_reference },
+		{ "SHA1Input/KSV", v_input },
+		{ "SHA1InputKsv", v_ksv },
+		{ "FIFO 15 bytes", v_fifo_dp },
+		{ "FIFO one read", v_fifo_hdmi },
+	};
+	static uint8_t Message[16384];
+	uint64_t KsvList[MAX_KSVS];
+	uint8_t Digest[SHA1HashSize];
+	SHA1Context Ctx;
+	double Start, Ns = 0;
+	uint64_t Cycles;
+	size_t m, k;
+	int Loops, i;
+
+	for (i = 0; i < MAX_KSVS; i++) {
+		KsvList[i] = ((uint64_t)rand32() << 32) | rand32();
+		ksv_to_buf(&FifoList[i * SHA1KsvSize], KsvList[i]);
+	}
+	for (i = 0; i < (int)sizeof(Message); i++) {
+		Message[i] = (uint8_t)rand32();
+	}
+
+	/* Warm up the caches and the clock frequency */
+	for (i = 0; i < Count * 100; i++) {
+		v_ksv(KsvList, MAX_KSVS, Digest);
+	}
+
+	printf("\n%-14s", "cycles/KSV");
+	for (k = 0; k < sizeof(Ksvs) / sizeof(Ksvs[0]); k++) {
+		printf(" %9d", Ksvs[k]);
+	}
+	printf(" %9s\n", "us@127");
+	for (m = 0; m < sizeof(Methods) / sizeof(Methods[0]); m++) {
+		printf("%-14s", Methods[m].Name);
+		for (k = 0; k < sizeof(Ksvs) / sizeof(Ksvs[0]); k++) {
+			Loops = Count * 1000 / Ksvs[k];
+			Start = now_ns();
+			Cycles = now_cycles();
+			for (i = 0; i < Loops; i++) {
+				Methods[m].Method(KsvList, Ksvs[k], Digest);
+			}
+			Ns = (now_ns() - Start) / Loops;
+			Cycles = bench_cycles(now_cycles() - Cycles, Ns * Loops,
+					Mhz);
+			printf(" %9.1f", (double)Cycles / Loops / Ksvs[k]);
+		}
+		/* Ns is the time of the last column */
+		printf(" %9.2f\n", Ns / 1e3);
+	}
+
+	printf("\n%-14s %9s %9s %9s\n", "16384 bytes", "us", "cyc/byte",
+			"MB/s");
+	for (m = 0; m < 2; m++) {
+		Loops = Count;
+		Start = now_ns();
+		Cycles = now_cycles();
+		for (i = 0; i < Loops; i++) {
+			if (m == 0) {
+				ref_SHA1Reset(&Ctx);
+				ref_SHA1Input(&Ctx, Message, sizeof(Message));
+				ref_SHA1Result(&Ctx, Digest);
+			} else {
+				SHA1Reset(&Ctx);
+				SHA1Input(&Ctx, Message, sizeof(Message));
+				SHA1Result(&Ctx, Digest);
+			}
+		}
+		Ns = (now_ns() - Start) / Loops;
+		Cycles = bench_cycles(now_cycles() - Cycles, Ns * Loops, Mhz);
+		printf("%-14s %9.1f %9.2f %9.1f\n", m ? "sha1" : "reference",
+				Ns / 1e3, (double)Cycles / Loops / sizeof(Message),
+				sizeof(Message) * 1e3 / Ns);
+	}
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n count] [-m MHz]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Count = 200;
+	double Mhz = 0;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:m:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Count = atoi(optarg);
+			break;
+		case 'm':
+			Mhz = atof(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Count <= 0) {
+		usage(argv[0]);
+	}
+
+	test_vectors();
+	test_stream();
+	test_ksv();
+	test_errors();
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	bench(Count, Mhz);
+
+	return 0;
+}
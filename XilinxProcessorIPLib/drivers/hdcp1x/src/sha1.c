@@ -20,6 +20,17 @@
  *      support 32 bit unsigned integers, this code is not
  *      appropriate.
  *
+ *  Implementation:
+ *      The message is consumed a 32-bit word at a time.  Whole 64-octet
+ *      blocks are compressed straight from the caller's buffer and only
+ *      a partial block is copied into the context.  The word schedule is
+ *      kept in a rolling window of 16 words instead of 80 and the 80
+ *      rounds are unrolled, so that no array copy or register shuffle is
+ *      done per round.  The words are assembled with shifts, so the code
+ *      is independent of the byte order and the alignment of the input.
+ *      SHA1InputKsv() adds one 40-bit HDCP KSV to the message without
+ *      the caller converting it to octets first.
+ *
  *  Caveats:
  *      SHA-1 is designed to work with messages less than 2^64 bits
  *      long.  Although SHA-1 allows a message digest to be generated
@@ -37,9 +48,51 @@
 #define SHA1CircularShift(bits,word) \
                 (((word) << (bits)) | ((word) >> (32-(bits))))
 
+/*
+ *  The round functions of FIPS PUB 180-1 in the forms with the fewest
+ *  operations: Ch for rounds 0-19, Parity for 20-39 and 60-79, Maj for
+ *  rounds 40-59
+ */
+#define SHA1Ch(b,c,d)       ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1Parity(b,c,d)   ((b) ^ (c) ^ (d))
+#define SHA1Maj(b,c,d)      (((b) & (c)) | ((d) & ((b) | (c))))
+
+/*
+ *  Word t of the message schedule.  W[] holds the last 16 words, the
+ *  first 16 are loaded from the block, the others replace W[t-16].
+ *  t is always a constant so the test is resolved by the compiler.
+ */
+#define SHA1Word(t) \
+                ((t) < 16 ? W[(t)] : \
+                 (W[(t) & 15] = SHA1CircularShift(1, \
+                        W[((t) - 3) & 15] ^ W[((t) - 8) & 15] ^ \
+                        W[((t) - 14) & 15] ^ W[(t) & 15])))
+
+/*
+ *  One round, the variables rotate by naming them in a different order
+ *  in the next round instead of moving the values
+ */
+#define SHA1Round(a,b,c,d,e,f,k,t) \
+                do { \
+                    e += SHA1CircularShift(5,a) + f(b,c,d) + (k) + \
+                         SHA1Word(t); \
+                    b = SHA1CircularShift(30,b); \
+                } while (0)
+
+#define SHA1Rounds5(f,k,t) \
+                do { \
+                    SHA1Round(A, B, C, D, E, f, k, (t)); \
+                    SHA1Round(E, A, B, C, D, f, k, (t) + 1); \
+                    SHA1Round(D, E, A, B, C, f, k, (t) + 2); \
+                    SHA1Round(C, D, E, A, B, f, k, (t) + 3); \
+                    SHA1Round(B, C, D, E, A, f, k, (t) + 4); \
+                } while (0)
+
 /* Local Function Prototyptes */
-void SHA1PadMessage(SHA1Context *);
-void SHA1ProcessMessageBlock(SHA1Context *);
+static void SHA1PadMessage(SHA1Context *);
+static void SHA1ProcessMessageBlock(SHA1Context *);
+static void SHA1ProcessBlocks(uint32_t *, const uint8_t *, unsigned);
+static int SHA1AddLength(SHA1Context *, unsigned);
 
 /*
  *  SHA1Reset
@@ -118,21 +171,23 @@ int SHA1Result( SHA1Context *context,
     if (!context->Computed)
     {
         SHA1PadMessage(context);
-        for(i=0; i<64; ++i)
-        {
-            /* message may be sensitive, clear it out */
-            context->Message_Block[i] = 0;
-        }
+
+        /* message may be sensitive, clear it out */
+        memset(context->Message_Block, 0, 64);
         context->Length_Low = 0;    /* and clear length */
         context->Length_High = 0;
         context->Computed = 1;
 
     }
 
-    for(i = 0; i < SHA1HashSize; ++i)
+    for(i = 0; i < SHA1HashSize / 4; ++i)
     {
-        Message_Digest[i] = context->Intermediate_Hash[i>>2]
-                            >> 8 * ( 3 - ( i & 0x03 ) );
+        uint32_t h = context->Intermediate_Hash[i];
+
+        Message_Digest[4 * i]     = (uint8_t)(h >> 24);
+        Message_Digest[4 * i + 1] = (uint8_t)(h >> 16);
+        Message_Digest[4 * i + 2] = (uint8_t)(h >> 8);
+        Message_Digest[4 * i + 3] = (uint8_t)h;
     }
 
     return shaSuccess;
@@ -143,7 +198,9 @@ int SHA1Result( SHA1Context *context,
  *
  *  Description:
  *      This function accepts an array of octets as the next portion
- *      of the message.
+ *      of the message.  It may be called with any number of octets at
+ *      a time, for example with each read of the KSV FIFO as it
+ *      arrives.
  *
  *  Parameters:
  *      context: [in/out]
@@ -162,6 +219,9 @@ int SHA1Input(    SHA1Context    *context,
                   const uint8_t  *message_array,
                   unsigned       length)
 {
+    unsigned index;
+    unsigned count;
+
     if (!length)
     {
         return shaSuccess;
@@ -183,137 +243,257 @@ int SHA1Input(    SHA1Context    *context,
     {
          return context->Corrupted;
     }
-    while(length-- && !context->Corrupted)
+
+    if (SHA1AddLength(context, length) != shaSuccess)
     {
-    context->Message_Block[context->Message_Block_Index++] =
-                    (*message_array & 0xFF);
+        return context->Corrupted;
+    }
 
-    context->Length_Low += 8;
-    if (context->Length_Low == 0)
+    /*
+     *  Complete a partial block first
+     */
+    index = (unsigned)context->Message_Block_Index;
+    if (index)
     {
-        context->Length_High++;
-        if (context->Length_High == 0)
+        count = 64 - index;
+        if (count > length)
         {
-            /* Message is too long */
-            context->Corrupted = 1;
+            count = length;
         }
+
+        memcpy(&context->Message_Block[index], message_array, count);
+        context->Message_Block_Index = (int_least16_t)(index + count);
+        message_array += count;
+        length -= count;
+
+        if (context->Message_Block_Index < 64)
+        {
+            return shaSuccess;
+        }
+
+        SHA1ProcessMessageBlock(context);
     }
 
-    if (context->Message_Block_Index == 64)
+    /*
+     *  Whole blocks are processed without copying them
+     */
+    if (length >= 64)
     {
-        SHA1ProcessMessageBlock(context);
+        SHA1ProcessBlocks(context->Intermediate_Hash, message_array,
+                          length / 64);
+        message_array += length & ~63u;
+        length &= 63;
     }
 
-    message_array++;
+    if (length)
+    {
+        memcpy(context->Message_Block, message_array, length);
+        context->Message_Block_Index = (int_least16_t)length;
     }
 
     return shaSuccess;
 }
 
 /*
- *  SHA1ProcessMessageBlock
+ *  SHA1InputKsv
  *
  *  Description:
- *      This function will process the next 512 bits of the message
- *      stored in the Message_Block array.
+ *      This function adds an HDCP 1.x KSV as the next 5 octets of the
+ *      message, least significant octet first as it is transferred in
+ *      the KSV FIFO.  This is the same as converting the KSV to a
+ *      5 octet buffer and calling SHA1Input() with it.
  *
  *  Parameters:
- *      None.
+ *      context: [in/out]
+ *          The SHA context to update
+ *      ksv: [in]
+ *          The KSV in bits 39:0, the upper bits are ignored.
  *
  *  Returns:
- *      Nothing.
- *
- *  Comments:
-
- *      Many of the variable names in this code, especially the
- *      single character names, were used because those were the
- *      names used in the publication.
- *
+ *      sha Error Code.
  *
  */
-void SHA1ProcessMessageBlock(SHA1Context *context)
+int SHA1InputKsv(SHA1Context *context, uint64_t ksv)
 {
-    const uint32_t K[] =    {       /* Constants defined in SHA-1   */
-                            0x5A827999,
-                            0x6ED9EBA1,
-                            0x8F1BBCDC,
-                            0xCA62C1D6
-                            };
-    int           t;                 /* Loop counter                */
-    uint32_t      temp;              /* Temporary word value        */
-    uint32_t      W[80];             /* Word sequence               */
-    uint32_t      A, B, C, D, E;     /* Word buffers                */
+    uint8_t *p;
+    uint32_t low;
+    unsigned index;
 
-    /*
-     *  Initialize the first 16 words in the array W
-     */
-    for(t = 0; t < 16; t++)
+    if (!context)
     {
-        W[t] = context->Message_Block[t * 4] << 24;
-        W[t] |= context->Message_Block[t * 4 + 1] << 16;
-        W[t] |= context->Message_Block[t * 4 + 2] << 8;
-        W[t] |= context->Message_Block[t * 4 + 3];
+        return shaNull;
     }
 
-    for(t = 16; t < 80; t++)
+    index = (unsigned)context->Message_Block_Index;
+    if (index > 64 - SHA1KsvSize || context->Computed ||
+        context->Corrupted)
     {
-       W[t] = SHA1CircularShift(1,W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]);
-    }
+        /* Crosses a block boundary or an error, the general path */
+        uint8_t buf[SHA1KsvSize];
+        int i;
+
+        for (i = 0; i < SHA1KsvSize; i++)
+        {
+            buf[i] = (uint8_t)ksv;
+            ksv >>= 8;
+        }
 
-    A = context->Intermediate_Hash[0];
-    B = context->Intermediate_Hash[1];
-    C = context->Intermediate_Hash[2];
-    D = context->Intermediate_Hash[3];
-    E = context->Intermediate_Hash[4];
+        return SHA1Input(context, buf, SHA1KsvSize);
+    }
 
-    for(t = 0; t < 20; t++)
+    if (SHA1AddLength(context, SHA1KsvSize) != shaSuccess)
     {
-        temp =  SHA1CircularShift(5,A) +
-                ((B & C) | ((~B) & D)) + E + W[t] + K[0];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-
-        B = A;
-        A = temp;
+        return context->Corrupted;
     }
 
-    for(t = 20; t < 40; t++)
+    low = (uint32_t)ksv;
+    p = &context->Message_Block[index];
+    p[0] = (uint8_t)low;
+    p[1] = (uint8_t)(low >> 8);
+    p[2] = (uint8_t)(low >> 16);
+    p[3] = (uint8_t)(low >> 24);
+    p[4] = (uint8_t)(ksv >> 32);
+
+    context->Message_Block_Index = (int_least16_t)(index + SHA1KsvSize);
+    if (context->Message_Block_Index == 64)
     {
-        temp = SHA1CircularShift(5,A) + (B ^ C ^ D) + E + W[t] + K[1];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
+        SHA1ProcessMessageBlock(context);
     }
 
-    for(t = 40; t < 60; t++)
+    return shaSuccess;
+}
+
+/*
+ *  SHA1AddLength
+ *
+ *  Description:
+ *      This function adds length octets to the message length in bits
+ *      and marks the context as corrupted when it overflows 2^64 bits.
+ *
+ *  Parameters:
+ *      context: [in/out]
+ *          The SHA context to update
+ *      length: [in]
+ *          The number of octets added to the message
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ */
+static int SHA1AddLength(SHA1Context *context, unsigned length)
+{
+    uint32_t low = context->Length_Low;
+    uint32_t high = context->Length_High;
+
+    context->Length_Low = low + ((uint32_t)length << 3);
+    context->Length_High = high + ((uint32_t)length >> 29) +
+                           (context->Length_Low < low);
+    if (context->Length_High < high)
     {
-        temp = SHA1CircularShift(5,A) +
-               ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
+        /* Message is too long */
+        context->Corrupted = shaInputTooLong;
+
+        return shaInputTooLong;
     }
 
-    for(t = 60; t < 80; t++)
+    return shaSuccess;
+}
+
+/*
+ *  SHA1ProcessBlocks
+ *
+ *  Description:
+ *      This function will process blocks consecutive 512-bit blocks
+ *      of the message starting at data.
+ *
+ *  Parameters:
+ *      H: [in/out]
+ *          The intermediate hash, 5 words.
+ *      data: [in]
+ *          The message blocks, no alignment is required.
+ *      blocks: [in]
+ *          The number of blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Many of the variable names in this code, especially the
+ *      single character names, were used because those were the
+ *      names used in the publication.
+ *
+ */
+static void SHA1ProcessBlocks(uint32_t *H, const uint8_t *data,
+                              unsigned blocks)
+{
+    uint32_t      W[16];             /* Word sequence               */
+    uint32_t      A, B, C, D, E;     /* Word buffers                */
+    int           t;                 /* Loop counter                */
+
+    while (blocks--)
     {
-        temp = SHA1CircularShift(5,A) + (B ^ C ^ D) + E + W[t] + K[3];
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30,B);
-        B = A;
-        A = temp;
+        /*
+         *  Initialize the first 16 words in the array W
+         */
+        for(t = 0; t < 16; t++)
+        {
+            W[t] = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                   ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+            data += 4;
+        }
+
+        A = H[0];
+        B = H[1];
+        C = H[2];
+        D = H[3];
+        E = H[4];
+
+        SHA1Rounds5(SHA1Ch, 0x5A827999, 0);
+        SHA1Rounds5(SHA1Ch, 0x5A827999, 5);
+        SHA1Rounds5(SHA1Ch, 0x5A827999, 10);
+        SHA1Rounds5(SHA1Ch, 0x5A827999, 15);
+
+        SHA1Rounds5(SHA1Parity, 0x6ED9EBA1, 20);
+        SHA1Rounds5(SHA1Parity, 0x6ED9EBA1, 25);
+        SHA1Rounds5(SHA1Parity, 0x6ED9EBA1, 30);
+        SHA1Rounds5(SHA1Parity, 0x6ED9EBA1, 35);
+
+        SHA1Rounds5(SHA1Maj, 0x8F1BBCDC, 40);
+        SHA1Rounds5(SHA1Maj, 0x8F1BBCDC, 45);
+        SHA1Rounds5(SHA1Maj, 0x8F1BBCDC, 50);
+        SHA1Rounds5(SHA1Maj, 0x8F1BBCDC, 55);
+
+        SHA1Rounds5(SHA1Parity, 0xCA62C1D6, 60);
+        SHA1Rounds5(SHA1Parity, 0xCA62C1D6, 65);
+        SHA1Rounds5(SHA1Parity, 0xCA62C1D6, 70);
+        SHA1Rounds5(SHA1Parity, 0xCA62C1D6, 75);
+
+        H[0] += A;
+        H[1] += B;
+        H[2] += C;
+        H[3] += D;
+        H[4] += E;
     }
+}
 
-    context->Intermediate_Hash[0] += A;
-    context->Intermediate_Hash[1] += B;
-    context->Intermediate_Hash[2] += C;
-    context->Intermediate_Hash[3] += D;
-    context->Intermediate_Hash[4] += E;
+/*
+ *  SHA1ProcessMessageBlock
+ *
+ *  Description:
+ *      This function will process the next 512 bits of the message
+ *      stored in the Message_Block array.
+ *
+ *  Parameters:
+ *      context: [in/out]
+ *          The SHA context to update
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ */
+static void SHA1ProcessMessageBlock(SHA1Context *context)
+{
+    SHA1ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
 
     context->Message_Block_Index = 0;
 }
@@ -335,57 +515,43 @@ void SHA1ProcessMessageBlock(SHA1Context *context)
  *  Parameters:
  *      context: [in/out]
  *          The context to pad
- *      ProcessMessageBlock: [in]
- *          The appropriate SHA*ProcessMessageBlock function
  *  Returns:
  *      Nothing.
  *
  */
 
-void SHA1PadMessage(SHA1Context *context)
+static void SHA1PadMessage(SHA1Context *context)
 {
+    unsigned index = (unsigned)context->Message_Block_Index;
+
+    context->Message_Block[index++] = 0x80;
+
     /*
      *  Check to see if the current message block is too small to hold
      *  the initial padding bits and length.  If so, we will pad the
      *  block, process it, and then continue padding into a second
      *  block.
      */
-    if (context->Message_Block_Index > 55)
+    if (index > 56)
     {
-        context->Message_Block[context->Message_Block_Index++] = 0x80;
-        while(context->Message_Block_Index < 64)
-        {
-            context->Message_Block[context->Message_Block_Index++] = 0;
-        }
-
+        memset(&context->Message_Block[index], 0, 64 - index);
         SHA1ProcessMessageBlock(context);
-
-        while(context->Message_Block_Index < 56)
-        {
-            context->Message_Block[context->Message_Block_Index++] = 0;
-        }
+        index = 0;
     }
-    else
-    {
-        context->Message_Block[context->Message_Block_Index++] = 0x80;
-        while(context->Message_Block_Index < 56)
-        {
 
-            context->Message_Block[context->Message_Block_Index++] = 0;
-        }
-    }
+    memset(&context->Message_Block[index], 0, 56 - index);
 
     /*
      *  Store the message length as the last 8 octets
      */
-    context->Message_Block[56] = context->Length_High >> 24;
-    context->Message_Block[57] = context->Length_High >> 16;
-    context->Message_Block[58] = context->Length_High >> 8;
-    context->Message_Block[59] = context->Length_High;
-    context->Message_Block[60] = context->Length_Low >> 24;
-    context->Message_Block[61] = context->Length_Low >> 16;
-    context->Message_Block[62] = context->Length_Low >> 8;
-    context->Message_Block[63] = context->Length_Low;
+    context->Message_Block[56] = (uint8_t)(context->Length_High >> 24);
+    context->Message_Block[57] = (uint8_t)(context->Length_High >> 16);
+    context->Message_Block[58] = (uint8_t)(context->Length_High >> 8);
+    context->Message_Block[59] = (uint8_t)context->Length_High;
+    context->Message_Block[60] = (uint8_t)(context->Length_Low >> 24);
+    context->Message_Block[61] = (uint8_t)(context->Length_Low >> 16);
+    context->Message_Block[62] = (uint8_t)(context->Length_Low >> 8);
+    context->Message_Block[63] = (uint8_t)context->Length_Low;
 
     SHA1ProcessMessageBlock(context);
 }
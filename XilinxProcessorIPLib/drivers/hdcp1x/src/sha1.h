@@ -40,6 +40,7 @@ enum
 };
 #endif
 #define SHA1HashSize 20
+#define SHA1KsvSize 5      /* Octets of an HDCP 1.x KSV in the message */
 
 /**
  *  This structure will hold context information for the SHA-1
@@ -67,6 +68,8 @@ int SHA1Reset(  SHA1Context *);
 int SHA1Input(  SHA1Context *,
                 const uint8_t *,
                 unsigned int);
+int SHA1InputKsv(SHA1Context *,
+                uint64_t);
 int SHA1Result( SHA1Context *,
                 uint8_t Message_Digest[SHA1HashSize]);
 
@@ -70,6 +70,8 @@
 *                       XHdcp1x_RxSetTopologyMaxDevsExceeded,
 *                       XHdcp1x_RxCheckEncryptionChange.
 * 4.1   yas    11/10/16 Added function XHdcp1x_RxSetHdmiMode.
+* 4.2   agt    10/17/26 XHdcp1x_RxCalculateSHA1Value hashes the KSV list
+*                       with SHA1InputKsv.
 * </pre>
 *
 *****************************************************************************/
@@ -1332,7 +1334,6 @@ static int XHdcp1x_RxCalculateSHA1Value(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	u32 NumToRead = 0;
 	int IsValid = FALSE;
 	u32 KsvCount;
-	u64 tempKsv;
 
 	/* Initialize Buf */
 	memset(Buf, 0, 24);
@@ -1346,17 +1347,15 @@ static int XHdcp1x_RxCalculateSHA1Value(XHdcp1x *InstancePtr, u16 RepeaterInfo)
 	/* Determine theNumToRead */
 	NumToRead = ((RepeaterInfo & 0x7Fu));
 
-	/* Read one ksv at a time from the
-	 * Ksv List and send it to SHA1 Input
+	/* Send one ksv at a time from the
+	 * Ksv List to the SHA-1 transform
 	 */
 	KsvCount = 0;
 
 	while (KsvCount < NumToRead) {
 		if (InstancePtr->RepeaterValues.DeviceCount > 0) {
-			tempKsv = InstancePtr->RepeaterValues.KsvList[KsvCount];
-			XHDCP1X_PORT_UINT_TO_BUF(Buf , tempKsv ,
-					(XHDCP1X_PORT_SIZE_BKSV*8));
-			SHA1Input(&Sha1Context , Buf , XHDCP1X_PORT_SIZE_BKSV);
+			SHA1InputKsv(&Sha1Context,
+				InstancePtr->RepeaterValues.KsvList[KsvCount]);
 		}
 		else {
 			IsValid = FALSE;
@@ -0,0 +1,494 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file aesbench.c
+*		Host microbenchmark and known-answer tests of the AES-128
+*		functions.
+*
+*		aes.c is linked three times, see Makefile: with the T-tables
+*		(no prefix), with XHDCP22_CMN_AES_CONSTANT_TIME (ct_ prefix)
+*		and with the ARMv8 Crypto Extension instructions (ce_ prefix).
+*		The last one runs on the arm_neon.h emulation of this
+*		directory. The tests check with each build
+*		- the FIPS 197 example and AESAVS GFSbox and KeySbox vectors,
+*		  encryption and decryption
+*		- the NIST SP 800-38A ECB and CTR vectors for AES-128
+*		- random ECB and CTR data of 0 to MAX_CTR_SIZE bytes against
+*		  the T-table build, including the counter carry
+*		- the HDCP key derivation, where the counter is XORed into
+*		  Rrx instead of added
+*		and then time the host builds.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xhdcp22_common.h"
+#include "bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define MAX_CTR_SIZE		300	/* Largest message of the CTR test */
+#define BLOCK			XHDCP22_CMN_AES128_BLOCK_SIZE
+
+/**************************** Type Definitions *******************************/
+
+/* One build of aes.c */
+typedef struct {
+	const char *Name;
+	int Timed;		/* Runs natively, not on the emulation */
+	void (*Encrypt)(const u8 *Data, const u8 *Key, u8 *Output);
+	void (*Decrypt)(const u8 *Data, const u8 *Key, u8 *Output);
+	void (*SetKey)(XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Key);
+	void (*EncryptBlocks)(const XHdcp22Cmn_Aes128Ctx *AesCtx,
+			const u8 *Data, u8 *Output, u32 NumBlocks);
+	void (*Ctr)(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Iv,
+			const u8 *Data, u8 *Output, u32 DataSize);
+	void (*DeriveKeys)(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Iv,
+			u32 Ctr, u8 *Output, u32 NumBlocks);
+} Build;
+
+/* Single block known answer */
+typedef struct {
+	const char *Name;
+	const char *Key;
+	const char *Plain;
+	const char *Cipher;
+} AesVector;
+
+/************************** Function Prototypes ******************************/
+
+/* The prefixed builds of aes.c */
+#define DECLARE_BUILD(p) \
+void p##XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output); \
+void p##XHdcp22Cmn_Aes128Decrypt(const u8 *Data, const u8 *Key, u8 *Output); \
+void p##XHdcp22Cmn_Aes128SetKey(XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Key); \
+void p##XHdcp22Cmn_Aes128EncryptBlocks(const XHdcp22Cmn_Aes128Ctx *AesCtx, \
+		const u8 *Data, u8 *Output, u32 NumBlocks); \
+void p##XHdcp22Cmn_Aes128Ctr(const XHdcp22Cmn_Aes128Ctx *AesCtx, \
+		const u8 *Iv, const u8 *Data, u8 *Output, u32 DataSize); \
+void p##XHdcp22Cmn_Aes128DeriveKeys(const XHdcp22Cmn_Aes128Ctx *AesCtx, \
+		const u8 *Iv, u32 Ctr, u8 *Output, u32 NumBlocks);
+
+DECLARE_BUILD(ct_)
+DECLARE_BUILD(ce_)
+
+#define BUILD(name, timed, p) { name, timed, p##XHdcp22Cmn_Aes128Encrypt, \
+	p##XHdcp22Cmn_Aes128Decrypt, p##XHdcp22Cmn_Aes128SetKey, \
+	p##XHdcp22Cmn_Aes128EncryptBlocks, p##XHdcp22Cmn_Aes128Ctr, \
+	p##XHdcp22Cmn_Aes128DeriveKeys }
+
+/************************** Variable Definitions *****************************/
+
+static const Build Builds[] = {
+	BUILD("ttable", 1, ),
+	BUILD("consttime", 1, ct_),
+	BUILD("armv8ce", 0, ce_),
+};
+
+#define NUM_BUILDS	(sizeof(Builds) / sizeof(Builds[0]))
+
+static const AesVector AesVectors[] = {
+	{ "FIPS 197 C.1", "000102030405060708090a0b0c0d0e0f",
+	  "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a" },
+	{ "GFSbox 0", "00000000000000000000000000000000",
+	  "f34481ec3cc627bacd5dc3fb08f273e6", "0336763e966d92595a567cc9ce537f5e" },
+	{ "GFSbox 1", "00000000000000000000000000000000",
+	  "9798c4640bad75c7c3227db910174e72", "a9a1631bf4996954ebc093957b234589" },
+	{ "GFSbox 2", "00000000000000000000000000000000",
+	  "96ab5c2ff612d9dfaae8c31f30c42168", "ff4f8391a6a40ca5b25d23bedd44a597" },
+	{ "KeySbox 0", "10a58869d74be5a374cf867cfb473859",
+	  "00000000000000000000000000000000", "6d251e6944b051e04eaa6fb4dbf78465" },
+};
+
+/* NIST SP 800-38A, F.1.1 ECB-AES128 and F.5.1 CTR-AES128 */
+static const char Sp800Key[] = "2b7e151628aed2a6abf7158809cf4f3c";
+static const char Sp800CtrIv[] = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+static const char Sp800Plain[] =
+	"6bc1bee22e409f96e93d7e117393172a" "ae2d8a571e03ac9c9eb76fac45af8e51"
+	"30c81c46a35ce411e5fbc1191a0a52ef" "f69f2445df4f9b17ad2b417be66c3710";
+static const char Sp800Ecb[] =
+	"3ad77bb40d7a3660a89ecaf32466ef97" "f5d3d58503b9699de785895a96fdbaaf"
+	"43b1cd7f598ece23881b00e3ed030688" "7b0c785e27e8ad3f8223207104725dd4";
+static const char Sp800Ctr[] =
+	"874d6191b620e3261bef6864990db6ce" "9806f66b7970fdff8617187bb9fffdff"
+	"5ae4df3edbd5d35e5b4f09020db03eab" "1e031dda2fbe03d1792170a0f3009cee";
+
+static u32 RandState = 0x2545F491;
+
+/*****************************************************************************/
+/*
+* xorshift32, the tests are repeatable
+*/
+static u32 rand32(void)
+{
+	RandState ^= RandState << 13;
+	RandState ^= RandState >> 17;
+	RandState ^= RandState << 5;
+	return RandState;
+}
+
+/* Converts a hex string, returns the number of bytes */
+static int from_hex(u8 *Bytes, const char *Hex)
+{
+	int i, n = (int)strlen(Hex) / 2;
+	unsigned int Byte;
+
+	for (i = 0; i < n; i++) {
+		sscanf(&Hex[2 * i], "%2x", &Byte);
+		Bytes[i] = (u8)Byte;
+	}
+	return n;
+}
+
+/*****************************************************************************/
+/*
+* Single block vectors with the one-shot functions and a key context
+*/
+static void test_vectors(void)
+{
+	XHdcp22Cmn_Aes128Ctx AesCtx;
+	u8 Key[BLOCK], Plain[BLOCK], Cipher[BLOCK], Out[BLOCK];
+	char Name[64];
+	size_t b, v;
+	int Ok;
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		for (v = 0; v < sizeof(AesVectors) / sizeof(AesVectors[0]); v++) {
+			from_hex(Key, AesVectors[v].Key);
+			from_hex(Plain, AesVectors[v].Plain);
+			from_hex(Cipher, AesVectors[v].Cipher);
+
+			Builds[b].Encrypt(Plain, Key, Out);
+			Ok = memcmp(Out, Cipher, BLOCK) == 0;
+			Builds[b].SetKey(&AesCtx, Key);
+			Builds[b].EncryptBlocks(&AesCtx, Plain, Out, 1);
+			Ok &= memcmp(Out, Cipher, BLOCK) == 0;
+			Builds[b].Decrypt(Cipher, Key, Out);
+			Ok &= memcmp(Out, Plain, BLOCK) == 0;
+
+			snprintf(Name, sizeof(Name), "%s aes128 %s", Builds[b].Name,
+					AesVectors[v].Name);
+			check(Name, Ok);
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+* SP 800-38A, ECB in one call and block by block decryption, CTR forward
+* and backward and in place
+*/
+static void test_sp800(void)
+{
+	XHdcp22Cmn_Aes128Ctx AesCtx;
+	u8 Key[BLOCK], Iv[BLOCK];
+	u8 Plain[4 * BLOCK], Ecb[4 * BLOCK], Ctr[4 * BLOCK], Out[4 * BLOCK];
+	char Name[64];
+	size_t b;
+	int i, Ok;
+
+	from_hex(Key, Sp800Key);
+	from_hex(Iv, Sp800CtrIv);
+	from_hex(Plain, Sp800Plain);
+	from_hex(Ecb, Sp800Ecb);
+	from_hex(Ctr, Sp800Ctr);
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		Builds[b].SetKey(&AesCtx, Key);
+
+		Builds[b].EncryptBlocks(&AesCtx, Plain, Out, 4);
+		Ok = memcmp(Out, Ecb, sizeof(Ecb)) == 0;
+		for (i = 0; i < 4; i++) {
+			Builds[b].Decrypt(&Ecb[i * BLOCK], Key, &Out[i * BLOCK]);
+		}
+		Ok &= memcmp(Out, Plain, sizeof(Plain)) == 0;
+		snprintf(Name, sizeof(Name), "%s SP 800-38A F.1 ECB-AES128",
+				Builds[b].Name);
+		check(Name, Ok);
+
+		Builds[b].Ctr(&AesCtx, Iv, Plain, Out, sizeof(Plain));
+		Ok = memcmp(Out, Ctr, sizeof(Ctr)) == 0;
+		Builds[b].Ctr(&AesCtx, Iv, Out, Out, sizeof(Out));
+		Ok &= memcmp(Out, Plain, sizeof(Plain)) == 0;
+		snprintf(Name, sizeof(Name), "%s SP 800-38A F.5 CTR-AES128",
+				Builds[b].Name);
+		check(Name, Ok);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Random keys and data against the T-table build: ECB of 0 to 9 blocks and
+* CTR of 0 to MAX_CTR_SIZE bytes, with counters that carry over 32 and 128
+* bits
+*/
+static void test_random(void)
+{
+	static u8 Data[MAX_CTR_SIZE + BLOCK], Out[MAX_CTR_SIZE + BLOCK];
+	static u8 Expected[MAX_CTR_SIZE + BLOCK];
+	XHdcp22Cmn_Aes128Ctx AesCtx, RefCtx;
+	u8 Key[BLOCK], Iv[BLOCK], Counter[BLOCK], Stream[BLOCK];
+	char Name[64];
+	u32 Size, Idx;
+	size_t b;
+	int Byte, OkEcb, OkCtr;
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		OkEcb = OkCtr = 1;
+		for (Size = 0; Size <= MAX_CTR_SIZE; Size++) {
+			for (Idx = 0; Idx < BLOCK; Idx++) {
+				Key[Idx] = (u8)rand32();
+				Iv[Idx] = (Size % 3 == 0) ? 0xFF : (u8)rand32();
+			}
+			for (Idx = 0; Idx < sizeof(Data); Idx++) {
+				Data[Idx] = (u8)rand32();
+			}
+			XHdcp22Cmn_Aes128SetKey(&RefCtx, Key);
+			Builds[b].SetKey(&AesCtx, Key);
+
+			if (Size % BLOCK == 0 && Size <= 9 * BLOCK) {
+				XHdcp22Cmn_Aes128EncryptBlocks(&RefCtx, Data, Expected,
+						Size / BLOCK);
+				Builds[b].EncryptBlocks(&AesCtx, Data, Out, Size / BLOCK);
+				OkEcb &= memcmp(Out, Expected, Size) == 0;
+			}
+
+			/* Reference CTR from single blocks */
+			memcpy(Counter, Iv, BLOCK);
+			for (Idx = 0; Idx < Size; Idx++) {
+				if (Idx % BLOCK == 0) {
+					XHdcp22Cmn_Aes128EncryptBlocks(&RefCtx, Counter,
+							Stream, 1);
+					for (Byte = BLOCK - 1; Byte >= 0; Byte--) {
+						if (++Counter[Byte] != 0) {
+							break;
+						}
+					}
+				}
+				Expected[Idx] = Data[Idx] ^ Stream[Idx % BLOCK];
+			}
+			memset(Out, 0, sizeof(Out));
+			Builds[b].Ctr(&AesCtx, Iv, Data, Out, Size);
+			OkCtr &= memcmp(Out, Expected, Size) == 0;
+			OkCtr &= Out[Size] == 0;
+			Builds[b].Ctr(&AesCtx, Iv, Data, Data, Size);
+			OkCtr &= memcmp(Data, Expected, Size) == 0;
+		}
+		snprintf(Name, sizeof(Name), "%s ecb random 0..9 blocks",
+				Builds[b].Name);
+		check(Name, OkEcb);
+		snprintf(Name, sizeof(Name), "%s ctr random 0..%d bytes",
+				Builds[b].Name, MAX_CTR_SIZE);
+		check(Name, OkCtr);
+	}
+}
+
+/*****************************************************************************/
+/*
+* HDCP key derivation: dkey_i = AES(Km, Rtx || (Rrx XOR i)). An odd Rrx
+* shows the difference between XORing and adding the counter.
+*/
+static void test_derive(void)
+{
+	XHdcp22Cmn_Aes128Ctx AesCtx;
+	u8 Km[BLOCK], Iv[BLOCK], Block[BLOCK];
+	u8 Keys[4 * BLOCK], Expected[4 * BLOCK];
+	char Name[64];
+	size_t b;
+	u32 Ctr, Num, i;
+	int Ok;
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		Ok = 1;
+		for (i = 0; i < BLOCK; i++) {
+			Km[i] = (u8)rand32();
+			Iv[i] = (u8)rand32();
+		}
+		Iv[BLOCK - 1] |= 0x01;
+		Builds[b].SetKey(&AesCtx, Km);
+
+		for (Ctr = 0; Ctr < 3; Ctr++) {
+			for (Num = 1; Num <= 4; Num++) {
+				for (i = 0; i < Num; i++) {
+					memcpy(Block, Iv, BLOCK);
+					Block[BLOCK - 1] ^= (u8)(Ctr + i);
+					XHdcp22Cmn_Aes128Encrypt(Block, Km,
+							&Expected[i * BLOCK]);
+				}
+				Builds[b].DeriveKeys(&AesCtx, Iv, Ctr, Keys, Num);
+				Ok &= memcmp(Keys, Expected, Num * BLOCK) == 0;
+			}
+		}
+		snprintf(Name, sizeof(Name), "%s hdcp dkey derivation",
+				Builds[b].Name);
+		check(Name, Ok);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Times the native builds. MHz converts ns to cycles on hosts without a
+* time stamp counter, 0 leaves the cycles out.
+*/
+static void bench(int Count, double Mhz)
+{
+	static const u32 Blocks[] = { 1, 4, 64, 1024 };
+	static u8 Data[1024 * BLOCK], Out[1024 * BLOCK];
+	XHdcp22Cmn_Aes128Ctx AesCtx;
+	u8 Key[BLOCK], Iv[BLOCK], Kd[2 * BLOCK];
+	double Start, Ns;
+	u64 Cycles;
+	int Loops, i;
+	size_t b, s;
+
+	for (i = 0; i < (int)sizeof(Data); i++) {
+		Data[i] = (u8)rand32();
+	}
+	memcpy(Key, Data, BLOCK);
+	memcpy(Iv, Data + BLOCK, BLOCK);
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		if (!Builds[b].Timed) {
+			continue;
+		}
+		Builds[b].SetKey(&AesCtx, Key);
+
+		/* Warm up the caches and the clock frequency */
+		for (i = 0; i < Count * 100; i++) {
+			Builds[b].EncryptBlocks(&AesCtx, Data, Out, 1);
+		}
+
+		printf("\n%-10s %-8s %9s %9s %9s %9s\n", Builds[b].Name, "blocks",
+				"ns", "ns/block", "cyc/byte", "MB/s");
+		for (s = 0; s < sizeof(Blocks) / sizeof(Blocks[0]); s++) {
+			Loops = (int)(Count * 1024 / Blocks[s]);
+			Start = now_ns();
+			Cycles = now_cycles();
+			for (i = 0; i < Loops; i++) {
+				Builds[b].EncryptBlocks(&AesCtx, Data, Out, Blocks[s]);
+			}
+			Ns = (now_ns() - Start) / Loops;
+			Cycles = bench_cycles(now_cycles() - Cycles, Ns * Loops,
+					Mhz);
+			printf("%-10s %-8u %9.0f %9.1f %9.2f %9.1f\n", "ecb",
+					Blocks[s], Ns, Ns / Blocks[s],
+					(double)Cycles / Loops / (Blocks[s] * BLOCK),
+					Blocks[s] * BLOCK * 1e3 / Ns);
+		}
+
+		Loops = Count;
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			Builds[b].Ctr(&AesCtx, Iv, Data, Out, sizeof(Data));
+		}
+		Ns = (now_ns() - Start) / Loops;
+		printf("%-10s %-8u %9.0f %9.1f %9s %9.1f\n", "ctr", 1024, Ns,
+				Ns / 1024, "", sizeof(Data) * 1e3 / Ns);
+
+		Loops = Count * 100;
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			Builds[b].SetKey(&AesCtx, Key);
+		}
+		printf("%-19s %9.0f\n", "key setup",
+				(now_ns() - Start) / Loops);
+
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			Builds[b].Encrypt(Data, Key, Out);
+			Builds[b].Encrypt(Data + BLOCK, Key, Out + BLOCK);
+		}
+		printf("%-19s %9.0f\n", "kd, 2 x Encrypt",
+				(now_ns() - Start) / Loops);
+
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			Builds[b].SetKey(&AesCtx, Key);
+			Builds[b].DeriveKeys(&AesCtx, Iv, 0, Kd, 2);
+		}
+		printf("%-19s %9.0f\n", "kd, DeriveKeys",
+				(now_ns() - Start) / Loops);
+	}
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n count] [-m MHz]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Count = 200;
+	double Mhz = 0;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:m:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Count = atoi(optarg);
+			break;
+		case 'm':
+			Mhz = atof(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Count <= 0) {
+		usage(argv[0]);
+	}
+
+	test_vectors();
+	test_sp800();
+	test_random();
+	test_derive();
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	bench(Count, Mhz);
+
+	return 0;
+}
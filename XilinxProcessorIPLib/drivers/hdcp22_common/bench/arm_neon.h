@@ -0,0 +1,370 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*
+ * Host emulation of the arm_neon.h intrinsics used by ../src/sha2.c and
+ * ../src/aes.c, so that their NEON and ARMv8 Crypto Extension code can be
+ * built and checked on any host. Only meant for correctness, not for timing.
+ * The SHA256 and AES instructions follow the pseudocode of the Arm
+ * Architecture Reference Manual.
+ */
+#ifndef ARM_NEON_H_HOST
+#define ARM_NEON_H_HOST
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct { uint8_t v[16]; } uint8x16_t;
+typedef struct { uint32_t v[2]; } uint32x2_t;
+typedef struct { uint32_t v[4]; } uint32x4_t;
+
+static inline uint32_t neon_ror(uint32_t x, int n)
+{
+	return (x >> n) | (x << (32 - n));
+}
+
+static inline uint8x16_t vld1q_u8(const uint8_t *p)
+{
+	uint8x16_t r;
+	memcpy(r.v, p, 16);
+	return r;
+}
+
+static inline uint32x4_t vld1q_u32(const uint32_t *p)
+{
+	uint32x4_t r;
+	memcpy(r.v, p, 16);
+	return r;
+}
+
+static inline void vst1q_u32(uint32_t *p, uint32x4_t a)
+{
+	memcpy(p, a.v, 16);
+}
+
+static inline void vst1q_u8(uint8_t *p, uint8x16_t a)
+{
+	memcpy(p, a.v, 16);
+}
+
+static inline uint32x4_t vdupq_n_u32(uint32_t x)
+{
+	uint32x4_t r = { { x, x, x, x } };
+	return r;
+}
+
+static inline uint8x16_t vdupq_n_u8(uint8_t x)
+{
+	uint8x16_t r;
+	memset(r.v, x, 16);
+	return r;
+}
+
+static inline uint32_t vgetq_lane_u32(uint32x4_t a, int n)
+{
+	return a.v[n];
+}
+
+static inline uint8x16_t vrev32q_u8(uint8x16_t a)
+{
+	uint8x16_t r;
+	int i;
+	for (i = 0; i < 16; i++)
+		r.v[i] = a.v[(i & ~3) + 3 - (i & 3)];
+	return r;
+}
+
+/* Lane 0 is the lowest address, as on a little endian A53 */
+static inline uint32x4_t vreinterpretq_u32_u8(uint8x16_t a)
+{
+	uint32x4_t r;
+	int i;
+	for (i = 0; i < 4; i++)
+		r.v[i] = (uint32_t)a.v[4*i] | ((uint32_t)a.v[4*i+1] << 8) |
+			 ((uint32_t)a.v[4*i+2] << 16) | ((uint32_t)a.v[4*i+3] << 24);
+	return r;
+}
+
+static inline uint8x16_t vreinterpretq_u8_u32(uint32x4_t a)
+{
+	uint8x16_t r;
+	int i;
+	for (i = 0; i < 16; i++)
+		r.v[i] = (uint8_t)(a.v[i / 4] >> (8 * (i % 4)));
+	return r;
+}
+
+#define NEON_LANEWISE(name, type, lanes, expr) \
+static inline type name(type a, type b) \
+{ \
+	type r; \
+	int i; \
+	for (i = 0; i < lanes; i++) \
+		r.v[i] = (expr); \
+	return r; \
+}
+
+NEON_LANEWISE(vaddq_u32, uint32x4_t, 4, a.v[i] + b.v[i])
+NEON_LANEWISE(veorq_u32, uint32x4_t, 4, a.v[i] ^ b.v[i])
+NEON_LANEWISE(vadd_u32, uint32x2_t, 2, a.v[i] + b.v[i])
+NEON_LANEWISE(veor_u32, uint32x2_t, 2, a.v[i] ^ b.v[i])
+NEON_LANEWISE(veorq_u8, uint8x16_t, 16, a.v[i] ^ b.v[i])
+
+#define NEON_SHIFT(name, type, lanes, expr) \
+static inline type name(type a, int n) \
+{ \
+	type r; \
+	int i; \
+	for (i = 0; i < lanes; i++) \
+		r.v[i] = (expr); \
+	return r; \
+}
+
+NEON_SHIFT(vshrq_n_u32, uint32x4_t, 4, a.v[i] >> n)
+NEON_SHIFT(vshlq_n_u32, uint32x4_t, 4, a.v[i] << n)
+NEON_SHIFT(vshr_n_u32, uint32x2_t, 2, a.v[i] >> n)
+NEON_SHIFT(vshl_n_u32, uint32x2_t, 2, a.v[i] << n)
+
+/* Shift right and insert: keeps the top n bits of a */
+#define NEON_SRI(name, type, lanes) \
+static inline type name(type a, type b, int n) \
+{ \
+	type r; \
+	uint32_t mask = 0xffffffffu >> n; \
+	int i; \
+	for (i = 0; i < lanes; i++) \
+		r.v[i] = (a.v[i] & ~mask) | (b.v[i] >> n); \
+	return r; \
+}
+
+NEON_SRI(vsriq_n_u32, uint32x4_t, 4)
+NEON_SRI(vsri_n_u32, uint32x2_t, 2)
+
+/* Lanes n..3 of a followed by lanes 0..n-1 of b */
+static inline uint32x4_t vextq_u32(uint32x4_t a, uint32x4_t b, int n)
+{
+	uint32x4_t r;
+	int i;
+	for (i = 0; i < 4; i++)
+		r.v[i] = (i + n < 4) ? a.v[i + n] : b.v[i + n - 4];
+	return r;
+}
+
+static inline uint32x2_t vget_low_u32(uint32x4_t a)
+{
+	uint32x2_t r = { { a.v[0], a.v[1] } };
+	return r;
+}
+
+static inline uint32x2_t vget_high_u32(uint32x4_t a)
+{
+	uint32x2_t r = { { a.v[2], a.v[3] } };
+	return r;
+}
+
+static inline uint32x4_t vcombine_u32(uint32x2_t lo, uint32x2_t hi)
+{
+	uint32x4_t r = { { lo.v[0], lo.v[1], hi.v[0], hi.v[1] } };
+	return r;
+}
+
+/* SHA256hash(X, Y, W, part1) */
+static inline void neon_sha256hash(uint32x4_t *x, uint32x4_t *y, uint32x4_t w)
+{
+	uint32_t X[4], Y[4], chs, maj, t, x3, y3;
+	int e;
+
+	memcpy(X, x->v, 16);
+	memcpy(Y, y->v, 16);
+	for (e = 0; e < 4; e++) {
+		chs = (Y[0] & Y[1]) ^ (~Y[0] & Y[2]);
+		maj = (X[0] & X[1]) ^ (X[0] & X[2]) ^ (X[1] & X[2]);
+		t = Y[3] + (neon_ror(Y[0], 6) ^ neon_ror(Y[0], 11) ^
+			    neon_ror(Y[0], 25)) + chs + w.v[e];
+		X[3] = t + X[3];
+		Y[3] = t + (neon_ror(X[0], 2) ^ neon_ror(X[0], 13) ^
+			    neon_ror(X[0], 22)) + maj;
+		/* <Y:X> = ROL(Y:X, 32) */
+		x3 = X[3];
+		y3 = Y[3];
+		X[3] = X[2]; X[2] = X[1]; X[1] = X[0]; X[0] = y3;
+		Y[3] = Y[2]; Y[2] = Y[1]; Y[1] = Y[0]; Y[0] = x3;
+	}
+	memcpy(x->v, X, 16);
+	memcpy(y->v, Y, 16);
+}
+
+/* SHA256H: returns the new ABCD */
+static inline uint32x4_t vsha256hq_u32(uint32x4_t abcd, uint32x4_t efgh,
+				       uint32x4_t wk)
+{
+	neon_sha256hash(&abcd, &efgh, wk);
+	return abcd;
+}
+
+/* SHA256H2: returns the new EFGH */
+static inline uint32x4_t vsha256h2q_u32(uint32x4_t efgh, uint32x4_t abcd,
+					uint32x4_t wk)
+{
+	neon_sha256hash(&abcd, &efgh, wk);
+	return efgh;
+}
+
+/* SHA256SU0: W[0..3] + sigma0(W[1..4]) */
+static inline uint32x4_t vsha256su0q_u32(uint32x4_t w0_3, uint32x4_t w4_7)
+{
+	uint32x4_t t = vextq_u32(w0_3, w4_7, 1);
+	uint32x4_t r;
+	int i;
+
+	for (i = 0; i < 4; i++)
+		r.v[i] = w0_3.v[i] + (neon_ror(t.v[i], 7) ^
+				      neon_ror(t.v[i], 18) ^ (t.v[i] >> 3));
+	return r;
+}
+
+/* SHA256SU1: adds W[9..12] and sigma1(W[14..17]) */
+static inline uint32x4_t vsha256su1q_u32(uint32x4_t tw0_3, uint32x4_t w8_11,
+					 uint32x4_t w12_15)
+{
+	uint32x4_t t0 = vextq_u32(w8_11, w12_15, 1);
+	uint32_t t1[2] = { w12_15.v[2], w12_15.v[3] };
+	uint32x4_t r;
+	int e;
+
+	for (e = 0; e < 2; e++)
+		r.v[e] = (neon_ror(t1[e], 17) ^ neon_ror(t1[e], 19) ^
+			  (t1[e] >> 10)) + tw0_3.v[e] + t0.v[e];
+	for (e = 0; e < 2; e++)
+		r.v[e + 2] = (neon_ror(r.v[e], 17) ^ neon_ror(r.v[e], 19) ^
+			      (r.v[e] >> 10)) + tw0_3.v[e + 2] + t0.v[e + 2];
+	return r;
+}
+
+/* GF(2^8) product with the AES polynomial */
+static inline uint8_t neon_gfmul(uint8_t a, uint8_t b)
+{
+	uint8_t r = 0;
+
+	while (b) {
+		if (b & 1)
+			r ^= a;
+		a = (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1b : 0));
+		b >>= 1;
+	}
+	return r;
+}
+
+/* The S-box from its definition, the inverse followed by the affine map */
+static inline uint8_t neon_sbox_calc(uint8_t x)
+{
+	uint8_t inv = 0, r;
+	int y, i;
+
+	for (y = 1; x && y < 256; y++)
+		if (neon_gfmul(x, (uint8_t)y) == 1)
+			inv = (uint8_t)y;
+	r = inv;
+	for (i = 1; i < 5; i++)
+		r ^= (uint8_t)((inv << i) | (inv >> (8 - i)));
+	return r ^ 0x63;
+}
+
+/* Forward (inv 0) or inverse (inv 1) S-box, computed on first use */
+static inline uint8_t neon_sbox_lookup(uint8_t x, int inv)
+{
+	static uint8_t box[2][256];
+	static int ready;
+	int y;
+
+	if (!ready) {
+		for (y = 0; y < 256; y++) {
+			box[0][y] = neon_sbox_calc((uint8_t)y);
+			box[1][box[0][y]] = (uint8_t)y;
+		}
+		ready = 1;
+	}
+	return box[inv][x];
+}
+
+#define neon_sbox(x)	neon_sbox_lookup((x), 0)
+#define neon_invsbox(x)	neon_sbox_lookup((x), 1)
+
+/* Byte 4*c+r is row r of column c */
+static inline uint8x16_t neon_mixcolumns(uint8x16_t a, const uint8_t m[4])
+{
+	uint8x16_t r;
+	int c, i, j;
+
+	for (c = 0; c < 4; c++)
+		for (i = 0; i < 4; i++) {
+			r.v[4*c+i] = 0;
+			for (j = 0; j < 4; j++)
+				r.v[4*c+i] ^= neon_gfmul(m[(j - i) & 3], a.v[4*c+j]);
+		}
+	return r;
+}
+
+/* AESE: AddRoundKey, ShiftRows and SubBytes */
+static inline uint8x16_t vaeseq_u8(uint8x16_t data, uint8x16_t key)
+{
+	uint8x16_t r;
+	int c, i;
+
+	for (c = 0; c < 4; c++)
+		for (i = 0; i < 4; i++)
+			r.v[4*c+i] = neon_sbox(data.v[4*((c+i)&3)+i] ^
+					       key.v[4*((c+i)&3)+i]);
+	return r;
+}
+
+/* AESD: AddRoundKey, InvShiftRows and InvSubBytes */
+static inline uint8x16_t vaesdq_u8(uint8x16_t data, uint8x16_t key)
+{
+	uint8x16_t r;
+	int c, i;
+
+	for (c = 0; c < 4; c++)
+		for (i = 0; i < 4; i++)
+			r.v[4*c+i] = neon_invsbox(data.v[4*((c-i)&3)+i] ^
+						  key.v[4*((c-i)&3)+i]);
+	return r;
+}
+
+static inline uint8x16_t vaesmcq_u8(uint8x16_t data)
+{
+	static const uint8_t m[4] = { 2, 3, 1, 1 };
+	return neon_mixcolumns(data, m);
+}
+
+static inline uint8x16_t vaesimcq_u8(uint8x16_t data)
+{
+	static const uint8_t m[4] = { 14, 11, 13, 9 };
+	return neon_mixcolumns(data, m);
+}
+
+#endif
@@ -0,0 +1,577 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file mpbench.c
+*		Host microbenchmark and known-answer tests of the bigdigits
+*		multiplication kernels and the Montgomery functions.
+*
+*		bigdigits.c is linked three times, see Makefile: with
+*		BIGD_KERNEL_SCHOOLBOOK as the reference (ref_ prefix), with
+*		BIGD_KERNEL_COMBA (c32_ prefix) and with the default kernel of
+*		the host (no prefix). The tests check
+*		- the signatures of the DCP test receiver certificates R1 and R2
+*		  against the test DCP LLC key, as XHdcp22Tx_RsaSignatureVerify()
+*		  does, with mpModExp() and with mpMontExp() of each kernel
+*		- mpMultiply() and mpSquare() of each kernel against the
+*		  reference for all sizes up to MAX_MONT_DIGITS
+*		- mpMontMult() and mpMontExp() of each kernel against the
+*		  reference mpMultiply(), mpDivide() and mpModExp()
+*		and then time the kernels at 1024, 2048 and 3072 bits.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xhdcp22_common.h"
+#include "bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define CERT_MSG_SIZE		138	/* Receiver ID, n, e and reserved */
+#define CERT_SIG_SIZE		384
+#define KPUB_DCP_N_SIZE		384
+#define DCP_DIGITS		(KPUB_DCP_N_SIZE / 4)
+
+#ifdef BIGD_KERNEL_LIMB64
+#define DEFAULT_KERNEL		"limb64"
+#elif defined(BIGD_KERNEL_COMBA)
+#define DEFAULT_KERNEL		"comba32"
+#else
+#define DEFAULT_KERNEL		"schoolbook"
+#endif
+
+/**************************** Type Definitions *******************************/
+
+/* One build of bigdigits.c */
+typedef struct {
+	const char *Name;
+	int (*Multiply)(u32 w[], const u32 u[], const u32 v[], size_t ndigits);
+	int (*Square)(u32 w[], const u32 x[], size_t ndigits);
+	int (*MontInit)(MP_MONT_CTX *ctx, const u32 m[], size_t ndigits);
+	int (*MontMult)(u32 a[], const u32 x[], const u32 y[],
+			const MP_MONT_CTX *ctx);
+	int (*MontToMont)(u32 a[], const u32 x[], const MP_MONT_CTX *ctx);
+	int (*MontFromMont)(u32 a[], const u32 x[], const MP_MONT_CTX *ctx);
+	int (*MontExp)(u32 y[], const u32 x[], const u32 e[],
+			const MP_MONT_CTX *ctx);
+} Kernel;
+
+/************************** Function Prototypes ******************************/
+
+/* The prefixed builds of bigdigits.c */
+#define DECLARE_BUILD(p) \
+int p##mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits); \
+int p##mpSquare(u32 w[], const u32 x[], size_t ndigits); \
+int p##mpDivide(u32 q[], u32 r[], const u32 u[], size_t udigits, \
+		u32 v[], size_t vdigits); \
+int p##mpModExp(u32 y[], const u32 x[], const u32 e[], u32 m[], \
+		size_t ndigits); \
+int p##mpMontInit(MP_MONT_CTX *ctx, const u32 m[], size_t ndigits); \
+int p##mpMontMult(u32 a[], const u32 x[], const u32 y[], \
+		const MP_MONT_CTX *ctx); \
+int p##mpMontToMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx); \
+int p##mpMontFromMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx); \
+int p##mpMontExp(u32 y[], const u32 x[], const u32 e[], \
+		const MP_MONT_CTX *ctx);
+
+DECLARE_BUILD(ref_)
+DECLARE_BUILD(c32_)
+
+#define KERNEL(name, p) { name, p##mpMultiply, p##mpSquare, p##mpMontInit, \
+	p##mpMontMult, p##mpMontToMont, p##mpMontFromMont, p##mpMontExp }
+
+/************************** Variable Definitions *****************************/
+
+static const Kernel Kernels[] = {
+	KERNEL("schoolbook", ref_),
+	KERNEL("comba32", c32_),
+	KERNEL(DEFAULT_KERNEL, ),
+};
+
+#define NUM_KERNELS	(sizeof(Kernels) / sizeof(Kernels[0]))
+
+/* DCP test vectors, see xhdcp22_tx_test.c */
+static const u8 TestKpubDcp[KPUB_DCP_N_SIZE + 1] =
+{
+	0xA2, 0xC7, 0x55, 0x57, 0x54, 0xCB, 0xAA, 0xA7, 0x7A, 0x27, 0x92, 0xC3, 0x1A, 0x6D, 0xC2, 0x31, 0xCF, 0x12,
+	0xC2, 0x24, 0xBF, 0x89, 0x72, 0x46, 0xA4, 0x8D, 0x20, 0x83, 0xB2, 0xDD, 0x04, 0xDA, 0x7E, 0x01, 0xA9, 0x19,
+	0xEF, 0x7E, 0x8C, 0x47, 0x54, 0xC8, 0x59, 0x72, 0x5C, 0x89, 0x60, 0x62, 0x9F, 0x39, 0xD0, 0xE4, 0x80, 0xCA,
+	0xA8, 0xD4, 0x1E, 0x91, 0xE3, 0x0E, 0x2C, 0x77, 0x55, 0x6D, 0x58, 0xA8, 0x9E, 0x3E, 0xF2, 0xDA, 0x78, 0x3E,
+	0xBA, 0xD1, 0x05, 0x37, 0x07, 0xF2, 0x88, 0x74, 0x0C, 0xBC, 0xFB, 0x68, 0xA4, 0x7A, 0x27, 0xAD, 0x63, 0xA5,
+	0x1F, 0x67, 0xF1, 0x45, 0x85, 0x16, 0x49, 0x8A, 0xE6, 0x34, 0x1C, 0x6E, 0x80, 0xF5, 0xFF, 0x13, 0x72, 0x85,
+	0x5D, 0xC1, 0xDE, 0x5F, 0x01, 0x86, 0x55, 0x86, 0x71, 0xE8, 0x10, 0x33, 0x14, 0x70, 0x2A, 0x5F, 0x15, 0x7B,
+	0x5C, 0x65, 0x3C, 0x46, 0x3A, 0x17, 0x79, 0xED, 0x54, 0x6A, 0xA6, 0xC9, 0xDF, 0xEB, 0x2A, 0x81, 0x2A, 0x80,
+	0x2A, 0x46, 0xA2, 0x06, 0xDB, 0xFD, 0xD5, 0xF3, 0xCF, 0x74, 0xBB, 0x66, 0x56, 0x48, 0xD7, 0x7C, 0x6A, 0x03,
+	0x14, 0x1E, 0x55, 0x56, 0xE4, 0xB6, 0xFA, 0x38, 0x2B, 0x5D, 0xFB, 0x87, 0x9F, 0x9E, 0x78, 0x21, 0x87, 0xC0,
+	0x0C, 0x63, 0x3E, 0x8D, 0x0F, 0xE2, 0xA7, 0x19, 0x10, 0x9B, 0x15, 0xE1, 0x11, 0x87, 0x49, 0x33, 0x49, 0xB8,
+	0x66, 0x32, 0x28, 0x7C, 0x87, 0xF5, 0xD2, 0x2E, 0xC5, 0xF3, 0x66, 0x2F, 0x79, 0xEF, 0x40, 0x5A, 0xD4, 0x14,
+	0x85, 0x74, 0x5F, 0x06, 0x43, 0x50, 0xCD, 0xDE, 0x84, 0xE7, 0x3C, 0x7D, 0x8E, 0x8A, 0x49, 0xCC, 0x5A, 0xCF,
+	0x73, 0xA1, 0x8A, 0x13, 0xFF, 0x37, 0x13, 0x3D, 0xAD, 0x57, 0xD8, 0x51, 0x22, 0xD6, 0x32, 0x1F, 0xC0, 0x68,
+	0x4C, 0xA0, 0x5B, 0xDD, 0x5F, 0x78, 0xC8, 0x9F, 0x2D, 0x3A, 0xA2, 0xB8, 0x1E, 0x4A, 0xE4, 0x08, 0x55, 0x64,
+	0x05, 0xE6, 0x94, 0xFB, 0xEB, 0x03, 0x6A, 0x0A, 0xBE, 0x83, 0x18, 0x94, 0xD4, 0xB6, 0xC3, 0xF2, 0x58, 0x9C,
+	0x7A, 0x24, 0xDD, 0xD1, 0x3A, 0xB7, 0x3A, 0xB0, 0xBB, 0xE5, 0xD1, 0x28, 0xAB, 0xAD, 0x24, 0x54, 0x72, 0x0E,
+	0x76, 0xD2, 0x89, 0x32, 0xEA, 0x46, 0xD3, 0x78, 0xD0, 0xA9, 0x67, 0x78, 0xC1, 0x2D, 0x18, 0xB0, 0x33, 0xDE,
+	0xDB, 0x27, 0xCC, 0xB0, 0x7C, 0xC9, 0xA4, 0xBD, 0xDF, 0x2B, 0x64, 0x10, 0x32, 0x44, 0x06, 0x81, 0x21, 0xB3,
+	0xBA, 0xCF, 0x33, 0x85, 0x49, 0x1E, 0x86, 0x4C, 0xBD, 0xF2, 0x3D, 0x34, 0xEF, 0xD6, 0x23, 0x7A, 0x9F, 0x2C,
+	0xDA, 0x84, 0xF0, 0x83, 0x83, 0x71, 0x7D, 0xDA, 0x6E, 0x44, 0x96, 0xCD, 0x1D, 0x05, 0xDE, 0x30, 0xF6, 0x1E,
+	0x2F, 0x9C, 0x99, 0x9C, 0x60, 0x07, 0x03
+};
+
+static const u8 TestCertRx[2][CERT_MSG_SIZE + CERT_SIG_SIZE] =
+{{ // R1
+	0x74, 0x5b, 0xb8, 0xbd, 0x04, 0xaf, 0xb5, 0xc5, 0xc6, 0x7b, 0xc5, 0x3a, 0x34, 0x90, 0xa9,
+	0x54, 0xc0, 0x8f, 0xb7, 0xeb, 0xa1, 0x54, 0xd2, 0x4f, 0x22, 0xde, 0x83, 0xf5, 0x03, 0xa6,
+	0xc6, 0x68, 0x46, 0x9b, 0xc0, 0xb8, 0xc8, 0x6c, 0xdb, 0x26, 0xf9, 0x3c, 0x49, 0x2f, 0x02,
+	0xe1, 0x71, 0xdf, 0x4e, 0xf3, 0x0e, 0xc8, 0xbf, 0x22, 0x9d, 0x04, 0xcf, 0xbf, 0xa9, 0x0d,
+	0xff, 0x68, 0xab, 0x05, 0x6f, 0x1f, 0x12, 0x8a, 0x68, 0x62, 0xeb, 0xfe, 0xc9, 0xea, 0x9f,
+	0xa7, 0xfb, 0x8c, 0xba, 0xb1, 0xbd, 0x65, 0xac, 0x35, 0x9c, 0xa0, 0x33, 0xb1, 0xdd, 0xa6,
+	0x05, 0x36, 0xaf, 0x00, 0xa2, 0x7f, 0xbc, 0x07, 0xb2, 0xdd, 0xb5, 0xcc, 0x57, 0x5c, 0xdc,
+	0xc0, 0x95, 0x50, 0xe5, 0xff, 0x1f, 0x20, 0xdb, 0x59, 0x46, 0xfa, 0x47, 0xc4, 0xed, 0x12,
+	0x2e, 0x9e, 0x22, 0xbd, 0x95, 0xa9, 0x85, 0x59, 0xa1, 0x59, 0x3c, 0xc7, 0x83, 0x01, 0x00,
+	0x01, 0x10, 0x00, 0x0b, 0xa3, 0x73, 0x77, 0xdd, 0x03, 0x18, 0x03, 0x8a, 0x91, 0x63, 0x29,
+	0x1e, 0xa2, 0x95, 0x74, 0x42, 0x90, 0x78, 0xd0, 0x67, 0x25, 0xb6, 0x32, 0x2f, 0xcc, 0x23,
+	0x2b, 0xad, 0x21, 0x39, 0x3d, 0x14, 0xba, 0x37, 0xa3, 0x65, 0x14, 0x6b, 0x9c, 0xcf, 0x61,
+	0x20, 0x44, 0xa1, 0x07, 0xbb, 0xcf, 0xc3, 0x4e, 0x95, 0x5b, 0x10, 0xcf, 0xc7, 0x6f, 0xf1,
+	0xc3, 0x53, 0x7c, 0x63, 0xa1, 0x8c, 0xb2, 0xe8, 0xab, 0x2e, 0x96, 0x97, 0xc3, 0x83, 0x99,
+	0x70, 0xd3, 0xdc, 0x21, 0x41, 0xf6, 0x0a, 0xd1, 0x1a, 0xee, 0xf4, 0xcc, 0xeb, 0xfb, 0xa6,
+	0xaa, 0xb6, 0x9a, 0xaf, 0x1d, 0x16, 0x5e, 0xe2, 0x83, 0xa0, 0x4a, 0x41, 0xf6, 0x7b, 0x07,
+	0xbf, 0x47, 0x85, 0x28, 0x6c, 0xa0, 0x77, 0xa6, 0xa3, 0xd7, 0x85, 0xa5, 0xc4, 0xa7, 0xe7,
+	0x6e, 0xb5, 0x1f, 0x40, 0x72, 0x97, 0xfe, 0xc4, 0x81, 0x23, 0xa0, 0xc2, 0x90, 0xb3, 0x49,
+	0x24, 0xf5, 0xb7, 0x90, 0x2c, 0xbf, 0xfe, 0x04, 0x2e, 0x00, 0xa9, 0x5f, 0x86, 0x04, 0xca,
+	0xc5, 0x3a, 0xcc, 0x26, 0xd9, 0x39, 0x7e, 0xa9, 0x2d, 0x28, 0x6d, 0xc0, 0xcc, 0x6e, 0x81,
+	0x9f, 0xb9, 0xb7, 0x11, 0x33, 0x32, 0x23, 0x47, 0x98, 0x43, 0x0d, 0xa5, 0x1c, 0x59, 0xf3,
+	0xcd, 0xd2, 0x4a, 0xb7, 0x3e, 0x69, 0xd9, 0x21, 0x53, 0x9a, 0xf2, 0x6e, 0x77, 0x62, 0xae,
+	0x50, 0xda, 0x85, 0xc6, 0xaa, 0xc4, 0xb5, 0x1c, 0xcd, 0xa8, 0xa5, 0xdd, 0x6e, 0x62, 0x73,
+	0xff, 0x5f, 0x7b, 0xd7, 0x3c, 0x17, 0xba, 0x47, 0x0c, 0x89, 0x0e, 0x62, 0x79, 0x43, 0x94,
+	0xaa, 0xa8, 0x47, 0xf4, 0x4c, 0x38, 0x89, 0xa8, 0x81, 0xad, 0x23, 0x13, 0x27, 0x0c, 0x17,
+	0xcf, 0x3d, 0x83, 0x84, 0x57, 0x36, 0xe7, 0x22, 0x26, 0x2e, 0x76, 0xfd, 0x56, 0x80, 0x83,
+	0xf6, 0x70, 0xd4, 0x5c, 0x91, 0x48, 0x84, 0x7b, 0x18, 0xdb, 0x0e, 0x15, 0x3b, 0x49, 0x26,
+	0x23, 0xe6, 0xa3, 0xe2, 0xc6, 0x3a, 0x23, 0x57, 0x66, 0xb0, 0x72, 0xb8, 0x12, 0x17, 0x4f,
+	0x86, 0xfe, 0x48, 0x0d, 0x53, 0xea, 0xfe, 0x31, 0x48, 0x7d, 0x86, 0xde, 0xeb, 0x82, 0x86,
+	0x1e, 0x62, 0x03, 0x98, 0x59, 0x00, 0x37, 0xeb, 0x61, 0xe9, 0xf9, 0x7a, 0x40, 0x78, 0x1c,
+	0xba, 0xbc, 0x0b, 0x88, 0xfb, 0xfd, 0x9d, 0xd5, 0x01, 0x11, 0x94, 0xe0, 0x35, 0xbe, 0x33,
+	0xe8, 0xe5, 0x36, 0xfb, 0x9c, 0x45, 0xcb, 0x75, 0xaf, 0xd6, 0x35, 0xff, 0x78, 0x92, 0x7f,
+	0xa1, 0x7c, 0xa8, 0xfc, 0xb7, 0xf7, 0xa8, 0x52, 0xa9, 0xc6, 0x84, 0x72, 0x3d, 0x1c, 0xc9,
+	0xdf, 0x35, 0xc6, 0xe6, 0x00, 0xe1, 0x48, 0x72, 0xce, 0x83, 0x1b, 0xcc, 0xf8, 0x33, 0x2d,
+	0x4f, 0x98, 0x75, 0x00, 0x3c, 0x41, 0xdf, 0x7a, 0xed, 0x38, 0x53, 0xb1
+ },
+ { // R2
+	0x8B, 0xA4, 0x47, 0x42, 0xFB, 0xE4, 0x68, 0x63, 0x8A, 0xDA, 0x97, 0x2D, 0xDE, 0x9A, 0x8D,
+	0x1C, 0xB1, 0x65, 0x4B, 0x85, 0x8D, 0xE5, 0x46, 0xD6, 0xDB, 0x95, 0xA5, 0xF6, 0x66, 0x74,
+	0xEA, 0x81, 0x0B, 0x9A, 0x58, 0x58, 0x66, 0x26, 0x86, 0xA6, 0xB4, 0x56, 0x2B, 0x29, 0x43,
+	0xE5, 0xBB, 0x81, 0x74, 0x86, 0xA7, 0xB7, 0x16, 0x2F, 0x07, 0xEC, 0xD1, 0xB5, 0xF9, 0xAE,
+	0x4F, 0x98, 0x89, 0xA9, 0x91, 0x7D, 0x58, 0x5B, 0x8D, 0x20, 0xD5, 0xC5, 0x08, 0x40, 0x3B,
+	0x86, 0xAF, 0xF4, 0xD6, 0xB9, 0x20, 0x95, 0xE8, 0x90, 0x3B, 0x8F, 0x9F, 0x36, 0x5B, 0x46,
+	0xB6, 0xD4, 0x1E, 0xF5, 0x05, 0x88, 0x80, 0x14, 0xE7, 0x2C, 0x77, 0x5D, 0x6E, 0x54, 0xE9,
+	0x65, 0x81, 0x5A, 0x68, 0x92, 0xA5, 0xD6, 0x40, 0x78, 0x11, 0x97, 0x65, 0xD7, 0x64, 0x36,
+	0x5E, 0x8D, 0x2A, 0x87, 0xA8, 0xEB, 0x7D, 0x06, 0x2C, 0x10, 0xF8, 0x0A, 0x7D, 0x01, 0x00,
+	0x01, 0x10, 0x00, 0x06, 0x40, 0x99, 0x8F, 0x5A, 0x54, 0x71, 0x23, 0xA7, 0x6A, 0x64, 0x3F,
+	0xBD, 0xDD, 0x52, 0xB2, 0x79, 0x6F, 0x88, 0x26, 0x94, 0x9E, 0xAF, 0xA4, 0xDE, 0x7D, 0x8D,
+	0x88, 0x10, 0xC8, 0xF6, 0x56, 0xF0, 0x8F, 0x46, 0x28, 0x48, 0x55, 0x51, 0xC5, 0xAF, 0xA1,
+	0xA9, 0x9D, 0xAC, 0x9F, 0xB1, 0x26, 0x4B, 0xEB, 0x39, 0xAD, 0x88, 0x46, 0xAF, 0xBC, 0x61,
+	0xA8, 0x7B, 0xF9, 0x7B, 0x3E, 0xE4, 0x95, 0xD9, 0xA8, 0x79, 0x48, 0x51, 0x00, 0xBE, 0xA4,
+	0xB6, 0x96, 0x7F, 0x3D, 0xFD, 0x76, 0xA6, 0xB7, 0xBB, 0xB9, 0x77, 0xDC, 0x54, 0xFB, 0x52,
+	0x9C, 0x79, 0x8F, 0xED, 0xD4, 0xB1, 0xBC, 0x0F, 0x7E, 0xB1, 0x7E, 0x70, 0x6D, 0xFC, 0xB9,
+	0x7E, 0x66, 0x9A, 0x86, 0x23, 0x3A, 0x98, 0x5E, 0x32, 0x8D, 0x75, 0x18, 0x54, 0x64, 0x36,
+	0xDD, 0x92, 0x01, 0x39, 0x90, 0xB9, 0xE3, 0xAF, 0x6F, 0x98, 0xA5, 0xC0, 0x80, 0xC6, 0x2F,
+	0xA1, 0x02, 0xAD, 0x8D, 0xF4, 0xD6, 0x66, 0x7B, 0x45, 0xE5, 0x74, 0x18, 0xB1, 0x27, 0x24,
+	0x01, 0x1E, 0xEA, 0xD8, 0xF3, 0x79, 0x92, 0xE9, 0x03, 0xF5, 0x57, 0x8D, 0x65, 0x2A, 0x8D,
+	0x1B, 0xF0, 0xDA, 0x58, 0x3F, 0x58, 0xA0, 0xF4, 0xB4, 0xBE, 0xCB, 0x21, 0x66, 0xE9, 0x21,
+	0x7C, 0x76, 0xF3, 0xC1, 0x7E, 0x2E, 0x7C, 0x3D, 0x61, 0x20, 0x1D, 0xC5, 0xC0, 0x71, 0x28,
+	0x2E, 0xB7, 0x0F, 0x1F, 0x7A, 0xC1, 0xD3, 0x6A, 0x1E, 0xA3, 0x54, 0x34, 0x8E, 0x0D, 0xD7,
+	0x96, 0x93, 0x78, 0x50, 0xC1, 0xEE, 0x27, 0x72, 0x3A, 0xBD, 0x57, 0x22, 0xF0, 0xD7, 0x6D,
+	0x9D, 0x65, 0xC4, 0x07, 0x9C, 0x82, 0xA6, 0xD4, 0xF7, 0x6B, 0x9A, 0xE9, 0xC0, 0x6C, 0x4A,
+	0x4F, 0x6F, 0xBE, 0x8E, 0x01, 0x37, 0x50, 0x3A, 0x66, 0xD9, 0xE9, 0xD9, 0xF9, 0x06, 0x9E,
+	0x00, 0xA9, 0x84, 0xA0, 0x18, 0xB3, 0x44, 0x21, 0x24, 0xA3, 0x6C, 0xCD, 0xB7, 0x0F, 0x31,
+	0x2A, 0xE8, 0x15, 0xB6, 0x93, 0x6F, 0xB9, 0x86, 0xE5, 0x28, 0x01, 0x1A, 0x5E, 0x10, 0x3F,
+	0x1F, 0x4D, 0x35, 0xA2, 0x8D, 0xB8, 0x54, 0x26, 0x68, 0x3A, 0xCD, 0xCB, 0x5F, 0xFA, 0x37,
+	0x4A, 0x60, 0x10, 0xB1, 0x0A, 0xFE, 0xBA, 0x9B, 0x96, 0x5D, 0x7E, 0x99, 0xCF, 0x01, 0x98,
+	0x65, 0x87, 0xAD, 0x40, 0xD5, 0x82, 0x1D, 0x61, 0x54, 0xA2, 0xD3, 0x16, 0x3E, 0xF7, 0xE3,
+	0x05, 0x89, 0x8D, 0x8A, 0x50, 0x87, 0x47, 0xBE, 0x29, 0x18, 0x01, 0xB7, 0xC3, 0xDD, 0x43,
+	0x23, 0x7A, 0xCD, 0x85, 0x1D, 0x4E, 0xA9, 0xC0, 0x1A, 0xA4, 0x77, 0xAB, 0xE7, 0x31, 0x9A,
+	0x33, 0x1B, 0x7A, 0x86, 0xE1, 0xE5, 0xCA, 0x0C, 0x43, 0x1A, 0xFA, 0xEC, 0x4C, 0x05, 0xC6,
+	0xD1, 0x43, 0x12, 0xF9, 0x4D, 0x3E, 0xF7, 0xD6, 0x05, 0x9C, 0x1C, 0xDD
+}};
+
+/* DigestInfo prefix of SHA-256 in the encoded message EM */
+static const u8 Sha256Identifier[] = {
+	0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+	0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20
+};
+
+static u32 RandState = 0x2545F491;
+
+/*****************************************************************************/
+/*
+* bigdigits prints with xil_printf
+*/
+void xil_printf(const char8 *ctrl1, ...)
+{
+}
+
+/*****************************************************************************/
+/*
+* xorshift32, the tests are repeatable
+*/
+static u32 rand32(void)
+{
+	RandState ^= RandState << 13;
+	RandState ^= RandState >> 17;
+	RandState ^= RandState << 5;
+	return RandState;
+}
+
+static void rand_digits(u32 *a, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		a[i] = rand32();
+	}
+}
+
+/* Random odd modulus of n digits with the top bit set */
+static void rand_modulus(u32 *m, size_t n)
+{
+	rand_digits(m, n);
+	m[n - 1] |= HIBITMASK;
+	m[0] |= 1;
+}
+
+/*****************************************************************************/
+/*
+* Checks EM = 0x00 || 0x01 || PS || 0x00 || T of a certificate signature,
+* see XHdcp22Tx_RsaSignatureVerify()
+*/
+static int check_em(const u8 *Em, const u8 *Cert)
+{
+	u8 Hash[32];
+	int i;
+
+	XHdcp22Cmn_Sha256Hash(Cert, CERT_MSG_SIZE, Hash);
+
+	if (Em[0] != 0x00 || Em[1] != 0x01) {
+		return 0;
+	}
+	for (i = 2; i < 332; i++) {
+		if (Em[i] != 0xFF) {
+			return 0;
+		}
+	}
+	return Em[332] == 0x00 &&
+		memcmp(&Em[333], Sha256Identifier, sizeof(Sha256Identifier)) == 0 &&
+		memcmp(&Em[352], Hash, sizeof(Hash)) == 0;
+}
+
+static void test_certificates(void)
+{
+	u32 n[DCP_DIGITS], e[DCP_DIGITS], s[DCP_DIGITS], y[DCP_DIGITS];
+	MP_MONT_CTX Ctx;
+	u8 Em[CERT_SIG_SIZE];
+	char Name[64];
+	size_t k;
+	int Rx;
+
+	mpConvFromOctets(e, DCP_DIGITS, &TestKpubDcp[KPUB_DCP_N_SIZE], 1);
+
+	for (Rx = 0; Rx < 2; Rx++) {
+		mpConvFromOctets(s, DCP_DIGITS, &TestCertRx[Rx][CERT_MSG_SIZE],
+				CERT_SIG_SIZE);
+
+		mpConvFromOctets(n, DCP_DIGITS, TestKpubDcp, KPUB_DCP_N_SIZE);
+		ref_mpModExp(y, s, e, n, DCP_DIGITS);
+		mpConvToOctets(y, DCP_DIGITS, Em, sizeof(Em));
+		snprintf(Name, sizeof(Name), "R%d certificate, mpModExp", Rx + 1);
+		check(Name, check_em(Em, TestCertRx[Rx]));
+
+		for (k = 0; k < NUM_KERNELS; k++) {
+			Kernels[k].MontInit(&Ctx, n, DCP_DIGITS);
+			Kernels[k].MontExp(y, s, e, &Ctx);
+			mpConvToOctets(y, DCP_DIGITS, Em, sizeof(Em));
+			snprintf(Name, sizeof(Name), "R%d certificate, mpMontExp %s",
+					Rx + 1, Kernels[k].Name);
+			check(Name, check_em(Em, TestCertRx[Rx]));
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+* mpMultiply and mpSquare of each kernel against the reference, random
+* operands and all ones for the longest carry chains
+*/
+static void test_multiply(void)
+{
+	u32 u[MAX_MONT_DIGITS], v[MAX_MONT_DIGITS];
+	u32 w[2 * MAX_MONT_DIGITS], r[2 * MAX_MONT_DIGITS];
+	char Name[64];
+	size_t k, n;
+	int i, Ok;
+
+	for (k = 0; k < NUM_KERNELS; k++) {
+		Ok = 1;
+		for (n = 1; n <= MAX_MONT_DIGITS; n++) {
+			for (i = 0; i < 5; i++) {
+				if (i == 0) {
+					memset(u, 0xFF, n * sizeof(u32));
+					memset(v, 0xFF, n * sizeof(u32));
+				} else {
+					rand_digits(u, n);
+					rand_digits(v, n);
+				}
+				if (i == 4) {
+					u[n / 2] = 0;
+				}
+				ref_mpMultiply(r, u, v, n);
+				Kernels[k].Multiply(w, u, v, n);
+				Ok &= memcmp(w, r, 2 * n * sizeof(u32)) == 0;
+				ref_mpSquare(r, u, n);
+				Kernels[k].Square(w, u, n);
+				Ok &= memcmp(w, r, 2 * n * sizeof(u32)) == 0;
+			}
+		}
+		snprintf(Name, sizeof(Name), "mpMultiply/mpSquare %s", Kernels[k].Name);
+		check(Name, Ok);
+	}
+}
+
+/*****************************************************************************/
+/*
+* mpMontMult and mpMontExp of each kernel against the reference
+*/
+static void test_montgomery(void)
+{
+	static const size_t Sizes[] = { 1, 2, 3, 17, 32, 33, 64, 96, 128 };
+	u32 m[MAX_MONT_DIGITS], x[MAX_MONT_DIGITS], y[MAX_MONT_DIGITS];
+	u32 e[MAX_MONT_DIGITS], a[MAX_MONT_DIGITS], b[MAX_MONT_DIGITS];
+	u32 xy[MAX_MONT_DIGITS], xe[MAX_MONT_DIGITS];
+	u32 t[2 * MAX_MONT_DIGITS], q[2 * MAX_MONT_DIGITS], r[2 * MAX_MONT_DIGITS];
+	MP_MONT_CTX Ctx;
+	int Ok[NUM_KERNELS];
+	char Name[64];
+	size_t k, s, n;
+	int i;
+
+	for (k = 0; k < NUM_KERNELS; k++) {
+		Ok[k] = 1;
+	}
+
+	for (s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++) {
+		n = Sizes[s];
+		for (i = 0; i < 6; i++) {
+			if (i == 0) {
+				memset(m, 0xFF, n * sizeof(u32));
+			} else {
+				rand_modulus(m, n);
+			}
+			if (i == 5) {
+				/* x = m - 1, also an even modulus to be refused */
+				mpSetEqual(x, m, n);
+				x[0] ^= 1;
+			} else {
+				rand_digits(x, n);
+				x[n - 1] &= m[n - 1] >> 1;
+			}
+			rand_digits(y, n);
+			y[n - 1] &= m[n - 1] >> 1;
+
+			/* e = 3, 65537, 0 and random */
+			mpSetZero(e, n);
+			if (i == 1) {
+				e[0] = 3;
+			} else if (i == 2) {
+				e[0] = 65537;
+			} else if (i != 3) {
+				rand_digits(e, n);
+			}
+
+			/* References x * y mod m and x^e mod m */
+			ref_mpMultiply(t, x, y, n);
+			ref_mpDivide(q, r, t, 2 * n, m, n);
+			mpSetEqual(xy, r, n);
+			ref_mpModExp(xe, x, e, m, n);
+
+			for (k = 0; k < NUM_KERNELS; k++) {
+				if (i == 5) {
+					Ok[k] &= Kernels[k].MontInit(&Ctx, x, n) != 0;
+				}
+				Ok[k] &= Kernels[k].MontInit(&Ctx, m, n) == 0;
+
+				Kernels[k].MontToMont(a, x, &Ctx);
+				Kernels[k].MontToMont(b, y, &Ctx);
+				Kernels[k].MontMult(a, a, b, &Ctx);
+				Kernels[k].MontFromMont(a, a, &Ctx);
+				Ok[k] &= mpEqual(a, xy, n);
+
+				Kernels[k].MontExp(a, x, e, &Ctx);
+				Ok[k] &= mpEqual(a, xe, n);
+			}
+		}
+	}
+
+	for (k = 0; k < NUM_KERNELS; k++) {
+		snprintf(Name, sizeof(Name), "mpMontMult/mpMontExp %s",
+				Kernels[k].Name);
+		check(Name, Ok[k]);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Times per operation at the HDCP modulus sizes. "e=3" is the signature
+* verification of XHdcp22Tx_RsaSignatureVerify() including mpMontInit.
+*/
+static void bench(int Count)
+{
+	static const size_t Sizes[] = { 32, 64, 96 };
+	u32 m[MAX_MONT_DIGITS], x[MAX_MONT_DIGITS], y[MAX_MONT_DIGITS];
+	u32 e[MAX_MONT_DIGITS], e3[MAX_MONT_DIGITS];
+	u32 w[2 * MAX_MONT_DIGITS];
+	MP_MONT_CTX Ctx;
+	double Start, Mul, Sqr, MontMul, Exp3, ExpFull;
+	int Full = Count / 100 > 0 ? Count / 100 : 1;
+	size_t k, s, n;
+	int i;
+
+	printf("\n%-5s %-11s %9s %9s %9s %11s %11s\n", "bits", "kernel",
+			"mult ns", "sqr ns", "mont ns", "e=3 us", "e=full ms");
+
+	for (s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++) {
+		n = Sizes[s];
+		rand_modulus(m, n);
+		rand_digits(x, n);
+		x[n - 1] &= m[n - 1] >> 1;
+		rand_digits(y, n);
+		y[n - 1] &= m[n - 1] >> 1;
+		rand_digits(e, n);
+		mpSetDigit(e3, 3, n);
+
+		/* mpModExp with the schoolbook kernel is the code before the change */
+		Start = now_ns();
+		for (i = 0; i < Count; i++) {
+			ref_mpModExp(w, x, e3, m, n);
+		}
+		Exp3 = (now_ns() - Start) / Count;
+		Start = now_ns();
+		for (i = 0; i < Full; i++) {
+			ref_mpModExp(w, x, e, m, n);
+		}
+		ExpFull = (now_ns() - Start) / Full;
+		printf("%-5zu %-11s %9s %9s %9s %11.1f %11.2f\n", n * 32,
+				"mpModExp", "", "", "", Exp3 / 1e3, ExpFull / 1e6);
+
+		for (k = 0; k < NUM_KERNELS; k++) {
+			Start = now_ns();
+			for (i = 0; i < Count * 10; i++) {
+				Kernels[k].Multiply(w, x, y, n);
+			}
+			Mul = (now_ns() - Start) / (Count * 10);
+
+			Start = now_ns();
+			for (i = 0; i < Count * 10; i++) {
+				Kernels[k].Square(w, x, n);
+			}
+			Sqr = (now_ns() - Start) / (Count * 10);
+
+			Kernels[k].MontInit(&Ctx, m, n);
+			Start = now_ns();
+			for (i = 0; i < Count * 10; i++) {
+				Kernels[k].MontMult(w, x, y, &Ctx);
+			}
+			MontMul = (now_ns() - Start) / (Count * 10);
+
+			Start = now_ns();
+			for (i = 0; i < Count; i++) {
+				Kernels[k].MontInit(&Ctx, m, n);
+				Kernels[k].MontExp(w, x, e3, &Ctx);
+			}
+			Exp3 = (now_ns() - Start) / Count;
+
+			Start = now_ns();
+			for (i = 0; i < Full; i++) {
+				Kernels[k].MontExp(w, x, e, &Ctx);
+			}
+			ExpFull = (now_ns() - Start) / Full;
+
+			printf("%-5zu %-11s %9.0f %9.0f %9.0f %11.1f %11.2f\n", n * 32,
+					Kernels[k].Name, Mul, Sqr, MontMul, Exp3 / 1e3,
+					ExpFull / 1e6);
+		}
+	}
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n count]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Count = 200;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Count = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Count <= 0) {
+		usage(argv[0]);
+	}
+
+	test_certificates();
+	test_multiply();
+	test_montgomery();
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	bench(Count);
+
+	return 0;
+}
@@ -0,0 +1,419 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file shabench.c
+*		Host microbenchmark and known-answer tests of the SHA256 and
+*		HMAC-SHA256 functions.
+*
+*		sha2.c is linked three times, see Makefile: with the block
+*		compression of the host (portable C, no prefix), with the NEON
+*		schedule (neon_ prefix) and with the ARMv8 Crypto Extension
+*		instructions (ce_ prefix). The last two run on the arm_neon.h
+*		emulation of this directory. The tests check
+*		- the FIPS 180-2 SHA256 examples with each build
+*		- streaming with random split points and source alignment
+*		  against the one-shot hash of the host build
+*		- the RFC 4231 HMAC-SHA256 test cases, with
+*		  XHdcp22Cmn_HmacSha256Hash and with a key context that is
+*		  used more than once
+*		and then time the host build.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.00  agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xstatus.h"
+#include "xhdcp22_common.h"
+#include "bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define MAX_STREAM_SIZE		1000	/* Largest message of the stream test */
+
+/**************************** Type Definitions *******************************/
+
+/* One build of sha2.c */
+typedef struct {
+	const char *Name;
+	void (*Hash)(const u8 *Data, u32 DataSize, u8 *HashedData);
+	void (*Init)(XHdcp22Cmn_Sha256Ctx *Ctx);
+	void (*Update)(XHdcp22Cmn_Sha256Ctx *Ctx, const u8 *Data, u32 DataSize);
+	void (*Final)(XHdcp22Cmn_Sha256Ctx *Ctx, u8 *HashedData);
+} Build;
+
+/* FIPS 180-2 example */
+typedef struct {
+	const char *Name;
+	const char *Message;
+	u32 Repeat;
+	const char *Hash;
+} ShaVector;
+
+/* RFC 4231 test case */
+typedef struct {
+	const char *Name;
+	u8 KeyByte;		/* Key is KeySize times KeyByte ... */
+	const char *Key;	/* ... unless given here */
+	int KeySize;
+	u8 DataByte;		/* Data is DataSize times DataByte ... */
+	const char *Data;	/* ... unless given here */
+	int DataSize;
+	const char *Mac;	/* Truncated for test case 5 */
+} HmacVector;
+
+/************************** Function Prototypes ******************************/
+
+/* The prefixed builds of sha2.c */
+#define DECLARE_BUILD(p) \
+void p##XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData); \
+void p##XHdcp22Cmn_Sha256Init(XHdcp22Cmn_Sha256Ctx *Ctx); \
+void p##XHdcp22Cmn_Sha256Update(XHdcp22Cmn_Sha256Ctx *Ctx, const u8 *Data, \
+		u32 DataSize); \
+void p##XHdcp22Cmn_Sha256Final(XHdcp22Cmn_Sha256Ctx *Ctx, u8 *HashedData);
+
+DECLARE_BUILD(neon_)
+DECLARE_BUILD(ce_)
+
+#define BUILD(name, p) { name, p##XHdcp22Cmn_Sha256Hash, \
+	p##XHdcp22Cmn_Sha256Init, p##XHdcp22Cmn_Sha256Update, \
+	p##XHdcp22Cmn_Sha256Final }
+
+/************************** Variable Definitions *****************************/
+
+static const Build Builds[] = {
+	BUILD("host", ),
+	BUILD("neon", neon_),
+	BUILD("armv8ce", ce_),
+};
+
+#define NUM_BUILDS	(sizeof(Builds) / sizeof(Builds[0]))
+
+static const ShaVector ShaVectors[] = {
+	{ "empty", "", 1,
+	  "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+	{ "abc", "abc", 1,
+	  "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+	{ "448 bits",
+	  "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1,
+	  "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+	{ "896 bits",
+	  "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	  "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1,
+	  "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1" },
+	{ "million a", "a", 1000000,
+	  "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+};
+
+static const HmacVector HmacVectors[] = {
+	{ "RFC 4231 case 1", 0x0b, NULL, 20, 0, "Hi There", 8,
+	  "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7" },
+	{ "RFC 4231 case 2", 0, "Jefe", 4, 0, "what do ya want for nothing?", 28,
+	  "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843" },
+	{ "RFC 4231 case 3", 0xaa, NULL, 20, 0xdd, NULL, 50,
+	  "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe" },
+	{ "RFC 4231 case 4", 0, "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a"
+	  "\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19", 25,
+	  0xcd, NULL, 50,
+	  "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b" },
+	{ "RFC 4231 case 5", 0x0c, NULL, 20, 0, "Test With Truncation", 20,
+	  "a3b6167473100ee06e0c796c2955552b" },
+	{ "RFC 4231 case 6", 0xaa, NULL, 131, 0,
+	  "Test Using Larger Than Block-Size Key - Hash Key First", 54,
+	  "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54" },
+	{ "RFC 4231 case 7", 0xaa, NULL, 131, 0,
+	  "This is a test using a larger than block-size key and a larger "
+	  "than block-size data. The key needs to be hashed before being "
+	  "used by the HMAC algorithm.", 152,
+	  "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2" },
+};
+
+static u32 RandState = 0x2545F491;
+
+/*****************************************************************************/
+/*
+* xorshift32, the tests are repeatable
+*/
+static u32 rand32(void)
+{
+	RandState ^= RandState << 13;
+	RandState ^= RandState >> 17;
+	RandState ^= RandState << 5;
+	return RandState;
+}
+
+/* Compares Size bytes of Hash with a hex string */
+static int match_hex(const u8 *Hash, const char *Hex)
+{
+	char Str[2 * XHDCP22_CMN_SHA256_HASH_SIZE + 1];
+	size_t i;
+
+	for (i = 0; i < strlen(Hex) / 2; i++) {
+		sprintf(&Str[2 * i], "%02x", Hash[i]);
+	}
+	return memcmp(Str, Hex, strlen(Hex)) == 0;
+}
+
+/*****************************************************************************/
+/*
+* FIPS 180-2 examples. The million a are streamed in pieces of 1000 bytes.
+*/
+static void test_vectors(void)
+{
+	static u8 Buffer[1000];
+	XHdcp22Cmn_Sha256Ctx Ctx;
+	u8 Hash[XHDCP22_CMN_SHA256_HASH_SIZE];
+	char Name[64];
+	size_t b, v;
+	u32 i;
+
+	memset(Buffer, 'a', sizeof(Buffer));
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		for (v = 0; v < sizeof(ShaVectors) / sizeof(ShaVectors[0]); v++) {
+			if (ShaVectors[v].Repeat == 1) {
+				Builds[b].Hash((const u8 *)ShaVectors[v].Message,
+					strlen(ShaVectors[v].Message), Hash);
+			} else {
+				Builds[b].Init(&Ctx);
+				for (i = 0; i < ShaVectors[v].Repeat; i += sizeof(Buffer)) {
+					Builds[b].Update(&Ctx, Buffer, sizeof(Buffer));
+				}
+				Builds[b].Final(&Ctx, Hash);
+			}
+			snprintf(Name, sizeof(Name), "%s sha256 %s", Builds[b].Name,
+					ShaVectors[v].Name);
+			check(Name, match_hex(Hash, ShaVectors[v].Hash));
+		}
+	}
+}
+
+/*****************************************************************************/
+/*
+* Streams random messages of 0 to MAX_STREAM_SIZE bytes from a random source
+* alignment in pieces of random size and compares the hash with the one-shot
+* hash of the host build.
+*/
+static void test_stream(void)
+{
+	static u8 Message[MAX_STREAM_SIZE + 8];
+	XHdcp22Cmn_Sha256Ctx Ctx;
+	u8 Hash[XHDCP22_CMN_SHA256_HASH_SIZE];
+	u8 Expected[XHDCP22_CMN_SHA256_HASH_SIZE];
+	char Name[64];
+	u32 Size, Offset, Done, Piece;
+	size_t b, i;
+	int Ok;
+
+	for (i = 0; i < sizeof(Message); i++) {
+		Message[i] = (u8)rand32();
+	}
+
+	for (b = 0; b < NUM_BUILDS; b++) {
+		Ok = 1;
+		for (Size = 0; Size <= MAX_STREAM_SIZE; Size++) {
+			Offset = rand32() & 7;
+			XHdcp22Cmn_Sha256Hash(Message + Offset, Size, Expected);
+
+			Builds[b].Hash(Message + Offset, Size, Hash);
+			Ok &= memcmp(Hash, Expected, sizeof(Hash)) == 0;
+
+			Builds[b].Init(&Ctx);
+			for (Done = 0; Done < Size; Done += Piece) {
+				Piece = rand32() % 150;
+				if (Piece > Size - Done) {
+					Piece = Size - Done;
+				}
+				Builds[b].Update(&Ctx, Message + Offset + Done, Piece);
+			}
+			Builds[b].Final(&Ctx, Hash);
+			Ok &= memcmp(Hash, Expected, sizeof(Hash)) == 0;
+		}
+		snprintf(Name, sizeof(Name), "%s sha256 stream 0..%d bytes",
+				Builds[b].Name, MAX_STREAM_SIZE);
+		check(Name, Ok);
+	}
+}
+
+/*****************************************************************************/
+/*
+* RFC 4231 test cases, the key context is used twice
+*/
+static void test_hmac(void)
+{
+	XHdcp22Cmn_HmacSha256Ctx HmacCtx;
+	u8 Key[131], Data[152];
+	const u8 *KeyPtr, *DataPtr;
+	u8 Mac[XHDCP22_CMN_SHA256_HASH_SIZE];
+	char Name[64];
+	size_t v;
+	int Ok, Result;
+
+	for (v = 0; v < sizeof(HmacVectors) / sizeof(HmacVectors[0]); v++) {
+		memset(Key, HmacVectors[v].KeyByte, sizeof(Key));
+		memset(Data, HmacVectors[v].DataByte, sizeof(Data));
+		KeyPtr = HmacVectors[v].Key ? (const u8 *)HmacVectors[v].Key : Key;
+		DataPtr = HmacVectors[v].Data ? (const u8 *)HmacVectors[v].Data : Data;
+
+		Result = XHdcp22Cmn_HmacSha256Hash(DataPtr, HmacVectors[v].DataSize,
+				KeyPtr, HmacVectors[v].KeySize, Mac);
+		snprintf(Name, sizeof(Name), "hmac %s", HmacVectors[v].Name);
+		check(Name, Result == XST_SUCCESS && match_hex(Mac, HmacVectors[v].Mac));
+
+		XHdcp22Cmn_HmacSha256SetKey(&HmacCtx, KeyPtr, HmacVectors[v].KeySize);
+		XHdcp22Cmn_HmacSha256Mac(&HmacCtx, DataPtr, HmacVectors[v].DataSize, Mac);
+		Ok = match_hex(Mac, HmacVectors[v].Mac);
+		memset(Mac, 0, sizeof(Mac));
+		XHdcp22Cmn_HmacSha256Mac(&HmacCtx, DataPtr, HmacVectors[v].DataSize, Mac);
+		Ok &= match_hex(Mac, HmacVectors[v].Mac);
+		snprintf(Name, sizeof(Name), "hmac %s, key context", HmacVectors[v].Name);
+		check(Name, Ok);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Times the host build. MHz converts ns to cycles on hosts without a time
+* stamp counter, 0 leaves the cycles out.
+*/
+static void bench(int Count, double Mhz)
+{
+	static const u32 Sizes[] = { 64, 256, 1024, 16384 };
+	/* Message sizes of L', H' and V with 31 receiver IDs */
+	static const struct { const char *Name; int Size; } Macs[] = {
+		{ "L' (8 bytes)", 8 }, { "H' (14 bytes)", 14 },
+		{ "V (160 bytes)", 160 },
+	};
+	static u8 Message[16384];
+	u8 Hash[XHDCP22_CMN_SHA256_HASH_SIZE];
+	u8 Key[XHDCP22_CMN_SHA256_HASH_SIZE];
+	XHdcp22Cmn_HmacSha256Ctx HmacCtx;
+	double Start, Ns, NsKeyed;
+	u64 Cycles;
+	int Loops, i;
+	size_t s;
+
+	for (i = 0; i < (int)sizeof(Message); i++) {
+		Message[i] = (u8)rand32();
+	}
+	memcpy(Key, Message, sizeof(Key));
+
+	/* Warm up the caches and the clock frequency */
+	for (i = 0; i < Count * 100; i++) {
+		XHdcp22Cmn_Sha256Hash(Message, 64, Hash);
+	}
+
+	printf("\n%-8s %9s %9s %9s %9s\n", "bytes", "ns", "ns/byte",
+			"cyc/byte", "MB/s");
+	for (s = 0; s < sizeof(Sizes) / sizeof(Sizes[0]); s++) {
+		Loops = (int)(Count * (16384 / Sizes[s]));
+		Start = now_ns();
+		Cycles = now_cycles();
+		for (i = 0; i < Loops; i++) {
+			XHdcp22Cmn_Sha256Hash(Message, Sizes[s], Hash);
+		}
+		Ns = (now_ns() - Start) / Loops;
+		Cycles = bench_cycles(now_cycles() - Cycles, Ns * Loops, Mhz);
+		printf("%-8u %9.0f %9.2f %9.2f %9.1f\n", Sizes[s], Ns,
+				Ns / Sizes[s], (double)Cycles / Loops / Sizes[s],
+				Sizes[s] * 1e3 / Ns);
+	}
+
+	printf("\n%-14s %14s %14s\n", "hmac-sha256", "ns with key", "ns keyed");
+	Loops = Count * 100;
+	for (s = 0; s < sizeof(Macs) / sizeof(Macs[0]); s++) {
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			XHdcp22Cmn_HmacSha256Hash(Message, Macs[s].Size, Key,
+					sizeof(Key), Hash);
+		}
+		Ns = (now_ns() - Start) / Loops;
+
+		XHdcp22Cmn_HmacSha256SetKey(&HmacCtx, Key, sizeof(Key));
+		Start = now_ns();
+		for (i = 0; i < Loops; i++) {
+			XHdcp22Cmn_HmacSha256Mac(&HmacCtx, Message, Macs[s].Size, Hash);
+		}
+		NsKeyed = (now_ns() - Start) / Loops;
+		printf("%-14s %14.0f %14.0f\n", Macs[s].Name, Ns, NsKeyed);
+	}
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n count] [-m MHz]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Count = 200;
+	double Mhz = 0;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:m:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Count = atoi(optarg);
+			break;
+		case 'm':
+			Mhz = atof(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Count <= 0) {
+		usage(argv[0]);
+	}
+
+	test_vectors();
+	test_stream();
+	test_hmac();
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	bench(Count, Mhz);
+
+	return 0;
+}
@@ -29,16 +29,32 @@
 /**
 * @file aes.c
 *
-* This code is the implementation of the AES algorithm and
-* the CTR, CBC, and CCM modes of operation it can be used in.
+* This code is the implementation of the AES-128 block cipher and the CTR
+* mode of operation used for the HDCP 2.2 key derivation.
 * AES is, specified by the NIST in in publication FIPS PUB 197,
 * availible at:
 * - http://csrc.nist.gov/publications/fips/fips197/fips-197.pdf .
-* The CBC and CTR modes of operation are specified by
+* The CTR mode of operation is specified by
 * NIST SP 800-38 A, available at:
 * - http://csrc.nist.gov/publications/nistpubs/800-38a/sp800-38a.pdf .
-* The CCM mode of operation is specified by NIST SP80-38 C, available at:
-* - http://csrc.nist.gov/publications/nistpubs/800-38C/SP800-38C_updated-July20_2007.pdf
+*
+* A key is expanded once with XHdcp22Cmn_Aes128SetKey and can then encrypt
+* any number of blocks. XHdcp22Cmn_Aes128DeriveKeys produces the HDCP 2.2
+* derived keys dkey0, dkey1, ... in one call.
+*
+* The cipher is selected at build time:
+* - ARMv8 Cryptography Extensions (AESE and AESMC) if the compiler targets
+*   them, e.g. -march=armv8-a+crypto for the Cortex-A53. Four blocks are
+*   interleaved to hide the instruction latency.
+* - Otherwise word-oriented C with one 1 KB T-table per direction, rotated
+*   for the other rows, which keeps the data cache footprint small on the
+*   Cortex-R5 and MicroBlaze.
+* - With XHDCP22_CMN_AES_CONSTANT_TIME the C code uses no table lookups at
+*   all. The S-box is computed as the GF(2^8) inverse on four bytes at a
+*   time, so the timing does not depend on the key or the data. It is
+*   two orders of magnitude slower than the T-tables, which matters little
+*   for the few blocks of an HDCP authentication.
+* Define XHDCP22_CMN_AES_GENERIC to force the C code on ARMv8.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -47,253 +63,241 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00  MH   10/30/15 First Release
 * 1.01  MH   01/28/17 Fixed warnings and errors.
+* 2.00  agt  10/17/26 Replaced the byte-oriented cipher with T-table,
+*                     constant time and ARMv8 Crypto Extension
+*                     implementations. Added key contexts and CTR mode.
 *</pre>
 *
 *****************************************************************************/
 
 /***************************** Include Files *********************************/
 #include "string.h"
-#include "stdlib.h"
 #include "xil_types.h"
+#include "xhdcp22_common.h"
 
 /************************** Constant Definitions *****************************/
-/* This is the specified AES SBox. To look up a substitution value, put the first
-   nibble in the first index (row) and the second nibble in the second index (column). */
-static const u8 Aes_Sbox[16][16] = {
-	{0x63,0x7C,0x77,0x7B,0xF2,0x6B,0x6F,0xC5,0x30,0x01,0x67,0x2B,0xFE,0xD7,0xAB,0x76},
-	{0xCA,0x82,0xC9,0x7D,0xFA,0x59,0x47,0xF0,0xAD,0xD4,0xA2,0xAF,0x9C,0xA4,0x72,0xC0},
-	{0xB7,0xFD,0x93,0x26,0x36,0x3F,0xF7,0xCC,0x34,0xA5,0xE5,0xF1,0x71,0xD8,0x31,0x15},
-	{0x04,0xC7,0x23,0xC3,0x18,0x96,0x05,0x9A,0x07,0x12,0x80,0xE2,0xEB,0x27,0xB2,0x75},
-	{0x09,0x83,0x2C,0x1A,0x1B,0x6E,0x5A,0xA0,0x52,0x3B,0xD6,0xB3,0x29,0xE3,0x2F,0x84},
-	{0x53,0xD1,0x00,0xED,0x20,0xFC,0xB1,0x5B,0x6A,0xCB,0xBE,0x39,0x4A,0x4C,0x58,0xCF},
-	{0xD0,0xEF,0xAA,0xFB,0x43,0x4D,0x33,0x85,0x45,0xF9,0x02,0x7F,0x50,0x3C,0x9F,0xA8},
-	{0x51,0xA3,0x40,0x8F,0x92,0x9D,0x38,0xF5,0xBC,0xB6,0xDA,0x21,0x10,0xFF,0xF3,0xD2},
-	{0xCD,0x0C,0x13,0xEC,0x5F,0x97,0x44,0x17,0xC4,0xA7,0x7E,0x3D,0x64,0x5D,0x19,0x73},
-	{0x60,0x81,0x4F,0xDC,0x22,0x2A,0x90,0x88,0x46,0xEE,0xB8,0x14,0xDE,0x5E,0x0B,0xDB},
-	{0xE0,0x32,0x3A,0x0A,0x49,0x06,0x24,0x5C,0xC2,0xD3,0xAC,0x62,0x91,0x95,0xE4,0x79},
-	{0xE7,0xC8,0x37,0x6D,0x8D,0xD5,0x4E,0xA9,0x6C,0x56,0xF4,0xEA,0x65,0x7A,0xAE,0x08},
-	{0xBA,0x78,0x25,0x2E,0x1C,0xA6,0xB4,0xC6,0xE8,0xDD,0x74,0x1F,0x4B,0xBD,0x8B,0x8A},
-	{0x70,0x3E,0xB5,0x66,0x48,0x03,0xF6,0x0E,0x61,0x35,0x57,0xB9,0x86,0xC1,0x1D,0x9E},
-	{0xE1,0xF8,0x98,0x11,0x69,0xD9,0x8E,0x94,0x9B,0x1E,0x87,0xE9,0xCE,0x55,0x28,0xDF},
-	{0x8C,0xA1,0x89,0x0D,0xBF,0xE6,0x42,0x68,0x41,0x99,0x2D,0x0F,0xB0,0x54,0xBB,0x16}
-};
+#if defined(XHDCP22_CMN_AES_GENERIC)
+#define AES_CORE_GENERIC
+#elif (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)) && \
+      !defined(__ARM_BIG_ENDIAN)
+#define AES_CORE_ARMV8CE
+#else
+#define AES_CORE_GENERIC
+#endif
 
-static const u8 Aes_Invsbox[16][16] = {
-	{0x52,0x09,0x6A,0xD5,0x30,0x36,0xA5,0x38,0xBF,0x40,0xA3,0x9E,0x81,0xF3,0xD7,0xFB},
-	{0x7C,0xE3,0x39,0x82,0x9B,0x2F,0xFF,0x87,0x34,0x8E,0x43,0x44,0xC4,0xDE,0xE9,0xCB},
-	{0x54,0x7B,0x94,0x32,0xA6,0xC2,0x23,0x3D,0xEE,0x4C,0x95,0x0B,0x42,0xFA,0xC3,0x4E},
-	{0x08,0x2E,0xA1,0x66,0x28,0xD9,0x24,0xB2,0x76,0x5B,0xA2,0x49,0x6D,0x8B,0xD1,0x25},
-	{0x72,0xF8,0xF6,0x64,0x86,0x68,0x98,0x16,0xD4,0xA4,0x5C,0xCC,0x5D,0x65,0xB6,0x92},
-	{0x6C,0x70,0x48,0x50,0xFD,0xED,0xB9,0xDA,0x5E,0x15,0x46,0x57,0xA7,0x8D,0x9D,0x84},
-	{0x90,0xD8,0xAB,0x00,0x8C,0xBC,0xD3,0x0A,0xF7,0xE4,0x58,0x05,0xB8,0xB3,0x45,0x06},
-	{0xD0,0x2C,0x1E,0x8F,0xCA,0x3F,0x0F,0x02,0xC1,0xAF,0xBD,0x03,0x01,0x13,0x8A,0x6B},
-	{0x3A,0x91,0x11,0x41,0x4F,0x67,0xDC,0xEA,0x97,0xF2,0xCF,0xCE,0xF0,0xB4,0xE6,0x73},
-	{0x96,0xAC,0x74,0x22,0xE7,0xAD,0x35,0x85,0xE2,0xF9,0x37,0xE8,0x1C,0x75,0xDF,0x6E},
-	{0x47,0xF1,0x1A,0x71,0x1D,0x29,0xC5,0x89,0x6F,0xB7,0x62,0x0E,0xAA,0x18,0xBE,0x1B},
-	{0xFC,0x56,0x3E,0x4B,0xC6,0xD2,0x79,0x20,0x9A,0xDB,0xC0,0xFE,0x78,0xCD,0x5A,0xF4},
-	{0x1F,0xDD,0xA8,0x33,0x88,0x07,0xC7,0x31,0xB1,0x12,0x10,0x59,0x27,0x80,0xEC,0x5F},
-	{0x60,0x51,0x7F,0xA9,0x19,0xB5,0x4A,0x0D,0x2D,0xE5,0x7A,0x9F,0x93,0xC9,0x9C,0xEF},
-	{0xA0,0xE0,0x3B,0x4D,0xAE,0x2A,0xF5,0xB0,0xC8,0xEB,0xBB,0x3C,0x83,0x53,0x99,0x61},
-	{0x17,0x2B,0x04,0x7E,0xBA,0x77,0xD6,0x26,0xE1,0x69,0x14,0x63,0x55,0x21,0x0C,0x7D}
-};
+#ifdef AES_CORE_ARMV8CE
+#include <arm_neon.h>
+#endif
 
-/* This table stores pre-calculated values for all possible GF(2^8) calculations.This
-   table is only used by the (Inv)MixColumns steps.
-   USAGE: The second index (column) is the coefficient of multiplication. Only 7 different
-   coefficients are used: 0x01, 0x02, 0x03, 0x09, 0x0b, 0x0d, 0x0e, but multiplication by
-   1 is negligible leaving only 6 coefficients. Each column of the table is devoted to one
-   of these coefficients, in the ascending order of value, from values 0x00 to 0xFF. */
-static const u8 Aes_GfMul[256][6] = {
-	{0x00,0x00,0x00,0x00,0x00,0x00},{0x02,0x03,0x09,0x0b,0x0d,0x0e},
-	{0x04,0x06,0x12,0x16,0x1a,0x1c},{0x06,0x05,0x1b,0x1d,0x17,0x12},
-	{0x08,0x0c,0x24,0x2c,0x34,0x38},{0x0a,0x0f,0x2d,0x27,0x39,0x36},
-	{0x0c,0x0a,0x36,0x3a,0x2e,0x24},{0x0e,0x09,0x3f,0x31,0x23,0x2a},
-	{0x10,0x18,0x48,0x58,0x68,0x70},{0x12,0x1b,0x41,0x53,0x65,0x7e},
-	{0x14,0x1e,0x5a,0x4e,0x72,0x6c},{0x16,0x1d,0x53,0x45,0x7f,0x62},
-	{0x18,0x14,0x6c,0x74,0x5c,0x48},{0x1a,0x17,0x65,0x7f,0x51,0x46},
-	{0x1c,0x12,0x7e,0x62,0x46,0x54},{0x1e,0x11,0x77,0x69,0x4b,0x5a},
-	{0x20,0x30,0x90,0xb0,0xd0,0xe0},{0x22,0x33,0x99,0xbb,0xdd,0xee},
-	{0x24,0x36,0x82,0xa6,0xca,0xfc},{0x26,0x35,0x8b,0xad,0xc7,0xf2},
-	{0x28,0x3c,0xb4,0x9c,0xe4,0xd8},{0x2a,0x3f,0xbd,0x97,0xe9,0xd6},
-	{0x2c,0x3a,0xa6,0x8a,0xfe,0xc4},{0x2e,0x39,0xaf,0x81,0xf3,0xca},
-	{0x30,0x28,0xd8,0xe8,0xb8,0x90},{0x32,0x2b,0xd1,0xe3,0xb5,0x9e},
-	{0x34,0x2e,0xca,0xfe,0xa2,0x8c},{0x36,0x2d,0xc3,0xf5,0xaf,0x82},
-	{0x38,0x24,0xfc,0xc4,0x8c,0xa8},{0x3a,0x27,0xf5,0xcf,0x81,0xa6},
-	{0x3c,0x22,0xee,0xd2,0x96,0xb4},{0x3e,0x21,0xe7,0xd9,0x9b,0xba},
-	{0x40,0x60,0x3b,0x7b,0xbb,0xdb},{0x42,0x63,0x32,0x70,0xb6,0xd5},
-	{0x44,0x66,0x29,0x6d,0xa1,0xc7},{0x46,0x65,0x20,0x66,0xac,0xc9},
-	{0x48,0x6c,0x1f,0x57,0x8f,0xe3},{0x4a,0x6f,0x16,0x5c,0x82,0xed},
-	{0x4c,0x6a,0x0d,0x41,0x95,0xff},{0x4e,0x69,0x04,0x4a,0x98,0xf1},
-	{0x50,0x78,0x73,0x23,0xd3,0xab},{0x52,0x7b,0x7a,0x28,0xde,0xa5},
-	{0x54,0x7e,0x61,0x35,0xc9,0xb7},{0x56,0x7d,0x68,0x3e,0xc4,0xb9},
-	{0x58,0x74,0x57,0x0f,0xe7,0x93},{0x5a,0x77,0x5e,0x04,0xea,0x9d},
-	{0x5c,0x72,0x45,0x19,0xfd,0x8f},{0x5e,0x71,0x4c,0x12,0xf0,0x81},
-	{0x60,0x50,0xab,0xcb,0x6b,0x3b},{0x62,0x53,0xa2,0xc0,0x66,0x35},
-	{0x64,0x56,0xb9,0xdd,0x71,0x27},{0x66,0x55,0xb0,0xd6,0x7c,0x29},
-	{0x68,0x5c,0x8f,0xe7,0x5f,0x03},{0x6a,0x5f,0x86,0xec,0x52,0x0d},
-	{0x6c,0x5a,0x9d,0xf1,0x45,0x1f},{0x6e,0x59,0x94,0xfa,0x48,0x11},
-	{0x70,0x48,0xe3,0x93,0x03,0x4b},{0x72,0x4b,0xea,0x98,0x0e,0x45},
-	{0x74,0x4e,0xf1,0x85,0x19,0x57},{0x76,0x4d,0xf8,0x8e,0x14,0x59},
-	{0x78,0x44,0xc7,0xbf,0x37,0x73},{0x7a,0x47,0xce,0xb4,0x3a,0x7d},
-	{0x7c,0x42,0xd5,0xa9,0x2d,0x6f},{0x7e,0x41,0xdc,0xa2,0x20,0x61},
-	{0x80,0xc0,0x76,0xf6,0x6d,0xad},{0x82,0xc3,0x7f,0xfd,0x60,0xa3},
-	{0x84,0xc6,0x64,0xe0,0x77,0xb1},{0x86,0xc5,0x6d,0xeb,0x7a,0xbf},
-	{0x88,0xcc,0x52,0xda,0x59,0x95},{0x8a,0xcf,0x5b,0xd1,0x54,0x9b},
-	{0x8c,0xca,0x40,0xcc,0x43,0x89},{0x8e,0xc9,0x49,0xc7,0x4e,0x87},
-	{0x90,0xd8,0x3e,0xae,0x05,0xdd},{0x92,0xdb,0x37,0xa5,0x08,0xd3},
-	{0x94,0xde,0x2c,0xb8,0x1f,0xc1},{0x96,0xdd,0x25,0xb3,0x12,0xcf},
-	{0x98,0xd4,0x1a,0x82,0x31,0xe5},{0x9a,0xd7,0x13,0x89,0x3c,0xeb},
-	{0x9c,0xd2,0x08,0x94,0x2b,0xf9},{0x9e,0xd1,0x01,0x9f,0x26,0xf7},
-	{0xa0,0xf0,0xe6,0x46,0xbd,0x4d},{0xa2,0xf3,0xef,0x4d,0xb0,0x43},
-	{0xa4,0xf6,0xf4,0x50,0xa7,0x51},{0xa6,0xf5,0xfd,0x5b,0xaa,0x5f},
-	{0xa8,0xfc,0xc2,0x6a,0x89,0x75},{0xaa,0xff,0xcb,0x61,0x84,0x7b},
-	{0xac,0xfa,0xd0,0x7c,0x93,0x69},{0xae,0xf9,0xd9,0x77,0x9e,0x67},
-	{0xb0,0xe8,0xae,0x1e,0xd5,0x3d},{0xb2,0xeb,0xa7,0x15,0xd8,0x33},
-	{0xb4,0xee,0xbc,0x08,0xcf,0x21},{0xb6,0xed,0xb5,0x03,0xc2,0x2f},
-	{0xb8,0xe4,0x8a,0x32,0xe1,0x05},{0xba,0xe7,0x83,0x39,0xec,0x0b},
-	{0xbc,0xe2,0x98,0x24,0xfb,0x19},{0xbe,0xe1,0x91,0x2f,0xf6,0x17},
-	{0xc0,0xa0,0x4d,0x8d,0xd6,0x76},{0xc2,0xa3,0x44,0x86,0xdb,0x78},
-	{0xc4,0xa6,0x5f,0x9b,0xcc,0x6a},{0xc6,0xa5,0x56,0x90,0xc1,0x64},
-	{0xc8,0xac,0x69,0xa1,0xe2,0x4e},{0xca,0xaf,0x60,0xaa,0xef,0x40},
-	{0xcc,0xaa,0x7b,0xb7,0xf8,0x52},{0xce,0xa9,0x72,0xbc,0xf5,0x5c},
-	{0xd0,0xb8,0x05,0xd5,0xbe,0x06},{0xd2,0xbb,0x0c,0xde,0xb3,0x08},
-	{0xd4,0xbe,0x17,0xc3,0xa4,0x1a},{0xd6,0xbd,0x1e,0xc8,0xa9,0x14},
-	{0xd8,0xb4,0x21,0xf9,0x8a,0x3e},{0xda,0xb7,0x28,0xf2,0x87,0x30},
-	{0xdc,0xb2,0x33,0xef,0x90,0x22},{0xde,0xb1,0x3a,0xe4,0x9d,0x2c},
-	{0xe0,0x90,0xdd,0x3d,0x06,0x96},{0xe2,0x93,0xd4,0x36,0x0b,0x98},
-	{0xe4,0x96,0xcf,0x2b,0x1c,0x8a},{0xe6,0x95,0xc6,0x20,0x11,0x84},
-	{0xe8,0x9c,0xf9,0x11,0x32,0xae},{0xea,0x9f,0xf0,0x1a,0x3f,0xa0},
-	{0xec,0x9a,0xeb,0x07,0x28,0xb2},{0xee,0x99,0xe2,0x0c,0x25,0xbc},
-	{0xf0,0x88,0x95,0x65,0x6e,0xe6},{0xf2,0x8b,0x9c,0x6e,0x63,0xe8},
-	{0xf4,0x8e,0x87,0x73,0x74,0xfa},{0xf6,0x8d,0x8e,0x78,0x79,0xf4},
-	{0xf8,0x84,0xb1,0x49,0x5a,0xde},{0xfa,0x87,0xb8,0x42,0x57,0xd0},
-	{0xfc,0x82,0xa3,0x5f,0x40,0xc2},{0xfe,0x81,0xaa,0x54,0x4d,0xcc},
-	{0x1b,0x9b,0xec,0xf7,0xda,0x41},{0x19,0x98,0xe5,0xfc,0xd7,0x4f},
-	{0x1f,0x9d,0xfe,0xe1,0xc0,0x5d},{0x1d,0x9e,0xf7,0xea,0xcd,0x53},
-	{0x13,0x97,0xc8,0xdb,0xee,0x79},{0x11,0x94,0xc1,0xd0,0xe3,0x77},
-	{0x17,0x91,0xda,0xcd,0xf4,0x65},{0x15,0x92,0xd3,0xc6,0xf9,0x6b},
-	{0x0b,0x83,0xa4,0xaf,0xb2,0x31},{0x09,0x80,0xad,0xa4,0xbf,0x3f},
-	{0x0f,0x85,0xb6,0xb9,0xa8,0x2d},{0x0d,0x86,0xbf,0xb2,0xa5,0x23},
-	{0x03,0x8f,0x80,0x83,0x86,0x09},{0x01,0x8c,0x89,0x88,0x8b,0x07},
-	{0x07,0x89,0x92,0x95,0x9c,0x15},{0x05,0x8a,0x9b,0x9e,0x91,0x1b},
-	{0x3b,0xab,0x7c,0x47,0x0a,0xa1},{0x39,0xa8,0x75,0x4c,0x07,0xaf},
-	{0x3f,0xad,0x6e,0x51,0x10,0xbd},{0x3d,0xae,0x67,0x5a,0x1d,0xb3},
-	{0x33,0xa7,0x58,0x6b,0x3e,0x99},{0x31,0xa4,0x51,0x60,0x33,0x97},
-	{0x37,0xa1,0x4a,0x7d,0x24,0x85},{0x35,0xa2,0x43,0x76,0x29,0x8b},
-	{0x2b,0xb3,0x34,0x1f,0x62,0xd1},{0x29,0xb0,0x3d,0x14,0x6f,0xdf},
-	{0x2f,0xb5,0x26,0x09,0x78,0xcd},{0x2d,0xb6,0x2f,0x02,0x75,0xc3},
-	{0x23,0xbf,0x10,0x33,0x56,0xe9},{0x21,0xbc,0x19,0x38,0x5b,0xe7},
-	{0x27,0xb9,0x02,0x25,0x4c,0xf5},{0x25,0xba,0x0b,0x2e,0x41,0xfb},
-	{0x5b,0xfb,0xd7,0x8c,0x61,0x9a},{0x59,0xf8,0xde,0x87,0x6c,0x94},
-	{0x5f,0xfd,0xc5,0x9a,0x7b,0x86},{0x5d,0xfe,0xcc,0x91,0x76,0x88},
-	{0x53,0xf7,0xf3,0xa0,0x55,0xa2},{0x51,0xf4,0xfa,0xab,0x58,0xac},
-	{0x57,0xf1,0xe1,0xb6,0x4f,0xbe},{0x55,0xf2,0xe8,0xbd,0x42,0xb0},
-	{0x4b,0xe3,0x9f,0xd4,0x09,0xea},{0x49,0xe0,0x96,0xdf,0x04,0xe4},
-	{0x4f,0xe5,0x8d,0xc2,0x13,0xf6},{0x4d,0xe6,0x84,0xc9,0x1e,0xf8},
-	{0x43,0xef,0xbb,0xf8,0x3d,0xd2},{0x41,0xec,0xb2,0xf3,0x30,0xdc},
-	{0x47,0xe9,0xa9,0xee,0x27,0xce},{0x45,0xea,0xa0,0xe5,0x2a,0xc0},
-	{0x7b,0xcb,0x47,0x3c,0xb1,0x7a},{0x79,0xc8,0x4e,0x37,0xbc,0x74},
-	{0x7f,0xcd,0x55,0x2a,0xab,0x66},{0x7d,0xce,0x5c,0x21,0xa6,0x68},
-	{0x73,0xc7,0x63,0x10,0x85,0x42},{0x71,0xc4,0x6a,0x1b,0x88,0x4c},
-	{0x77,0xc1,0x71,0x06,0x9f,0x5e},{0x75,0xc2,0x78,0x0d,0x92,0x50},
-	{0x6b,0xd3,0x0f,0x64,0xd9,0x0a},{0x69,0xd0,0x06,0x6f,0xd4,0x04},
-	{0x6f,0xd5,0x1d,0x72,0xc3,0x16},{0x6d,0xd6,0x14,0x79,0xce,0x18},
-	{0x63,0xdf,0x2b,0x48,0xed,0x32},{0x61,0xdc,0x22,0x43,0xe0,0x3c},
-	{0x67,0xd9,0x39,0x5e,0xf7,0x2e},{0x65,0xda,0x30,0x55,0xfa,0x20},
-	{0x9b,0x5b,0x9a,0x01,0xb7,0xec},{0x99,0x58,0x93,0x0a,0xba,0xe2},
-	{0x9f,0x5d,0x88,0x17,0xad,0xf0},{0x9d,0x5e,0x81,0x1c,0xa0,0xfe},
-	{0x93,0x57,0xbe,0x2d,0x83,0xd4},{0x91,0x54,0xb7,0x26,0x8e,0xda},
-	{0x97,0x51,0xac,0x3b,0x99,0xc8},{0x95,0x52,0xa5,0x30,0x94,0xc6},
-	{0x8b,0x43,0xd2,0x59,0xdf,0x9c},{0x89,0x40,0xdb,0x52,0xd2,0x92},
-	{0x8f,0x45,0xc0,0x4f,0xc5,0x80},{0x8d,0x46,0xc9,0x44,0xc8,0x8e},
-	{0x83,0x4f,0xf6,0x75,0xeb,0xa4},{0x81,0x4c,0xff,0x7e,0xe6,0xaa},
-	{0x87,0x49,0xe4,0x63,0xf1,0xb8},{0x85,0x4a,0xed,0x68,0xfc,0xb6},
-	{0xbb,0x6b,0x0a,0xb1,0x67,0x0c},{0xb9,0x68,0x03,0xba,0x6a,0x02},
-	{0xbf,0x6d,0x18,0xa7,0x7d,0x10},{0xbd,0x6e,0x11,0xac,0x70,0x1e},
-	{0xb3,0x67,0x2e,0x9d,0x53,0x34},{0xb1,0x64,0x27,0x96,0x5e,0x3a},
-	{0xb7,0x61,0x3c,0x8b,0x49,0x28},{0xb5,0x62,0x35,0x80,0x44,0x26},
-	{0xab,0x73,0x42,0xe9,0x0f,0x7c},{0xa9,0x70,0x4b,0xe2,0x02,0x72},
-	{0xaf,0x75,0x50,0xff,0x15,0x60},{0xad,0x76,0x59,0xf4,0x18,0x6e},
-	{0xa3,0x7f,0x66,0xc5,0x3b,0x44},{0xa1,0x7c,0x6f,0xce,0x36,0x4a},
-	{0xa7,0x79,0x74,0xd3,0x21,0x58},{0xa5,0x7a,0x7d,0xd8,0x2c,0x56},
-	{0xdb,0x3b,0xa1,0x7a,0x0c,0x37},{0xd9,0x38,0xa8,0x71,0x01,0x39},
-	{0xdf,0x3d,0xb3,0x6c,0x16,0x2b},{0xdd,0x3e,0xba,0x67,0x1b,0x25},
-	{0xd3,0x37,0x85,0x56,0x38,0x0f},{0xd1,0x34,0x8c,0x5d,0x35,0x01},
-	{0xd7,0x31,0x97,0x40,0x22,0x13},{0xd5,0x32,0x9e,0x4b,0x2f,0x1d},
-	{0xcb,0x23,0xe9,0x22,0x64,0x47},{0xc9,0x20,0xe0,0x29,0x69,0x49},
-	{0xcf,0x25,0xfb,0x34,0x7e,0x5b},{0xcd,0x26,0xf2,0x3f,0x73,0x55},
-	{0xc3,0x2f,0xcd,0x0e,0x50,0x7f},{0xc1,0x2c,0xc4,0x05,0x5d,0x71},
-	{0xc7,0x29,0xdf,0x18,0x4a,0x63},{0xc5,0x2a,0xd6,0x13,0x47,0x6d},
-	{0xfb,0x0b,0x31,0xca,0xdc,0xd7},{0xf9,0x08,0x38,0xc1,0xd1,0xd9},
-	{0xff,0x0d,0x23,0xdc,0xc6,0xcb},{0xfd,0x0e,0x2a,0xd7,0xcb,0xc5},
-	{0xf3,0x07,0x15,0xe6,0xe8,0xef},{0xf1,0x04,0x1c,0xed,0xe5,0xe1},
-	{0xf7,0x01,0x07,0xf0,0xf2,0xf3},{0xf5,0x02,0x0e,0xfb,0xff,0xfd},
-	{0xeb,0x13,0x79,0x92,0xb4,0xa7},{0xe9,0x10,0x70,0x99,0xb9,0xa9},
-	{0xef,0x15,0x6b,0x84,0xae,0xbb},{0xed,0x16,0x62,0x8f,0xa3,0xb5},
-	{0xe3,0x1f,0x5d,0xbe,0x80,0x9f},{0xe1,0x1c,0x54,0xb5,0x8d,0x91},
-	{0xe7,0x19,0x4f,0xa8,0x9a,0x83},{0xe5,0x1a,0x46,0xa3,0x97,0x8d}
-};
+#define AES_BLOCK_SIZE  XHDCP22_CMN_AES128_BLOCK_SIZE /* AES operates on 16 bytes at a time */
+#define AES_ROUNDS      10  /* Number of rounds of AES-128 */
+#define AES_CTR_BLOCKS  4   /* Counter blocks encrypted per call in CTR mode */
 
 /***************** Macros (Inline Functions) Definitions *********************/
-// The least significant byte of the word is rotated to the end.
-#define AES_BLOCK_SIZE 16 /* AES operates on 16 bytes at a time */
+// The most significant byte of the word is rotated to the end.
 #define KE_ROTWORD(x) (((x) << 8) | ((x) >> 24))
+#define AES_ROTR(x,n) (((x) >> (n)) | ((x) << (32-(n))))
+
+// Multiplication by x (0x02) in GF(2^8) of the four bytes of a word.
+#define AES_XTIME(x) ((((x) & 0x7F7F7F7F) << 1) ^ ((((x) >> 7) & 0x01010101) * 0x1B))
+
+// Rotation left by n bits of each of the four bytes of a word.
+#define AES_ROTL8(x,n) \
+	((((x) << (n)) & (0x01010101U * ((0xFFU << (n)) & 0xFFU))) | \
+	 (((x) >> (8-(n))) & (0x01010101U * (0xFFU >> (8-(n))))))
+
+#if defined(AES_CORE_GENERIC) && !defined(XHDCP22_CMN_AES_CONSTANT_TIME)
+// Column c of the next state from the state words a, b, c, d that ShiftRows
+// moves into it. Row r uses the T-table rotated by 8*r bits.
+#define AES_TE(a,b,c,d) (Aes_Te0[(a) >> 24] ^ \
+	AES_ROTR(Aes_Te0[((b) >> 16) & 0xFF], 8) ^ \
+	AES_ROTR(Aes_Te0[((c) >> 8) & 0xFF], 16) ^ \
+	AES_ROTR(Aes_Te0[(d) & 0xFF], 24))
+#define AES_TD(a,b,c,d) (Aes_Td0[(a) >> 24] ^ \
+	AES_ROTR(Aes_Td0[((b) >> 16) & 0xFF], 8) ^ \
+	AES_ROTR(Aes_Td0[((c) >> 8) & 0xFF], 16) ^ \
+	AES_ROTR(Aes_Td0[(d) & 0xFF], 24))
+// The last round without MixColumns, with the plain S-box.
+#define AES_SUB(Box,a,b,c,d) (((u32)Box[(a) >> 24] << 24) | \
+	((u32)Box[((b) >> 16) & 0xFF] << 16) | \
+	((u32)Box[((c) >> 8) & 0xFF] << 8) | \
+	(u32)Box[(d) & 0xFF])
+#endif
 
 /**************************** Type Definitions *******************************/
 
+/************************** Variable Definitions *****************************/
+static const u8 Aes_Rcon[AES_ROUNDS] = {
+	0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x1B,0x36
+};
+
+#if defined(AES_CORE_GENERIC) && !defined(XHDCP22_CMN_AES_CONSTANT_TIME)
+/* This is the specified AES SBox and its inverse, indexed by the input byte. */
+static const u8 Aes_Sbox[256] = {
+	0x63,0x7C,0x77,0x7B,0xF2,0x6B,0x6F,0xC5,0x30,0x01,0x67,0x2B,0xFE,0xD7,0xAB,0x76,
+	0xCA,0x82,0xC9,0x7D,0xFA,0x59,0x47,0xF0,0xAD,0xD4,0xA2,0xAF,0x9C,0xA4,0x72,0xC0,
+	0xB7,0xFD,0x93,0x26,0x36,0x3F,0xF7,0xCC,0x34,0xA5,0xE5,0xF1,0x71,0xD8,0x31,0x15,
+	0x04,0xC7,0x23,0xC3,0x18,0x96,0x05,0x9A,0x07,0x12,0x80,0xE2,0xEB,0x27,0xB2,0x75,
+	0x09,0x83,0x2C,0x1A,0x1B,0x6E,0x5A,0xA0,0x52,0x3B,0xD6,0xB3,0x29,0xE3,0x2F,0x84,
+	0x53,0xD1,0x00,0xED,0x20,0xFC,0xB1,0x5B,0x6A,0xCB,0xBE,0x39,0x4A,0x4C,0x58,0xCF,
+	0xD0,0xEF,0xAA,0xFB,0x43,0x4D,0x33,0x85,0x45,0xF9,0x02,0x7F,0x50,0x3C,0x9F,0xA8,
+	0x51,0xA3,0x40,0x8F,0x92,0x9D,0x38,0xF5,0xBC,0xB6,0xDA,0x21,0x10,0xFF,0xF3,0xD2,
+	0xCD,0x0C,0x13,0xEC,0x5F,0x97,0x44,0x17,0xC4,0xA7,0x7E,0x3D,0x64,0x5D,0x19,0x73,
+	0x60,0x81,0x4F,0xDC,0x22,0x2A,0x90,0x88,0x46,0xEE,0xB8,0x14,0xDE,0x5E,0x0B,0xDB,
+	0xE0,0x32,0x3A,0x0A,0x49,0x06,0x24,0x5C,0xC2,0xD3,0xAC,0x62,0x91,0x95,0xE4,0x79,
+	0xE7,0xC8,0x37,0x6D,0x8D,0xD5,0x4E,0xA9,0x6C,0x56,0xF4,0xEA,0x65,0x7A,0xAE,0x08,
+	0xBA,0x78,0x25,0x2E,0x1C,0xA6,0xB4,0xC6,0xE8,0xDD,0x74,0x1F,0x4B,0xBD,0x8B,0x8A,
+	0x70,0x3E,0xB5,0x66,0x48,0x03,0xF6,0x0E,0x61,0x35,0x57,0xB9,0x86,0xC1,0x1D,0x9E,
+	0xE1,0xF8,0x98,0x11,0x69,0xD9,0x8E,0x94,0x9B,0x1E,0x87,0xE9,0xCE,0x55,0x28,0xDF,
+	0x8C,0xA1,0x89,0x0D,0xBF,0xE6,0x42,0x68,0x41,0x99,0x2D,0x0F,0xB0,0x54,0xBB,0x16
+};
+
+static const u8 Aes_InvSbox[256] = {
+	0x52,0x09,0x6A,0xD5,0x30,0x36,0xA5,0x38,0xBF,0x40,0xA3,0x9E,0x81,0xF3,0xD7,0xFB,
+	0x7C,0xE3,0x39,0x82,0x9B,0x2F,0xFF,0x87,0x34,0x8E,0x43,0x44,0xC4,0xDE,0xE9,0xCB,
+	0x54,0x7B,0x94,0x32,0xA6,0xC2,0x23,0x3D,0xEE,0x4C,0x95,0x0B,0x42,0xFA,0xC3,0x4E,
+	0x08,0x2E,0xA1,0x66,0x28,0xD9,0x24,0xB2,0x76,0x5B,0xA2,0x49,0x6D,0x8B,0xD1,0x25,
+	0x72,0xF8,0xF6,0x64,0x86,0x68,0x98,0x16,0xD4,0xA4,0x5C,0xCC,0x5D,0x65,0xB6,0x92,
+	0x6C,0x70,0x48,0x50,0xFD,0xED,0xB9,0xDA,0x5E,0x15,0x46,0x57,0xA7,0x8D,0x9D,0x84,
+	0x90,0xD8,0xAB,0x00,0x8C,0xBC,0xD3,0x0A,0xF7,0xE4,0x58,0x05,0xB8,0xB3,0x45,0x06,
+	0xD0,0x2C,0x1E,0x8F,0xCA,0x3F,0x0F,0x02,0xC1,0xAF,0xBD,0x03,0x01,0x13,0x8A,0x6B,
+	0x3A,0x91,0x11,0x41,0x4F,0x67,0xDC,0xEA,0x97,0xF2,0xCF,0xCE,0xF0,0xB4,0xE6,0x73,
+	0x96,0xAC,0x74,0x22,0xE7,0xAD,0x35,0x85,0xE2,0xF9,0x37,0xE8,0x1C,0x75,0xDF,0x6E,
+	0x47,0xF1,0x1A,0x71,0x1D,0x29,0xC5,0x89,0x6F,0xB7,0x62,0x0E,0xAA,0x18,0xBE,0x1B,
+	0xFC,0x56,0x3E,0x4B,0xC6,0xD2,0x79,0x20,0x9A,0xDB,0xC0,0xFE,0x78,0xCD,0x5A,0xF4,
+	0x1F,0xDD,0xA8,0x33,0x88,0x07,0xC7,0x31,0xB1,0x12,0x10,0x59,0x27,0x80,0xEC,0x5F,
+	0x60,0x51,0x7F,0xA9,0x19,0xB5,0x4A,0x0D,0x2D,0xE5,0x7A,0x9F,0x93,0xC9,0x9C,0xEF,
+	0xA0,0xE0,0x3B,0x4D,0xAE,0x2A,0xF5,0xB0,0xC8,0xEB,0xBB,0x3C,0x83,0x53,0x99,0x61,
+	0x17,0x2B,0x04,0x7E,0xBA,0x77,0xD6,0x26,0xE1,0x69,0x14,0x63,0x55,0x21,0x0C,0x7D
+};
+
+/* The T-tables combine SubBytes and MixColumns of one byte in row 0:
+   Aes_Te0[x] = {02,01,01,03}*S[x] and Aes_Td0[x] = {0e,09,0d,0b}*InvS[x],
+   most significant byte first. The rows 1 to 3 use the same table rotated. */
+static const u32 Aes_Te0[256] = {
+	0xC66363A5,0xF87C7C84,0xEE777799,0xF67B7B8D,0xFFF2F20D,0xD66B6BBD,0xDE6F6FB1,0x91C5C554,
+	0x60303050,0x02010103,0xCE6767A9,0x562B2B7D,0xE7FEFE19,0xB5D7D762,0x4DABABE6,0xEC76769A,
+	0x8FCACA45,0x1F82829D,0x89C9C940,0xFA7D7D87,0xEFFAFA15,0xB25959EB,0x8E4747C9,0xFBF0F00B,
+	0x41ADADEC,0xB3D4D467,0x5FA2A2FD,0x45AFAFEA,0x239C9CBF,0x53A4A4F7,0xE4727296,0x9BC0C05B,
+	0x75B7B7C2,0xE1FDFD1C,0x3D9393AE,0x4C26266A,0x6C36365A,0x7E3F3F41,0xF5F7F702,0x83CCCC4F,
+	0x6834345C,0x51A5A5F4,0xD1E5E534,0xF9F1F108,0xE2717193,0xABD8D873,0x62313153,0x2A15153F,
+	0x0804040C,0x95C7C752,0x46232365,0x9DC3C35E,0x30181828,0x379696A1,0x0A05050F,0x2F9A9AB5,
+	0x0E070709,0x24121236,0x1B80809B,0xDFE2E23D,0xCDEBEB26,0x4E272769,0x7FB2B2CD,0xEA75759F,
+	0x1209091B,0x1D83839E,0x582C2C74,0x341A1A2E,0x361B1B2D,0xDC6E6EB2,0xB45A5AEE,0x5BA0A0FB,
+	0xA45252F6,0x763B3B4D,0xB7D6D661,0x7DB3B3CE,0x5229297B,0xDDE3E33E,0x5E2F2F71,0x13848497,
+	0xA65353F5,0xB9D1D168,0x00000000,0xC1EDED2C,0x40202060,0xE3FCFC1F,0x79B1B1C8,0xB65B5BED,
+	0xD46A6ABE,0x8DCBCB46,0x67BEBED9,0x7239394B,0x944A4ADE,0x984C4CD4,0xB05858E8,0x85CFCF4A,
+	0xBBD0D06B,0xC5EFEF2A,0x4FAAAAE5,0xEDFBFB16,0x864343C5,0x9A4D4DD7,0x66333355,0x11858594,
+	0x8A4545CF,0xE9F9F910,0x04020206,0xFE7F7F81,0xA05050F0,0x783C3C44,0x259F9FBA,0x4BA8A8E3,
+	0xA25151F3,0x5DA3A3FE,0x804040C0,0x058F8F8A,0x3F9292AD,0x219D9DBC,0x70383848,0xF1F5F504,
+	0x63BCBCDF,0x77B6B6C1,0xAFDADA75,0x42212163,0x20101030,0xE5FFFF1A,0xFDF3F30E,0xBFD2D26D,
+	0x81CDCD4C,0x180C0C14,0x26131335,0xC3ECEC2F,0xBE5F5FE1,0x359797A2,0x884444CC,0x2E171739,
+	0x93C4C457,0x55A7A7F2,0xFC7E7E82,0x7A3D3D47,0xC86464AC,0xBA5D5DE7,0x3219192B,0xE6737395,
+	0xC06060A0,0x19818198,0x9E4F4FD1,0xA3DCDC7F,0x44222266,0x542A2A7E,0x3B9090AB,0x0B888883,
+	0x8C4646CA,0xC7EEEE29,0x6BB8B8D3,0x2814143C,0xA7DEDE79,0xBC5E5EE2,0x160B0B1D,0xADDBDB76,
+	0xDBE0E03B,0x64323256,0x743A3A4E,0x140A0A1E,0x924949DB,0x0C06060A,0x4824246C,0xB85C5CE4,
+	0x9FC2C25D,0xBDD3D36E,0x43ACACEF,0xC46262A6,0x399191A8,0x319595A4,0xD3E4E437,0xF279798B,
+	0xD5E7E732,0x8BC8C843,0x6E373759,0xDA6D6DB7,0x018D8D8C,0xB1D5D564,0x9C4E4ED2,0x49A9A9E0,
+	0xD86C6CB4,0xAC5656FA,0xF3F4F407,0xCFEAEA25,0xCA6565AF,0xF47A7A8E,0x47AEAEE9,0x10080818,
+	0x6FBABAD5,0xF0787888,0x4A25256F,0x5C2E2E72,0x381C1C24,0x57A6A6F1,0x73B4B4C7,0x97C6C651,
+	0xCBE8E823,0xA1DDDD7C,0xE874749C,0x3E1F1F21,0x964B4BDD,0x61BDBDDC,0x0D8B8B86,0x0F8A8A85,
+	0xE0707090,0x7C3E3E42,0x71B5B5C4,0xCC6666AA,0x904848D8,0x06030305,0xF7F6F601,0x1C0E0E12,
+	0xC26161A3,0x6A35355F,0xAE5757F9,0x69B9B9D0,0x17868691,0x99C1C158,0x3A1D1D27,0x279E9EB9,
+	0xD9E1E138,0xEBF8F813,0x2B9898B3,0x22111133,0xD26969BB,0xA9D9D970,0x078E8E89,0x339494A7,
+	0x2D9B9BB6,0x3C1E1E22,0x15878792,0xC9E9E920,0x87CECE49,0xAA5555FF,0x50282878,0xA5DFDF7A,
+	0x038C8C8F,0x59A1A1F8,0x09898980,0x1A0D0D17,0x65BFBFDA,0xD7E6E631,0x844242C6,0xD06868B8,
+	0x824141C3,0x299999B0,0x5A2D2D77,0x1E0F0F11,0x7BB0B0CB,0xA85454FC,0x6DBBBBD6,0x2C16163A
+};
+
+static const u32 Aes_Td0[256] = {
+	0x51F4A750,0x7E416553,0x1A17A4C3,0x3A275E96,0x3BAB6BCB,0x1F9D45F1,0xACFA58AB,0x4BE30393,
+	0x2030FA55,0xAD766DF6,0x88CC7691,0xF5024C25,0x4FE5D7FC,0xC52ACBD7,0x26354480,0xB562A38F,
+	0xDEB15A49,0x25BA1B67,0x45EA0E98,0x5DFEC0E1,0xC32F7502,0x814CF012,0x8D4697A3,0x6BD3F9C6,
+	0x038F5FE7,0x15929C95,0xBF6D7AEB,0x955259DA,0xD4BE832D,0x587421D3,0x49E06929,0x8EC9C844,
+	0x75C2896A,0xF48E7978,0x99583E6B,0x27B971DD,0xBEE14FB6,0xF088AD17,0xC920AC66,0x7DCE3AB4,
+	0x63DF4A18,0xE51A3182,0x97513360,0x62537F45,0xB16477E0,0xBB6BAE84,0xFE81A01C,0xF9082B94,
+	0x70486858,0x8F45FD19,0x94DE6C87,0x527BF8B7,0xAB73D323,0x724B02E2,0xE31F8F57,0x6655AB2A,
+	0xB2EB2807,0x2FB5C203,0x86C57B9A,0xD33708A5,0x302887F2,0x23BFA5B2,0x02036ABA,0xED16825C,
+	0x8ACF1C2B,0xA779B492,0xF307F2F0,0x4E69E2A1,0x65DAF4CD,0x0605BED5,0xD134621F,0xC4A6FE8A,
+	0x342E539D,0xA2F355A0,0x058AE132,0xA4F6EB75,0x0B83EC39,0x4060EFAA,0x5E719F06,0xBD6E1051,
+	0x3E218AF9,0x96DD063D,0xDD3E05AE,0x4DE6BD46,0x91548DB5,0x71C45D05,0x0406D46F,0x605015FF,
+	0x1998FB24,0xD6BDE997,0x894043CC,0x67D99E77,0xB0E842BD,0x07898B88,0xE7195B38,0x79C8EEDB,
+	0xA17C0A47,0x7C420FE9,0xF8841EC9,0x00000000,0x09808683,0x322BED48,0x1E1170AC,0x6C5A724E,
+	0xFD0EFFFB,0x0F853856,0x3DAED51E,0x362D3927,0x0A0FD964,0x685CA621,0x9B5B54D1,0x24362E3A,
+	0x0C0A67B1,0x9357E70F,0xB4EE96D2,0x1B9B919E,0x80C0C54F,0x61DC20A2,0x5A774B69,0x1C121A16,
+	0xE293BA0A,0xC0A02AE5,0x3C22E043,0x121B171D,0x0E090D0B,0xF28BC7AD,0x2DB6A8B9,0x141EA9C8,
+	0x57F11985,0xAF75074C,0xEE99DDBB,0xA37F60FD,0xF701269F,0x5C72F5BC,0x44663BC5,0x5BFB7E34,
+	0x8B432976,0xCB23C6DC,0xB6EDFC68,0xB8E4F163,0xD731DCCA,0x42638510,0x13972240,0x84C61120,
+	0x854A247D,0xD2BB3DF8,0xAEF93211,0xC729A16D,0x1D9E2F4B,0xDCB230F3,0x0D8652EC,0x77C1E3D0,
+	0x2BB3166C,0xA970B999,0x119448FA,0x47E96422,0xA8FC8CC4,0xA0F03F1A,0x567D2CD8,0x223390EF,
+	0x87494EC7,0xD938D1C1,0x8CCAA2FE,0x98D40B36,0xA6F581CF,0xA57ADE28,0xDAB78E26,0x3FADBFA4,
+	0x2C3A9DE4,0x5078920D,0x6A5FCC9B,0x547E4662,0xF68D13C2,0x90D8B8E8,0x2E39F75E,0x82C3AFF5,
+	0x9F5D80BE,0x69D0937C,0x6FD52DA9,0xCF2512B3,0xC8AC993B,0x10187DA7,0xE89C636E,0xDB3BBB7B,
+	0xCD267809,0x6E5918F4,0xEC9AB701,0x834F9AA8,0xE6956E65,0xAAFFE67E,0x21BCCF08,0xEF15E8E6,
+	0xBAE79BD9,0x4A6F36CE,0xEA9F09D4,0x29B07CD6,0x31A4B2AF,0x2A3F2331,0xC6A59430,0x35A266C0,
+	0x744EBC37,0xFC82CAA6,0xE090D0B0,0x33A7D815,0xF104984A,0x41ECDAF7,0x7FCD500E,0x1791F62F,
+	0x764DD68D,0x43EFB04D,0xCCAA4D54,0xE49604DF,0x9ED1B5E3,0x4C6A881B,0xC12C1FB8,0x4665517F,
+	0x9D5EEA04,0x018C355D,0xFA877473,0xFB0B412E,0xB3671D5A,0x92DBD252,0xE9105633,0x6DD64713,
+	0x9AD7618C,0x37A10C7A,0x59F8148E,0xEB133C89,0xCEA927EE,0xB761C935,0xE11CE5ED,0x7A47B13C,
+	0x9CD2DF59,0x55F2733F,0x1814CE79,0x73C737BF,0x53F7CDEA,0x5FFDAA5B,0xDF3D6F14,0x7844DB86,
+	0xCAAFF381,0xB968C43E,0x3824342C,0xC2A3405F,0x161DC372,0xBCE2250C,0x283C498B,0xFF0D9541,
+	0x39A80171,0x080CB3DE,0xD8B4E49C,0x6456C190,0x7BCB8461,0xD532B670,0x486C5C74,0xD0B85742
+};
+#endif
+
 /************************** Function Prototypes ******************************/
+static u32  AesLoad32(const u8 *Bytes);
+static void AesStore32(u8 *Bytes, u32 Word);
 static u32  AesSubWord(u32 Word);
-static void AesKeySetup(const u8 Key[], u32 W[], int KeySizeBits);
-static void AesAddRoundKey(u8 State[][4], const u32 W[]);
-static void AesSubBytes(u8 State[][4]);
-static void AesInvSubBytes(u8 State[][4]);
-static void AesShiftRows(u8 State[][4]);
-static void AesInvShiftRows(u8 State[][4]);
-static void AesMixColumns(u8 State[][4]);
-static void AesInvMixColumns(u8 State[][4]);
-static void AesEncrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize);
-static void AesDecrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize);
-#ifdef AES_CIPHER_CTR_MODE
-static void Xor(u8 *C, const u8 *A, const u8 *B, u32 Size);
-static void AesIncrementIv(u8 Iv[], int CounterSize);
-static void AesEncryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								  const u32 Key[], int KeySize, const u8 Iv[]);
-static void AesDecryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								 const u32 Key[], int KeySize, const u8 Iv[]);
+static void AesKeySetup(const u8 Key[], u32 W[]);
+static void AesEncryptBlocks(const u32 W[], const u8 In[], u8 Out[], u32 NumBlocks);
+static void AesDecrypt(const u32 W[], const u8 In[], u8 Out[]);
+#ifndef AES_CORE_ARMV8CE
+static u32  AesInvMixWord(u32 Word);
+#endif
+#if defined(AES_CORE_GENERIC) && defined(XHDCP22_CMN_AES_CONSTANT_TIME)
+static u32  AesCtMul(u32 A, u32 B);
+static u32  AesCtSquare(u32 A);
+static u32  AesCtInv(u32 Word);
+static u32  AesCtInvSubWord(u32 Word);
+static u32  AesMixWord(u32 Word);
 #endif
 
-/************************** Variable Definitions *****************************/
+/************************** Function Implementation **************************/
 
 /*****************************************************************************/
 /**
 *
 * This function encrypts 128 bits data with a key of size 128 bits.
 *
-* @param	Input is the 16 byte plaintext
+* @param	Data is the 16 byte plaintext
 * @param	Key is the user supplied input key
 * @param	Output is the 16 byte ciphertext
 *
 * @return	None.
 *
-* @note		None.
+* @note		Use XHdcp22Cmn_Aes128SetKey and XHdcp22Cmn_Aes128EncryptBlocks
+*		to encrypt several blocks with the same key.
 *
 ******************************************************************************/
 void XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output)
 {
-	u32 KeySchedule[60];
+	XHdcp22Cmn_Aes128Ctx AesCtx;
 
 	/* Setup the AES internal key */
-	AesKeySetup(Key, KeySchedule, 128);
+	AesKeySetup(Key, AesCtx.RoundKey);
 	/* Encrypt 128-bits*/
-	AesEncrypt(Data, Output, KeySchedule, 128);
+	AesEncryptBlocks(AesCtx.RoundKey, Data, Output, 1);
+
+	memset(&AesCtx, 0, sizeof(AesCtx));
 }
 
 /*****************************************************************************/
 /**
 *
-* This function encrypts 128 bits data with a key of size 128 bits.
+* This function decrypts 128 bits data with a key of size 128 bits.
 *
-* @param	Input is the 16 byte ciphertext
+* @param	Data is the 16 byte ciphertext
 * @param	Key is the user supplied input key
 * @param	Output is the 16 byte plaintext
 *
@@ -304,816 +308,726 @@ void XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output)
 ******************************************************************************/
 void XHdcp22Cmn_Aes128Decrypt(const u8 *Data, const u8 *Key, u8 *Output)
 {
-	u32 KeySchedule[60];
+	XHdcp22Cmn_Aes128Ctx AesCtx;
 
 	/* Setup the AES internal key */
-	AesKeySetup(Key, KeySchedule, 128);
-	/* Encrypt 128-bits*/
-	AesDecrypt(Data, Output, KeySchedule, 128);
+	AesKeySetup(Key, AesCtx.RoundKey);
+	/* Decrypt 128-bits*/
+	AesDecrypt(AesCtx.RoundKey, Data, Output);
+
+	memset(&AesCtx, 0, sizeof(AesCtx));
 }
 
-#ifdef AES_CIPHER_CTR_MODE
-/****************************************************************************/
+/*****************************************************************************/
 /**
 *
-* This function calculates an XOR over each element of two equally sized
-* arrays.
+* This function expands a 128 bits key into the round keys of the context.
+*
+* @param	AesCtx is the key context to set up.
+* @param	Key is the 16 byte key.
+*
+* @return	None.
+*
+* @note		The context holds key material, clear it when it is no
+*		longer needed.
+*
+******************************************************************************/
+void XHdcp22Cmn_Aes128SetKey(XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Key)
+{
+	AesKeySetup(Key, AesCtx->RoundKey);
+}
+
+/*****************************************************************************/
+/**
 *
-* C = A ^ B.
+* This function encrypts consecutive 16 byte blocks independently (ECB).
 *
-* @param	C is the XOR of the input arrays.
-* @param    A is the input byte array.
-* @param    B is the input byte array.
-* @param    Size is the length of the input byte arrays.
+* @param	AesCtx is the key context set up by XHdcp22Cmn_Aes128SetKey.
+* @param	Data is the plaintext of NumBlocks blocks.
+* @param	Output is the ciphertext of NumBlocks blocks. It may be the
+*		same buffer as Data.
+* @param	NumBlocks is the number of blocks.
 *
 * @return	None.
 *
 * @note		None.
 *
-*****************************************************************************/
-static void Xor(u8 *C, const u8 *A, const u8 *B, u32 Size)
+******************************************************************************/
+void XHdcp22Cmn_Aes128EncryptBlocks(const XHdcp22Cmn_Aes128Ctx *AesCtx,
+	const u8 *Data, u8 *Output, u32 NumBlocks)
 {
-	while(Size--)
-	{
-		C[Size] = A[Size] ^ B[Size];
-	}
+	AesEncryptBlocks(AesCtx->RoundKey, Data, Output, NumBlocks);
 }
-#endif
 
 /*****************************************************************************/
 /**
 *
-* This function substitutes a word using the AES S-Box.
+* This function encrypts or decrypts with AES-128 in counter mode as
+* specified in NIST SP 800-38A. The counter block starts at Iv and is
+* incremented as a 128-bit big endian integer for each block.
 *
-* @param	Word to substitute.
+* @param	AesCtx is the key context set up by XHdcp22Cmn_Aes128SetKey.
+* @param	Iv is the 16 byte initial counter block.
+* @param	Data is the plaintext or ciphertext.
+* @param	Output is the ciphertext or plaintext, same length as Data.
+*		It may be the same buffer as Data.
+* @param	DataSize is any byte length.
 *
-* @return	Transformation word.
+* @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static u32 AesSubWord(u32 Word)
+void XHdcp22Cmn_Aes128Ctr(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Iv,
+	const u8 *Data, u8 *Output, u32 DataSize)
 {
-	unsigned int result;
+	u8 Counter[AES_BLOCK_SIZE];
+	u8 CtrBlocks[AES_CTR_BLOCKS * AES_BLOCK_SIZE];
+	u8 KeyStream[AES_CTR_BLOCKS * AES_BLOCK_SIZE];
+	u32 NumBlocks, Size, Idx;
+	int Byte;
+
+	memcpy(Counter, Iv, AES_BLOCK_SIZE);
+
+	while (DataSize > 0) {
+		NumBlocks = (DataSize + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+		if (NumBlocks > AES_CTR_BLOCKS)
+			NumBlocks = AES_CTR_BLOCKS;
+
+		for (Idx = 0; Idx < NumBlocks; Idx++) {
+			memcpy(&CtrBlocks[Idx * AES_BLOCK_SIZE], Counter, AES_BLOCK_SIZE);
+			for (Byte = AES_BLOCK_SIZE - 1; Byte >= 0; Byte--) {
+				if (++Counter[Byte] != 0)
+					break;
+			}
+		}
+
+		AesEncryptBlocks(AesCtx->RoundKey, CtrBlocks, KeyStream, NumBlocks);
+
+		Size = NumBlocks * AES_BLOCK_SIZE;
+		if (Size > DataSize)
+			Size = DataSize;
+		for (Idx = 0; Idx < Size; Idx++)
+			Output[Idx] = Data[Idx] ^ KeyStream[Idx];
 
-	result = (int)Aes_Sbox[(Word >> 4) & 0x0000000F][Word & 0x0000000F];
-	result += (int)Aes_Sbox[(Word >> 12) & 0x0000000F][(Word >> 8) & 0x0000000F] << 8;
-	result += (int)Aes_Sbox[(Word >> 20) & 0x0000000F][(Word >> 16) & 0x0000000F] << 16;
-	result += (int)Aes_Sbox[(Word >> 28) & 0x0000000F][(Word >> 24) & 0x0000000F] << 24;
-	return(result);
+		Data += Size;
+		Output += Size;
+		DataSize -= Size;
+	}
+
+	memset(KeyStream, 0, sizeof(KeyStream));
 }
 
 /*****************************************************************************/
 /**
 *
-* Performs the action of generating the keys that will be used in every round of
-* encryption.
+* This function computes the HDCP 2.2 derived keys
+* dkey(Ctr+i) = AES(Key, Iv XOR (Ctr+i)) for i = 0 .. NumBlocks-1.
+* The counter is XORed into the least significant 64 bits of Iv, as the
+* HDCP 2.2 key derivation specifies, instead of being added. The keys
+* dkey0 and dkey1 of Kd are computed in one call with Ctr 0 and NumBlocks 2.
 *
-* @param	Key is the user-supplied input key.
-* @param	W is the output key schedule.
-* @param	KeySize is the length in bits of "Key", must be 128, 192, or 256.
+* @param	AesCtx is the key context set up by XHdcp22Cmn_Aes128SetKey
+*		with Km XOR Rn.
+* @param	Iv is the 16 byte input Rtx || Rrx.
+* @param	Ctr is the first counter value.
+* @param	Output is the NumBlocks x 16 byte derived keys.
+* @param	NumBlocks is the number of keys, at most 4.
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesKeySetup(const u8 Key[], u32 W[], int KeySizeBits)
+void XHdcp22Cmn_Aes128DeriveKeys(const XHdcp22Cmn_Aes128Ctx *AesCtx,
+	const u8 *Iv, u32 Ctr, u8 *Output, u32 NumBlocks)
 {
-	int Nb=4, Nr, Nk, Idx;
-	u32 Temp, Rcon[]={0x01000000,0x02000000,0x04000000,0x08000000,0x10000000,0x20000000,
-	                  0x40000000,0x80000000,0x1b000000,0x36000000,0x6c000000,0xd8000000,
-	                  0xab000000,0x4d000000,0x9a000000};
-
-	switch (KeySizeBits) {
-		case 128: Nr = 10; Nk = 4; break;
-		case 192: Nr = 12; Nk = 6; break;
-		case 256: Nr = 14; Nk = 8; break;
-		default: return;
-	}
+	u8 CtrBlocks[AES_CTR_BLOCKS * AES_BLOCK_SIZE];
+	u8 *Block;
+	u32 Idx;
 
-	for (Idx=0; Idx < Nk; ++Idx) {
-		W[Idx] = ((Key[4 * Idx]) << 24) | ((Key[4 * Idx + 1]) << 16) |
-				   ((Key[4 * Idx + 2]) << 8) | ((Key[4 * Idx + 3]));
-	}
+	if (NumBlocks > AES_CTR_BLOCKS)
+		NumBlocks = AES_CTR_BLOCKS;
 
-	for (Idx = Nk; Idx < Nb * (Nr+1); ++Idx) {
-		Temp = W[Idx - 1];
-		if ((Idx % Nk) == 0)
-			Temp = AesSubWord(KE_ROTWORD(Temp)) ^ Rcon[(Idx-1)/Nk];
-		else if (Nk > 6 && (Idx % Nk) == 4)
-			Temp = AesSubWord(Temp);
-		W[Idx] = W[Idx-Nk] ^ Temp;
+	for (Idx = 0; Idx < NumBlocks; Idx++) {
+		Block = &CtrBlocks[Idx * AES_BLOCK_SIZE];
+		memcpy(Block, Iv, AES_BLOCK_SIZE);
+		AesStore32(&Block[12], AesLoad32(&Iv[12]) ^ (Ctr + Idx));
 	}
+
+	AesEncryptBlocks(AesCtx->RoundKey, CtrBlocks, Output, NumBlocks);
 }
 
 /*****************************************************************************/
 /**
 *
-* Performs the AddRoundKey step.
-* Each round has its own pre-generated 16-byte key in the form of 4 integers W.
-* Each integer is XOR'd by one column of the state.
-* Also performs the job of InvAddRoundKey(); since the function is a simple XOR process,
-* it is its own inverse.
+* This function loads a big endian word.
 *
-* @param	State are the statevalues of the AES conversion
-* @param	W are the 4 integers.
+* @param	Bytes points to the 4 bytes.
 *
-* @return	None.
+* @return	The word.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesAddRoundKey(u8 State[][4], const u32 w[])
+static u32 AesLoad32(const u8 *Bytes)
 {
-	u8 subkey[4];
-
-	// memcpy(subkey,&w[Idx],4); // Not accurate for big endian machines
-	// Subkey 1
-	subkey[0] = w[0] >> 24;
-	subkey[1] = w[0] >> 16;
-	subkey[2] = w[0] >> 8;
-	subkey[3] = w[0];
-	State[0][0] ^= subkey[0];
-	State[1][0] ^= subkey[1];
-	State[2][0] ^= subkey[2];
-	State[3][0] ^= subkey[3];
-	// Subkey 2
-	subkey[0] = w[1] >> 24;
-	subkey[1] = w[1] >> 16;
-	subkey[2] = w[1] >> 8;
-	subkey[3] = w[1];
-	State[0][1] ^= subkey[0];
-	State[1][1] ^= subkey[1];
-	State[2][1] ^= subkey[2];
-	State[3][1] ^= subkey[3];
-	// Subkey 3
-	subkey[0] = w[2] >> 24;
-	subkey[1] = w[2] >> 16;
-	subkey[2] = w[2] >> 8;
-	subkey[3] = w[2];
-	State[0][2] ^= subkey[0];
-	State[1][2] ^= subkey[1];
-	State[2][2] ^= subkey[2];
-	State[3][2] ^= subkey[3];
-	// Subkey 4
-	subkey[0] = w[3] >> 24;
-	subkey[1] = w[3] >> 16;
-	subkey[2] = w[3] >> 8;
-	subkey[3] = w[3];
-	State[0][3] ^= subkey[0];
-	State[1][3] ^= subkey[1];
-	State[2][3] ^= subkey[2];
-	State[3][3] ^= subkey[3];
+	return ((u32)Bytes[0] << 24) | ((u32)Bytes[1] << 16) |
+	       ((u32)Bytes[2] << 8) | (u32)Bytes[3];
 }
 
 /*****************************************************************************/
 /**
 *
-* Performs the SubBytes step. All bytes in the State are substituted with a
-* pre-calculated value from a lookup table.
+* This function stores a word in big endian order.
 *
-* @param	State are the statevalues of the AES conversion.
+* @param	Bytes points to the 4 bytes.
+* @param	Word is the word to store.
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesSubBytes(u8 State[][4])
+static void AesStore32(u8 *Bytes, u32 Word)
 {
-	State[0][0] = Aes_Sbox[State[0][0] >> 4][State[0][0] & 0x0F];
-	State[0][1] = Aes_Sbox[State[0][1] >> 4][State[0][1] & 0x0F];
-	State[0][2] = Aes_Sbox[State[0][2] >> 4][State[0][2] & 0x0F];
-	State[0][3] = Aes_Sbox[State[0][3] >> 4][State[0][3] & 0x0F];
-	State[1][0] = Aes_Sbox[State[1][0] >> 4][State[1][0] & 0x0F];
-	State[1][1] = Aes_Sbox[State[1][1] >> 4][State[1][1] & 0x0F];
-	State[1][2] = Aes_Sbox[State[1][2] >> 4][State[1][2] & 0x0F];
-	State[1][3] = Aes_Sbox[State[1][3] >> 4][State[1][3] & 0x0F];
-	State[2][0] = Aes_Sbox[State[2][0] >> 4][State[2][0] & 0x0F];
-	State[2][1] = Aes_Sbox[State[2][1] >> 4][State[2][1] & 0x0F];
-	State[2][2] = Aes_Sbox[State[2][2] >> 4][State[2][2] & 0x0F];
-	State[2][3] = Aes_Sbox[State[2][3] >> 4][State[2][3] & 0x0F];
-	State[3][0] = Aes_Sbox[State[3][0] >> 4][State[3][0] & 0x0F];
-	State[3][1] = Aes_Sbox[State[3][1] >> 4][State[3][1] & 0x0F];
-	State[3][2] = Aes_Sbox[State[3][2] >> 4][State[3][2] & 0x0F];
-	State[3][3] = Aes_Sbox[State[3][3] >> 4][State[3][3] & 0x0F];
+	Bytes[0] = (u8)(Word >> 24);
+	Bytes[1] = (u8)(Word >> 16);
+	Bytes[2] = (u8)(Word >> 8);
+	Bytes[3] = (u8)Word;
 }
 
 /*****************************************************************************/
 /**
 *
-* This function Performs the inverted substates step.
+* Performs the action of generating the keys that will be used in every round of
+* encryption. The words hold the bytes of the round keys most significant
+* byte first.
 *
-* @param	State are the statevalues of the AES conversion
+* @param	Key is the user-supplied 128-bit input key.
+* @param	W is the output key schedule of 44 words.
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesInvSubBytes(u8 State[][4])
+static void AesKeySetup(const u8 Key[], u32 W[])
 {
-	State[0][0] = Aes_Invsbox[State[0][0] >> 4][State[0][0] & 0x0F];
-	State[0][1] = Aes_Invsbox[State[0][1] >> 4][State[0][1] & 0x0F];
-	State[0][2] = Aes_Invsbox[State[0][2] >> 4][State[0][2] & 0x0F];
-	State[0][3] = Aes_Invsbox[State[0][3] >> 4][State[0][3] & 0x0F];
-	State[1][0] = Aes_Invsbox[State[1][0] >> 4][State[1][0] & 0x0F];
-	State[1][1] = Aes_Invsbox[State[1][1] >> 4][State[1][1] & 0x0F];
-	State[1][2] = Aes_Invsbox[State[1][2] >> 4][State[1][2] & 0x0F];
-	State[1][3] = Aes_Invsbox[State[1][3] >> 4][State[1][3] & 0x0F];
-	State[2][0] = Aes_Invsbox[State[2][0] >> 4][State[2][0] & 0x0F];
-	State[2][1] = Aes_Invsbox[State[2][1] >> 4][State[2][1] & 0x0F];
-	State[2][2] = Aes_Invsbox[State[2][2] >> 4][State[2][2] & 0x0F];
-	State[2][3] = Aes_Invsbox[State[2][3] >> 4][State[2][3] & 0x0F];
-	State[3][0] = Aes_Invsbox[State[3][0] >> 4][State[3][0] & 0x0F];
-	State[3][1] = Aes_Invsbox[State[3][1] >> 4][State[3][1] & 0x0F];
-	State[3][2] = Aes_Invsbox[State[3][2] >> 4][State[3][2] & 0x0F];
-	State[3][3] = Aes_Invsbox[State[3][3] >> 4][State[3][3] & 0x0F];
+	int Idx;
+
+	for (Idx = 0; Idx < 4; ++Idx) {
+		W[Idx] = AesLoad32(&Key[4 * Idx]);
+	}
+
+	for (Idx = 4; Idx < 4 * (AES_ROUNDS + 1); Idx += 4) {
+		W[Idx] = W[Idx - 4] ^ AesSubWord(KE_ROTWORD(W[Idx - 1])) ^
+		         ((u32)Aes_Rcon[Idx / 4 - 1] << 24);
+		W[Idx + 1] = W[Idx - 3] ^ W[Idx];
+		W[Idx + 2] = W[Idx - 2] ^ W[Idx + 1];
+		W[Idx + 3] = W[Idx - 1] ^ W[Idx + 2];
+	}
 }
 
+#ifndef AES_CORE_ARMV8CE
 /*****************************************************************************/
 /**
 *
-* This function erforms the ShiftRows step. All rows are shifted cylindrically
-* to the left.
+* Performs InvMixColumns on one column. It is written without tables, so it
+* also serves the constant time cipher. InvMixColumns equals MixColumns
+* after adding {04}*(a0 + a2) to the rows 0 and 2 and {04}*(a1 + a3) to the
+* rows 1 and 3.
 *
-* @param	State are the statevalues of the AES conversion.
+* @param	Word is the column, row 0 in the most significant byte.
 *
-* @return	None.
+* @return	The transformed column.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesShiftRows(u8 State[][4])
+static u32 AesInvMixWord(u32 Word)
 {
-	int t;
-
-	// Shift left by 1
-	t = State[1][0];
-	State[1][0] = State[1][1];
-	State[1][1] = State[1][2];
-	State[1][2] = State[1][3];
-	State[1][3] = t;
-	// Shift left by 2
-	t = State[2][0];
-	State[2][0] = State[2][2];
-	State[2][2] = t;
-	t = State[2][1];
-	State[2][1] = State[2][3];
-	State[2][3] = t;
-	// Shift left by 3
-	t = State[3][0];
-	State[3][0] = State[3][3];
-	State[3][3] = State[3][2];
-	State[3][2] = State[3][1];
-	State[3][1] = t;
+	u32 Rot8 = KE_ROTWORD(Word);
+	u32 Rot16 = AES_ROTR(Word, 16);
+	u32 Rot24 = AES_ROTR(Word, 8);
+	u32 X4 = AES_XTIME(AES_XTIME(Word ^ Rot16));
+
+	Word ^= X4;
+	Rot8 ^= AES_ROTR(X4, 24);
+	Rot16 ^= AES_ROTR(X4, 16);
+	Rot24 ^= AES_ROTR(X4, 8);
+
+	/* MixColumns: {02}*a0 + {03}*a1 + a2 + a3 */
+	return AES_XTIME(Word ^ Rot8) ^ Rot8 ^ Rot16 ^ Rot24;
 }
+#endif
 
+#if defined(AES_CORE_GENERIC) && !defined(XHDCP22_CMN_AES_CONSTANT_TIME)
 /*****************************************************************************/
 /**
 *
-* All rows are shifted cylindrically to the right.
+* This function substitutes a word using the AES S-Box.
 *
-* @param	State are the statevalues of the AES conversion.
+* @param	Word to substitute.
 *
-* @return	None.
+* @return	Transformation word.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesInvShiftRows(u8 State[][4])
+static u32 AesSubWord(u32 Word)
 {
-	int t;
-
-	// Shift right by 1
-	t = State[1][3];
-	State[1][3] = State[1][2];
-	State[1][2] = State[1][1];
-	State[1][1] = State[1][0];
-	State[1][0] = t;
-	// Shift right by 2
-	t = State[2][3];
-	State[2][3] = State[2][1];
-	State[2][1] = t;
-	t = State[2][2];
-	State[2][2] = State[2][0];
-	State[2][0] = t;
-	// Shift right by 3
-	t = State[3][3];
-	State[3][3] = State[3][0];
-	State[3][0] = State[3][1];
-	State[3][1] = State[3][2];
-	State[3][2] = t;
+	return AES_SUB(Aes_Sbox, Word, Word, Word, Word);
 }
 
 /*****************************************************************************/
 /**
 *
-* This function Performs the MixColums step.
-* The State is multiplied by itself using matrix
-* multiplication in a Galios Field 2^8. All multiplication is pre-computed in a table.
-* Addition is equivilent to XOR. (Must always make a copy of the column as the original
-* values will be destoyed.)
+* This function encrypts blocks using the T-tables.
 *
-* @param	State are the statevalues of the AES conversion.
+* @param	W is the key schedule.
+* @param	In is the plaintext of NumBlocks blocks.
+* @param	Out is the ciphertext of NumBlocks blocks.
+* @param	NumBlocks is the number of blocks.
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesMixColumns(u8 State[][4])
+static void AesEncryptBlocks(const u32 W[], const u8 In[], u8 Out[], u32 NumBlocks)
 {
-	u8 Col[4];
-
-	// Column 1
-	Col[0] = State[0][0];
-	Col[1] = State[1][0];
-	Col[2] = State[2][0];
-	Col[3] = State[3][0];
-	State[0][0] = Aes_GfMul[Col[0]][0];
-	State[0][0] ^= Aes_GfMul[Col[1]][1];
-	State[0][0] ^= Col[2];
-	State[0][0] ^= Col[3];
-	State[1][0] = Col[0];
-	State[1][0] ^= Aes_GfMul[Col[1]][0];
-	State[1][0] ^= Aes_GfMul[Col[2]][1];
-	State[1][0] ^= Col[3];
-	State[2][0] = Col[0];
-	State[2][0] ^= Col[1];
-	State[2][0] ^= Aes_GfMul[Col[2]][0];
-	State[2][0] ^= Aes_GfMul[Col[3]][1];
-	State[3][0] = Aes_GfMul[Col[0]][1];
-	State[3][0] ^= Col[1];
-	State[3][0] ^= Col[2];
-	State[3][0] ^= Aes_GfMul[Col[3]][0];
-	// Column 2
-	Col[0] = State[0][1];
-	Col[1] = State[1][1];
-	Col[2] = State[2][1];
-	Col[3] = State[3][1];
-	State[0][1] = Aes_GfMul[Col[0]][0];
-	State[0][1] ^= Aes_GfMul[Col[1]][1];
-	State[0][1] ^= Col[2];
-	State[0][1] ^= Col[3];
-	State[1][1] = Col[0];
-	State[1][1] ^= Aes_GfMul[Col[1]][0];
-	State[1][1] ^= Aes_GfMul[Col[2]][1];
-	State[1][1] ^= Col[3];
-	State[2][1] = Col[0];
-	State[2][1] ^= Col[1];
-	State[2][1] ^= Aes_GfMul[Col[2]][0];
-	State[2][1] ^= Aes_GfMul[Col[3]][1];
-	State[3][1] = Aes_GfMul[Col[0]][1];
-	State[3][1] ^= Col[1];
-	State[3][1] ^= Col[2];
-	State[3][1] ^= Aes_GfMul[Col[3]][0];
-	// Column 3
-	Col[0] = State[0][2];
-	Col[1] = State[1][2];
-	Col[2] = State[2][2];
-	Col[3] = State[3][2];
-	State[0][2] = Aes_GfMul[Col[0]][0];
-	State[0][2] ^= Aes_GfMul[Col[1]][1];
-	State[0][2] ^= Col[2];
-	State[0][2] ^= Col[3];
-	State[1][2] = Col[0];
-	State[1][2] ^= Aes_GfMul[Col[1]][0];
-	State[1][2] ^= Aes_GfMul[Col[2]][1];
-	State[1][2] ^= Col[3];
-	State[2][2] = Col[0];
-	State[2][2] ^= Col[1];
-	State[2][2] ^= Aes_GfMul[Col[2]][0];
-	State[2][2] ^= Aes_GfMul[Col[3]][1];
-	State[3][2] = Aes_GfMul[Col[0]][1];
-	State[3][2] ^= Col[1];
-	State[3][2] ^= Col[2];
-	State[3][2] ^= Aes_GfMul[Col[3]][0];
-	// Column 4
-	Col[0] = State[0][3];
-	Col[1] = State[1][3];
-	Col[2] = State[2][3];
-	Col[3] = State[3][3];
-	State[0][3] = Aes_GfMul[Col[0]][0];
-	State[0][3] ^= Aes_GfMul[Col[1]][1];
-	State[0][3] ^= Col[2];
-	State[0][3] ^= Col[3];
-	State[1][3] = Col[0];
-	State[1][3] ^= Aes_GfMul[Col[1]][0];
-	State[1][3] ^= Aes_GfMul[Col[2]][1];
-	State[1][3] ^= Col[3];
-	State[2][3] = Col[0];
-	State[2][3] ^= Col[1];
-	State[2][3] ^= Aes_GfMul[Col[2]][0];
-	State[2][3] ^= Aes_GfMul[Col[3]][1];
-	State[3][3] = Aes_GfMul[Col[0]][1];
-	State[3][3] ^= Col[1];
-	State[3][3] ^= Col[2];
-	State[3][3] ^= Aes_GfMul[Col[3]][0];
+	u32 S0, S1, S2, S3, T0, T1, T2, T3;
+	int Round;
+
+	while (NumBlocks--) {
+		S0 = AesLoad32(&In[0]) ^ W[0];
+		S1 = AesLoad32(&In[4]) ^ W[1];
+		S2 = AesLoad32(&In[8]) ^ W[2];
+		S3 = AesLoad32(&In[12]) ^ W[3];
+
+		for (Round = 1; Round < AES_ROUNDS; Round++) {
+			T0 = AES_TE(S0, S1, S2, S3) ^ W[4 * Round];
+			T1 = AES_TE(S1, S2, S3, S0) ^ W[4 * Round + 1];
+			T2 = AES_TE(S2, S3, S0, S1) ^ W[4 * Round + 2];
+			T3 = AES_TE(S3, S0, S1, S2) ^ W[4 * Round + 3];
+			S0 = T0; S1 = T1; S2 = T2; S3 = T3;
+		}
+
+		AesStore32(&Out[0], AES_SUB(Aes_Sbox, S0, S1, S2, S3) ^ W[40]);
+		AesStore32(&Out[4], AES_SUB(Aes_Sbox, S1, S2, S3, S0) ^ W[41]);
+		AesStore32(&Out[8], AES_SUB(Aes_Sbox, S2, S3, S0, S1) ^ W[42]);
+		AesStore32(&Out[12], AES_SUB(Aes_Sbox, S3, S0, S1, S2) ^ W[43]);
+
+		In += AES_BLOCK_SIZE;
+		Out += AES_BLOCK_SIZE;
+	}
 }
 
 /*****************************************************************************/
 /**
 *
-* This function Performs the the inverted MixColums step.
+* This function decrypts one block using the T-tables and the equivalent
+* inverse cipher of FIPS 197, section 5.3.5.
 *
-* @param	State are the statevalues of the AES conversion.
+* @param	W is the encryption key schedule.
+* @param	In is 16 bytes of ciphertext
+* @param	Out is 16 bytes of plaintext
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesInvMixColumns(u8 State[][4])
+static void AesDecrypt(const u32 W[], const u8 In[], u8 Out[])
 {
-	u8 Col[4];
-
-	// Column 1
-	Col[0] = State[0][0];
-	Col[1] = State[1][0];
-	Col[2] = State[2][0];
-	Col[3] = State[3][0];
-	State[0][0] = Aes_GfMul[Col[0]][5];
-	State[0][0] ^= Aes_GfMul[Col[1]][3];
-	State[0][0] ^= Aes_GfMul[Col[2]][4];
-	State[0][0] ^= Aes_GfMul[Col[3]][2];
-	State[1][0] = Aes_GfMul[Col[0]][2];
-	State[1][0] ^= Aes_GfMul[Col[1]][5];
-	State[1][0] ^= Aes_GfMul[Col[2]][3];
-	State[1][0] ^= Aes_GfMul[Col[3]][4];
-	State[2][0] = Aes_GfMul[Col[0]][4];
-	State[2][0] ^= Aes_GfMul[Col[1]][2];
-	State[2][0] ^= Aes_GfMul[Col[2]][5];
-	State[2][0] ^= Aes_GfMul[Col[3]][3];
-	State[3][0] = Aes_GfMul[Col[0]][3];
-	State[3][0] ^= Aes_GfMul[Col[1]][4];
-	State[3][0] ^= Aes_GfMul[Col[2]][2];
-	State[3][0] ^= Aes_GfMul[Col[3]][5];
-	// Column 2
-	Col[0] = State[0][1];
-	Col[1] = State[1][1];
-	Col[2] = State[2][1];
-	Col[3] = State[3][1];
-	State[0][1] = Aes_GfMul[Col[0]][5];
-	State[0][1] ^= Aes_GfMul[Col[1]][3];
-	State[0][1] ^= Aes_GfMul[Col[2]][4];
-	State[0][1] ^= Aes_GfMul[Col[3]][2];
-	State[1][1] = Aes_GfMul[Col[0]][2];
-	State[1][1] ^= Aes_GfMul[Col[1]][5];
-	State[1][1] ^= Aes_GfMul[Col[2]][3];
-	State[1][1] ^= Aes_GfMul[Col[3]][4];
-	State[2][1] = Aes_GfMul[Col[0]][4];
-	State[2][1] ^= Aes_GfMul[Col[1]][2];
-	State[2][1] ^= Aes_GfMul[Col[2]][5];
-	State[2][1] ^= Aes_GfMul[Col[3]][3];
-	State[3][1] = Aes_GfMul[Col[0]][3];
-	State[3][1] ^= Aes_GfMul[Col[1]][4];
-	State[3][1] ^= Aes_GfMul[Col[2]][2];
-	State[3][1] ^= Aes_GfMul[Col[3]][5];
-	// Column 3
-	Col[0] = State[0][2];
-	Col[1] = State[1][2];
-	Col[2] = State[2][2];
-	Col[3] = State[3][2];
-	State[0][2] = Aes_GfMul[Col[0]][5];
-	State[0][2] ^= Aes_GfMul[Col[1]][3];
-	State[0][2] ^= Aes_GfMul[Col[2]][4];
-	State[0][2] ^= Aes_GfMul[Col[3]][2];
-	State[1][2] = Aes_GfMul[Col[0]][2];
-	State[1][2] ^= Aes_GfMul[Col[1]][5];
-	State[1][2] ^= Aes_GfMul[Col[2]][3];
-	State[1][2] ^= Aes_GfMul[Col[3]][4];
-	State[2][2] = Aes_GfMul[Col[0]][4];
-	State[2][2] ^= Aes_GfMul[Col[1]][2];
-	State[2][2] ^= Aes_GfMul[Col[2]][5];
-	State[2][2] ^= Aes_GfMul[Col[3]][3];
-	State[3][2] = Aes_GfMul[Col[0]][3];
-	State[3][2] ^= Aes_GfMul[Col[1]][4];
-	State[3][2] ^= Aes_GfMul[Col[2]][2];
-	State[3][2] ^= Aes_GfMul[Col[3]][5];
-	// Column 4
-	Col[0] = State[0][3];
-	Col[1] = State[1][3];
-	Col[2] = State[2][3];
-	Col[3] = State[3][3];
-	State[0][3] = Aes_GfMul[Col[0]][5];
-	State[0][3] ^= Aes_GfMul[Col[1]][3];
-	State[0][3] ^= Aes_GfMul[Col[2]][4];
-	State[0][3] ^= Aes_GfMul[Col[3]][2];
-	State[1][3] = Aes_GfMul[Col[0]][2];
-	State[1][3] ^= Aes_GfMul[Col[1]][5];
-	State[1][3] ^= Aes_GfMul[Col[2]][3];
-	State[1][3] ^= Aes_GfMul[Col[3]][4];
-	State[2][3] = Aes_GfMul[Col[0]][4];
-	State[2][3] ^= Aes_GfMul[Col[1]][2];
-	State[2][3] ^= Aes_GfMul[Col[2]][5];
-	State[2][3] ^= Aes_GfMul[Col[3]][3];
-	State[3][3] = Aes_GfMul[Col[0]][3];
-	State[3][3] ^= Aes_GfMul[Col[1]][4];
-	State[3][3] ^= Aes_GfMul[Col[2]][2];
-	State[3][3] ^= Aes_GfMul[Col[3]][5];
+	u32 S0, S1, S2, S3, T0, T1, T2, T3;
+	int Round;
+
+	S0 = AesLoad32(&In[0]) ^ W[40];
+	S1 = AesLoad32(&In[4]) ^ W[41];
+	S2 = AesLoad32(&In[8]) ^ W[42];
+	S3 = AesLoad32(&In[12]) ^ W[43];
+
+	for (Round = AES_ROUNDS - 1; Round > 0; Round--) {
+		T0 = AES_TD(S0, S3, S2, S1) ^ AesInvMixWord(W[4 * Round]);
+		T1 = AES_TD(S1, S0, S3, S2) ^ AesInvMixWord(W[4 * Round + 1]);
+		T2 = AES_TD(S2, S1, S0, S3) ^ AesInvMixWord(W[4 * Round + 2]);
+		T3 = AES_TD(S3, S2, S1, S0) ^ AesInvMixWord(W[4 * Round + 3]);
+		S0 = T0; S1 = T1; S2 = T2; S3 = T3;
+	}
+
+	AesStore32(&Out[0], AES_SUB(Aes_InvSbox, S0, S3, S2, S1) ^ W[0]);
+	AesStore32(&Out[4], AES_SUB(Aes_InvSbox, S1, S0, S3, S2) ^ W[1]);
+	AesStore32(&Out[8], AES_SUB(Aes_InvSbox, S2, S1, S0, S3) ^ W[2]);
+	AesStore32(&Out[12], AES_SUB(Aes_InvSbox, S3, S2, S1, S0) ^ W[3]);
 }
+#endif
 
-#ifdef AES_CIPHER_CTR_MODE
+#if defined(AES_CORE_GENERIC) && defined(XHDCP22_CMN_AES_CONSTANT_TIME)
 /*****************************************************************************/
 /**
 *
-* This function increments IV. It is used for AES-CTR.
+* This function multiplies the four bytes of A with the four bytes of B in
+* GF(2^8) without branches or table lookups.
 *
-* @param	Iv is the initialization vector used.
-* @param	CounterSize is the size of the counter block.
+* @param	A is the first factor.
+* @param	B is the second factor.
 *
-* @return	None.
+* @return	The four products.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesIncrementIv(u8 Iv[], int CounterSize)
+static u32 AesCtMul(u32 A, u32 B)
 {
-	int Idx;
+	u32 Product = 0;
+	int Bit;
 
-	// Use CounterSize bytes at the end of the IV as the big-endian integer to increment.
-	for (Idx = AES_BLOCK_SIZE - 1; Idx >= AES_BLOCK_SIZE -
-		 CounterSize; Idx--) {
-		Iv[Idx]++;
-		if (Iv[Idx] != 0 || Idx == AES_BLOCK_SIZE - CounterSize)
-			break;
+	for (Bit = 0; Bit < 8; Bit++) {
+		Product ^= A & (((B >> Bit) & 0x01010101) * 0xFF);
+		A = AES_XTIME(A);
 	}
+
+	return Product;
 }
-#endif
 
 /*****************************************************************************/
 /**
 *
-* This function encrypts using AES encryption.
+* This function squares the four bytes of a word in GF(2^8). Squaring is
+* linear, bit i of the input adds x^(2i) reduced modulo the AES polynomial.
+*
+* @param	A holds the four bytes.
+*
+* @return	The four squares.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesCtSquare(u32 A)
+{
+	static const u8 Sq[8] = {0x01,0x04,0x10,0x40,0x1B,0x6C,0xAB,0x9A};
+	u32 Square = 0;
+	int Bit;
+
+	for (Bit = 0; Bit < 8; Bit++) {
+		Square ^= ((A >> Bit) & 0x01010101) * Sq[Bit];
+	}
+
+	return Square;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes the GF(2^8) inverse of the four bytes of a word as
+* x^254, which maps 0 to 0 as the S-box requires.
+*
+* @param	Word holds the four bytes.
 *
-* @param	In is 16 bytes of plaintext
-* @param	Out is 16 bytes of ciphertext
-* @param	Key is from the key setup
-* @param	KeySize is the bit length of the key, 128, 192, or 256
+* @return	The four inverses.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesCtInv(u32 Word)
+{
+	u32 X2, X3, X12, X15, X240;
+
+	/* Addition chain with 7 squarings and 4 multiplications */
+	X2 = AesCtSquare(Word);
+	X3 = AesCtMul(X2, Word);
+	X12 = AesCtSquare(AesCtSquare(X3));
+	X15 = AesCtMul(X12, X3);
+	X240 = AesCtSquare(AesCtSquare(AesCtSquare(AesCtSquare(X15))));
+
+	return AesCtMul(AesCtMul(X240, X12), X2);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function substitutes a word with the S-box computed as the inverse
+* followed by the affine transformation.
+*
+* @param	Word to substitute.
+*
+* @return	Transformation word.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesSubWord(u32 Word)
+{
+	u32 Inverse = AesCtInv(Word);
+
+	return Inverse ^ AES_ROTL8(Inverse, 1) ^ AES_ROTL8(Inverse, 2) ^
+	       AES_ROTL8(Inverse, 3) ^ AES_ROTL8(Inverse, 4) ^ 0x63636363;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function substitutes a word with the inverse S-box, the inverse
+* affine transformation followed by the inverse.
+*
+* @param	Word to substitute.
+*
+* @return	Transformation word.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesCtInvSubWord(u32 Word)
+{
+	return AesCtInv(AES_ROTL8(Word, 1) ^ AES_ROTL8(Word, 3) ^
+	                AES_ROTL8(Word, 6) ^ 0x05050505);
+}
+
+/*****************************************************************************/
+/**
+*
+* Performs MixColumns on one column: {02}*a0 + {03}*a1 + a2 + a3 for row 0
+* and the rotations for the other rows.
+*
+* @param	Word is the column, row 0 in the most significant byte.
+*
+* @return	The transformed column.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 AesMixWord(u32 Word)
+{
+	u32 Rot8 = KE_ROTWORD(Word);
+
+	return AES_XTIME(Word ^ Rot8) ^ Rot8 ^ AES_ROTR(Word, 16) ^
+	       AES_ROTR(Word, 8);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function encrypts blocks in constant time.
+*
+* @param	W is the key schedule.
+* @param	In is the plaintext of NumBlocks blocks.
+* @param	Out is the ciphertext of NumBlocks blocks.
+* @param	NumBlocks is the number of blocks.
 *
 * @return	None.
 *
-* @note		Key setup must be done before any AES en/de-cryption functions
-* 			can be used.
+* @note		None.
 *
 ******************************************************************************/
-static void AesEncrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize)
+static void AesEncryptBlocks(const u32 W[], const u8 In[], u8 Out[], u32 NumBlocks)
 {
-	u8 State[4][4];
-
-	/* Copy input array (should be 16 bytes long) to a matrix (sequential bytes are ordered
-	   by row, not Col) called "State" for processing.
-	   *** Implementation note: The official AES documentation references the State by
-	   column, then row. Accessing an element in C requires row then column. Thus, all State
-	   references in AES must have the column and row indexes reversed for C implementation. */
-	State[0][0] = In[0];
-	State[1][0] = In[1];
-	State[2][0] = In[2];
-	State[3][0] = In[3];
-	State[0][1] = In[4];
-	State[1][1] = In[5];
-	State[2][1] = In[6];
-	State[3][1] = In[7];
-	State[0][2] = In[8];
-	State[1][2] = In[9];
-	State[2][2] = In[10];
-	State[3][2] = In[11];
-	State[0][3] = In[12];
-	State[1][3] = In[13];
-	State[2][3] = In[14];
-	State[3][3] = In[15];
-
-	// Perform the necessary number of rounds. The round key is added first.
-	// The last round does not perform the MixColumns step.
-	AesAddRoundKey(State,&Key[0]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[4]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[8]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[12]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[16]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[20]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[24]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[28]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[32]);
-	AesSubBytes(State); AesShiftRows(State);
-	AesMixColumns(State); AesAddRoundKey(State,&Key[36]);
-	if (KeySize != 128) {
-		AesSubBytes(State); AesShiftRows(State);
-		AesMixColumns(State); AesAddRoundKey(State,&Key[40]);
-		AesSubBytes(State); AesShiftRows(State);
-		AesMixColumns(State); AesAddRoundKey(State,&Key[44]);
-		if (KeySize != 192) {
-			AesSubBytes(State); AesShiftRows(State);
-			AesMixColumns(State); AesAddRoundKey(State,&Key[48]);
-			AesSubBytes(State); AesShiftRows(State);
-			AesMixColumns(State); AesAddRoundKey(State,&Key[52]);
-			AesSubBytes(State); AesShiftRows(State);
-			AesAddRoundKey(State,&Key[56]);
-		}
-		else {
-			AesSubBytes(State); AesShiftRows(State);
-			AesAddRoundKey(State,&Key[48]);
+	u32 S[4], T[4];
+	int Round, Col;
+
+	while (NumBlocks--) {
+		for (Col = 0; Col < 4; Col++)
+			S[Col] = AesLoad32(&In[4 * Col]) ^ W[Col];
+
+		for (Round = 1; Round <= AES_ROUNDS; Round++) {
+			/* SubBytes */
+			for (Col = 0; Col < 4; Col++)
+				S[Col] = AesSubWord(S[Col]);
+
+			/* ShiftRows: row r of column c comes from column c+r */
+			for (Col = 0; Col < 4; Col++)
+				T[Col] = (S[Col] & 0xFF000000) |
+				         (S[(Col + 1) & 3] & 0x00FF0000) |
+				         (S[(Col + 2) & 3] & 0x0000FF00) |
+				         (S[(Col + 3) & 3] & 0x000000FF);
+
+			/* MixColumns except in the last round, AddRoundKey */
+			for (Col = 0; Col < 4; Col++) {
+				if (Round != AES_ROUNDS)
+					T[Col] = AesMixWord(T[Col]);
+				S[Col] = T[Col] ^ W[4 * Round + Col];
+			}
 		}
-	}
-	else {
-		AesSubBytes(State); AesShiftRows(State);
-		AesAddRoundKey(State,&Key[40]);
-	}
 
-	// Copy the State to the output array.
-	Out[0] = State[0][0];
-	Out[1] = State[1][0];
-	Out[2] = State[2][0];
-	Out[3] = State[3][0];
-	Out[4] = State[0][1];
-	Out[5] = State[1][1];
-	Out[6] = State[2][1];
-	Out[7] = State[3][1];
-	Out[8] = State[0][2];
-	Out[9] = State[1][2];
-	Out[10] = State[2][2];
-	Out[11] = State[3][2];
-	Out[12] = State[0][3];
-	Out[13] = State[1][3];
-	Out[14] = State[2][3];
-	Out[15] = State[3][3];
+		for (Col = 0; Col < 4; Col++)
+			AesStore32(&Out[4 * Col], S[Col]);
+
+		In += AES_BLOCK_SIZE;
+		Out += AES_BLOCK_SIZE;
+	}
 }
 
 /*****************************************************************************/
 /**
 *
-* This function decrypts using AES.
+* This function decrypts one block in constant time.
 *
+* @param	W is the encryption key schedule.
 * @param	In is 16 bytes of ciphertext
 * @param	Out is 16 bytes of plaintext
-* @param	Key is from the key setup
-* @param	KeySize is the bit length of the key, 128, 192, or 256
 *
 * @return	None.
 *
-* @note		Key setup must be done before any AES en/de-cryption functions
-* 			can be used.
+* @note		None.
 *
 ******************************************************************************/
-static void AesDecrypt(const u8 In[], u8 Out[], const u32 Key[], int KeySize)
+static void AesDecrypt(const u32 W[], const u8 In[], u8 Out[])
 {
-	u8 State[4][4];
-
-	// Copy the input to the State.
-	State[0][0] = In[0];
-	State[1][0] = In[1];
-	State[2][0] = In[2];
-	State[3][0] = In[3];
-	State[0][1] = In[4];
-	State[1][1] = In[5];
-	State[2][1] = In[6];
-	State[3][1] = In[7];
-	State[0][2] = In[8];
-	State[1][2] = In[9];
-	State[2][2] = In[10];
-	State[3][2] = In[11];
-	State[0][3] = In[12];
-	State[1][3] = In[13];
-	State[2][3] = In[14];
-	State[3][3] = In[15];
-
-	// Perform the necessary number of rounds. The round key is added first.
-	// The last round does not perform the MixColumns step.
-	if (KeySize > 128) {
-		if (KeySize > 192) {
-			AesAddRoundKey(State,&Key[56]);
-			AesInvShiftRows(State);AesInvSubBytes(State);
-			AesAddRoundKey(State,&Key[52]);AesInvMixColumns(State);
-			AesInvShiftRows(State);AesInvSubBytes(State);
-			AesAddRoundKey(State,&Key[48]);AesInvMixColumns(State);
-		}
-		else {
-			AesAddRoundKey(State,&Key[48]);
+	u32 S[4], T[4];
+	int Round, Col;
+
+	for (Col = 0; Col < 4; Col++)
+		S[Col] = AesLoad32(&In[4 * Col]) ^ W[40 + Col];
+
+	for (Round = AES_ROUNDS - 1; Round >= 0; Round--) {
+		/* InvShiftRows: row r of column c comes from column c-r */
+		for (Col = 0; Col < 4; Col++)
+			T[Col] = (S[Col] & 0xFF000000) |
+			         (S[(Col + 3) & 3] & 0x00FF0000) |
+			         (S[(Col + 2) & 3] & 0x0000FF00) |
+			         (S[(Col + 1) & 3] & 0x000000FF);
+
+		/* InvSubBytes, AddRoundKey and InvMixColumns except in the
+		   last round */
+		for (Col = 0; Col < 4; Col++) {
+			S[Col] = AesCtInvSubWord(T[Col]) ^ W[4 * Round + Col];
+			if (Round != 0)
+				S[Col] = AesInvMixWord(S[Col]);
 		}
-		AesInvShiftRows(State);AesInvSubBytes(State);
-		AesAddRoundKey(State,&Key[44]);AesInvMixColumns(State);
-		AesInvShiftRows(State);AesInvSubBytes(State);
-		AesAddRoundKey(State,&Key[40]);AesInvMixColumns(State);
 	}
-	else {
-		AesAddRoundKey(State,&Key[40]);
-	}
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[36]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[32]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[28]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[24]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[20]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[16]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[12]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[8]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[4]);AesInvMixColumns(State);
-	AesInvShiftRows(State);AesInvSubBytes(State);
-	AesAddRoundKey(State,&Key[0]);
-
-	// Copy the State to the output array.
-	Out[0] = State[0][0];
-	Out[1] = State[1][0];
-	Out[2] = State[2][0];
-	Out[3] = State[3][0];
-	Out[4] = State[0][1];
-	Out[5] = State[1][1];
-	Out[6] = State[2][1];
-	Out[7] = State[3][1];
-	Out[8] = State[0][2];
-	Out[9] = State[1][2];
-	Out[10] = State[2][2];
-	Out[11] = State[3][2];
-	Out[12] = State[0][3];
-	Out[13] = State[1][3];
-	Out[14] = State[2][3];
-	Out[15] = State[3][3];
+
+	for (Col = 0; Col < 4; Col++)
+		AesStore32(&Out[4 * Col], S[Col]);
 }
+#endif
 
+#ifdef AES_CORE_ARMV8CE
+/*****************************************************************************/
+/**
+*
+* This function loads a round key into a vector in byte order.
+*
+* @param	W points to the 4 words of the round key.
+*
+* @return	The round key.
+*
+* @note		None.
+*
+******************************************************************************/
+static inline uint8x16_t AesCeLoadKey(const u32 *W)
+{
+	return vrev32q_u8(vreinterpretq_u8_u32(vld1q_u32(W)));
+}
 
-#ifdef AES_CIPHER_CTR_MODE
 /*****************************************************************************/
 /**
 *
-* This function encrypts using AES and a counter.
+* This function substitutes a word using AESE. With the word in all four
+* columns and a zero round key ShiftRows has no effect.
 *
-* @param	In is the plaintext
-* @param	InLen is any bytes length
-* @param	Out is is the ciphertext, same length as plaintext
-* @param	Key is from the key setup
-* @param	KeySize is the bit length of the key
-* @param	Iv must be AES_BLOCK_SIZE bytes long
+* @param	Word to substitute.
 *
-* @return	None.
+* @return	Transformation word.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesEncryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								  const u32 Key[], int KeySize, const u8 Iv[])
+static u32 AesSubWord(u32 Word)
 {
-	size_t Idx = 0, LastBlockLength;
-	u8 iv_buf[AES_BLOCK_SIZE], out_buf[AES_BLOCK_SIZE];
+	uint8x16_t State;
+	u32 Bytes;
 
-	if (In != Out)
-		memcpy(Out, In, InLen);
+	State = vreinterpretq_u8_u32(vdupq_n_u32(Word));
+	State = vaeseq_u8(State, vdupq_n_u8(0));
+	Bytes = vgetq_lane_u32(vreinterpretq_u32_u8(State), 0);
 
-	memcpy(iv_buf, Iv, AES_BLOCK_SIZE);
-	LastBlockLength = InLen - AES_BLOCK_SIZE;
+	/* The S-box works on single bytes, the byte order stays the same */
+	return Bytes;
+}
 
-	if (InLen > AES_BLOCK_SIZE) {
-		for (Idx = 0; Idx < LastBlockLength; Idx += AES_BLOCK_SIZE) {
-			AesEncrypt(iv_buf, out_buf, Key, KeySize);
-			Xor(&Out[Idx], out_buf, &Out[Idx], AES_BLOCK_SIZE);
-			AesIncrementIv(iv_buf, AES_BLOCK_SIZE);
+/*****************************************************************************/
+/**
+*
+* This function encrypts blocks with AESE and AESMC, four blocks at a time.
+*
+* @param	W is the key schedule.
+* @param	In is the plaintext of NumBlocks blocks.
+* @param	Out is the ciphertext of NumBlocks blocks.
+* @param	NumBlocks is the number of blocks.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void AesEncryptBlocks(const u32 W[], const u8 In[], u8 Out[], u32 NumBlocks)
+{
+	uint8x16_t Key[AES_ROUNDS + 1];
+	uint8x16_t B0, B1, B2, B3;
+	int Round;
+
+	for (Round = 0; Round <= AES_ROUNDS; Round++)
+		Key[Round] = AesCeLoadKey(&W[4 * Round]);
+
+	for (; NumBlocks >= 4; NumBlocks -= 4) {
+		B0 = vld1q_u8(&In[0]);
+		B1 = vld1q_u8(&In[16]);
+		B2 = vld1q_u8(&In[32]);
+		B3 = vld1q_u8(&In[48]);
+		for (Round = 0; Round < AES_ROUNDS - 1; Round++) {
+			B0 = vaesmcq_u8(vaeseq_u8(B0, Key[Round]));
+			B1 = vaesmcq_u8(vaeseq_u8(B1, Key[Round]));
+			B2 = vaesmcq_u8(vaeseq_u8(B2, Key[Round]));
+			B3 = vaesmcq_u8(vaeseq_u8(B3, Key[Round]));
 		}
+		vst1q_u8(&Out[0], veorq_u8(vaeseq_u8(B0, Key[9]), Key[10]));
+		vst1q_u8(&Out[16], veorq_u8(vaeseq_u8(B1, Key[9]), Key[10]));
+		vst1q_u8(&Out[32], veorq_u8(vaeseq_u8(B2, Key[9]), Key[10]));
+		vst1q_u8(&Out[48], veorq_u8(vaeseq_u8(B3, Key[9]), Key[10]));
+		In += 4 * AES_BLOCK_SIZE;
+		Out += 4 * AES_BLOCK_SIZE;
 	}
 
-	AesEncrypt(iv_buf, out_buf, Key, KeySize);
-	/* Use the Most Significant bytes. */
-	Xor(&Out[Idx], out_buf, &Out[Idx], InLen - Idx);
+	for (; NumBlocks > 0; NumBlocks--) {
+		B0 = vld1q_u8(In);
+		for (Round = 0; Round < AES_ROUNDS - 1; Round++)
+			B0 = vaesmcq_u8(vaeseq_u8(B0, Key[Round]));
+		vst1q_u8(Out, veorq_u8(vaeseq_u8(B0, Key[9]), Key[10]));
+		In += AES_BLOCK_SIZE;
+		Out += AES_BLOCK_SIZE;
+	}
 }
-#endif
 
-#ifdef AES_CIPHER_CTR_MODE
 /*****************************************************************************/
 /**
 *
-* This function does a AES-CTR decryption (is the same as encryption)
+* This function decrypts one block with AESD and AESIMC and the equivalent
+* inverse cipher.
 *
-* @param	In is the ciphertext
-* @param	InLen is any byte length
-* @param	Out is the ciphertext, same length as plaintext
-* @param	Key is from the key setup
-* @param	KeySize is the bit length of the key, 128, 192, or 256
-* @param	Iv must be AES_BLOCK_SIZE bytes long
+* @param	W is the encryption key schedule.
+* @param	In is 16 bytes of ciphertext
+* @param	Out is 16 bytes of plaintext
 *
 * @return	None.
 *
 * @note		None.
 *
 ******************************************************************************/
-static void AesDecryptCtr(const u8 In[], size_t InLen, u8 Out[],
-								 const u32 Key[], int KeySize, const u8 Iv[])
+static void AesDecrypt(const u32 W[], const u8 In[], u8 Out[])
 {
-	// CTR encryption is its own inverse function.
-	AesEncryptCtr(In, InLen, Out, Key, KeySize, Iv);
+	uint8x16_t State;
+	int Round;
+
+	State = vld1q_u8(In);
+	for (Round = AES_ROUNDS; Round > 1; Round--) {
+		State = vaesdq_u8(State, Round == AES_ROUNDS ?
+			AesCeLoadKey(&W[4 * Round]) :
+			vaesimcq_u8(AesCeLoadKey(&W[4 * Round])));
+		State = vaesimcq_u8(State);
+	}
+	State = vaesdq_u8(State, vaesimcq_u8(AesCeLoadKey(&W[4])));
+	vst1q_u8(Out, veorq_u8(State, AesCeLoadKey(&W[0])));
 }
 #endif
+
@@ -175,8 +175,11 @@ OPTIONS:
 1. define USE_64WITH32 to use 64-bit types on a 32-bit machine; or
 2. define USE_SPASM to use Intel ASM (32-bit Intel compilers with __asm support); or
 3. use default "long" calculations (any platform)
+The 64-bit routines of option 1 are also used with BIGD_KERNEL_LIMB64,
+which implies a 64-bit machine.
 */
 
+#if defined(USE_64WITH32) || defined(BIGD_KERNEL_LIMB64)
 #ifdef USE_64WITH32
 /* 1. We are on a 32-bit machine with a 64-bit type available. */
 #pragma message("USE_64WITH32 is set")
@@ -187,6 +190,7 @@ typedef unsigned __int64 uint64_t;
 #elif !defined(HAVE_C99INCLUDES) && !defined(HAVE_SYS_TYPES)
 typedef unsigned long long int uint64_t;
 #endif
+#endif
 
 int spMultiply(uint32_t p[2], uint32_t x, uint32_t y)
 {
@@ -581,8 +585,227 @@ u32 mpSubtract(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 	return k;	/* Should be zero if u >= v */
 }
 
+/* PRODUCT SCANNING (COMBA) KERNELS */
+/*	Column k of the product sums all u_i * v_j with i + j = k into a three-word
+	accumulator (acc, hi), stores the low word in w_k and shifts the accumulator
+	down by one word. Each w_k is written once and there is no carry chain
+	through w[] as in Algorithm M. A square sums each u_i * u_j with i < j once
+	and doubles the column before adding the diagonal term u_{k/2}^2.
+	The 64-bit limb versions read and write the u32 arrays two digits at a time,
+	so they need an even ndigits.
+	mpRedc32 and mpRedc64 are the Montgomery reductions used by the mpMont functions.
+*/
+#ifndef BIGD_KERNEL_SCHOOLBOOK
+static void mpMultComba32(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
+{	/*	Computes w = u * v, w is 2*ndigits long */
+	uint64_t acc, p;
+	u32 hi;
+	size_t i, k, lo, top;
+
+	acc = 0;
+	for (k = 0; k < 2 * ndigits - 1; k++)
+	{
+		lo = (k < ndigits) ? 0 : k - ndigits + 1;
+		top = (k < ndigits) ? k : ndigits - 1;
+		hi = 0;
+		for (i = lo; i <= top; i++)
+		{
+			p = (uint64_t)u[i] * v[k-i];
+			acc += p;
+			hi += (acc < p);
+		}
+		w[k] = (u32)acc;
+		acc = (acc >> 32) | ((uint64_t)hi << 32);
+	}
+	w[k] = (u32)acc;
+}
+
+static void mpSqrComba32(u32 w[], const u32 x[], size_t ndigits)
+{	/*	Computes w = x * x, w is 2*ndigits long */
+	uint64_t acc, sum, p;
+	u32 hi, shi;
+	size_t i, k, lo;
+
+	acc = 0;
+	for (k = 0; k < 2 * ndigits - 1; k++)
+	{
+		lo = (k < ndigits) ? 0 : k - ndigits + 1;
+		/* sum = 2 * (sum of x_i * x_{k-i} for i < k-i) */
+		sum = 0;
+		shi = 0;
+		for (i = lo; i < k - i; i++)
+		{
+			p = (uint64_t)x[i] * x[k-i];
+			sum += p;
+			shi += (sum < p);
+		}
+		shi = (shi << 1) | (u32)(sum >> 63);
+		sum <<= 1;
+		if (ISEVEN(k))
+		{
+			p = (uint64_t)x[k/2] * x[k/2];
+			sum += p;
+			shi += (sum < p);
+		}
+		acc += sum;
+		hi = shi + (acc < sum);
+		w[k] = (u32)acc;
+		acc = (acc >> 32) | ((uint64_t)hi << 32);
+	}
+	w[k] = (u32)acc;
+}
+#endif /* !BIGD_KERNEL_SCHOOLBOOK */
+
+static void mpRedc32(u32 a[], u32 t[], const u32 m[], u32 minv, size_t ndigits)
+{	/*	Computes a = t * 2^(-32*ndigits) mod m, t is 2*ndigits long and is overwritten.
+		Ref: Menezes p600 Algorithm 14.32.
+	*/
+	uint64_t p;
+	u32 q, c, top;
+	size_t i, j;
+
+	top = 0;
+	for (i = 0; i < ndigits; i++)
+	{
+		/* t = t + q * m * b^i clears t_i */
+		q = t[i] * minv;
+		c = 0;
+		for (j = 0; j < ndigits; j++)
+		{
+			p = (uint64_t)q * m[j] + t[i+j] + c;
+			t[i+j] = (u32)p;
+			c = (u32)(p >> 32);
+		}
+		/* top is the carry out of t_{i+n} from the previous round */
+		p = (uint64_t)t[i+ndigits] + c + top;
+		t[i+ndigits] = (u32)p;
+		top = (u32)(p >> 32);
+	}
+
+	if (top || mpCompare(&t[ndigits], m, ndigits) >= 0)
+		mpSubtract(a, &t[ndigits], m, ndigits);
+	else
+		mpSetEqual(a, &t[ndigits], ndigits);
+}
+
+#ifdef BIGD_KERNEL_LIMB64
+typedef unsigned __int128 dlimb_t;
+
+/* Limb i of a u32 array, the two digits are combined into a single load on little-endian targets */
+#define LIMB64(a, i) ((uint64_t)(a)[2*(i)] | ((uint64_t)(a)[2*(i)+1] << 32))
+#define SETLIMB64(a, i, x) do{(a)[2*(i)]=(u32)(x);(a)[2*(i)+1]=(u32)((x) >> 32);}while(0)
+
+static void mpMultComba64(u32 w[], const u32 u[], const u32 v[], size_t nlimbs)
+{	/*	Computes w = u * v on 64-bit limbs, w is 2*nlimbs limbs long */
+	dlimb_t acc, p;
+	uint64_t hi;
+	size_t i, k, lo, top;
+
+	acc = 0;
+	for (k = 0; k < 2 * nlimbs - 1; k++)
+	{
+		lo = (k < nlimbs) ? 0 : k - nlimbs + 1;
+		top = (k < nlimbs) ? k : nlimbs - 1;
+		hi = 0;
+		for (i = lo; i <= top; i++)
+		{
+			p = (dlimb_t)LIMB64(u, i) * LIMB64(v, k-i);
+			acc += p;
+			hi += (acc < p);
+		}
+		SETLIMB64(w, k, (uint64_t)acc);
+		acc = (acc >> 64) | ((dlimb_t)hi << 64);
+	}
+	SETLIMB64(w, k, (uint64_t)acc);
+}
+
+static void mpSqrComba64(u32 w[], const u32 x[], size_t nlimbs)
+{	/*	Computes w = x * x on 64-bit limbs, w is 2*nlimbs limbs long */
+	dlimb_t acc, sum, p;
+	uint64_t hi, shi, xi;
+	size_t i, k, lo;
+
+	acc = 0;
+	for (k = 0; k < 2 * nlimbs - 1; k++)
+	{
+		lo = (k < nlimbs) ? 0 : k - nlimbs + 1;
+		sum = 0;
+		shi = 0;
+		for (i = lo; i < k - i; i++)
+		{
+			p = (dlimb_t)LIMB64(x, i) * LIMB64(x, k-i);
+			sum += p;
+			shi += (sum < p);
+		}
+		shi = (shi << 1) | (uint64_t)(sum >> 127);
+		sum <<= 1;
+		if (ISEVEN(k))
+		{
+			xi = LIMB64(x, k/2);
+			p = (dlimb_t)xi * xi;
+			sum += p;
+			shi += (sum < p);
+		}
+		acc += sum;
+		hi = shi + (acc < sum);
+		SETLIMB64(w, k, (uint64_t)acc);
+		acc = (acc >> 64) | ((dlimb_t)hi << 64);
+	}
+	SETLIMB64(w, k, (uint64_t)acc);
+}
+
+static void mpRedc64(u32 a[], u32 t[], const u32 m[], uint64_t minv, size_t nlimbs)
+{	/*	Computes a = t * 2^(-64*nlimbs) mod m on 64-bit limbs, as mpRedc32 */
+	dlimb_t p;
+	uint64_t q, c, top;
+	size_t i, j, ndigits = 2 * nlimbs;
+
+	top = 0;
+	for (i = 0; i < nlimbs; i++)
+	{
+		q = LIMB64(t, i) * minv;
+		c = 0;
+		for (j = 0; j < nlimbs; j++)
+		{
+			p = (dlimb_t)q * LIMB64(m, j) + LIMB64(t, i+j) + c;
+			SETLIMB64(t, i+j, (uint64_t)p);
+			c = (uint64_t)(p >> 64);
+		}
+		p = (dlimb_t)LIMB64(t, i+nlimbs) + c + top;
+		SETLIMB64(t, i+nlimbs, (uint64_t)p);
+		top = (uint64_t)(p >> 64);
+	}
+
+	if (top || mpCompare(&t[ndigits], m, ndigits) >= 0)
+		mpSubtract(a, &t[ndigits], m, ndigits);
+	else
+		mpSetEqual(a, &t[ndigits], ndigits);
+}
+#endif /* BIGD_KERNEL_LIMB64 */
+
 int mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 {
+#ifndef BIGD_KERNEL_SCHOOLBOOK
+	/*	Computes product w = u * v
+		where u, v are multiprecision integers of ndigits each
+		and w is a multiprecision integer of 2*ndigits
+		using the product scanning kernel chosen in bigdigits.h
+	*/
+	assert(w != u && w != v);
+
+	if (ndigits == 0)
+		return 0;
+#ifdef BIGD_KERNEL_LIMB64
+	if (ISEVEN(ndigits))
+	{
+		mpMultComba64(w, u, v, ndigits / 2);
+		return 0;
+	}
+#endif
+	mpMultComba32(w, u, v, ndigits);
+
+	return 0;
+#else
 	/*	Computes product w = u * v
 		where u, v are multiprecision integers of ndigits each
 		and w is a multiprecision integer of 2*ndigits
@@ -634,6 +857,7 @@ int mpMultiply(u32 w[], const u32 u[], const u32 v[], size_t ndigits)
 	}	/* Step M6. Loop on j */
 
 	return 0;
+#endif /* BIGD_KERNEL_SCHOOLBOOK */
 }
 
 /* mpDivide */
@@ -849,6 +1073,27 @@ int mpDivide(u32 q[], u32 r[], const u32 u[],
 int mpSquare(u32 w[], const u32 x[], size_t ndigits)
 /* New in Version 2.0 */
 {
+#ifndef BIGD_KERNEL_SCHOOLBOOK
+	/*	Computes square w = x * x
+		where x is a multiprecision integer of ndigits
+		and w is a multiprecision integer of 2*ndigits
+		using the product scanning kernel chosen in bigdigits.h
+	*/
+	assert(w != x);
+
+	if (ndigits == 0)
+		return 0;
+#ifdef BIGD_KERNEL_LIMB64
+	if (ISEVEN(ndigits))
+	{
+		mpSqrComba64(w, x, ndigits / 2);
+		return 0;
+	}
+#endif
+	mpSqrComba32(w, x, ndigits);
+
+	return 0;
+#else
 	/*	Computes square w = x * x
 		where x is a multiprecision integer of ndigits
 		and w is a multiprecision integer of 2*ndigits
@@ -953,6 +1198,7 @@ int mpSquare(u32 w[], const u32 x[], size_t ndigits)
 	/* Return w */
 
 	return 0;
+#endif /* BIGD_KERNEL_SCHOOLBOOK */
 }
 
 /** Returns true if a == b, else false. Not constant-time. */
@@ -1763,6 +2009,100 @@ int mpModMult(u32 a[], const u32 x[], const u32 y[],
 	return 0;
 }
 
+/***************************/
+/* MONTGOMERY ARITHMETIC   */
+/***************************/
+int mpMontInit(MP_MONT_CTX *ctx, const u32 m[], size_t ndigits)
+{	/*	Sets up the Montgomery context for the odd modulus m */
+	u32 t[MAX_MONT_DIGITS * 2];
+	u32 q[MAX_MONT_DIGITS * 2];
+	u32 r[MAX_MONT_DIGITS * 2];
+	uint64_t m0, x;
+	int i;
+
+	if (ndigits == 0 || ndigits > MAX_MONT_DIGITS || mpISEVEN(m, ndigits))
+		return -1;
+
+	ctx->ndigits = ndigits;
+	mpSetEqual(ctx->m, m, ndigits);
+
+	/*	minv = -m^{-1} mod 2^64 by Newton iteration x = x(2 - m0 x),
+		starting with x = m0, which is m0^{-1} mod 2^3 for odd m0.
+		Each step doubles the number of correct bits.
+	*/
+	m0 = m[0];
+	if (ndigits > 1)
+		m0 |= (uint64_t)m[1] << 32;
+	x = m0;
+	for (i = 0; i < 5; i++)
+		x *= 2 - m0 * x;
+	ctx->minv = (uint64_t)0 - x;
+
+	/* rr = R^2 mod m, with R mod m = b^n mod m first */
+	mpSetZero(t, ndigits + 1);
+	t[ndigits] = 1;
+	mpDivide(q, r, t, ndigits + 1, ctx->m, ndigits);
+	mpSquare(t, r, ndigits);
+	mpDivide(q, r, t, ndigits * 2, ctx->m, ndigits);
+	mpSetEqual(ctx->rr, r, ndigits);
+
+	mpSetZero(t, ndigits * 2);
+	mpSetZero(q, ndigits * 2);
+	mpSetZero(r, ndigits * 2);
+
+	return 0;
+}
+
+int mpMontRedc(u32 a[], u32 t[], const MP_MONT_CTX *ctx)
+{	/*	Computes a = t * R^{-1} mod m */
+#ifdef BIGD_KERNEL_LIMB64
+	if (ISEVEN(ctx->ndigits))
+	{
+		mpRedc64(a, t, ctx->m, ctx->minv, ctx->ndigits / 2);
+		return 0;
+	}
+#endif
+	mpRedc32(a, t, ctx->m, (u32)ctx->minv, ctx->ndigits);
+
+	return 0;
+}
+
+int mpMontMult(u32 a[], const u32 x[], const u32 y[], const MP_MONT_CTX *ctx)
+{	/*	Computes a = x * y * R^{-1} mod m */
+	u32 t[MAX_MONT_DIGITS * 2];
+
+	mpMultiply(t, x, y, ctx->ndigits);
+	mpMontRedc(a, t, ctx);
+
+	return 0;
+}
+
+int mpMontSquare(u32 a[], const u32 x[], const MP_MONT_CTX *ctx)
+{	/*	Computes a = x * x * R^{-1} mod m */
+	u32 t[MAX_MONT_DIGITS * 2];
+
+	mpSquare(t, x, ctx->ndigits);
+	mpMontRedc(a, t, ctx);
+
+	return 0;
+}
+
+int mpMontToMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx)
+{	/*	Computes a = x * R mod m = MontMult(x, R^2). Any x < R is fine. */
+	return mpMontMult(a, x, ctx->rr, ctx);
+}
+
+int mpMontFromMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx)
+{	/*	Computes a = x * R^{-1} mod m = MontMult(x, 1) */
+	u32 t[MAX_MONT_DIGITS * 2];
+
+	mpSetEqual(t, x, ctx->ndigits);
+	mpSetZero(&t[ctx->ndigits], ctx->ndigits);
+	mpMontRedc(a, t, ctx);
+
+	return 0;
+}
+
 int mpModInv(u32 inv[], const u32 u[], const u32 v[], size_t ndigits)
 {	/*	Computes inv = u^(-1) mod v */
 	/*	Ref: Knuth Algorithm X Vol 2 p 342
@@ -2648,6 +2988,98 @@ done:
 
 
 
+/* Bit ibit of a, as mpGetBit for a const array */
+#define mpTESTBIT(a, ibit) (((a)[(ibit) / BITS_PER_DIGIT] >> ((ibit) % BITS_PER_DIGIT)) & 0x1)
+
+/* Computes y = x^e mod m in Montgomery arithmetic using sliding-window exponentiation */
+int mpMontExp(u32 y[], const u32 x[], const u32 e[], const MP_MONT_CTX *ctx)
+{
+	/*	Ref: Menezes p616 Algorithm 14.85 with Montgomery multiplication.
+		g[i] holds x^(2i+1) in Montgomery form. The window length is the
+		one with the fewest multiplications for the size of e, at most
+		MONT_MAX_WINDOW, so a short public exponent such as 3 or 65537
+		uses plain square and multiply.
+	*/
+	u32 g[1 << (MONT_MAX_WINDOW - 1)][MAX_MONT_DIGITS];
+	u32 a[MAX_MONT_DIGITS];
+	size_t n = ctx->ndigits;
+	size_t nbits, winlen, ngt, cost, best, i, j, k;
+	u32 wval;
+	int started;
+
+	nbits = mpBitLength(e, n);
+	if (nbits == 0)
+	{	/* x^0 = 1 */
+		mpSetDigit(y, 1, n);
+		return 0;
+	}
+
+	/* Precomputation 2^(k-1) plus one multiplication per window of about k+1 bits */
+	winlen = 1;
+	best = nbits / 2;
+	for (k = 2; k <= MONT_MAX_WINDOW; k++)
+	{
+		cost = ((size_t)1 << (k - 1)) + nbits / (k + 1);
+		if (cost < best)
+		{
+			best = cost;
+			winlen = k;
+		}
+	}
+
+	/* g[0] = xR, g[i] = g[i-1] * x^2 */
+	mpMontToMont(g[0], x, ctx);
+	ngt = (size_t)1 << (winlen - 1);
+	if (ngt > 1)
+	{
+		mpMontSquare(a, g[0], ctx);
+		for (i = 1; i < ngt; i++)
+			mpMontMult(g[i], g[i-1], a, ctx);
+	}
+
+	/* Scan e from the most significant bit, i is the number of bits left */
+	started = 0;
+	i = nbits;
+	while (i > 0)
+	{
+		if (!mpTESTBIT(e, i - 1))
+		{
+			mpMontSquare(a, a, ctx);
+			i--;
+			continue;
+		}
+
+		/* The window is bits i-1 down to j of e and ends with a '1' bit */
+		j = (i > winlen) ? i - winlen : 0;
+		while (!mpTESTBIT(e, j))
+			j++;
+		wval = 0;
+		for (k = i; k > j; k--)
+			wval = (wval << 1) | mpTESTBIT(e, k - 1);
+
+		if (started)
+		{
+			for (k = j; k < i; k++)
+				mpMontSquare(a, a, ctx);
+			mpMontMult(a, a, g[wval >> 1], ctx);
+		}
+		else
+		{
+			mpSetEqual(a, g[wval >> 1], n);
+			started = 1;
+		}
+		i = j;
+	}
+
+	mpMontFromMont(y, a, ctx);
+
+	mpSetZero(a, n);
+	for (i = 0; i < ngt; i++)
+		mpSetZero(g[i], n);
+
+	return 0;
+}
+
 /* Use sliding window alternative only if NO_ALLOCS not defined */
 #ifndef NO_ALLOCS
 
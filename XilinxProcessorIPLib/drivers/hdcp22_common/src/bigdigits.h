@@ -72,6 +72,33 @@ typedef uint16_t HALF_DIGIT_T;
    The USE_SPASM option takes precedence over USE_64WITH32.
 */
 
+/*
+   Choose one of {BIGD_KERNEL_LIMB64 | BIGD_KERNEL_COMBA | BIGD_KERNEL_SCHOOLBOOK}
+   for mpMultiply, mpSquare and the mpMont functions.
+   BIGD_KERNEL_LIMB64: product scanning (Comba) on 64-bit limbs with 128-bit products,
+     needs unsigned __int128 (e.g. AArch64). Falls back to BIGD_KERNEL_COMBA for an odd ndigits.
+   BIGD_KERNEL_COMBA: product scanning (Comba) on 32-bit digits with 64-bit products.
+   BIGD_KERNEL_SCHOOLBOOK: the original Knuth Algorithm M and Menezes 14.16 routines.
+   Default: BIGD_KERNEL_LIMB64 if the compiler has __int128, else BIGD_KERNEL_COMBA.
+   The digit type and the mp interface are the same for all kernels.
+*/
+#if !defined(BIGD_KERNEL_LIMB64) && !defined(BIGD_KERNEL_COMBA) && !defined(BIGD_KERNEL_SCHOOLBOOK)
+#ifdef __SIZEOF_INT128__
+#define BIGD_KERNEL_LIMB64
+#else
+#define BIGD_KERNEL_COMBA
+#endif
+#endif
+
+/* Largest modulus supported by the mpMont functions */
+#ifdef NO_ALLOCS
+#define MAX_MONT_DIGITS MAX_FIXED_DIGITS
+#else
+#define MAX_MONT_DIGITS (4096 / BITS_PER_DIGIT)
+#endif
+/* Largest window of mpMontExp, its table takes 2^(MONT_MAX_WINDOW-1) * MAX_MONT_DIGITS digits of stack */
+#define MONT_MAX_WINDOW 3
+
 /* Useful macros */
 #define ISODD(x) ((x) & 0x1)
 #define ISEVEN(x) (!ISODD(x))
@@ -207,6 +234,46 @@ int mpModExp_ct(u32 yout[], const u32 x[], const u32 e[], u32 m[], size_t ndigit
 /** Computes a = (x * y) mod m */
 int mpModMult(u32 a[], const u32 x[], const u32 y[], u32 m[], size_t ndigits);
 
+/* Montgomery arithmetic modulo an odd m, with R = 2^(BITS_PER_DIGIT * ndigits).
+ * The context is set up once per modulus by mpMontInit(). mpMontMult, mpMontSquare
+ * and mpMontRedc work on numbers in Montgomery form xR mod m, which mpMontToMont and
+ * mpMontFromMont convert to and from. mpMontExp takes and returns ordinary numbers.
+ * None of these functions use mpDivide, except mpMontInit to compute R^2 mod m.
+ * Not constant-time: use for public exponents only.
+ */
+
+/** Montgomery context for an odd modulus */
+typedef struct
+{
+	u32 m[MAX_MONT_DIGITS];		/**< Modulus m */
+	u32 rr[MAX_MONT_DIGITS];	/**< R^2 mod m */
+	uint64_t minv;			/**< -m^{-1} mod 2^64 */
+	size_t ndigits;			/**< Size of m in digits */
+} MP_MONT_CTX;
+
+/** Sets up `ctx` for modulus `m` of `ndigits`, returns -1 if m is even or too long, else 0 */
+int mpMontInit(MP_MONT_CTX *ctx, const u32 m[], size_t ndigits);
+
+/** Computes a = t * R^{-1} mod m, where t is 2 x ndigits long and t < mR.
+@remark `t` is overwritten.
+*/
+int mpMontRedc(u32 a[], u32 t[], const MP_MONT_CTX *ctx);
+
+/** Computes a = x * y * R^{-1} mod m, a may overlap x or y */
+int mpMontMult(u32 a[], const u32 x[], const u32 y[], const MP_MONT_CTX *ctx);
+
+/** Computes a = x^2 * R^{-1} mod m, a may overlap x */
+int mpMontSquare(u32 a[], const u32 x[], const MP_MONT_CTX *ctx);
+
+/** Computes a = x * R mod m, the Montgomery form of x */
+int mpMontToMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx);
+
+/** Computes a = x * R^{-1} mod m, the ordinary form of x */
+int mpMontFromMont(u32 a[], const u32 x[], const MP_MONT_CTX *ctx);
+
+/** Computes y = x^e mod m, where x, e and y are ndigits long */
+int mpMontExp(u32 y[], const u32 x[], const u32 e[], const MP_MONT_CTX *ctx);
+
 /** Computes the inverse of `u` modulo `m`, inv = u^{-1} mod m */
 int mpModInv(u32 inv[], const u32 u[], const u32 m[], size_t ndigits);
 
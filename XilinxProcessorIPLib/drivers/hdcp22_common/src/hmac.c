@@ -38,6 +38,9 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00  MH   10/30/15 First Release
+* 2.00  agt  10/17/26 Added HMAC key contexts with precomputed ipad/opad
+*                     states. XHdcp22Cmn_HmacSha256Hash streams the data
+*                     and no longer limits its size.
 *</pre>
 *
 *****************************************************************************/
@@ -57,6 +60,9 @@
 
 /************************** Function Prototypes ******************************/
 
+static void XHdcp22Cmn_HmacSha256Resume(XHdcp22Cmn_Sha256Ctx *Ctx,
+                                        const u32 *State);
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Definitions *****************************/
@@ -78,58 +84,129 @@
 * @param	HashedData is the output of this function.
 *
 * @return	- XST_SUCCESS if no errors occured
-*			- XST_FAILURE if the datasize execeeds the size of the local buffer.
 *
-* @note		None.
+* @note		Use XHdcp22Cmn_HmacSha256SetKey and XHdcp22Cmn_HmacSha256Mac
+*		when several HMACs are computed with the same key.
 *
 ******************************************************************************/
 int XHdcp22Cmn_HmacSha256Hash(const u8 *Data, int DataSize, const u8 *Key, int KeySize, u8  *HashedData)
 {
-	u8 Ipad[65];   /* inner padding-key XORd with ipad */
-	u8 Opad[65];   /* outer padding-key XORd with opad */
-	u8 Ktemp[SHA256_SIZE];
-	u8 Ktemp2[SHA256_SIZE];
-	u8 BufferIn[256];
-	u8 BufferOut[256];
-	int i;
+	XHdcp22Cmn_HmacSha256Ctx HmacCtx;
 
-	memset(BufferIn, 0x00, 256);
-	memset(BufferOut, 0x00, 256);
+	XHdcp22Cmn_HmacSha256SetKey(&HmacCtx, Key, KeySize);
+	XHdcp22Cmn_HmacSha256Mac(&HmacCtx, Data, DataSize, HashedData);
 
-	/* If the input size exceeds the local buffers, return an error */
-	if(DataSize + 64 >  256) {
-		return XST_FAILURE;
-	}
+	/* Clear the key material from the stack */
+	memset(&HmacCtx, 0x00, sizeof(HmacCtx));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up a HMAC_SHA256 key context. It compresses the blocks
+* (K XOR ipad) and (K XOR opad) and keeps the resulting SHA256 states.
+*
+* @param	HmacCtx is the key context to set up.
+* @param	Key is the hash-key to use.
+* @param	KeySize is the size of the hash key.
+*
+* @return	None.
+*
+* @note		The context holds key material, clear it when it is no
+*		longer used.
+*
+******************************************************************************/
+void XHdcp22Cmn_HmacSha256SetKey(XHdcp22Cmn_HmacSha256Ctx *HmacCtx, const u8 *Key, int KeySize)
+{
+	XHdcp22Cmn_Sha256Ctx Ctx;
+	u8 Pad[XHDCP22_CMN_SHA256_BLOCK_SIZE];
+	u8 Ktemp[SHA256_SIZE];
+	int i;
 
 	/* If key is longer than 64 bytes reset it to Key=sha256(Key) */
-	if(KeySize > 64) {
-		XHdcp22Cmn_Sha256Hash(Key, KeySize, Ktemp );
+	if(KeySize > XHDCP22_CMN_SHA256_BLOCK_SIZE) {
+		XHdcp22Cmn_Sha256Hash(Key, KeySize, Ktemp);
 		Key     = Ktemp;
 		KeySize = SHA256_SIZE;
 	}
 
-	/* start out by storing Key in pads */
-	memset(Ipad, 0, sizeof Ipad );
-	memset(Opad, 0, sizeof Opad );
-	memcpy(Ipad, Key, KeySize );
-	memcpy(Opad, Key, KeySize );
-
-	/* XOR Key with Ipad and Opad values */
-	for(i = 0; i < 64; i++) {
-		Ipad[i] ^= 0x36;
-		Opad[i] ^= 0x5c;
+	/* Inner state: compress Key XOR ipad */
+	memset(Pad, 0x36, sizeof(Pad));
+	for(i = 0; i < KeySize; i++) {
+		Pad[i] ^= Key[i];
 	}
+	XHdcp22Cmn_Sha256Init(&Ctx);
+	XHdcp22Cmn_Sha256Update(&Ctx, Pad, sizeof(Pad));
+	memcpy(HmacCtx->InnerState, Ctx.State, sizeof(HmacCtx->InnerState));
+
+	/* Outer state: compress Key XOR opad */
+	memset(Pad, 0x5c, sizeof(Pad));
+	for(i = 0; i < KeySize; i++) {
+		Pad[i] ^= Key[i];
+	}
+	XHdcp22Cmn_Sha256Init(&Ctx);
+	XHdcp22Cmn_Sha256Update(&Ctx, Pad, sizeof(Pad));
+	memcpy(HmacCtx->OuterState, Ctx.State, sizeof(HmacCtx->OuterState));
+
+	/* Clear the key material from the stack */
+	memset(Pad, 0x00, sizeof(Pad));
+	memset(Ktemp, 0x00, sizeof(Ktemp));
+	memset(&Ctx, 0x00, sizeof(Ctx));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function computes a HMAC_SHA256 with a key context set up by
+* XHdcp22Cmn_HmacSha256SetKey. The inner and outer hashes resume from the
+* stored states, so only the data and the inner hash are compressed.
+*
+* @param	HmacCtx is the key context.
+* @param	Data is the input data.
+* @param	DataSize is the size of the data buffer.
+* @param	HashedData is the output of this function.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XHdcp22Cmn_HmacSha256Mac(const XHdcp22Cmn_HmacSha256Ctx *HmacCtx, const u8 *Data, int DataSize, u8 *HashedData)
+{
+	XHdcp22Cmn_Sha256Ctx Ctx;
+	u8 InnerHash[SHA256_SIZE];
 
 	/* Execute inner SHA256 */
-	memcpy(BufferIn, Ipad, 64 );
-	memcpy(BufferIn + 64, Data, DataSize );
-	XHdcp22Cmn_Sha256Hash(BufferIn, 64 + DataSize, Ktemp2 );
+	XHdcp22Cmn_HmacSha256Resume(&Ctx, HmacCtx->InnerState);
+	XHdcp22Cmn_Sha256Update(&Ctx, Data, DataSize);
+	XHdcp22Cmn_Sha256Final(&Ctx, InnerHash);
 
 	/* Execute outer SHA256 */
-	memcpy(BufferOut, Opad, 64);
-	memcpy(BufferOut + 64, Ktemp2, SHA256_SIZE );
-	XHdcp22Cmn_Sha256Hash(BufferOut, 64 + SHA256_SIZE,
-						(u8 *)HashedData );
+	XHdcp22Cmn_HmacSha256Resume(&Ctx, HmacCtx->OuterState);
+	XHdcp22Cmn_Sha256Update(&Ctx, InnerHash, SHA256_SIZE);
+	XHdcp22Cmn_Sha256Final(&Ctx, HashedData);
+}
 
-	return XST_SUCCESS;
+/*****************************************************************************/
+/**
+*
+* This function sets a SHA256 context to the state after one block of
+* padded key, as stored in a HMAC key context.
+*
+* @param	Ctx is the SHA256 context.
+* @param	State is the inner or outer state of a HMAC key context.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XHdcp22Cmn_HmacSha256Resume(XHdcp22Cmn_Sha256Ctx *Ctx,
+                                        const u32 *State)
+{
+	memcpy(Ctx->State, State, sizeof(Ctx->State));
+	Ctx->BufferLen = 0;
+	Ctx->Length = XHDCP22_CMN_SHA256_BLOCK_SIZE;
 }
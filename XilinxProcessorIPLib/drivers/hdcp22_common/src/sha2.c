@@ -31,12 +31,28 @@
 *
 * This file contains the implementation of the SHA-2 Secure Hashing Algorithm.
 *
+* The hash can be computed in one call with XHdcp22Cmn_Sha256Hash or
+* streamed with XHdcp22Cmn_Sha256Init, XHdcp22Cmn_Sha256Update and
+* XHdcp22Cmn_Sha256Final. Whole 64-byte blocks are compressed straight
+* from the input buffer, only a partial block is copied into the context.
+*
+* The block compression is selected at build time:
+* - ARMv8 Cryptography Extensions (SHA256H, SHA256H2, SHA256SU0 and
+*   SHA256SU1) if the compiler targets them, e.g. -march=armv8-a+crypto
+*   for the Cortex-A53.
+* - NEON message schedule with scalar rounds if only NEON is available.
+* - Portable C otherwise, e.g. for the Cortex-R5 and MicroBlaze.
+* Define XHDCP22_CMN_SHA256_GENERIC to force the portable C code.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00  MH   10/30/15 First Release
+* 2.00  agt  10/17/26 Added streaming interface and multi-block
+*                     compression with ARMv8 Crypto Extension and NEON
+*                     implementations.
 *</pre>
 *
 *****************************************************************************/
@@ -44,19 +60,24 @@
 /***************************** Include Files ********************************/
 #include "string.h"
 #include "xil_types.h"
+#include "xhdcp22_common.h"
+
+/************************** Constant Definitions ****************************/
+#if defined(XHDCP22_CMN_SHA256_GENERIC)
+#define SHA256_CORE_GENERIC
+#elif defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define SHA256_CORE_ARMV8CE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SHA256_CORE_NEON
+#else
+#define SHA256_CORE_GENERIC
+#endif
 
-/**************************** Type Definitions ******************************/
-typedef struct {
-   u8 data[64];
-   u32 datalen;
-   u32 bitlen[2];
-   u32 state[8];
-} Sha256Type;
+#ifndef SHA256_CORE_GENERIC
+#include <arm_neon.h>
+#endif
 
 /***************** Macros (Inline Functions) Definitions ********************/
-// DBL_INT_ADD treats two unsigned ints a and b as one 64-bit integer and adds c to it
-#define DBL_INT_ADD(a,b,c) if (a > 0xffffffff - (c)) ++b; a += c;
-#define ROTLEFT(a,b) (((a) << (b)) | ((a) >> (32-(b))))
 #define ROTRIGHT(a,b) (((a) >> (b)) | ((a) << (32-(b))))
 
 #define CH(x,y,z) (((x) & (y)) ^ (~(x) & (z)))
@@ -66,6 +87,24 @@ typedef struct {
 #define SIG0(x) (ROTRIGHT(x,7) ^ ROTRIGHT(x,18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x,17) ^ ROTRIGHT(x,19) ^ ((x) >> 10))
 
+// One round, wk is the message word plus the round constant.
+// The callers rotate the names of a..h instead of moving the values.
+#define SHA256_RND(a,b,c,d,e,f,g,h,wk) \
+   t1 = (h) + EP1(e) + CH(e,f,g) + (wk); \
+   (d) += t1; \
+   (h) = t1 + EP0(a) + MAJ(a,b,c)
+
+// Eight rounds starting at round i, WK(i) gives the message word plus constant.
+#define SHA256_RND8(i,WK) \
+   SHA256_RND(a,b,c,d,e,f,g,h,WK((i)+0)); \
+   SHA256_RND(h,a,b,c,d,e,f,g,WK((i)+1)); \
+   SHA256_RND(g,h,a,b,c,d,e,f,WK((i)+2)); \
+   SHA256_RND(f,g,h,a,b,c,d,e,WK((i)+3)); \
+   SHA256_RND(e,f,g,h,a,b,c,d,WK((i)+4)); \
+   SHA256_RND(d,e,f,g,h,a,b,c,WK((i)+5)); \
+   SHA256_RND(c,d,e,f,g,h,a,b,WK((i)+6)); \
+   SHA256_RND(b,c,d,e,f,g,h,a,WK((i)+7))
+
 /************************** Variable Definitions ****************************/
 static const u32 k[64] = {
    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
@@ -78,13 +117,14 @@ static const u32 k[64] = {
    0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
 };
 
+static const u32 Sha256InitState[8] = {
+   0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
 /************************** Function Prototypes *****************************/
 
 /* SHA-256 Hashing */
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data);
-static void Sha256Init(Sha256Type *Ctx);
-static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len);
-static void Sha256Final(Sha256Type *Ctx, u8 *Hash);
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 NumBlocks);
 
 /************************** Function Implementation *****************************/
 
@@ -104,177 +144,361 @@ static void Sha256Final(Sha256Type *Ctx, u8 *Hash);
 ******************************************************************************/
 void XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData)
 {
-	Sha256Type Ctx;
+	XHdcp22Cmn_Sha256Ctx Ctx;
 
-	Sha256Init(&Ctx);
+	XHdcp22Cmn_Sha256Init(&Ctx);
 
-	Sha256Update(&Ctx, Data, DataSize);
-	Sha256Final(&Ctx, HashedData);
+	XHdcp22Cmn_Sha256Update(&Ctx, Data, DataSize);
+	XHdcp22Cmn_Sha256Final(&Ctx, HashedData);
 }
 
 /*****************************************************************************/
 /**
-* This function executes a SHA256 transformation.
+* This function initializes the context data for a SHA 256 hash calculation.
 *
 * @param  Ctx is the context data for SHA256.
-* @param  Data is the data to transform.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Transform(Sha256Type *Ctx, u8 *Data)
+void XHdcp22Cmn_Sha256Init(XHdcp22Cmn_Sha256Ctx *Ctx)
 {
-   u32 a,b,c,d,e,f,g,h,i,j,t1,t2,m[64];
-
-   for (i=0,j=0; i < 16; ++i, j += 4)
-      m[i] = (Data[j] << 24) | (Data[j+1] << 16) | (Data[j+2] << 8) | (Data[j+3]);
-   for ( ; i < 64; ++i)
-      m[i] = SIG1(m[i-2]) + m[i-7] + SIG0(m[i-15]) + m[i-16];
-
-   a = Ctx->state[0];
-   b = Ctx->state[1];
-   c = Ctx->state[2];
-   d = Ctx->state[3];
-   e = Ctx->state[4];
-   f = Ctx->state[5];
-   g = Ctx->state[6];
-   h = Ctx->state[7];
-
-   for (i = 0; i < 64; ++i) {
-      t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-      t2 = EP0(a) + MAJ(a,b,c);
-      h = g;
-      g = f;
-      f = e;
-      e = d + t1;
-      d = c;
-      c = b;
-      b = a;
-      a = t1 + t2;
-   }
-
-   Ctx->state[0] += a;
-   Ctx->state[1] += b;
-   Ctx->state[2] += c;
-   Ctx->state[3] += d;
-   Ctx->state[4] += e;
-   Ctx->state[5] += f;
-   Ctx->state[6] += g;
-   Ctx->state[7] += h;
+   memcpy(Ctx->State, Sha256InitState, sizeof(Ctx->State));
+   Ctx->BufferLen = 0;
+   Ctx->Length = 0;
 }
 
 /*****************************************************************************/
 /**
-* This function initializes the context data for a SHA 256 hash calculation.
+*
+* This function adds data to a SHA256 hash calculation. Whole blocks are
+* compressed directly from Data, the remainder is kept in the context
+* until the next call.
 *
 * @param  Ctx is the context data for SHA256.
+* @param  Data is the input data.
+* @param  DataSize is size of the input data array.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Init(Sha256Type *Ctx)
+void XHdcp22Cmn_Sha256Update(XHdcp22Cmn_Sha256Ctx *Ctx, const u8 *Data, u32 DataSize)
 {
-   Ctx->datalen = 0;
-   Ctx->bitlen[0] = 0;
-   Ctx->bitlen[1] = 0;
-   Ctx->state[0] = 0x6a09e667;
-   Ctx->state[1] = 0xbb67ae85;
-   Ctx->state[2] = 0x3c6ef372;
-   Ctx->state[3] = 0xa54ff53a;
-   Ctx->state[4] = 0x510e527f;
-   Ctx->state[5] = 0x9b05688c;
-   Ctx->state[6] = 0x1f83d9ab;
-   Ctx->state[7] = 0x5be0cd19;
+   u8 *Buffer = (u8 *)Ctx->Buffer;
+   u32 Fill;
+
+   Ctx->Length += DataSize;
+
+   // Complete a partial block first.
+   if (Ctx->BufferLen > 0) {
+      Fill = XHDCP22_CMN_SHA256_BLOCK_SIZE - Ctx->BufferLen;
+      if (DataSize < Fill) {
+         memcpy(Buffer + Ctx->BufferLen, Data, DataSize);
+         Ctx->BufferLen += DataSize;
+         return;
+      }
+      memcpy(Buffer + Ctx->BufferLen, Data, Fill);
+      Sha256Blocks(Ctx->State, Buffer, 1);
+      Ctx->BufferLen = 0;
+      Data += Fill;
+      DataSize -= Fill;
+   }
+
+   if (DataSize >= XHDCP22_CMN_SHA256_BLOCK_SIZE) {
+      Sha256Blocks(Ctx->State, Data, DataSize / XHDCP22_CMN_SHA256_BLOCK_SIZE);
+      Data += DataSize & ~(XHDCP22_CMN_SHA256_BLOCK_SIZE - 1);
+      DataSize &= XHDCP22_CMN_SHA256_BLOCK_SIZE - 1;
+   }
+
+   if (DataSize > 0) {
+      memcpy(Buffer, Data, DataSize);
+      Ctx->BufferLen = DataSize;
+   }
 }
 
 /*****************************************************************************/
 /**
 *
-* This function updates the SHA data before adding padding data.
+* This function adds the padding and the message length and returns the hash.
 *
 * @param  Ctx is the context data for SHA256.
-* @param  Data is the input data.
-* @param  Len is size of the input data array.
+* @param  HashedData is the calculated hash (256-bits).
+*
+* @return None.
+*
+* @note   The context must be initialized again before it is reused.
+*
+******************************************************************************/
+void XHdcp22Cmn_Sha256Final(XHdcp22Cmn_Sha256Ctx *Ctx, u8 *HashedData)
+{
+   u8 *Buffer = (u8 *)Ctx->Buffer;
+   u64 BitLen = Ctx->Length * 8;
+   u32 i;
+
+   i = Ctx->BufferLen;
+
+   // Pad whatever data is left in the buffer.
+   Buffer[i++] = 0x80;
+   if (i > 56) {
+      memset(Buffer + i, 0, XHDCP22_CMN_SHA256_BLOCK_SIZE - i);
+      Sha256Blocks(Ctx->State, Buffer, 1);
+      i = 0;
+   }
+   memset(Buffer + i, 0, 56 - i);
+
+   // Append to the padding the total message's length in bits and transform.
+   for (i = 0; i < 8; ++i)
+      Buffer[56+i] = (u8)(BitLen >> (56 - i*8));
+   Sha256Blocks(Ctx->State, Buffer, 1);
+
+   // SHA uses big endian, store the state words most significant byte first.
+   for (i = 0; i < 8; ++i) {
+      HashedData[i*4]   = (u8)(Ctx->State[i] >> 24);
+      HashedData[i*4+1] = (u8)(Ctx->State[i] >> 16);
+      HashedData[i*4+2] = (u8)(Ctx->State[i] >> 8);
+      HashedData[i*4+3] = (u8)(Ctx->State[i]);
+   }
+}
+
+#if defined(SHA256_CORE_ARMV8CE)
+/*****************************************************************************/
+/**
+* This function executes the SHA256 transformation on consecutive blocks
+* with the ARMv8 Cryptography Extensions. Each SHA256H/SHA256H2 pair does
+* four rounds, SHA256SU0/SHA256SU1 compute four message schedule words.
+*
+* @param  State is the intermediate hash value H0..H7, updated in place.
+* @param  Data is the data to transform, NumBlocks * 64 bytes.
+* @param  NumBlocks is the number of 64-byte blocks.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Update(Sha256Type *Ctx, const u8 *Data, u32 Len)
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 NumBlocks)
 {
+   uint32x4_t Abcd, Efgh, AbcdSave, EfghSave, Wk, Tmp;
+   uint32x4_t Msg[4];
    u32 i;
 
-   for (i=0; i < Len; ++i) {
-      Ctx->data[Ctx->datalen] = Data[i];
-      Ctx->datalen++;
-      if (Ctx->datalen == 64) {
-	  Sha256Transform(Ctx,Ctx->data);
-         DBL_INT_ADD(Ctx->bitlen[0],Ctx->bitlen[1],512);
-         Ctx->datalen = 0;
+   Abcd = vld1q_u32(&State[0]);
+   Efgh = vld1q_u32(&State[4]);
+
+   while (NumBlocks--) {
+      AbcdSave = Abcd;
+      EfghSave = Efgh;
+
+      for (i = 0; i < 4; ++i)
+         Msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Data + i*16)));
+
+      for (i = 0; i < 16; ++i) {
+         Wk = vaddq_u32(Msg[i & 3], vld1q_u32(&k[i*4]));
+         if (i < 12)
+            Msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(Msg[i & 3], Msg[(i+1) & 3]),
+                                         Msg[(i+2) & 3], Msg[(i+3) & 3]);
+         Tmp = Abcd;
+         Abcd = vsha256hq_u32(Abcd, Efgh, Wk);
+         Efgh = vsha256h2q_u32(Efgh, Tmp, Wk);
       }
+
+      Abcd = vaddq_u32(Abcd, AbcdSave);
+      Efgh = vaddq_u32(Efgh, EfghSave);
+      Data += XHDCP22_CMN_SHA256_BLOCK_SIZE;
    }
+
+   vst1q_u32(&State[0], Abcd);
+   vst1q_u32(&State[4], Efgh);
 }
 
+#elif defined(SHA256_CORE_NEON)
+// Rotate right of each 32-bit lane
+#define VRORQ(x,n) vsriq_n_u32(vshlq_n_u32(x, 32-(n)), x, n)
+#define VROR(x,n)  vsri_n_u32(vshl_n_u32(x, 32-(n)), x, n)
+
+#define WK_TABLE(i) (Wk[i])
+
 /*****************************************************************************/
 /**
+* This function computes the next four message schedule words
+* W[t..t+3] from W[t-16..t-1] with NEON. W[t+2] and W[t+3] depend on
+* W[t] and W[t+1], so sigma1 is applied to two lanes at a time.
 *
-* This function adds padding
+* @param  X0 is W[t-16..t-13].
+* @param  X1 is W[t-12..t-9].
+* @param  X2 is W[t-8..t-5].
+* @param  X3 is W[t-4..t-1].
 *
-* @param  Ctx is the context data for SHA256.
-* @param  Hash is the calculated hash (256-bits).
+* @return W[t..t+3].
+*
+* @note   None.
+*
+******************************************************************************/
+static inline uint32x4_t Sha256NeonSchedule(uint32x4_t X0, uint32x4_t X1,
+                                            uint32x4_t X2, uint32x4_t X3)
+{
+   uint32x4_t W15 = vextq_u32(X0, X1, 1);   // W[t-15..t-12]
+   uint32x4_t W7 = vextq_u32(X2, X3, 1);    // W[t-7..t-4]
+   uint32x4_t Sum;
+   uint32x2_t W2, Lo, Hi;
+
+   Sum = veorq_u32(veorq_u32(VRORQ(W15, 7), VRORQ(W15, 18)), vshrq_n_u32(W15, 3));
+   Sum = vaddq_u32(vaddq_u32(X0, Sum), W7);
+
+   W2 = vget_high_u32(X3);                  // W[t-2..t-1]
+   Lo = vadd_u32(vget_low_u32(Sum),
+                 veor_u32(veor_u32(VROR(W2, 17), VROR(W2, 19)), vshr_n_u32(W2, 10)));
+   Hi = vadd_u32(vget_high_u32(Sum),
+                 veor_u32(veor_u32(VROR(Lo, 17), VROR(Lo, 19)), vshr_n_u32(Lo, 10)));
+
+   return vcombine_u32(Lo, Hi);
+}
+
+/*****************************************************************************/
+/**
+* This function executes the SHA256 transformation on consecutive blocks.
+* The message schedule plus round constants are computed four words at a
+* time with NEON, the rounds run on the integer pipeline.
+*
+* @param  State is the intermediate hash value H0..H7, updated in place.
+* @param  Data is the data to transform, NumBlocks * 64 bytes.
+* @param  NumBlocks is the number of 64-byte blocks.
 *
 * @return None.
 *
 * @note   None.
 *
 ******************************************************************************/
-static void Sha256Final(Sha256Type *Ctx, u8 *Hash)
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 NumBlocks)
 {
-   u32 i;
+   u32 a,b,c,d,e,f,g,h,i,t1;
+   u32 Wk[64];
+   uint32x4_t X0, X1, X2, X3, Next;
 
-   i = Ctx->datalen;
+   while (NumBlocks--) {
+      X0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Data)));
+      X1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Data + 16)));
+      X2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Data + 32)));
+      X3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(Data + 48)));
 
-   // Pad whatever data is left in the buffer.
-   if (Ctx->datalen < 56) {
-      Ctx->data[i++] = 0x80;
-      while (i < 56)
-         Ctx->data[i++] = 0x00;
-   }
-   else {
-      Ctx->data[i++] = 0x80;
-      while (i < 64)
-         Ctx->data[i++] = 0x00;
-      Sha256Transform(Ctx,Ctx->data);
-      memset(Ctx->data,0,56);
+      vst1q_u32(&Wk[0], vaddq_u32(X0, vld1q_u32(&k[0])));
+      vst1q_u32(&Wk[4], vaddq_u32(X1, vld1q_u32(&k[4])));
+      vst1q_u32(&Wk[8], vaddq_u32(X2, vld1q_u32(&k[8])));
+      vst1q_u32(&Wk[12], vaddq_u32(X3, vld1q_u32(&k[12])));
+      for (i = 16; i < 64; i += 4) {
+         Next = Sha256NeonSchedule(X0, X1, X2, X3);
+         vst1q_u32(&Wk[i], vaddq_u32(Next, vld1q_u32(&k[i])));
+         X0 = X1;
+         X1 = X2;
+         X2 = X3;
+         X3 = Next;
+      }
+
+      a = State[0];
+      b = State[1];
+      c = State[2];
+      d = State[3];
+      e = State[4];
+      f = State[5];
+      g = State[6];
+      h = State[7];
+
+      for (i = 0; i < 64; i += 8) {
+         SHA256_RND8(i, WK_TABLE);
+      }
+
+      State[0] += a;
+      State[1] += b;
+      State[2] += c;
+      State[3] += d;
+      State[4] += e;
+      State[5] += f;
+      State[6] += g;
+      State[7] += h;
+      Data += XHDCP22_CMN_SHA256_BLOCK_SIZE;
    }
+}
 
-   // Append to the padding the total message's length in bits and transform.
-   DBL_INT_ADD(Ctx->bitlen[0],Ctx->bitlen[1],Ctx->datalen * 8);
-   Ctx->data[63] = Ctx->bitlen[0];
-   Ctx->data[62] = Ctx->bitlen[0] >> 8;
-   Ctx->data[61] = Ctx->bitlen[0] >> 16;
-   Ctx->data[60] = Ctx->bitlen[0] >> 24;
-   Ctx->data[59] = Ctx->bitlen[1];
-   Ctx->data[58] = Ctx->bitlen[1] >> 8;
-   Ctx->data[57] = Ctx->bitlen[1] >> 16;
-   Ctx->data[56] = Ctx->bitlen[1] >> 24;
-   Sha256Transform(Ctx,Ctx->data);
-
-   // Since this implementation uses little endian byte ordering and SHA uses big endian,
-   // reverse all the bytes when copying the final state to the output hash.
-   for (i=0; i < 4; ++i) {
-      Hash[i]    = (Ctx->state[0] >> (24-i*8)) & 0x000000ff;
-      Hash[i+4]  = (Ctx->state[1] >> (24-i*8)) & 0x000000ff;
-      Hash[i+8]  = (Ctx->state[2] >> (24-i*8)) & 0x000000ff;
-      Hash[i+12] = (Ctx->state[3] >> (24-i*8)) & 0x000000ff;
-      Hash[i+16] = (Ctx->state[4] >> (24-i*8)) & 0x000000ff;
-      Hash[i+20] = (Ctx->state[5] >> (24-i*8)) & 0x000000ff;
-      Hash[i+24] = (Ctx->state[6] >> (24-i*8)) & 0x000000ff;
-      Hash[i+28] = (Ctx->state[7] >> (24-i*8)) & 0x000000ff;
+#else
+// Big endian 32-bit load from any alignment
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+static inline u32 Sha256Load32(const u8 *Data)
+{
+   u32 Word;
+
+   memcpy(&Word, Data, sizeof(Word));
+   return __builtin_bswap32(Word);
+}
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+static inline u32 Sha256Load32(const u8 *Data)
+{
+   u32 Word;
+
+   memcpy(&Word, Data, sizeof(Word));
+   return Word;
+}
+#else
+static inline u32 Sha256Load32(const u8 *Data)
+{
+   return ((u32)Data[0] << 24) | ((u32)Data[1] << 16) | ((u32)Data[2] << 8) | (u32)Data[3];
+}
+#endif
+
+// Message schedule in a rolling window of 16 words
+#define SHA256_SCHED(i) \
+   (m[(i) & 15] += SIG1(m[((i)-2) & 15]) + m[((i)-7) & 15] + SIG0(m[((i)-15) & 15]))
+#define WK_LOAD(i) (k[i] + m[i])
+#define WK_SCHED(i) (k[i] + SHA256_SCHED(i))
+
+/*****************************************************************************/
+/**
+* This function executes the SHA256 transformation on consecutive blocks.
+*
+* @param  State is the intermediate hash value H0..H7, updated in place.
+* @param  Data is the data to transform, NumBlocks * 64 bytes.
+* @param  NumBlocks is the number of 64-byte blocks.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void Sha256Blocks(u32 *State, const u8 *Data, u32 NumBlocks)
+{
+   u32 a,b,c,d,e,f,g,h,i,t1,m[16];
+
+   while (NumBlocks--) {
+      for (i = 0; i < 16; ++i)
+         m[i] = Sha256Load32(Data + i*4);
+
+      a = State[0];
+      b = State[1];
+      c = State[2];
+      d = State[3];
+      e = State[4];
+      f = State[5];
+      g = State[6];
+      h = State[7];
+
+      SHA256_RND8(0, WK_LOAD);
+      SHA256_RND8(8, WK_LOAD);
+      for (i = 16; i < 64; i += 8) {
+         SHA256_RND8(i, WK_SCHED);
+      }
+
+      State[0] += a;
+      State[1] += b;
+      State[2] += c;
+      State[3] += d;
+      State[4] += e;
+      State[5] += f;
+      State[6] += g;
+      State[7] += h;
+      Data += XHDCP22_CMN_SHA256_BLOCK_SIZE;
    }
 }
+#endif
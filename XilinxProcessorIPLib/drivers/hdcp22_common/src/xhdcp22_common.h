@@ -39,6 +39,9 @@
 * 1.00  MH   10/30/15 First Release.
 * 1.01  MH   01/15/16 Added prefix to function names.
 * 2.00  MH   06/21/17 Changed DIGIT_T type to u32 for ARM support.
+* 2.00  agt  10/17/26 Added streaming SHA256 and HMAC-SHA256 key contexts.
+* 2.00  agt  10/17/26 Added AES-128 key contexts, CTR mode and the HDCP
+*                     key derivation.
 *</pre>
 *
 *****************************************************************************/
@@ -54,8 +57,40 @@ extern "C" {
 #include "bigdigits.h"
 
 /************************** Constant Definitions ****************************/
+#define XHDCP22_CMN_SHA256_HASH_SIZE	32	/**< SHA256 hash size in bytes */
+#define XHDCP22_CMN_SHA256_BLOCK_SIZE	64	/**< SHA256 block size in bytes */
+#define XHDCP22_CMN_AES128_BLOCK_SIZE	16	/**< AES block size in bytes */
+#define XHDCP22_CMN_AES128_KEY_SIZE	16	/**< AES-128 key size in bytes */
 
 /**************************** Type Definitions ******************************/
+/**
+* This typedef contains the state of a streaming SHA256 hash, see
+* XHdcp22Cmn_Sha256Init.
+*/
+typedef struct {
+	u32 State[8];	/**< Intermediate hash value H0..H7 */
+	u32 Buffer[XHDCP22_CMN_SHA256_BLOCK_SIZE / 4]; /**< Partial block */
+	u32 BufferLen;	/**< Number of bytes in Buffer */
+	u64 Length;	/**< Number of bytes hashed */
+} XHdcp22Cmn_Sha256Ctx;
+
+/**
+* This typedef contains a HMAC-SHA256 key in the form of the SHA256 states
+* after compressing the (Key XOR ipad) and (Key XOR opad) blocks. A key set
+* up once with XHdcp22Cmn_HmacSha256SetKey saves these two compressions in
+* every XHdcp22Cmn_HmacSha256Mac call.
+*/
+typedef struct {
+	u32 InnerState[8];	/**< State after the Key XOR ipad block */
+	u32 OuterState[8];	/**< State after the Key XOR opad block */
+} XHdcp22Cmn_HmacSha256Ctx;
+
+/**
+* This typedef contains an expanded AES-128 key, see XHdcp22Cmn_Aes128SetKey.
+*/
+typedef struct {
+	u32 RoundKey[44];	/**< Round keys 0..10, four words each */
+} XHdcp22Cmn_Aes128Ctx;
 
 /***************** Macros (Inline Functions) Definitions ********************/
 
@@ -63,9 +98,18 @@ extern "C" {
 
 /* Cryptographic functions */
 void XHdcp22Cmn_Sha256Hash(const u8 *Data, u32 DataSize, u8 *HashedData);
+void XHdcp22Cmn_Sha256Init(XHdcp22Cmn_Sha256Ctx *Ctx);
+void XHdcp22Cmn_Sha256Update(XHdcp22Cmn_Sha256Ctx *Ctx, const u8 *Data, u32 DataSize);
+void XHdcp22Cmn_Sha256Final(XHdcp22Cmn_Sha256Ctx *Ctx, u8 *HashedData);
 int  XHdcp22Cmn_HmacSha256Hash(const u8 *Data, int DataSize, const u8 *Key, int KeySize, u8  *HashedData);
+void XHdcp22Cmn_HmacSha256SetKey(XHdcp22Cmn_HmacSha256Ctx *HmacCtx, const u8 *Key, int KeySize);
+void XHdcp22Cmn_HmacSha256Mac(const XHdcp22Cmn_HmacSha256Ctx *HmacCtx, const u8 *Data, int DataSize, u8 *HashedData);
 void XHdcp22Cmn_Aes128Encrypt(const u8 *Data, const u8 *Key, u8 *Output);
 void XHdcp22Cmn_Aes128Decrypt(const u8 *Data, const u8 *Key, u8 *Output);
+void XHdcp22Cmn_Aes128SetKey(XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Key);
+void XHdcp22Cmn_Aes128EncryptBlocks(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Data, u8 *Output, u32 NumBlocks);
+void XHdcp22Cmn_Aes128Ctr(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Iv, const u8 *Data, u8 *Output, u32 DataSize);
+void XHdcp22Cmn_Aes128DeriveKeys(const XHdcp22Cmn_Aes128Ctx *AesCtx, const u8 *Iv, u32 Ctr, u8 *Output, u32 NumBlocks);
 
 #ifdef __cplusplus
 }
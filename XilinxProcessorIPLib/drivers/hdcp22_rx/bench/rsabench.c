@@ -0,0 +1,409 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file rsabench.c
+*		Host benchmark of the RSA private key decryption of the HDCP 2.2
+*		receiver. xhdcp22_rx_crypt.c is built for Linux and decrypts the
+*		Ekpub(km) test vectors of the DCP receiver keys R1 and R2 with
+*		XHdcp22Rx_RsaesOaepDecrypt(), which runs the two 512 bit CRT
+*		exponentiations. Each decryption is checked against km.
+*
+*		The default build uses the hdcp22_mmult core, which is modelled
+*		here in software and counts the Montgomery multiplications
+*		that the driver starts. The build with _XHDCP22_RX_SW_MMULT_
+*		uses the software Montgomery multiplication of the driver. Both
+*		report the time per decryption; the count of the binary square
+*		and multiply method is computed from the exponents.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 2.20  agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "xhdcp22_rx_i.h"
+#include "xhdcp22_common.h"
+
+/************************** Constant Definitions *****************************/
+
+#define NDIGITS		(XHDCP22_RX_P_SIZE / 4)
+
+/************************** Variable Definitions *****************************/
+
+/* DCP test vectors of the receivers R1 and R2, see xhdcp22_rx_test.c */
+static const u8 TestKpriv[2][320] =
+{
+	{0xec, 0xbe, 0xe5, 0x5b, 0x9e, 0x7a, 0x50, 0x8a, 0x96, 0x80, 0xc8, 0xdb,
+	 0xb0, 0xed, 0x44, 0xf2, 0xba, 0x1d, 0x5d, 0x80, 0xc1, 0xc8, 0xb3, 0xc2,
+	 0x74, 0xde, 0xee, 0x28, 0xec, 0xdc, 0x78, 0xc8, 0x67, 0x53, 0x07, 0xf2,
+	 0xf8, 0x75, 0x9c, 0x4c, 0xa5, 0x6c, 0x48, 0x94, 0xc8, 0xeb, 0xad, 0xd7,
+	 0x7d, 0xd2, 0xea, 0xdf, 0x74, 0x20, 0x62, 0xc9, 0x81, 0xa8, 0x3c, 0x36,
+	 0xb9, 0xea, 0x40, 0xfd, 0xbe, 0x00, 0x19, 0x76, 0xc6, 0xb4, 0xba, 0x19,
+	 0xd4, 0x69, 0xfa, 0x4d, 0xe2, 0xf8, 0x30, 0x27, 0x36, 0x2b, 0x4c, 0xc4,
+	 0x34, 0xab, 0xd3, 0xd9, 0x8c, 0xd6, 0xb8, 0x0d, 0x37, 0x5e, 0x59, 0x4b,
+	 0x76, 0x70, 0x68, 0x2b, 0x1f, 0x4c, 0x3d, 0x47, 0x5f, 0xa5, 0xb1, 0xcd,
+	 0x74, 0x56, 0x88, 0xfe, 0x7c, 0xf8, 0x3b, 0x30, 0x6f, 0xfd, 0xc3, 0xed,
+	 0x87, 0x3c, 0xa1, 0x53, 0x84, 0xc3, 0xd2, 0x7f, 0x60, 0x71, 0x9b, 0xe9,
+	 0xe8, 0xf3, 0x97, 0x1f, 0xfe, 0x13, 0xd4, 0xbf, 0x7a, 0xa2, 0x0d, 0xf6,
+	 0x7b, 0xcf, 0x3e, 0xaa, 0x17, 0x47, 0x75, 0xc3, 0x7f, 0xec, 0xd9, 0x44,
+	 0x9e, 0xc9, 0x6a, 0x02, 0xe9, 0xe4, 0xaf, 0x56, 0x51, 0xd5, 0x47, 0xa9,
+	 0x09, 0xb2, 0xc5, 0x16, 0xa7, 0x8b, 0x2b, 0x34, 0xa0, 0x33, 0x6e, 0x2f,
+	 0x3d, 0x95, 0x7b, 0xe8, 0xef, 0x02, 0xe4, 0x14, 0xbf, 0x44, 0x28, 0xd9,
+	 0x10, 0x0e, 0x2e, 0x18, 0xad, 0x5d, 0xe4, 0x43, 0xfe, 0x81, 0x1e, 0x17,
+	 0xaa, 0xd0, 0x52, 0x31, 0x5e, 0x10, 0x76, 0xa2, 0x35, 0xd9, 0x37, 0x43,
+	 0xb0, 0xf5, 0x0c, 0x04, 0x81, 0xe3, 0x45, 0x24, 0x6d, 0x53, 0xbe, 0x59,
+	 0xb6, 0x81, 0x58, 0xc4, 0x49, 0x3e, 0xd5, 0x31, 0x89, 0x5d, 0x2e, 0xa2,
+	 0x62, 0xa9, 0x0f, 0x47, 0x5e, 0x8f, 0x51, 0x19, 0x27, 0x4e, 0x66, 0x4b,
+	 0x8a, 0x72, 0x89, 0xbd, 0x3e, 0x53, 0x0a, 0xf4, 0x8e, 0x75, 0xe1, 0x52,
+	 0xc6, 0x24, 0xe9, 0xf7, 0xbb, 0xac, 0x3f, 0x22, 0x5f, 0xe8, 0xe0, 0x79,
+	 0x35, 0xff, 0x91, 0xee, 0x22, 0x56, 0xd2, 0x00, 0x68, 0x32, 0xc4, 0xe1,
+	 0x5f, 0xff, 0xf8, 0xb1, 0x1d, 0xee, 0xdc, 0x57, 0x81, 0xd1, 0xab, 0x8b,
+	 0x37, 0x22, 0xe3, 0x9f, 0xd0, 0xa1, 0xc1, 0xce, 0x1d, 0xd0, 0x24, 0x23,
+	 0xa0, 0x0e, 0xf7, 0xa6, 0xdb, 0xa3, 0xea, 0xd3},
+	{0xf5, 0xf6, 0xfa, 0x44, 0xa2, 0x16, 0x2f, 0xa7, 0x1f, 0x7f, 0x16, 0x05,
+	 0x99, 0x26, 0xc4, 0x1b, 0x80, 0x7f, 0xfa, 0x52, 0x4e, 0x3e, 0xaa, 0x3d,
+	 0x1e, 0xb0, 0xf1, 0x9a, 0xc6, 0x3d, 0x8f, 0x57, 0x2b, 0x9e, 0xcd, 0xe8,
+	 0x03, 0xd6, 0xf3, 0x91, 0x75, 0xe2, 0x19, 0x44, 0x9e, 0x11, 0x58, 0x5f,
+	 0xd6, 0x88, 0x7c, 0xc4, 0xc1, 0x5b, 0x45, 0x9b, 0x84, 0xcf, 0x72, 0x1d,
+	 0x35, 0xbf, 0x24, 0xd5, 0xed, 0xba, 0x08, 0xbf, 0x42, 0x2c, 0x0e, 0xfa,
+	 0x3a, 0xc4, 0xd2, 0xc7, 0x01, 0x51, 0x25, 0xae, 0xb0, 0xa1, 0xcc, 0xdb,
+	 0x67, 0x9b, 0xaa, 0x50, 0xf0, 0x80, 0xac, 0x4b, 0x9f, 0x5c, 0xba, 0x1e,
+	 0xf4, 0x7f, 0xa9, 0xb3, 0x21, 0x8b, 0x62, 0x2c, 0x36, 0xda, 0xcd, 0xa7,
+	 0x4d, 0xa4, 0xd6, 0x44, 0xed, 0xb1, 0x34, 0xe7, 0x69, 0x10, 0x77, 0x5a,
+	 0x6a, 0xff, 0xf5, 0x63, 0x8a, 0x2c, 0x43, 0x09, 0x61, 0x5a, 0xc4, 0x6c,
+	 0x6e, 0x0b, 0x82, 0x09, 0x10, 0x3a, 0x69, 0x29, 0x06, 0x19, 0x85, 0xfd,
+	 0xac, 0xba, 0xfb, 0x05, 0xa0, 0xda, 0xc4, 0xdf, 0x34, 0x4a, 0xad, 0x16,
+	 0xa9, 0xe8, 0xab, 0xd7, 0xc0, 0xf8, 0x36, 0x5f, 0xe3, 0x45, 0x2d, 0x5b,
+	 0x21, 0xe1, 0xc0, 0x46, 0x9c, 0x9a, 0x18, 0xf4, 0xb6, 0x21, 0x87, 0xe1,
+	 0x08, 0xf7, 0x6b, 0x71, 0xc6, 0xfb, 0xa5, 0x1b, 0x52, 0xae, 0xb9, 0x91,
+	 0x5a, 0x83, 0x7f, 0xbb, 0x1a, 0xbd, 0xdd, 0xc2, 0x06, 0xc8, 0x54, 0x1c,
+	 0xb3, 0x72, 0xab, 0x2f, 0x55, 0x4f, 0x75, 0xc9, 0x80, 0x2c, 0x73, 0xef,
+	 0xb7, 0x72, 0xb6, 0xa7, 0x60, 0x79, 0x14, 0xe0, 0x9e, 0x65, 0x51, 0x3e,
+	 0xc4, 0x21, 0xe6, 0xf2, 0x40, 0xbc, 0x94, 0x9b, 0x03, 0xe4, 0x24, 0x35,
+	 0x40, 0x6f, 0x3d, 0x5e, 0x72, 0xd1, 0x73, 0x30, 0x39, 0x17, 0x55, 0xde,
+	 0x5d, 0x88, 0xb6, 0xc9, 0xbc, 0x91, 0x2a, 0x93, 0x6a, 0x8d, 0x24, 0x3c,
+	 0xd5, 0x7d, 0x12, 0x3b, 0xa3, 0x71, 0xc7, 0x3a, 0xf0, 0x64, 0x72, 0x50,
+	 0x7e, 0x18, 0x71, 0xe1, 0xb4, 0x3b, 0x1e, 0xfc, 0x38, 0xca, 0xe6, 0x8c,
+	 0x16, 0x51, 0x97, 0xd6, 0x3f, 0x04, 0xee, 0x23, 0x8b, 0x45, 0x0c, 0x4b,
+	 0x98, 0x36, 0x18, 0x27, 0x29, 0x1b, 0x4d, 0x73, 0x7e, 0xe8, 0xb0, 0x1a,
+	 0xc7, 0xfb, 0x5c, 0xea, 0x78, 0xd0, 0x6e, 0x97}
+};
+
+static const u8 TestEkm[2][128] =
+{
+	{0x9b, 0x9f, 0x80, 0x19, 0xad, 0x0e, 0xa2, 0xf0, 0xdd, 0xa0, 0x29, 0x33,
+	 0xd9, 0x6d, 0x1c, 0x77, 0x31, 0x37, 0x57, 0xe0, 0xe5, 0xb2, 0xbd, 0xdd,
+	 0x36, 0x3e, 0x38, 0x4e, 0x7d, 0x40, 0x78, 0x66, 0x97, 0x7a, 0x4c, 0xce,
+	 0xc5, 0xc7, 0x5d, 0x01, 0x57, 0x26, 0xcc, 0xa2, 0xf6, 0xde, 0x34, 0xdd,
+	 0x29, 0xbe, 0x5e, 0x31, 0xe8, 0xf1, 0x34, 0xe8, 0x1a, 0x63, 0xa3, 0x6d,
+	 0x46, 0xdc, 0x0a, 0x06, 0x08, 0x99, 0x9d, 0xdb, 0x3c, 0xa2, 0x9c, 0x04,
+	 0xdd, 0x4e, 0xd9, 0x02, 0x7d, 0x20, 0x54, 0xec, 0xca, 0x86, 0x42, 0x1b,
+	 0x18, 0xda, 0x30, 0x9c, 0xc4, 0xcb, 0xac, 0xb4, 0x54, 0xde, 0x84, 0x68,
+	 0x71, 0x53, 0x6d, 0x92, 0x17, 0xca, 0x08, 0x8a, 0x7a, 0xf9, 0x98, 0x9a,
+	 0xb6, 0x7b, 0x22, 0x92, 0xac, 0x7d, 0x0d, 0x6b, 0xd6, 0x7f, 0x31, 0xab,
+	 0xf0, 0x10, 0xc5, 0x2a, 0x0f, 0x6d, 0x27, 0xa0},
+	{0xa8, 0x55, 0xc2, 0xc4, 0xc6, 0xbe, 0xef, 0xcd, 0xcb, 0x9f, 0xe3, 0x9f,
+	 0x2a, 0xb7, 0x29, 0x76, 0xfe, 0xd8, 0xda, 0xc9, 0x38, 0xfa, 0x39, 0xf0,
+	 0xab, 0xca, 0x8a, 0xed, 0x95, 0x7b, 0x93, 0xb2, 0xdf, 0xd0, 0x7d, 0x09,
+	 0x9d, 0x05, 0x96, 0x66, 0x03, 0x6e, 0xba, 0xe0, 0x63, 0x0f, 0x30, 0x77,
+	 0xc2, 0xbb, 0xe2, 0x11, 0x39, 0xe5, 0x27, 0x78, 0xee, 0x64, 0xf2, 0x85,
+	 0x36, 0x57, 0xc3, 0x39, 0xd2, 0x7b, 0x79, 0x03, 0xb7, 0xcc, 0x82, 0xcb,
+	 0xf0, 0x62, 0x82, 0x43, 0x38, 0x09, 0x9b, 0x71, 0xaa, 0x38, 0xa6, 0x3f,
+	 0x48, 0x12, 0x6d, 0x8c, 0x5e, 0x07, 0x90, 0x76, 0xac, 0x90, 0x99, 0x51,
+	 0x5b, 0x06, 0xa5, 0xfa, 0x50, 0xe4, 0xf9, 0x25, 0xc3, 0x07, 0x12, 0x37,
+	 0x64, 0x92, 0xd7, 0xdb, 0xd3, 0x34, 0x1c, 0xe4, 0xfa, 0xdd, 0x09, 0xe6,
+	 0x28, 0x3d, 0x0c, 0xad, 0xa9, 0xd8, 0xe1, 0xb5}
+};
+
+static const u8 TestKm[2][16] =
+{
+	{0x68, 0xbc, 0xc5, 0x1b, 0xa9, 0xdb, 0x1b, 0xd0, 0xfa, 0xf1, 0x5e, 0x9a,
+	 0xd8, 0xa5, 0xaf, 0xb9},
+	{0xca, 0x9f, 0x83, 0x95, 0x70, 0xd0, 0xd0, 0xf9, 0xcf, 0xe4, 0xeb, 0x54,
+	 0x7e, 0x09, 0xfa, 0x3b}
+};
+
+#ifndef _XHDCP22_RX_SW_MMULT_
+/* Registers of the modelled MMULT core */
+static u32 MmultN[NDIGITS];
+static u32 MmultNPrime[NDIGITS];
+static u32 MmultA[NDIGITS];
+static u32 MmultB[NDIGITS];
+static u32 MmultU[NDIGITS];
+#endif
+static unsigned long MmultCount;
+
+/*****************************************************************************/
+/*
+* Driver dependencies. The log and the random number generator are not used
+* by the decryption.
+*/
+void XHdcp22Rx_LogWr(XHdcp22_Rx *InstancePtr, u16 Evt, u16 Data)
+{
+}
+
+void XHdcp22Rng_GetRandom(XHdcp22_Rng *InstancePtr, u8 *BufferPtr,
+		u16 BufferLength, u16 RandomLength)
+{
+	memset(BufferPtr, 0, RandomLength);
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+}
+
+void print(const char8 *ptr)
+{
+	fputs(ptr, stdout);
+}
+
+/*****************************************************************************/
+/*
+* Model of the hdcp22_mmult core: U = A * B * R^-1 mod N with R = 2^512,
+* computed with the CIOS method. Every start is counted.
+*/
+#ifndef _XHDCP22_RX_SW_MMULT_
+static void mmult_copy(u32 *Dst, const int *Src, int Offset, int Length)
+{
+	memcpy(Dst + Offset, Src, Length * sizeof(u32));
+}
+
+u32 XHdcp22_mmult_IsReady(XHdcp22_mmult *InstancePtr)
+{
+	return 1;
+}
+
+u32 XHdcp22_mmult_IsDone(XHdcp22_mmult *InstancePtr)
+{
+	return 1;
+}
+
+u32 XHdcp22_mmult_Write_N_Words(XHdcp22_mmult *InstancePtr, int offset,
+		int *data, int length)
+{
+	mmult_copy(MmultN, data, offset, length);
+	return length;
+}
+
+u32 XHdcp22_mmult_Write_NPrime_Words(XHdcp22_mmult *InstancePtr, int offset,
+		int *data, int length)
+{
+	mmult_copy(MmultNPrime, data, offset, length);
+	return length;
+}
+
+u32 XHdcp22_mmult_Write_A_Words(XHdcp22_mmult *InstancePtr, int offset,
+		int *data, int length)
+{
+	mmult_copy(MmultA, data, offset, length);
+	return length;
+}
+
+u32 XHdcp22_mmult_Write_B_Words(XHdcp22_mmult *InstancePtr, int offset,
+		int *data, int length)
+{
+	mmult_copy(MmultB, data, offset, length);
+	return length;
+}
+
+u32 XHdcp22_mmult_Read_U_Words(XHdcp22_mmult *InstancePtr, int offset,
+		int *data, int length)
+{
+	memcpy(data, MmultU + offset, length * sizeof(u32));
+	return length;
+}
+
+void XHdcp22_mmult_Start(XHdcp22_mmult *InstancePtr)
+{
+	u32 T[NDIGITS + 2];
+	u32 Diff[NDIGITS + 1];
+	u64 Acc;
+	u32 Carry;
+	u32 M;
+	int i, j;
+
+	memset(T, 0, sizeof(T));
+	for (i = 0; i < NDIGITS; i++) {
+		Carry = 0;
+		for (j = 0; j < NDIGITS; j++) {
+			Acc = (u64)T[j] + (u64)MmultA[j] * MmultB[i] + Carry;
+			T[j] = (u32)Acc;
+			Carry = (u32)(Acc >> 32);
+		}
+		Acc = (u64)T[NDIGITS] + Carry;
+		T[NDIGITS] = (u32)Acc;
+		T[NDIGITS + 1] = (u32)(Acc >> 32);
+
+		M = T[0] * MmultNPrime[0];
+		Acc = (u64)T[0] + (u64)M * MmultN[0];
+		Carry = (u32)(Acc >> 32);
+		for (j = 1; j < NDIGITS; j++) {
+			Acc = (u64)T[j] + (u64)M * MmultN[j] + Carry;
+			T[j - 1] = (u32)Acc;
+			Carry = (u32)(Acc >> 32);
+		}
+		Acc = (u64)T[NDIGITS] + Carry;
+		T[NDIGITS - 1] = (u32)Acc;
+		T[NDIGITS] = T[NDIGITS + 1] + (u32)(Acc >> 32);
+	}
+
+	/* Final subtraction if T >= N */
+	Carry = 0;
+	for (j = 0; j < NDIGITS; j++) {
+		Acc = (u64)T[j] - MmultN[j] - Carry;
+		Diff[j] = (u32)Acc;
+		Carry = (u32)(Acc >> 63);
+	}
+	Diff[NDIGITS] = T[NDIGITS] - Carry;
+	if (T[NDIGITS] >= Carry) {
+		memcpy(MmultU, Diff, sizeof(MmultU));
+	} else {
+		memcpy(MmultU, T, sizeof(MmultU));
+	}
+	MmultCount++;
+}
+#endif
+
+/*****************************************************************************/
+/*
+* Number of Montgomery multiplications of one exponentiation with binary
+* square and multiply: one squaring per bit, one multiplication per set bit
+* and the conversion from the Montgomery domain.
+*/
+static unsigned long binary_mults(const u8 *Exp)
+{
+	unsigned long Count = NDIGITS * 32 + 1;
+	int i;
+	u8 Byte;
+
+	for (i = 0; i < XHDCP22_RX_P_SIZE; i++) {
+		for (Byte = Exp[i]; Byte != 0; Byte &= Byte - 1) {
+			Count++;
+		}
+	}
+	return Count;
+}
+
+static double now_us(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return Ts.tv_sec * 1e6 + Ts.tv_nsec / 1e3;
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n decrypts]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	static XHdcp22_Rx Rx;
+	const XHdcp22_Rx_KprivRx *Kpriv;
+	u8 Ekm[XHDCP22_RX_N_SIZE];
+	u8 Message[XHDCP22_RX_N_SIZE];
+	unsigned long Binary;
+	unsigned long Count;
+	double Start, Elapsed;
+	int Iterations = 200;
+	int MessageLen;
+	int Key, i, Opt;
+
+	while ((Opt = getopt(argc, argv, "n:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Iterations = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Iterations <= 0) {
+		usage(argv[0]);
+	}
+
+#ifndef _XHDCP22_RX_SW_MMULT_
+	printf("RSA-1024 CRT decrypt, hdcp22_mmult model, %d decrypts\n",
+			Iterations);
+#else
+	printf("RSA-1024 CRT decrypt, _XHDCP22_RX_SW_MMULT_, %d decrypts\n",
+			Iterations);
+#endif
+	printf("%-4s %10s %10s %14s\n", "key", "mmult", "binary", "us/decrypt");
+
+	for (Key = 0; Key < 2; Key++) {
+		Kpriv = (const XHdcp22_Rx_KprivRx *)TestKpriv[Key];
+		memset(&Rx, 0, sizeof(Rx));
+		XHdcp22Rx_CalcMontNPrime(Rx.NPrimeP, Kpriv->p, NDIGITS);
+		XHdcp22Rx_CalcMontNPrime(Rx.NPrimeQ, Kpriv->q, NDIGITS);
+		Binary = binary_mults(Kpriv->dp) + binary_mults(Kpriv->dq);
+
+		MmultCount = 0;
+		Start = now_us();
+		for (i = 0; i < Iterations; i++) {
+			memcpy(Ekm, TestEkm[Key], sizeof(Ekm));
+			memset(Message, 0, sizeof(Message));
+			if (XHdcp22Rx_RsaesOaepDecrypt(&Rx, Kpriv, Ekm, Message,
+						&MessageLen) != XST_SUCCESS ||
+				MessageLen != sizeof(TestKm[Key]) ||
+				memcmp(Message, TestKm[Key], sizeof(TestKm[Key])) != 0) {
+				printf("R%d: decrypt failed\n", Key + 1);
+				return 1;
+			}
+		}
+		Elapsed = now_us() - Start;
+		Count = MmultCount / Iterations;
+
+#ifndef _XHDCP22_RX_SW_MMULT_
+		printf("R%-3d %10lu %10lu %14.1f\n", Key + 1, Count, Binary,
+				Elapsed / Iterations);
+#else
+		(void)Count;
+		printf("R%-3d %10s %10lu %14.1f\n", Key + 1, "-", Binary,
+				Elapsed / Iterations);
+#endif
+	}
+
+	return 0;
+}
@@ -53,6 +53,8 @@
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.01  MH   02/28/17 Fixed compiler warnings.
 * 2.20  MH   06/08/17 Updated for 64 bit support.
+* 2.20  agt  10/17/26 Derive the HMAC keys of the session once before H'
+*                     and use them for L', V' and M'.
 *</pre>
 *
 *****************************************************************************/
@@ -1765,6 +1767,7 @@ static void XHdcp22Rx_ResetParams(XHdcp22_Rx *InstancePtr)
 	memset(InstancePtr->Params.SeqNumM,      0, sizeof(InstancePtr->Params.SeqNumM));
 	memset(InstancePtr->Params.StreamIdType, 0, sizeof(InstancePtr->Params.StreamIdType));
 	memset(InstancePtr->Params.MPrime,       0, sizeof(InstancePtr->Params.MPrime));
+	memset(&InstancePtr->Params.HmacKeys,    0, sizeof(InstancePtr->Params.HmacKeys));
 }
 
 /*****************************************************************************/
@@ -3118,8 +3121,10 @@ static int XHdcp22Rx_SendMessageAKESendHPrime(XHdcp22_Rx *InstancePtr)
 
 	/* Compute H Prime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_HPRIME);
-	XHdcp22Rx_ComputeHPrime(InstancePtr->Params.Rrx, InstancePtr->Params.RxCaps,
-			InstancePtr->Params.Rtx, InstancePtr->Params.TxCaps, InstancePtr->Params.Km,
+	XHdcp22Rx_ComputeHmacKeys(InstancePtr->Params.Rrx, InstancePtr->Params.Rtx,
+			InstancePtr->Params.Km, &InstancePtr->Params.HmacKeys);
+	XHdcp22Rx_ComputeHPrime(InstancePtr->Params.RxCaps, InstancePtr->Params.Rtx,
+			InstancePtr->Params.TxCaps, &InstancePtr->Params.HmacKeys,
 			MsgPtr->AKESendHPrime.HPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_HPRIME_DONE);
 
@@ -3274,8 +3279,8 @@ static int XHdcp22Rx_SendMessageLCSendLPrime(XHdcp22_Rx *InstancePtr)
 
 	/* Compute LPrime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_LPRIME);
-	XHdcp22Rx_ComputeLPrime(InstancePtr->Params.Rn, InstancePtr->Params.Km, InstancePtr->Params.Rrx,
-		InstancePtr->Params.Rtx, MsgPtr->LCSendLPrime.LPrime);
+	XHdcp22Rx_ComputeLPrime(InstancePtr->Params.Rn, &InstancePtr->Params.HmacKeys,
+		MsgPtr->LCSendLPrime.LPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_LPRIME_DONE);
 
 	/* Generate LC_Send_L_prime message */
@@ -3423,9 +3428,7 @@ static int XHdcp22Rx_SendMessageRepeaterAuthSendRxIdList(XHdcp22_Rx *InstancePtr
 			InstancePtr->Topology.DeviceCnt,
 			MsgPtr->RepeaterAuthSendRxIdList.RxInfo,
 			MsgPtr->RepeaterAuthSendRxIdList.SeqNumV,
-			InstancePtr->Params.Km,
-			InstancePtr->Params.Rrx,
-			InstancePtr->Params.Rtx,
+			&InstancePtr->Params.HmacKeys,
 			InstancePtr->Params.VPrime);
 		XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_VPRIME_DONE);
 
@@ -3592,8 +3595,7 @@ static int XHdcp22Rx_SendMessageRepeaterAuthStreamReady(XHdcp22_Rx *InstancePtr)
 	/* Compute MPrime */
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_MPRIME);
 	XHdcp22Rx_ComputeMPrime(InstancePtr->Params.StreamIdType, InstancePtr->Params.SeqNumM,
-		InstancePtr->Params.Km, InstancePtr->Params.Rrx, InstancePtr->Params.Rtx,
-		MsgPtr->RepeaterAuthStreamReady.MPrime);
+		&InstancePtr->Params.HmacKeys, MsgPtr->RepeaterAuthStreamReady.MPrime);
 	XHdcp22Rx_LogWr(InstancePtr, XHDCP22_RX_LOG_EVT_DEBUG, XHDCP22_RX_LOG_DEBUG_COMPUTE_MPRIME_DONE);
 
 	/* Generate RepeaterAuth_Stream_Ready message */
@@ -98,6 +98,8 @@
 *                     to array. Added function XHDCP22Rx_GetVersion.
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.01  MH   02/28/17 Fixed compiler warnings.
+* 2.20  agt  10/17/26 Added the HMAC-SHA256 session keys HmacKeys to
+*                     XHdcp22_Rx_Parameters.
 *</pre>
 *
 *****************************************************************************/
@@ -118,6 +120,7 @@ extern "C" {
 #include "xhdcp22_rng.h"
 #include "xhdcp22_mmult.h"
 #include "xhdcp22_cipher.h"
+#include "xhdcp22_common.h"
 
 /************************** Constant Definitions ****************************/
 #define XHDCP22_RX_MAX_MESSAGE_SIZE           534  /**< Maximum message size */
@@ -406,6 +409,18 @@ typedef struct
 	u8                    IsEncryptionStatusCallbackSet;
 } XHdcp22_Rx_Handles;
 
+/**
+ * This typedef contains the HMAC-SHA256 keys of an authentication session.
+ * They are derived from Km, Rtx and Rrx once with H', so each L', V' and M'
+ * costs only the compressions of its message.
+ */
+typedef struct
+{
+	XHdcp22Cmn_HmacSha256Ctx Kd;       /**< Kd, the key of H' and V' */
+	XHdcp22Cmn_HmacSha256Ctx KdRrx;    /**< Kd[255:64] || (Kd[63:0] xor Rrx), the key of L' */
+	XHdcp22Cmn_HmacSha256Ctx Sha256Kd; /**< SHA256(Kd), the key of M' */
+} XHdcp22_Rx_HmacKeys;
+
 /**
  * This typedef is used to store temporary parameters for computations
  */
@@ -426,6 +441,7 @@ typedef struct
 	u8 SeqNumM[3];
 	u8 StreamIdType[2];
 	u8 MPrime[32];
+	XHdcp22_Rx_HmacKeys HmacKeys;
 } XHdcp22_Rx_Parameters;
 
 /**
@@ -44,6 +44,12 @@
 * 1.00  MH   10/30/15 First Release
 * 2.00  MH   04/14/16 Updated for repeater upstream support.
 * 2.20  MH   06/21/17 Updated for 64 bit support.
+* 2.20  agt  10/17/26 Changed XHdcp22Rx_Pkcs1MontExp to sliding window
+*                     exponentiation with a table of odd powers.
+* 2.20  agt  10/17/26 Added XHdcp22Rx_ComputeHmacKeys. H', L', V' and M'
+*                     use the HMAC keys instead of deriving Kd each time.
+* 2.20  agt  10/17/26 XHdcp22Rx_ComputeDKey derives consecutive keys with
+*                     one AES key setup.
 *</pre>
 *
 *****************************************************************************/
@@ -58,6 +64,10 @@
 #include "xhdcp22_common.h"
 
 /************************** Constant Definitions ****************************/
+/** Window size in bits of the modular exponentiation */
+#define XHDCP22_RX_MONTEXP_WINDOW	4
+/** Number of odd powers A^1, A^3, ..., A^(2^WINDOW-1) in the table */
+#define XHDCP22_RX_MONTEXP_TABLE	(1 << (XHDCP22_RX_MONTEXP_WINDOW-1))
 
 /**************************** Type Definitions ******************************/
 
@@ -76,9 +86,9 @@ static int  XHdcp22Rx_Pkcs1Mgf1(const u8 *seed, const u32 seedlen, u8  *mask, u3
 static int  XHdcp22Rx_Pkcs1EmeOaepEncode(const u8 *Message, const u32 MessageLen,
 	            const u8 *MaskingSeed, u8 *EncodedMessage);
 static int  XHdcp22Rx_Pkcs1EmeOaepDecode(u8 *EncodedMessage, u8 *Message, int *MessageLen);
+#ifndef _XHDCP22_RX_SW_MMULT_
 static void XHdcp22Rx_Pkcs1MontMultFiosInit(XHdcp22_Rx *InstancePtr, u32 *N,
 	            const u32 *NPrime, int NDigits);
-#ifndef _XHDCP22_RX_SW_MMULT_
 static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
 	            u32 *B, int NDigits);
 #else
@@ -86,12 +96,14 @@ static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B, u32 *N,
 	            const u32 *NPrime, int NDigits);
 static void XHdcp22Rx_Pkcs1MontMultAdd(u32 *A, u32 C, int SDigit, int NDigits);
 #endif
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	            u32 *B, u32 *N, const u32 *NPrime, int NDigits);
 static int  XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A, u32 *E,
 	            u32 *N, const u32 *NPrime, int NDigits);
 
 /* Functions for implementing other cryptographic tasks */
 static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
-	            const u8 *Rn, u8 *Ctr, u8 *DKey);
+	            const u8 *Rn, u32 Ctr, u32 NumKeys, u8 *DKey);
 static void XHdcp22Rx_Xor(u8 *Cout, const u8 *Ain, const u8 *Bin, u32 Len);
 
 /*****************************************************************************/
@@ -811,6 +823,7 @@ static void XHdcp22Rx_Pkcs1MontMultFiosStub(u32 *U, u32 *A, u32 *B,
 }
 #endif
 
+#ifndef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function initializes the Montgomery Multiplier (MMULT) hardware
@@ -851,7 +864,6 @@ static void XHdcp22Rx_Pkcs1MontMultFiosInit(XHdcp22_Rx *InstancePtr, u32 *N,
 	XHdcp22_mmult_Write_NPrime_Words(&InstancePtr->MmultInst, 0, (int *)NPrime, NDigits);
 }
 
-#ifndef _XHDCP22_RX_SW_MMULT_
 /****************************************************************************/
 /**
 * This function runs the Montgomery Multiplier (MMULT) hardware to perform
@@ -899,10 +911,50 @@ static void XHdcp22Rx_Pkcs1MontMultFios(XHdcp22_Rx *InstancePtr, u32 *U,
 }
 #endif
 
+/****************************************************************************/
+/**
+* This function performs one Montgomery multiplication with the MMULT
+* hardware, or with the software implementation when the driver is built
+* with _XHDCP22_RX_SW_MMULT_.
+*
+* U = MontMult(A,B,N)
+*
+* @param	InstancePtr is a pointer to the MMULT instance.
+* @param	U is the MMM result
+* @param	A is the n-residue input, A' = A*R mod N
+* @param	B is the n-residue input, B' = B*R mod N
+* @param	N is the modulus
+* @param	NPrime is a pre-computed constant, NPrime = (1-R*Rbar)/N
+* @param	NDigits is the integer precision of the arguments (C,A,B,N,NPrime)
+*
+* @return	None.
+*
+* @note		The MMULT hardware must be initialized with N and NPrime
+* 			using XHdcp22Rx_Pkcs1MontMultFiosInit.
+*****************************************************************************/
+static void XHdcp22Rx_Pkcs1MontMult(XHdcp22_Rx *InstancePtr, u32 *U, u32 *A,
+	u32 *B, u32 *N, const u32 *NPrime, int NDigits)
+{
+#ifndef _XHDCP22_RX_SW_MMULT_
+	/* N and NPrime are already loaded in the hardware */
+	(void)N;
+	(void)NPrime;
+	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, U, A, B, NDigits);
+#else
+	(void)InstancePtr;
+	XHdcp22Rx_Pkcs1MontMultFiosStub(U, A, B, N, NPrime, NDigits);
+#endif
+}
+
 /****************************************************************************/
 /**
 * This function performs the modular exponentation operation using the
-* binary square and multiply method.
+* left-to-right sliding window method. The odd powers Abar^1, Abar^3, ...,
+* Abar^(2^w-1) are computed first. The exponent is then scanned from the
+* most significant set bit, each window of up to w bits ending in a set bit
+* costs one multiplication with a table entry, and each bit costs one
+* squaring. For a 512 bit exponent and w=4 this takes about 620 Montgomery
+* multiplications instead of about 770 with binary square and multiply.
 *
 * C = ModExp(A, E, N) = A^E*mod(N)
 *
@@ -922,9 +974,16 @@ static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	u32 *E, u32 *N, const u32 *NPrime, int NDigits)
 {
 	int Offset;
+	int Low;
+	int Bit;
+	int Window;
+	u8  Started = FALSE;
 	u32 R[XHDCP22_RX_N_SIZE/4];
 	u32 Abar[XHDCP22_RX_N_SIZE/4];
 	u32 Xbar[XHDCP22_RX_N_SIZE/4];
+	u32 Table[XHDCP22_RX_MONTEXP_TABLE][XHDCP22_RX_P_SIZE/4];
+
+	Xil_AssertNonvoid(NDigits <= XHDCP22_RX_P_SIZE/4);
 
 	memset(R, 0, sizeof(R));
 	memset(Abar, 0, sizeof(Abar));
@@ -944,34 +1003,71 @@ static int XHdcp22Rx_Pkcs1MontExp(XHdcp22_Rx *InstancePtr, u32 *C, u32 *A,
 	/* Step 2: Abar = A*R*mod(N) */
 	mpModMult(Abar, A, Xbar, N, 2*NDigits);
 
-	/* Step 3: Binary square and multiply */
-	for(Offset=32*NDigits-1; Offset>=0; Offset--)
+	/* Step 3: Table[i] = Abar^(2i+1), Abar is reused for Abar^2 */
+	memcpy(Table[0], Abar, 4*NDigits);
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, Abar, Abar, Abar, N, NPrime, NDigits);
+	for(Window=1; Window<XHDCP22_RX_MONTEXP_TABLE; Window++)
 	{
-#ifndef _XHDCP22_RX_SW_MMULT_
-		XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Xbar, NDigits);
-#else
-		XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Xbar, N, NPrime, NDigits);
-#endif
+		XHdcp22Rx_Pkcs1MontMult(InstancePtr, Table[Window], Table[Window-1],
+			Abar, N, NPrime, NDigits);
+	}
+
+	/* Step 4: Sliding window square and multiply */
+	for(Offset=32*NDigits-1; Offset>=0; )
+	{
+		if(mpGetBit(E, NDigits, Offset) == FALSE)
+		{
+			/* Squaring Xbar=R is not needed before the first window */
+			if(Started == TRUE)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N,
+					NPrime, NDigits);
+			}
+			Offset--;
+			continue;
+		}
 
-		if(mpGetBit(E, NDigits, Offset) == TRUE)
+		/* Longest window of at most w bits that ends in a set bit */
+		Low = Offset - XHDCP22_RX_MONTEXP_WINDOW + 1;
+		if(Low < 0)
 		{
-#ifndef _XHDCP22_RX_SW_MMULT_
-			XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, Xbar, Xbar, Abar, NDigits);
-#else
-			XHdcp22Rx_Pkcs1MontMultFiosStub(Xbar, Xbar, Abar, N, NPrime, NDigits);
-#endif
+			Low = 0;
+		}
+		while(mpGetBit(E, NDigits, Low) == FALSE)
+		{
+			Low++;
+		}
+
+		Window = 0;
+		for(Bit=Offset; Bit>=Low; Bit--)
+		{
+			Window = (Window << 1) | mpGetBit(E, NDigits, Bit);
+			if(Started == TRUE)
+			{
+				XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Xbar, N,
+					NPrime, NDigits);
+			}
+		}
+
+		/* The first window loads the table entry instead of multiplying R */
+		if(Started == TRUE)
+		{
+			XHdcp22Rx_Pkcs1MontMult(InstancePtr, Xbar, Xbar, Table[Window >> 1],
+				N, NPrime, NDigits);
+		}
+		else
+		{
+			memcpy(Xbar, Table[Window >> 1], 4*NDigits);
+			Started = TRUE;
 		}
+		Offset = Low - 1;
 	}
 
-	/* Step 4: C=MonPro(Xbar,1) */
+	/* Step 5: C=MonPro(Xbar,1) */
 	memset(R, 0, sizeof(R));
 	R[0] = 1;
 
-#ifndef _XHDCP22_RX_SW_MMULT_
-	XHdcp22Rx_Pkcs1MontMultFios(InstancePtr, C, Xbar, R, NDigits);
-#else
-	XHdcp22Rx_Pkcs1MontMultFiosStub(C, Xbar, R, N, NPrime, NDigits);
-#endif
+	XHdcp22Rx_Pkcs1MontMult(InstancePtr, C, Xbar, R, N, NPrime, NDigits);
 
 	return XST_SUCCESS;
 }
@@ -1008,18 +1104,20 @@ static void XHdcp22Rx_Xor(u8 *Cout, const u8 *Ain, const u8 *Bin, u32 Len)
 * @param	Rtx is the Tx random generated value.
 * @param	Km is the master key generated by tx.
 * @param	Rn is the 64-bit psuedo-random nonce generated by the transmitter.
-* @param	Ctr is the 64-bit AES counter value.
-* @param	DKey is the 128-bit derived key.
+* @param	Ctr is the AES counter value of the first key.
+* @param	NumKeys is the number of consecutive keys to derive.
+* @param	DKey is the NumKeys x 128-bit derived keys.
 *
 * @return	None.
 *
 * @note		None.
 ******************************************************************************/
 static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
-	const u8 *Rn, u8 *Ctr, u8 *DKey)
+	const u8 *Rn, u32 Ctr, u32 NumKeys, u8 *DKey)
 {
 	u8 Aes_Iv[XHDCP22_RX_AES_SIZE];
 	u8 Aes_Key[XHDCP22_RX_AES_SIZE];
+	XHdcp22Cmn_Aes128Ctx AesCtx;
 
 	/* Verify arguments */
 	Xil_AssertVoid(Rrx != NULL);
@@ -1036,16 +1134,63 @@ static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 
 	/* AES Input = Rtx || (Rrx xor Ctr) */
 	memcpy(Aes_Iv, Rtx, XHDCP22_RX_RTX_SIZE);
-	if(Ctr == NULL)
-	{
-		memcpy(&Aes_Iv[XHDCP22_RX_RRX_SIZE], Rrx, XHDCP22_RX_RRX_SIZE);
-	}
-	else
-	{
-		XHdcp22Rx_Xor(Aes_Iv+XHDCP22_RX_RTX_SIZE, Rrx, Ctr, XHDCP22_RX_RRX_SIZE);
-	}
+	memcpy(&Aes_Iv[XHDCP22_RX_RTX_SIZE], Rrx, XHDCP22_RX_RRX_SIZE);
+
+	XHdcp22Cmn_Aes128SetKey(&AesCtx, Aes_Key);
+	XHdcp22Cmn_Aes128DeriveKeys(&AesCtx, Aes_Iv, Ctr, DKey, NumKeys);
+
+	memset(&AesCtx, 0, sizeof(AesCtx));
+	memset(Aes_Key, 0, sizeof(Aes_Key));
+}
+
+/*****************************************************************************/
+/**
+* This function computes the HMAC-SHA256 keys used for H', L', V' and M'.
+* They only depend on Km, Rrx and Rtx, so they are computed once per
+* session and each hash only compresses its own message.
+*
+* Reference: HDCP v2.2, sections 2.2 and 2.3
+*
+* @param	Rrx is the Rx random generated value.
+* @param	Rtx is the Tx random generated value.
+* @param	Km is the master key generated by tx.
+* @param	HmacKeysPtr is a pointer to the keys to set up.
+*
+* @return	None.
+*
+* @note		None.
+******************************************************************************/
+void XHdcp22Rx_ComputeHmacKeys(const u8 *Rrx, const u8 *Rtx, const u8 *Km,
+	XHdcp22_Rx_HmacKeys *HmacKeysPtr)
+{
+	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
+	u8 HashKey[XHDCP22_RX_HASH_SIZE];
+
+	/* Verify arguments */
+	Xil_AssertVoid(Rrx != NULL);
+	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(Km != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
+
+	/* Generate derived keys dkey0 and dkey1
+	   HashKey Kd = dkey0 || dkey1 */
+	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, 0, 2, Kd);
+
+	/* H' and V': Kd */
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->Kd, Kd, XHDCP22_RX_KD_SIZE);
+
+	/* L': Kd[256:64] || (Kd[63:0] xor Rrx) */
+	memcpy(HashKey, Kd, XHDCP22_RX_KD_SIZE);
+	XHdcp22Rx_Xor(HashKey+(XHDCP22_RX_KD_SIZE-XHDCP22_RX_RRX_SIZE),
+		Kd+(XHDCP22_RX_KD_SIZE-XHDCP22_RX_RRX_SIZE), Rrx, XHDCP22_RX_RRX_SIZE);
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->KdRrx, HashKey, XHDCP22_RX_KD_SIZE);
+
+	/* M': SHA256(Kd) */
+	XHdcp22Cmn_Sha256Hash(Kd, XHDCP22_RX_KD_SIZE, HashKey);
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->Sha256Kd, HashKey, XHDCP22_RX_HASH_SIZE);
 
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, DKey);
+	memset(Kd, 0, sizeof(Kd));
+	memset(HashKey, 0, sizeof(HashKey));
 }
 
 /*****************************************************************************/
@@ -1055,39 +1200,30 @@ static void XHdcp22Rx_ComputeDKey(const u8* Rrx, const u8* Rtx, const u8 *Km,
 *
 * Reference: HDCP v2.2, section 2.2
 *
-* @param	Rrx is the Rx random generated value.
 * @param	RxCaps are the capabilities of the receiver.
 * @param	Rtx is the Tx random generated value.
 * @param	TxCaps are the capabilities of the receiver.
-* @param	Km is the master key generated by tx.
+* @param	HmacKeysPtr is a pointer to the HMAC keys of the session
+*		set up by XHdcp22Rx_ComputeHmacKeys.
 * @param	HPrime is a pointer to the HPrime hash from the HDCP2.2 receiver.
 *
 * @return	None.
 *
 * @note		None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
-	const u8 *TxCaps, const u8 *Km, u8 *HPrime)
+void XHdcp22Rx_ComputeHPrime(const u8 *RxCaps, const u8* Rtx, const u8 *TxCaps,
+	const XHdcp22_Rx_HmacKeys *HmacKeysPtr, u8 *HPrime)
 {
 	u8 HashInput[XHDCP22_RX_RTX_SIZE + XHDCP22_RX_RXCAPS_SIZE + XHDCP22_RX_TXCAPS_SIZE];
 	int Idx = 0;
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
-
 
 	/* Verify arguments */
-	Xil_AssertVoid(Rrx != NULL);
 	Xil_AssertVoid(RxCaps != NULL);
 	Xil_AssertVoid(Rtx != NULL);
 	Xil_AssertVoid(TxCaps != NULL);
-	Xil_AssertVoid(Km != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(HPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
-
 	/* HashInput = Rtx || RxCaps || TxCaps */
 	memcpy(HashInput, Rtx, XHDCP22_RX_RTX_SIZE);
 	Idx += XHDCP22_RX_RTX_SIZE;
@@ -1096,7 +1232,7 @@ void XHdcp22Rx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps, const u8* Rtx,
 	memcpy(&HashInput[Idx], TxCaps, XHDCP22_RX_TXCAPS_SIZE);
 
 	/* Compute H' = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, sizeof(HashInput), Kd, XHDCP22_RX_KD_SIZE, HPrime);
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->Kd, HashInput, sizeof(HashInput), HPrime);
 }
 
 /*****************************************************************************/
@@ -1140,40 +1276,22 @@ void XHdcp22Rx_ComputeEkh(const u8 *KprivRx, const u8 *Km, const u8 *M, u8 *Ekh)
 * Reference: HDCP v2.2, section 2.3
 *
 * @param	Rn is the 64-bit psuedo-random nonce generated by the transmitter.
-* @param	Km is the 128-bit master key generated by tx.
-* @param	Rrx is the 64-bit pseudo-random number generated by the receiver.
-* @param	Rtx is the 64-bit pseudo-random number generated by the transmitter.
+* @param	HmacKeysPtr is a pointer to the HMAC keys of the session.
 * @param	LPrime is the 256-bit value generated for locality check.
 *
 * @return	None.
 *
 * @note		None.
 ******************************************************************************/
-void XHdcp22Rx_ComputeLPrime(const u8 *Rn, const u8 *Km, const u8 *Rrx, const u8 *Rtx, u8 *LPrime)
+void XHdcp22Rx_ComputeLPrime(const u8 *Rn, const XHdcp22_Rx_HmacKeys *HmacKeysPtr, u8 *LPrime)
 {
-	u8 HashKey[XHDCP22_RX_KD_SIZE];
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
-
 	/* Verify arguments */
 	Xil_AssertVoid(Rn != NULL);
-	Xil_AssertVoid(Km != NULL);
-	Xil_AssertVoid(Rrx != NULL);
-	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(LPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
-
-	/* HashKey = Kd[256:64] || (Kd[63:0] xor Rrx) */
-	memcpy(HashKey, Kd, XHDCP22_RX_KD_SIZE);
-	XHdcp22Rx_Xor(HashKey+(XHDCP22_RX_KD_SIZE-XHDCP22_RX_RRX_SIZE),
-		Kd+(XHDCP22_RX_KD_SIZE-XHDCP22_RX_RRX_SIZE), Rrx, XHDCP22_RX_RRX_SIZE);
-
-	/* LPrime = HMAC-SHA256(Rn, HashKey) */
-	XHdcp22Cmn_HmacSha256Hash(Rn, XHDCP22_RX_RN_SIZE, HashKey, XHDCP22_RX_KD_SIZE, LPrime);
+	/* LPrime = HMAC-SHA256(Rn, Kd[256:64] || (Kd[63:0] xor Rrx)) */
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->KdRrx, Rn, XHDCP22_RX_RN_SIZE, LPrime);
 }
 
 /*****************************************************************************/
@@ -1197,7 +1315,6 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 	     const u8 *Eks, u8 *Ks)
 {
 	u8 Dkey2[XHDCP22_RX_KS_SIZE];
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02};
 
 	/* Verify arguments */
 	Xil_AssertVoid(Rrx != NULL);
@@ -1208,7 +1325,7 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 	Xil_AssertVoid(Ks != NULL);
 
 	/* Generate derived key dkey2 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, Rn, Ctr, Dkey2);
+	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, Rn, 2, 1, Dkey2);
 
 	/* Compute Ks = EKs xor (Dkey2 xor Rrx) */
 	memcpy(Ks, Dkey2, XHDCP22_RX_KS_SIZE);
@@ -1229,9 +1346,8 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 *         There can be between 1 and 31 devices in the list.
 * @param  RxInfo is the 16-bit field in the RepeaterAuth_Send_ReceiverID_List
 *         message.
-* @param  Km is the 128-bit master key generated by tx.
-* @param  Rrx is the 64-bit pseudo-random number generated by the receiver.
-* @param  Rtx is the 64-bit pseudo-random number generated by the transmitter.
+* @param  SeqNumV is the 24-bit sequence number of the message.
+* @param  HmacKeysPtr is a pointer to the HMAC keys of the session.
 * @param  VPrime is the 256-bit value generated for repeater authentication.
 *
 * @return None.
@@ -1239,8 +1355,8 @@ void XHdcp22Rx_ComputeKs(const u8* Rrx, const u8* Rtx, const u8 *Km, const u8 *R
 * @note   None.
 ******************************************************************************/
 void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
-       const u8 *RxInfo, const u8 *SeqNumV, const u8 *Km, const u8 *Rrx,
-       const u8 *Rtx, u8 *VPrime)
+       const u8 *RxInfo, const u8 *SeqNumV,
+       const XHdcp22_Rx_HmacKeys *HmacKeysPtr, u8 *VPrime)
 {
 	int Idx = 0;
 	u8 HashInput[XHDCP22_RX_SEQNUMV_SIZE +
@@ -1248,24 +1364,15 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 					(XHDCP22_RX_MAX_DEVICE_COUNT*XHDCP22_RX_RCVID_SIZE)];
 	int HashInputSize = (ReceiverIdListSize*XHDCP22_RX_RCVID_SIZE) +
 					XHDCP22_RX_SEQNUMV_SIZE + XHDCP22_RX_RXINFO_SIZE;
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
 
 	/* Verify arguments */
 	Xil_AssertVoid(ReceiverIdList != NULL);
 	Xil_AssertVoid(ReceiverIdListSize > 0);
 	Xil_AssertVoid(RxInfo != NULL);
 	Xil_AssertVoid(SeqNumV != NULL);
-	Xil_AssertVoid(Km != NULL);
-	Xil_AssertVoid(Rrx != NULL);
-	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(VPrime != NULL);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
-
 	/* HashInput = ReceiverIdList || RxInfo || SeqNumV */
 	memcpy(HashInput, ReceiverIdList, ReceiverIdListSize*XHDCP22_RX_RCVID_SIZE);
 	Idx += ReceiverIdListSize*XHDCP22_RX_RCVID_SIZE;
@@ -1274,7 +1381,7 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 	memcpy(&HashInput[Idx], SeqNumV, XHDCP22_RX_SEQNUMV_SIZE);
 
 	/* VPrime = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, HashInputSize, Kd, XHDCP22_RX_KD_SIZE, VPrime);
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->Kd, HashInput, HashInputSize, VPrime);
 }
 
 /*****************************************************************************/
@@ -1288,9 +1395,7 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 * 			  message.
 * @param  SeqNumM is the 24-bit field in the RepeaterAuth_Stream_Manage
 * 			  message.
-* @param  Km is the 128-bit master key generated by tx.
-* @param  Rrx is the 64-bit pseudo-random number generated by the receiver.
-* @param  Rtx is the 64-bit pseudo-random number generated by the transmitter.
+* @param  HmacKeysPtr is a pointer to the HMAC keys of the session.
 * @param  MPrime is the 256-bit value generated for repeater stream
 *         management ready.
 *
@@ -1299,20 +1404,15 @@ void XHdcp22Rx_ComputeVPrime(const u8 *ReceiverIdList, u32 ReceiverIdListSize,
 * @note	  None.
 ******************************************************************************/
 void XHdcp22Rx_ComputeMPrime(const u8 *StreamIdType, const u8 *SeqNumM,
-       const u8 *Km, const u8 *Rrx, const u8 *Rtx, u8 *MPrime)
+       const XHdcp22_Rx_HmacKeys *HmacKeysPtr, u8 *MPrime)
 {
 	int Idx = 0;
 	u8 HashInput[XHDCP22_RX_STREAMID_SIZE + XHDCP22_RX_SEQNUMM_SIZE];
-	u8 HashKey[XHDCP22_RX_HASH_SIZE];
-	u8 Ctr[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01};
-	u8 Kd[2 * XHDCP22_RX_AES_SIZE]; /* dkey0 || dkey 1 */
 
 	/* Verify arguments */
 	Xil_AssertVoid(StreamIdType != NULL);
 	Xil_AssertVoid(SeqNumM != NULL);
-	Xil_AssertVoid(Km != NULL);
-	Xil_AssertVoid(Rrx != NULL);
-	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(MPrime != NULL);
 
 	/* HashInput = StreamIdType || SeqNumM */
@@ -1320,16 +1420,8 @@ void XHdcp22Rx_ComputeMPrime(const u8 *StreamIdType, const u8 *SeqNumM,
 	Idx += XHDCP22_RX_STREAMID_SIZE;
 	memcpy(&HashInput[Idx], SeqNumM, XHDCP22_RX_SEQNUMM_SIZE);
 
-	/* Generate derived keys dkey0 and dkey1
-	   HashKey Kd = dkey0 || dkey1 */
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, NULL, Kd);
-	XHdcp22Rx_ComputeDKey(Rrx, Rtx, Km, NULL, Ctr, Kd+XHDCP22_RX_AES_SIZE);
-
-	/* Hashkey = SHA256(Kd) */
-	XHdcp22Cmn_Sha256Hash(Kd, XHDCP22_RX_KD_SIZE, HashKey);
-
-	/* VPrime = HMAC-SHA256(HashInput, Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, sizeof(HashInput), HashKey, XHDCP22_RX_HASH_SIZE, MPrime);
+	/* MPrime = HMAC-SHA256(HashInput, SHA256(Kd)) */
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->Sha256Kd, HashInput, sizeof(HashInput), MPrime);
 }
 
 /** @} */
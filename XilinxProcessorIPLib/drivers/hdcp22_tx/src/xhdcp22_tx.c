@@ -71,6 +71,8 @@
 *                          buffer.
 *                       6. Check return status of DDC write/read when polling
 *                          RxStatus register.
+* 2.40  agt    10/17/26 The HMAC keys of L', V and M are computed once on the
+*                       transition to state A2.
 * </pre>
 *
 ******************************************************************************/
@@ -365,6 +367,7 @@ int XHdcp22Tx_CfgInitialize(XHdcp22_Tx *InstancePtr, XHdcp22_Tx_Config *CfgPtr,
 	InstancePtr->Info.IsEnabled = (FALSE);
 	InstancePtr->Info.StateContext = NULL;
 	InstancePtr->Info.MsgAvailable = (FALSE);
+	memset(&InstancePtr->Info.HmacKeys, 0x00, sizeof(InstancePtr->Info.HmacKeys));
 	InstancePtr->Info.PollingValue = XHDCP22_TX_DEFAULT_RX_STATUS_POLLVALUE;
 
 	/* Topology info */
@@ -2115,8 +2118,6 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA2_1(XHdcp22_Tx *InstancePtr)
 	int Result = XST_SUCCESS;
 	u8 LPrime[XHDCP22_TX_H_PRIME_SIZE];
 
-	XHdcp22_Tx_PairingInfo *PairingInfoPtr =
-	                       (XHdcp22_Tx_PairingInfo *)InstancePtr->Info.StateContext;
 	XHdcp22_Tx_DDCMessage *MsgPtr =
 	                      (XHdcp22_Tx_DDCMessage *)InstancePtr->MessageBuffer;
 
@@ -2152,8 +2153,7 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA2_1(XHdcp22_Tx *InstancePtr)
 	/* Verify the received L' */
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
 	XHDCP22_TX_LOG_DBG_COMPUTE_L);
-	XHdcp22Tx_ComputeLPrime(InstancePtr->Info.Rn, PairingInfoPtr->Km,
-	                        InstancePtr->Info.Rrx, InstancePtr->Info.Rtx,
+	XHdcp22Tx_ComputeLPrime(InstancePtr->Info.Rn, &InstancePtr->Info.HmacKeys,
 	                        LPrime);
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG,
 		XHDCP22_TX_LOG_DBG_COMPUTE_L_DONE);
@@ -2369,8 +2369,6 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA6_A7_A8(XHdcp22_Tx *InstancePtr)
 	 * so clear the topology available flag */
 	InstancePtr->Info.IsTopologyAvailable = (FALSE);
 
-	XHdcp22_Tx_PairingInfo *PairingInfoPtr =
-		(XHdcp22_Tx_PairingInfo *)InstancePtr->Info.StateContext;
 	XHdcp22_Tx_DDCMessage *MsgPtr =
 		(XHdcp22_Tx_DDCMessage *)InstancePtr->MessageBuffer;
 	/* Wait for the receiver to respond within 3 secs.
@@ -2431,13 +2429,11 @@ static XHdcp22_Tx_StateType XHdcp22Tx_StateA6_A7_A8(XHdcp22_Tx *InstancePtr)
 
 	/* Verify the received VPrime */
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_COMPUTE_V);
-	XHdcp22Tx_ComputeV(InstancePtr->Info.Rn, InstancePtr->Info.Rrx,
-		MsgPtr->Message.RepeatAuthSendRecvIDList.RxInfo,
-		InstancePtr->Info.Rtx,
+	XHdcp22Tx_ComputeV(MsgPtr->Message.RepeatAuthSendRecvIDList.RxInfo,
 		(u8 *)MsgPtr->Message.RepeatAuthSendRecvIDList.ReceiverIDs,
 		DeviceCount,
 		MsgPtr->Message.RepeatAuthSendRecvIDList.SeqNum_V,
-		PairingInfoPtr->Km,
+		&InstancePtr->Info.HmacKeys,
 		V);
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_COMPUTE_V_DONE);
 
@@ -2750,6 +2746,7 @@ static void XHdcp22Tx_A1A0(XHdcp22_Tx *InstancePtr)
 * which means that state A2 is executed for the first time.
 * The locality check counter is initialized.
 * Subsequent locality checks are then executed for an extra 1023 times.
+* The HMAC keys used for L', V and M are computed for this session.
 *
 * @param  InstancePtr is a pointer to the XHdcp22Tx core instance.
 *
@@ -2760,7 +2757,13 @@ static void XHdcp22Tx_A1A0(XHdcp22_Tx *InstancePtr)
 ******************************************************************************/
 static void XHdcp22Tx_A1A2(XHdcp22_Tx *InstancePtr)
 {
+	XHdcp22_Tx_PairingInfo *PairingInfoPtr =
+	                       (XHdcp22_Tx_PairingInfo *)InstancePtr->Info.StateContext;
+
 	InstancePtr->Info.LocalityCheckCounter = 0;
+
+	XHdcp22Tx_ComputeHmacKeys(InstancePtr->Info.Rrx, InstancePtr->Info.Rtx,
+	                          PairingInfoPtr->Km, &InstancePtr->Info.HmacKeys);
 }
 
 /*****************************************************************************/
@@ -3425,6 +3428,9 @@ static void XHdcp22Tx_HandleAuthenticationFailed(XHdcp22_Tx * InstancePtr)
 {
 	InstancePtr->Info.AuthenticationStatus = XHDCP22_TX_AUTHENTICATION_BUSY;
 
+	/* The session keys are no longer used */
+	memset(&InstancePtr->Info.HmacKeys, 0x00, sizeof(InstancePtr->Info.HmacKeys));
+
      /* Run user callback */
 	if (InstancePtr->IsUnauthenticatedCallbackSet)
 		InstancePtr->UnauthenticatedCallback(InstancePtr->UnauthenticatedCallbackRef);
@@ -3719,8 +3725,6 @@ static int XHdcp22Tx_WriteRepeaterAuth_Send_Ack(XHdcp22_Tx *InstancePtr, const u
 ******************************************************************************/
 static int XHdcp22Tx_WriteRepeaterAuth_Stream_Manage(XHdcp22_Tx *InstancePtr)
 {
-	XHdcp22_Tx_PairingInfo *PairingInfoPtr =
-		(XHdcp22_Tx_PairingInfo *)InstancePtr->Info.StateContext;
 	XHdcp22_Tx_DDCMessage* MsgPtr =
 		(XHdcp22_Tx_DDCMessage*)InstancePtr->MessageBuffer;
 
@@ -3745,13 +3749,10 @@ static int XHdcp22Tx_WriteRepeaterAuth_Stream_Manage(XHdcp22_Tx *InstancePtr)
 	/* To make verifying the MPrime from the repeater easier,
 	 * the M is calculated and stored before executing the write */
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_COMPUTE_M);
-	XHdcp22Tx_ComputeM(InstancePtr->Info.Rn,
-		InstancePtr->Info.Rrx,
-		InstancePtr->Info.Rtx,
-		MsgPtr->Message.RepeatAuthStreamManage.StreamID_Type,
+	XHdcp22Tx_ComputeM(MsgPtr->Message.RepeatAuthStreamManage.StreamID_Type,
 		MsgPtr->Message.RepeatAuthStreamManage.K,
 		MsgPtr->Message.RepeatAuthStreamManage.SeqNum_M,
-		PairingInfoPtr->Km,
+		&InstancePtr->Info.HmacKeys,
 		InstancePtr->Info.M);
 	XHdcp22Tx_LogWr(InstancePtr, XHDCP22_TX_LOG_EVT_DBG, XHDCP22_TX_LOG_DBG_COMPUTE_M_DONE);
 
@@ -82,6 +82,8 @@
 * 2.01  MH     02/28/17 Fixed compiler warnings.
 * 2.20  MH     04/12/17 Added function XHdcp22Tx_IsDwnstrmCapable.
 * 2.30  MH     07/06/17 Changed default polling value to 10 ms.
+* 2.40  agt    10/17/26 Added the HMAC-SHA256 session keys HmacKeys to
+*                       XHdcp22_Tx_Info.
 * </pre>
 *
 ******************************************************************************/
@@ -104,6 +106,7 @@ extern "C" {
 #include "xtmrctr.h"
 #include "xhdcp22_cipher.h"
 #include "xhdcp22_rng.h"
+#include "xhdcp22_common.h"
 
 /************************** Constant Definitions *****************************/
 
@@ -316,6 +319,18 @@ typedef struct {
 	u8 Ekh_Km[16];       /**< Ekh(Km). */
      u8 Ready;            /**< Indicates a valid entry */
 } XHdcp22_Tx_PairingInfo;
+
+/**
+* This typedef contains the HMAC-SHA256 keys of an authentication session.
+* They are derived from Km, Rtx and Rrx once before the locality check, so
+* each L', V and M costs only the compressions of its message.
+*/
+typedef struct {
+	XHdcp22Cmn_HmacSha256Ctx Kd;       /**< Kd, the key of V. */
+	XHdcp22Cmn_HmacSha256Ctx KdRrx;    /**< Kd XOR Rrx, the key of L'. */
+	XHdcp22Cmn_HmacSha256Ctx Sha256Kd; /**< SHA256(Kd), the key of M. */
+} XHdcp22_Tx_HmacKeys;
+
 /**
 * This typedef contains information about the HDCP22 transmitter.
 */
@@ -332,6 +347,7 @@ typedef struct
 	void *StateContext;                 /**< Context used internally by the state machine. */
 	u16  LocalityCheckCounter;          /**< Locality may attempt 1024 times. */
 	u8 MsgAvailable;                    /**< Message is available for reading. */
+	XHdcp22_Tx_HmacKeys HmacKeys;       /**< HMAC keys of L', V and M. */
 
 	XHdcp22_Tx_PairingInfo PairingInfo[XHDCP22_TX_MAX_STORED_PAIRINGINFO];
 	/** The result after a call to #XHdcp22Tx_Poll. */
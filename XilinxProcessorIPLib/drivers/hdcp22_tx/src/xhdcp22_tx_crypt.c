@@ -49,6 +49,11 @@
 *                       Signature verification has been updated to
 *                       check entire encoded message EM including
 *                       padding PS.
+* 2.40  agt    10/17/26 XHdcp22Tx_RsaEncryptMsg uses Montgomery exponentiation
+*                       instead of mpModExp for an odd modulus.
+* 2.40  agt    10/17/26 Added XHdcp22Tx_ComputeHmacKeys. L', V and M use the
+*                       HMAC keys of the session instead of deriving Kd.
+* 2.40  agt    10/17/26 Kd is derived with a single AES key setup.
 * </pre>
 *
 ******************************************************************************/
@@ -85,6 +90,8 @@ static int XHdcp22Tx_RsaSignatureVerify(const u8 *MessagePtr, int MessageSize,
                                         const u8 *SignaturePtr,
                                         const u8 *KpubDcpNPtr, int KpubDcpNSize,
                                         const u8 *KpubDcpEPtr, int KpubDcpESize);
+static void XHdcp22Tx_ComputeKd(const u8 *Rrx, const u8 *Rtx, const u8 *Km,
+                                u8 *Kd);
 
 /************************** Variable Definitions *****************************/
 
@@ -255,6 +262,7 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
 {
 	u32 n[BD_MAX_MOD_SIZE], e[BD_MAX_MOD_SIZE],
 	        m[BD_MAX_MOD_SIZE], s[BD_MAX_MOD_SIZE];
+	MP_MONT_CTX Mont;
 	unsigned int ModSize = KeyPubNSize / sizeof(u32);
 
 
@@ -267,7 +275,14 @@ static int XHdcp22Tx_RsaEncryptMsg(const u8 *KeyPubNPtr, int KeyPubNSize,
 	mpConvFromOctets(e, ModSize, KeyPubEPtr, KeyPubESize);
 
 	mpConvFromOctets(m, ModSize, MsgPtr, MsgSize);
-	mpModExp(s, m, e, n, ModSize);
+
+	/* An RSA modulus is odd, Montgomery reduction avoids the long division of mpModExp */
+	if (mpMontInit(&Mont, n, ModSize) == 0) {
+		mpMontExp(s, m, e, &Mont);
+	}
+	else {
+		mpModExp(s, m, e, n, ModSize);
+	}
 	mpConvToOctets(s, ModSize, EncryptedMsgPtr, MsgSize);
 
 	return XST_SUCCESS;
@@ -537,6 +552,44 @@ int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
 	return Result;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function computes the derived key Kd = dkey0 || dkey1.
+*
+* @param  Rrx is the Rx random generated value on start of authentication.
+* @param  Rtx is the Tx random generated value start of authentication.
+* @param  Km is the master key generated by tx.
+* @param  Kd is a pointer to the 32 byte derived key.
+*
+* @return None.
+*
+* @note   None.
+*
+******************************************************************************/
+static void XHdcp22Tx_ComputeKd(const u8 *Rrx, const u8 *Rtx, const u8 *Km,
+                                u8 *Kd)
+{
+	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
+	XHdcp22Cmn_Aes128Ctx AesCtx;
+
+	/* For key derivation, use Km XOR Rn as AES key where Rn=0 during AKE.
+	 * Note: Protocol says we should use incoming Rn and XOR it with Km,
+	 * but then the output does not match the errata output.
+	 * For now we use for Rn 0, which matches the test vectors.
+	 */
+	XHdcp22Cmn_Aes128SetKey(&AesCtx, Km);
+
+	/* Add m = Rtx || Rrx. */
+	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
+	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
+
+	/* Determine dkey0 and dkey1, the counters 0 and 1 are XORed into Rrx. */
+	XHdcp22Cmn_Aes128DeriveKeys(&AesCtx, Aes_Iv, 0, Kd, 2);
+
+	memset(&AesCtx, 0x00, sizeof(AesCtx));
+}
+
 /*****************************************************************************/
 /**
 *
@@ -566,29 +619,13 @@ void XHdcp22Tx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps,
 	Xil_AssertVoid(Km != NULL);
 	Xil_AssertVoid(HPrime != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
-	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
 	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
 
 	u8 HashInput[XHDCP22_TX_RTX_SIZE + XHDCP22_TX_RXCAPS_SIZE +
                XHDCP22_TX_TXCAPS_SIZE];
 	int Idx = 0;
 
-	/* Normally we should do: Key XOR with Rn, but Rn is 0. */
-	memcpy(Aes_Key, Km, XHDCP22_TX_KM_SIZE);
-
-	/* Determine dkey0. */
-	/* Add m = Rtx || Rrx. */
-	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
-	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
-	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
-
-	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
-
+	XHdcp22Tx_ComputeKd(Rrx, Rtx, Km, Kd);
 
 	/* Create hash with HMAC-SHA256. */
 	/* Input: Rtx || RxCaps || TxCaps. */
@@ -603,6 +640,54 @@ void XHdcp22Tx_ComputeHPrime(const u8* Rrx, const u8 *RxCaps,
                            sizeof(Kd), HPrime);
 }
 
+/*****************************************************************************/
+/**
+*
+* This function computes the HMAC-SHA256 keys used for LPrime, V and M.
+* They only depend on Km, Rrx and Rtx, so they are computed once per
+* session and each LPrime, V and M only hashes its own message.
+*
+* @param  Rrx is the random value generated by rx.
+* @param  Rtx is the random value generated by tx.
+* @param  Km is the master key generated by tx.
+* @param  HmacKeysPtr is a pointer to the keys to set up.
+*
+* @return None.
+*
+* @note   None.
+******************************************************************************/
+void XHdcp22Tx_ComputeHmacKeys(const u8 *Rrx, const u8 *Rtx, const u8 *Km,
+                               XHdcp22_Tx_HmacKeys *HmacKeysPtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(Rrx != NULL);
+	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(Km != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
+
+	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
+	u8 HashKey[XHDCP22_TX_SHA256_HASH_SIZE];
+
+	XHdcp22Tx_ComputeKd(Rrx, Rtx, Km, Kd);
+
+	/* V: Kd */
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->Kd, Kd, sizeof(Kd));
+
+	/* LPrime: Kd XOR Rrx (least sign. 64 bits). */
+	memset(HashKey, 0x00, XHDCP22_TX_SHA256_HASH_SIZE);
+	memcpy(&HashKey[XHDCP22_TX_SHA256_HASH_SIZE-XHDCP22_TX_RRX_SIZE], Rrx,
+         XHDCP22_TX_RRX_SIZE);
+	XHdcp22Tx_MemXor(HashKey, HashKey, Kd, XHDCP22_TX_SHA256_HASH_SIZE);
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->KdRrx, HashKey, sizeof(HashKey));
+
+	/* M: SHA256(Kd) */
+	XHdcp22Cmn_Sha256Hash(Kd, sizeof(Kd), HashKey);
+	XHdcp22Cmn_HmacSha256SetKey(&HmacKeysPtr->Sha256Kd, HashKey, sizeof(HashKey));
+
+	memset(Kd, 0x00, sizeof(Kd));
+	memset(HashKey, 0x00, sizeof(HashKey));
+}
+
 /*****************************************************************************/
 /**
 *
@@ -668,66 +753,31 @@ void XHdcp22Tx_ComputeEdkeyKs(const u8* Rn, const u8* Km,
 /*****************************************************************************/
 /**
 *
-* This function computes LPrime. Kd is calculated as in
-* #XHdcp22Tx_ComputeHPrime, but could also be stored the first time.
-* This could save some computing time.
-* According protocol however, only Rrx and Rtx are supposed to be stored.
+* This function computes LPrime.
 *
 * @param  Rn is a pseudo-random nonce.
-* @param  Km is the master key generated by tx and previouslyd stored.
-* @param  Rrx is the random value generated by rx.
-* @param  Rtx is the random value generated by tx.
+* @param  HmacKeysPtr is a pointer to the HMAC keys of the session,
+*         see #XHdcp22Tx_ComputeHmacKeys.
 * @param  LPrime is a pointer to the computed LPrime hash.
 *
 * @return None.
 *
 * @note   None.
 ******************************************************************************/
-void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
-                             const u8 *Rrx, const u8 *Rtx,
+void XHdcp22Tx_ComputeLPrime(const u8* Rn,
+                             const XHdcp22_Tx_HmacKeys *HmacKeysPtr,
                              u8 *LPrime)
 {
 	/* Verify arguments */
 	Xil_AssertVoid(Rn != NULL);
-	Xil_AssertVoid(Km != NULL);
-	Xil_AssertVoid(Rrx != NULL);
-	Xil_AssertVoid(Rtx != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(LPrime != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
-	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
-	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
-	u8 HashKey[XHDCP22_TX_SHA256_HASH_SIZE];
-
-	/* For key derivation, use Km XOR Rn as AES key where Rn=0 during AKE.
-	 * Note: Protocol says we should use incoming Rn and XOR it with Km,
-	 * but then the output does not match the errata output.
-	 * For now we use for Rn 0, which matches the test vectors.
-	 */
-	memcpy(Aes_Key, Km, XHDCP22_TX_KM_SIZE);
-
-	/* Compute Dkey0. */
-	/* Add m = Rtx || Rrx. */
-	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
-	/* Rrx XOR Ctr0, where Ctr0 is 0. */
-	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
-
-	/* Compute Dkey0 , counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
-
-
 	/* Create hash with HMAC-SHA256. */
 	/* Input: Rn. */
 	/* Key:	Kd XOR Rrx (least sign. 64 bits). */
-	memset(HashKey, 0x00, XHDCP22_TX_SHA256_HASH_SIZE);
-	memcpy(&HashKey[XHDCP22_TX_SHA256_HASH_SIZE-XHDCP22_TX_RRX_SIZE], Rrx,
-         XHDCP22_TX_RRX_SIZE);
-	XHdcp22Tx_MemXor(HashKey, HashKey, Kd, XHDCP22_TX_SHA256_HASH_SIZE);
-	XHdcp22Cmn_HmacSha256Hash(Rn, XHDCP22_TX_RN_SIZE, HashKey,
-                           XHDCP22_TX_SHA256_HASH_SIZE, LPrime);
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->KdRrx, Rn, XHDCP22_TX_RN_SIZE,
+                          LPrime);
 }
 
 /*****************************************************************************/
@@ -735,7 +785,12 @@ void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
 *
 * This function computes V
 *
-* @param
+* @param  RxInfo is the RxInfo field of the receiver ID list message.
+* @param  RecvIDList is the list of receiver IDs.
+* @param  RecvIDCount is the number of receiver IDs in RecvIDList.
+* @param  SeqNum_V is the seq_num_V field of the receiver ID list message.
+* @param  HmacKeysPtr is a pointer to the HMAC keys of the session,
+*         see #XHdcp22Tx_ComputeHmacKeys.
 * @param  V is a pointer to the computed V hash.
 *
 * @return None.
@@ -743,44 +798,20 @@ void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
 * @note   None.
 *
 ******************************************************************************/
-void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
-	const u8* Rtx, const u8* RecvIDList, const u8 RecvIDCount,
-	const u8* SeqNum_V, const u8* Km, u8* V)
+void XHdcp22Tx_ComputeV(const u8* RxInfo, const u8* RecvIDList,
+                        const u8 RecvIDCount, const u8* SeqNum_V,
+                        const XHdcp22_Tx_HmacKeys *HmacKeysPtr, u8* V)
 {
 	/* Verify arguments */
-	Xil_AssertVoid(Rn != NULL);
-	Xil_AssertVoid(Rrx != NULL);
 	Xil_AssertVoid(RxInfo != NULL);
 	Xil_AssertVoid(SeqNum_V != NULL);
-	Xil_AssertVoid(Km != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(V != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
-	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
-	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
-
 	u8 HashInput[(XHDCP22_TX_REPEATER_MAX_DEVICE_COUNT * XHDCP22_TX_RCVID_SIZE) +
 		XHDCP22_TX_RXINFO_SIZE + XHDCP22_TX_SEQ_NUM_V_SIZE];
 	int Idx = 0;
 
-	/* For key derivation, use Km XOR Rn as AES key where Rn=0 during AKE.
-	* Note: Protocol says we should use incoming Rn and XOR it with Km,
-	* but then the output does not match the errata output.
-	* For now we use for Rn 0, which matches the test vectors.
-	*/
-	memcpy(Aes_Key, Km, XHDCP22_TX_KM_SIZE);
-
-	/* Determine dkey0. */
-	/* Add m = Rtx || Rrx. */
-	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
-	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
-	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
-	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
-
 	/* Create hash with HMAC-SHA256. */
 	/* Input: ReceiverID list || RxInfo || seq_num_V. */
 	memcpy(HashInput, RecvIDList, (RecvIDCount*XHDCP22_TX_RCVID_SIZE));
@@ -790,7 +821,7 @@ void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
 	memcpy(&HashInput[Idx], SeqNum_V, XHDCP22_TX_SEQ_NUM_V_SIZE);
 	Idx += XHDCP22_TX_SEQ_NUM_V_SIZE;
 	/* HashKey:	Kd*/
-	XHdcp22Cmn_HmacSha256Hash(HashInput, Idx, Kd, sizeof(Kd), V);
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->Kd, HashInput, Idx, V);
 }
 
 /*****************************************************************************/
@@ -798,7 +829,11 @@ void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
 *
 * This function computes M
 *
-* @param
+* @param  StreamIDType is the StreamID_Type list.
+* @param  k is the number of streams, big endian.
+* @param  SeqNum_M is the seq_num_M value.
+* @param  HmacKeysPtr is a pointer to the HMAC keys of the session,
+*         see #XHdcp22Tx_ComputeHmacKeys.
 * @param  M is a pointer to the computed M hash.
 *
 * @return None.
@@ -806,26 +841,17 @@ void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
 * @note   None.
 *
 ******************************************************************************/
-void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
-	const u8* StreamIDType, const u8* k,
-	const u8* SeqNum_M, const u8* Km, u8* M)
+void XHdcp22Tx_ComputeM(const u8* StreamIDType, const u8* k,
+                        const u8* SeqNum_M,
+                        const XHdcp22_Tx_HmacKeys *HmacKeysPtr, u8* M)
 {
 	/* Verify arguments */
-	Xil_AssertVoid(Rn != NULL);
-	Xil_AssertVoid(Rrx != NULL);
-	Xil_AssertVoid(Rtx != NULL);
 	Xil_AssertVoid(StreamIDType != NULL);
 	Xil_AssertVoid(k != NULL);
 	Xil_AssertVoid(SeqNum_M != NULL);
-	Xil_AssertVoid(Km != NULL);
+	Xil_AssertVoid(HmacKeysPtr != NULL);
 	Xil_AssertVoid(M != NULL);
 
-	u8 Aes_Iv[XHDCP22_TX_AES128_SIZE];
-	u8 Aes_Key[XHDCP22_TX_AES128_SIZE];
-	u8 Kd[2 * XHDCP22_TX_AES128_SIZE]; /* Dkey0 || Dkey 1. */
-
-	u8 SHA256_Kd[XHDCP22_TX_SHA256_HASH_SIZE];
-
 	u16 StreamIDCount;
 
 	/* K value is in big endian format */
@@ -836,27 +862,6 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 		XHDCP22_TX_RXINFO_SIZE + XHDCP22_TX_SEQ_NUM_M_SIZE];
 	int Idx = 0;
 
-	/* For key derivation, use Km XOR Rn as AES key where Rn=0 during AKE.
-	* Note: Protocol says we should use incoming Rn and XOR it with Km,
-	* but then the output does not match the errata output.
-	* For now we use for Rn 0, which matches the test vectors.
-	*/
-	memcpy(Aes_Key, Km, XHDCP22_TX_KM_SIZE);
-
-	/* Determine dkey0. */
-	/* Add m = Rtx || Rrx. */
-	memcpy(Aes_Iv, Rtx, XHDCP22_TX_RTX_SIZE);
-	/* Normally we should do Rrx XOR with Ctr0, but Ctr0 is 0. */
-	memcpy(&Aes_Iv[XHDCP22_TX_RTX_SIZE], Rrx, XHDCP22_TX_RRX_SIZE);
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, Kd);
-
-	/* Determine dkey1, counter is 1: Rrx | 0x01. */
-	Aes_Iv[15] ^= 0x01; /* big endian! */
-	XHdcp22Cmn_Aes128Encrypt(Aes_Iv, Aes_Key, &Kd[XHDCP22_TX_KM_SIZE]);
-
-	/* Create hash with SHA256 */
-	XHdcp22Cmn_Sha256Hash(Kd, sizeof(Kd), SHA256_Kd);
-
 	/* Create hash with HMAC-SHA256. */
 	/* Input: StreamID_Type list || seq_num_M. */
 	memcpy(HashInput, StreamIDType, (StreamIDCount*XHDCP22_TX_STREAMID_TYPE_SIZE));
@@ -864,7 +869,7 @@ void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
 	memcpy(&HashInput[Idx], SeqNum_M, XHDCP22_TX_SEQ_NUM_M_SIZE);
 	Idx += XHDCP22_TX_SEQ_NUM_M_SIZE;
 	/* HashKey:	SHA256(Kd) */
-	XHdcp22Cmn_HmacSha256Hash(HashInput, Idx, SHA256_Kd, sizeof(SHA256_Kd), M);
+	XHdcp22Cmn_HmacSha256Mac(&HmacKeysPtr->Sha256Kd, HashInput, Idx, M);
 }
 
 /*****************************************************************************/
@@ -48,6 +48,8 @@
 * 2.01  MH     02/13/17 1. Updated maximum locality check count
 *                       from 128 to 8 to avoid delays in re-auth.
 *                       2. Added log events for failures.
+* 2.40  agt    10/17/26 Added XHdcp22Tx_ComputeHmacKeys. L', V and M are
+*                       computed with the HMAC keys of the session.
 * </pre>
 *
 ******************************************************************************/
@@ -496,15 +498,17 @@ int XHdcp22Tx_VerifySRM(const u8* SrmPtr, int SrmSize,
 void XHdcp22Tx_ComputeHPrime(const u8 *Rrx, const u8 *RxCaps,
                              const u8* Rtx,  const u8 *TxCaps,
                              const u8 *Km, u8 *HPrime);
-void XHdcp22Tx_ComputeLPrime(const u8* Rn, const u8 *Km,
-                             const u8 *Rrx, const u8 *Rtx,
+void XHdcp22Tx_ComputeHmacKeys(const u8 *Rrx, const u8 *Rtx, const u8 *Km,
+                               XHdcp22_Tx_HmacKeys *HmacKeysPtr);
+void XHdcp22Tx_ComputeLPrime(const u8* Rn,
+                             const XHdcp22_Tx_HmacKeys *HmacKeysPtr,
                              u8 *LPrime);
-void XHdcp22Tx_ComputeV(const u8* Rn, const u8* Rrx, const u8* RxInfo,
-	                    const u8* Rtx, const u8* RecvIDList, const u8 RecvIDCount,
-	                    const u8* SeqNum_V, const u8* Km, u8* V);
-void XHdcp22Tx_ComputeM(const u8* Rn, const u8* Rrx, const u8* Rtx,
-                        const u8* StreamIDType, const u8* k,
-                        const u8* SeqNum_M, const u8* Km, u8* M);
+void XHdcp22Tx_ComputeV(const u8* RxInfo, const u8* RecvIDList,
+                        const u8 RecvIDCount, const u8* SeqNum_V,
+                        const XHdcp22_Tx_HmacKeys *HmacKeysPtr, u8* V);
+void XHdcp22Tx_ComputeM(const u8* StreamIDType, const u8* k,
+                        const u8* SeqNum_M,
+                        const XHdcp22_Tx_HmacKeys *HmacKeysPtr, u8* M);
 void XHdcp22Tx_ComputeEdkeyKs(const u8* Rn, const u8* Km,
                               const u8 *Ks, const u8 *Rrx,
                               const u8 *Rtx,  u8 *EdkeyKs);
@@ -0,0 +1,485 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file schedbench.c
+*		Host tests of the MCDMA channel scheduler. xmcdma_sched.c is
+*		built for Linux and driven through XMcdma_SchedSignal() with a
+*		service callback that retires packets from simulated channel
+*		rings instead of calling XMcdma_BdChainFromHW(). Like that
+*		function, the callback only returns whole packets, which may
+*		span several BDs.
+*
+*		The tests check
+*		- the argument checks of XMcdma_SchedSetWeight()
+*		- the shares of saturated channels against their quanta, with
+*		  packets of one BD and of several BDs
+*		- that no channel leaves the pending set while complete
+*		  packets are left, for multi BD packets, visits cut at any
+*		  BD limit and packets still being received
+*		- the worst case wait of lightly loaded channels against one
+*		  round of budgets, compared with a model of the fixed
+*		  channel order of XMcdma_IntrHandler()
+*
+*		Usage: schedbench [-n ticks]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.2   agt  10/17/26 First release, replaces xmcdma_sched_sim_example.c
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xmcdma.h"
+#include "bench.h"
+
+#define SIM_NUM_CHANS		4	/* Simulated channels */
+#define SIM_RING_SIZE		256	/* BDs per simulated channel */
+#define SIM_RING_PKTS		256	/* Packets per simulated channel */
+#define SIM_TICK_BDS		40	/* BDs serviced per tick */
+#define SIM_SHARE_TOL_PCT	2	/* Allowed share error in percent */
+#define SIM_LIGHT_PERIOD	7	/* Ticks between light channel BDs */
+#define SIM_DRAIN_PKTS		50	/* Packets per channel, drain test */
+#define SIM_MAX_RUNS		100000	/* Runs before a drain test gives up */
+
+/* Simulated channel: a ring of complete packets and one being received */
+typedef struct {
+	u8 PktBds[SIM_RING_PKTS];	/* BDs of each packet, oldest first */
+	u32 Head;		/* Oldest packet */
+	u32 NumPkts;		/* Complete packets not serviced yet */
+	u32 ReadyBds;		/* BDs of the complete packets */
+	u32 PartialBds;		/* BDs of a packet not complete yet */
+	u32 Dropped;		/* Packets lost because the ring was full */
+} SimChan;
+
+/* Weights of the channels in one test */
+typedef struct {
+	u32 Quantum[SIM_NUM_CHANS];
+	u32 Budget;
+	u32 MaxPktBds[SIM_NUM_CHANS];
+} SimWeights;
+
+static SimChan SimChans[SIM_NUM_CHANS];
+static XMcdma SimMcdma;		/* Never touched by XMcdma_SchedRun() */
+static XMcdma_Sched Sched;
+static u32 Ticks = 2000;
+static u32 RandState = 0x2545F491;
+
+/* Channel 1 gets twice the share of channel 2, packets of one BD */
+static const SimWeights SingleBd = {
+	{ 16, 8, 4, 4 }, 16, { 1, 1, 1, 1 }
+};
+
+/*
+ * Packets of up to MaxPktBds BDs, with quanta that are no multiple of the
+ * packet sizes so that visits end with credits that do not cover the next
+ * packet
+ */
+static const SimWeights MultiBd = {
+	{ 16, 8, 7, 5 }, 20, { 3, 5, 2, 4 }
+};
+
+/*****************************************************************************/
+/*
+* xorshift32, the tests are repeatable
+*/
+static u32 rand32(void)
+{
+	RandState ^= RandState << 13;
+	RandState ^= RandState >> 17;
+	RandState ^= RandState << 5;
+	return RandState;
+}
+
+/*****************************************************************************/
+/*
+* Service callback of the scheduler. Retires the oldest complete packets of
+* the simulated channel as long as they fit in BdLimit, as
+* XMcdma_BdChainFromHW() does.
+*/
+static u32 SimServiceHandler(void *CallBackRef, u32 Chan_Id, u32 BdLimit)
+{
+	SimChan *ChanPtr = &((SimChan *)CallBackRef)[Chan_Id - 1];
+	u32 Done = 0;
+
+	while ((ChanPtr->NumPkts != 0) &&
+	       (ChanPtr->PktBds[ChanPtr->Head] <= (BdLimit - Done))) {
+		Done += ChanPtr->PktBds[ChanPtr->Head];
+		ChanPtr->Head = (ChanPtr->Head + 1) % SIM_RING_PKTS;
+		ChanPtr->NumPkts--;
+	}
+	ChanPtr->ReadyBds -= Done;
+
+	return Done;
+}
+
+/*****************************************************************************/
+/*
+* Completes NumPkts packets of PktBds BDs on a simulated channel, or of 1 to
+* MaxPktBds BDs at random when PktBds is 0, and signals the channel as
+* XMcdma_SchedHarvest() does for an IOC interrupt.
+*/
+static void SimComplete(u32 Chan, u32 NumPkts, u32 PktBds, u32 MaxPktBds)
+{
+	SimChan *ChanPtr = &SimChans[Chan];
+	u32 Bds;
+
+	while (NumPkts--) {
+		Bds = PktBds ? PktBds : 1 + (rand32() % MaxPktBds);
+		if ((ChanPtr->ReadyBds + ChanPtr->PartialBds + Bds >
+		     SIM_RING_SIZE) || (ChanPtr->NumPkts == SIM_RING_PKTS)) {
+			ChanPtr->Dropped++;
+			continue;
+		}
+		ChanPtr->PktBds[(ChanPtr->Head + ChanPtr->NumPkts) %
+				SIM_RING_PKTS] = (u8)Bds;
+		ChanPtr->NumPkts++;
+		ChanPtr->ReadyBds += Bds;
+	}
+
+	if (ChanPtr->NumPkts) {
+		XMcdma_SchedSignal(&Sched, 1U << Chan);
+	}
+}
+
+/*****************************************************************************/
+/*
+* Sets up the scheduler with the given weights and empties the simulated
+* channels.
+*/
+static int SimReset(const SimWeights *Weights)
+{
+	u32 Chan;
+	int Status = XST_SUCCESS;
+
+	(void)XMcdma_SchedInitialize(&Sched, &SimMcdma, XMCDMA_DEV_TO_MEM,
+				     SIM_NUM_CHANS);
+	XMcdma_SchedSetHandler(&Sched, SimServiceHandler, SimChans);
+
+	memset(SimChans, 0, sizeof(SimChans));
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		if (XMcdma_SchedSetWeight(&Sched, Chan + 1,
+					  Weights->Quantum[Chan],
+					  Weights->Budget,
+					  Weights->MaxPktBds[Chan]) !=
+		    XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/*
+* XMcdma_SchedSetWeight() refuses weights that would let a visit end on a
+* packet the quantum can never cover.
+*/
+static void test_weights(void)
+{
+	(void)XMcdma_SchedInitialize(&Sched, &SimMcdma, XMCDMA_DEV_TO_MEM,
+				     SIM_NUM_CHANS);
+
+	check("weight: quantum below the largest packet refused",
+	      XMcdma_SchedSetWeight(&Sched, 1, 2, 8, 3) == XST_INVALID_PARAM);
+	check("weight: budget below the quantum refused",
+	      XMcdma_SchedSetWeight(&Sched, 1, 8, 4, 1) == XST_INVALID_PARAM);
+	check("weight: packet of 0 BDs refused",
+	      XMcdma_SchedSetWeight(&Sched, 1, 8, 8, 0) == XST_INVALID_PARAM);
+	check("weight: channel out of range refused",
+	      XMcdma_SchedSetWeight(&Sched, SIM_NUM_CHANS + 1, 8, 8, 1) ==
+	      XST_INVALID_PARAM);
+	check("weight: quantum equal to the largest packet accepted",
+	      XMcdma_SchedSetWeight(&Sched, 1, 3, 3, 3) == XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/*
+* Fairness: every channel always has more complete packets than the
+* scheduler can service, so each must get a share of the BDs proportional
+* to its quantum.
+*/
+static void test_fairness(const char *Name, const SimWeights *Weights)
+{
+	u32 Tick, Chan;
+	u32 QuantumSum = 0;
+	u32 Expected, Actual;
+	char Line[80];
+	int Ok;
+
+	Ok = (SimReset(Weights) == XST_SUCCESS);
+
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		QuantumSum += Weights->Quantum[Chan];
+	}
+
+	for (Tick = 0; Tick < Ticks; Tick++) {
+		for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+			SimComplete(Chan, SIM_TICK_BDS, 0,
+				    Weights->MaxPktBds[Chan]);
+		}
+		(void)XMcdma_SchedRun(&Sched, SIM_TICK_BDS);
+	}
+
+	printf("fairness %s: %u BDs serviced in %u rounds\n", Name,
+	       Sched.BdCnt, Sched.RoundCnt);
+
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		/* Shares in units of 0.01 percent */
+		Expected = (Weights->Quantum[Chan] * 10000) / QuantumSum;
+		Actual = (u32)(((u64)Sched.Chan[Chan].BdCnt * 10000) /
+			       Sched.BdCnt);
+
+		printf("  chan %u quantum %2u max packet %u BDs: share "
+		       "%u.%02u%% (expected %u.%02u%%)\n", Chan + 1,
+		       Weights->Quantum[Chan], Weights->MaxPktBds[Chan],
+		       Actual / 100, Actual % 100,
+		       Expected / 100, Expected % 100);
+
+		if (((Actual > Expected) ? (Actual - Expected) :
+		     (Expected - Actual)) > (SIM_SHARE_TOL_PCT * 100)) {
+			Ok = 0;
+		}
+	}
+
+	snprintf(Line, sizeof(Line), "fairness %s", Name);
+	check(Line, Ok);
+}
+
+/*****************************************************************************/
+/*
+* Drain: the channels are signalled once with SIM_DRAIN_PKTS multi BD packets
+* each and XMcdma_SchedRun() is called with BD limits of 1 to 24 until no
+* channel is pending. Without new signals a channel that leaves the pending
+* set with complete packets left would keep them until an unrelated
+* interrupt, so every ring must be empty at the end. Channels 2 and 4 also
+* have a packet that is still being received, which the callback cannot
+* return and which must not keep them pending.
+*/
+static void test_drain(void)
+{
+	u32 Runs = 0;
+	u32 Chan;
+	u32 Left = 0;
+	int Ok;
+
+	Ok = (SimReset(&MultiBd) == XST_SUCCESS);
+
+	SimChans[1].PartialBds = 2;
+	SimChans[3].PartialBds = 1;
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		SimComplete(Chan, SIM_DRAIN_PKTS, 0, MultiBd.MaxPktBds[Chan]);
+	}
+
+	while (Sched.PendingMask && (Runs < SIM_MAX_RUNS)) {
+		(void)XMcdma_SchedRun(&Sched, 1 + (rand32() % 24));
+		Runs++;
+	}
+
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		Left += SimChans[Chan].NumPkts;
+		if (SimChans[Chan].NumPkts) {
+			printf("  chan %u: %u packets (%u BDs) left\n",
+			       Chan + 1, SimChans[Chan].NumPkts,
+			       SimChans[Chan].ReadyBds);
+		}
+	}
+	printf("drain: %u runs, %u BDs serviced, %u packets left\n", Runs,
+	       Sched.BdCnt, Left);
+
+	check("drain: no complete packet left behind", Ok && (Left == 0));
+	check("drain: partial packets do not keep channels pending",
+	      Sched.PendingMask == 0);
+
+	/* The same with the limit of XMcdma_SchedIntrHandler() */
+	Ok = (SimReset(&MultiBd) == XST_SUCCESS);
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		SimComplete(Chan, SIM_DRAIN_PKTS, 0, MultiBd.MaxPktBds[Chan]);
+	}
+	(void)XMcdma_SchedRun(&Sched, XMCDMA_SCHED_NO_LIMIT);
+	Left = 0;
+	for (Chan = 0; Chan < SIM_NUM_CHANS; Chan++) {
+		Left += SimChans[Chan].NumPkts;
+	}
+	check("drain: no limit, no complete packet left behind",
+	      Ok && (Left == 0) && (Sched.PendingMask == 0));
+}
+
+/*****************************************************************************/
+/*
+* Model of the fixed channel order servicing of XMcdma_IntrHandler(): the
+* signalled channels are serviced in channel number order, each until it is
+* drained, here with at most BdLimit BDs per tick. Tracks the same wait
+* statistic as the scheduler.
+*/
+static void SimFixedOrderRun(u32 BdLimit, u32 *BdCnt, u32 *SignalBdCnt,
+			     u32 *MaxWait, u32 *Serviced)
+{
+	u32 Chan, Done;
+
+	for (Chan = 0; (Chan < SIM_NUM_CHANS) && BdLimit; Chan++) {
+		if (!SimChans[Chan].NumPkts) {
+			continue;
+		}
+		if ((*BdCnt - SignalBdCnt[Chan]) > MaxWait[Chan]) {
+			MaxWait[Chan] = *BdCnt - SignalBdCnt[Chan];
+		}
+
+		Done = SimServiceHandler(SimChans, Chan + 1, BdLimit);
+		*BdCnt += Done;
+		Serviced[Chan] += Done;
+		BdLimit -= Done;
+		SignalBdCnt[Chan] = *BdCnt;
+	}
+}
+
+/*****************************************************************************/
+/*
+* Latency: channel 1 is saturated and the other channels complete one BD
+* every SIM_LIGHT_PERIOD ticks. The worst case wait of the light channels,
+* in BDs serviced on other channels, must stay within one round of budgets.
+* The same traffic is run through the fixed order model for comparison,
+* where the light channels are starved.
+*/
+static void test_latency(void)
+{
+	u32 Tick, Chan;
+	u32 Bound = (SIM_NUM_CHANS - 1) * SingleBd.Budget;
+	u32 FixedBdCnt = 0;
+	u32 FixedSignal[SIM_NUM_CHANS] = {0};
+	u32 FixedMaxWait[SIM_NUM_CHANS] = {0};
+	u32 FixedServiced[SIM_NUM_CHANS] = {0};
+	u32 Pass;
+	int Ok = 1;
+
+	for (Pass = 0; Pass < 2; Pass++) {
+		(void)SimReset(&SingleBd);
+
+		for (Tick = 0; Tick < Ticks; Tick++) {
+			SimComplete(0, SIM_TICK_BDS * 2, 1, 1);
+
+			/* Light traffic arrives in the middle of a tick */
+			if (Pass == 0) {
+				(void)XMcdma_SchedRun(&Sched, SIM_TICK_BDS / 2);
+			} else {
+				SimFixedOrderRun(SIM_TICK_BDS / 2, &FixedBdCnt,
+						 FixedSignal, FixedMaxWait,
+						 FixedServiced);
+			}
+
+			for (Chan = 1; Chan < SIM_NUM_CHANS; Chan++) {
+				if ((Tick % SIM_LIGHT_PERIOD) != Chan) {
+					continue;
+				}
+				if (!SimChans[Chan].NumPkts) {
+					FixedSignal[Chan] = FixedBdCnt;
+				}
+				SimComplete(Chan, 1, 1, 1);
+			}
+
+			if (Pass == 0) {
+				(void)XMcdma_SchedRun(&Sched, SIM_TICK_BDS / 2);
+			} else {
+				SimFixedOrderRun(SIM_TICK_BDS / 2, &FixedBdCnt,
+						 FixedSignal, FixedMaxWait,
+						 FixedServiced);
+			}
+		}
+
+		if (Pass == 1) {
+			break;
+		}
+
+		printf("latency: worst case wait in BDs, bound %u\n", Bound);
+		for (Chan = 1; Chan < SIM_NUM_CHANS; Chan++) {
+			printf("  chan %u drr: wait %u serviced %u\n",
+			       Chan + 1, Sched.Chan[Chan].MaxWait,
+			       Sched.Chan[Chan].BdCnt);
+			if ((Sched.Chan[Chan].MaxWait > Bound) ||
+			    (Sched.Chan[Chan].BdCnt == 0)) {
+				Ok = 0;
+			}
+		}
+	}
+
+	for (Chan = 1; Chan < SIM_NUM_CHANS; Chan++) {
+		if (FixedServiced[Chan] == 0) {
+			printf("  chan %u fixed order: starved\n", Chan + 1);
+		} else {
+			printf("  chan %u fixed order: wait %u serviced %u\n",
+			       Chan + 1, FixedMaxWait[Chan],
+			       FixedServiced[Chan]);
+		}
+	}
+
+	check("latency: light channels wait at most one round", Ok);
+}
+
+static void usage(const char *Prog)
+{
+	fprintf(stderr, "usage: %s [-n ticks]\n", Prog);
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "n:")) != -1) {
+		switch (Opt) {
+		case 'n':
+			Ticks = (u32)atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+	if (Ticks == 0) {
+		usage(argv[0]);
+	}
+
+	test_weights();
+	test_fairness("1 BD packets", &SingleBd);
+	test_fairness("multi BD packets", &MultiBd);
+	test_drain();
+	test_latency();
+
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	return 0;
+}
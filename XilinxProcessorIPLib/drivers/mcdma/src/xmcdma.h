@@ -62,6 +62,20 @@
 * The users of this driver have to register this handler with the interrupt
 * system and provide the callback functions by using XMcdma_SetCallBack  API.
 *
+* <b> Channel scheduler </b>
+*
+* XMcdma_IntrHandler() services the signalled channels in channel number
+* order, so a busy low numbered channel can delay the others. The channel
+* scheduler in xmcdma_sched.c is an alternative. XMcdma_SchedHarvest() reads
+* the interrupt serviced register once per pass, acknowledges every signalled
+* channel and marks its completions pending. XMcdma_SchedRun() then services
+* the pending channels in deficit round robin order. Each visit is bounded by
+* the channel quantum (its weight) and budget, set with
+* XMcdma_SchedSetWeight() together with the BD count of the largest packet
+* on the channel. The quantum must cover that packet, as partial packets are
+* never serviced. XMcdma_SchedIntrHandler() does both and can be connected
+* in place of XMcdma_IntrHandler()/XMcdma_TxIntrHandler().
+*
 * <b>Buffer Descriptors(BD) management </b>
 *
 * BD is shared by the software and the hardware. To use BD for SG DMA
@@ -138,6 +152,9 @@
 * 1.2   mj      05/03/18 Exported APIs XMcdma_BdChainFree() and
 *                        XMcDma_BdSetAppWord().
 * 1.2   mus    11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
+* 1.2   agt    10/17/26 Added deficit round robin channel scheduler with
+*                        per channel weights, budgets and a completion
+*                        batcher (xmcdma_sched.c).
 ******************************************************************************/
 #ifndef XMCDMA_H_
 #define XMCDMA_H_
@@ -169,6 +186,13 @@ extern "C" {
 #define XMCDMA_DEV_TO_MEM		0
 #define XMCDMA_MEM_TO_DEV		1
 
+/* Channel scheduler */
+#define XMCDMA_SCHED_MAX_CHAN		16  /**< Channels per direction */
+#define XMCDMA_SCHED_DEF_QUANTUM	8   /**< Default BDs per round */
+#define XMCDMA_SCHED_DEF_BUDGET		16  /**< Default BDs per visit */
+#define XMCDMA_SCHED_DEF_MAX_PKT_BDS	1   /**< Default BDs per packet */
+#define XMCDMA_SCHED_NO_LIMIT		0xFFFFFFFFU
+
 /**************************** Type Definitions *******************************/
 
 typedef enum {
@@ -196,6 +220,16 @@ typedef void (*XMcdma_ChanDoneHandler) (void *CallBackRef);
 typedef void (*XMcdma_ChanErrorHandler) (void *CallBackRef, u32 ErrorMask);
 typedef void (*XMcdma_ChanPktDropHandler) (void *CallBackRef);
 
+/**
+ * Channel service callback of the scheduler. It must process at most BdLimit
+ * completed BDs of Chan_Id, in whole packets as XMcdma_BdChainFromHW()
+ * returns them, and return the number it processed. The scheduler takes the
+ * channel as drained when the callback stops although the largest packet of
+ * the channel would still have fit in BdLimit.
+ */
+typedef u32 (*XMcdma_SchedHandler) (void *CallBackRef, u32 Chan_Id,
+				    u32 BdLimit);
+
 typedef enum {
 	XMCDMA_FIXED_PRIORITY,
 	XMCDMA_WRR,
@@ -293,6 +327,40 @@ typedef struct {
 	                                     * interrupt callback */
 
 } XMcdma;
+
+/**
+ * Per channel state of the deficit round robin scheduler.
+ */
+typedef struct {
+	u32 Quantum;		/**< BD credits granted each round */
+	u32 Budget;		/**< Most BDs serviced in one visit */
+	u32 MaxPktBds;		/**< BDs of the largest packet */
+	u32 Deficit;		/**< Credits carried into the next round */
+	u32 Waiting;		/**< Signalled but not visited yet */
+	u32 SignalBdCnt;	/**< Scheduler BD count when signalled */
+	u32 BdCnt;		/**< BDs serviced on this channel */
+	u32 VisitCnt;		/**< Visits to this channel */
+	u32 MaxWait;		/**< Most BDs serviced on other channels
+				  *  between a signal and the first visit */
+} XMcdma_SchedChan;
+
+/**
+ * Deficit round robin scheduler for the channels of one direction.
+ */
+typedef struct {
+	XMcdma *InstancePtr;	/**< MCDMA instance the channels belong to */
+	u32 Direction;		/**< XMCDMA_DEV_TO_MEM or XMCDMA_MEM_TO_DEV */
+	u32 NumChans;		/**< Channels scheduled, from Chan_Id 1 */
+	u32 PendingMask;	/**< Bit (Chan_Id - 1) set while pending */
+	u32 NextChan;		/**< Index the next visit starts from */
+	u32 VisitLeft;		/**< BDs left in a visit cut by BdLimit */
+	u32 BdCnt;		/**< BDs serviced on all channels */
+	u32 RoundCnt;		/**< Completed rounds */
+	XMcdma_SchedHandler Handler;	/**< Channel service callback */
+	void *HandlerRef;	/**< Passed to the service callback */
+	XMcdma_SchedChan Chan[XMCDMA_SCHED_MAX_CHAN];
+} XMcdma_Sched;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -637,6 +705,18 @@ s32 XMcdma_SetCallBack(XMcdma *InstancePtr, XMcdma_Handler HandlerType,
 void XMcdma_ChanIntrHandler(void *Instance);
 s32 XMcdma_ChanSetCallBack(XMcdma_ChanCtrl *Chan, XMcdma_ChanHandler HandlerType,
 			      void *CallBackFunc, void *CallBackRef);
+/* Channel scheduler */
+s32 XMcdma_SchedInitialize(XMcdma_Sched *SchedPtr, XMcdma *InstancePtr,
+			   u32 Direction, u32 NumChans);
+s32 XMcdma_SchedSetWeight(XMcdma_Sched *SchedPtr, u32 Chan_Id, u32 Quantum,
+			  u32 Budget, u32 MaxPktBds);
+void XMcdma_SchedSetHandler(XMcdma_Sched *SchedPtr,
+			    XMcdma_SchedHandler Handler, void *CallBackRef);
+void XMcdma_SchedSignal(XMcdma_Sched *SchedPtr, u32 ChanMask);
+u32 XMcdma_SchedHarvest(XMcdma_Sched *SchedPtr);
+u32 XMcdma_SchedRun(XMcdma_Sched *SchedPtr, u32 BdLimit);
+void XMcdma_SchedIntrHandler(void *Instance);
+void XMcdma_SchedResetStats(XMcdma_Sched *SchedPtr);
 #ifdef __cplusplus
 }
 
@@ -0,0 +1,547 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xmcdma_sched.c
+* @addtogroup mcdma_v1_2
+* @{
+*
+* This file implements a deficit round robin scheduler for the channels of
+* one direction of the MCDMA core.
+*
+* Completions are harvested from the interrupt serviced register in batches.
+* XMcdma_SchedHarvest() acknowledges every signalled channel in one pass and
+* marks the channels with completions pending. XMcdma_SchedRun() then visits
+* the pending channels in round robin order. On every visit a channel gets
+* its quantum of BD credits and is serviced through the scheduler callback
+* for up to min(credits, budget) BDs. The callback only services whole
+* packets, so a visit can end with credits left that do not cover the next
+* packet. Credits that are not used because the budget was reached or the
+* next packet did not fit are carried into the next round. A channel is
+* drained when the callback stops while the largest packet of the channel
+* would still have fit; it then leaves the pending set and loses its carried
+* credits. Channels are therefore serviced in proportion to their quantum,
+* and a channel that was just signalled never waits for more than one round.
+*
+* XMcdma_SchedRun() does not access the hardware, so it can also be driven
+* with XMcdma_SchedSignal() and a callback that fakes BD completions. This is
+* what the host bench in ../bench does.
+*
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.2    agt    10/17/26 Initial version.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xmcdma.h"
+
+/************************** Function Prototypes ******************************/
+
+static void XMcdma_SchedAdvance(XMcdma_Sched *SchedPtr);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a channel scheduler. All channels get the default
+* quantum and budget and nothing is pending.
+*
+* @param	SchedPtr is a pointer to the scheduler to be initialized.
+* @param	InstancePtr is a pointer to the XMcdma instance whose channels
+*		are scheduled.
+* @param	Direction is XMCDMA_DEV_TO_MEM for the S2MM (Rx) channels or
+*		XMCDMA_MEM_TO_DEV for the MM2S (Tx) channels.
+* @param	NumChans is the number of channels, starting at Chan_Id 1.
+*
+* @return
+*		- XST_SUCCESS if the scheduler was initialized.
+*		- XST_INVALID_PARAM if NumChans is out of range.
+*
+* @note		The service callback must be set with XMcdma_SchedSetHandler()
+*		before the scheduler is run.
+*
+******************************************************************************/
+s32 XMcdma_SchedInitialize(XMcdma_Sched *SchedPtr, XMcdma *InstancePtr,
+			   u32 Direction, u32 NumChans)
+{
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid((Direction == XMCDMA_DEV_TO_MEM) ||
+			  (Direction == XMCDMA_MEM_TO_DEV));
+
+	if ((NumChans == 0) || (NumChans > XMCDMA_SCHED_MAX_CHAN)) {
+		return XST_INVALID_PARAM;
+	}
+
+	SchedPtr->InstancePtr = InstancePtr;
+	SchedPtr->Direction = Direction;
+	SchedPtr->NumChans = NumChans;
+	SchedPtr->PendingMask = 0;
+	SchedPtr->NextChan = 0;
+	SchedPtr->VisitLeft = 0;
+	SchedPtr->Handler = NULL;
+	SchedPtr->HandlerRef = NULL;
+
+	for (Index = 0; Index < XMCDMA_SCHED_MAX_CHAN; Index++) {
+		SchedPtr->Chan[Index].Quantum = XMCDMA_SCHED_DEF_QUANTUM;
+		SchedPtr->Chan[Index].Budget = XMCDMA_SCHED_DEF_BUDGET;
+		SchedPtr->Chan[Index].MaxPktBds = XMCDMA_SCHED_DEF_MAX_PKT_BDS;
+		SchedPtr->Chan[Index].Deficit = 0;
+	}
+
+	XMcdma_SchedResetStats(SchedPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the weight of a channel.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+* @param	Chan_Id is the channel, from 1 to the number of channels.
+* @param	Quantum is the number of BD credits the channel gets each
+*		round. Channels are serviced in proportion to their quantum.
+* @param	Budget is the largest number of BDs serviced in a single
+*		visit. It bounds the time the other channels wait.
+* @param	MaxPktBds is the number of BDs of the largest packet on the
+*		channel, 1 when every packet fits in one BD.
+*
+* @return
+*		- XST_SUCCESS if the weight was set.
+*		- XST_INVALID_PARAM if Chan_Id is out of range, MaxPktBds is 0,
+*		  Quantum is smaller than MaxPktBds or Budget is smaller than
+*		  Quantum.
+*
+* @note		Quantum must cover the largest packet because partial packets
+*		are never returned by XMcdma_BdChainFromHW(). MaxPktBds also
+*		tells a channel with no complete packet left from one whose
+*		next packet does not fit in the credits of the visit.
+*
+******************************************************************************/
+s32 XMcdma_SchedSetWeight(XMcdma_Sched *SchedPtr, u32 Chan_Id, u32 Quantum,
+			  u32 Budget, u32 MaxPktBds)
+{
+	XMcdma_SchedChan *ChanPtr;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+
+	if ((Chan_Id == 0) || (Chan_Id > SchedPtr->NumChans) ||
+	    (MaxPktBds == 0) || (Quantum < MaxPktBds) || (Budget < Quantum)) {
+		return XST_INVALID_PARAM;
+	}
+
+	ChanPtr = &SchedPtr->Chan[Chan_Id - 1];
+	ChanPtr->Quantum = Quantum;
+	ChanPtr->Budget = Budget;
+	ChanPtr->MaxPktBds = MaxPktBds;
+	ChanPtr->Deficit = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function installs the channel service callback of the scheduler.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+* @param	Handler is the callback that services a channel.
+* @param	CallBackRef is a user data item that will be passed to the
+*		callback function when it is invoked.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XMcdma_SchedSetHandler(XMcdma_Sched *SchedPtr,
+			    XMcdma_SchedHandler Handler, void *CallBackRef)
+{
+	/* Verify arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(Handler != NULL);
+
+	SchedPtr->Handler = Handler;
+	SchedPtr->HandlerRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function marks channels as having completions to service.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+* @param	ChanMask has bit (Chan_Id - 1) set for each channel to mark.
+*
+* @return	None.
+*
+* @note		XMcdma_SchedHarvest() calls this for the channels signalled by
+*		the hardware. Polled mode users and simulations can call it
+*		directly.
+*
+******************************************************************************/
+void XMcdma_SchedSignal(XMcdma_Sched *SchedPtr, u32 ChanMask)
+{
+	XMcdma_SchedChan *ChanPtr;
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+
+	ChanMask &= ((1U << SchedPtr->NumChans) - 1U);
+
+	for (Index = 0; ChanMask >> Index; Index++) {
+		if (!(ChanMask & (1U << Index))) {
+			continue;
+		}
+
+		ChanPtr = &SchedPtr->Chan[Index];
+		if (!ChanPtr->Waiting) {
+			ChanPtr->Waiting = 1;
+			ChanPtr->SignalBdCnt = SchedPtr->BdCnt;
+		}
+	}
+
+	SchedPtr->PendingMask |= ChanMask;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function harvests the completion interrupts of all channels of the
+* scheduled direction.
+*
+* The interrupt serviced register is read until no channel is signalled.
+* Every signalled channel is acknowledged in the same pass. Channels with
+* IOC or delay interrupts are marked pending for XMcdma_SchedRun(). Error
+* and packet drop interrupts are reported straight away through the error
+* and packet drop callbacks of the XMcdma instance.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+*
+* @return	Mask of the channels pending service.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XMcdma_SchedHarvest(XMcdma_Sched *SchedPtr)
+{
+	XMcdma *InstancePtr;
+	XMcdma_ChanCtrl *Chan;
+	u32 SerOffset;
+	u32 Chan_SerMask;
+	u32 DoneMask = 0;
+	u32 IrqStatus;
+	u32 Chan_id;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+
+	InstancePtr = SchedPtr->InstancePtr;
+
+	if (SchedPtr->Direction == XMCDMA_DEV_TO_MEM) {
+		SerOffset = XMCDMA_RX_OFFSET + XMCDMA_RXINT_SER_OFFSET;
+	} else {
+		SerOffset = XMCDMA_TXINT_SER_OFFSET;
+	}
+
+	while (1) {
+		Chan_SerMask = XMcdma_ReadReg(InstancePtr->Config.BaseAddress,
+					      SerOffset);
+		Chan_SerMask &= ((1U << SchedPtr->NumChans) - 1U);
+		if (!Chan_SerMask) {
+			break;
+		}
+
+		for (Chan_id = 1; Chan_SerMask >> (Chan_id - 1); Chan_id++) {
+			if (!(Chan_SerMask & (1U << (Chan_id - 1)))) {
+				continue;
+			}
+
+			if (SchedPtr->Direction == XMCDMA_DEV_TO_MEM) {
+				Chan = XMcdma_GetMcdmaRxChan(InstancePtr,
+							     Chan_id);
+			} else {
+				Chan = XMcdma_GetMcdmaTxChan(InstancePtr,
+							     Chan_id);
+			}
+
+			/* Acknowledge pending interrupts */
+			IrqStatus = XMcdma_ChanGetIrq(Chan);
+			XMcdma_ChanAckIrq(Chan, IrqStatus);
+
+			if (IrqStatus & (XMCDMA_IRQ_DELAY_MASK |
+					 XMCDMA_IRQ_IOC_MASK)) {
+				Chan->ChanState = XMCDMA_CHAN_IDLE;
+				DoneMask |= 1U << (Chan_id - 1);
+			}
+
+			if ((IrqStatus & XMCDMA_IRQ_PKTDROP_MASK) &&
+			    (InstancePtr->PktDropHandler != NULL)) {
+				Chan->ChanState = XMCDMA_CHAN_IDLE;
+				InstancePtr->PktDropHandler(
+					InstancePtr->PktDropRef, Chan_id);
+			}
+
+			if (IrqStatus & XMCDMA_IRQ_ERROR_MASK) {
+				Chan->ChanState = XMCDMA_CHAN_PAUSE;
+				if ((SchedPtr->Direction ==
+				     XMCDMA_DEV_TO_MEM) &&
+				    (InstancePtr->ErrorHandler != NULL)) {
+					InstancePtr->ErrorHandler(
+						InstancePtr->ErrorRef,
+						Chan_id, IrqStatus);
+				} else if ((SchedPtr->Direction ==
+					    XMCDMA_MEM_TO_DEV) &&
+					   (InstancePtr->TxErrorHandler !=
+					    NULL)) {
+					InstancePtr->TxErrorHandler(
+						InstancePtr->TxErrorRef,
+						Chan_id, IrqStatus);
+				}
+			}
+		}
+	}
+
+	XMcdma_SchedSignal(SchedPtr, DoneMask);
+
+	return SchedPtr->PendingMask;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function services the pending channels in deficit round robin order.
+*
+* Each visit adds the channel quantum to its credits and calls the service
+* callback for up to min(credits, budget) BDs. The unused credits are kept
+* while the channel stays pending. A channel whose callback stops with room
+* left for its largest packet is drained and leaves the pending set. A
+* callback that stops with less room left only ran out of credits for the
+* next packet, and the channel stays pending. A visit cut short by BdLimit
+* is resumed by the next call, so BdLimit does not skew the shares. A visit
+* is only cut where its largest packet still fits in the rest of BdLimit,
+* otherwise the call returns early.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+* @param	BdLimit is the most BDs serviced in this call, or
+*		XMCDMA_SCHED_NO_LIMIT to run until no channel is pending.
+*
+* @return	Number of BDs serviced.
+*
+* @note		Channels signalled while this function runs are only picked
+*		up by the next XMcdma_SchedHarvest()/XMcdma_SchedSignal().
+*
+******************************************************************************/
+u32 XMcdma_SchedRun(XMcdma_Sched *SchedPtr, u32 BdLimit)
+{
+	XMcdma_SchedChan *ChanPtr;
+	u32 Total = 0;
+	u32 Index;
+	u32 Limit;
+	u32 Done;
+	u32 Cut;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(SchedPtr->Handler != NULL);
+
+	while (SchedPtr->PendingMask && (Total < BdLimit)) {
+		Index = SchedPtr->NextChan;
+		if (!(SchedPtr->PendingMask & (1U << Index))) {
+			XMcdma_SchedAdvance(SchedPtr);
+			continue;
+		}
+
+		ChanPtr = &SchedPtr->Chan[Index];
+
+		/* Start a new visit unless resuming one cut short by BdLimit */
+		if (!SchedPtr->VisitLeft) {
+			ChanPtr->Deficit += ChanPtr->Quantum;
+			SchedPtr->VisitLeft = (ChanPtr->Deficit < ChanPtr->Budget) ?
+					      ChanPtr->Deficit : ChanPtr->Budget;
+			ChanPtr->VisitCnt++;
+
+			if (ChanPtr->Waiting) {
+				ChanPtr->Waiting = 0;
+				if ((SchedPtr->BdCnt - ChanPtr->SignalBdCnt) >
+				    ChanPtr->MaxWait) {
+					ChanPtr->MaxWait = SchedPtr->BdCnt -
+						ChanPtr->SignalBdCnt;
+				}
+			}
+		}
+
+		Limit = SchedPtr->VisitLeft;
+		Cut = 0;
+		if (Limit > (BdLimit - Total)) {
+			/*
+			 * A limit that cannot hold the largest packet would
+			 * make a full channel look drained, resume the visit in
+			 * the next call instead
+			 */
+			if ((BdLimit - Total) < ChanPtr->MaxPktBds) {
+				break;
+			}
+			Limit = BdLimit - Total;
+			Cut = 1;
+		}
+
+		Done = SchedPtr->Handler(SchedPtr->HandlerRef, Index + 1,
+					 Limit);
+		if (Done > Limit) {
+			Done = Limit;
+		}
+
+		ChanPtr->BdCnt += Done;
+		ChanPtr->Deficit -= Done;
+		SchedPtr->VisitLeft -= Done;
+		SchedPtr->BdCnt += Done;
+		Total += Done;
+
+		if ((Limit - Done) >= ChanPtr->MaxPktBds) {
+			/*
+			 * The largest packet would have fit, so no complete
+			 * packet is left. Drained, an idle channel does not
+			 * bank credits.
+			 */
+			SchedPtr->PendingMask &= ~(1U << Index);
+			ChanPtr->Deficit = 0;
+			SchedPtr->VisitLeft = 0;
+			XMcdma_SchedAdvance(SchedPtr);
+		} else if (!Cut) {
+			/*
+			 * The credits or the budget of the visit are used up or
+			 * do not cover the next packet, the rest is carried
+			 */
+			SchedPtr->VisitLeft = 0;
+			XMcdma_SchedAdvance(SchedPtr);
+		}
+	}
+
+	return Total;
+}
+
+/*****************************************************************************/
+/**
+*
+* Moves the scheduler on to the next channel, counting a round each time it
+* wraps around.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XMcdma_SchedAdvance(XMcdma_Sched *SchedPtr)
+{
+	if (++SchedPtr->NextChan >= SchedPtr->NumChans) {
+		SchedPtr->NextChan = 0;
+		SchedPtr->RoundCnt++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler for the channel scheduler. It can
+* be connected in place of XMcdma_IntrHandler() or XMcdma_TxIntrHandler().
+*
+* Completions are harvested and serviced in deficit round robin order until
+* no channel is pending. Channels signalled while servicing join the next
+* round.
+*
+* @param	Instance is a pointer to the XMcdma_Sched scheduler.
+*
+* @return	None.
+*
+* @note		The scheduler callback is invoked instead of the done
+*		callbacks installed with XMcdma_SetCallBack().
+*
+******************************************************************************/
+void XMcdma_SchedIntrHandler(void *Instance)
+{
+	XMcdma_Sched *SchedPtr = (XMcdma_Sched *)((void *)Instance);
+	u32 Batch = 0;
+	u32 Index;
+
+	for (Index = 0; Index < SchedPtr->NumChans; Index++) {
+		Batch += SchedPtr->Chan[Index].Budget;
+	}
+
+	/* Service one round's worth of BDs between harvests */
+	while (XMcdma_SchedHarvest(SchedPtr)) {
+		(void)XMcdma_SchedRun(SchedPtr, Batch);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the service statistics of the scheduler.
+*
+* @param	SchedPtr is a pointer to the scheduler to be worked on.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XMcdma_SchedResetStats(XMcdma_Sched *SchedPtr)
+{
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+
+	SchedPtr->BdCnt = 0;
+	SchedPtr->RoundCnt = 0;
+
+	for (Index = 0; Index < XMCDMA_SCHED_MAX_CHAN; Index++) {
+		SchedPtr->Chan[Index].Waiting = 0;
+		SchedPtr->Chan[Index].SignalBdCnt = 0;
+		SchedPtr->Chan[Index].BdCnt = 0;
+		SchedPtr->Chan[Index].VisitCnt = 0;
+		SchedPtr->Chan[Index].MaxWait = 0;
+	}
+}
+/** @} */
@@ -0,0 +1,673 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file bbmbench.c
+*		Host tests of the bad block management. xnandpsu_bbm.c is
+*		built for Linux against a flash in memory that checks that no
+*		page is programmed twice without an erase, and that can fail a
+*		journal program, leaving the page unreadable, or lose power
+*		during it.
+*
+*		The tests check
+*		- that XNandPsu_ScanBbt() creates the tables from the factory
+*		  bad block marks and finds them again
+*		- the RAM table, XNandPsu_IsBlockBad(),
+*		  XNandPsu_NextBlock(), XNandPsu_MapBlock() and
+*		  XNandPsu_GetNumGoodBlocks() against a walk of the expected
+*		  block types, after every XNandPsu_MarkBlockBad() of random
+*		  blocks with failed journal programs, and after rescans
+*		- XNandPsu_ReadMapped() against the data of the mapped blocks
+*		- that the journal ends at the first erased page and that a
+*		  full journal rewrites the tables
+*		- that a page that cannot be read or is not a journal page
+*		  ends the journal, and that the next mark rewrites the
+*		  tables instead of programming behind it
+*
+*		Usage: bbmbench [-s seed]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	   Changes
+* ----- ----   ----------  -----------------------------------------------
+* 1.5   agt    10/17/26    First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xnandpsu.h"
+#include "xnandpsu_bbm.h"
+#include "bench.h"
+
+#define SIM_PAGE_SIZE		2048U
+#define SIM_SPARE_SIZE		64U
+#define SIM_PROGRAMMED		0x1U	/* Data area programmed */
+#define SIM_SPARE_PROGRAMMED	0x2U	/* Spare area programmed */
+#define SIM_UNREADABLE		0x4U	/* Uncorrectable ECC error */
+#define SIM_WEAR_MARKS		400U
+#define SIM_NAME_LEN		80
+
+/* Flash in memory */
+static u8 *Data;
+static u8 *Spare;
+static u8 *State;
+static u32 NumBlocks;
+static u32 PagesPerBlock;
+static int Violations;		/* Programs of pages not erased, bad ranges */
+static int Erases;
+static int FailJournal;		/* Journal program that fails, 1 is the next */
+static int LoseOnFail;		/* Power is lost when it fails */
+static int PowerLost;		/* Programs and erases fail */
+
+static XNandPsu Nand;
+static u8 Ref[XNANDPSU_MAX_BLOCKS];	/* Expected type of each block */
+static u32 Seed = 1U;
+
+/*****************************************************************************/
+/*
+* Flash functions used by xnandpsu_bbm.c
+*/
+static int RangeOk(u64 Offset, u64 Length)
+{
+	u64 Size = (u64)NumBlocks * PagesPerBlock * SIM_PAGE_SIZE;
+
+	if ((Offset > Size) || (Length > (Size - Offset))) {
+		Violations++;
+		return 0;
+	}
+	return 1;
+}
+
+s32 XNandPsu_Read(XNandPsu *InstancePtr, u64 Offset, u64 Length,
+							u8 *DestBuf)
+{
+	u64 Page;
+
+	(void)InstancePtr;
+	if (!RangeOk(Offset, Length)) {
+		return XST_FAILURE;
+	}
+	for (Page = Offset / SIM_PAGE_SIZE; Page * SIM_PAGE_SIZE <
+						Offset + Length; Page++) {
+		if ((State[Page] & SIM_UNREADABLE) != 0U) {
+			return XST_FAILURE;
+		}
+	}
+	memcpy(DestBuf, Data + Offset, Length);
+	return XST_SUCCESS;
+}
+
+s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length,
+							u8 *SrcBuf)
+{
+	u32 Page = (u32)(Offset / SIM_PAGE_SIZE);
+	u64 Index;
+	int Fail = 0;
+
+	(void)InstancePtr;
+	if ((PowerLost != 0) || !RangeOk(Offset, Length)) {
+		return XST_FAILURE;
+	}
+	/* The tables are written to the first page, the journal after it */
+	if (((Page % PagesPerBlock) != 0U) && (FailJournal > 0)) {
+		FailJournal--;
+		Fail = (FailJournal == 0);
+	}
+	for (; (u64)Page * SIM_PAGE_SIZE < Offset + Length; Page++) {
+		if ((State[Page] & SIM_PROGRAMMED) != 0U) {
+			Violations++;
+		}
+		State[Page] |= SIM_PROGRAMMED;
+	}
+	for (Index = 0U; Index < Length; Index++) {
+		Data[Offset + Index] &= SrcBuf[Index];
+	}
+	if (Fail != 0) {
+		State[Offset / SIM_PAGE_SIZE] |= SIM_UNREADABLE;
+		PowerLost = LoseOnFail;
+		return XST_FAILURE;
+	}
+	return XST_SUCCESS;
+}
+
+s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block)
+{
+	u32 Page = Block * PagesPerBlock;
+
+	(void)InstancePtr;
+	if ((Target != 0U) || (Block >= NumBlocks)) {
+		Violations++;
+		return XST_FAILURE;
+	}
+	if (PowerLost != 0) {
+		return XST_FAILURE;
+	}
+	memset(Data + (u64)Page * SIM_PAGE_SIZE, 0xFF,
+				PagesPerBlock * SIM_PAGE_SIZE);
+	memset(Spare + (u64)Page * SIM_SPARE_SIZE, 0xFF,
+				PagesPerBlock * SIM_SPARE_SIZE);
+	memset(State + Page, 0, PagesPerBlock);
+	Erases++;
+	return XST_SUCCESS;
+}
+
+s32 XNandPsu_ReadSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
+{
+	(void)InstancePtr;
+	if (Page >= NumBlocks * PagesPerBlock) {
+		Violations++;
+		return XST_FAILURE;
+	}
+	if ((State[Page] & SIM_UNREADABLE) != 0U) {
+		return XST_FAILURE;
+	}
+	memcpy(Buf, Spare + (u64)Page * SIM_SPARE_SIZE, SIM_SPARE_SIZE);
+	return XST_SUCCESS;
+}
+
+s32 XNandPsu_WriteSpareBytes(XNandPsu *InstancePtr, u32 Page, u8 *Buf)
+{
+	u32 Index;
+
+	(void)InstancePtr;
+	if (Page >= NumBlocks * PagesPerBlock) {
+		Violations++;
+		return XST_FAILURE;
+	}
+	if (PowerLost != 0) {
+		return XST_FAILURE;
+	}
+	if ((State[Page] & SIM_SPARE_PROGRAMMED) != 0U) {
+		Violations++;
+	}
+	State[Page] |= SIM_SPARE_PROGRAMMED;
+	for (Index = 0U; Index < SIM_SPARE_SIZE; Index++) {
+		Spare[(u64)Page * SIM_SPARE_SIZE + Index] &= Buf[Index];
+	}
+	return XST_SUCCESS;
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+	(void)ctrl1;
+}
+
+/*****************************************************************************/
+/*
+* Flash set up and the expected state
+*/
+static u32 Rand(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+static u8 BlockType(u32 Block)
+{
+	return (u8)((Nand.Bbt[Block >> XNANDPSU_BBT_BLOCK_SHIFT] >>
+		XNandPsu_BbtBlockShift(Block)) & XNANDPSU_BLOCK_TYPE_MASK);
+}
+
+static int IsBad(u32 Block)
+{
+	return (Ref[Block] == XNANDPSU_BLOCK_BAD) ||
+		(Ref[Block] == XNANDPSU_BLOCK_FACTORY_BAD);
+}
+
+/*
+* Erased flash with factory bad blocks, marked in the first or the second
+* page, and data in the blocks before the tables
+*/
+static void Setup(u32 Blocks, u32 Pages)
+{
+	static const u32 FactoryBad[] = { 3U, 40U, 130U };
+	u64 Size = (u64)Blocks * Pages * SIM_PAGE_SIZE;
+	u64 Index;
+	u32 Page;
+	u32 Block;
+
+	NumBlocks = Blocks;
+	PagesPerBlock = Pages;
+	free(Data);
+	free(Spare);
+	free(State);
+	Data = malloc(Size);
+	Spare = malloc((u64)Blocks * Pages * SIM_SPARE_SIZE);
+	State = calloc((u64)Blocks * Pages, 1U);
+	if ((Data == NULL) || (Spare == NULL) || (State == NULL)) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	memset(Spare, 0xFF, (u64)Blocks * Pages * SIM_SPARE_SIZE);
+	for (Index = 0U; Index < Size; Index++) {
+		Data[Index] = (u8)((Index >> 2) ^ (Index / SIM_PAGE_SIZE));
+	}
+	memset(Data + (u64)(Blocks - 8U) * Pages * SIM_PAGE_SIZE, 0xFF,
+					8U * Pages * SIM_PAGE_SIZE);
+	for (Page = 0U; Page < (Blocks - 8U) * Pages; Page++) {
+		State[Page] = SIM_PROGRAMMED;
+	}
+
+	memset(Ref, XNANDPSU_BLOCK_GOOD, sizeof(Ref));
+	for (Index = 0U; Index < sizeof(FactoryBad) / sizeof(FactoryBad[0]);
+								Index++) {
+		Block = FactoryBad[Index];
+		if (Block < Blocks) {
+			Spare[(u64)Block * Pages * SIM_SPARE_SIZE] = 0x00U;
+			Ref[Block] = XNANDPSU_BLOCK_FACTORY_BAD;
+		}
+	}
+	/* In the second page, and among the table blocks */
+	Block = 17U;
+	Spare[((u64)Block * Pages + 1U) * SIM_SPARE_SIZE + 1U] = 0x00U;
+	Ref[Block] = XNANDPSU_BLOCK_FACTORY_BAD;
+	Block = Blocks - 3U;
+	Spare[(u64)Block * Pages * SIM_SPARE_SIZE] = 0x00U;
+	Ref[Block] = XNANDPSU_BLOCK_FACTORY_BAD;
+
+	Violations = 0;
+	Erases = 0;
+	FailJournal = 0;
+	LoseOnFail = 0;
+	PowerLost = 0;
+}
+
+/* Initializes the instance and scans the tables, as after a reset */
+static s32 Attach(void)
+{
+	memset(&Nand, 0, sizeof(Nand));
+	Nand.IsReady = XIL_COMPONENT_IS_READY;
+	Nand.EccMode = XNANDPSU_HWECC;
+	Nand.Geometry.BytesPerPage = SIM_PAGE_SIZE;
+	Nand.Geometry.SpareBytesPerPage = SIM_SPARE_SIZE;
+	Nand.Geometry.PagesPerBlock = PagesPerBlock;
+	Nand.Geometry.BlockSize = PagesPerBlock * SIM_PAGE_SIZE;
+	Nand.Geometry.NumTargetPages = NumBlocks * PagesPerBlock;
+	Nand.Geometry.NumTargetBlocks = NumBlocks;
+	Nand.Geometry.TargetSize = (u64)NumBlocks * Nand.Geometry.BlockSize;
+	Nand.Geometry.NumTargets = 1U;
+	Nand.Geometry.NumPages = Nand.Geometry.NumTargetPages;
+	Nand.Geometry.NumBlocks = NumBlocks;
+	Nand.Geometry.DeviceSize = Nand.Geometry.TargetSize;
+	XNandPsu_InitBbtDesc(&Nand);
+	return XNandPsu_ScanBbt(&Nand);
+}
+
+/* Creates the tables on the flash of Setup() */
+static s32 Format(void)
+{
+	u32 Block;
+	u32 Index;
+	s32 Status = Attach();
+
+	/* The blocks before the last one are reserved for the tables */
+	Block = NumBlocks - Nand.BbtDesc.MaxBlocks - 1U;
+	for (Index = 0U; Index < Nand.BbtDesc.MaxBlocks; Index++) {
+		Ref[Block + Index] |= XNANDPSU_BLOCK_RESERVED;
+	}
+	return Status;
+}
+
+/* First block of the tables area, the mapped blocks are before it */
+static u32 MapEnd(void)
+{
+	u32 Block;
+
+	for (Block = 0U; Block < NumBlocks; Block++) {
+		if (Ref[Block] == XNANDPSU_BLOCK_RESERVED) {
+			break;
+		}
+	}
+	return Block;
+}
+
+/* Random mapped block, NumBlocks if there is none */
+static u32 RandomGood(void)
+{
+	u32 End = MapEnd();
+	u32 Good = 0U;
+	u32 Pick;
+	u32 Block;
+
+	for (Block = 0U; Block < End; Block++) {
+		Good += (Ref[Block] == XNANDPSU_BLOCK_GOOD) ? 1U : 0U;
+	}
+	if (Good == 0U) {
+		return NumBlocks;
+	}
+	Pick = Rand() % Good;
+	for (Block = 0U; Block < End; Block++) {
+		if (Ref[Block] == XNANDPSU_BLOCK_GOOD) {
+			if (Pick == 0U) {
+				break;
+			}
+			Pick--;
+		}
+	}
+	return Block;
+}
+
+static s32 Mark(u32 Block)
+{
+	Ref[Block] = XNANDPSU_BLOCK_BAD;
+	return XNandPsu_MarkBlockBad(&Nand, Block);
+}
+
+/*
+* Checks the RAM table and the lookups against a walk of the expected block
+* types
+*/
+static int StateOk(void)
+{
+	u32 End = MapEnd();
+	u32 Block;
+	u32 Next;
+	u32 Index;
+	u32 Phys;
+	u32 Bad;
+
+	for (Block = 0U; Block < NumBlocks; Block++) {
+		if ((BlockType(Block) != Ref[Block]) ||
+			((XNandPsu_IsBlockBad(&Nand, Block) == XST_SUCCESS) !=
+							IsBad(Block))) {
+			return 0;
+		}
+		for (Bad = 0U; Bad < 2U; Bad++) {
+			for (Next = Block; (Next < NumBlocks) &&
+				((u32)IsBad(Next) != Bad); Next++) {
+			}
+			if (XNandPsu_NextBlock(&Nand, Block, Bad) != Next) {
+				return 0;
+			}
+		}
+	}
+	Index = 0U;
+	for (Block = 0U; Block < End; Block++) {
+		if (Ref[Block] != XNANDPSU_BLOCK_GOOD) {
+			continue;
+		}
+		if ((XNandPsu_MapBlock(&Nand, Index, &Phys) != XST_SUCCESS) ||
+							(Phys != Block)) {
+			return 0;
+		}
+		Index++;
+	}
+	return (XNandPsu_GetNumGoodBlocks(&Nand) == Index) &&
+		(XNandPsu_MapBlock(&Nand, Index, &Phys) == XST_INVALID_PARAM);
+}
+
+/* The tables of both descriptors were found at the same version */
+static int TablesOk(void)
+{
+	u32 Primary = Nand.BbtDesc.PageOffset[0];
+	u32 Mirror = Nand.BbtMirrorDesc.PageOffset[0];
+
+	return (Nand.BbtDesc.Valid != 0U) && (Nand.BbtMirrorDesc.Valid != 0U) &&
+		(Primary != Mirror) &&
+		(memcmp(Spare + (u64)Primary * SIM_SPARE_SIZE +
+			XNANDPSU_BBT_DESC_SIG_OFFSET, "Bbt0", 4U) == 0) &&
+		(memcmp(Spare + (u64)Mirror * SIM_SPARE_SIZE +
+			XNANDPSU_BBT_DESC_SIG_OFFSET, "1tbB", 4U) == 0) &&
+		(Nand.BbtDesc.Version[0] == Nand.BbtMirrorDesc.Version[0]);
+}
+
+static int JournalIs(u32 Primary, u32 Mirror)
+{
+	return (Nand.BbtDesc.JournalPage[0] == Primary) &&
+		(Nand.BbtMirrorDesc.JournalPage[0] == Mirror);
+}
+
+/*****************************************************************************/
+/*
+* Tests
+*/
+static void test_create(u32 Blocks, u32 Pages)
+{
+	char Name[SIM_NAME_LEN];
+	int Ok;
+	int Before;
+
+	Setup(Blocks, Pages);
+	Ok = (Format() == XST_SUCCESS) && TablesOk() && StateOk();
+	snprintf(Name, sizeof(Name), "create: %u blocks, tables written",
+								Blocks);
+	check(Name, Ok && (Violations == 0));
+
+	Before = Erases;
+	Ok = (Attach() == XST_SUCCESS) && TablesOk() && StateOk();
+	snprintf(Name, sizeof(Name), "create: %u blocks, tables found",
+								Blocks);
+	check(Name, Ok && (Erases == Before) &&
+		JournalIs(1U, 1U) && (Violations == 0));
+}
+
+static void test_wear(u32 Blocks, u32 Pages)
+{
+	char Name[SIM_NAME_LEN];
+	u32 Marks = 0U;
+	u32 Block;
+	int Ok;
+
+	Setup(Blocks, Pages);
+	Ok = (Format() == XST_SUCCESS);
+	while (Ok && (Marks < SIM_WEAR_MARKS)) {
+		Block = RandomGood();
+		if (Block >= NumBlocks) {
+			break;
+		}
+		/* Fail the primary or the mirror journal program */
+		FailJournal = (int)(Rand() % 4U);
+		Ok = (Mark(Block) == XST_SUCCESS) && StateOk();
+		FailJournal = 0;
+		Marks++;
+		if ((Marks % 5U) == 0U) {
+			Ok = Ok && (Attach() == XST_SUCCESS) && TablesOk() &&
+								StateOk();
+		}
+	}
+	Ok = Ok && (Attach() == XST_SUCCESS) && TablesOk() && StateOk();
+	snprintf(Name, sizeof(Name),
+		"wear: %u blocks, %u marks, %d erases, rescans", Blocks,
+		Marks, Erases);
+	check(Name, Ok && (Violations == 0));
+}
+
+static void test_mapped(void)
+{
+	u64 BlockSize = (u64)PagesPerBlock * SIM_PAGE_SIZE;
+	u64 Size;
+	u64 Offset;
+	u64 Length;
+	u32 Good;
+	u32 Phys;
+	u32 Index;
+	u8 *Buf;
+	u8 *Exp;
+	int Ok;
+
+	Setup(256U, 16U);
+	Ok = (Format() == XST_SUCCESS);
+	for (Index = 0U; Index < 60U; Index++) {
+		Ok = Ok && (Mark(RandomGood()) == XST_SUCCESS);
+	}
+	Good = XNandPsu_GetNumGoodBlocks(&Nand);
+	Size = Good * BlockSize;
+	Buf = malloc(Size);
+	Exp = malloc(Size);
+	if ((Buf == NULL) || (Exp == NULL)) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (Index = 0U; Ok && (Index < Good); Index++) {
+		Ok = (XNandPsu_MapBlock(&Nand, Index, &Phys) == XST_SUCCESS);
+		memcpy(Exp + Index * BlockSize, Data + Phys * BlockSize,
+								BlockSize);
+	}
+	Ok = Ok && (XNandPsu_ReadMapped(&Nand, 0U, Size, Buf) ==
+				XST_SUCCESS) && (memcmp(Buf, Exp, Size) == 0);
+	check("mapped: all good blocks", Ok);
+
+	Ok = 1;
+	for (Index = 0U; Index < 200U; Index++) {
+		Offset = (((u64)Rand() << 16) ^ Rand()) % Size;
+		Length = (Rand() % (u32)(3U * BlockSize)) % (Size - Offset);
+		memset(Buf, 0, Length);
+		Ok = Ok && (XNandPsu_ReadMapped(&Nand, Offset, Length, Buf) ==
+			XST_SUCCESS) && (memcmp(Buf, Exp + Offset, Length) == 0);
+	}
+	check("mapped: random ranges", Ok);
+
+	Ok = (XNandPsu_ReadMapped(&Nand, Size - 1U, 2U, Buf) ==
+							XST_INVALID_PARAM) &&
+		(XNandPsu_ReadMapped(&Nand, Size + 1U, 0U, Buf) ==
+							XST_INVALID_PARAM) &&
+		(XNandPsu_ReadMapped(&Nand, Size, 0U, Buf) == XST_SUCCESS);
+	(void)XNandPsu_MapBlock(&Nand, Good / 2U, &Phys);
+	State[Phys * PagesPerBlock + 3U] |= SIM_UNREADABLE;
+	Ok = Ok && (XNandPsu_ReadMapped(&Nand, 0U, Size, Buf) == XST_FAILURE);
+	check("mapped: range checks and read errors", Ok);
+
+	free(Buf);
+	free(Exp);
+}
+
+static void test_journal(void)
+{
+	u32 Pages = 32U;
+	u32 Index;
+	u8 Version;
+	int Before;
+	int Ok;
+
+	Setup(64U, Pages);
+	Ok = (Format() == XST_SUCCESS);
+	Before = Erases;
+	Ok = Ok && (Mark(RandomGood()) == XST_SUCCESS) &&
+		(Mark(RandomGood()) == XST_SUCCESS);
+	check("journal: marks are logged without an erase",
+		Ok && (Erases == Before) && JournalIs(3U, 3U) && StateOk());
+
+	Ok = (Attach() == XST_SUCCESS) && StateOk();
+	check("journal: an erased page ends it",
+		Ok && (Erases == Before) && JournalIs(3U, 3U));
+
+	for (Index = 3U; Ok && (Index < Pages); Index++) {
+		Ok = (Mark(RandomGood()) == XST_SUCCESS);
+	}
+	Ok = Ok && JournalIs(Pages, Pages) && (Attach() == XST_SUCCESS) &&
+		StateOk() && JournalIs(Pages, Pages) && (Erases == Before);
+	Version = Nand.BbtDesc.Version[0];
+	Ok = Ok && (Mark(RandomGood()) == XST_SUCCESS) && StateOk() &&
+		(Erases == Before + 2) && JournalIs(1U, 1U) &&
+		(Nand.BbtDesc.Version[0] == (u8)(Version + 1U));
+	Ok = Ok && (Attach() == XST_SUCCESS) && TablesOk() && StateOk();
+	check("journal: a full journal rewrites the tables",
+		Ok && (Violations == 0));
+}
+
+static void test_torn(void)
+{
+	u32 Block;
+	u32 Page;
+	int Before;
+	int Ok;
+
+	/* Power lost while the primary journal page is programmed */
+	Setup(64U, 32U);
+	Ok = (Format() == XST_SUCCESS) && (Mark(RandomGood()) == XST_SUCCESS);
+	Block = RandomGood();
+	FailJournal = 1;
+	LoseOnFail = 1;
+	(void)XNandPsu_MarkBlockBad(&Nand, Block);
+	PowerLost = 0;
+	LoseOnFail = 0;
+	Ok = Ok && (Attach() == XST_SUCCESS) && StateOk() &&
+						JournalIs(32U, 2U);
+	check("torn: an unreadable page ends the journal, taken as full", Ok);
+
+	Before = Erases;
+	Ok = Ok && (Mark(Block) == XST_SUCCESS) && StateOk() &&
+		(Erases == Before + 2) && JournalIs(1U, 1U);
+	Ok = Ok && (Attach() == XST_SUCCESS) && TablesOk() && StateOk();
+	check("torn: the next mark rewrites the tables",
+		Ok && (Violations == 0));
+
+	/* A page that is not a journal page of the table */
+	Setup(64U, 32U);
+	Ok = (Format() == XST_SUCCESS) && (Mark(RandomGood()) == XST_SUCCESS);
+	Page = Nand.BbtDesc.PageOffset[0] + 2U;
+	memcpy(Data + (u64)Page * SIM_PAGE_SIZE, "BbtJ\x7f\xff\x00\x00", 8U);
+	State[Page] |= SIM_PROGRAMMED;
+	Ok = Ok && (Attach() == XST_SUCCESS) && StateOk() &&
+						JournalIs(32U, 2U);
+	Before = Erases;
+	Ok = Ok && (Mark(RandomGood()) == XST_SUCCESS) && StateOk() &&
+		(Erases == Before + 2) && (Attach() == XST_SUCCESS) &&
+		TablesOk() && StateOk();
+	check("torn: as does a page of another version",
+		Ok && (Violations == 0));
+}
+
+int main(int argc, char *argv[])
+{
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "s:")) != -1) {
+		switch (Opt) {
+		case 's': Seed = (u32)strtoul(optarg, NULL, 0); break;
+		default:
+			fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (Seed == 0U) {
+		Seed = 1U;
+	}
+
+	test_create(64U, 32U);
+	test_create(256U, 16U);
+	test_wear(64U, 32U);
+	test_wear(256U, 16U);
+	test_mapped();
+	test_journal();
+	test_torn();
+
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	return 0;
+}
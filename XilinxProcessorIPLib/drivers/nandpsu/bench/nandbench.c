@@ -0,0 +1,621 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file nandbench.c
+*		Host benchmark of the NAND command scheduler. xnandpsu_sched.c
+*		is built for Linux on a simulated device back end that keeps
+*		the flash in memory and models every LUN: tR, tPROG, tBERS,
+*		the cache read and cache program busy times, the command and
+*		status cycles and the page transfers on the shared bus. The
+*		simulation also checks that the commands follow the ONFI
+*		rules for ready and array ready, cache operations and
+*		multi-LUN operations.
+*
+*		Each workload runs one request at a time without cache
+*		operations, as XNandPsu_Read() and XNandPsu_Write() do
+*		(serial), as one batch interleaved over the dies without
+*		cache operations (interleave), and as one batch with cache
+*		read and cache program (sched). The image workload reads a
+*		file from one LUN while the application processes each page,
+*		with XNandPsu_Read() style page reads and with a stream. The
+*		workloads report the modelled time and throughput, and all
+*		data read is checked.
+*
+*		Usage: nandbench [-t targets] [-u luns] [-b blocks_per_lun]
+*		                 [-g pages_per_block] [-p page_size]
+*		                 [-r tr_us] [-w tprog_us] [-e tbers_us]
+*		                 [-x bus_mb_s] [-a app_us_per_page]
+*		                 [-n stream_bufs] [-s]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	   Changes
+* ----- ----   ----------  -----------------------------------------------
+* 1.5   agt    10/17/26    First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xnandpsu_sched.h"
+
+#define BENCH_NO_PAGE		0xFFFFFFFFU
+#define BENCH_RAND_READS	4096U
+
+/* One simulated LUN */
+typedef struct {
+	double RdyAt;		/* Time the LUN becomes ready in ns */
+	double ArdyAt;		/* Time the array becomes ready in ns */
+	u32 DataPage;		/* Page in the data register */
+	u32 CachePage;		/* Page in the cache register */
+	u8 CacheRead;		/* Cache read in progress */
+	u8 CacheProgram;	/* Last program was a cache program */
+	u8 LastFail;		/* Result of the last program or erase */
+	u8 PrevFail;		/* Result of the program before it */
+} SimLun;
+
+/* Simulated device and its time model */
+typedef struct {
+	u8 *Data;
+	u32 BytesPerPage;
+	u32 PagesPerBlock;
+	u32 PagesPerLun;
+	u32 LunsPerTarget;
+	u32 NumLuns;
+	u32 Flags;
+	SimLun Luns[XNANDPSU_SCHED_MAX_DIES];
+	double Now;		/* Time in ns */
+	double ReadNs;		/* tR */
+	double ProgNs;		/* tPROG */
+	double EraseNs;		/* tBERS */
+	double CacheReadNs;	/* tRCBSY */
+	double CacheProgNs;	/* tCBSY */
+	double CmdNs;		/* Controller setup, command and address */
+	double StatusNs;	/* Read status */
+	double ByteNs;		/* Transfer time per byte */
+	u32 Violations;		/* Commands against the ONFI rules */
+	u8 *ProgFail;		/* Pages that fail to program, or NULL */
+	u8 *EraseFail;		/* Blocks that fail to erase, or NULL */
+	u8 *ReadFail;		/* Pages with uncorrectable errors, or NULL */
+} SimDevice;
+
+static SimDevice Dev;
+static double AppNs = 20000.0;
+static u32 StreamBufs = 4U;
+
+static void SimViolation(u32 Lun, const char *Msg)
+{
+	if (Dev.Violations < 10U) {
+		fprintf(stderr, "LUN %u at %.0f ns: %s\n", Lun, Dev.Now, Msg);
+	}
+	Dev.Violations++;
+}
+
+static double SimMax(double A, double B)
+{
+	return (A > B) ? A : B;
+}
+
+/* Other LUNs of the target in use, without multi-LUN operations */
+static void SimCheckTarget(u32 Lun)
+{
+	u32 First = Lun - (Lun % Dev.LunsPerTarget);
+	u32 Index;
+
+	if ((Dev.Flags & XNANDPSU_SCHED_MULTI_LUN) != 0U) {
+		return;
+	}
+	for (Index = First; Index < First + Dev.LunsPerTarget; Index++) {
+		if ((Index != Lun) && ((Dev.Luns[Index].RdyAt > Dev.Now) ||
+			(Dev.Luns[Index].ArdyAt > Dev.Now) ||
+			(Dev.Luns[Index].CacheRead != 0U))) {
+			SimViolation(Lun, "command while another LUN is busy");
+		}
+	}
+}
+
+static s32 SimIssue(void *Ref, u32 Cmd, u32 Die, u32 Page, u8 *BufPtr)
+{
+	SimLun *LunPtr = &Dev.Luns[Die];
+	u8 *PagePtr = Dev.Data + ((u64)Page * Dev.BytesPerPage);
+	u32 Block = Page / Dev.PagesPerBlock;
+	double Start;
+	u32 Index;
+
+	(void)Ref;
+	if ((Die >= Dev.NumLuns) || ((Page / Dev.PagesPerLun) != Die)) {
+		SimViolation(Die, "page outside of the LUN");
+		return (s32)XST_FAILURE;
+	}
+	if (LunPtr->RdyAt > Dev.Now) {
+		SimViolation(Die, "command while busy");
+	}
+	SimCheckTarget(Die);
+	Dev.Now += Dev.CmdNs;
+
+	switch (Cmd) {
+	case XNANDPSU_SCHED_CMD_READ:
+		if ((LunPtr->ArdyAt > Dev.Now) || (LunPtr->CacheRead != 0U)) {
+			SimViolation(Die, "read during an array operation");
+		}
+		LunPtr->DataPage = Page;
+		LunPtr->CachePage = Page;
+		LunPtr->RdyAt = Dev.Now + Dev.ReadNs;
+		LunPtr->ArdyAt = LunPtr->RdyAt;
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_SEQ:
+	case XNANDPSU_SCHED_CMD_READ_CACHE_RND:
+		if (LunPtr->DataPage == BENCH_NO_PAGE) {
+			SimViolation(Die, "cache read without a page read");
+		}
+		if ((Cmd == XNANDPSU_SCHED_CMD_READ_CACHE_SEQ) &&
+			((Page != LunPtr->DataPage + 1U) ||
+			((Page % Dev.PagesPerBlock) == 0U))) {
+			SimViolation(Die, "sequential cache read out of order");
+		}
+		Start = SimMax(Dev.Now, LunPtr->ArdyAt);
+		LunPtr->CachePage = LunPtr->DataPage;
+		LunPtr->DataPage = Page;
+		LunPtr->CacheRead = 1U;
+		LunPtr->RdyAt = Start + Dev.CacheReadNs;
+		LunPtr->ArdyAt = Start + Dev.ReadNs;
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_END:
+		if (LunPtr->CacheRead == 0U) {
+			SimViolation(Die, "cache read end without cache read");
+		}
+		Start = SimMax(Dev.Now, LunPtr->ArdyAt);
+		LunPtr->CachePage = LunPtr->DataPage;
+		LunPtr->DataPage = BENCH_NO_PAGE;
+		LunPtr->CacheRead = 0U;
+		LunPtr->RdyAt = Start + Dev.CacheReadNs;
+		LunPtr->ArdyAt = LunPtr->RdyAt;
+		break;
+	case XNANDPSU_SCHED_CMD_DATA_OUT:
+		if (LunPtr->CachePage != Page) {
+			SimViolation(Die, "data out of a page not in the cache");
+			return (s32)XST_FAILURE;
+		}
+		Dev.Now += Dev.BytesPerPage * Dev.ByteNs;
+		memcpy(BufPtr, PagePtr, Dev.BytesPerPage);
+		if ((Dev.ReadFail != NULL) && (Dev.ReadFail[Page] != 0U)) {
+			return (s32)XST_FAILURE;
+		}
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM:
+	case XNANDPSU_SCHED_CMD_PROGRAM_CACHE:
+		if (((LunPtr->ArdyAt > Dev.Now) &&
+			(LunPtr->CacheProgram == 0U)) ||
+			(LunPtr->CacheRead != 0U)) {
+			SimViolation(Die, "program during an array operation");
+		}
+		Dev.Now += Dev.BytesPerPage * Dev.ByteNs;
+		/* The page leaves the cache register when the array is free */
+		Start = SimMax(Dev.Now, LunPtr->ArdyAt);
+		LunPtr->PrevFail = LunPtr->LastFail;
+		LunPtr->LastFail = ((Dev.ProgFail != NULL) &&
+				(Dev.ProgFail[Page] != 0U)) ? 1U : 0U;
+		if (LunPtr->LastFail == 0U) {
+			for (Index = 0U; Index < Dev.BytesPerPage; Index++) {
+				PagePtr[Index] &= BufPtr[Index];
+			}
+		}
+		LunPtr->DataPage = BENCH_NO_PAGE;
+		LunPtr->CachePage = BENCH_NO_PAGE;
+		LunPtr->ArdyAt = Start + Dev.ProgNs;
+		if (Cmd == XNANDPSU_SCHED_CMD_PROGRAM_CACHE) {
+			LunPtr->CacheProgram = 1U;
+			LunPtr->RdyAt = Start + Dev.CacheProgNs;
+		} else {
+			LunPtr->CacheProgram = 0U;
+			LunPtr->RdyAt = LunPtr->ArdyAt;
+		}
+		break;
+	case XNANDPSU_SCHED_CMD_ERASE:
+		if ((LunPtr->ArdyAt > Dev.Now) || (LunPtr->CacheRead != 0U)) {
+			SimViolation(Die, "erase during an array operation");
+		}
+		LunPtr->LastFail = ((Dev.EraseFail != NULL) &&
+				(Dev.EraseFail[Block] != 0U)) ? 1U : 0U;
+		if (LunPtr->LastFail == 0U) {
+			memset(Dev.Data + ((u64)Block * Dev.PagesPerBlock *
+				Dev.BytesPerPage), 0xFF,
+				(size_t)Dev.PagesPerBlock * Dev.BytesPerPage);
+		}
+		LunPtr->DataPage = BENCH_NO_PAGE;
+		LunPtr->CachePage = BENCH_NO_PAGE;
+		LunPtr->CacheProgram = 0U;
+		LunPtr->RdyAt = Dev.Now + Dev.EraseNs;
+		LunPtr->ArdyAt = LunPtr->RdyAt;
+		break;
+	default:
+		SimViolation(Die, "unknown command");
+		return (s32)XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+static s32 SimStatus(void *Ref, u32 Die, u8 *StatusPtr)
+{
+	SimLun *LunPtr = &Dev.Luns[Die];
+	u8 Status = 0U;
+
+	(void)Ref;
+	Dev.Now += Dev.StatusNs;
+	if (Dev.Now >= LunPtr->RdyAt) {
+		Status |= XNANDPSU_SCHED_STS_RDY;
+	}
+	if (Dev.Now >= LunPtr->ArdyAt) {
+		Status |= XNANDPSU_SCHED_STS_ARDY;
+		LunPtr->CacheProgram = 0U;
+	}
+	if (LunPtr->LastFail != 0U) {
+		Status |= XNANDPSU_SCHED_STS_FAIL;
+	}
+	if (LunPtr->PrevFail != 0U) {
+		Status |= XNANDPSU_SCHED_STS_FAILC;
+	}
+	*StatusPtr = Status;
+
+	return XST_SUCCESS;
+}
+
+static void SimReset(void)
+{
+	u32 Index;
+
+	Dev.Now = 0.0;
+	for (Index = 0U; Index < Dev.NumLuns; Index++) {
+		memset(&Dev.Luns[Index], 0, sizeof(Dev.Luns[Index]));
+		Dev.Luns[Index].DataPage = BENCH_NO_PAGE;
+		Dev.Luns[Index].CachePage = BENCH_NO_PAGE;
+	}
+}
+
+static void AssertCallback(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "assert in %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/* Contents of a page written by the benchmark */
+static void FillPage(u8 *BufPtr, u32 Page, u32 Seed)
+{
+	u32 *WordPtr = (u32 *)(void *)BufPtr;
+	u32 Index;
+
+	for (Index = 0U; Index < Dev.BytesPerPage / 4U; Index++) {
+		WordPtr[Index] = (Page * 2654435761U) ^ (Index * 40503U) ^ Seed;
+	}
+}
+
+static const char *ModeNames[] = { "serial", "interleave", "sched" };
+
+/* Runs requests one at a time or as a batch, by mode */
+static s32 RunRequests(XNandPsu_Sched *SchedPtr, XNandPsu_SchedReq *Reqs,
+		u32 NumReqs, int Mode)
+{
+	u32 Index;
+	s32 Status = XST_SUCCESS;
+
+	if (Mode == 0) {
+		XNandPsu_SchedSetFlags(SchedPtr, 0U);
+		for (Index = 0U; Index < NumReqs; Index++) {
+			if (XNandPsu_SchedSubmit(SchedPtr, &Reqs[Index], 1U) !=
+					XST_SUCCESS) {
+				Status = (s32)XST_FAILURE;
+			}
+		}
+		return Status;
+	}
+	XNandPsu_SchedSetFlags(SchedPtr, (Mode == 1) ?
+			XNANDPSU_SCHED_MULTI_LUN : 0xFFFFFFFFU);
+	return XNandPsu_SchedSubmit(SchedPtr, Reqs, NumReqs);
+}
+
+static void Report(const char *Name, const char *ModeName, u64 Bytes,
+		XNandPsu_Sched *SchedPtr)
+{
+	XNandPsu_SchedStats Stats;
+
+	XNandPsu_SchedGetStats(SchedPtr, &Stats);
+	printf("%-12s %-10s %10.3f ms %9.2f MB/s %7u cmds %8u polls "
+		"%6u cache rd %6u cache pg\n", Name, ModeName, Dev.Now / 1e6,
+		(Bytes / 1048576.0) / (Dev.Now / 1e9), Stats.Commands,
+		Stats.StatusPolls, Stats.CacheReads, Stats.CachePrograms);
+	XNandPsu_SchedClearStats(SchedPtr);
+}
+
+/* Erase, program and read back the whole device, and random reads */
+static int RunDevice(XNandPsu_Sched *SchedPtr, XNandPsu_SchedReq *Reqs,
+		u8 *PageBufs)
+{
+	u32 NumPages = Dev.PagesPerLun * Dev.NumLuns;
+	u32 NumBlocks = NumPages / Dev.PagesPerBlock;
+	u64 DevBytes = (u64)NumPages * Dev.BytesPerPage;
+	u8 *Expect = malloc(Dev.BytesPerPage);
+	u32 Index;
+	u32 Page;
+	int Mode;
+
+	for (Mode = 0; Mode < 3; Mode++) {
+		for (Index = 0U; Index < NumBlocks; Index++) {
+			Reqs[Index].Op = XNANDPSU_SCHED_ERASE;
+			Reqs[Index].Page = Index * Dev.PagesPerBlock;
+			Reqs[Index].BufPtr = NULL;
+		}
+		SimReset();
+		if (RunRequests(SchedPtr, Reqs, NumBlocks, Mode) !=
+				XST_SUCCESS) {
+			fprintf(stderr, "erase failed\n");
+			return 1;
+		}
+		Report("erase", ModeNames[Mode], DevBytes, SchedPtr);
+
+		for (Index = 0U; Index < NumPages; Index++) {
+			Reqs[Index].Op = XNANDPSU_SCHED_PROGRAM;
+			Reqs[Index].Page = Index;
+			Reqs[Index].BufPtr = PageBufs +
+				((u64)Index * Dev.BytesPerPage);
+			FillPage(Reqs[Index].BufPtr, Index, (u32)Mode);
+		}
+		SimReset();
+		if (RunRequests(SchedPtr, Reqs, NumPages, Mode) !=
+				XST_SUCCESS) {
+			fprintf(stderr, "program failed\n");
+			return 1;
+		}
+		Report("program", ModeNames[Mode], DevBytes, SchedPtr);
+
+		for (Index = 0U; Index < NumPages; Index++) {
+			Reqs[Index].Op = XNANDPSU_SCHED_READ;
+			memset(Reqs[Index].BufPtr, 0, Dev.BytesPerPage);
+		}
+		SimReset();
+		if (RunRequests(SchedPtr, Reqs, NumPages, Mode) !=
+				XST_SUCCESS) {
+			fprintf(stderr, "read failed\n");
+			return 1;
+		}
+		for (Index = 0U; Index < NumPages; Index++) {
+			FillPage(Expect, Index, (u32)Mode);
+			if (memcmp(Reqs[Index].BufPtr, Expect,
+					Dev.BytesPerPage) != 0) {
+				fprintf(stderr, "%s: bad data in page %u\n",
+					ModeNames[Mode], Index);
+				return 1;
+			}
+		}
+		Report("read", ModeNames[Mode], DevBytes, SchedPtr);
+
+		srand(1);
+		for (Index = 0U; Index < BENCH_RAND_READS; Index++) {
+			Page = (u32)(((u64)(u32)rand() * 65536U +
+					(u32)rand()) % NumPages);
+			Reqs[Index].Op = XNANDPSU_SCHED_READ;
+			Reqs[Index].Page = Page;
+			Reqs[Index].BufPtr = PageBufs +
+				((u64)Index * Dev.BytesPerPage);
+		}
+		SimReset();
+		if (RunRequests(SchedPtr, Reqs, BENCH_RAND_READS, Mode) !=
+				XST_SUCCESS) {
+			fprintf(stderr, "random read failed\n");
+			return 1;
+		}
+		for (Index = 0U; Index < BENCH_RAND_READS; Index++) {
+			FillPage(Expect, Reqs[Index].Page, (u32)Mode);
+			if (memcmp(Reqs[Index].BufPtr, Expect,
+					Dev.BytesPerPage) != 0) {
+				fprintf(stderr, "%s: bad data in page %u\n",
+					ModeNames[Mode], Reqs[Index].Page);
+				return 1;
+			}
+		}
+		Report("rand read", ModeNames[Mode],
+			(u64)BENCH_RAND_READS * Dev.BytesPerPage, SchedPtr);
+	}
+	free(Expect);
+
+	return 0;
+}
+
+/* Reads an image from LUN 0 while the application processes each page */
+static int RunImage(XNandPsu_Sched *SchedPtr, u8 *PageBufs)
+{
+	XNandPsu_SchedReq Req;
+	XNandPsu_Stream Stream;
+	u64 Length = (u64)Dev.PagesPerLun * Dev.BytesPerPage;
+	u64 Offset = Dev.BytesPerPage / 2U;
+	u64 Done;
+	u8 *DataPtr;
+	u32 Count;
+	u32 Col;
+	s32 Status;
+
+	/* Image from the middle of the first page to the end of the LUN */
+	Length -= Offset;
+
+	SimReset();
+	XNandPsu_SchedSetFlags(SchedPtr, 0U);
+	for (Done = 0U; Done < Length; Done += Count) {
+		Req.Op = XNANDPSU_SCHED_READ;
+		Req.Page = (u32)((Offset + Done) / Dev.BytesPerPage);
+		Req.BufPtr = PageBufs;
+		Col = (u32)((Offset + Done) % Dev.BytesPerPage);
+		Count = Dev.BytesPerPage - Col;
+		if (Count > Length - Done) {
+			Count = (u32)(Length - Done);
+		}
+		if ((XNandPsu_SchedSubmit(SchedPtr, &Req, 1U) != XST_SUCCESS) ||
+			(memcmp(PageBufs + Col, Dev.Data + Offset + Done,
+				Count) != 0)) {
+			fprintf(stderr, "image read failed\n");
+			return 1;
+		}
+		Dev.Now += AppNs;
+	}
+	Report("image", "serial", Length, SchedPtr);
+
+	SimReset();
+	XNandPsu_SchedSetFlags(SchedPtr, 0xFFFFFFFFU);
+	Status = XNandPsu_StreamOpen(&Stream, SchedPtr, Offset, Length,
+			PageBufs, StreamBufs);
+	Done = 0U;
+	while (Status == XST_SUCCESS) {
+		Status = XNandPsu_StreamRead(&Stream, &DataPtr, &Count);
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+		if (memcmp(DataPtr, Dev.Data + Offset + Done, Count) != 0) {
+			fprintf(stderr, "bad stream data at %llu\n",
+				(unsigned long long)Done);
+			return 1;
+		}
+		Done += Count;
+		Dev.Now += AppNs;
+	}
+	if ((Status != XST_NO_DATA) || (Done != Length) ||
+		(XNandPsu_StreamClose(&Stream) != XST_SUCCESS)) {
+		fprintf(stderr, "stream failed %d\n", (int)Status);
+		return 1;
+	}
+	Report("image", "stream", Length, SchedPtr);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	XNandPsu_SchedOps Ops;
+	XNandPsu_Sched Sched;
+	XNandPsu_SchedReq *Reqs;
+	u8 *PageBufs;
+	u32 Targets = 2U;
+	u32 Luns = 2U;
+	u32 BlocksPerLun = 64U;
+	u32 NumPages;
+	double BusMbs = 100.0;
+	s32 Status;
+	int Opt;
+
+	Dev.BytesPerPage = 4096U;
+	Dev.PagesPerBlock = 64U;
+	Dev.ReadNs = 25000.0;
+	Dev.ProgNs = 250000.0;
+	Dev.EraseNs = 2000000.0;
+	Dev.CacheReadNs = 3000.0;
+	Dev.CacheProgNs = 3000.0;
+	Dev.CmdNs = 1000.0;
+	Dev.StatusNs = 500.0;
+	Dev.Flags = XNANDPSU_SCHED_CACHE_READ | XNANDPSU_SCHED_CACHE_PROGRAM |
+			XNANDPSU_SCHED_MULTI_LUN;
+
+	while ((Opt = getopt(argc, argv, "t:u:b:g:p:r:w:e:x:a:n:s")) != -1) {
+		switch (Opt) {
+		case 't': Targets = (u32)atoi(optarg); break;
+		case 'u': Luns = (u32)atoi(optarg); break;
+		case 'b': BlocksPerLun = (u32)atoi(optarg); break;
+		case 'g': Dev.PagesPerBlock = (u32)atoi(optarg); break;
+		case 'p': Dev.BytesPerPage = (u32)atoi(optarg); break;
+		case 'r': Dev.ReadNs = atof(optarg) * 1000.0; break;
+		case 'w': Dev.ProgNs = atof(optarg) * 1000.0; break;
+		case 'e': Dev.EraseNs = atof(optarg) * 1000.0; break;
+		case 'x': BusMbs = atof(optarg); break;
+		case 'a': AppNs = atof(optarg) * 1000.0; break;
+		case 'n': StreamBufs = (u32)atoi(optarg); break;
+		case 's': Dev.Flags &= ~XNANDPSU_SCHED_MULTI_LUN; break;
+		default:
+			fprintf(stderr, "Usage: nandbench [-t targets] "
+				"[-u luns] [-b blocks_per_lun] "
+				"[-g pages_per_block] [-p page_size] "
+				"[-r tr_us] [-w tprog_us] [-e tbers_us] "
+				"[-x bus_mb_s] [-a app_us_per_page] "
+				"[-n stream_bufs] [-s]\n");
+			return 1;
+		}
+	}
+
+	Xil_AssertSetCallback(AssertCallback);
+
+	Dev.LunsPerTarget = Luns;
+	Dev.NumLuns = Targets * Luns;
+	Dev.PagesPerLun = BlocksPerLun * Dev.PagesPerBlock;
+	Dev.ByteNs = 1000.0 / BusMbs;
+	NumPages = Dev.PagesPerLun * Dev.NumLuns;
+
+	Ops.Issue = SimIssue;
+	Ops.Status = SimStatus;
+	Ops.IsBlockBad = NULL;
+	Ops.Ref = &Dev;
+	Ops.BytesPerPage = Dev.BytesPerPage;
+	Ops.PagesPerBlock = Dev.PagesPerBlock;
+	Ops.PagesPerLun = Dev.PagesPerLun;
+	Ops.LunsPerTarget = Luns;
+	Ops.NumDies = Dev.NumLuns;
+	Ops.Flags = Dev.Flags;
+	Status = XNandPsu_SchedInitialize(&Sched, &Ops);
+	if ((Status != XST_SUCCESS) || (NumPages < BENCH_RAND_READS)) {
+		fprintf(stderr, "invalid geometry\n");
+		return 1;
+	}
+
+	Dev.Data = malloc((size_t)NumPages * Dev.BytesPerPage);
+	PageBufs = aligned_alloc(64U, (size_t)NumPages * Dev.BytesPerPage);
+	Reqs = calloc(NumPages, sizeof(*Reqs));
+	if ((Dev.Data == NULL) || (PageBufs == NULL) || (Reqs == NULL)) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	memset(Dev.Data, 0xFF, (size_t)NumPages * Dev.BytesPerPage);
+
+	printf("%u targets x %u LUNs x %u blocks x %u pages x %u bytes, "
+		"tR %.0f us, tPROG %.0f us, tBERS %.0f us, bus %.0f MB/s, "
+		"%s\n", Targets, Luns, BlocksPerLun, Dev.PagesPerBlock,
+		Dev.BytesPerPage, Dev.ReadNs / 1000.0, Dev.ProgNs / 1000.0,
+		Dev.EraseNs / 1000.0, BusMbs,
+		((Dev.Flags & XNANDPSU_SCHED_MULTI_LUN) != 0U) ?
+		"multi-LUN" : "one LUN per target at a time");
+	if ((RunDevice(&Sched, Reqs, PageBufs) != 0) ||
+		(RunImage(&Sched, PageBufs) != 0)) {
+		return 1;
+	}
+	if (Dev.Violations != 0U) {
+		fprintf(stderr, "%u ONFI rule violations\n", Dev.Violations);
+		return 1;
+	}
+
+	return 0;
+}
@@ -103,6 +103,11 @@
 * 1.5   mus    11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 1.5   mus    11/05/18 Updated XNandPsu_ChangeClockFreq to fix compilation
 *                       warnings.
+* 1.5   agt    10/17/26 Added XNandPsu_SchedCfgInitialize and the controller
+*                       back end of the command scheduler, added cache
+*                       read, cache program and multi-LUN features.
+* 1.5   agt    10/17/26 XNandPsu_CalculateLength skips runs of good and bad
+*                       blocks with XNandPsu_NextBlock.
 *
 * </pre>
 *
@@ -181,11 +186,26 @@ static s32 XNandPsu_OnfiReadParamPage(XNandPsu *InstancePtr, u32 Target,
 						u8 *Buf);
 
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf);
+						u32 Col, u8 *Buf, u8 Cmd2);
 
 static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 							u32 Col, u8 *Buf);
 
+static s32 XNandPsu_ReadCachePage(XNandPsu *InstancePtr, u32 Target,
+						u32 Page, u8 *Buf);
+
+static s32 XNandPsu_CheckEccError(XNandPsu *InstancePtr, s32 Status);
+
+static s32 XNandPsu_SchedCmd(XNandPsu *InstancePtr, u32 Target, u8 Cmd1,
+			u8 Cmd2, u32 AddrCycles, u32 Page, u32 ProgMask);
+
+static s32 XNandPsu_SchedCtrlIssue(void *Ref, u32 Cmd, u32 Die, u32 Page,
+							u8 *BufPtr);
+
+static s32 XNandPsu_SchedCtrlStatus(void *Ref, u32 Die, u8 *StatusPtr);
+
+static s32 XNandPsu_SchedCtrlIsBlockBad(void *Ref, u32 Block);
+
 static s32 XNandPsu_CheckOnDie(XNandPsu *InstancePtr, OnfiParamPage *Param);
 
 static void XNandPsu_SetEccAddrSize(XNandPsu *InstancePtr);
@@ -537,6 +557,16 @@ static void XNandPsu_InitFeatures(XNandPsu *InstancePtr, OnfiParamPage *Param)
 								1U : 0U;
 	InstancePtr->Features.ExtPrmPage = ((Param->Features & (1U << 7)) != 0U) ?
 								1U : 0U;
+	InstancePtr->Features.MultiLun = ((Param->Features & (1U << 1)) != 0U) ?
+								1U : 0U;
+	InstancePtr->Features.CacheProgram =
+		((Param->OptionalCmds & (1U << 0)) != 0U) ? 1U : 0U;
+	InstancePtr->Features.CacheRead =
+		((Param->OptionalCmds & (1U << 1)) != 0U) ? 1U : 0U;
+	InstancePtr->Features.RdStsEnh =
+		((Param->OptionalCmds & (1U << 3)) != 0U) ? 1U : 0U;
+	InstancePtr->Features.ChngRdColEnh =
+		((Param->OptionalCmds & (1U << 6)) != 0U) ? 1U : 0U;
 }
 
 /*****************************************************************************/
@@ -1288,27 +1318,27 @@ static s32 XNandPsu_CalculateLength(XNandPsu *InstancePtr, u64 Offset,
 {
 	s32 Status;
 	u32 BlockSize;
-	u32 BlockLen;
 	u32 Block;
+	u32 End;
 	u64 TempLen = 0;
 	u64 OffsetVar = Offset;
 
 	BlockSize = InstancePtr->Geometry.BlockSize;
 
 	while (TempLen < Length) {
-		Block = (u32)(OffsetVar/BlockSize);
-		BlockLen = BlockSize - (u32)(OffsetVar % BlockSize);
 		if (OffsetVar >= InstancePtr->Geometry.DeviceSize) {
 			Status = XST_FAILURE;
 			goto Out;
 		}
-		/* Check if the block is bad */
-		Status = XNandPsu_IsBlockBad(InstancePtr, Block);
-		if (Status != XST_SUCCESS) {
-			/* Good block */
-			TempLen += BlockLen;
+		Block = (u32)(OffsetVar/BlockSize);
+		/* Skip the run of bad or good blocks at once */
+		if (XNandPsu_IsBlockBad(InstancePtr, Block) == XST_SUCCESS) {
+			End = XNandPsu_NextBlock(InstancePtr, Block, 0U);
+		} else {
+			End = XNandPsu_NextBlock(InstancePtr, Block, 1U);
+			TempLen += ((u64)End * BlockSize) - OffsetVar;
 		}
-		OffsetVar += BlockLen;
+		OffsetVar = (u64)End * BlockSize;
 	}
 
 	Status = XST_SUCCESS;
@@ -1414,7 +1444,7 @@ s32 XNandPsu_Write(XNandPsu *InstancePtr, u64 Offset, u64 Length, u8 *SrcBuf)
 		}
 		/* Program page */
 		Status = XNandPsu_ProgramPage(InstancePtr, Target, Page, 0U,
-								BufPtr);
+						BufPtr, ONFI_CMD_PG_PROG2);
 		if (Status != XST_SUCCESS)
 			goto Out;
 
@@ -1647,16 +1677,19 @@ Out:
 * @param	Page is the page address value to program.
 * @param	Col is the column address value to program.
 * @param	Buf is the data buffer to program.
+* @param	Cmd2 is ONFI_CMD_PG_PROG2 for a page program or
+*		ONFI_CMD_PG_CACHE_PROG2 for a cache program.
 *
 * @return
 *		- XST_SUCCESS if successful.
 *		- XST_FAILURE if failed.
 *
-* @note		None
+* @note		The function returns when the data is transferred, the caller
+*		waits for the flash to be ready.
 *
 ******************************************************************************/
 static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
-							u32 Col, u8 *Buf)
+						u32 Col, u8 *Buf, u8 Cmd2)
 {
 	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
 				InstancePtr->Geometry.ColAddrCycles;
@@ -1676,7 +1709,7 @@ static s32 XNandPsu_ProgramPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	}
 	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
 
-	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, ONFI_CMD_PG_PROG2,
+	XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_PG_PROG1, Cmd2,
 					1U, 1U, (u8)AddrCycles);
 
 	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
@@ -1938,6 +1971,32 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 	Status = XNandPsu_Data_ReadWrite(InstancePtr, Buf, PktCount, PktSize, 0, 1);
 
 	/* Check ECC Errors */
+	Status = XNandPsu_CheckEccError(InstancePtr, Status);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks the ECC errors of the page read last and updates the
+* ECC error counters.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Status is the status of the data transfer.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the transfer failed or the page has
+*		uncorrectable errors.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_CheckEccError(XNandPsu *InstancePtr, s32 Status)
+{
+	s32 EccStatus = Status;
+
 	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
 		/* Hamming Multi Bit Errors */
 		if (((u32)XNandPsu_ReadReg(InstancePtr->Config.BaseAddress,
@@ -1959,7 +2018,7 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 					0x1FF00U) >> 8U);
 			InstancePtr->Ecc_Stats_total_flips +=
 					InstancePtr->Ecc_Stat_PerPage_flips;
-			Status = XST_FAILURE;
+			EccStatus = XST_FAILURE;
 		}
 		/* Hamming Single Bit or BCH Errors */
 		if (((u32)XNandPsu_ReadReg(InstancePtr->Config.BaseAddress,
@@ -1978,11 +2037,107 @@ static s32 XNandPsu_ReadPage(XNandPsu *InstancePtr, u32 Target, u32 Page,
 						0x1FF00U) >> 8U);
 				InstancePtr->Ecc_Stats_total_flips +=
 					InstancePtr->Ecc_Stat_PerPage_flips;
-				Status = XST_SUCCESS;
+				EccStatus = XST_SUCCESS;
 			}
 		}
 	}
 
+	return EccStatus;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads a page from the cache register of the flash, after a
+* read or a cache read of the page was started and the flash is ready. With
+* the enhanced change read column command the page address selects the LUN.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Page is the page address in the target.
+* @param	Buf is the data buffer to fill in.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_ReadCachePage(XNandPsu *InstancePtr, u32 Target,
+						u32 Page, u8 *Buf)
+{
+	u32 AddrCycles;
+	u32 PktSize;
+	u32 PktCount;
+	s32 Status = XST_FAILURE;
+	u32 RegVal;
+
+	if (InstancePtr->EccCfg.CodeWordSize > 9U) {
+		PktSize = 1024U;
+	} else {
+		PktSize = 512U;
+	}
+	PktCount = InstancePtr->Geometry.BytesPerPage/PktSize;
+
+	if (InstancePtr->Features.ChngRdColEnh != 0U) {
+		AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+		XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_CHNG_RD_COL_ENHCD1,
+				ONFI_CMD_CHNG_RD_COL_ENHCD2, 1U, 1U,
+				(u8)AddrCycles);
+	} else {
+		AddrCycles = InstancePtr->Geometry.ColAddrCycles;
+		XNandPsu_Prepare_Cmd(InstancePtr, ONFI_CMD_CHNG_RD_COL1,
+				ONFI_CMD_CHNG_RD_COL2, 1U, 1U,
+				(u8)AddrCycles);
+	}
+
+	if (InstancePtr->DmaMode == XNANDPSU_MDMA) {
+		RegVal = XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK |
+			 XNANDPSU_INTR_STS_EN_DMA_INT_STS_EN_MASK;
+		if (InstancePtr->Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((INTPTR)(void *)Buf, (PktSize * PktCount));
+		}
+		XNandPsu_Update_DmaAddr(InstancePtr, Buf);
+	} else {
+		RegVal = XNANDPSU_INTR_STS_EN_BUFF_RD_RDY_STS_EN_MASK;
+	}
+	/* Enable Single bit error and Multi bit error */
+	if (InstancePtr->EccMode == XNANDPSU_HWECC)
+		RegVal |= XNANDPSU_INTR_STS_EN_MUL_BIT_ERR_STS_EN_MASK |
+			 XNANDPSU_INTR_STS_EN_ERR_INTR_STS_EN_MASK;
+
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_INTR_STS_EN_OFFSET, RegVal);
+	/* Program Page Size */
+	XNandPsu_SetPageSize(InstancePtr);
+	/* Program Column, Page, Block address */
+	XNandPsu_SetPageColAddr(InstancePtr, Page, 0U);
+	/* Program Packet Size and Packet Count */
+	XNandPsu_SetPktSzCnt(InstancePtr, PktSize, PktCount);
+	/* Program Memory Address Register2 for chip select */
+	XNandPsu_SelectChip(InstancePtr, Target);
+	/* Set ECC */
+	if (InstancePtr->EccMode == XNANDPSU_HWECC) {
+		XNandPsu_SetEccSpareCmd(InstancePtr,
+					(ONFI_CMD_CHNG_RD_COL1 |
+					(ONFI_CMD_CHNG_RD_COL2 << (u8)8U)),
+					InstancePtr->Geometry.ColAddrCycles);
+	}
+
+	/* Set Change Read Column command in Program Register */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_PROG_OFFSET,
+			(InstancePtr->Features.ChngRdColEnh != 0U) ?
+			XNANDPSU_PROG_CHNG_RD_COL_ENH_MASK :
+			XNANDPSU_PROG_RD_MASK);
+
+	Status = XNandPsu_Data_ReadWrite(InstancePtr, Buf, PktCount, PktSize, 0, 1);
+
+	/* Check ECC Errors */
+	Status = XNandPsu_CheckEccError(InstancePtr, Status);
+
 	return Status;
 }
 
@@ -2111,6 +2266,280 @@ s32 XNandPsu_EraseBlock(XNandPsu *InstancePtr, u32 Target, u32 Block)
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* This function initializes a command scheduler for the flash of a XNandPsu
+* instance. The scheduler interleaves the reads, programs and erases of all
+* LUNs and uses cache read and cache program if the flash supports them, see
+* xnandpsu_sched.h. The flash must not be used with other functions of the
+* driver while a batch or a stream of the scheduler is in progress.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	InstancePtr is a pointer to the initialized XNandPsu instance.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the flash has more LUNs than the
+*		scheduler supports.
+*
+* @note		Multi-LUN operations are used only if the flash supports
+*		them together with the read status enhanced and change read
+*		column enhanced commands, which address a LUN.
+*
+******************************************************************************/
+s32 XNandPsu_SchedCfgInitialize(XNandPsu_Sched *SchedPtr, XNandPsu *InstancePtr)
+{
+	XNandPsu_SchedOps Ops;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Ops.Issue = XNandPsu_SchedCtrlIssue;
+	Ops.Status = XNandPsu_SchedCtrlStatus;
+	Ops.IsBlockBad = XNandPsu_SchedCtrlIsBlockBad;
+	Ops.Ref = InstancePtr;
+	Ops.BytesPerPage = InstancePtr->Geometry.BytesPerPage;
+	Ops.PagesPerBlock = InstancePtr->Geometry.PagesPerBlock;
+	Ops.PagesPerLun = InstancePtr->Geometry.PagesPerBlock *
+				InstancePtr->Geometry.BlocksPerLun;
+	Ops.LunsPerTarget = InstancePtr->Geometry.NumLuns;
+	Ops.NumDies = (u32)InstancePtr->Geometry.NumTargets *
+				InstancePtr->Geometry.NumLuns;
+	Ops.Flags = 0U;
+	if (InstancePtr->Features.CacheRead != 0U) {
+		Ops.Flags |= XNANDPSU_SCHED_CACHE_READ;
+	}
+	if (InstancePtr->Features.CacheProgram != 0U) {
+		Ops.Flags |= XNANDPSU_SCHED_CACHE_PROGRAM;
+	}
+	if ((InstancePtr->Features.MultiLun != 0U) &&
+		(InstancePtr->Features.RdStsEnh != 0U) &&
+		(InstancePtr->Features.ChngRdColEnh != 0U)) {
+		Ops.Flags |= XNANDPSU_SCHED_MULTI_LUN;
+	}
+
+	return XNandPsu_SchedInitialize(SchedPtr, &Ops);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sends a command without data to the flash and waits until
+* the controller has sent it. It does not wait for the flash to be ready.
+*
+* @param	InstancePtr is a pointer to the XNandPsu instance.
+* @param	Target is the chip select value.
+* @param	Cmd1 is the first command.
+* @param	Cmd2 is the second command, or ONFI_CMD_INVALID.
+* @param	AddrCycles is the number of address cycles.
+* @param	Page is the page address value.
+* @param	ProgMask is the operation in the Program Register.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		With row address cycles only, Page is sent as the row address
+*		as in XNandPsu_EraseBlock().
+*
+******************************************************************************/
+static s32 XNandPsu_SchedCmd(XNandPsu *InstancePtr, u32 Target, u8 Cmd1,
+			u8 Cmd2, u32 AddrCycles, u32 Page, u32 ProgMask)
+{
+	/*
+	 * Enable Transfer Complete Interrupt in Interrupt Status Enable
+	 * Register
+	 */
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_INTR_STS_EN_OFFSET,
+			XNANDPSU_INTR_STS_EN_TRANS_COMP_STS_EN_MASK);
+	/* Program Command */
+	XNandPsu_Prepare_Cmd(InstancePtr, Cmd1, Cmd2, 0U, 0U, (u8)AddrCycles);
+	/* Program Column, Page, Block address */
+	if (AddrCycles == InstancePtr->Geometry.RowAddrCycles) {
+		XNandPsu_SetPageColAddr(InstancePtr, (Page >> 16U) & 0xFFFFU,
+					(u16)(Page & 0xFFFFU));
+	} else if (AddrCycles != 0U) {
+		XNandPsu_SetPageColAddr(InstancePtr, Page, 0U);
+	} else {
+		/* No address */
+	}
+	/* Program Memory Address Register2 for chip select */
+	XNandPsu_SelectChip(InstancePtr, Target);
+	if (ProgMask == XNANDPSU_PROG_RD_STS_ENH_MASK) {
+		/* Program Packet Size and Packet Count */
+		if (InstancePtr->DataInterface == XNANDPSU_SDR) {
+			XNandPsu_SetPktSzCnt(InstancePtr, 1U, 1U);
+		} else {
+			XNandPsu_SetPktSzCnt(InstancePtr, 2U, 1U);
+		}
+	}
+	XNandPsu_WriteReg((InstancePtr)->Config.BaseAddress,
+			XNANDPSU_PROG_OFFSET, ProgMask);
+	/* Poll for Transfer Complete event */
+	return XNandPsu_WaitFor_Transfer_Complete(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the controller back end of the command scheduler. It
+* sends one command of the scheduler to a LUN, see XNandPsu_SchedIssue in
+* xnandpsu_sched.h.
+*
+* @param	Ref is a pointer to the XNandPsu instance.
+* @param	Cmd is the XNANDPSU_SCHED_CMD_* command.
+* @param	Die is the LUN.
+* @param	Page is the page of the device.
+* @param	BufPtr is the page buffer of data out and programs.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		The cache read commands 31h and 3Fh have no address. On a
+*		target with several LUNs the LUN is selected first with a
+*		status command.
+*
+******************************************************************************/
+static s32 XNandPsu_SchedCtrlIssue(void *Ref, u32 Cmd, u32 Die, u32 Page,
+							u8 *BufPtr)
+{
+	XNandPsu *InstancePtr = (XNandPsu *)Ref;
+	u32 AddrCycles = InstancePtr->Geometry.RowAddrCycles +
+				InstancePtr->Geometry.ColAddrCycles;
+	u32 Target = Page / InstancePtr->Geometry.NumTargetPages;
+	u32 TargetPage = Page % InstancePtr->Geometry.NumTargetPages;
+	s32 Status = XST_FAILURE;
+	u8 LunStatus;
+
+	if (((Cmd == XNANDPSU_SCHED_CMD_READ_CACHE_SEQ) ||
+		(Cmd == XNANDPSU_SCHED_CMD_READ_CACHE_END)) &&
+		(InstancePtr->Geometry.NumLuns > 1U)) {
+		Status = XNandPsu_SchedCtrlStatus(Ref, Die, &LunStatus);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+	}
+
+	switch (Cmd) {
+	case XNANDPSU_SCHED_CMD_READ:
+		Status = XNandPsu_SchedCmd(InstancePtr, Target, ONFI_CMD_RD1,
+				ONFI_CMD_RD2, AddrCycles, TargetPage,
+				XNANDPSU_PROG_MUL_DIE_RD_MASK);
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_SEQ:
+		Status = XNandPsu_SchedCmd(InstancePtr, Target,
+				ONFI_CMD_RD_CACHE_SEQ, ONFI_CMD_INVALID, 0U,
+				0U, XNANDPSU_PROG_RD_CACHE_SEQ_MASK);
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_RND:
+		Status = XNandPsu_SchedCmd(InstancePtr, Target,
+				ONFI_CMD_RD_CACHE_RND1, ONFI_CMD_RD_CACHE_RND2,
+				AddrCycles, TargetPage,
+				XNANDPSU_PROG_RD_CACHE_RAND_MASK);
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_END:
+		Status = XNandPsu_SchedCmd(InstancePtr, Target,
+				ONFI_CMD_RD_CACHE_END, ONFI_CMD_INVALID, 0U,
+				0U, XNANDPSU_PROG_RD_CACHE_END_MASK);
+		break;
+	case XNANDPSU_SCHED_CMD_DATA_OUT:
+		Status = XNandPsu_ReadCachePage(InstancePtr, Target,
+				TargetPage, BufPtr);
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM:
+		Status = XNandPsu_ProgramPage(InstancePtr, Target, TargetPage,
+				0U, BufPtr, ONFI_CMD_PG_PROG2);
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM_CACHE:
+		Status = XNandPsu_ProgramPage(InstancePtr, Target, TargetPage,
+				0U, BufPtr, ONFI_CMD_PG_CACHE_PROG2);
+		break;
+	case XNANDPSU_SCHED_CMD_ERASE:
+		Status = XNandPsu_EraseBlock(InstancePtr, Target,
+			TargetPage / InstancePtr->Geometry.PagesPerBlock);
+		break;
+	default:
+		Status = XST_FAILURE;
+		break;
+	}
+
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the status register of a LUN for the command
+* scheduler, with the read status enhanced command if the flash supports it.
+*
+* @param	Ref is a pointer to the XNandPsu instance.
+* @param	Die is the LUN.
+* @param	StatusPtr returns the ONFI status register.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_SchedCtrlStatus(void *Ref, u32 Die, u8 *StatusPtr)
+{
+	XNandPsu *InstancePtr = (XNandPsu *)Ref;
+	u32 Target = Die / InstancePtr->Geometry.NumLuns;
+	u32 Page;
+	u16 OnfiStatus = 0U;
+	s32 Status = XST_FAILURE;
+
+	if (InstancePtr->Features.RdStsEnh != 0U) {
+		/* First page of the LUN, the row address selects the LUN */
+		Page = (Die % InstancePtr->Geometry.NumLuns) *
+			InstancePtr->Geometry.BlocksPerLun *
+			InstancePtr->Geometry.PagesPerBlock;
+		Status = XNandPsu_SchedCmd(InstancePtr, Target,
+				ONFI_CMD_RD_STS_ENHCD, ONFI_CMD_INVALID,
+				InstancePtr->Geometry.RowAddrCycles, Page,
+				XNANDPSU_PROG_RD_STS_ENH_MASK);
+		/* Read Flash Status */
+		OnfiStatus = (u16)XNandPsu_ReadReg(
+				InstancePtr->Config.BaseAddress,
+				XNANDPSU_FLASH_STS_OFFSET);
+	} else {
+		Status = XNandPsu_OnfiReadStatus(InstancePtr, Target,
+							&OnfiStatus);
+	}
+	*StatusPtr = (u8)OnfiStatus;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks a block in the bad block table for the streams of the
+* command scheduler.
+*
+* @param	Ref is a pointer to the XNandPsu instance.
+* @param	Block is the block of the device.
+*
+* @return
+*		- XST_SUCCESS if the block is bad.
+*		- XST_FAILURE if the block is good.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_SchedCtrlIsBlockBad(void *Ref, u32 Block)
+{
+	return XNandPsu_IsBlockBad((XNandPsu *)Ref, Block);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -92,6 +92,15 @@
 * only after the erase operation is completed successfully or an error is
 * reported.
 *
+* <b>Command Scheduler</b>
+*
+* XNandPsu_SchedCfgInitialize() sets up a command scheduler for the flash,
+* see xnandpsu_sched.h. The scheduler runs batches of page reads, page
+* programs and block erases, and read streams, with the LUNs working in
+* parallel, and uses the cache read and cache program commands so that the
+* transfer of a page overlaps with the array operation of the next. Reads
+* and writes through XNandPsu_Read() and XNandPsu_Write() are unchanged.
+*
 * @note		Driver has been renamed to nandpsu after change in
 *		naming convention.
 *
@@ -167,6 +176,13 @@
 * 1.5   mus    11/08/18    Updated BBT signature array size  in
 *                          XNandPsu_BbtDesc structure to fix the compilation
 *                          warnings.
+* 1.5   agt    10/17/26    Added cache read, cache program, multi-LUN, read
+*                          status enhanced and change read column enhanced
+*                          to XNandPsu_Features, added
+*                          XNandPsu_SchedCfgInitialize.
+* 1.5   agt    10/17/26    Added the bad block bitmaps and the mapping of
+*                          good blocks to the instance, and the journal page
+*                          to XNandPsu_BbtDesc.
 *
 * </pre>
 *
@@ -186,6 +202,7 @@ extern "C" {
 #include "xil_assert.h"
 #include "xnandpsu_hw.h"
 #include "xnandpsu_onfi.h"
+#include "xnandpsu_sched.h"
 #include "xil_cache.h"
 /************************** Constant Definitions *****************************/
 
@@ -297,6 +314,9 @@ typedef struct {
 	u8 Version[XNANDPSU_MAX_TARGETS];
 				/**< BBT version */
 	u32 Valid;		/**< BBT descriptor is valid or not */
+	u32 JournalPage[XNANDPSU_MAX_TARGETS];
+				/**< Next free journal page in the BBT
+				  block */
 } XNandPsu_BbtDesc;
 
 /**
@@ -343,6 +363,11 @@ typedef struct {
 	u32 EzNand;
 	u32 OnDie;
 	u32 ExtPrmPage;
+	u32 MultiLun;		/**< Multi-LUN operations */
+	u32 CacheRead;		/**< Read cache commands */
+	u32 CacheProgram;	/**< Page cache program command */
+	u32 RdStsEnh;		/**< Read status enhanced command */
+	u32 ChngRdColEnh;	/**< Change read column enhanced command */
 } XNandPsu_Features;
 
 /**
@@ -402,6 +427,16 @@ typedef struct {
 	XNandPsu_BadBlockPattern BbPattern;	/**< Bad block pattern to
 						  search */
 	u8 Bbt[XNANDPSU_MAX_BLOCKS >> 2];	/**< Bad block table array */
+	u32 BbtBadMap[XNANDPSU_MAX_BLOCKS >> 5];	/**< One bit per block,
+							  set if the block is
+							  bad */
+	u32 BbtSkipMap[XNANDPSU_MAX_BLOCKS >> 5];	/**< One bit per block,
+							  set if the block is
+							  bad or reserved */
+	u16 BbtGoodBefore[XNANDPSU_MAX_BLOCKS >> 5];	/**< Good blocks in
+							  the words before a
+							  word of BbtSkipMap */
+	u32 NumGoodBlocks;	/**< Blocks that are not bad or reserved */
 } XNandPsu;
 
 /******************* Macro Definitions (Inline Functions) *******************/
@@ -575,6 +610,8 @@ void XNandPsu_DisableEccMode(XNandPsu *InstancePtr);
 void XNandPsu_Prepare_Cmd(XNandPsu *InstancePtr, u8 Cmd1, u8 Cmd2, u8 EccState,
 			u8 DmaMode, u8 AddrCycles);
 
+s32 XNandPsu_SchedCfgInitialize(XNandPsu_Sched *SchedPtr, XNandPsu *InstancePtr);
+
 /* XNandPsu_LookupConfig in xnandpsu_sinit.c */
 XNandPsu_Config *XNandPsu_LookupConfig(u16 DevID);
 
@@ -50,6 +50,8 @@
 * 1.1	nsk    11/07/16    Change memcpy to Xil_MemCpy to handle word aligned
 *	                   data access.
 * 1.4	nsk    04/10/18    Added ICCARM compiler support.
+* 1.5   agt    10/17/26    Added the bad block bitmaps, the mapping of good
+*			   blocks and the BBT journal.
 * </pre>
 *
 ******************************************************************************/
@@ -85,6 +87,23 @@ static s32 XNandPsu_MarkBbt(XNandPsu* InstancePtr, XNandPsu_BbtDesc *Desc,
 
 static s32 XNandPsu_UpdateBbt(XNandPsu *InstancePtr, u32 Target);
 
+static u32 XNandPsu_BbtJournalStart(XNandPsu *InstancePtr);
+
+static s32 XNandPsu_WriteBbtJournal(XNandPsu *InstancePtr,
+				XNandPsu_BbtDesc *Desc, u32 Target);
+
+static void XNandPsu_ReadBbtJournal(XNandPsu *InstancePtr,
+				XNandPsu_BbtDesc *Desc, u32 Target);
+
+static void XNandPsu_BuildBbtMap(XNandPsu *InstancePtr);
+
+static void XNandPsu_MarkBbtMap(XNandPsu *InstancePtr, u32 Block);
+
+static u32 XNandPsu_BbtFind(const u32 *Map, u32 NumWords, u32 Block,
+								u32 Set);
+
+static u32 XNandPsu_BbtLowestBit(u32 Word);
+
 /************************** Variable Definitions *****************************/
 
 /*****************************************************************************/
@@ -287,6 +306,8 @@ s32 XNandPsu_ScanBbt(XNandPsu *InstancePtr)
 	BbtLen = InstancePtr->Geometry.NumBlocks >>
 					XNANDPSU_BBT_BLOCK_SHIFT;
 	(void)memset(&InstancePtr->Bbt[0], 0, BbtLen);
+	(void)memset(&InstancePtr->BbtBadMap[0], 0,
+					sizeof(InstancePtr->BbtBadMap));
 
 	for (Index = 0U; Index < InstancePtr->Geometry.NumTargets; Index++) {
 
@@ -323,9 +344,18 @@ s32 XNandPsu_ScanBbt(XNandPsu *InstancePtr)
 			if (Status != XST_SUCCESS) {
 				goto Out;
 			}
+		} else {
+			/* Apply the blocks logged after the tables */
+			XNandPsu_ReadBbtJournal(InstancePtr,
+					&InstancePtr->BbtDesc, Index);
+			XNandPsu_ReadBbtJournal(InstancePtr,
+					&InstancePtr->BbtMirrorDesc, Index);
 		}
 	}
 
+	/* Build the bitmaps from the Bad Block Table(BBT) */
+	XNandPsu_BuildBbtMap(InstancePtr);
+
 	Status = XST_SUCCESS;
 Out:
 	return Status;
@@ -733,6 +763,8 @@ static s32 XNandPsu_WriteBbt(XNandPsu *InstancePtr, XNandPsu_BbtDesc *Desc,
 	if (Status != XST_SUCCESS) {
 		goto Out;
 	}
+	/* The erase emptied the journal */
+	Desc->JournalPage[Target] = XNandPsu_BbtJournalStart(InstancePtr);
 
 	Status = XST_SUCCESS;
 Out:
@@ -856,23 +888,15 @@ Out:
 ******************************************************************************/
 s32 XNandPsu_IsBlockBad(XNandPsu *InstancePtr, u32 Block)
 {
-	u8 Data;
-	u8 BlockShift;
-	u8 BlockType;
-	u32 BlockOffset;
 	s32 Status;
 
 	Xil_AssertNonvoid(InstancePtr != NULL);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 	Xil_AssertNonvoid(Block < InstancePtr->Geometry.NumBlocks);
 
-	BlockOffset = Block >> XNANDPSU_BBT_BLOCK_SHIFT;
-	BlockShift = XNandPsu_BbtBlockShift(Block);
-	Data = InstancePtr->Bbt[BlockOffset];	/* Block information in BBT */
-	BlockType = (Data >> BlockShift) & XNANDPSU_BLOCK_TYPE_MASK;
-
-	if ((BlockType != XNANDPSU_BLOCK_GOOD) &&
-		(BlockType != XNANDPSU_BLOCK_RESERVED)) {
+	/* Block information in the bad block bitmap */
+	if ((InstancePtr->BbtBadMap[Block >> XNANDPSU_BBT_MAP_SHIFT] &
+				XNandPsu_BbtMapBit(Block)) != 0U) {
 		Status = XST_SUCCESS;
 	}
 	else {
@@ -923,7 +947,17 @@ s32 XNandPsu_MarkBlockBad(XNandPsu *InstancePtr, u32 Block)
 
 	/* Update the Bad Block Table(BBT) in flash */
 	if (OldVal != NewVal) {
-		Status = XNandPsu_UpdateBbt(InstancePtr, Target);
+		XNandPsu_MarkBbtMap(InstancePtr, Block);
+		/* Log the block, rewrite the tables if the log is full */
+		Status = XNandPsu_WriteBbtJournal(InstancePtr,
+					&InstancePtr->BbtDesc, Target);
+		if (Status == XST_SUCCESS) {
+			Status = XNandPsu_WriteBbtJournal(InstancePtr,
+					&InstancePtr->BbtMirrorDesc, Target);
+		}
+		if (Status != XST_SUCCESS) {
+			Status = XNandPsu_UpdateBbt(InstancePtr, Target);
+		}
 		if (Status != XST_SUCCESS) {
 			goto Out;
 		}
@@ -933,4 +967,572 @@ s32 XNandPsu_MarkBlockBad(XNandPsu *InstancePtr, u32 Block)
 Out:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+* This function returns the first page of the journal in a Bad Block
+* Table(BBT) block, the page after the table.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+*
+* @return
+*		- Page offset of the journal in the block.
+*
+******************************************************************************/
+static u32 XNandPsu_BbtJournalStart(XNandPsu *InstancePtr)
+{
+	u32 BbtLen = InstancePtr->Geometry.NumBlocks >>
+						XNANDPSU_BBT_BLOCK_SHIFT;
+
+	return (BbtLen + InstancePtr->Geometry.BytesPerPage - 1U) /
+					InstancePtr->Geometry.BytesPerPage;
+}
+
+/*****************************************************************************/
+/**
+* This function appends a journal page with all blocks of a target that are
+* bad due to wear to a Bad Block Table(BBT) block.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Desc is the BBT descriptor of the block.
+* @param	Target is the chip select value.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the block is full, the blocks do not fit into
+*		a page or the program failed. The tables must be rewritten.
+*
+******************************************************************************/
+static s32 XNandPsu_WriteBbtJournal(XNandPsu *InstancePtr,
+				XNandPsu_BbtDesc *Desc, u32 Target)
+{
+	u8 *Buf = &InstancePtr->PartialDataBuf[0];
+	u32 BytesPerPage = InstancePtr->Geometry.BytesPerPage;
+	u32 StartBlock = Target * InstancePtr->Geometry.NumTargetBlocks;
+	u32 EndBlock = StartBlock + InstancePtr->Geometry.NumTargetBlocks;
+	u32 MaxCount = (BytesPerPage - XNANDPSU_BBT_JOURNAL_HDR_LEN) >> 2U;
+	u32 Count = 0U;
+	u32 Block;
+	u32 Pos;
+	u8 BlockType;
+	u64 Offset;
+	s32 Status;
+
+	if ((Desc->Valid == 0U) || (Desc->JournalPage[Target] >=
+				InstancePtr->Geometry.PagesPerBlock)) {
+		Status = XST_FAILURE;
+		goto Out;
+	}
+
+	(void)memset(Buf, 0xff, BytesPerPage);
+	for (Block = StartBlock; Block < EndBlock; Block++) {
+		BlockType = (InstancePtr->Bbt[Block >>
+				XNANDPSU_BBT_BLOCK_SHIFT] >>
+				XNandPsu_BbtBlockShift(Block)) &
+				XNANDPSU_BLOCK_TYPE_MASK;
+		if (BlockType != XNANDPSU_BLOCK_BAD) {
+			continue;
+		}
+		if (Count >= MaxCount) {
+			Status = XST_FAILURE;
+			goto Out;
+		}
+		Pos = XNANDPSU_BBT_JOURNAL_HDR_LEN + (Count << 2U);
+		Buf[Pos] = (u8)Block;
+		Buf[Pos + 1U] = (u8)(Block >> 8U);
+		Buf[Pos + 2U] = (u8)(Block >> 16U);
+		Buf[Pos + 3U] = (u8)(Block >> 24U);
+		Count++;
+	}
+	(void)Xil_MemCpy(Buf + XNANDPSU_BBT_JOURNAL_SIG_OFFSET,
+			XNANDPSU_BBT_JOURNAL_SIG, XNANDPSU_BBT_SIG_LENGTH);
+	Buf[XNANDPSU_BBT_JOURNAL_VER_OFFSET] = Desc->Version[Target];
+	Buf[XNANDPSU_BBT_JOURNAL_CNT_OFFSET] = (u8)Count;
+	Buf[XNANDPSU_BBT_JOURNAL_CNT_OFFSET + 1U] = (u8)(Count >> 8U);
+
+	/* The page is used even if the program fails */
+	Offset = (u64)(Desc->PageOffset[Target] + Desc->JournalPage[Target]) *
+							(u64)BytesPerPage;
+	Desc->JournalPage[Target]++;
+	Status = XNandPsu_Write(InstancePtr, Offset, BytesPerPage, Buf);
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function applies the journal pages of a Bad Block Table(BBT) block to
+* the RAM based Bad Block Table(BBT) and finds the next free journal page.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Desc is the BBT descriptor of the block.
+* @param	Target is the chip select value.
+*
+* @return
+*		- NONE
+*
+* @note		Journal pages are written in order after the table and
+*		each one holds all the blocks logged so far, so the journal
+*		ends at the first erased page. A page that cannot be read or
+*		is not a journal page of this version of the table also ends
+*		it, and the journal is taken as full: nothing after such a
+*		page is trusted, and the next XNandPsu_MarkBlockBad() rewrites
+*		the table instead of programming behind it.
+*
+******************************************************************************/
+static void XNandPsu_ReadBbtJournal(XNandPsu *InstancePtr,
+				XNandPsu_BbtDesc *Desc, u32 Target)
+{
+	u8 *Buf = &InstancePtr->PartialDataBuf[0];
+	u32 BytesPerPage = InstancePtr->Geometry.BytesPerPage;
+	u32 StartBlock = Target * InstancePtr->Geometry.NumTargetBlocks;
+	u32 EndBlock = StartBlock + InstancePtr->Geometry.NumTargetBlocks;
+	u32 MaxCount = (BytesPerPage - XNANDPSU_BBT_JOURNAL_HDR_LEN) >> 2U;
+	u32 Page;
+	u32 Count;
+	u32 Index;
+	u32 Pos;
+	u32 Block;
+	u8 BlockShift;
+	u8 BlockType;
+	u64 Offset;
+	s32 Status;
+
+	if (Desc->Valid == 0U) {
+		return;
+	}
+
+	for (Page = XNandPsu_BbtJournalStart(InstancePtr);
+			Page < InstancePtr->Geometry.PagesPerBlock; Page++) {
+		Offset = (u64)(Desc->PageOffset[Target] + Page) *
+							(u64)BytesPerPage;
+		Status = XNandPsu_Read(InstancePtr, Offset, BytesPerPage, Buf);
+		if (Status != XST_SUCCESS) {
+			Page = InstancePtr->Geometry.PagesPerBlock;
+			break;
+		}
+		/* An erased page ends the journal */
+		for (Index = 0U; Index < BytesPerPage; Index++) {
+			if (Buf[Index] != 0xFFU) {
+				break;
+			}
+		}
+		if (Index >= BytesPerPage) {
+			break;
+		}
+		Count = (u32)Buf[XNANDPSU_BBT_JOURNAL_CNT_OFFSET] |
+			((u32)Buf[XNANDPSU_BBT_JOURNAL_CNT_OFFSET + 1U] << 8U);
+		if ((memcmp(Buf + XNANDPSU_BBT_JOURNAL_SIG_OFFSET,
+				XNANDPSU_BBT_JOURNAL_SIG,
+				XNANDPSU_BBT_SIG_LENGTH) != 0) ||
+			(Buf[XNANDPSU_BBT_JOURNAL_VER_OFFSET] !=
+				Desc->Version[Target]) ||
+			(Count > MaxCount)) {
+			Page = InstancePtr->Geometry.PagesPerBlock;
+			break;
+		}
+		for (Index = 0U; Index < Count; Index++) {
+			Pos = XNANDPSU_BBT_JOURNAL_HDR_LEN + (Index << 2U);
+			Block = (u32)Buf[Pos] | ((u32)Buf[Pos + 1U] << 8U) |
+				((u32)Buf[Pos + 2U] << 16U) |
+				((u32)Buf[Pos + 3U] << 24U);
+			if ((Block < StartBlock) || (Block >= EndBlock)) {
+				continue;
+			}
+			BlockShift = XNandPsu_BbtBlockShift(Block);
+			BlockType = (InstancePtr->Bbt[Block >>
+					XNANDPSU_BBT_BLOCK_SHIFT] >>
+					BlockShift) & XNANDPSU_BLOCK_TYPE_MASK;
+			if (BlockType == XNANDPSU_BLOCK_FACTORY_BAD) {
+				continue;
+			}
+			/* Mark the block as bad as XNandPsu_MarkBlockBad does */
+			InstancePtr->Bbt[Block >> XNANDPSU_BBT_BLOCK_SHIFT] &=
+				(u8)~(XNANDPSU_BLOCK_TYPE_MASK << BlockShift);
+			InstancePtr->Bbt[Block >> XNANDPSU_BBT_BLOCK_SHIFT] |=
+				(u8)(XNANDPSU_BLOCK_BAD << BlockShift);
+		}
+	}
+	Desc->JournalPage[Target] = Page;
+}
+
+/*****************************************************************************/
+/**
+* This function builds the bad block bitmaps and the count of good blocks
+* before each word from the RAM based Bad Block Table(BBT).
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+*
+* @return
+*		- NONE
+*
+* @note		The blocks of a target from its first reserved block on hold
+*		the Bad Block Table(BBT) and are not mapped.
+*
+******************************************************************************/
+static void XNandPsu_BuildBbtMap(XNandPsu *InstancePtr)
+{
+	u32 NumBlocks = InstancePtr->Geometry.NumBlocks;
+	u32 NumWords = (NumBlocks + XNANDPSU_BBT_MAP_MASK) >>
+						XNANDPSU_BBT_MAP_SHIFT;
+	u32 StartBlock;
+	u32 EndBlock;
+	u32 MapEnd;
+	u32 Block;
+	u32 Index;
+	u32 Word;
+	u32 Good;
+	u8 BlockType;
+
+	(void)memset(&InstancePtr->BbtBadMap[0], 0,
+					sizeof(InstancePtr->BbtBadMap));
+	(void)memset(&InstancePtr->BbtSkipMap[0], 0xff,
+					sizeof(InstancePtr->BbtSkipMap));
+
+	for (Index = 0U; Index < InstancePtr->Geometry.NumTargets; Index++) {
+		StartBlock = Index * InstancePtr->Geometry.NumTargetBlocks;
+		EndBlock = StartBlock + InstancePtr->Geometry.NumTargetBlocks;
+		MapEnd = EndBlock;
+		for (Block = StartBlock; Block < EndBlock; Block++) {
+			BlockType = (InstancePtr->Bbt[Block >>
+					XNANDPSU_BBT_BLOCK_SHIFT] >>
+					XNandPsu_BbtBlockShift(Block)) &
+					XNANDPSU_BLOCK_TYPE_MASK;
+			if ((BlockType == XNANDPSU_BLOCK_RESERVED) &&
+						(MapEnd == EndBlock)) {
+				MapEnd = Block;
+			}
+			if ((BlockType == XNANDPSU_BLOCK_BAD) ||
+				(BlockType == XNANDPSU_BLOCK_FACTORY_BAD)) {
+				InstancePtr->BbtBadMap[Block >>
+					XNANDPSU_BBT_MAP_SHIFT] |=
+					XNandPsu_BbtMapBit(Block);
+			}
+		}
+		for (Block = StartBlock; Block < MapEnd; Block++) {
+			BlockType = (InstancePtr->Bbt[Block >>
+					XNANDPSU_BBT_BLOCK_SHIFT] >>
+					XNandPsu_BbtBlockShift(Block)) &
+					XNANDPSU_BLOCK_TYPE_MASK;
+			if (BlockType == XNANDPSU_BLOCK_GOOD) {
+				InstancePtr->BbtSkipMap[Block >>
+					XNANDPSU_BBT_MAP_SHIFT] &=
+					~XNandPsu_BbtMapBit(Block);
+			}
+		}
+	}
+
+	/* Count the good blocks before each word */
+	Good = 0U;
+	for (Index = 0U; Index < NumWords; Index++) {
+		InstancePtr->BbtGoodBefore[Index] = (u16)Good;
+		/* Number of zero bits */
+		Word = ~InstancePtr->BbtSkipMap[Index];
+		Word = Word - ((Word >> 1U) & 0x55555555U);
+		Word = (Word & 0x33333333U) + ((Word >> 2U) & 0x33333333U);
+		Word = (Word + (Word >> 4U)) & 0x0F0F0F0FU;
+		Good += (Word * 0x01010101U) >> 24U;
+	}
+	InstancePtr->NumGoodBlocks = Good;
+}
+
+/*****************************************************************************/
+/**
+* This function marks a block as bad in the bitmaps.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Block is the block number.
+*
+* @return
+*		- NONE
+*
+******************************************************************************/
+static void XNandPsu_MarkBbtMap(XNandPsu *InstancePtr, u32 Block)
+{
+	u32 NumWords = (InstancePtr->Geometry.NumBlocks +
+			XNANDPSU_BBT_MAP_MASK) >> XNANDPSU_BBT_MAP_SHIFT;
+	u32 Word = Block >> XNANDPSU_BBT_MAP_SHIFT;
+	u32 Index;
+
+	InstancePtr->BbtBadMap[Word] |= XNandPsu_BbtMapBit(Block);
+	if ((InstancePtr->BbtSkipMap[Word] & XNandPsu_BbtMapBit(Block)) ==
+								0U) {
+		InstancePtr->BbtSkipMap[Word] |= XNandPsu_BbtMapBit(Block);
+		for (Index = Word + 1U; Index < NumWords; Index++) {
+			InstancePtr->BbtGoodBefore[Index]--;
+		}
+		InstancePtr->NumGoodBlocks--;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function returns the index of the lowest set bit of a word.
+*
+* @param	Word is the word, not zero.
+*
+* @return
+*		- Index of the bit.
+*
+******************************************************************************/
+static u32 XNandPsu_BbtLowestBit(u32 Word)
+{
+	u32 Bit = 0U;
+	u32 WordVar = Word;
+
+	if ((WordVar & 0xFFFFU) == 0U) {
+		WordVar >>= 16U;
+		Bit += 16U;
+	}
+	if ((WordVar & 0xFFU) == 0U) {
+		WordVar >>= 8U;
+		Bit += 8U;
+	}
+	if ((WordVar & 0xFU) == 0U) {
+		WordVar >>= 4U;
+		Bit += 4U;
+	}
+	if ((WordVar & 0x3U) == 0U) {
+		WordVar >>= 2U;
+		Bit += 2U;
+	}
+	if ((WordVar & 0x1U) == 0U) {
+		Bit += 1U;
+	}
+
+	return Bit;
+}
+
+/*****************************************************************************/
+/**
+* This function finds the first block at or after a block with its bit in a
+* bitmap set or clear. The bitmap is searched a word at a time.
+*
+* @param	Map is the bitmap.
+* @param	NumWords is the number of words of the bitmap.
+* @param	Block is the block to start at.
+* @param	Set is 1 to find a set bit and 0 to find a clear bit.
+*
+* @return
+*		- The block, or NumWords * 32 if there is none.
+*
+******************************************************************************/
+static u32 XNandPsu_BbtFind(const u32 *Map, u32 NumWords, u32 Block,
+								u32 Set)
+{
+	u32 Index = Block >> XNANDPSU_BBT_MAP_SHIFT;
+	u32 Word;
+
+	if (Index >= NumWords) {
+		return NumWords << XNANDPSU_BBT_MAP_SHIFT;
+	}
+	Word = (Set != 0U) ? Map[Index] : ~Map[Index];
+	Word &= ~(XNandPsu_BbtMapBit(Block) - 1U);
+	while (Word == 0U) {
+		Index++;
+		if (Index >= NumWords) {
+			return NumWords << XNANDPSU_BBT_MAP_SHIFT;
+		}
+		Word = (Set != 0U) ? Map[Index] : ~Map[Index];
+	}
+
+	return (Index << XNANDPSU_BBT_MAP_SHIFT) + XNandPsu_BbtLowestBit(Word);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the first bad or good block at or after a block. It
+* checks 32 blocks at a time, so runs of good blocks are found without a
+* check of each block.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Block is the block number to start at.
+* @param	Bad is 1 to find a bad block and 0 to find a good block.
+*
+* @return
+*		- The block number, or the number of blocks if there is none.
+*
+* @note		Reserved blocks are good blocks, as with
+*		XNandPsu_IsBlockBad.
+*
+******************************************************************************/
+u32 XNandPsu_NextBlock(XNandPsu *InstancePtr, u32 Block, u32 Bad)
+{
+	u32 NumBlocks;
+	u32 Found;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	NumBlocks = InstancePtr->Geometry.NumBlocks;
+	Found = XNandPsu_BbtFind(&InstancePtr->BbtBadMap[0],
+			(NumBlocks + XNANDPSU_BBT_MAP_MASK) >>
+			XNANDPSU_BBT_MAP_SHIFT, Block, Bad);
+
+	return (Found < NumBlocks) ? Found : NumBlocks;
+}
+
+/*****************************************************************************/
+/**
+* This function maps a logical block to a physical block. The logical blocks
+* are the blocks that are neither bad nor reserved, numbered from 0 without
+* gaps.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Block is the logical block number.
+* @param	PhysBlockPtr returns the physical block number.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if Block is not less than the number of
+*		good blocks.
+*
+* @note		The mapping changes when a block is marked bad.
+*
+******************************************************************************/
+s32 XNandPsu_MapBlock(XNandPsu *InstancePtr, u32 Block, u32 *PhysBlockPtr)
+{
+	u32 Low;
+	u32 High;
+	u32 Mid;
+	u32 Rank;
+	u32 Word;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(PhysBlockPtr != NULL);
+
+	if (Block >= InstancePtr->NumGoodBlocks) {
+		Status = XST_INVALID_PARAM;
+		goto Out;
+	}
+
+	/* Last word with at most Block good blocks before it */
+	Low = 0U;
+	High = ((InstancePtr->Geometry.NumBlocks + XNANDPSU_BBT_MAP_MASK) >>
+					XNANDPSU_BBT_MAP_SHIFT) - 1U;
+	while (Low < High) {
+		Mid = (Low + High + 1U) >> 1U;
+		if ((u32)InstancePtr->BbtGoodBefore[Mid] <= Block) {
+			Low = Mid;
+		} else {
+			High = Mid - 1U;
+		}
+	}
+
+	/* Drop the good blocks of the word before the wanted one */
+	Word = ~InstancePtr->BbtSkipMap[Low];
+	for (Rank = Block - (u32)InstancePtr->BbtGoodBefore[Low]; Rank > 0U;
+								Rank--) {
+		Word &= Word - 1U;
+	}
+	*PhysBlockPtr = (Low << XNANDPSU_BBT_MAP_SHIFT) +
+					XNandPsu_BbtLowestBit(Word);
+
+	Status = XST_SUCCESS;
+Out:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* This function returns the number of logical blocks, the blocks that are
+* neither bad nor reserved.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+*
+* @return
+*		- Number of good blocks.
+*
+******************************************************************************/
+u32 XNandPsu_GetNumGoodBlocks(XNandPsu *InstancePtr)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	return InstancePtr->NumGoodBlocks;
+}
+
+/*****************************************************************************/
+/**
+* This function reads from the logical blocks of the flash, see
+* XNandPsu_MapBlock. The start block is mapped once, and each run of good
+* blocks is read with one XNandPsu_Read call.
+*
+* @param	InstancePtr is the pointer to the XNandPsu instance.
+* @param	Offset is the logical offset to read from.
+* @param	Length is the number of bytes to read.
+* @param	DestBuf is the destination data buffer to fill in.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the range is beyond the good blocks.
+*		- XST_FAILURE if a read failed.
+*
+******************************************************************************/
+s32 XNandPsu_ReadMapped(XNandPsu *InstancePtr, u64 Offset, u64 Length,
+							u8 *DestBuf)
+{
+	u64 BlockSize;
+	u64 Col;
+	u64 RunLen;
+	u64 LengthVar = Length;
+	u8 *DestBufPtr = DestBuf;
+	u32 NumWords;
+	u32 Block;
+	u32 End;
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(DestBuf != NULL);
+
+	BlockSize = (u64)InstancePtr->Geometry.BlockSize;
+	if ((Offset > ((u64)InstancePtr->NumGoodBlocks * BlockSize)) ||
+		(LengthVar > (((u64)InstancePtr->NumGoodBlocks * BlockSize) -
+								Offset))) {
+		Status = XST_INVALID_PARAM;
+		goto Out;
+	}
+	if (LengthVar == 0U) {
+		Status = XST_SUCCESS;
+		goto Out;
+	}
+
+	NumWords = (InstancePtr->Geometry.NumBlocks + XNANDPSU_BBT_MAP_MASK) >>
+						XNANDPSU_BBT_MAP_SHIFT;
+	Status = XNandPsu_MapBlock(InstancePtr, (u32)(Offset / BlockSize),
+								&Block);
+	if (Status != XST_SUCCESS) {
+		goto Out;
+	}
+	Col = Offset % BlockSize;
+
+	while (LengthVar > 0U) {
+		/* End of the run of good blocks */
+		End = XNandPsu_BbtFind(&InstancePtr->BbtSkipMap[0], NumWords,
+								Block, 1U);
+		RunLen = ((u64)(End - Block) * BlockSize) - Col;
+		if (RunLen > LengthVar) {
+			RunLen = LengthVar;
+		}
+		Status = XNandPsu_Read(InstancePtr, ((u64)Block * BlockSize) +
+						Col, RunLen, DestBufPtr);
+		if (Status != XST_SUCCESS) {
+			goto Out;
+		}
+		DestBufPtr += RunLen;
+		LengthVar -= RunLen;
+		Col = 0U;
+		if (LengthVar > 0U) {
+			Block = XNandPsu_BbtFind(&InstancePtr->BbtSkipMap[0],
+						NumWords, End, 0U);
+		}
+	}
+
+	Status = XST_SUCCESS;
+Out:
+	return Status;
+}
 /** @} */
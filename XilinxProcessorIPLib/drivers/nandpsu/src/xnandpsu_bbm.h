@@ -74,6 +74,25 @@
 * XNandPsu_IsBlockBad and take the action based on the return value. Also user
 * can update the bad block table using XNandPsu_MarkBlockBad API.
 *
+* Besides the 2 bit table, the driver keeps two bitmaps in RAM with one bit per
+* block in 32 bit words. BbtBadMap has the bad blocks, so XNandPsu_IsBlockBad
+* is one word test, and a run of good or bad blocks is found 32 blocks at a
+* time with XNandPsu_NextBlock. BbtSkipMap also has the reserved blocks and the
+* Bad Block Table(BBT) area at the end of each target. It maps the good blocks
+* to a contiguous range of logical blocks: XNandPsu_MapBlock returns the
+* physical block of a logical block from the count of good blocks before each
+* word, and XNandPsu_ReadMapped reads a range of logical blocks with one
+* XNandPsu_Read for each run of good blocks.
+*
+* XNandPsu_MarkBlockBad does not rewrite the tables. It appends a journal page
+* with all blocks that went bad due to wear in the target to the primary and
+* the mirror BBT block, in the pages after the table. The journal page has the
+* signature "BbtJ", the version of the table, the number of blocks and the
+* blocks as 32 bit little endian values. When the BBT is read, the journal
+* pages of both blocks are applied to the table. The tables are rewritten with
+* a new version, which erases the journals, only when a BBT block is full, the
+* blocks do not fit into one page or a journal page cannot be programmed.
+*
 * @note		None
 *
 * <pre>
@@ -86,6 +105,9 @@
 *			   in page section by enabling XNANDPSU_BBT_NO_OOB.
 *			   Modified Bbt Signature and Version Offset value for
 *			   Oob and No-Oob region.
+* 1.5   agt    10/17/26    Added the bad block bitmaps, XNandPsu_NextBlock,
+*			   XNandPsu_MapBlock, XNandPsu_GetNumGoodBlocks,
+*			   XNandPsu_ReadMapped and the BBT journal.
 * </pre>
 *
 ******************************************************************************/
@@ -162,6 +184,24 @@ extern "C" {
 #define XNANDPSU_BBT_VERSION_LENGTH	1U
 #define XNANDPSU_BBT_SIG_LENGTH		4U
 
+#define XNANDPSU_BBT_MAP_SHIFT		5U	/**< Block shift value
+							  for a word of the
+							  bitmaps */
+#define XNANDPSU_BBT_MAP_MASK		0x1FU	/**< Bit of a block in a
+							  word of the bitmaps */
+
+#define XNANDPSU_BBT_JOURNAL_SIG	"BbtJ"	/**< Journal page
+							  signature */
+#define XNANDPSU_BBT_JOURNAL_SIG_OFFSET	0U	/**< Journal signature
+							  offset */
+#define XNANDPSU_BBT_JOURNAL_VER_OFFSET	4U	/**< Journal BBT version
+							  offset */
+#define XNANDPSU_BBT_JOURNAL_CNT_OFFSET	6U	/**< Journal block count
+							  offset */
+#define XNANDPSU_BBT_JOURNAL_HDR_LEN	8U	/**< Journal header
+							  length, the blocks
+							  follow */
+
 #define XNANDPSU_BBT_BUF_LENGTH		((XNANDPSU_MAX_BLOCKS >> 		\
 					 XNANDPSU_BBT_BLOCK_SHIFT) +	\
 					(XNANDPSU_BBT_DESC_SIG_OFFSET +	\
@@ -186,6 +226,21 @@ extern "C" {
 #define XNandPsu_BbtBlockShift(Block) \
 			(u8)(((Block) * 2U) & XNANDPSU_BLOCK_SHIFT_MASK)
 
+/****************************************************************************/
+/**
+*
+* This macro returns the bit of a Block in a word of the bad block bitmaps.
+*
+* @param        Block is the block number.
+*
+* @return       Bit mask of the block
+*
+* @note         None.
+*
+*****************************************************************************/
+#define XNandPsu_BbtMapBit(Block) \
+			((u32)1U << ((Block) & XNANDPSU_BBT_MAP_MASK))
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes ******************************/
@@ -194,6 +249,15 @@ void XNandPsu_InitBbtDesc(XNandPsu *InstancePtr);
 
 s32 XNandPsu_IsBlockBad(XNandPsu *InstancePtr, u32 Block);
 
+u32 XNandPsu_NextBlock(XNandPsu *InstancePtr, u32 Block, u32 Bad);
+
+s32 XNandPsu_MapBlock(XNandPsu *InstancePtr, u32 Block, u32 *PhysBlockPtr);
+
+u32 XNandPsu_GetNumGoodBlocks(XNandPsu *InstancePtr);
+
+s32 XNandPsu_ReadMapped(XNandPsu *InstancePtr, u64 Offset, u64 Length,
+							u8 *DestBuf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1034 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xnandpsu_sched.c
+* @addtogroup nandpsu_v1_3
+* @{
+*
+* This file implements the NAND command scheduler and read streams. It only
+* uses the back end of the scheduler and can be built for a host. See
+* xnandpsu_sched.h for a description of the scheduler.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	   Changes
+* ----- ----   ----------  -----------------------------------------------
+* 1.5   agt    10/17/26    First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+#include "xnandpsu_sched.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XNANDPSU_SCHED_QUEUED		0U	/**< Request not started */
+#define XNANDPSU_SCHED_ACTIVE		1U	/**< Request in flight */
+#define XNANDPSU_SCHED_DONE		2U	/**< Request completed */
+
+#define XNANDPSU_SCHED_NO_BLOCK		0xFFFFFFFFU	/**< No block */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static XNandPsu_SchedReq *XNandPsu_SchedFind(XNandPsu_Sched *SchedPtr,
+				u32 Die, u32 From, u32 *SeqPtr);
+static void XNandPsu_SchedComplete(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *ReqPtr, s32 Status);
+static void XNandPsu_SchedDieFail(XNandPsu_Sched *SchedPtr, u32 Die,
+				s32 Status);
+static u32 XNandPsu_SchedTargetBusy(XNandPsu_Sched *SchedPtr, u32 Die);
+static void XNandPsu_SchedPoll(XNandPsu_Sched *SchedPtr, u32 Die);
+static u32 XNandPsu_SchedStep(XNandPsu_Sched *SchedPtr, u32 Die,
+				u32 Transfer);
+static u32 XNandPsu_SchedKick(XNandPsu_Sched *SchedPtr);
+static s32 XNandPsu_SchedRun(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *WaitPtr);
+static void XNandPsu_SchedReset(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *Reqs, u32 NumReqs);
+static void XNandPsu_StreamQueue(XNandPsu_Stream *StreamPtr);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a scheduler on a device back end. All features
+* of XNandPsu_SchedOps.Flags are enabled.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	OpsPtr is a pointer to the back end, which is copied.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the geometry is not supported.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_SchedInitialize(XNandPsu_Sched *SchedPtr,
+				const XNandPsu_SchedOps *OpsPtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(OpsPtr != NULL);
+	Xil_AssertNonvoid(OpsPtr->Issue != NULL);
+	Xil_AssertNonvoid(OpsPtr->Status != NULL);
+
+	if ((OpsPtr->BytesPerPage == 0U) ||
+		((OpsPtr->BytesPerPage & 3U) != 0U) ||
+		(OpsPtr->PagesPerBlock == 0U) ||
+		(OpsPtr->PagesPerLun == 0U) ||
+		((OpsPtr->PagesPerLun % OpsPtr->PagesPerBlock) != 0U) ||
+		(OpsPtr->LunsPerTarget == 0U) ||
+		(OpsPtr->NumDies == 0U) ||
+		(OpsPtr->NumDies > XNANDPSU_SCHED_MAX_DIES) ||
+		((OpsPtr->NumDies % OpsPtr->LunsPerTarget) != 0U) ||
+		(((u64)OpsPtr->PagesPerLun * OpsPtr->NumDies) > 0xFFFFFFFFU)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	SchedPtr->Ops = *OpsPtr;
+	SchedPtr->Flags = OpsPtr->Flags;
+	XNandPsu_SchedReset(SchedPtr, NULL, 0U);
+	(void)memset(&SchedPtr->Stats, 0, sizeof(SchedPtr->Stats));
+	SchedPtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function selects the device features the scheduler uses, e.g. to
+* compare with the page at a time access of XNandPsu_Read().
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Flags is a combination of XNANDPSU_SCHED_CACHE_READ,
+*		XNANDPSU_SCHED_CACHE_PROGRAM and XNANDPSU_SCHED_MULTI_LUN.
+*		Features the back end does not support are ignored.
+*
+* @return
+*		None
+*
+* @note		No batch or stream may be in progress.
+*
+******************************************************************************/
+void XNandPsu_SchedSetFlags(XNandPsu_Sched *SchedPtr, u32 Flags)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(SchedPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(SchedPtr->Pending == 0U);
+
+	SchedPtr->Flags = Flags & SchedPtr->Ops.Flags;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs a batch of requests. Requests of the same die are
+* executed in the order of the array, requests of different dies are
+* interleaved. The result of each request is stored in its Status field.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Reqs is the array of requests.
+* @param	NumReqs is the number of requests.
+*
+* @return
+*		- XST_SUCCESS if all requests succeeded.
+*		- XST_FAILURE if a request failed.
+*		- XST_INVALID_PARAM if a request is not valid. No request is
+*		executed then.
+*		- XST_DEVICE_BUSY if a stream is open on the scheduler.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_SchedSubmit(XNandPsu_Sched *SchedPtr, XNandPsu_SchedReq *Reqs,
+				u32 NumReqs)
+{
+	u32 NumPages;
+	u32 Index;
+	s32 Status;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(SchedPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((Reqs != NULL) || (NumReqs == 0U));
+
+	if (SchedPtr->Pending != 0U) {
+		return (s32)XST_DEVICE_BUSY;
+	}
+
+	NumPages = SchedPtr->Ops.PagesPerLun * SchedPtr->Ops.NumDies;
+	for (Index = 0U; Index < NumReqs; Index++) {
+		if ((Reqs[Index].Page >= NumPages) ||
+			((Reqs[Index].Op != XNANDPSU_SCHED_READ) &&
+			(Reqs[Index].Op != XNANDPSU_SCHED_PROGRAM) &&
+			(Reqs[Index].Op != XNANDPSU_SCHED_ERASE)) ||
+			((Reqs[Index].Op != XNANDPSU_SCHED_ERASE) &&
+			(Reqs[Index].BufPtr == NULL))) {
+			return (s32)XST_INVALID_PARAM;
+		}
+	}
+
+	XNandPsu_SchedReset(SchedPtr, Reqs, NumReqs);
+	for (Index = 0U; Index < NumReqs; Index++) {
+		Reqs[Index].State = XNANDPSU_SCHED_QUEUED;
+		Reqs[Index].Status = (s32)XST_FAILURE;
+	}
+	SchedPtr->Tail = NumReqs;
+	SchedPtr->Pending = NumReqs;
+
+	Status = XNandPsu_SchedRun(SchedPtr, NULL);
+	if (Status == XST_SUCCESS) {
+		for (Index = 0U; Index < NumReqs; Index++) {
+			if (Reqs[Index].Status != XST_SUCCESS) {
+				Status = (s32)XST_FAILURE;
+				break;
+			}
+		}
+	}
+	XNandPsu_SchedReset(SchedPtr, NULL, 0U);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function opens a read stream of Length bytes at flash offset Offset.
+* Bad blocks are skipped and do not count in Length, as in XNandPsu_Read().
+* The reads of the first pages are started before the function returns.
+*
+* @param	StreamPtr is a pointer to the stream.
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Offset is the flash offset of the image.
+* @param	Length is the number of bytes to read.
+* @param	BufferPtr is the ring of NumBufs page buffers, word aligned.
+* @param	NumBufs is the number of page buffers, at least 3 to keep a
+*		die in cache read mode while the application holds a buffer.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_INVALID_PARAM if the range is outside of the flash or
+*		NumBufs is not supported.
+*		- XST_DEVICE_BUSY if a batch or stream uses the scheduler.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_StreamOpen(XNandPsu_Stream *StreamPtr, XNandPsu_Sched *SchedPtr,
+				u64 Offset, u64 Length, u8 *BufferPtr,
+				u32 NumBufs)
+{
+	u64 DeviceSize;
+	u32 Index;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(StreamPtr != NULL);
+	Xil_AssertNonvoid(SchedPtr != NULL);
+	Xil_AssertNonvoid(SchedPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+
+	DeviceSize = (u64)SchedPtr->Ops.PagesPerLun * SchedPtr->Ops.NumDies *
+			SchedPtr->Ops.BytesPerPage;
+	if ((NumBufs < 2U) || (NumBufs > XNANDPSU_SCHED_MAX_BUFS) ||
+		(((UINTPTR)BufferPtr & 3U) != 0U) ||
+		(Offset > DeviceSize) || (Length > (DeviceSize - Offset))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+	if (SchedPtr->Pending != 0U) {
+		return (s32)XST_DEVICE_BUSY;
+	}
+
+	StreamPtr->SchedPtr = SchedPtr;
+	for (Index = 0U; Index < NumBufs; Index++) {
+		StreamPtr->Reqs[Index].Op = XNANDPSU_SCHED_READ;
+		StreamPtr->Reqs[Index].State = XNANDPSU_SCHED_DONE;
+		StreamPtr->Reqs[Index].BufPtr = BufferPtr +
+				(Index * SchedPtr->Ops.BytesPerPage);
+		StreamPtr->Col[Index] = 0U;
+		StreamPtr->Length[Index] = 0U;
+	}
+	StreamPtr->NumBufs = NumBufs;
+	StreamPtr->Offset = Offset;
+	StreamPtr->Remaining = Length;
+	StreamPtr->CheckedBlock = XNANDPSU_SCHED_NO_BLOCK;
+	StreamPtr->Held = 0U;
+	StreamPtr->Truncated = 0U;
+	StreamPtr->Status = XST_SUCCESS;
+
+	XNandPsu_SchedReset(SchedPtr, StreamPtr->Reqs, NumBufs);
+	XNandPsu_StreamQueue(StreamPtr);
+	(void)XNandPsu_SchedKick(SchedPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the next part of a stream. The data is in one of
+* the page buffers of the stream and stays valid until the next call of
+* XNandPsu_StreamRead() or XNandPsu_StreamClose(). Reads of the following
+* pages continue in the background until then.
+*
+* @param	StreamPtr is a pointer to the stream.
+* @param	DataPtr returns a pointer to the data.
+* @param	ByteCountPtr returns the number of bytes, at most one page.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_NO_DATA at the end of the stream.
+*		- XST_FAILURE if the page could not be read. The stream
+*		continues with the next page. At the end of the stream, if
+*		the flash ended before Length good bytes were found.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_StreamRead(XNandPsu_Stream *StreamPtr, u8 **DataPtr,
+				u32 *ByteCountPtr)
+{
+	XNandPsu_Sched *SchedPtr;
+	XNandPsu_SchedReq *ReqPtr;
+	u32 Index;
+	s32 Status;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(StreamPtr != NULL);
+	Xil_AssertNonvoid(StreamPtr->SchedPtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+	Xil_AssertNonvoid(ByteCountPtr != NULL);
+
+	SchedPtr = StreamPtr->SchedPtr;
+	*DataPtr = NULL;
+	*ByteCountPtr = 0U;
+
+	/* The application returns the buffer it held */
+	if (StreamPtr->Held != 0U) {
+		SchedPtr->Head++;
+		StreamPtr->Held = 0U;
+	}
+	XNandPsu_StreamQueue(StreamPtr);
+
+	if (SchedPtr->Head == SchedPtr->Tail) {
+		if (StreamPtr->Truncated != 0U) {
+			return (s32)XST_FAILURE;
+		}
+		return (s32)XST_NO_DATA;
+	}
+
+	Index = SchedPtr->Head % StreamPtr->NumBufs;
+	ReqPtr = &StreamPtr->Reqs[Index];
+	if (ReqPtr->State != XNANDPSU_SCHED_DONE) {
+		Status = XNandPsu_SchedRun(SchedPtr, ReqPtr);
+		if (Status != XST_SUCCESS) {
+			StreamPtr->Status = Status;
+			return Status;
+		}
+	} else {
+		(void)XNandPsu_SchedKick(SchedPtr);
+	}
+
+	*DataPtr = ReqPtr->BufPtr + StreamPtr->Col[Index];
+	*ByteCountPtr = StreamPtr->Length[Index];
+	StreamPtr->Held = 1U;
+	if ((ReqPtr->Status != XST_SUCCESS) &&
+		(StreamPtr->Status == XST_SUCCESS)) {
+		StreamPtr->Status = ReqPtr->Status;
+	}
+
+	return ReqPtr->Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function closes a stream. Reads that have not been started are
+* dropped and the reads in flight are completed, so that the controller can
+* be used for other commands.
+*
+* @param	StreamPtr is a pointer to the stream.
+*
+* @return
+*		- XST_SUCCESS if all parts of the stream that were read
+*		succeeded.
+*		- XST_FAILURE if a part of the stream failed.
+*
+* @note		None
+*
+******************************************************************************/
+s32 XNandPsu_StreamClose(XNandPsu_Stream *StreamPtr)
+{
+	XNandPsu_Sched *SchedPtr;
+	XNandPsu_SchedReq *ReqPtr;
+	u32 Seq;
+	s32 Status;
+
+	/* Assert the input arguments. */
+	Xil_AssertNonvoid(StreamPtr != NULL);
+	Xil_AssertNonvoid(StreamPtr->SchedPtr != NULL);
+
+	SchedPtr = StreamPtr->SchedPtr;
+	for (Seq = SchedPtr->Head; Seq != SchedPtr->Tail; Seq++) {
+		ReqPtr = &StreamPtr->Reqs[Seq % StreamPtr->NumBufs];
+		if (ReqPtr->State == XNANDPSU_SCHED_QUEUED) {
+			ReqPtr->State = XNANDPSU_SCHED_DONE;
+			SchedPtr->Pending--;
+		}
+	}
+
+	Status = XNandPsu_SchedRun(SchedPtr, NULL);
+	XNandPsu_SchedReset(SchedPtr, NULL, 0U);
+	StreamPtr->SchedPtr = NULL;
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	return StreamPtr->Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function returns the counters of a scheduler.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	StatsPtr is filled with the counters.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_SchedGetStats(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedStats *StatsPtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = SchedPtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function clears the counters of a scheduler.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+void XNandPsu_SchedClearStats(XNandPsu_Sched *SchedPtr)
+{
+	/* Assert the input arguments. */
+	Xil_AssertVoid(SchedPtr != NULL);
+
+	(void)memset(&SchedPtr->Stats, 0, sizeof(SchedPtr->Stats));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets up the request ring and puts all dies in idle state.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Reqs is the request ring.
+* @param	NumReqs is the size of the ring.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+static void XNandPsu_SchedReset(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *Reqs, u32 NumReqs)
+{
+	SchedPtr->Reqs = Reqs;
+	SchedPtr->NumReqs = NumReqs;
+	SchedPtr->Head = 0U;
+	SchedPtr->Tail = 0U;
+	SchedPtr->Pending = 0U;
+	SchedPtr->NextDie = 0U;
+	(void)memset(SchedPtr->Dies, 0, sizeof(SchedPtr->Dies));
+}
+
+/*****************************************************************************/
+/**
+*
+* This function finds the oldest request of a die that has not been started.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Die is the die.
+* @param	From is the sequence number to search from.
+* @param	SeqPtr returns the sequence number of the request, or of the
+*		tail of the ring if there is none.
+*
+* @return	The request, or NULL if there is none.
+*
+* @note		None
+*
+******************************************************************************/
+static XNandPsu_SchedReq *XNandPsu_SchedFind(XNandPsu_Sched *SchedPtr,
+				u32 Die, u32 From, u32 *SeqPtr)
+{
+	XNandPsu_SchedReq *ReqPtr;
+	u32 Seq = From;
+
+	/* Ring entries before the head have been reused */
+	if ((s32)(Seq - SchedPtr->Head) < 0) {
+		Seq = SchedPtr->Head;
+	}
+	for (; Seq != SchedPtr->Tail; Seq++) {
+		ReqPtr = &SchedPtr->Reqs[Seq % SchedPtr->NumReqs];
+		if ((ReqPtr->State == XNANDPSU_SCHED_QUEUED) &&
+			((ReqPtr->Page / SchedPtr->Ops.PagesPerLun) == Die)) {
+			*SeqPtr = Seq;
+			return ReqPtr;
+		}
+	}
+	*SeqPtr = Seq;
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function completes a request.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	ReqPtr is the request.
+* @param	Status is the result of the request.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+static void XNandPsu_SchedComplete(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *ReqPtr, s32 Status)
+{
+	ReqPtr->Status = Status;
+	ReqPtr->State = XNANDPSU_SCHED_DONE;
+	SchedPtr->Pending--;
+
+	if (ReqPtr->Op == XNANDPSU_SCHED_READ) {
+		SchedPtr->Stats.Reads++;
+	} else if (ReqPtr->Op == XNANDPSU_SCHED_PROGRAM) {
+		SchedPtr->Stats.Programs++;
+	} else {
+		SchedPtr->Stats.Erases++;
+	}
+	if (Status != XST_SUCCESS) {
+		SchedPtr->Stats.Failures++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function fails all requests in flight on a die after the back end
+* failed to issue a command or to read the status, and puts the die in idle
+* state.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Die is the die.
+* @param	Status is the result of the requests.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+static void XNandPsu_SchedDieFail(XNandPsu_Sched *SchedPtr, u32 Die,
+				s32 Status)
+{
+	XNandPsu_SchedDie *DiePtr = &SchedPtr->Dies[Die];
+
+	if (DiePtr->Array != NULL) {
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Array, Status);
+	}
+	if ((DiePtr->Cache != NULL) && (DiePtr->Cache != DiePtr->Array)) {
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Cache, Status);
+	}
+	if (DiePtr->Active != NULL) {
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Active, Status);
+	}
+	if (DiePtr->Prog != NULL) {
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Prog, Status);
+	}
+	DiePtr->Array = NULL;
+	DiePtr->Cache = NULL;
+	DiePtr->Active = NULL;
+	DiePtr->Prog = NULL;
+	DiePtr->Busy = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function checks if another LUN of the target of a die has an
+* operation in progress. It is used for devices without multi-LUN
+* operations, which allow one LUN of a target at a time.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Die is the die.
+*
+* @return	1 if another LUN of the target is in use, 0 otherwise.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_SchedTargetBusy(XNandPsu_Sched *SchedPtr, u32 Die)
+{
+	XNandPsu_SchedDie *DiePtr;
+	u32 First;
+	u32 Index;
+
+	First = Die - (Die % SchedPtr->Ops.LunsPerTarget);
+	for (Index = First; Index < (First + SchedPtr->Ops.LunsPerTarget);
+								Index++) {
+		DiePtr = &SchedPtr->Dies[Index];
+		if ((Index != Die) && ((DiePtr->Busy != 0U) ||
+			(DiePtr->Array != NULL) || (DiePtr->Cache != NULL) ||
+			(DiePtr->Active != NULL) || (DiePtr->Prog != NULL))) {
+			return 1U;
+		}
+	}
+
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function reads the status of a busy die and completes the command
+* that made it busy when the die is ready.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Die is the die.
+*
+* @return
+*		None
+*
+* @note		None
+*
+******************************************************************************/
+static void XNandPsu_SchedPoll(XNandPsu_Sched *SchedPtr, u32 Die)
+{
+	XNandPsu_SchedDie *DiePtr = &SchedPtr->Dies[Die];
+	u8 OnfiStatus = 0U;
+	s32 Status;
+
+	Status = SchedPtr->Ops.Status(SchedPtr->Ops.Ref, Die, &OnfiStatus);
+	SchedPtr->Stats.StatusPolls++;
+	if (Status != XST_SUCCESS) {
+		XNandPsu_SchedDieFail(SchedPtr, Die, Status);
+		return;
+	}
+	if ((OnfiStatus & XNANDPSU_SCHED_STS_RDY) == 0U) {
+		return;
+	}
+
+	DiePtr->Busy = 0U;
+	switch (DiePtr->LastCmd) {
+	case XNANDPSU_SCHED_CMD_READ:
+		/* The page can be transferred from the cache register */
+		DiePtr->Cache = DiePtr->Array;
+		break;
+	case XNANDPSU_SCHED_CMD_ERASE:
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Active,
+			((OnfiStatus & XNANDPSU_SCHED_STS_FAIL) != 0U) ?
+			(s32)XST_FAILURE : (s32)XST_SUCCESS);
+		DiePtr->Active = NULL;
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM_CACHE:
+		/*
+		 * The cache register is free, so the previous page has been
+		 * programmed and FAILC is its result. This page is still
+		 * being programmed.
+		 */
+		if (DiePtr->Prog != NULL) {
+			XNandPsu_SchedComplete(SchedPtr, DiePtr->Prog,
+				((OnfiStatus & XNANDPSU_SCHED_STS_FAILC) != 0U) ?
+				(s32)XST_FAILURE : (s32)XST_SUCCESS);
+		}
+		DiePtr->Prog = DiePtr->Active;
+		DiePtr->Active = NULL;
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM:
+		if (DiePtr->Prog != NULL) {
+			XNandPsu_SchedComplete(SchedPtr, DiePtr->Prog,
+				((OnfiStatus & XNANDPSU_SCHED_STS_FAILC) != 0U) ?
+				(s32)XST_FAILURE : (s32)XST_SUCCESS);
+			DiePtr->Prog = NULL;
+		}
+		XNandPsu_SchedComplete(SchedPtr, DiePtr->Active,
+			((OnfiStatus & XNANDPSU_SCHED_STS_FAIL) != 0U) ?
+			(s32)XST_FAILURE : (s32)XST_SUCCESS);
+		DiePtr->Active = NULL;
+		break;
+	default:
+		/* Cache read commands, the next page is being read */
+		break;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This function issues the next command of a die that is ready, if it is a
+* page transfer when Transfer is set and an array command otherwise.
+*
+* A read is started with 00h-30h. When the page is in the cache register
+* and the die has another read, the next read is started with a cache read
+* command before the page is transferred. When a page has been
+* transferred during a cache read, the next cache read command moves the
+* page read meanwhile into the cache register; the last one is 3Fh.
+* Programs use 80h-15h when the die has another program, so the die
+* returns to ready as soon as the page has been moved out of the cache
+* register, and 80h-10h otherwise.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	Die is the die.
+* @param	Transfer selects page transfers or array commands.
+*
+* @return	1 if a command was issued, 0 otherwise.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_SchedStep(XNandPsu_Sched *SchedPtr, u32 Die,
+				u32 Transfer)
+{
+	XNandPsu_SchedDie *DiePtr = &SchedPtr->Dies[Die];
+	XNandPsu_SchedReq *NextPtr;
+	XNandPsu_SchedReq *AfterPtr;
+	XNandPsu_SchedReq *ReqPtr = NULL;
+	u32 PagesPerBlock = SchedPtr->Ops.PagesPerBlock;
+	u32 Cmd;
+	u32 Page;
+	u32 Seq;
+	u32 CacheNext;
+	s32 Status;
+
+	if (DiePtr->Busy != 0U) {
+		return 0U;
+	}
+
+	NextPtr = XNandPsu_SchedFind(SchedPtr, Die, DiePtr->Cursor,
+					&DiePtr->Cursor);
+	CacheNext = (u32)(((SchedPtr->Flags & XNANDPSU_SCHED_CACHE_READ) !=
+				0U) && (NextPtr != NULL) &&
+			(NextPtr->Op == XNANDPSU_SCHED_READ));
+
+	if ((DiePtr->Cache != NULL) && ((DiePtr->Cache != DiePtr->Array) ||
+		(CacheNext == 0U))) {
+		Cmd = XNANDPSU_SCHED_CMD_DATA_OUT;
+		ReqPtr = DiePtr->Cache;
+	} else if (DiePtr->Array != NULL) {
+		if (CacheNext != 0U) {
+			/* 31h reads the next page of the same block */
+			if ((NextPtr->Page == (DiePtr->Array->Page + 1U)) &&
+				((NextPtr->Page % PagesPerBlock) != 0U)) {
+				Cmd = XNANDPSU_SCHED_CMD_READ_CACHE_SEQ;
+			} else {
+				Cmd = XNANDPSU_SCHED_CMD_READ_CACHE_RND;
+			}
+			ReqPtr = NextPtr;
+		} else {
+			Cmd = XNANDPSU_SCHED_CMD_READ_CACHE_END;
+		}
+	} else if (NextPtr != NULL) {
+		/*
+		 * A die with a cache program in flight always has the next
+		 * program queued, see below, so it is not blocked here.
+		 */
+		if (((SchedPtr->Flags & XNANDPSU_SCHED_MULTI_LUN) == 0U) &&
+			(XNandPsu_SchedTargetBusy(SchedPtr, Die) != 0U)) {
+			return 0U;
+		}
+		if (NextPtr->Op == XNANDPSU_SCHED_READ) {
+			Cmd = XNANDPSU_SCHED_CMD_READ;
+		} else if (NextPtr->Op == XNANDPSU_SCHED_ERASE) {
+			Cmd = XNANDPSU_SCHED_CMD_ERASE;
+		} else {
+			AfterPtr = XNandPsu_SchedFind(SchedPtr, Die,
+						DiePtr->Cursor + 1U, &Seq);
+			if (((SchedPtr->Flags &
+				XNANDPSU_SCHED_CACHE_PROGRAM) != 0U) &&
+				(AfterPtr != NULL) &&
+				(AfterPtr->Op == XNANDPSU_SCHED_PROGRAM)) {
+				Cmd = XNANDPSU_SCHED_CMD_PROGRAM_CACHE;
+			} else {
+				Cmd = XNANDPSU_SCHED_CMD_PROGRAM;
+			}
+		}
+		ReqPtr = NextPtr;
+	} else {
+		return 0U;
+	}
+
+	if (((Cmd == XNANDPSU_SCHED_CMD_DATA_OUT) ||
+		(Cmd == XNANDPSU_SCHED_CMD_PROGRAM) ||
+		(Cmd == XNANDPSU_SCHED_CMD_PROGRAM_CACHE)) != (Transfer != 0U)) {
+		return 0U;
+	}
+
+	Page = (ReqPtr != NULL) ? ReqPtr->Page :
+			(Die * SchedPtr->Ops.PagesPerLun);
+	Status = SchedPtr->Ops.Issue(SchedPtr->Ops.Ref, Cmd, Die, Page,
+			(ReqPtr != NULL) ? ReqPtr->BufPtr : NULL);
+	SchedPtr->Stats.Commands++;
+
+	if (Cmd == XNANDPSU_SCHED_CMD_DATA_OUT) {
+		/* A transfer error only fails its page */
+		XNandPsu_SchedComplete(SchedPtr, ReqPtr, Status);
+		if (DiePtr->Array == DiePtr->Cache) {
+			DiePtr->Array = NULL;
+		}
+		DiePtr->Cache = NULL;
+		return 1U;
+	}
+
+	switch (Cmd) {
+	case XNANDPSU_SCHED_CMD_READ:
+		DiePtr->Array = ReqPtr;
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_SEQ:
+	case XNANDPSU_SCHED_CMD_READ_CACHE_RND:
+		DiePtr->Cache = DiePtr->Array;
+		DiePtr->Array = ReqPtr;
+		SchedPtr->Stats.CacheReads++;
+		break;
+	case XNANDPSU_SCHED_CMD_READ_CACHE_END:
+		DiePtr->Cache = DiePtr->Array;
+		DiePtr->Array = NULL;
+		break;
+	case XNANDPSU_SCHED_CMD_PROGRAM_CACHE:
+		SchedPtr->Stats.CachePrograms++;
+		DiePtr->Active = ReqPtr;
+		break;
+	default:
+		DiePtr->Active = ReqPtr;
+		break;
+	}
+	if (ReqPtr != NULL) {
+		ReqPtr->State = XNANDPSU_SCHED_ACTIVE;
+	}
+	DiePtr->LastCmd = (u8)Cmd;
+	DiePtr->Busy = 1U;
+
+	if (Status != XST_SUCCESS) {
+		XNandPsu_SchedDieFail(SchedPtr, Die, Status);
+	}
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function polls the busy dies once and starts the array commands of
+* the dies that are ready, without waiting.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+*
+* @return	1 if a command was issued, 0 otherwise.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 XNandPsu_SchedKick(XNandPsu_Sched *SchedPtr)
+{
+	u32 Issued = 0U;
+	u32 Die;
+
+	for (Die = 0U; Die < SchedPtr->Ops.NumDies; Die++) {
+		if (SchedPtr->Dies[Die].Busy != 0U) {
+			XNandPsu_SchedPoll(SchedPtr, Die);
+		}
+	}
+	for (Die = 0U; Die < SchedPtr->Ops.NumDies; Die++) {
+		Issued |= XNandPsu_SchedStep(SchedPtr, Die, 0U);
+	}
+
+	return Issued;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the requests until a request has completed, or until
+* all requests have completed. Each round polls the busy dies, starts the
+* array commands of the ready dies and then transfers one page, taking the
+* dies in turn.
+*
+* @param	SchedPtr is a pointer to the XNandPsu_Sched instance.
+* @param	WaitPtr is the request to wait for, or NULL for all.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if no request can make progress, which does not
+*		happen with a back end that becomes ready.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 XNandPsu_SchedRun(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedReq *WaitPtr)
+{
+	u32 NumDies = SchedPtr->Ops.NumDies;
+	u32 Issued;
+	u32 Busy;
+	u32 Count;
+	u32 Die;
+
+	for (;;) {
+		Issued = XNandPsu_SchedKick(SchedPtr);
+		if (((WaitPtr != NULL) &&
+			(WaitPtr->State == XNANDPSU_SCHED_DONE)) ||
+			((WaitPtr == NULL) && (SchedPtr->Pending == 0U))) {
+			break;
+		}
+
+		for (Count = 0U; Count < NumDies; Count++) {
+			Die = (SchedPtr->NextDie + Count) % NumDies;
+			if (XNandPsu_SchedStep(SchedPtr, Die, 1U) != 0U) {
+				SchedPtr->NextDie = (Die + 1U) % NumDies;
+				Issued = 1U;
+				break;
+			}
+		}
+
+		if (Issued == 0U) {
+			Busy = 0U;
+			for (Die = 0U; Die < NumDies; Die++) {
+				Busy |= SchedPtr->Dies[Die].Busy;
+			}
+			if (Busy == 0U) {
+				return (s32)XST_FAILURE;
+			}
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function queues the reads of a stream as far as the ring allows,
+* skipping bad blocks.
+*
+* @param	StreamPtr is a pointer to the stream.
+*
+* @return
+*		None
+*
+* @note		If the flash ends before the stream, the stream ends there
+*		and its status is XST_FAILURE.
+*
+******************************************************************************/
+static void XNandPsu_StreamQueue(XNandPsu_Stream *StreamPtr)
+{
+	XNandPsu_Sched *SchedPtr = StreamPtr->SchedPtr;
+	XNandPsu_SchedOps *OpsPtr = &SchedPtr->Ops;
+	XNandPsu_SchedReq *ReqPtr;
+	u32 BlockSize = OpsPtr->PagesPerBlock * OpsPtr->BytesPerPage;
+	u64 DeviceSize;
+	u32 Block;
+	u32 Index;
+	u32 Col;
+	u32 Length;
+
+	DeviceSize = (u64)OpsPtr->PagesPerLun * OpsPtr->NumDies *
+			OpsPtr->BytesPerPage;
+
+	while ((StreamPtr->Remaining > 0U) &&
+		((SchedPtr->Tail - SchedPtr->Head) < StreamPtr->NumBufs)) {
+		if (StreamPtr->Offset >= DeviceSize) {
+			StreamPtr->Remaining = 0U;
+			StreamPtr->Truncated = 1U;
+			StreamPtr->Status = (s32)XST_FAILURE;
+			break;
+		}
+		Block = (u32)(StreamPtr->Offset / BlockSize);
+		if ((OpsPtr->IsBlockBad != NULL) &&
+			(Block != StreamPtr->CheckedBlock)) {
+			StreamPtr->CheckedBlock = Block;
+			if (OpsPtr->IsBlockBad(OpsPtr->Ref, Block) ==
+							XST_SUCCESS) {
+				StreamPtr->Offset += BlockSize;
+				continue;
+			}
+		}
+
+		Col = (u32)(StreamPtr->Offset % OpsPtr->BytesPerPage);
+		Length = OpsPtr->BytesPerPage - Col;
+		if (Length > StreamPtr->Remaining) {
+			Length = (u32)StreamPtr->Remaining;
+		}
+
+		Index = SchedPtr->Tail % StreamPtr->NumBufs;
+		ReqPtr = &StreamPtr->Reqs[Index];
+		ReqPtr->Page = (u32)(StreamPtr->Offset / OpsPtr->BytesPerPage);
+		ReqPtr->State = XNANDPSU_SCHED_QUEUED;
+		ReqPtr->Status = (s32)XST_FAILURE;
+		StreamPtr->Col[Index] = Col;
+		StreamPtr->Length[Index] = Length;
+		SchedPtr->Tail++;
+		SchedPtr->Pending++;
+
+		StreamPtr->Offset += Length;
+		StreamPtr->Remaining -= Length;
+	}
+}
+/** @} */
@@ -0,0 +1,313 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xnandpsu_sched.h
+* @addtogroup nandpsu_v1_3
+* @{
+*
+* NAND command scheduler with multi-die interleaving and ONFI cache
+* operations.
+*
+* XNandPsu_Read() and XNandPsu_Write() handle one page at a time: they issue
+* the command, wait until the die is ready and then transfer the page, so
+* the bus is idle for tR or tPROG on every page. The scheduler takes a batch
+* of page read, page program and block erase requests and runs them as one
+* pipeline per die, where a die is one LUN of one target:
+*	- Requests of the same die are executed in the order they were
+*	  submitted. Requests of different dies are independent.
+*	- While one die is busy with tR, tPROG or tBERS, the bus is used to
+*	  start commands on other dies and to transfer their pages, so page
+*	  DMA overlaps with the array time of the other dies.
+*	- Consecutive reads of one die use Read Cache Sequential (31h), or Read
+*	  Cache Random (00h-31h) when the pages are not consecutive, so that
+*	  the transfer of a page overlaps with tR of the next one. The last
+*	  read ends with Read Cache End (3Fh).
+*	- Consecutive programs of one die use Page Cache Program (80h-15h), so
+*	  that the transfer of a page overlaps with tPROG of the previous one.
+*	  The last program uses 80h-10h.
+*	- Array commands of idle dies are started before the next page
+*	  transfer, and page transfers go round robin over the dies.
+*
+* XNandPsu_SchedSubmit() runs a batch of requests and returns when all of
+* them have completed, with the result of each in its Status field.
+*
+* XNandPsu_StreamOpen() and XNandPsu_StreamRead() read a large image
+* through a ring of page buffers. The image is queued as page reads as far
+* ahead as the ring allows, bad blocks are skipped as XNandPsu_Read() does,
+* and each XNandPsu_StreamRead() returns the next part of the image in a
+* page buffer. The die keeps reading ahead in cache read mode while the
+* application processes the data, so a loader that hashes, decrypts or
+* copies an image mostly waits for the bus instead of for tR.
+*
+* The scheduler does not access the controller itself. It issues commands
+* and polls the status of each die through an XNandPsu_SchedOps back end,
+* which describes the geometry and the ONFI features the device supports.
+* XNandPsu_SchedCfgInitialize() in xnandpsu.c sets up a scheduler on the
+* controller of an XNandPsu instance. A host build can use a simulated back
+* end instead, see nandpsu/bench.
+*
+* The scheduler reports program and erase failures of a request as the
+* FAIL and FAILC bits of the status register, and read failures as returned
+* by the page transfer, e.g. uncorrectable ECC errors. A failed request
+* does not stop the other requests. If the back end fails to issue a
+* command or to read the status of a die, all requests in flight on that
+* die fail and the die starts over with its next request.
+*
+* Only one batch or stream can use a scheduler at a time, and the
+* application must not use the controller for other commands while a
+* stream is open.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	   Changes
+* ----- ----   ----------  -----------------------------------------------
+* 1.5   agt    10/17/26    First release
+*
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XNANDPSU_SCHED_H		/* prevent circular inclusions */
+#define XNANDPSU_SCHED_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+#include "xil_types.h"
+#include "xstatus.h"
+#include "xil_assert.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XNANDPSU_SCHED_MAX_DIES		8U	/**< Max LUNs of all targets */
+#define XNANDPSU_SCHED_MAX_BUFS		32U	/**< Max page buffers of a
+						  stream */
+
+/**
+ * @name Request operations
+ * @{
+ */
+#define XNANDPSU_SCHED_READ		1U	/**< Read a page */
+#define XNANDPSU_SCHED_PROGRAM		2U	/**< Program a page */
+#define XNANDPSU_SCHED_ERASE		3U	/**< Erase the block of Page */
+/* @} */
+
+/**
+ * @name Back end commands
+ * @{
+ */
+#define XNANDPSU_SCHED_CMD_READ		1U	/**< 00h-30h, no data */
+#define XNANDPSU_SCHED_CMD_READ_CACHE_SEQ 2U	/**< 31h, reads Page + 1 */
+#define XNANDPSU_SCHED_CMD_READ_CACHE_RND 3U	/**< 00h-31h, reads Page */
+#define XNANDPSU_SCHED_CMD_READ_CACHE_END 4U	/**< 3Fh */
+#define XNANDPSU_SCHED_CMD_DATA_OUT	5U	/**< Transfer of Page from the
+						  cache register of the
+						  die, 06h-E0h */
+#define XNANDPSU_SCHED_CMD_PROGRAM	6U	/**< 80h-data-10h */
+#define XNANDPSU_SCHED_CMD_PROGRAM_CACHE 7U	/**< 80h-data-15h */
+#define XNANDPSU_SCHED_CMD_ERASE	8U	/**< 60h-D0h on the block of
+						  Page */
+/* @} */
+
+/**
+ * @name ONFI status register bits
+ * @{
+ */
+#define XNANDPSU_SCHED_STS_FAIL		0x01U	/**< Last command failed */
+#define XNANDPSU_SCHED_STS_FAILC	0x02U	/**< Command before the last
+						  cache program failed */
+#define XNANDPSU_SCHED_STS_ARDY		0x20U	/**< Array ready */
+#define XNANDPSU_SCHED_STS_RDY		0x40U	/**< Ready for commands */
+/* @} */
+
+/**
+ * @name Device features in XNandPsu_SchedOps.Flags
+ * @{
+ */
+#define XNANDPSU_SCHED_CACHE_READ	0x01U	/**< Read cache commands */
+#define XNANDPSU_SCHED_CACHE_PROGRAM	0x02U	/**< Page cache program */
+#define XNANDPSU_SCHED_MULTI_LUN	0x04U	/**< LUNs of one target can be
+						  busy at the same time,
+						  with Read Status Enhanced
+						  and Change Read Column
+						  Enhanced */
+/* @} */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Issues Cmd to the die Die. Page is a page of the device; for
+ * XNANDPSU_SCHED_CMD_READ_CACHE_SEQ it is the page that the die reads
+ * next. BufPtr is the page data of the data out and program commands. The
+ * function returns when the command and its data have been transferred,
+ * without waiting for the die to become ready.
+ */
+typedef s32 (*XNandPsu_SchedIssue) (void *Ref, u32 Cmd, u32 Die, u32 Page,
+					u8 *BufPtr);
+
+/**
+ * Reads the ONFI status register of the die Die into StatusPtr.
+ */
+typedef s32 (*XNandPsu_SchedStatus) (void *Ref, u32 Die, u8 *StatusPtr);
+
+/**
+ * Returns XST_SUCCESS if the block Block of the device is bad, as
+ * XNandPsu_IsBlockBad() does.
+ */
+typedef s32 (*XNandPsu_SchedIsBlockBad) (void *Ref, u32 Block);
+
+/**
+ * Device back end of a scheduler. The pages of the device are numbered
+ * target after target and LUN after LUN, so the die of a page is
+ * Page / PagesPerLun and the target of a die is Die / LunsPerTarget.
+ */
+typedef struct {
+	XNandPsu_SchedIssue Issue;
+	XNandPsu_SchedStatus Status;
+	XNandPsu_SchedIsBlockBad IsBlockBad;	/**< Used by streams to skip
+						  bad blocks, NULL if there
+						  are none */
+	void *Ref;		/**< Passed to the back end functions */
+	u32 BytesPerPage;	/**< Bytes per page */
+	u32 PagesPerBlock;	/**< Pages per block */
+	u32 PagesPerLun;	/**< Pages per LUN */
+	u32 LunsPerTarget;	/**< LUNs per target */
+	u32 NumDies;		/**< LUNs of all targets */
+	u32 Flags;		/**< Device features, XNANDPSU_SCHED_* */
+} XNandPsu_SchedOps;
+
+/**
+ * A page read, page program or block erase request
+ */
+typedef struct {
+	u8 Op;			/**< XNANDPSU_SCHED_READ/PROGRAM/ERASE */
+	u8 State;		/**< Used by the scheduler */
+	u32 Page;		/**< Page of the device */
+	u8 *BufPtr;		/**< Page data of reads and programs, word
+				  aligned */
+	s32 Status;		/**< Result of the request */
+} XNandPsu_SchedReq;
+
+/**
+ * State of one die
+ */
+typedef struct {
+	XNandPsu_SchedReq *Array;	/**< Read in the data register */
+	XNandPsu_SchedReq *Cache;	/**< Read in the cache register that
+					  has not been transferred */
+	XNandPsu_SchedReq *Active;	/**< Program or erase in flight */
+	XNandPsu_SchedReq *Prog;	/**< Cache program whose result is
+					  reported by the next status */
+	u32 Cursor;		/**< Sequence number to search the next
+				  request of the die from */
+	u8 Busy;		/**< Waiting for the die to become ready */
+	u8 LastCmd;		/**< Command that made the die busy */
+} XNandPsu_SchedDie;
+
+/**
+ * Counters of a scheduler
+ */
+typedef struct {
+	u32 Reads;		/**< Page reads completed */
+	u32 Programs;		/**< Page programs completed */
+	u32 Erases;		/**< Block erases completed */
+	u32 Failures;		/**< Requests that failed */
+	u32 CacheReads;		/**< 31h commands */
+	u32 CachePrograms;	/**< 80h-15h commands */
+	u32 Commands;		/**< Commands issued on the back end */
+	u32 StatusPolls;	/**< Status reads */
+} XNandPsu_SchedStats;
+
+/**
+ * The XNandPsu_Sched instance data. The requests of a batch or stream are
+ * kept in a ring and are identified by sequence numbers; the request of
+ * sequence number N is Reqs[N % NumReqs].
+ */
+typedef struct {
+	XNandPsu_SchedOps Ops;	/**< Device back end */
+	u32 Flags;		/**< Features in use, a subset of
+				  Ops.Flags */
+	XNandPsu_SchedDie Dies[XNANDPSU_SCHED_MAX_DIES];
+	XNandPsu_SchedReq *Reqs;	/**< Request ring */
+	u32 NumReqs;		/**< Size of the request ring */
+	u32 Head;		/**< Oldest request in the ring */
+	u32 Tail;		/**< Next request to add to the ring */
+	u32 Pending;		/**< Requests that have not completed */
+	u32 NextDie;		/**< Die of the next page transfer */
+	XNandPsu_SchedStats Stats;
+	u32 IsReady;		/**< Scheduler is initialized and ready */
+} XNandPsu_Sched;
+
+/**
+ * A read stream of a flash image
+ */
+typedef struct {
+	XNandPsu_Sched *SchedPtr;
+	XNandPsu_SchedReq Reqs[XNANDPSU_SCHED_MAX_BUFS];	/**< One read
+							  per buffer */
+	u32 Col[XNANDPSU_SCHED_MAX_BUFS];	/**< Offset of the data in
+						  each buffer */
+	u32 Length[XNANDPSU_SCHED_MAX_BUFS];	/**< Bytes of the data in
+						  each buffer */
+	u32 NumBufs;		/**< Number of page buffers */
+	u64 Offset;		/**< Flash offset of the next read to queue */
+	u64 Remaining;		/**< Bytes still to queue */
+	u32 CheckedBlock;	/**< Last block checked for being bad */
+	u32 Held;		/**< Buffer of Head is with the application */
+	u32 Truncated;		/**< The flash ended before the stream */
+	s32 Status;		/**< First error of the stream */
+} XNandPsu_Stream;
+
+/************************** Function Prototypes ******************************/
+
+s32 XNandPsu_SchedInitialize(XNandPsu_Sched *SchedPtr,
+				const XNandPsu_SchedOps *OpsPtr);
+void XNandPsu_SchedSetFlags(XNandPsu_Sched *SchedPtr, u32 Flags);
+s32 XNandPsu_SchedSubmit(XNandPsu_Sched *SchedPtr, XNandPsu_SchedReq *Reqs,
+				u32 NumReqs);
+s32 XNandPsu_StreamOpen(XNandPsu_Stream *StreamPtr, XNandPsu_Sched *SchedPtr,
+				u64 Offset, u64 Length, u8 *BufferPtr,
+				u32 NumBufs);
+s32 XNandPsu_StreamRead(XNandPsu_Stream *StreamPtr, u8 **DataPtr,
+				u32 *ByteCountPtr);
+s32 XNandPsu_StreamClose(XNandPsu_Stream *StreamPtr);
+void XNandPsu_SchedGetStats(XNandPsu_Sched *SchedPtr,
+				XNandPsu_SchedStats *StatsPtr);
+void XNandPsu_SchedClearStats(XNandPsu_Sched *SchedPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XNANDPSU_SCHED_H end of protection macro */
+/** @} */
@@ -0,0 +1,327 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file qspibench.c
+*		Host benchmark of the QSPI flash read cache. xqspipsu_cache.c
+*		is built for Linux on a simulated flash back end that keeps
+*		the flash in memory and models the time of each read:
+*		the controller setup cost, command, address and dummy
+*		clocks on one line and the data clocks on the bus width.
+*		A read completes in the background, so prefetches overlap
+*		with the modelled processing of the data by the application.
+*
+*		Each workload runs with one read command per request, as
+*		XFsbl_Qspi32Copy() does, and through the cache with and
+*		without prefetch. It reports the modelled time and
+*		throughput, the hit rate and the number of read commands,
+*		and checks every byte read against the flash contents.
+*
+*		Usage: qspibench [-s flash_mb] [-l line_size] [-n lines]
+*		                 [-c clk_mhz] [-w bus_width] [-o setup_ns]
+*		                 [-a app_ns_per_kb]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 1.8   agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "xqspipsu_cache.h"
+
+#define BENCH_MAX_LINE_SIZE	65536U
+#define BENCH_SEQ_BYTES		(4U * 1024U * 1024U)
+#define BENCH_RAND_OPS		20000U
+#define BENCH_HOT_SIZE		(16U * 1024U)
+
+/* Simulated flash and its time model */
+typedef struct {
+	u8 *Data;
+	u32 Size;
+	u32 Busy;		/* A read has been started */
+	double Now;		/* Processor time in ns */
+	double BusFree;		/* End of the last read in ns */
+	double CmdNs;		/* Setup, command, address and dummy time */
+	double ByteNs;		/* Data phase time per byte */
+	double SetupNs;		/* Processor time to start a read */
+	u32 Commands;
+} SimFlash;
+
+typedef struct {
+	const char *Name;
+	u32 MinSize;		/* Request size range */
+	u32 MaxSize;
+	u32 Region;		/* Bytes of flash the requests fall in */
+	u32 Sequential;
+} Workload;
+
+static SimFlash Flash;
+static u8 *LineBuffer;
+static u8 *ReadBuffer;
+static double AppNsPerByte = 1.0;
+
+static const Workload Workloads[] = {
+	{ "seq 64B",	64U,	64U,	BENCH_SEQ_BYTES, 1U },
+	{ "seq 1K",	1024U,	1024U,	BENCH_SEQ_BYTES, 1U },
+	{ "seq 256K",	262144U, 262144U, BENCH_SEQ_BYTES, 1U },
+	{ "seq mixed",	16U,	4096U,	BENCH_SEQ_BYTES, 1U },
+	{ "hot 16-256B", 16U,	256U,	BENCH_HOT_SIZE, 0U },
+	{ "rand 256B",	256U,	256U,	0U, 0U },
+};
+
+static s32 SimStartRead(void *Ref, u32 Address, u8 *BufPtr, u32 ByteCount)
+{
+	SimFlash *SimPtr = (SimFlash *)Ref;
+	double Start;
+
+	if (SimPtr->Busy != 0U) {
+		fprintf(stderr, "read started while another is in flight\n");
+		exit(1);
+	}
+	if ((ByteCount == 0U) || (Address >= SimPtr->Size) ||
+		(ByteCount > SimPtr->Size - Address)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	SimPtr->Now += SimPtr->SetupNs;
+	Start = (SimPtr->Now > SimPtr->BusFree) ? SimPtr->Now :
+		SimPtr->BusFree;
+	SimPtr->BusFree = Start + SimPtr->CmdNs + (ByteCount * SimPtr->ByteNs);
+	memcpy(BufPtr, SimPtr->Data + Address, ByteCount);
+	SimPtr->Busy = 1U;
+	SimPtr->Commands++;
+	return XST_SUCCESS;
+}
+
+static s32 SimWaitRead(void *Ref)
+{
+	SimFlash *SimPtr = (SimFlash *)Ref;
+
+	if (SimPtr->Busy != 0U) {
+		if (SimPtr->Now < SimPtr->BusFree) {
+			SimPtr->Now = SimPtr->BusFree;
+		}
+		SimPtr->Busy = 0U;
+	}
+	return XST_SUCCESS;
+}
+
+static void AssertCallback(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "assert in %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/* Request of a workload, the same sequence for every mode */
+static void NextRequest(const Workload *WlPtr, u32 Index, u32 *AddrPtr,
+		u32 *SizePtr, u32 *SeqPosPtr)
+{
+	u32 Size = WlPtr->MinSize;
+	u32 Region = (WlPtr->Region != 0U) ? WlPtr->Region : Flash.Size;
+
+	if (WlPtr->MaxSize > WlPtr->MinSize) {
+		Size += (u32)rand() % (WlPtr->MaxSize - WlPtr->MinSize + 1U);
+	}
+	if (WlPtr->Sequential != 0U) {
+		*AddrPtr = *SeqPosPtr;
+		if (Size > Region - *SeqPosPtr) {
+			Size = Region - *SeqPosPtr;
+		}
+		*SeqPosPtr += Size;
+	} else {
+		*AddrPtr = (u32)(((u64)(u32)rand() * 65536U + (u32)rand() +
+				Index) % (Region - Size + 1U));
+	}
+	*SizePtr = Size;
+}
+
+static int RunWorkload(const Workload *WlPtr, int Mode, u32 LineSize,
+		u32 NumLines)
+{
+	static const char *ModeNames[] = { "direct", "cache", "prefetch" };
+	XQspiPsu_Cache Cache;
+	XQspiPsu_CacheStats Stats;
+	XQspiPsu_CacheOps Ops;
+	u32 Ops_Count;
+	u32 Index;
+	u32 Address;
+	u32 Size;
+	u32 SeqPos = 0U;
+	u64 Bytes = 0U;
+	double Hits;
+	u32 Misses;
+	s32 Status;
+
+	Ops.StartRead = SimStartRead;
+	Ops.WaitRead = SimWaitRead;
+	Ops.Ref = &Flash;
+	Ops.Boundary = 0U;
+	Ops.Align = 1U;
+	if (Mode != 0) {
+		Status = XQspiPsu_CacheInitialize(&Cache, &Ops, Flash.Size,
+				LineBuffer, LineSize, NumLines);
+		if (Status != XST_SUCCESS) {
+			fprintf(stderr, "cache initialization failed %d\n",
+				(int)Status);
+			return 1;
+		}
+		XQspiPsu_CacheSetPrefetch(&Cache, (u32)(Mode == 2));
+	}
+
+	Flash.Now = 0.0;
+	Flash.BusFree = 0.0;
+	Flash.Commands = 0U;
+	srand(1);
+	Ops_Count = (WlPtr->Sequential != 0U) ? 0xFFFFFFFFU : BENCH_RAND_OPS;
+	for (Index = 0U; Index < Ops_Count; Index++) {
+		if ((WlPtr->Sequential != 0U) && (SeqPos >= WlPtr->Region)) {
+			break;
+		}
+		NextRequest(WlPtr, Index, &Address, &Size, &SeqPos);
+		if (Mode == 0) {
+			Status = SimStartRead(&Flash, Address, ReadBuffer,
+					Size);
+			if (Status == XST_SUCCESS) {
+				Status = SimWaitRead(&Flash);
+			}
+		} else {
+			Status = XQspiPsu_CacheRead(&Cache, Address,
+					ReadBuffer, Size);
+		}
+		if ((Status != XST_SUCCESS) ||
+			(memcmp(ReadBuffer, Flash.Data + Address, Size) != 0)) {
+			fprintf(stderr, "%s %s: bad read of %u bytes at 0x%x\n",
+				WlPtr->Name, ModeNames[Mode], Size, Address);
+			return 1;
+		}
+		/* The application works on the data */
+		Flash.Now += Size * AppNsPerByte;
+		Bytes += Size;
+	}
+	if (Mode != 0) {
+		(void)XQspiPsu_CacheSync(&Cache);
+		XQspiPsu_CacheGetStats(&Cache, &Stats);
+	}
+
+	printf("%-12s %-9s %10.3f ms %9.2f MB/s %8u cmds", WlPtr->Name,
+		ModeNames[Mode], Flash.Now / 1e6,
+		(Bytes / 1048576.0) / (Flash.Now / 1e9), Flash.Commands);
+	if (Mode != 0) {
+		Misses = Stats.Misses + Stats.ReadArounds;
+		Hits = (Stats.Hits + Misses) ?
+			(100.0 * Stats.Hits) / (Stats.Hits + Misses) : 0.0;
+		printf(" %6.1f%% hits %6u prefetched %6u around %6u direct",
+			Hits, Stats.PrefetchHits, Stats.ReadArounds,
+			Stats.Bypasses);
+	}
+	printf("\n");
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	u32 FlashMb = 32U;
+	u32 LineSize = 4096U;
+	u32 NumLines = 8U;
+	double ClkMhz = 100.0;
+	u32 BusWidth = 4U;
+	double SetupNs = 2000.0;
+	u32 AddrBytes;
+	u32 Index;
+	int Mode;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "s:l:n:c:w:o:a:")) != -1) {
+		switch (Opt) {
+		case 's': FlashMb = (u32)atoi(optarg); break;
+		case 'l': LineSize = (u32)atoi(optarg); break;
+		case 'n': NumLines = (u32)atoi(optarg); break;
+		case 'c': ClkMhz = atof(optarg); break;
+		case 'w': BusWidth = (u32)atoi(optarg); break;
+		case 'o': SetupNs = atof(optarg); break;
+		case 'a': AppNsPerByte = atof(optarg) / 1024.0; break;
+		default:
+			fprintf(stderr, "Usage: qspibench [-s flash_mb] "
+				"[-l line_size] [-n lines] [-c clk_mhz] "
+				"[-w bus_width] [-o setup_ns] "
+				"[-a app_ns_per_kb]\n");
+			return 1;
+		}
+	}
+	if ((LineSize > BENCH_MAX_LINE_SIZE) || (FlashMb == 0U) ||
+		((BusWidth != 1U) && (BusWidth != 2U) && (BusWidth != 4U))) {
+		fprintf(stderr, "invalid options\n");
+		return 1;
+	}
+
+	Xil_AssertSetCallback(AssertCallback);
+
+	Flash.Size = FlashMb * 1024U * 1024U;
+	Flash.Data = malloc(Flash.Size);
+	LineBuffer = aligned_alloc(XQSPIPSU_CACHE_MIN_LINE_SIZE,
+			(size_t)NumLines * LineSize);
+	ReadBuffer = aligned_alloc(XQSPIPSU_CACHE_MIN_LINE_SIZE, 262144U);
+	if ((Flash.Data == NULL) || (LineBuffer == NULL) ||
+		(ReadBuffer == NULL)) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	srand(12345);
+	for (Index = 0U; Index < Flash.Size; Index++) {
+		Flash.Data[Index] = (u8)rand();
+	}
+
+	/* Command and address on one line, 8 dummy clocks, data on BusWidth */
+	AddrBytes = (Flash.Size > 0x1000000U) ? 4U : 3U;
+	Flash.SetupNs = SetupNs;
+	Flash.CmdNs = ((1U + AddrBytes) * 8U + 8U) * 1000.0 / ClkMhz;
+	Flash.ByteNs = (8.0 / BusWidth) * 1000.0 / ClkMhz;
+
+	printf("flash %u MB, %u x %u byte lines, %.0f MHz x%u, setup %.0f ns, "
+		"application %.0f ns/KB\n", FlashMb, NumLines, LineSize,
+		ClkMhz, BusWidth, SetupNs, AppNsPerByte * 1024.0);
+	for (Index = 0U; Index < sizeof(Workloads) / sizeof(Workloads[0]);
+			Index++) {
+		for (Mode = 0; Mode < 3; Mode++) {
+			if (RunWorkload(&Workloads[Index], Mode, LineSize,
+					NumLines) != 0) {
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
@@ -78,6 +78,16 @@
  * check the status of the transfer and report back to the application
  * when done.
  *
+ * Flash reads:
+ * XQspiPsu_FlashInitialize() sets up reads of a serial flash with the fast,
+ * dual or quad output read command that the bus width of the configuration
+ * allows, using 4 byte addresses for devices above 16MB and the connection
+ * mode of the configuration. XQspiPsu_FlashStartRead() starts a DMA read
+ * with XQspiPsu_InterruptTransfer() and XQspiPsu_FlashWaitRead() waits for
+ * it, so that the processor can work while the data phase runs.
+ * XQspiPsu_FlashCacheInitialize() puts the read cache of xqspipsu_cache.h
+ * on top, see that file for details.
+ *
  * <pre>
  * MODIFICATION HISTORY:
  *
@@ -146,6 +156,9 @@
  * 1.8	tjs 07/18/18 Added support for the low density ISSI flash parts.
  * 1.8	tjs 09/06/18 Fixed the code in XQspiPsu_GenFifoEntryData() for data
  *		     transfer length up to 255 for reducing the extra loop.
+ * 1.8	agt 10/17/26 Added the flash read back end in xqspipsu_flash.c and
+ *		     the read cache with sequential prefetch in
+ *		     xqspipsu_cache.c
  * </pre>
  *
  ******************************************************************************/
@@ -161,6 +174,7 @@ extern "C" {
 #include "xstatus.h"
 #include "xqspipsu_hw.h"
 #include "xil_cache.h"
+#include "xqspipsu_cache.h"
 
 /**************************** Type Definitions *******************************/
 /**
@@ -241,6 +255,22 @@ typedef struct {
 	void *StatusRef;	/**< Callback reference for status handler */
 } XQspiPsu;
 
+/**
+ * Reads of a serial flash, see XQspiPsu_FlashInitialize()
+ */
+typedef struct {
+	XQspiPsu *QspiPsuPtr;	/**< Controller of the flash */
+	u32 FlashSize;		/**< Bytes of all flash devices */
+	u32 UseInterrupt;	/**< XQspiPsu_InterruptHandler() is connected */
+	u8 ReadCmd;		/**< Read command */
+	u8 AddrBytes;		/**< 3 or 4 address bytes */
+	u8 DummyClocks;		/**< Dummy clocks after the address */
+	u8 BusWidth;		/**< Bus width of the data phase */
+	volatile s32 Status;	/**< Status of the read in flight */
+	u8 CmdBfr[5];		/**< Command and address */
+	XQspiPsu_Msg Msg[3];	/**< Messages of the read in flight */
+} XQspiPsu_Flash;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /**
@@ -317,6 +347,23 @@ typedef struct {
 #define XQSPIPSU_CONNECTION_MODE_STACKED	1U
 #define XQSPIPSU_CONNECTION_MODE_PARALLEL	2U
 
+/* Bus width of XQspiPsu_Config */
+#define XQSPIPSU_CONFIG_BUSWIDTH_ONE	0U
+#define XQSPIPSU_CONFIG_BUSWIDTH_TWO	1U
+#define XQSPIPSU_CONFIG_BUSWIDTH_FOUR	2U
+
+/* Flash read commands used by XQspiPsu_FlashInitialize() */
+#define XQSPIPSU_FLASH_FAST_READ_CMD	0x0BU
+#define XQSPIPSU_FLASH_DUAL_READ_CMD	0x3BU
+#define XQSPIPSU_FLASH_QUAD_READ_CMD	0x6BU
+#define XQSPIPSU_FLASH_FAST_READ_CMD_4B	0x0CU
+#define XQSPIPSU_FLASH_DUAL_READ_CMD_4B	0x3CU
+#define XQSPIPSU_FLASH_QUAD_READ_CMD_4B	0x6CU
+#define XQSPIPSU_FLASH_DUMMY_CLOCKS	8U
+#define XQSPIPSU_FLASH_SIZE_3B_MAX	0x1000000U /**< Largest device that
+						     *  3 byte addresses
+						     *  reach */
+
 /*QSPI Frequencies*/
 #define XQSPIPSU_FREQ_40MHZ 40000000
 #define XQSPIPSU_FREQ_100MHZ 100000000
@@ -378,6 +425,18 @@ s32 XQspiPsu_SetReadMode(XQspiPsu *InstancePtr, u32 Mode);
 void XQspiPsu_SetWP(XQspiPsu *InstancePtr, u8 Value);
 void XQspiPsu_WriteProtectToggle(XQspiPsu *InstancePtr, u32 Toggle);
 
+/* Flash read functions */
+s32 XQspiPsu_FlashInitialize(XQspiPsu_Flash *FlashPtr, XQspiPsu *InstancePtr,
+				u32 FlashSize, u32 UseInterrupt);
+s32 XQspiPsu_FlashStartRead(void *Ref, u32 Address, u8 *BufPtr,
+				u32 ByteCount);
+s32 XQspiPsu_FlashWaitRead(void *Ref);
+s32 XQspiPsu_FlashRead(XQspiPsu_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+				u32 ByteCount);
+s32 XQspiPsu_FlashCacheInitialize(XQspiPsu_Cache *CachePtr,
+		XQspiPsu_Flash *FlashPtr, u8 *BufferPtr, u32 LineSize,
+		u32 NumLines);
+
 #ifdef __cplusplus
 }
 #endif
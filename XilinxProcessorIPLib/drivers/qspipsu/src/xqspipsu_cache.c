@@ -0,0 +1,704 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xqspipsu_cache.c
+ * @addtogroup qspipsu_v1_8
+ * @{
+ *
+ * This file implements the flash read cache with sequential prefetch. It
+ * only uses the back end of the cache and can be built for a host. See
+ * xqspipsu_cache.h for a description of the cache.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who Date     Changes
+ * ----- --- -------- -----------------------------------------------
+ * 1.8   agt 10/17/26 First release
+ *
+ * </pre>
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xqspipsu_cache.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static XQspiPsu_CacheLine *XQspiPsu_CacheLookup(XQspiPsu_Cache *CachePtr,
+		u32 Address);
+static XQspiPsu_CacheLine *XQspiPsu_CacheVictim(XQspiPsu_Cache *CachePtr,
+		const XQspiPsu_CacheLine *KeepPtr);
+static s32 XQspiPsu_CacheWait(XQspiPsu_Cache *CachePtr);
+static s32 XQspiPsu_CacheTransfer(XQspiPsu_Cache *CachePtr, u32 Address,
+		u8 *BufPtr, u32 ByteCount);
+static void XQspiPsu_CachePrefetch(XQspiPsu_Cache *CachePtr, u32 Address,
+		const XQspiPsu_CacheLine *KeepPtr);
+static XQspiPsu_CacheLine *XQspiPsu_CacheGetLine(XQspiPsu_Cache *CachePtr,
+		u32 Address, s32 *StatusPtr);
+static u32 XQspiPsu_CacheMissedBefore(XQspiPsu_Cache *CachePtr,
+		u32 Address);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ *
+ * Initializes a cache on a flash back end. Prefetch is enabled and reads of
+ * at least two lines bypass the lines.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	OpsPtr is the flash back end, which is copied.
+ * @param	FlashSize is the number of bytes of flash, a multiple of
+ *		LineSize.
+ * @param	BufferPtr is the line buffer of NumLines * LineSize bytes,
+ *		aligned to XQSPIPSU_CACHE_MIN_LINE_SIZE for DMA.
+ * @param	LineSize is the number of bytes of a line, a power of two of
+ *		at least XQSPIPSU_CACHE_MIN_LINE_SIZE that divides the
+ *		Boundary of the back end.
+ * @param	NumLines is the number of lines, 2 to XQSPIPSU_CACHE_MAX_LINES.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- XST_INVALID_PARAM if the sizes do not meet the above.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_CacheInitialize(XQspiPsu_Cache *CachePtr,
+		const XQspiPsu_CacheOps *OpsPtr, u32 FlashSize, u8 *BufferPtr,
+		u32 LineSize, u32 NumLines)
+{
+	u32 Index;
+
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(OpsPtr != NULL);
+	Xil_AssertNonvoid(OpsPtr->StartRead != NULL);
+	Xil_AssertNonvoid(OpsPtr->WaitRead != NULL);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+
+	if ((LineSize < XQSPIPSU_CACHE_MIN_LINE_SIZE) ||
+		((LineSize & (LineSize - 1U)) != 0U) ||
+		(NumLines < 2U) || (NumLines > XQSPIPSU_CACHE_MAX_LINES) ||
+		(FlashSize == 0U) || ((FlashSize % LineSize) != 0U) ||
+		((OpsPtr->Boundary % LineSize) != 0U) ||
+		(((UINTPTR)BufferPtr % XQSPIPSU_CACHE_MIN_LINE_SIZE) != 0U)) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	CachePtr->Ops = *OpsPtr;
+	if (CachePtr->Ops.Align == 0U) {
+		CachePtr->Ops.Align = 1U;
+	}
+	CachePtr->FlashSize = FlashSize;
+	CachePtr->LineSize = LineSize;
+	CachePtr->NumLines = NumLines;
+	CachePtr->BypassSize = 2U * LineSize;
+	CachePtr->Prefetch = (u32)TRUE;
+	CachePtr->Clock = 0U;
+	CachePtr->NextAddress = XQSPIPSU_CACHE_INVALID_ADDR;
+	CachePtr->Pending = NULL;
+	for (Index = 0U; Index < NumLines; Index++) {
+		CachePtr->Lines[Index].Address = XQSPIPSU_CACHE_INVALID_ADDR;
+		CachePtr->Lines[Index].Stamp = 0U;
+		CachePtr->Lines[Index].DataPtr = BufferPtr + (Index * LineSize);
+		CachePtr->Lines[Index].Prefetched = 0U;
+		CachePtr->Missed[Index] = XQSPIPSU_CACHE_INVALID_ADDR;
+	}
+	CachePtr->MissedNext = 0U;
+	(void)memset(&CachePtr->Stats, 0, sizeof(CachePtr->Stats));
+	CachePtr->IsReady = XIL_COMPONENT_IS_READY;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Reads flash through the cache. A read that starts where the previous one
+ * ended is taken as sequential; it reads its blocks into lines and
+ * prefetches the block after each block it reads. Other reads of blocks
+ * that have not been missed recently go directly into the destination.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the flash address.
+ * @param	BufPtr is the destination, word aligned for direct reads.
+ * @param	ByteCount is the number of bytes to read.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- XST_INVALID_PARAM if the range is outside of the flash.
+ *		- The status of the back end if a read failed.
+ *
+ * @note	A prefetch may still be in flight when this function returns.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_CacheRead(XQspiPsu_Cache *CachePtr, u32 Address, u8 *BufPtr,
+		u32 ByteCount)
+{
+	XQspiPsu_CacheLine *LinePtr;
+	u32 Mask;
+	u32 Offset;
+	u32 Count;
+	u32 Direct;
+	u32 Stream;
+	s32 Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(CachePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((BufPtr != NULL) || (ByteCount == 0U));
+
+	if ((Address > CachePtr->FlashSize) ||
+		(ByteCount > (CachePtr->FlashSize - Address))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	CachePtr->Stats.Reads++;
+	Mask = CachePtr->LineSize - 1U;
+	Stream = (u32)(Address == CachePtr->NextAddress);
+
+	while (ByteCount > 0U) {
+		Offset = Address & Mask;
+		/* DMA needs a word aligned destination */
+		Direct = (u32)(((UINTPTR)BufPtr & 3U) == 0U);
+		Count = CachePtr->LineSize - Offset;
+		if (Count > ByteCount) {
+			Count = ByteCount;
+		}
+		LinePtr = XQspiPsu_CacheLookup(CachePtr, Address - Offset);
+
+		if ((LinePtr == NULL) && (Direct != 0U) && (Offset == 0U) &&
+			(CachePtr->BypassSize != 0U) &&
+			(ByteCount >= CachePtr->BypassSize)) {
+			/* Whole lines, read them directly into the buffer */
+			Count = ByteCount & ~Mask;
+			if ((CachePtr->Ops.Boundary != 0U) &&
+				(((Address % CachePtr->Ops.Boundary) + Count) >
+					CachePtr->Ops.Boundary)) {
+				Count = CachePtr->Ops.Boundary -
+					(Address % CachePtr->Ops.Boundary);
+			}
+			Status = XQspiPsu_CacheTransfer(CachePtr, Address,
+					BufPtr, Count);
+			if (Status != XST_SUCCESS) {
+				break;
+			}
+			CachePtr->Stats.Bypasses++;
+			if (CachePtr->Prefetch != 0U) {
+				/* Streaming, keep the next block coming */
+				XQspiPsu_CachePrefetch(CachePtr,
+						Address + Count, NULL);
+			}
+		} else if ((LinePtr == NULL) && (Direct != 0U) &&
+			(Stream == 0U) &&
+			((Address % CachePtr->Ops.Align) == 0U) &&
+			((Count % CachePtr->Ops.Align) == 0U) &&
+			(XQspiPsu_CacheMissedBefore(CachePtr,
+				Address - Offset) == 0U)) {
+			/*
+			 * First miss of the block, read only what is asked,
+			 * together with the following blocks that are not
+			 * cached either
+			 */
+			while ((Count < ByteCount) &&
+				((CachePtr->Ops.Boundary == 0U) ||
+				 (((Address + Count) %
+					CachePtr->Ops.Boundary) != 0U)) &&
+				(XQspiPsu_CacheLookup(CachePtr,
+					Address + Count) == NULL)) {
+				Count += ((ByteCount - Count) >
+					CachePtr->LineSize) ?
+					CachePtr->LineSize :
+					(ByteCount - Count);
+			}
+			if ((Count % CachePtr->Ops.Align) != 0U) {
+				Count -= Count % CachePtr->Ops.Align;
+			}
+			Status = XQspiPsu_CacheTransfer(CachePtr, Address,
+					BufPtr, Count);
+			if (Status != XST_SUCCESS) {
+				break;
+			}
+			CachePtr->Stats.ReadArounds++;
+		} else {
+			LinePtr = XQspiPsu_CacheGetLine(CachePtr,
+					Address - Offset, &Status);
+			if (LinePtr == NULL) {
+				break;
+			}
+			if ((CachePtr->Prefetch != 0U) && (Stream != 0U) &&
+				((CachePtr->BypassSize == 0U) ||
+				 ((ByteCount - Count) < CachePtr->BypassSize))) {
+				/*
+				 * Start the next block before copying this
+				 * one, so that the copy overlaps the transfer,
+				 * unless the rest of the read bypasses the
+				 * lines anyway
+				 */
+				XQspiPsu_CachePrefetch(CachePtr,
+					Address - Offset + CachePtr->LineSize,
+					LinePtr);
+			}
+			(void)memcpy(BufPtr, LinePtr->DataPtr + Offset, Count);
+		}
+
+		Address += Count;
+		BufPtr += Count;
+		ByteCount -= Count;
+	}
+
+	CachePtr->NextAddress = (Status == XST_SUCCESS) ? Address :
+		XQSPIPSU_CACHE_INVALID_ADDR;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Waits for a prefetch in flight, so that the controller can be used for
+ * other commands.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- The status of the back end if the prefetch failed, the
+ *		block is then read again when it is needed.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_CacheSync(XQspiPsu_Cache *CachePtr)
+{
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(CachePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	return XQspiPsu_CacheWait(CachePtr);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Drops the cached blocks of a flash area after it has been programmed or
+ * erased. A prefetch in flight is completed first.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the start of the changed area.
+ * @param	ByteCount is the size of the changed area.
+ *
+ * @return	The result of XQspiPsu_CacheSync().
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_CacheInvalidate(XQspiPsu_Cache *CachePtr, u32 Address,
+		u32 ByteCount)
+{
+	XQspiPsu_CacheLine *LinePtr;
+	u32 Index;
+	u32 Overlap;
+	s32 Status;
+
+	Xil_AssertNonvoid(CachePtr != NULL);
+	Xil_AssertNonvoid(CachePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Status = XQspiPsu_CacheWait(CachePtr);
+
+	for (Index = 0U; Index < CachePtr->NumLines; Index++) {
+		LinePtr = &CachePtr->Lines[Index];
+		if (LinePtr->Address == XQSPIPSU_CACHE_INVALID_ADDR) {
+			continue;
+		}
+		if (LinePtr->Address >= Address) {
+			Overlap = (u32)((LinePtr->Address - Address) <
+					ByteCount);
+		} else {
+			Overlap = (u32)(((Address - LinePtr->Address) <
+					CachePtr->LineSize) &&
+					(ByteCount != 0U));
+		}
+		if (Overlap != 0U) {
+			LinePtr->Address = XQSPIPSU_CACHE_INVALID_ADDR;
+			LinePtr->Prefetched = 0U;
+		}
+	}
+	CachePtr->NextAddress = XQSPIPSU_CACHE_INVALID_ADDR;
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Enables or disables sequential prefetch.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Enable is TRUE to prefetch, FALSE to read blocks on demand
+ *		only.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+void XQspiPsu_CacheSetPrefetch(XQspiPsu_Cache *CachePtr, u32 Enable)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+	Xil_AssertVoid(CachePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	CachePtr->Prefetch = (Enable != 0U) ? (u32)TRUE : (u32)FALSE;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Sets the minimum size of a read that is transferred directly into the
+ * destination buffer instead of through the lines.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	BypassSize is the size in bytes, rounded up to whole lines,
+ *		or 0 to read everything through the lines.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+void XQspiPsu_CacheSetBypassSize(XQspiPsu_Cache *CachePtr, u32 BypassSize)
+{
+	u32 Mask;
+
+	Xil_AssertVoid(CachePtr != NULL);
+	Xil_AssertVoid(CachePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Mask = CachePtr->LineSize - 1U;
+	CachePtr->BypassSize = (BypassSize == 0U) ? 0U :
+		((BypassSize + Mask) & ~Mask);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Copies the counters of the cache.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	StatsPtr receives the counters.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+void XQspiPsu_CacheGetStats(XQspiPsu_Cache *CachePtr,
+		XQspiPsu_CacheStats *StatsPtr)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = CachePtr->Stats;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Clears the counters of the cache.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+void XQspiPsu_CacheClearStats(XQspiPsu_Cache *CachePtr)
+{
+	Xil_AssertVoid(CachePtr != NULL);
+
+	(void)memset(&CachePtr->Stats, 0, sizeof(CachePtr->Stats));
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Finds the line of a block, including a block that is still in flight.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the line aligned flash address.
+ *
+ * @return	The line or NULL if the block is not cached.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static XQspiPsu_CacheLine *XQspiPsu_CacheLookup(XQspiPsu_Cache *CachePtr,
+		u32 Address)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < CachePtr->NumLines; Index++) {
+		if (CachePtr->Lines[Index].Address == Address) {
+			return &CachePtr->Lines[Index];
+		}
+	}
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Chooses the least recently used line, preferring unused lines.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	KeepPtr is a line that must not be replaced, or NULL.
+ *
+ * @return	The line to replace.
+ *
+ * @note	The line of the prefetch in flight is never chosen.
+ *
+ ******************************************************************************/
+static XQspiPsu_CacheLine *XQspiPsu_CacheVictim(XQspiPsu_Cache *CachePtr,
+		const XQspiPsu_CacheLine *KeepPtr)
+{
+	XQspiPsu_CacheLine *LinePtr;
+	XQspiPsu_CacheLine *VictimPtr = NULL;
+	u32 Index;
+
+	for (Index = 0U; Index < CachePtr->NumLines; Index++) {
+		LinePtr = &CachePtr->Lines[Index];
+		if ((LinePtr == KeepPtr) || (LinePtr == CachePtr->Pending)) {
+			continue;
+		}
+		if (LinePtr->Address == XQSPIPSU_CACHE_INVALID_ADDR) {
+			return LinePtr;
+		}
+		if ((VictimPtr == NULL) ||
+			((s32)(LinePtr->Stamp - VictimPtr->Stamp) < 0)) {
+			VictimPtr = LinePtr;
+		}
+	}
+	return VictimPtr;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Completes the prefetch in flight, if any. A failed prefetch leaves its
+ * line unused.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ *
+ * @return	XST_SUCCESS or the status of the failed prefetch.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static s32 XQspiPsu_CacheWait(XQspiPsu_Cache *CachePtr)
+{
+	s32 Status;
+
+	if (CachePtr->Pending == NULL) {
+		return XST_SUCCESS;
+	}
+	Status = CachePtr->Ops.WaitRead(CachePtr->Ops.Ref);
+	if (Status != XST_SUCCESS) {
+		CachePtr->Pending->Address = XQSPIPSU_CACHE_INVALID_ADDR;
+		CachePtr->Pending->Prefetched = 0U;
+	}
+	CachePtr->Pending = NULL;
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Reads from the flash and waits for the data. A prefetch in flight is
+ * completed first; its failure does not fail this read.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the flash address.
+ * @param	BufPtr is the destination.
+ * @param	ByteCount is the number of bytes, within one Boundary.
+ *
+ * @return	XST_SUCCESS or the status of the back end.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static s32 XQspiPsu_CacheTransfer(XQspiPsu_Cache *CachePtr, u32 Address,
+		u8 *BufPtr, u32 ByteCount)
+{
+	s32 Status;
+
+	(void)XQspiPsu_CacheWait(CachePtr);
+
+	CachePtr->Stats.Transfers++;
+	CachePtr->Stats.TransferBytes += ByteCount;
+	Status = CachePtr->Ops.StartRead(CachePtr->Ops.Ref, Address, BufPtr,
+			ByteCount);
+	if (Status == XST_SUCCESS) {
+		Status = CachePtr->Ops.WaitRead(CachePtr->Ops.Ref);
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Starts the read of a block into a free line unless the block is cached,
+ * outside of the flash or another prefetch is in flight.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the line aligned flash address.
+ * @param	KeepPtr is the line being read, which must not be replaced.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static void XQspiPsu_CachePrefetch(XQspiPsu_Cache *CachePtr, u32 Address,
+		const XQspiPsu_CacheLine *KeepPtr)
+{
+	XQspiPsu_CacheLine *LinePtr;
+
+	if ((CachePtr->Pending != NULL) || (Address >= CachePtr->FlashSize) ||
+		(XQspiPsu_CacheLookup(CachePtr, Address) != NULL)) {
+		return;
+	}
+
+	LinePtr = XQspiPsu_CacheVictim(CachePtr, KeepPtr);
+	LinePtr->Address = XQSPIPSU_CACHE_INVALID_ADDR;
+	CachePtr->Stats.Transfers++;
+	CachePtr->Stats.TransferBytes += CachePtr->LineSize;
+	if (CachePtr->Ops.StartRead(CachePtr->Ops.Ref, Address,
+			LinePtr->DataPtr, CachePtr->LineSize) != XST_SUCCESS) {
+		return;
+	}
+	CachePtr->Stats.Prefetches++;
+	LinePtr->Address = Address;
+	LinePtr->Prefetched = 1U;
+	/* As recent as the block being read, it is needed next */
+	LinePtr->Stamp = CachePtr->Clock;
+	CachePtr->Pending = LinePtr;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Returns the line of a block for reading, waiting for its prefetch or
+ * reading it from the flash if needed.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the line aligned flash address.
+ * @param	StatusPtr receives the status of a failed read.
+ *
+ * @return	The line or NULL if the block could not be read.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static XQspiPsu_CacheLine *XQspiPsu_CacheGetLine(XQspiPsu_Cache *CachePtr,
+		u32 Address, s32 *StatusPtr)
+{
+	XQspiPsu_CacheLine *LinePtr;
+	s32 Status;
+
+	LinePtr = XQspiPsu_CacheLookup(CachePtr, Address);
+	if ((LinePtr != NULL) && (LinePtr == CachePtr->Pending)) {
+		CachePtr->Stats.PrefetchWaits++;
+		if (XQspiPsu_CacheWait(CachePtr) != XST_SUCCESS) {
+			LinePtr = NULL;
+		}
+	}
+
+	if (LinePtr != NULL) {
+		CachePtr->Stats.Hits++;
+		if (LinePtr->Prefetched != 0U) {
+			CachePtr->Stats.PrefetchHits++;
+			LinePtr->Prefetched = 0U;
+		}
+	} else {
+		CachePtr->Stats.Misses++;
+		(void)XQspiPsu_CacheWait(CachePtr);
+		LinePtr = XQspiPsu_CacheVictim(CachePtr, NULL);
+		LinePtr->Address = XQSPIPSU_CACHE_INVALID_ADDR;
+		LinePtr->Prefetched = 0U;
+		Status = XQspiPsu_CacheTransfer(CachePtr, Address,
+				LinePtr->DataPtr, CachePtr->LineSize);
+		if (Status != XST_SUCCESS) {
+			*StatusPtr = Status;
+			return NULL;
+		}
+		LinePtr->Address = Address;
+	}
+
+	CachePtr->Clock++;
+	LinePtr->Stamp = CachePtr->Clock;
+	return LinePtr;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Records a miss of a block that is read without a line.
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	Address is the line aligned flash address.
+ *
+ * @return	TRUE if the block was missed recently, FALSE if it has been
+ *		recorded now.
+ *
+ * @note	As many misses as there are lines are remembered.
+ *
+ ******************************************************************************/
+static u32 XQspiPsu_CacheMissedBefore(XQspiPsu_Cache *CachePtr, u32 Address)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < CachePtr->NumLines; Index++) {
+		if (CachePtr->Missed[Index] == Address) {
+			CachePtr->Missed[Index] = XQSPIPSU_CACHE_INVALID_ADDR;
+			return (u32)TRUE;
+		}
+	}
+	CachePtr->Missed[CachePtr->MissedNext] = Address;
+	CachePtr->MissedNext = (CachePtr->MissedNext + 1U) %
+				CachePtr->NumLines;
+	return (u32)FALSE;
+}
+/** @} */
@@ -0,0 +1,202 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xqspipsu_cache.h
+ * @addtogroup qspipsu_v1_8
+ * @{
+ *
+ * Read cache with sequential prefetch for QSPI flash.
+ *
+ * Every XQspiPsu_PolledTransfer() of a flash read costs the command, address
+ * and dummy phases, so loaders that read a flash image in small pieces spend
+ * most of their time outside the data phase. The cache keeps NumLines blocks
+ * of LineSize bytes in a buffer provided by the application and replaces
+ * them least recently used first.
+ *
+ * A read that misses a block which has not been missed recently is read
+ * directly into the destination, so that scattered small reads do not cost
+ * a whole line each; a block is given a line when it is missed again.
+ *
+ * When a read continues where the previous read ended, the block following
+ * the one being read is fetched into a free line in the background while the
+ * application copies the current one, so a sequential reader finds its next
+ * block already in flight or complete. Aligned reads of at least BypassSize
+ * bytes are transferred directly into the destination buffer with one
+ * command.
+ *
+ * The cache does not access the controller itself. It starts and waits for
+ * reads through an XQspiPsu_CacheOps back end, which allows one read in
+ * flight. XQspiPsu_FlashCacheInitialize() sets up a cache on the QSPI read
+ * back end of xqspipsu_flash.c, which uses DMA and the fastest read command
+ * the bus width allows; a host build can use a simulated back end instead.
+ *
+ * The cache does not see program or erase operations. The application calls
+ * XQspiPsu_CacheSync() before it uses the controller for other commands,
+ * as a prefetch may be in flight, and XQspiPsu_CacheInvalidate() for flash
+ * areas it has changed.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who Date     Changes
+ * ----- --- -------- -----------------------------------------------
+ * 1.8   agt 10/17/26 First release
+ *
+ * </pre>
+ *
+ ******************************************************************************/
+#ifndef XQSPIPSU_CACHE_H_		/* prevent circular inclusions */
+#define XQSPIPSU_CACHE_H_		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XQSPIPSU_CACHE_MAX_LINES	32U	/**< Maximum number of lines */
+#define XQSPIPSU_CACHE_MIN_LINE_SIZE	64U	/**< One data cache line, so
+						  *  that DMA invalidation of
+						  *  a line does not touch
+						  *  its neighbours */
+#define XQSPIPSU_CACHE_INVALID_ADDR	0xFFFFFFFFU /**< Address of an unused
+						     *  line */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Starts a read of ByteCount bytes at flash Address into BufPtr. The read
+ * may complete later; the cache calls the wait function before it uses the
+ * data or starts another read. The cache never asks for a read that crosses
+ * a multiple of XQspiPsu_CacheOps.Boundary.
+ */
+typedef s32 (*XQspiPsu_CacheStartRead) (void *Ref, u32 Address, u8 *BufPtr,
+					u32 ByteCount);
+
+/**
+ * Waits for the read started last and returns its status.
+ */
+typedef s32 (*XQspiPsu_CacheWaitRead) (void *Ref);
+
+/**
+ * Flash back end of a cache
+ */
+typedef struct {
+	XQspiPsu_CacheStartRead StartRead;
+	XQspiPsu_CacheWaitRead WaitRead;
+	void *Ref;		/**< Passed to StartRead and WaitRead */
+	u32 Boundary;		/**< Reads do not cross multiples of Boundary,
+				  *  e.g. the two devices of a stacked
+				  *  connection, 0 if there is none */
+	u32 Align;		/**< Address and size of direct reads are
+				  *  multiples of Align, e.g. 2 for byte
+				  *  striped devices, 0 or 1 for none */
+} XQspiPsu_CacheOps;
+
+/**
+ * One block of flash data held by the cache
+ */
+typedef struct {
+	u32 Address;		/**< Flash address of the block or
+				  *  XQSPIPSU_CACHE_INVALID_ADDR */
+	u32 Stamp;		/**< Time of the last use */
+	u8 *DataPtr;		/**< Block data in the line buffer */
+	u8 Prefetched;		/**< Filled by prefetch and not used yet */
+} XQspiPsu_CacheLine;
+
+/**
+ * Counters of a cache
+ */
+typedef struct {
+	u32 Reads;		/**< XQspiPsu_CacheRead() calls */
+	u32 Hits;		/**< Blocks read from a valid line */
+	u32 Misses;		/**< Blocks read into a line on demand */
+	u32 ReadArounds;	/**< Misses read directly into the
+				  *  destination */
+	u32 Prefetches;		/**< Prefetches started */
+	u32 PrefetchHits;	/**< Prefetched blocks that were read */
+	u32 PrefetchWaits;	/**< Reads that waited for a prefetch in
+				  *  flight, also counted as hits */
+	u32 Bypasses;		/**< Whole lines transferred directly into the
+				  *  destination */
+	u32 Transfers;		/**< Reads started on the back end */
+	u64 TransferBytes;	/**< Bytes read on the back end */
+} XQspiPsu_CacheStats;
+
+/**
+ * The XQspiPsu_Cache instance data. The line buffer and the back end belong
+ * to the cache until it is no longer used.
+ */
+typedef struct {
+	XQspiPsu_CacheOps Ops;	/**< Flash back end */
+	u32 FlashSize;		/**< Bytes of flash */
+	u32 LineSize;		/**< Bytes of one line, power of two */
+	u32 NumLines;		/**< Number of lines */
+	u32 BypassSize;		/**< Minimum size of a direct read, 0 to
+				  *  read everything through the lines */
+	u32 Prefetch;		/**< Sequential prefetch enabled */
+	u32 Clock;		/**< Time for LRU replacement */
+	u32 NextAddress;	/**< End of the previous read */
+	XQspiPsu_CacheLine *Pending; /**< Line of the prefetch in flight */
+	XQspiPsu_CacheLine Lines[XQSPIPSU_CACHE_MAX_LINES];
+	u32 Missed[XQSPIPSU_CACHE_MAX_LINES]; /**< Recently missed blocks
+					       *  that have no line */
+	u32 MissedNext;		/**< Next entry of Missed to replace */
+	XQspiPsu_CacheStats Stats;
+	u32 IsReady;		/**< Cache is initialized and ready */
+} XQspiPsu_Cache;
+
+/************************** Function Prototypes ******************************/
+
+s32 XQspiPsu_CacheInitialize(XQspiPsu_Cache *CachePtr,
+		const XQspiPsu_CacheOps *OpsPtr, u32 FlashSize, u8 *BufferPtr,
+		u32 LineSize, u32 NumLines);
+s32 XQspiPsu_CacheRead(XQspiPsu_Cache *CachePtr, u32 Address, u8 *BufPtr,
+		u32 ByteCount);
+s32 XQspiPsu_CacheSync(XQspiPsu_Cache *CachePtr);
+s32 XQspiPsu_CacheInvalidate(XQspiPsu_Cache *CachePtr, u32 Address,
+		u32 ByteCount);
+void XQspiPsu_CacheSetPrefetch(XQspiPsu_Cache *CachePtr, u32 Enable);
+void XQspiPsu_CacheSetBypassSize(XQspiPsu_Cache *CachePtr, u32 BypassSize);
+void XQspiPsu_CacheGetStats(XQspiPsu_Cache *CachePtr,
+		XQspiPsu_CacheStats *StatsPtr);
+void XQspiPsu_CacheClearStats(XQspiPsu_Cache *CachePtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XQSPIPSU_CACHE_H_ */
+/** @} */
@@ -0,0 +1,462 @@
+/******************************************************************************
+ *
+ * Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+ * OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Except as contained in this notice, the name of the Xilinx shall not be used
+ * in advertising or otherwise to promote the sale, use or other dealings in
+ * this Software without prior written authorization from Xilinx.
+ *
+ ******************************************************************************/
+/*****************************************************************************/
+/**
+ *
+ * @file xqspipsu_flash.c
+ * @addtogroup qspipsu_v1_8
+ * @{
+ *
+ * This file implements reads of a serial flash with RX DMA that complete in
+ * the background, and the back end of the read cache of xqspipsu_cache.c on
+ * top of them. See xqspipsu.h for an overview.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who Date     Changes
+ * ----- --- -------- -----------------------------------------------
+ * 1.8   agt 10/17/26 First release
+ *
+ * </pre>
+ *
+ ******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xqspipsu.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static void XQspiPsu_FlashStatusHandler(void *CallBackRef, u32 StatusEvent,
+			u32 ByteCount);
+static u32 XQspiPsu_FlashSelect(const XQspiPsu_Flash *FlashPtr, u32 Address);
+static u32 XQspiPsu_FlashBoundary(const XQspiPsu_Flash *FlashPtr);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+ *
+ * Sets up flash reads on an initialized controller. The read command is
+ * chosen from the bus width of the controller configuration: quad output
+ * fast read on a 4 bit bus, dual output fast read on a 2 bit bus and fast
+ * read otherwise, with 4 byte addresses if a device is larger than 16MB.
+ * The controller is switched to DMA reads and its status handler is set.
+ *
+ * @param	FlashPtr is a pointer to the XQspiPsu_Flash instance.
+ * @param	InstancePtr is a pointer to the XQspiPsu instance, configured
+ *		with clock, options and manual start as for polled transfers.
+ * @param	FlashSize is the number of bytes of all flash devices, as
+ *		read from the ID of the flash.
+ * @param	UseInterrupt is TRUE if XQspiPsu_InterruptHandler() is
+ *		connected to the interrupt controller. Otherwise
+ *		XQspiPsu_FlashWaitRead() calls it while polling.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- XST_DEVICE_BUSY if a transfer is in progress.
+ *
+ * @note	The flash must be in its default SPI protocol mode. Octal
+ *		commands are not used as the controller has no octal mode.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_FlashInitialize(XQspiPsu_Flash *FlashPtr, XQspiPsu *InstancePtr,
+				u32 FlashSize, u32 UseInterrupt)
+{
+	u32 DeviceSize;
+	s32 Status;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(FlashSize > 0U);
+
+	Status = XQspiPsu_SetReadMode(InstancePtr, XQSPIPSU_READMODE_DMA);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	FlashPtr->QspiPsuPtr = InstancePtr;
+	FlashPtr->FlashSize = FlashSize;
+	FlashPtr->UseInterrupt = UseInterrupt;
+	FlashPtr->DummyClocks = (u8)XQSPIPSU_FLASH_DUMMY_CLOCKS;
+	FlashPtr->Status = XST_SUCCESS;
+
+	DeviceSize = FlashSize;
+	if (InstancePtr->Config.ConnectionMode !=
+			XQSPIPSU_CONNECTION_MODE_SINGLE) {
+		DeviceSize = FlashSize / 2U;
+	}
+	FlashPtr->AddrBytes = (DeviceSize > XQSPIPSU_FLASH_SIZE_3B_MAX) ?
+				4U : 3U;
+
+	switch (InstancePtr->Config.BusWidth) {
+		case XQSPIPSU_CONFIG_BUSWIDTH_FOUR:
+			FlashPtr->ReadCmd = (FlashPtr->AddrBytes == 4U) ?
+				(u8)XQSPIPSU_FLASH_QUAD_READ_CMD_4B :
+				(u8)XQSPIPSU_FLASH_QUAD_READ_CMD;
+			FlashPtr->BusWidth = (u8)XQSPIPSU_SELECT_MODE_QUADSPI;
+			break;
+		case XQSPIPSU_CONFIG_BUSWIDTH_TWO:
+			FlashPtr->ReadCmd = (FlashPtr->AddrBytes == 4U) ?
+				(u8)XQSPIPSU_FLASH_DUAL_READ_CMD_4B :
+				(u8)XQSPIPSU_FLASH_DUAL_READ_CMD;
+			FlashPtr->BusWidth = (u8)XQSPIPSU_SELECT_MODE_DUALSPI;
+			break;
+		default:
+			FlashPtr->ReadCmd = (FlashPtr->AddrBytes == 4U) ?
+				(u8)XQSPIPSU_FLASH_FAST_READ_CMD_4B :
+				(u8)XQSPIPSU_FLASH_FAST_READ_CMD;
+			FlashPtr->BusWidth = (u8)XQSPIPSU_SELECT_MODE_SPI;
+			break;
+	}
+
+	XQspiPsu_SetStatusHandler(InstancePtr, FlashPtr,
+				XQspiPsu_FlashStatusHandler);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Starts a DMA read of the flash. The data is valid once
+ * XQspiPsu_FlashWaitRead() has returned XST_SUCCESS; the controller can not
+ * be used for anything else until then.
+ *
+ * @param	Ref is a pointer to the XQspiPsu_Flash instance.
+ * @param	Address is the flash address, even in parallel mode.
+ * @param	BufPtr is the word aligned destination.
+ * @param	ByteCount is the number of bytes, within one device in stacked
+ *		mode and even in parallel mode.
+ *
+ * @return
+ *		- XST_SUCCESS if the read has started.
+ *		- XST_INVALID_PARAM if the range is not valid.
+ *		- XST_DEVICE_BUSY if a transfer is in progress.
+ *
+ * @note	Has the XQspiPsu_CacheStartRead type.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_FlashStartRead(void *Ref, u32 Address, u8 *BufPtr,
+				u32 ByteCount)
+{
+	XQspiPsu_Flash *FlashPtr = (XQspiPsu_Flash *)Ref;
+	u32 Boundary;
+	u32 FlashAddr;
+	u32 Index;
+	s32 Status;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(FlashPtr->QspiPsuPtr != NULL);
+
+	Boundary = XQspiPsu_FlashBoundary(FlashPtr);
+	if ((ByteCount == 0U) || (Address >= FlashPtr->FlashSize) ||
+		(ByteCount > (FlashPtr->FlashSize - Address)) ||
+		((Boundary != 0U) &&
+		 (((Address % Boundary) + ByteCount) > Boundary))) {
+		return (s32)XST_INVALID_PARAM;
+	}
+
+	if (FlashPtr->QspiPsuPtr->IsBusy == TRUE) {
+		return (s32)XST_DEVICE_BUSY;
+	}
+
+	FlashAddr = XQspiPsu_FlashSelect(FlashPtr, Address);
+
+	FlashPtr->CmdBfr[0] = FlashPtr->ReadCmd;
+	for (Index = 0U; Index < FlashPtr->AddrBytes; Index++) {
+		FlashPtr->CmdBfr[1U + Index] = (u8)(FlashAddr >>
+			(8U * (FlashPtr->AddrBytes - 1U - Index)));
+	}
+
+	(void)memset(FlashPtr->Msg, 0, sizeof(FlashPtr->Msg));
+
+	/* Command and address */
+	FlashPtr->Msg[0].TxBfrPtr = FlashPtr->CmdBfr;
+	FlashPtr->Msg[0].ByteCount = 1U + FlashPtr->AddrBytes;
+	FlashPtr->Msg[0].BusWidth = XQSPIPSU_SELECT_MODE_SPI;
+	FlashPtr->Msg[0].Flags = XQSPIPSU_MSG_FLAG_TX;
+
+	/* Dummy clocks with the bus width of the data phase */
+	FlashPtr->Msg[1].ByteCount = FlashPtr->DummyClocks;
+	FlashPtr->Msg[1].BusWidth = FlashPtr->BusWidth;
+
+	/* Data */
+	FlashPtr->Msg[2].RxBfrPtr = BufPtr;
+	FlashPtr->Msg[2].ByteCount = ByteCount;
+	FlashPtr->Msg[2].BusWidth = FlashPtr->BusWidth;
+	FlashPtr->Msg[2].Flags = XQSPIPSU_MSG_FLAG_RX;
+	if (FlashPtr->QspiPsuPtr->Config.ConnectionMode ==
+			XQSPIPSU_CONNECTION_MODE_PARALLEL) {
+		FlashPtr->Msg[2].Flags |= XQSPIPSU_MSG_FLAG_STRIPE;
+	}
+
+	FlashPtr->Status = (s32)XST_DEVICE_BUSY;
+	Status = XQspiPsu_InterruptTransfer(FlashPtr->QspiPsuPtr,
+				FlashPtr->Msg, 3U);
+	if (Status != XST_SUCCESS) {
+		FlashPtr->Status = Status;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Waits for the read started by XQspiPsu_FlashStartRead().
+ *
+ * @param	Ref is a pointer to the XQspiPsu_Flash instance.
+ *
+ * @return
+ *		- XST_SUCCESS if the data has been read.
+ *		- XST_FAILURE if the DMA reported an error.
+ *		- The status of XQspiPsu_FlashStartRead() if it failed.
+ *
+ * @note	Has the XQspiPsu_CacheWaitRead type.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_FlashWaitRead(void *Ref)
+{
+	XQspiPsu_Flash *FlashPtr = (XQspiPsu_Flash *)Ref;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(FlashPtr->QspiPsuPtr != NULL);
+
+	/*
+	 * IsBusy is cleared by the interrupt handler, read it through a
+	 * volatile access so that the load is not hoisted out of the loop.
+	 */
+	while (*(volatile u32 *)&FlashPtr->QspiPsuPtr->IsBusy == TRUE) {
+		if (FlashPtr->UseInterrupt == FALSE) {
+			(void)XQspiPsu_InterruptHandler(FlashPtr->QspiPsuPtr);
+		}
+	}
+
+	return FlashPtr->Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Reads the flash and waits for the data. Reads across the devices of a
+ * stacked connection are split.
+ *
+ * @param	FlashPtr is a pointer to the XQspiPsu_Flash instance.
+ * @param	Address is the flash address.
+ * @param	BufPtr is the word aligned destination.
+ * @param	ByteCount is the number of bytes.
+ *
+ * @return
+ *		- XST_SUCCESS if successful.
+ *		- The status of XQspiPsu_FlashStartRead() or
+ *		XQspiPsu_FlashWaitRead() otherwise.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_FlashRead(XQspiPsu_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+				u32 ByteCount)
+{
+	u32 Boundary;
+	u32 Count;
+	s32 Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	Boundary = XQspiPsu_FlashBoundary(FlashPtr);
+	while (ByteCount > 0U) {
+		Count = ByteCount;
+		if ((Boundary != 0U) &&
+			(((Address % Boundary) + Count) > Boundary)) {
+			Count = Boundary - (Address % Boundary);
+		}
+		Status = XQspiPsu_FlashStartRead(FlashPtr, Address, BufPtr,
+					Count);
+		if (Status == XST_SUCCESS) {
+			Status = XQspiPsu_FlashWaitRead(FlashPtr);
+		}
+		if (Status != XST_SUCCESS) {
+			break;
+		}
+		Address += Count;
+		BufPtr += Count;
+		ByteCount -= Count;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Initializes a read cache on the flash, see XQspiPsu_CacheInitialize().
+ *
+ * @param	CachePtr is a pointer to the XQspiPsu_Cache instance.
+ * @param	FlashPtr is a pointer to the initialized XQspiPsu_Flash
+ *		instance.
+ * @param	BufferPtr is the line buffer of NumLines * LineSize bytes.
+ * @param	LineSize is the number of bytes of a line.
+ * @param	NumLines is the number of lines.
+ *
+ * @return	The result of XQspiPsu_CacheInitialize().
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+s32 XQspiPsu_FlashCacheInitialize(XQspiPsu_Cache *CachePtr,
+		XQspiPsu_Flash *FlashPtr, u8 *BufferPtr, u32 LineSize,
+		u32 NumLines)
+{
+	XQspiPsu_CacheOps Ops;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+
+	Ops.StartRead = XQspiPsu_FlashStartRead;
+	Ops.WaitRead = XQspiPsu_FlashWaitRead;
+	Ops.Ref = FlashPtr;
+	Ops.Boundary = XQspiPsu_FlashBoundary(FlashPtr);
+	/* Striped reads start at an even address and have an even size */
+	Ops.Align = (FlashPtr->QspiPsuPtr->Config.ConnectionMode ==
+			XQSPIPSU_CONNECTION_MODE_PARALLEL) ? 2U : 1U;
+
+	return XQspiPsu_CacheInitialize(CachePtr, &Ops, FlashPtr->FlashSize,
+			BufferPtr, LineSize, NumLines);
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Records the end of a read, called by XQspiPsu_InterruptHandler().
+ *
+ * @param	CallBackRef is a pointer to the XQspiPsu_Flash instance.
+ * @param	StatusEvent is the event that just occurred.
+ * @param	ByteCount is not used.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static void XQspiPsu_FlashStatusHandler(void *CallBackRef, u32 StatusEvent,
+			u32 ByteCount)
+{
+	XQspiPsu_Flash *FlashPtr = (XQspiPsu_Flash *)CallBackRef;
+
+	(void) ByteCount;
+
+	if (StatusEvent != XST_SPI_TRANSFER_DONE) {
+		FlashPtr->Status = (s32)XST_FAILURE;
+	} else if (FlashPtr->Status == (s32)XST_DEVICE_BUSY) {
+		FlashPtr->Status = XST_SUCCESS;
+	} else {
+		/* Keep the error of the transfer */
+	}
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Selects the device and bus of a flash address for the connection mode.
+ *
+ * @param	FlashPtr is a pointer to the XQspiPsu_Flash instance.
+ * @param	Address is the flash address.
+ *
+ * @return	The address within the selected device.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 XQspiPsu_FlashSelect(const XQspiPsu_Flash *FlashPtr, u32 Address)
+{
+	u32 FlashAddr;
+
+	switch (FlashPtr->QspiPsuPtr->Config.ConnectionMode) {
+		case XQSPIPSU_CONNECTION_MODE_STACKED:
+			if (Address >= (FlashPtr->FlashSize / 2U)) {
+				XQspiPsu_SelectFlash(FlashPtr->QspiPsuPtr,
+					XQSPIPSU_SELECT_FLASH_CS_UPPER,
+					XQSPIPSU_SELECT_FLASH_BUS_LOWER);
+				FlashAddr = Address - (FlashPtr->FlashSize / 2U);
+			} else {
+				XQspiPsu_SelectFlash(FlashPtr->QspiPsuPtr,
+					XQSPIPSU_SELECT_FLASH_CS_LOWER,
+					XQSPIPSU_SELECT_FLASH_BUS_LOWER);
+				FlashAddr = Address;
+			}
+			break;
+		case XQSPIPSU_CONNECTION_MODE_PARALLEL:
+			/* Each device holds every other byte */
+			XQspiPsu_SelectFlash(FlashPtr->QspiPsuPtr,
+				XQSPIPSU_SELECT_FLASH_CS_BOTH,
+				XQSPIPSU_SELECT_FLASH_BUS_BOTH);
+			FlashAddr = Address / 2U;
+			break;
+		default:
+			XQspiPsu_SelectFlash(FlashPtr->QspiPsuPtr,
+				XQSPIPSU_SELECT_FLASH_CS_LOWER,
+				XQSPIPSU_SELECT_FLASH_BUS_LOWER);
+			FlashAddr = Address;
+			break;
+	}
+
+	return FlashAddr;
+}
+
+/*****************************************************************************/
+/**
+ *
+ * Returns the address of the second device of a stacked connection, which
+ * a single read can not cross.
+ *
+ * @param	FlashPtr is a pointer to the XQspiPsu_Flash instance.
+ *
+ * @return	The boundary, or 0 if there is none.
+ *
+ * @note	None.
+ *
+ ******************************************************************************/
+static u32 XQspiPsu_FlashBoundary(const XQspiPsu_Flash *FlashPtr)
+{
+	u32 Boundary = 0U;
+
+	if (FlashPtr->QspiPsuPtr->Config.ConnectionMode ==
+			XQSPIPSU_CONNECTION_MODE_STACKED) {
+		Boundary = FlashPtr->FlashSize / 2U;
+	}
+	return Boundary;
+}
+/** @} */
@@ -0,0 +1,701 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file asyncbench.c
+*		Host tests of the SD asynchronous request queue. xsdps_async.c
+*		is built for Linux against a card that logs the commands given
+*		to XSdPs_CmdTransfer() and a controller whose interrupt
+*		registers live in memory. Transfers are completed by setting
+*		the status and calling XSdPs_AsyncIntrHandler().
+*
+*		The tests check
+*		- the merging of contiguous requests of one direction, and
+*		  where it stops: a gap, a change of direction, the merge,
+*		  block count and descriptor limits
+*		- the commands issued with and without CMD23 support, block
+*		  and byte addressed
+*		- the packed write header, its descriptor and the CMD23 and
+*		  CMD25 arguments, and the entry limit of the card
+*		- the argument checks of XSdPs_AsyncSubmit()
+*		- error completion and commands the card rejects
+*		- that an interrupt taken while the queue is locked does not
+*		  touch the queue and is raised again on unlock, and that
+*		  requests submitted from a completion callback are issued
+*
+*		Usage: asyncbench
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 3.6   agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xsdps.h"
+#include "bench.h"
+
+#define SIM_BASE		0xFF160000U	/* Controller registers */
+#define SIM_REG_SPACE		0x100U
+#define SIM_MAX_CMDS		64	/* Commands logged */
+#define SIM_MAX_REQS		48	/* Requests of a test */
+#define SIM_BUF_SIZE		(4U * XSDPS_BLK_SIZE_512_MASK)
+#define SIM_ALL_SIG		(XSDPS_INTR_TC_MASK | XSDPS_INTR_ERR_MASK)
+
+/* Command given to XSdPs_CmdTransfer() */
+typedef struct {
+	u32 Cmd;
+	u32 Arg;
+	u32 BlkCnt;
+	u16 TransferMode;
+} SimCmd;
+
+static u8 Regs[SIM_REG_SPACE];
+static SimCmd Cmds[SIM_MAX_CMDS];
+static int NumCmds;
+static int SwResets;
+static s32 CmdStatus;		/* Returned by XSdPs_CmdTransfer() */
+static int IrqOnMask;		/* Interrupt taken as the signals are masked */
+static u8 ExtCsdRev;
+static u8 ExtCsdMaxPacked;
+static u8 ScrCmdSupp;
+
+static XSdPs Sd;
+static XSdPs_Async Async;
+static XSdPs_AsyncReq Reqs[SIM_MAX_REQS];
+static u8 Bufs[SIM_MAX_REQS][SIM_BUF_SIZE];
+static int Done[SIM_MAX_REQS];	/* Requests in completion order */
+static s32 DoneStatus[SIM_MAX_REQS];
+static int NumDone;
+static int Resubmit = -1;	/* Request submitted by the next callback */
+
+/*****************************************************************************/
+/*
+* BSP and driver functions used by xsdps_async.c
+*/
+static u16 RegGet16(u32 Offset)
+{
+	return (u16)(Regs[Offset] | (Regs[Offset + 1U] << 8));
+}
+
+static void RegSet16(u32 Offset, u16 Value)
+{
+	Regs[Offset] = (u8)Value;
+	Regs[Offset + 1U] = (u8)(Value >> 8);
+}
+
+u8 Xil_In8(UINTPTR Addr)
+{
+	return Regs[Addr - SIM_BASE];
+}
+
+u16 Xil_In16(UINTPTR Addr)
+{
+	return RegGet16((u32)(Addr - SIM_BASE));
+}
+
+u32 Xil_In32(UINTPTR Addr)
+{
+	u32 Offset = (u32)(Addr - SIM_BASE);
+
+	return RegGet16(Offset) | ((u32)RegGet16(Offset + 2U) << 16);
+}
+
+u64 Xil_In64(UINTPTR Addr)
+{
+	return Xil_In32(Addr) | ((u64)Xil_In32(Addr + 4U) << 32);
+}
+
+/* The software reset completes at once */
+void Xil_Out8(UINTPTR Addr, u8 Value)
+{
+	u32 Offset = (u32)(Addr - SIM_BASE);
+
+	if (Offset == XSDPS_SW_RST_OFFSET) {
+		SwResets++;
+		Value = 0U;
+	}
+	Regs[Offset] = Value;
+}
+
+/*
+* The interrupt status registers are write 1 to clear. With IrqOnMask set,
+* masking the error signals takes the interrupt the GIC already had pending.
+*/
+void Xil_Out16(UINTPTR Addr, u16 Value)
+{
+	u32 Offset = (u32)(Addr - SIM_BASE);
+
+	if ((Offset == XSDPS_NORM_INTR_STS_OFFSET) ||
+			(Offset == XSDPS_ERR_INTR_STS_OFFSET)) {
+		RegSet16(Offset, RegGet16(Offset) & (u16)~Value);
+	} else {
+		RegSet16(Offset, Value);
+	}
+
+	if ((IrqOnMask != 0) && (Offset == XSDPS_ERR_INTR_SIG_EN_OFFSET) &&
+			(Value == 0U)) {
+		IrqOnMask = 0;
+		XSdPs_AsyncIntrHandler(&Async);
+	}
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	Xil_Out16(Addr, (u16)Value);
+	Xil_Out16(Addr + 2U, (u16)(Value >> 16));
+}
+
+void Xil_Out64(UINTPTR Addr, u64 Value)
+{
+	Xil_Out32(Addr, (u32)Value);
+	Xil_Out32(Addr + 4U, (u32)(Value >> 32));
+}
+
+void Xil_DCacheFlushRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+}
+
+void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+}
+
+void xil_printf(const char8 *ctrl1, ...)
+{
+	(void)ctrl1;
+}
+
+static void RaiseIntr(u16 Mask)
+{
+	RegSet16(XSDPS_NORM_INTR_STS_OFFSET,
+		RegGet16(XSDPS_NORM_INTR_STS_OFFSET) | Mask);
+}
+
+s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
+{
+	if (NumCmds < SIM_MAX_CMDS) {
+		Cmds[NumCmds].Cmd = Cmd;
+		Cmds[NumCmds].Arg = Arg;
+		Cmds[NumCmds].BlkCnt = BlkCnt;
+		Cmds[NumCmds].TransferMode = InstancePtr->TransferMode;
+	}
+	NumCmds++;
+
+	return CmdStatus;
+}
+
+s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff)
+{
+	(void)InstancePtr;
+	(void)memset(ReadBuff, 0, 512);
+	ReadBuff[EXT_CSD_REV_BYTE] = ExtCsdRev;
+	ReadBuff[EXT_CSD_MAX_PACKED_WR_BYTE] = ExtCsdMaxPacked;
+	return XST_SUCCESS;
+}
+
+s32 XSdPs_Get_BusWidth(XSdPs *InstancePtr, u8 *SCR)
+{
+	(void)InstancePtr;
+	(void)memset(SCR, 0, 8);
+	SCR[XSDPS_SCR_CMD_SUPP_BYTE] = ScrCmdSupp;
+	return XST_SUCCESS;
+}
+
+s32 XSdPs_SetBlkSize(XSdPs *InstancePtr, u16 BlkSize)
+{
+	(void)InstancePtr;
+	RegSet16(XSDPS_BLK_SIZE_OFFSET, BlkSize);
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+
+static void Callback(void *CallBackRef, s32 Status)
+{
+	int Index = (int)(UINTPTR)CallBackRef;
+	int Next;
+
+	Done[NumDone] = Index;
+	DoneStatus[NumDone] = Status;
+	NumDone++;
+
+	if (Resubmit >= 0) {
+		Next = Resubmit;
+		Resubmit = -1;
+		(void)XSdPs_AsyncSubmit(&Async, &Reqs[Next]);
+	}
+}
+
+/*
+* Initializes the queue on a card of CardType. HasCmd23 is the SCR bit of
+* an SD card, ExtRev and MaxPacked the EXT_CSD fields of an eMMC device.
+*/
+static void Setup(u8 CardType, u32 Hcs, u8 HasCmd23, u8 ExtRev,
+		u8 MaxPacked)
+{
+	(void)memset(Regs, 0, sizeof(Regs));
+	(void)memset(&Sd, 0, sizeof(Sd));
+	Sd.Config.BaseAddress = SIM_BASE;
+	Sd.Config.IsCacheCoherent = 1U;
+	Sd.IsReady = XIL_COMPONENT_IS_READY;
+	Sd.CardType = CardType;
+	Sd.HCS = Hcs;
+
+	ScrCmdSupp = (HasCmd23 != 0U) ? XSDPS_SCR_CMD23_SUPP : 0U;
+	ExtCsdRev = ExtRev;
+	ExtCsdMaxPacked = MaxPacked;
+	NumCmds = 0;
+	NumDone = 0;
+	SwResets = 0;
+	CmdStatus = XST_SUCCESS;
+	IrqOnMask = 0;
+	Resubmit = -1;
+
+	if (XSdPs_AsyncInitialize(&Async, &Sd) != XST_SUCCESS) {
+		fprintf(stderr, "XSdPs_AsyncInitialize failed\n");
+		exit(1);
+	}
+}
+
+static void Prepare(int Index, u32 Sector, u32 BlkCnt, u8 IsWrite)
+{
+	XSdPs_AsyncReq *ReqPtr = &Reqs[Index];
+
+	(void)memset(ReqPtr, 0, sizeof(*ReqPtr));
+	ReqPtr->Sector = Sector;
+	ReqPtr->BlkCnt = BlkCnt;
+	ReqPtr->Buff = Bufs[Index];
+	ReqPtr->IsWrite = IsWrite;
+	ReqPtr->Handler = Callback;
+	ReqPtr->CallBackRef = (void *)(UINTPTR)Index;
+}
+
+static s32 Submit(int Index, u32 Sector, u32 BlkCnt, u8 IsWrite)
+{
+	Prepare(Index, Sector, BlkCnt, IsWrite);
+	return XSdPs_AsyncSubmit(&Async, &Reqs[Index]);
+}
+
+/* Completes the command in flight */
+static void Complete(u16 Mask)
+{
+	RaiseIntr(Mask);
+	XSdPs_AsyncIntrHandler(&Async);
+}
+
+static int CmdIs(int Index, u32 Cmd, u32 Arg, u32 BlkCnt)
+{
+	return (Index < NumCmds) && (Cmds[Index].Cmd == Cmd) &&
+		(Cmds[Index].Arg == Arg) && (Cmds[Index].BlkCnt == BlkCnt);
+}
+
+/* Descriptor address of a buffer, 32 bit outside of the 64 bit ARM build */
+static u64 DescAddr(const void *Buff)
+{
+#if defined(__aarch64__) || defined(__arch64__)
+	return (u64)(UINTPTR)Buff;
+#else
+	return (u32)(UINTPTR)Buff;
+#endif
+}
+
+/*
+* Checks that the ADMA2 table holds the packed header if Header is set and
+* then the buffers of the requests in List, terminated by -1.
+*/
+static int DescOk(int Header, const int *List)
+{
+	XSdPs_Adma2Descriptor *Desc = Async.DescTbl;
+	int Num = 0;
+	int Ok = 1;
+	int i;
+
+	if (Header != 0) {
+		Ok &= (Desc[Num].Address == DescAddr(Async.PackedHdr));
+		Ok &= (Desc[Num].Length == XSDPS_BLK_SIZE_512_MASK);
+		Num++;
+	}
+	for (i = 0; List[i] >= 0; i++) {
+		Ok &= (Desc[Num].Address == DescAddr(Reqs[List[i]].Buff));
+		Ok &= (Desc[Num].Length ==
+			Reqs[List[i]].BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		Num++;
+	}
+	for (i = 0; i < Num; i++) {
+		Ok &= ((Desc[i].Attribute & ~XSDPS_DESC_END) ==
+			(XSDPS_DESC_TRAN | XSDPS_DESC_VALID));
+		Ok &= (((Desc[i].Attribute & XSDPS_DESC_END) != 0U) ==
+			(i == Num - 1));
+	}
+	return Ok;
+}
+
+static int DoneIs(const int *List, s32 Status)
+{
+	int i;
+
+	for (i = 0; List[i] >= 0; i++) {
+		if ((i >= NumDone) || (Done[i] != List[i]) ||
+				(DoneStatus[i] != Status)) {
+			return 0;
+		}
+	}
+	return NumDone == i;
+}
+
+static u32 Le32(const u8 *Bytes)
+{
+	return Bytes[0] | (Bytes[1] << 8) | (Bytes[2] << 16) |
+		((u32)Bytes[3] << 24);
+}
+
+/*****************************************************************************/
+/*
+* Contiguous reads queued behind a command merge, a gap, a change of
+* direction and the end of the queue start a new command.
+*/
+static void test_merge(void)
+{
+	const int Cmd1[] = { 1, 2, -1 };
+	const int Done0[] = { 0, -1 };
+	const int DoneAll[] = { 0, 1, 2, 3, 4, -1 };
+	u16 Tm;
+	int Ok;
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+
+	(void)Submit(0, 0U, 8U, 0U);
+	Tm = Cmds[1].TransferMode;
+	check("merge: idle queue issues CMD23 and CMD18 at once",
+		(NumCmds == 2) && CmdIs(0, CMD23, 8U, 0U) &&
+		CmdIs(1, CMD18, 0U, 8U) &&
+		((Tm & XSDPS_TM_DAT_DIR_SEL_MASK) != 0U) &&
+		((Tm & XSDPS_TM_AUTO_CMD12_EN_MASK) == 0U));
+
+	(void)Submit(1, 8U, 8U, 0U);
+	(void)Submit(2, 16U, 4U, 0U);
+	(void)Submit(3, 100U, 2U, 0U);
+	(void)Submit(4, 102U, 1U, 1U);
+	check("merge: nothing issued while a command is in flight",
+		NumCmds == 2);
+
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("merge: contiguous reads issued as one command",
+		DoneIs(Done0, XST_SUCCESS) && (NumCmds == 2) &&
+		CmdIs(0, CMD23, 12U, 0U) && CmdIs(1, CMD18, 8U, 12U) &&
+		DescOk(0, Cmd1));
+
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("merge: a gap starts a new command",
+		(NumCmds == 2) && CmdIs(0, CMD23, 2U, 0U) &&
+		CmdIs(1, CMD18, 100U, 2U));
+
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("merge: a contiguous write starts a new command",
+		(NumCmds == 1) && CmdIs(0, CMD24, 102U, 1U) &&
+		((Cmds[0].TransferMode & XSDPS_TM_DAT_DIR_SEL_MASK) == 0U));
+
+	Complete(XSDPS_INTR_TC_MASK);
+	Ok = DoneIs(DoneAll, XST_SUCCESS) &&
+		(XSdPs_AsyncIsIdle(&Async) == TRUE) &&
+		(Async.Stats.Commands == 4U) && (Async.Stats.Merged == 1U) &&
+		(Async.Stats.Requests == 5U) &&
+		(RegGet16(XSDPS_NORM_INTR_SIG_EN_OFFSET) == 0U);
+	check("merge: completions in order, idle and masked at the end", Ok);
+}
+
+/*
+* A command takes at most XSDPS_ASYNC_MAX_MERGE requests and fewer than
+* XSDPS_ASYNC_MAX_DESC descriptors.
+*/
+static void test_merge_limits(void)
+{
+	u32 BlkPerDesc = XSDPS_DESC_MAX_LENGTH / XSDPS_BLK_SIZE_512_MASK;
+	u32 Blks;
+	int i;
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	(void)Submit(0, 1000U, 1U, 0U);
+	for (i = 1; i <= (int)XSDPS_ASYNC_MAX_MERGE + 8; i++) {
+		(void)Submit(i, (u32)i - 1U, 1U, 0U);
+	}
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("limits: at most XSDPS_ASYNC_MAX_MERGE requests merged",
+		CmdIs(1, CMD18, 0U, XSDPS_ASYNC_MAX_MERGE));
+
+	/* Requests of 16 descriptors, the fourth one no longer fits */
+	Blks = 16U * BlkPerDesc;
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	(void)Submit(0, 100000U, 1U, 0U);
+	for (i = 1; i <= 5; i++) {
+		(void)Submit(i, ((u32)i - 1U) * Blks, Blks, 0U);
+	}
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("limits: merge stops before the descriptor table is full",
+		CmdIs(1, CMD18, 0U, 3U * Blks));
+}
+
+/* Without CMD23 multiple block transfers stop with auto CMD12 */
+static void test_no_cmd23(void)
+{
+	Setup(XSDPS_CARD_SD, 0U, 0U, 0U, 0U);
+
+	(void)Submit(0, 4U, 3U, 0U);
+	check("no cmd23: CMD18 with auto CMD12, byte address",
+		(NumCmds == 1) &&
+		CmdIs(0, CMD18, 4U * XSDPS_BLK_SIZE_512_MASK, 3U) &&
+		((Cmds[0].TransferMode & XSDPS_TM_AUTO_CMD12_EN_MASK) != 0U));
+
+	NumCmds = 0;
+	(void)Submit(1, 7U, 2U, 1U);
+	Complete(XSDPS_INTR_TC_MASK);
+	check("no cmd23: write issued after the read completes",
+		(NumCmds == 1) &&
+		CmdIs(0, CMD25, 7U * XSDPS_BLK_SIZE_512_MASK, 2U));
+}
+
+/*
+* Writes to several places queued behind a command are packed into one
+* CMD25, contiguous ones share an entry of the header.
+*/
+static void test_packed(u32 Hcs)
+{
+	const int Cmd1[] = { 1, 2, 3, 4, -1 };
+	u32 Scale = (Hcs != 0U) ? 1U : XSDPS_BLK_SIZE_512_MASK;
+	const u8 *Hdr = Async.PackedHdr;
+	const u8 *Entry;
+	char Name[64];
+	int Ok;
+	int i;
+
+	Setup(XSDPS_CHIP_EMMC, Hcs, 0U, EXT_CSD_REV_4_5, 8U);
+
+	(void)Submit(0, 0U, 1U, 1U);
+	(void)Submit(1, 10U, 2U, 1U);
+	(void)Submit(2, 12U, 2U, 1U);
+	(void)Submit(3, 50U, 1U, 1U);
+	(void)Submit(4, 80U, 3U, 1U);
+	(void)Submit(5, 200U, 1U, 0U);
+
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	Ok = (NumCmds == 2) &&
+		CmdIs(0, CMD23, XSDPS_CMD23_PACKED | 9U, 0U) &&
+		CmdIs(1, CMD25, 10U * Scale, 9U) && DescOk(1, Cmd1) &&
+		(Async.Stats.Packed == 1U) && (Async.Stats.Merged == 3U);
+	(void)snprintf(Name, sizeof(Name),
+		"packed: one CMD25 for 4 writes, %s address",
+		(Hcs != 0U) ? "block" : "byte");
+	check(Name, Ok);
+
+	Ok = (Hdr[0] == XSDPS_PACKED_HDR_VERSION) &&
+		(Hdr[1] == XSDPS_PACKED_HDR_WRITE) && (Hdr[2] == 3U) &&
+		(Hdr[3] == 0U);
+	Entry = &Hdr[XSDPS_PACKED_HDR_ENTRY_SIZE];
+	Ok &= (Le32(&Entry[0]) == 4U) && (Le32(&Entry[4]) == 10U * Scale);
+	Entry += XSDPS_PACKED_HDR_ENTRY_SIZE;
+	Ok &= (Le32(&Entry[0]) == 1U) && (Le32(&Entry[4]) == 50U * Scale);
+	Entry += XSDPS_PACKED_HDR_ENTRY_SIZE;
+	Ok &= (Le32(&Entry[0]) == 3U) && (Le32(&Entry[4]) == 80U * Scale);
+	for (i = 4 * XSDPS_PACKED_HDR_ENTRY_SIZE;
+			i < (int)XSDPS_BLK_SIZE_512_MASK; i++) {
+		Ok &= (Hdr[i] == 0U);
+	}
+	(void)snprintf(Name, sizeof(Name), "packed: header entries, %s address",
+		(Hcs != 0U) ? "block" : "byte");
+	check(Name, Ok);
+
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("packed: the read is issued on its own",
+		(NumCmds == 1) && CmdIs(0, CMD17, 200U * Scale, 1U));
+	Complete(XSDPS_INTR_TC_MASK);
+}
+
+/* The entries of a packed write are limited by the card */
+static void test_packed_limit(void)
+{
+	Setup(XSDPS_CHIP_EMMC, 1U, 0U, EXT_CSD_REV_4_5, 2U);
+	(void)Submit(0, 0U, 1U, 1U);
+	(void)Submit(1, 10U, 1U, 1U);
+	(void)Submit(2, 20U, 1U, 1U);
+	(void)Submit(3, 30U, 1U, 1U);
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("packed: no more entries than EXT_CSD allows",
+		(NumCmds == 2) &&
+		CmdIs(0, CMD23, XSDPS_CMD23_PACKED | 3U, 0U) &&
+		(Async.PackedHdr[2] == 2U));
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("packed: the rest follows in the next command",
+		(NumCmds == 1) && CmdIs(0, CMD24, 30U, 1U));
+
+	/* Devices before EXT_CSD revision 6 have no packed commands */
+	Setup(XSDPS_CHIP_EMMC, 1U, 0U, EXT_CSD_REV_4_5 - 1U, 8U);
+	(void)Submit(0, 0U, 1U, 1U);
+	(void)Submit(1, 10U, 1U, 1U);
+	(void)Submit(2, 20U, 1U, 1U);
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	check("packed: not used before EXT_CSD revision 6",
+		(NumCmds == 1) && CmdIs(0, CMD24, 10U, 1U) &&
+		(Async.MaxPackedWrites == 0U));
+}
+
+static void test_args(void)
+{
+	u32 BlkPerDesc = XSDPS_DESC_MAX_LENGTH / XSDPS_BLK_SIZE_512_MASK;
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	check("args: request of 0 blocks refused",
+		Submit(0, 0U, 0U, 0U) == XST_INVALID_PARAM);
+	check("args: request needing the header descriptor refused",
+		Submit(0, 0U, (XSDPS_ASYNC_MAX_DESC - 1U) * BlkPerDesc + 1U,
+			0U) == XST_INVALID_PARAM);
+	check("args: largest request accepted",
+		(Submit(0, 0U, (XSDPS_ASYNC_MAX_DESC - 1U) * BlkPerDesc,
+			0U) == XST_SUCCESS) && (NumCmds == 2));
+}
+
+/* Errors fail every request of the command, the next one still starts */
+static void test_errors(void)
+{
+	const int Failed[] = { 0, 1, -1 };
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	(void)Submit(0, 0U, 1U, 0U);
+	(void)Submit(1, 1U, 1U, 0U);
+	(void)Submit(2, 2U, 1U, 0U);
+	(void)Submit(3, 9U, 1U, 0U);
+	Complete(XSDPS_INTR_TC_MASK);
+	NumDone = 0;
+	NumCmds = 0;
+	Complete(XSDPS_INTR_ERR_MASK);
+	check("errors: merged requests fail together, lines reset",
+		(NumDone == 2) && (Done[0] == 1) && (Done[1] == 2) &&
+		(DoneStatus[0] == XST_FAILURE) &&
+		(DoneStatus[1] == XST_FAILURE) && (SwResets == 1) &&
+		(Async.Stats.Errors == 1U) &&
+		CmdIs(0, CMD17, 9U, 1U));
+	Complete(XSDPS_INTR_TC_MASK);
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	CmdStatus = XST_FAILURE;
+	(void)Submit(0, 0U, 1U, 0U);
+	(void)Submit(1, 1U, 1U, 1U);
+	check("errors: commands the card rejects fail their requests",
+		DoneIs(Failed, XST_FAILURE) &&
+		(XSdPs_AsyncIsIdle(&Async) == TRUE) &&
+		(RegGet16(XSDPS_NORM_INTR_SIG_EN_OFFSET) == 0U));
+}
+
+/*
+* An interrupt the GIC delivers while the queue is locked leaves the queue
+* alone and is raised again by the unmask. Requests submitted from a
+* completion callback are issued once the handler is done.
+*/
+static void test_lock(void)
+{
+	const int Done0[] = { 0, -1 };
+	const int Done01[] = { 0, 1, -1 };
+	int Ok;
+
+	/* The transfer of request 0 completes as request 1 is submitted */
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	(void)Submit(0, 0U, 1U, 0U);
+	RaiseIntr(XSDPS_INTR_TC_MASK);
+	IrqOnMask = 1;
+	NumCmds = 0;
+	(void)Submit(1, 50U, 1U, 1U);
+	Ok = (IrqOnMask == 0) && (NumDone == 0) && (NumCmds == 0) &&
+		(Async.Active == &Reqs[0]) && (Async.Head == &Reqs[1]) &&
+		(Async.LockDepth == 0U) &&
+		((RegGet16(XSDPS_NORM_INTR_STS_OFFSET) &
+		XSDPS_INTR_TC_MASK) != 0U) &&
+		(RegGet16(XSDPS_NORM_INTR_SIG_EN_OFFSET) == SIM_ALL_SIG);
+	check("lock: handler backs off, status kept, signals unmasked", Ok);
+
+	XSdPs_AsyncIntrHandler(&Async);
+	check("lock: the interrupt raised again completes the request",
+		DoneIs(Done0, XST_SUCCESS) && CmdIs(0, CMD24, 50U, 1U));
+	Complete(XSDPS_INTR_TC_MASK);
+
+	Setup(XSDPS_CARD_SD, 1U, 1U, 0U, 0U);
+	(void)Submit(0, 0U, 1U, 0U);
+	Prepare(1, 50U, 1U, 1U);
+	Resubmit = 1;
+	NumCmds = 0;
+	Complete(XSDPS_INTR_TC_MASK);
+	Ok = (NumCmds == 1) && CmdIs(0, CMD24, 50U, 1U) &&
+		(Async.LockDepth == 0U) &&
+		(RegGet16(XSDPS_NORM_INTR_SIG_EN_OFFSET) == SIM_ALL_SIG);
+	check("lock: request submitted by a callback is issued", Ok);
+	Complete(XSDPS_INTR_TC_MASK);
+	check("lock: and completes", DoneIs(Done01, XST_SUCCESS));
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1) {
+		fprintf(stderr, "usage: %s\n", argv[0]);
+		return 1;
+	}
+
+	test_merge();
+	test_merge_limits();
+	test_no_cmd23();
+	test_packed(1U);
+	test_packed(0U);
+	test_packed_limit();
+	test_args();
+	test_errors();
+	test_lock();
+
+	if (check_status() != 0) {
+		return 1;
+	}
+
+	return 0;
+}
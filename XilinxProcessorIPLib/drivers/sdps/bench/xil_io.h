@@ -0,0 +1,66 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*
+ * Host replacement of xil_io.h for the SD asynchronous queue bench. The
+ * register accesses of the driver are made to asyncbench.c, which models the
+ * interrupt registers of the controller in memory. Xil_Out32LE() stores to
+ * memory, the driver only uses it for the packed command header.
+ */
+#ifndef XIL_IO_H
+#define XIL_IO_H
+
+#include <string.h>
+#include "xil_types.h"
+#include "xil_printf.h"
+
+#define INLINE			inline
+#define SYNCHRONIZE_IO
+#define INST_SYNC
+#define DATA_SYNC
+
+u8 Xil_In8(UINTPTR Addr);
+u16 Xil_In16(UINTPTR Addr);
+u32 Xil_In32(UINTPTR Addr);
+u64 Xil_In64(UINTPTR Addr);
+void Xil_Out8(UINTPTR Addr, u8 Value);
+void Xil_Out16(UINTPTR Addr, u16 Value);
+void Xil_Out32(UINTPTR Addr, u32 Value);
+void Xil_Out64(UINTPTR Addr, u64 Value);
+
+static INLINE void Xil_Out32LE(UINTPTR Addr, u32 Value)
+{
+	u8 Bytes[4];
+
+	Bytes[0] = (u8)Value;
+	Bytes[1] = (u8)(Value >> 8);
+	Bytes[2] = (u8)(Value >> 16);
+	Bytes[3] = (u8)(Value >> 24);
+	memcpy((void *)Addr, Bytes, sizeof(Bytes));
+}
+
+#endif
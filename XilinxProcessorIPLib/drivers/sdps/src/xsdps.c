@@ -94,6 +94,10 @@
 *       mn     08/14/18 Resolve compilation warnings for ARMCC toolchain
 *       mn     10/01/18 Change Expected Response for CMD3 to R1 for MMC
  * 3.6  mus 11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
+*       agt    10/17/26 CMD23 and ACMD23 carry no data, removed the data
+*                       present flag from their command frame.
+*       agt    10/17/26 Transfer mode is kept in the instance instead of a
+*                       global variable.
 * </pre>
 *
 ******************************************************************************/
@@ -142,7 +146,6 @@ extern s32 XSdPs_Uhs_ModeInit(XSdPs *InstancePtr, u8 Mode);
 static s32 XSdPs_IdentifyCard(XSdPs *InstancePtr);
 static s32 XSdPs_Switch_Voltage(XSdPs *InstancePtr);
 
-u16 TransferMode;
 /*****************************************************************************/
 /**
 *
@@ -307,8 +310,8 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	 * Transfer mode register - default value
 	 * DMA enabled, block count enabled, data direction card to host(read)
 	 */
-	TransferMode = XSDPS_TM_DMA_EN_MASK | XSDPS_TM_BLK_CNT_EN_MASK |
-			XSDPS_TM_DAT_DIR_SEL_MASK;
+	InstancePtr->TransferMode = XSDPS_TM_DMA_EN_MASK |
+			XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DAT_DIR_SEL_MASK;
 
 	/* Set block size to 512 by default */
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
@@ -1157,7 +1160,7 @@ s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 	}
 
 	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_XFER_MODE_OFFSET,
-			(CommandReg << 16) | TransferMode);
+			(CommandReg << 16) | InstancePtr->TransferMode);
 
 	/* Polling for response for now */
 	do {
@@ -1279,6 +1282,8 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		break;
 		case CMD23:
 		case ACMD23:
+			RetVal |= RESP_R1;
+		break;
 		case CMD24:
 		case CMD25:
 			RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
@@ -1364,7 +1369,7 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	}
 
 	if (BlkCnt == 1U) {
-		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+		InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
 			XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 		/* Send single block read command */
@@ -1374,7 +1379,7 @@ s32 XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 			goto RETURN_PATH;
 		}
 	} else {
-		TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+		InstancePtr->TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
 			XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DAT_DIR_SEL_MASK |
 			XSDPS_TM_DMA_EN_MASK | XSDPS_TM_MUL_SIN_BLK_SEL_MASK;
 
@@ -1474,7 +1479,8 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	}
 
 	if (BlkCnt == 1U) {
-		TransferMode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_DMA_EN_MASK;
 
 		/* Send single block write command */
 		Status = XSdPs_CmdTransfer(InstancePtr, CMD24, Arg, BlkCnt);
@@ -1483,7 +1489,7 @@ s32 XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 			goto RETURN_PATH;
 		}
 	} else {
-		TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+		InstancePtr->TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
 			XSDPS_TM_BLK_CNT_EN_MASK |
 			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
@@ -80,8 +80,15 @@
 * descriptor table and hence care will have to be taken to call read/write
 * API's in a loop for large file sizes.
 *
-* Interrupt mode is not supported because it offers no improvement when used
-* with file system.
+* Asynchronous I/O:
+* XSdPs_AsyncSubmit() queues read and write requests which are transferred
+* in the background, with completion signalled by the transfer complete
+* interrupt through XSdPs_AsyncIntrHandler(). Queued requests of the same
+* direction with contiguous sectors are merged into one multiple block
+* command. Multiple block commands use CMD23 pre-defined block counts where
+* the card supports it, and non-contiguous writes are combined into eMMC
+* packed write commands where EXT_CSD reports support. The polled read and
+* write functions must not be used while requests are in flight.
 *
 * eMMC support:
 * SD driver supports SD and eMMC based on the "enable MMC" parameter in SDK.
@@ -90,8 +97,8 @@
 * using 4-bit and high speed mode currently.
 *
 * Features not supported include - card write protect, password setting,
-* lock/unlock, interrupts, SDMA mode, programmed I/O mode and
-* 64-bit addressed ADMA2, erase/pre-erase commands.
+* lock/unlock, interrupts other than for the asynchronous queue, SDMA mode,
+* programmed I/O mode and 64-bit addressed ADMA2, erase/pre-erase commands.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -146,6 +153,11 @@
 *                       information.
 *       mn     09/06/17 Resolved compilation errors with IAR toolchain
 * 3.6   mn     08/01/18 Add support for using 64Bit DMA with 32-Bit Processor
+*       agt    10/17/26 Added interrupt driven asynchronous request queue in
+*                       xsdps_async.c
+*       agt    10/17/26 Moved the transfer mode from a global variable into
+*                       the instance so that controllers can be used from
+*                       different tasks concurrently.
 *
 * </pre>
 *
@@ -171,6 +183,13 @@ extern "C" {
 #define XSDPS_CT_ERROR	0x2U	/**< Command timeout flag */
 #define MAX_TUNING_COUNT	40U		/**< Maximum Tuning count */
 
+#define XSDPS_ASYNC_MAX_DESC	64U	/**< ADMA2 descriptors of the
+					     asynchronous queue */
+#define XSDPS_ASYNC_MAX_MERGE	32U	/**< Requests merged into one
+					     command at most */
+#define XSDPS_ASYNC_MAX_PACKED	16U	/**< Entries of a packed write at
+					     most */
+
 /**************************** Type Definitions *******************************/
 
 typedef void (*XSdPs_ConfigTap) (u32 Bank, u32 DeviceId, u32 CardType);
@@ -226,6 +245,7 @@ typedef struct {
 	u32 SectorCount;		/**< Sector Count */
 	u32 SdCardConfig;	/**< Sd Card Configuration Register */
 	u32 Mode;			/**< Bus Speed Mode */
+	u16 TransferMode;	/**< Transfer mode of the next command */
 	XSdPs_ConfigTap Config_TapDelay;	/**< Configuring the tap delays */
 	/**< ADMA Descriptors */
 #ifdef __ICCARM__
@@ -238,6 +258,67 @@ typedef struct {
 	u64 Dma64BitAddr;	/**< 64 Bit DMA Address */
 } XSdPs;
 
+/**
+ * Completion callback of an asynchronous request, called from interrupt
+ * context with XST_SUCCESS or XST_FAILURE.
+ */
+typedef void (*XSdPs_AsyncHandler) (void *CallBackRef, s32 Status);
+
+/**
+ * Asynchronous read or write request. The request and its buffer belong to
+ * the driver from XSdPs_AsyncSubmit() until the completion callback.
+ */
+typedef struct XSdPs_AsyncReq {
+	u32 Sector;		/**< First sector */
+	u32 BlkCnt;		/**< Number of 512 byte blocks */
+	u8 *Buff;		/**< Data buffer, 32 byte aligned */
+	u8 IsWrite;		/**< Write to the card if set */
+	XSdPs_AsyncHandler Handler;	/**< Completion callback, may be
+					     NULL */
+	void *CallBackRef;	/**< Passed to the completion callback */
+	s32 Status;		/**< Completion status */
+	struct XSdPs_AsyncReq *Next;	/**< Driver internal */
+} XSdPs_AsyncReq;
+
+/**
+ * Counters of the asynchronous queue
+ */
+typedef struct {
+	u32 Requests;		/**< Completed requests */
+	u32 Commands;		/**< Data commands issued */
+	u32 Merged;		/**< Requests merged into a previous one */
+	u32 Packed;		/**< Packed write commands issued */
+	u32 Errors;		/**< Failed data commands */
+} XSdPs_AsyncStats;
+
+/**
+ * Asynchronous request queue of one host controller
+ */
+typedef struct {
+	XSdPs *InstancePtr;	/**< Initialized SD instance */
+	u32 IsReady;		/**< Queue is initialized */
+	u8 HasCmd23;		/**< Card supports CMD23 */
+	u8 MaxPackedWrites;	/**< Packed write entries, 0 if unsupported */
+	u8 IsBusy;		/**< A data command is in flight */
+	u8 IsWrite;		/**< Direction of the command in flight */
+	u32 LockDepth;		/**< Nesting of XSdPs_AsyncLock */
+	XSdPs_AsyncReq *Head;	/**< Oldest queued request */
+	XSdPs_AsyncReq *Tail;	/**< Newest queued request */
+	XSdPs_AsyncReq *Active;	/**< Requests of the command in flight */
+	XSdPs_AsyncStats Stats;	/**< Counters */
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+	XSdPs_Adma2Descriptor DescTbl[XSDPS_ASYNC_MAX_DESC];
+#pragma data_alignment = 32
+	u8 PackedHdr[XSDPS_BLK_SIZE_512_MASK];
+#pragma data_alignment = 4
+#else
+	XSdPs_Adma2Descriptor DescTbl[XSDPS_ASYNC_MAX_DESC]
+						__attribute__ ((aligned(32)));
+	u8 PackedHdr[XSDPS_BLK_SIZE_512_MASK] __attribute__ ((aligned(32)));
+#endif
+} XSdPs_Async;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
@@ -259,6 +340,11 @@ s32 XSdPs_MmcCardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_CardInitialize(XSdPs *InstancePtr);
 s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff);
 s32 XSdPs_Set_Mmc_ExtCsd(XSdPs *InstancePtr, u32 Arg);
+s32 XSdPs_AsyncInitialize(XSdPs_Async *AsyncPtr, XSdPs *InstancePtr);
+s32 XSdPs_AsyncSubmit(XSdPs_Async *AsyncPtr, XSdPs_AsyncReq *ReqPtr);
+u32 XSdPs_AsyncIsIdle(XSdPs_Async *AsyncPtr);
+void XSdPs_AsyncIntrHandler(void *CallBackRef);
+void XSdPs_AsyncGetStats(XSdPs_Async *AsyncPtr, XSdPs_AsyncStats *StatsPtr);
 #if defined (ARMR5) || defined (__aarch64__) || defined (ARMA53_32)
 void XSdPs_Identify_UhsMode(XSdPs *InstancePtr, u8 *ReadBuff);
 void XSdPs_ddr50_tapdelay(u32 Bank, u32 DeviceId, u32 CardType);
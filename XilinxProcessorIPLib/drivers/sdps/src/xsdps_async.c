@@ -0,0 +1,735 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_async.c
+* @addtogroup sdps_v3_6
+* @{
+*
+* Contains the interrupt driven asynchronous request queue. Requests are
+* queued in submission order. The oldest request and the requests queued
+* after it with the same direction are combined into one data command as
+* long as their sectors are contiguous, or, for eMMC writes, into one packed
+* write command. The command is issued with the ADMA2 table of the queue and
+* its transfer complete interrupt completes the requests and starts the next
+* command. Queue updates are made with the interrupt signals of the
+* controller masked. The mask is read back before the queue is touched, and
+* an interrupt the GIC delivered before the mask took effect finds the queue
+* locked and is taken again once the lock owner unmasks the signals. See
+* xsdps.h for a detailed description of the device and driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.6   agt    10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSDPS_ASYNC_MAX_BLKCNT	0xFFFFU	/**< Limit of the block count
+					     register */
+
+#define XSDPS_ASYNC_NORM_SIG	(XSDPS_INTR_TC_MASK | XSDPS_INTR_ERR_MASK)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+s32 XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt);
+static u32 XSdPs_AsyncDescCnt(u32 BlkCnt);
+static u32 XSdPs_AsyncAddr(const XSdPs_Async *AsyncPtr, u32 Sector);
+static void XSdPs_AsyncLock(XSdPs_Async *AsyncPtr);
+static void XSdPs_AsyncUnlock(XSdPs_Async *AsyncPtr);
+static u32 XSdPs_AsyncAddDesc(XSdPs_Async *AsyncPtr, u32 DescNum,
+		const u8 *Buff, u32 Length);
+static s32 XSdPs_AsyncStart(XSdPs_Async *AsyncPtr);
+static void XSdPs_AsyncComplete(XSdPs_Async *AsyncPtr, s32 Status);
+static void XSdPs_AsyncDispatch(XSdPs_Async *AsyncPtr);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+* Initializes the asynchronous request queue of an initialized card and
+* detects the CMD23 and packed command support of the card.
+*
+* @param	AsyncPtr is a pointer to the queue to initialize.
+* @param	InstancePtr is a pointer to the XSdPs instance, the card has
+*		to be initialized.
+*
+* @return
+*		- XST_SUCCESS if the queue is initialized.
+*		- XST_FAILURE if the card registers could not be read or the
+*		  block size could not be set.
+*
+* @note		The SD interrupt has to be connected to
+*		XSdPs_AsyncIntrHandler() with AsyncPtr as callback reference.
+*
+******************************************************************************/
+s32 XSdPs_AsyncInitialize(XSdPs_Async *AsyncPtr, XSdPs *InstancePtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(AsyncPtr != NULL);
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	(void)memset(AsyncPtr, 0, sizeof(XSdPs_Async));
+	AsyncPtr->InstancePtr = InstancePtr;
+
+	if ((InstancePtr->CardType == XSDPS_CARD_MMC) ||
+			(InstancePtr->CardType == XSDPS_CHIP_EMMC)) {
+		/* CMD23 is mandatory for MMC, packed commands since v4.5 */
+		AsyncPtr->HasCmd23 = 1U;
+
+		Status = XSdPs_Get_Mmc_ExtCsd(InstancePtr, AsyncPtr->PackedHdr);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		if (AsyncPtr->PackedHdr[EXT_CSD_REV_BYTE] >= EXT_CSD_REV_4_5) {
+			AsyncPtr->MaxPackedWrites =
+				AsyncPtr->PackedHdr[EXT_CSD_MAX_PACKED_WR_BYTE];
+			if (AsyncPtr->MaxPackedWrites > XSDPS_ASYNC_MAX_PACKED) {
+				AsyncPtr->MaxPackedWrites = XSDPS_ASYNC_MAX_PACKED;
+			}
+		}
+	} else {
+		Status = XSdPs_Get_BusWidth(InstancePtr, AsyncPtr->PackedHdr);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		if ((AsyncPtr->PackedHdr[XSDPS_SCR_CMD_SUPP_BYTE] &
+				XSDPS_SCR_CMD23_SUPP) != 0U) {
+			AsyncPtr->HasCmd23 = 1U;
+		}
+	}
+
+	/* Packing a single entry is pointless */
+	if (AsyncPtr->MaxPackedWrites < 2U) {
+		AsyncPtr->MaxPackedWrites = 0U;
+	}
+
+	if (XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_BLK_SIZE_OFFSET) != XSDPS_BLK_SIZE_512_MASK) {
+		Status = XSdPs_SetBlkSize(InstancePtr, XSDPS_BLK_SIZE_512_MASK);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+	}
+
+	AsyncPtr->IsReady = XIL_COMPONENT_IS_READY;
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Queues a read or write request. The request is started at once if the
+* queue is idle, otherwise after the requests queued before it.
+*
+* @param	AsyncPtr is a pointer to the queue.
+* @param	ReqPtr is the request. Sector, BlkCnt, Buff, IsWrite, Handler
+*		and CallBackRef have to be set.
+*
+* @return
+*		- XST_SUCCESS if the request is queued.
+*		- XST_INVALID_PARAM if the block count is 0 or the request
+*		  needs more ADMA2 descriptors than the queue has.
+*
+* @note		Write buffers are flushed from the data cache here, so they
+*		must not be modified until the completion callback.
+*
+******************************************************************************/
+s32 XSdPs_AsyncSubmit(XSdPs_Async *AsyncPtr, XSdPs_AsyncReq *ReqPtr)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(AsyncPtr != NULL);
+	Xil_AssertNonvoid(AsyncPtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(ReqPtr != NULL);
+
+	/* One descriptor is kept for the packed command header */
+	if ((ReqPtr->BlkCnt == 0U) ||
+			(ReqPtr->BlkCnt >= XSDPS_ASYNC_MAX_BLKCNT) ||
+			(XSdPs_AsyncDescCnt(ReqPtr->BlkCnt) >=
+			XSDPS_ASYNC_MAX_DESC)) {
+		Status = XST_INVALID_PARAM;
+		goto RETURN_PATH;
+	}
+
+	if (AsyncPtr->InstancePtr->Config.IsCacheCoherent == 0U) {
+		if (ReqPtr->IsWrite != 0U) {
+			Xil_DCacheFlushRange((INTPTR)ReqPtr->Buff,
+				ReqPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		} else {
+			Xil_DCacheInvalidateRange((INTPTR)ReqPtr->Buff,
+				ReqPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		}
+	}
+
+	ReqPtr->Next = NULL;
+	ReqPtr->Status = XST_DEVICE_BUSY;
+
+	XSdPs_AsyncLock(AsyncPtr);
+
+	if (AsyncPtr->Tail != NULL) {
+		AsyncPtr->Tail->Next = ReqPtr;
+	} else {
+		AsyncPtr->Head = ReqPtr;
+	}
+	AsyncPtr->Tail = ReqPtr;
+
+	XSdPs_AsyncDispatch(AsyncPtr);
+
+	XSdPs_AsyncUnlock(AsyncPtr);
+
+	Status = XST_SUCCESS;
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Checks whether the queue has no request in flight or queued.
+*
+* @param	AsyncPtr is a pointer to the queue.
+*
+* @return	TRUE if the queue is idle, FALSE otherwise.
+*
+******************************************************************************/
+u32 XSdPs_AsyncIsIdle(XSdPs_Async *AsyncPtr)
+{
+	u32 IsIdle;
+
+	Xil_AssertNonvoid(AsyncPtr != NULL);
+
+	XSdPs_AsyncLock(AsyncPtr);
+	IsIdle = ((AsyncPtr->IsBusy == 0U) && (AsyncPtr->Head == NULL)) ?
+			(u32)TRUE : (u32)FALSE;
+	XSdPs_AsyncUnlock(AsyncPtr);
+
+	return IsIdle;
+}
+
+/*****************************************************************************/
+/**
+* Interrupt handler of the asynchronous queue. It completes the requests of
+* the command in flight on transfer complete or error, and issues the next
+* command.
+*
+* @param	CallBackRef is a pointer to the queue.
+*
+* @return	None
+*
+* @note		On an error the command and data lines are reset and all
+*		requests of the command complete with XST_FAILURE.
+*
+******************************************************************************/
+void XSdPs_AsyncIntrHandler(void *CallBackRef)
+{
+	XSdPs_Async *AsyncPtr = (XSdPs_Async *)CallBackRef;
+	u32 BaseAddress;
+	u16 StatusReg;
+	u8 ResetReg;
+	s32 Status;
+
+	Xil_AssertVoid(AsyncPtr != NULL);
+
+	BaseAddress = AsyncPtr->InstancePtr->Config.BaseAddress;
+	StatusReg = XSdPs_ReadReg16(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET);
+
+	if (AsyncPtr->LockDepth != 0U) {
+		/*
+		 * Raised before the lock masked the signals. The status stays
+		 * set and XSdPs_AsyncUnlock() raises the interrupt again,
+		 * masking here keeps the level interrupt from refiring.
+		 */
+		XSdPs_WriteReg16(BaseAddress, XSDPS_NORM_INTR_SIG_EN_OFFSET, 0U);
+		XSdPs_WriteReg16(BaseAddress, XSDPS_ERR_INTR_SIG_EN_OFFSET, 0U);
+		return;
+	}
+
+	if ((AsyncPtr->IsBusy == 0U) ||
+			((StatusReg & XSDPS_ASYNC_NORM_SIG) == 0U)) {
+		return;
+	}
+
+	XSdPs_AsyncLock(AsyncPtr);
+
+	if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+		XSdPs_WriteReg16(BaseAddress, XSDPS_ERR_INTR_STS_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+
+		XSdPs_WriteReg8(BaseAddress, XSDPS_SW_RST_OFFSET,
+			XSDPS_SWRST_CMD_LINE_MASK | XSDPS_SWRST_DAT_LINE_MASK);
+		do {
+			ResetReg = XSdPs_ReadReg8(BaseAddress,
+						XSDPS_SW_RST_OFFSET);
+		} while ((ResetReg & (XSDPS_SWRST_CMD_LINE_MASK |
+				XSDPS_SWRST_DAT_LINE_MASK)) != 0U);
+
+		Status = XST_FAILURE;
+	} else {
+		Status = XST_SUCCESS;
+	}
+
+	XSdPs_WriteReg16(BaseAddress, XSDPS_NORM_INTR_STS_OFFSET,
+			StatusReg & XSDPS_ASYNC_NORM_SIG);
+
+	XSdPs_AsyncComplete(AsyncPtr, Status);
+	XSdPs_AsyncDispatch(AsyncPtr);
+
+	XSdPs_AsyncUnlock(AsyncPtr);
+}
+
+/*****************************************************************************/
+/**
+* Copies the counters of the queue.
+*
+* @param	AsyncPtr is a pointer to the queue.
+* @param	StatsPtr is the structure to contain the counters.
+*
+* @return	None
+*
+******************************************************************************/
+void XSdPs_AsyncGetStats(XSdPs_Async *AsyncPtr, XSdPs_AsyncStats *StatsPtr)
+{
+	Xil_AssertVoid(AsyncPtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	XSdPs_AsyncLock(AsyncPtr);
+	(void)memcpy(StatsPtr, &AsyncPtr->Stats, sizeof(XSdPs_AsyncStats));
+	XSdPs_AsyncUnlock(AsyncPtr);
+}
+
+/*****************************************************************************/
+/**
+* Number of ADMA2 descriptors a buffer of BlkCnt blocks needs.
+*
+* @param	BlkCnt - block count.
+*
+* @return	Number of descriptors
+*
+******************************************************************************/
+static u32 XSdPs_AsyncDescCnt(u32 BlkCnt)
+{
+	return ((BlkCnt * XSDPS_BLK_SIZE_512_MASK) +
+			(XSDPS_DESC_MAX_LENGTH - 1U)) / XSDPS_DESC_MAX_LENGTH;
+}
+
+/*****************************************************************************/
+/**
+* Command argument of a sector, block addressed for high capacity cards and
+* byte addressed otherwise.
+*
+* @param	AsyncPtr is a pointer to the queue.
+* @param	Sector is the sector number.
+*
+* @return	Command argument
+*
+******************************************************************************/
+static u32 XSdPs_AsyncAddr(const XSdPs_Async *AsyncPtr, u32 Sector)
+{
+	u32 Addr;
+
+	if (AsyncPtr->InstancePtr->HCS != 0U) {
+		Addr = Sector;
+	} else {
+		Addr = Sector * XSDPS_BLK_SIZE_512_MASK;
+	}
+
+	return Addr;
+}
+
+/*****************************************************************************/
+/**
+* Masks the interrupt signals of the queue so the interrupt handler does not
+* run. Pending status stays set and raises the interrupt again on unlock.
+* The signal enable register is read back, so the mask has reached the
+* controller before the queue is changed.
+*
+* @param	AsyncPtr is a pointer to the queue.
+*
+* @return	None
+*
+* @note		Calls may be nested, only the outermost one masks. An
+*		interrupt already pending at the GIC may still be taken,
+*		XSdPs_AsyncIntrHandler() checks LockDepth and backs off.
+*
+******************************************************************************/
+static void XSdPs_AsyncLock(XSdPs_Async *AsyncPtr)
+{
+	u32 BaseAddress = AsyncPtr->InstancePtr->Config.BaseAddress;
+
+	AsyncPtr->LockDepth++;
+	if (AsyncPtr->LockDepth == 1U) {
+		XSdPs_WriteReg16(BaseAddress, XSDPS_NORM_INTR_SIG_EN_OFFSET, 0U);
+		XSdPs_WriteReg16(BaseAddress, XSDPS_ERR_INTR_SIG_EN_OFFSET, 0U);
+		(void)XSdPs_ReadReg16(BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Undoes XSdPs_AsyncLock() and unmasks the interrupt signals of the queue
+* while a command is in flight.
+*
+* @param	AsyncPtr is a pointer to the queue.
+*
+* @return	None
+*
+******************************************************************************/
+static void XSdPs_AsyncUnlock(XSdPs_Async *AsyncPtr)
+{
+	u32 BaseAddress = AsyncPtr->InstancePtr->Config.BaseAddress;
+
+	AsyncPtr->LockDepth--;
+	if ((AsyncPtr->LockDepth == 0U) && (AsyncPtr->IsBusy != 0U)) {
+		XSdPs_WriteReg16(BaseAddress, XSDPS_ERR_INTR_SIG_EN_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		XSdPs_WriteReg16(BaseAddress, XSDPS_NORM_INTR_SIG_EN_OFFSET,
+				XSDPS_ASYNC_NORM_SIG);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Adds the descriptors of one buffer to the ADMA2 table of the queue.
+*
+* @param	AsyncPtr is a pointer to the queue.
+* @param	DescNum is the first free descriptor.
+* @param	Buff is the buffer.
+* @param	Length is the buffer length in bytes.
+*
+* @return	Next free descriptor
+*
+******************************************************************************/
+static u32 XSdPs_AsyncAddDesc(XSdPs_Async *AsyncPtr, u32 DescNum,
+		const u8 *Buff, u32 Length)
+{
+	UINTPTR Addr = (UINTPTR)Buff;
+	u32 Remaining = Length;
+	u32 Chunk;
+	u32 Index = DescNum;
+
+	while (Remaining != 0U) {
+		Chunk = (Remaining > XSDPS_DESC_MAX_LENGTH) ?
+				XSDPS_DESC_MAX_LENGTH : Remaining;
+
+#if defined(__aarch64__) || defined(__arch64__)
+		AsyncPtr->DescTbl[Index].Address = (u64)Addr;
+#else
+		AsyncPtr->DescTbl[Index].Address = (u32)Addr;
+#endif
+		AsyncPtr->DescTbl[Index].Attribute =
+				XSDPS_DESC_TRAN | XSDPS_DESC_VALID;
+		/* This will write '0' to length field which indicates 65536 */
+		AsyncPtr->DescTbl[Index].Length = (u16)Chunk;
+
+		Addr += Chunk;
+		Remaining -= Chunk;
+		Index++;
+	}
+
+	return Index;
+}
+
+/*****************************************************************************/
+/**
+* Combines the oldest queued requests into one data command and issues it.
+* The requests are moved from the queue to the active list.
+*
+* @param	AsyncPtr is a pointer to the queue.
+*
+* @return
+*		- XST_SUCCESS if the command was issued.
+*		- XST_FAILURE if the card or the controller rejected it, the
+*		  active requests are not completed yet.
+*
+******************************************************************************/
+static s32 XSdPs_AsyncStart(XSdPs_Async *AsyncPtr)
+{
+	XSdPs *InstancePtr = AsyncPtr->InstancePtr;
+	XSdPs_AsyncReq *ReqPtr;
+	XSdPs_AsyncReq *LastPtr = NULL;
+	u32 EntrySector[XSDPS_ASYNC_MAX_PACKED];
+	u32 EntryCnt[XSDPS_ASYNC_MAX_PACKED];
+	u32 MaxEntries;
+	u32 NumEntries = 0U;
+	u32 NumReq = 0U;
+	u32 BlkCnt = 0U;
+	u32 DescCnt = 0U;
+	u32 DescNum = 0U;
+	u32 Index;
+	u8 *EntryPtr;
+	u8 IsWrite;
+	s32 Status;
+
+	IsWrite = AsyncPtr->Head->IsWrite;
+	MaxEntries = (IsWrite != 0U) ? AsyncPtr->MaxPackedWrites : 1U;
+	if (MaxEntries == 0U) {
+		MaxEntries = 1U;
+	}
+
+	/*
+	 * Take requests in queue order while they fit: contiguous ones
+	 * extend the current entry, others open a new packed entry.
+	 */
+	for (ReqPtr = AsyncPtr->Head; ReqPtr != NULL; ReqPtr = ReqPtr->Next) {
+		if ((ReqPtr->IsWrite != IsWrite) ||
+				(NumReq == XSDPS_ASYNC_MAX_MERGE) ||
+				((BlkCnt + ReqPtr->BlkCnt) >=
+				XSDPS_ASYNC_MAX_BLKCNT) ||
+				((DescCnt + XSdPs_AsyncDescCnt(ReqPtr->BlkCnt)) >=
+				XSDPS_ASYNC_MAX_DESC)) {
+			break;
+		}
+
+		if ((NumEntries != 0U) && (ReqPtr->Sector ==
+				(EntrySector[NumEntries - 1U] +
+				EntryCnt[NumEntries - 1U]))) {
+			EntryCnt[NumEntries - 1U] += ReqPtr->BlkCnt;
+		} else if (NumEntries < MaxEntries) {
+			EntrySector[NumEntries] = ReqPtr->Sector;
+			EntryCnt[NumEntries] = ReqPtr->BlkCnt;
+			NumEntries++;
+		} else {
+			break;
+		}
+
+		BlkCnt += ReqPtr->BlkCnt;
+		DescCnt += XSdPs_AsyncDescCnt(ReqPtr->BlkCnt);
+		NumReq++;
+		LastPtr = ReqPtr;
+	}
+
+	/* Move the requests to the active list */
+	AsyncPtr->Active = AsyncPtr->Head;
+	AsyncPtr->Head = LastPtr->Next;
+	if (AsyncPtr->Head == NULL) {
+		AsyncPtr->Tail = NULL;
+	}
+	LastPtr->Next = NULL;
+	AsyncPtr->IsWrite = IsWrite;
+
+	/* Packed write header, followed by the data of all entries */
+	if (NumEntries > 1U) {
+		(void)memset(AsyncPtr->PackedHdr, 0, sizeof(AsyncPtr->PackedHdr));
+		AsyncPtr->PackedHdr[0] = XSDPS_PACKED_HDR_VERSION;
+		AsyncPtr->PackedHdr[1] = XSDPS_PACKED_HDR_WRITE;
+		AsyncPtr->PackedHdr[2] = (u8)NumEntries;
+
+		for (Index = 0U; Index < NumEntries; Index++) {
+			EntryPtr = &AsyncPtr->PackedHdr[(Index + 1U) *
+					XSDPS_PACKED_HDR_ENTRY_SIZE];
+			Xil_Out32LE((UINTPTR)&EntryPtr[0], EntryCnt[Index]);
+			Xil_Out32LE((UINTPTR)&EntryPtr[4],
+				XSdPs_AsyncAddr(AsyncPtr, EntrySector[Index]));
+		}
+
+		if (InstancePtr->Config.IsCacheCoherent == 0U) {
+			Xil_DCacheFlushRange((INTPTR)AsyncPtr->PackedHdr,
+				sizeof(AsyncPtr->PackedHdr));
+		}
+
+		DescNum = XSdPs_AsyncAddDesc(AsyncPtr, DescNum,
+				AsyncPtr->PackedHdr, XSDPS_BLK_SIZE_512_MASK);
+	}
+
+	for (ReqPtr = AsyncPtr->Active; ReqPtr != NULL; ReqPtr = ReqPtr->Next) {
+		DescNum = XSdPs_AsyncAddDesc(AsyncPtr, DescNum, ReqPtr->Buff,
+				ReqPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	}
+	AsyncPtr->DescTbl[DescNum - 1U].Attribute |= XSDPS_DESC_END;
+
+	if (InstancePtr->Config.IsCacheCoherent == 0U) {
+		Xil_DCacheFlushRange((INTPTR)&AsyncPtr->DescTbl[0],
+			sizeof(XSdPs_Adma2Descriptor) * DescNum);
+	}
+
+#if defined(__aarch64__) || defined(__arch64__)
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress,
+			XSDPS_ADMA_SAR_EXT_OFFSET,
+			(u32)(((u64)&(AsyncPtr->DescTbl[0]))>>32));
+#endif
+	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
+			(u32)(UINTPTR)&(AsyncPtr->DescTbl[0]));
+
+	AsyncPtr->Stats.Commands++;
+	AsyncPtr->Stats.Merged += NumReq - 1U;
+
+	if (NumEntries > 1U) {
+		/* Header block counts in the pre-defined block count */
+		BlkCnt += 1U;
+		AsyncPtr->Stats.Packed++;
+
+		InstancePtr->TransferMode = 0U;
+		Status = XSdPs_CmdTransfer(InstancePtr, CMD23,
+				XSDPS_CMD23_PACKED | BlkCnt, 0U);
+		if (Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto RETURN_PATH;
+		}
+
+		InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+			XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		Status = XSdPs_CmdTransfer(InstancePtr, CMD25,
+				XSdPs_AsyncAddr(AsyncPtr, EntrySector[0]), BlkCnt);
+	} else if (BlkCnt == 1U) {
+		InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DMA_EN_MASK;
+		if (IsWrite == 0U) {
+			InstancePtr->TransferMode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		Status = XSdPs_CmdTransfer(InstancePtr,
+				(IsWrite != 0U) ? CMD24 : CMD17,
+				XSdPs_AsyncAddr(AsyncPtr, EntrySector[0]), BlkCnt);
+	} else {
+		if (AsyncPtr->HasCmd23 != 0U) {
+			/* Pre-defined block count, no stop command needed */
+			InstancePtr->TransferMode = 0U;
+			Status = XSdPs_CmdTransfer(InstancePtr, CMD23, BlkCnt, 0U);
+			if (Status != XST_SUCCESS) {
+				Status = XST_FAILURE;
+				goto RETURN_PATH;
+			}
+
+			InstancePtr->TransferMode = XSDPS_TM_BLK_CNT_EN_MASK |
+				XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		} else {
+			InstancePtr->TransferMode = XSDPS_TM_AUTO_CMD12_EN_MASK |
+				XSDPS_TM_BLK_CNT_EN_MASK |
+				XSDPS_TM_MUL_SIN_BLK_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		}
+
+		if (IsWrite == 0U) {
+			InstancePtr->TransferMode |= XSDPS_TM_DAT_DIR_SEL_MASK;
+		}
+
+		Status = XSdPs_CmdTransfer(InstancePtr,
+				(IsWrite != 0U) ? CMD25 : CMD18,
+				XSdPs_AsyncAddr(AsyncPtr, EntrySector[0]), BlkCnt);
+	}
+
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Completes the requests of the active list.
+*
+* @param	AsyncPtr is a pointer to the queue.
+* @param	Status is the completion status of the requests.
+*
+* @return	None
+*
+* @note		The callbacks may submit new requests.
+*
+******************************************************************************/
+static void XSdPs_AsyncComplete(XSdPs_Async *AsyncPtr, s32 Status)
+{
+	XSdPs_AsyncReq *ReqPtr = AsyncPtr->Active;
+	XSdPs_AsyncReq *NextPtr;
+
+	AsyncPtr->Active = NULL;
+	AsyncPtr->IsBusy = 0U;
+
+	if (Status != XST_SUCCESS) {
+		AsyncPtr->Stats.Errors++;
+	}
+
+	while (ReqPtr != NULL) {
+		NextPtr = ReqPtr->Next;
+		ReqPtr->Next = NULL;
+		ReqPtr->Status = Status;
+
+		if ((ReqPtr->IsWrite == 0U) &&
+			(AsyncPtr->InstancePtr->Config.IsCacheCoherent == 0U)) {
+			Xil_DCacheInvalidateRange((INTPTR)ReqPtr->Buff,
+				ReqPtr->BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+		}
+
+		AsyncPtr->Stats.Requests++;
+		if (ReqPtr->Handler != NULL) {
+			ReqPtr->Handler(ReqPtr->CallBackRef, Status);
+		}
+
+		ReqPtr = NextPtr;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Issues the next data command if none is in flight. Requests of commands
+* which cannot be issued are completed with XST_FAILURE.
+*
+* @param	AsyncPtr is a pointer to the queue.
+*
+* @return	None
+*
+* @note		Called with the interrupt signals masked.
+*
+******************************************************************************/
+static void XSdPs_AsyncDispatch(XSdPs_Async *AsyncPtr)
+{
+	s32 Status;
+
+	while ((AsyncPtr->IsBusy == 0U) && (AsyncPtr->Head != NULL)) {
+		Status = XSdPs_AsyncStart(AsyncPtr);
+		if (Status == XST_SUCCESS) {
+			AsyncPtr->IsBusy = 1U;
+		} else {
+			XSdPs_AsyncComplete(AsyncPtr, XST_FAILURE);
+		}
+	}
+}
+/** @} */
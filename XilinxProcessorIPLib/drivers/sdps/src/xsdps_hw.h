@@ -57,6 +57,7 @@
 *       mn     09/06/17 Added support for ARMCC toolchain
 * 3.4   mn     01/22/18 Separated out SDR104 and HS200 clock defines
 * 3.6   mn     07/06/18 Fix Doxygen warnings for sdps driver
+*       agt    10/17/26 Added CMD23 and eMMC packed command definitions
 *
 * </pre>
 *
@@ -738,6 +739,16 @@ extern "C" {
 #define XSDPS_SCR_CMD_SUPP_MASK		0x3U
 #define XSDPS_SCR_CMD23_SUPP		(1U<<1)
 #define XSDPS_SCR_CMD20_SUPP		(1U<<0)
+#define XSDPS_SCR_CMD_SUPP_BYTE		3U	/* Byte of CMD_SUPPORT in the
+						   SCR as read by ACMD51 */
+
+/* CMD23 argument definitions */
+#define XSDPS_CMD23_PACKED		(1U<<30)	/* eMMC packed command */
+
+/* eMMC packed command header definitions */
+#define XSDPS_PACKED_HDR_VERSION	0x01U
+#define XSDPS_PACKED_HDR_WRITE		0x02U
+#define XSDPS_PACKED_HDR_ENTRY_SIZE	8U
 
 /* Card Status Register Definitions */
 #define XSDPS_CD_STS_OUT_OF_RANGE	(1U<<31)
@@ -816,6 +827,11 @@ extern "C" {
 
 #define EXT_CSD_WR_REL_PARAM_EN		(1U<<2)
 
+#define EXT_CSD_REV_BYTE		192U
+#define EXT_CSD_MAX_PACKED_WR_BYTE	501U	/* Max entries of a packed write */
+#define EXT_CSD_REV_4_5			6U	/* First revision with packed
+						   commands */
+
 #define EXT_CSD_BOOT_WP_B_PWR_WP_DIS    (0x40U)
 #define EXT_CSD_BOOT_WP_B_PERM_WP_DIS   (0x10U)
 #define EXT_CSD_BOOT_WP_B_PERM_WP_EN    (0x04U)
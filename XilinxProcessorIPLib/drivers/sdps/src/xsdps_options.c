@@ -72,6 +72,8 @@
 *       mn     08/22/17 Updated for Word Access System support
 * 3.4   mn     01/22/18 Separated out SDR104 and HS200 clock defines
 * 3.6   mn     07/06/18 Fix Cppcheck warnings for sdps driver
+*       agt    10/17/26 Transfer mode is kept in the instance instead of a
+*                       global variable.
 *
 * </pre>
 *
@@ -104,7 +106,6 @@ void XSdPs_SetTapDelay(XSdPs *InstancePtr);
 static void XSdPs_DllReset(XSdPs *InstancePtr);
 #endif
 
-extern u16 TransferMode;
 /*****************************************************************************/
 /**
 * Update Block size for read/write operations.
@@ -201,7 +202,7 @@ s32 XSdPs_Get_BusWidth(XSdPs *InstancePtr, u8 *SCR)
 
 	XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, SCR);
 
-	TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+	InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 	if (InstancePtr->Config.IsCacheCoherent == 0) {
 		Xil_DCacheInvalidateRange((INTPTR)SCR, 8);
@@ -415,7 +416,7 @@ s32 XSdPs_Get_BusSpeed(XSdPs *InstancePtr, u8 *ReadBuff)
 
 	XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, ReadBuff);
 
-	TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+	InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 	Arg = XSDPS_SWITCH_CMD_HS_GET;
 
@@ -498,7 +499,7 @@ s32 XSdPs_Change_BusSpeed(XSdPs *InstancePtr)
 			Xil_DCacheFlushRange((INTPTR)ReadBuff, 64);
 		}
 
-		TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+		InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 		Arg = XSDPS_SWITCH_CMD_HS_SET;
 
@@ -857,7 +858,7 @@ s32 XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff)
 		Xil_DCacheInvalidateRange((INTPTR)ReadBuff, 512U);
 	}
 
-	TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+	InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 	/* Send SEND_EXT_CSD command */
 	Status = XSdPs_CmdTransfer(InstancePtr, CMD8, Arg, 1U);
@@ -1040,7 +1041,7 @@ s32 XSdPs_Uhs_ModeInit(XSdPs *InstancePtr, u8 Mode)
 		Xil_DCacheFlushRange((INTPTR)ReadBuff, 64);
 	}
 
-	TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
+	InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK | XSDPS_TM_DMA_EN_MASK;
 
 	switch (Mode) {
 	case 0U:
@@ -1149,7 +1150,7 @@ static s32 XSdPs_Execute_Tuning(XSdPs *InstancePtr)
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress, XSDPS_BLK_SIZE_OFFSET,
 			BlkSize);
 
-	TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK;
+	InstancePtr->TransferMode = 	XSDPS_TM_DAT_DIR_SEL_MASK;
 
 	CtrlReg = XSdPs_ReadReg16(InstancePtr->Config.BaseAddress,
 				XSDPS_HOST_CTRL2_OFFSET);
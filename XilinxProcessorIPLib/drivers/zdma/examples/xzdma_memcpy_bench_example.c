@@ -0,0 +1,436 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_memcpy_bench_example.c
+*
+* This file contains a benchmark of the XZDma memcpy engine. It compares
+* libc memcpy(), Xil_MemCpy() and the engine, with all GDMA and ADMA
+* channels in its pool, for copy sizes from 64 bytes to 64 MB.
+*
+* For every size the same number of bytes is copied by each method. Copies
+* are made between distinct regions of two buffers. The engine gets them in
+* batches of BENCH_BATCH requests and runs in polled mode, so no interrupt
+* controller setup is needed. The engine is measured twice:
+*	- dma	- CPU threshold 0, every request goes to a channel.
+*	- auto	- default CPU threshold XZDMA_MEMCPY_CPU_THRESHOLD.
+* Bandwidth is printed in MB/s; the engine times include its cache
+* maintenance.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.6   agt     10/17/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xzdma.h"
+#include "xparameters.h"
+#include "xil_mem.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+#include "bspconfig.h"
+
+/************************** Constant Definitions ******************************/
+
+/*
+ * The buffers are placed in DDR at fixed addresses, the two of them need
+ * 128 MB. Change these to fit the memory map of the design.
+ */
+#if EL3
+#define BENCH_SRC_ADDR		0x10000000U	/**< Source buffer */
+#define BENCH_DST_ADDR		0x14000000U	/**< Destination buffer */
+#else
+#define BENCH_SRC_ADDR		0x50000000U	/**< Source buffer */
+#define BENCH_DST_ADDR		0x54000000U	/**< Destination buffer */
+#endif
+#define BENCH_BUF_SIZE		0x4000000U	/**< 64 MB per buffer */
+#define BENCH_MIN_SIZE		64U		/**< Smallest copy */
+#define BENCH_TOTAL_BYTES	0x1000000U	/**< Bytes per measurement */
+#define BENCH_MIN_ITER		2U		/**< Copies per measurement */
+#define BENCH_MAX_ITER		4096U		/**< Copies per measurement */
+#define BENCH_BATCH		64U		/**< Requests per submit */
+
+/**************************** Type Definitions *******************************/
+
+
+/************************** Function Prototypes ******************************/
+
+int XZDma_MemcpyBenchExample(void);
+static int SetupEngine(void);
+static u32 RunCpu(u32 Size, u32 Iter, u32 UseXil);
+static int RunEngine(u32 Size, u32 Iter, u32 CpuThreshold, u32 *RatePtr);
+static u32 Rate(u64 Bytes, XTime Ticks);
+static void CopyDone(void *CallBackRef, s32 Status);
+
+/************************** Variable Definitions *****************************/
+
+XZDma ZDma[XZDMA_MEMCPY_MAX_CHAN];	/**< Instances of the ZDMA channels */
+XZDma_Memcpy Engine;			/**< Memcpy engine instance */
+XZDma_MemcpyReq Req[2U * BENCH_BATCH];	/**< Two batches of requests */
+
+#if defined(__ICCARM__)
+    #pragma data_alignment = 64
+	u8 DscrMem[XZDMA_MEMCPY_MAX_CHAN][XZDMA_MEMCPY_DSCR_MEM_SIZE];
+	#pragma data_alignment = 4
+#else
+u8 DscrMem[XZDMA_MEMCPY_MAX_CHAN][XZDMA_MEMCPY_DSCR_MEM_SIZE]
+					__attribute__ ((aligned (64)));
+#endif
+
+u8 *SrcBuf = (u8 *)BENCH_SRC_ADDR;
+u8 *DstBuf = (u8 *)BENCH_DST_ADDR;
+
+volatile u32 DoneCnt;		/**< Completed requests */
+volatile u32 HalfDone[2];	/**< Completed requests of each half */
+volatile u32 ErrCnt;		/**< Requests completed with an error */
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if failed.
+*
+* @note		None.
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	Status = XZDma_MemcpyBenchExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("ZDMA Memcpy Benchmark Example Failed\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran ZDMA Memcpy Benchmark Example\r\n");
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function runs the benchmark for all sizes and prints one line per
+* size.
+*
+* @return
+*		- XST_SUCCESS if all copies completed and were verified.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+int XZDma_MemcpyBenchExample(void)
+{
+	u32 Size;
+	u32 Iter;
+	u32 Index;
+	u32 DmaRate;
+	u32 AutoRate;
+	u32 CpuRate;
+	u32 XilRate;
+	int Status;
+
+	Status = SetupEngine();
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	xil_printf("%d ZDMA channels in the engine pool\r\n", Engine.NumChans);
+
+	for (Index = 0U; Index < BENCH_BUF_SIZE; Index++) {
+		SrcBuf[Index] = (u8)(Index * 7U + (Index >> 13));
+	}
+	Xil_DCacheFlushRange((INTPTR)SrcBuf, BENCH_BUF_SIZE);
+
+	xil_printf("    size  memcpy  Xil_MemCpy  dma  auto (MB/s)\r\n");
+	for (Size = BENCH_MIN_SIZE; Size <= BENCH_BUF_SIZE; Size <<= 2) {
+		Iter = BENCH_TOTAL_BYTES / Size;
+		if (Iter < BENCH_MIN_ITER) {
+			Iter = BENCH_MIN_ITER;
+		}
+		if (Iter > BENCH_MAX_ITER) {
+			Iter = BENCH_MAX_ITER;
+		}
+
+		CpuRate = RunCpu(Size, Iter, FALSE);
+		XilRate = RunCpu(Size, Iter, TRUE);
+		Status = RunEngine(Size, Iter, 0U, &DmaRate);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Status = RunEngine(Size, Iter, XZDMA_MEMCPY_CPU_THRESHOLD,
+					&AutoRate);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		xil_printf("%8d  %6d  %10d  %4d  %4d\r\n", Size, CpuRate,
+				XilRate, DmaRate, AutoRate);
+	}
+
+	xil_printf("engine: %d chains, %d descriptors\r\n", Engine.ChainCnt,
+			Engine.DscrCnt);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function initializes every ZDMA channel of the design and adds it to
+* the memcpy engine.
+*
+* @return
+*		- XST_SUCCESS if at least one channel is in the pool.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int SetupEngine(void)
+{
+	XZDma_Config *Config;
+	XZDma_DataConfig Configur;
+	u32 Index;
+	int Status;
+
+	XZDma_MemcpyInitialize(&Engine);
+
+	for (Index = 0U; (Index < (u32)XPAR_XZDMA_NUM_INSTANCES) &&
+			(Index < XZDMA_MEMCPY_MAX_CHAN); Index++) {
+		Config = XZDma_LookupConfig((u16)Index);
+		if (NULL == Config) {
+			continue;
+		}
+
+		Status = XZDma_CfgInitialize(&ZDma[Index], Config,
+						Config->BaseAddress);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		if (Config->IsCacheCoherent) {
+			XZDma_GetChDataConfig(&ZDma[Index], &Configur);
+			Configur.SrcCache = 0xF;
+			Configur.DstCache = 0xF;
+			XZDma_SetChDataConfig(&ZDma[Index], &Configur);
+		}
+
+		Status = XZDma_MemcpyAddChan(&Engine, &ZDma[Index],
+				(UINTPTR)DscrMem[Index],
+				XZDMA_MEMCPY_DSCR_MEM_SIZE);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	return (Engine.NumChans != 0U) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function measures the CPU copy functions.
+*
+* @param	Size is the size of one copy.
+* @param	Iter is the number of copies.
+* @param	UseXil selects Xil_MemCpy() instead of memcpy().
+*
+* @return	The bandwidth in MB/s.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 RunCpu(u32 Size, u32 Iter, u32 UseXil)
+{
+	XTime Start;
+	XTime End;
+	u32 Index;
+	u32 Offset;
+
+	XTime_GetTime(&Start);
+	for (Index = 0U; Index < Iter; Index++) {
+		Offset = (Index * Size) % BENCH_BUF_SIZE;
+		if (UseXil != FALSE) {
+			Xil_MemCpy(DstBuf + Offset, SrcBuf + Offset, Size);
+		}
+		else {
+			(void)memcpy(DstBuf + Offset, SrcBuf + Offset, Size);
+		}
+	}
+	XTime_GetTime(&End);
+
+	return Rate((u64)Size * Iter, End - Start);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function measures the memcpy engine. Requests are submitted in
+* batches alternating between the two halves of the request array, so one
+* batch is queued while the previous one is still in flight. A half is only
+* refilled once all of its requests have completed. The copied
+* regions are verified afterwards.
+*
+* @param	Size is the size of one copy.
+* @param	Iter is the number of copies.
+* @param	CpuThreshold is the CPU copy threshold of the engine.
+* @param	RatePtr returns the bandwidth in MB/s.
+*
+* @return
+*		- XST_SUCCESS if all copies completed and were verified.
+*		- XST_FAILURE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static int RunEngine(u32 Size, u32 Iter, u32 CpuThreshold, u32 *RatePtr)
+{
+	XZDma_MemcpyReq *Batch;
+	XTime Start;
+	XTime End;
+	u32 HalfCnt[2] = {0U, 0U};
+	u32 Submitted = 0U;
+	u32 Half = 0U;
+	u32 Count;
+	u32 Index;
+	u32 Offset;
+	u32 Span;
+	int Status;
+
+	(void)memset(DstBuf, 0, BENCH_BUF_SIZE);
+	Xil_DCacheFlushRange((INTPTR)DstBuf, BENCH_BUF_SIZE);
+	XZDma_MemcpySetThreshold(&Engine, CpuThreshold,
+					XZDMA_MEMCPY_CHUNK_SIZE);
+	DoneCnt = 0U;
+	HalfDone[0] = 0U;
+	HalfDone[1] = 0U;
+	ErrCnt = 0U;
+
+	XTime_GetTime(&Start);
+	while (Submitted < Iter) {
+		Count = Iter - Submitted;
+		if (Count > BENCH_BATCH) {
+			Count = BENCH_BATCH;
+		}
+
+		/* The half being refilled must have completed */
+		while (HalfDone[Half] != HalfCnt[Half]) {
+			(void)XZDma_MemcpyPoll(&Engine);
+		}
+
+		Batch = &Req[Half * BENCH_BATCH];
+		for (Index = 0U; Index < Count; Index++) {
+			Offset = ((Submitted + Index) * Size) % BENCH_BUF_SIZE;
+			Batch[Index].SrcAddr = (UINTPTR)(SrcBuf + Offset);
+			Batch[Index].DstAddr = (UINTPTR)(DstBuf + Offset);
+			Batch[Index].Size = Size;
+			Batch[Index].Handler = CopyDone;
+			Batch[Index].CallBackRef = (void *)&HalfDone[Half];
+		}
+		HalfDone[Half] = 0U;
+		HalfCnt[Half] = Count;
+		Submitted += Count;
+		Status = XZDma_MemcpyAsync(&Engine, Batch, Count);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Half ^= 1U;
+	}
+	while (XZDma_MemcpyIsIdle(&Engine) == FALSE) {
+		(void)XZDma_MemcpyPoll(&Engine);
+	}
+	XTime_GetTime(&End);
+
+	if ((DoneCnt != Iter) || (ErrCnt != 0U)) {
+		return XST_FAILURE;
+	}
+
+	Span = (Iter * Size < BENCH_BUF_SIZE) ? (Iter * Size) : BENCH_BUF_SIZE;
+	if (memcmp(SrcBuf, DstBuf, Span) != 0) {
+		return XST_FAILURE;
+	}
+
+	*RatePtr = Rate((u64)Size * Iter, End - Start);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function converts a byte count and a global timer interval to MB/s.
+*
+* @param	Bytes is the number of bytes copied.
+* @param	Ticks is the elapsed time in global timer counts.
+*
+* @return	The bandwidth in MB/s.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 Rate(u64 Bytes, XTime Ticks)
+{
+	if (Ticks == 0U) {
+		Ticks = 1U;
+	}
+
+	return (u32)((Bytes * COUNTS_PER_SECOND) / ((u64)Ticks * 0x100000U));
+}
+
+/*****************************************************************************/
+/**
+* This static function is the completion handler of all requests.
+*
+* @param	CallBackRef is the completion counter of the request's half.
+* @param	Status is the completion status of the request.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void CopyDone(void *CallBackRef, s32 Status)
+{
+	(*(volatile u32 *)CallBackRef)++;
+	if (Status != XST_SUCCESS) {
+		ErrCnt++;
+	}
+	DoneCnt++;
+}
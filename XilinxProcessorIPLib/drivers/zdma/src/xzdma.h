@@ -72,6 +72,19 @@
 * functions by using XZDma_SetCallBack API. In this version Descriptor done
 * option is disabled.
 *
+* <b> Memcpy engine </b>
+*
+* XZDma_MemcpyInitialize() and XZDma_MemcpyAddChan() group any number of
+* initialized GDMA and ADMA channels into one copy service. Copy requests
+* submitted through XZDma_MemcpyAsync() are queued. Whenever a channel is
+* idle, the queue head is packed into one linked list descriptor chain of up
+* to XZDMA_MEMCPY_MAX_BATCH descriptors. Large requests are split into chunks
+* so that all channels work on them in parallel. The request callbacks of a
+* whole chain are invoked from its single DMA done interrupt, serviced by
+* XZDma_MemcpyIntrHandler(), or from XZDma_MemcpyPoll() when interrupts are
+* not used. Requests below the CPU
+* threshold are copied with memcpy() before XZDma_MemcpyAsync() returns.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -130,6 +143,8 @@
 *			 errors in the driver(CR#1006353).
 *		19/07/18 Fixed cppcheck warning in the driver.
 * 1.6   aru     08/18/18 Resolved MISRA-C mandatory violations.
+* 1.6   agt     10/17/26 Added asynchronous scatter gather memcpy engine
+*                        (XZDma_Memcpy*) in xzdma_memcpy.c.
 * </pre>
 *
 ******************************************************************************/
@@ -150,6 +165,17 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/** @name Memcpy engine limits and defaults
+ * @{
+ */
+#define XZDMA_MEMCPY_MAX_CHAN		16U	/**< GDMA + ADMA channels */
+#define XZDMA_MEMCPY_MAX_BATCH		16U	/**< Descriptors per chain */
+#define XZDMA_MEMCPY_DSCR_MEM_SIZE	(XZDMA_MEMCPY_MAX_BATCH * 64U)
+					/**< Descriptor memory per channel
+					  *  for a full linked list chain */
+#define XZDMA_MEMCPY_CPU_THRESHOLD	512U	/**< Default CPU copy size */
+#define XZDMA_MEMCPY_CHUNK_SIZE		0x40000U/**< Default bytes per chain */
+/*@}*/
 
 /**************************** Type Definitions *******************************/
 
@@ -366,6 +392,78 @@ typedef struct {
 				  *  this transfer only for SG mode */
 } XZDma_Transfer;
 
+/******************************************************************************/
+/**
+* Callback type for completion of a memcpy engine request.
+*
+* @param	CallBackRef is the reference given in the request.
+* @param	Status is XST_SUCCESS, or XST_FAILURE when one of the
+*		descriptors of the request ended with an AXI error.
+*******************************************************************************/
+typedef void (*XZDma_MemcpyHandler) (void *CallBackRef, s32 Status);
+
+/******************************************************************************/
+/**
+*
+* This typedef contains a copy request of the memcpy engine. The memory is
+* owned by the caller and must stay valid until the handler has been called.
+*/
+typedef struct XZDma_MemcpyReq {
+	UINTPTR DstAddr;		/**< Destination address */
+	UINTPTR SrcAddr;		/**< Source address */
+	u32 Size;			/**< Bytes to be copied */
+	XZDma_MemcpyHandler Handler;	/**< Completion callback, may be
+					  *  NULL */
+	void *CallBackRef;		/**< Passed to the handler */
+
+	struct XZDma_MemcpyReq *Next;	/**< Queue link, driver private */
+	u32 Offset;			/**< Bytes handed to channels */
+	u32 Outstanding;		/**< Chunks in flight */
+	s32 Status;			/**< Accumulated status */
+} XZDma_MemcpyReq;
+
+/******************************************************************************/
+/**
+*
+* This typedef contains the state of one channel of the memcpy engine.
+*/
+typedef struct {
+	XZDma *InstancePtr;		/**< Initialized ZDMA channel */
+	void *EnginePtr;		/**< Owning XZDma_Memcpy */
+	u32 MaxBatch;			/**< Descriptors in the chain memory */
+	u32 Busy;			/**< A chain is in flight */
+	u32 BatchCnt;			/**< Descriptors of the current chain */
+	u32 Deferred;			/**< Interrupts reported while the
+					  *  engine was locked */
+	XZDma_MemcpyReq *Req[XZDMA_MEMCPY_MAX_BATCH];
+					/**< Request of each descriptor */
+	XZDma_Transfer Data[XZDMA_MEMCPY_MAX_BATCH];
+					/**< Descriptor payload */
+} XZDma_MemcpyChan;
+
+/******************************************************************************/
+/**
+*
+* The memcpy engine instance data structure.
+*/
+typedef struct {
+	XZDma_MemcpyChan Chan[XZDMA_MEMCPY_MAX_CHAN];	/**< Channel pool */
+	u32 NumChans;			/**< Channels added to the pool */
+	u32 NextChan;			/**< Next channel to be tried */
+	XZDma_MemcpyReq *Head;		/**< Oldest not fully handed out
+					  *  request */
+	XZDma_MemcpyReq *Tail;		/**< Newest queued request */
+	u32 CpuThreshold;		/**< Requests below are CPU copied */
+	u32 ChunkSize;			/**< Bytes per chain and chunk */
+	u32 LockDepth;			/**< Nesting of XZDma_MemcpyLock */
+	u32 IsReady;			/**< Engine is initialized */
+
+	u64 DmaBytes;			/**< Bytes copied by the channels */
+	u64 CpuBytes;			/**< Bytes copied by the CPU */
+	u32 ChainCnt;			/**< Descriptor chains started */
+	u32 DscrCnt;			/**< Descriptors started */
+} XZDma_Memcpy;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /*****************************************************************************/
@@ -703,6 +801,17 @@ void XZDma_IntrHandler(void *Instance);
 s32 XZDma_SetCallBack(XZDma *InstancePtr, XZDma_Handler HandlerType,
 	void *CallBackFunc, void *CallBackRef);
 
+void XZDma_MemcpyInitialize(XZDma_Memcpy *EnginePtr);
+s32 XZDma_MemcpyAddChan(XZDma_Memcpy *EnginePtr, XZDma *InstancePtr,
+				UINTPTR Dscr_MemPtr, u32 NoOfBytes);
+void XZDma_MemcpySetThreshold(XZDma_Memcpy *EnginePtr, u32 CpuThreshold,
+				u32 ChunkSize);
+s32 XZDma_MemcpyAsync(XZDma_Memcpy *EnginePtr, XZDma_MemcpyReq *ReqPtr,
+				u32 Num);
+u32 XZDma_MemcpyPoll(XZDma_Memcpy *EnginePtr);
+void XZDma_MemcpyIntrHandler(void *Instance);
+u32 XZDma_MemcpyIsIdle(XZDma_Memcpy *EnginePtr);
+
 /*@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,742 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xzdma_memcpy.c
+* @addtogroup zdma_v1_6
+* @{
+*
+* This file contains the asynchronous scatter gather memcpy engine of the
+* ZDMA driver. The engine owns a pool of ZDMA channels, queues copy requests
+* and coalesces them into linked list descriptor chains. Please see xzdma.h
+* for more details of the driver.
+*
+* All queue updates are made with the interrupts of the pool channels masked
+* in the core, so XZDma_MemcpyAsync() may be called both from task context
+* and from a request callback. The mask is read back before the queue is
+* touched, and an interrupt the GIC delivered before the mask took effect
+* finds the engine locked and leaves the chain to the lock owner, which
+* retires it when it drops the lock. The interrupt of each channel has to be
+* connected to XZDma_MemcpyIntrHandler() by the application. Unlike
+* XZDma_IntrHandler(), it clears the status of a chain before the channel is
+* restarted with the next one, so no completion of the new chain is lost.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- ------------------------------------------------------
+* 1.6   agt     10/17/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xzdma.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XZDMA_MEMCPY_AXI_ERR_MASK	(XZDMA_IXR_AXI_WR_DATA_MASK | \
+					XZDMA_IXR_AXI_RD_DATA_MASK | \
+					XZDMA_IXR_AXI_RD_DST_DSCR_MASK | \
+					XZDMA_IXR_AXI_RD_SRC_DSCR_MASK)
+#define XZDMA_MEMCPY_INTR_MASK		(XZDMA_IXR_DMA_DONE_MASK | \
+					XZDMA_MEMCPY_AXI_ERR_MASK)
+
+/************************** Function Prototypes ******************************/
+
+static void XZDma_MemcpyLock(XZDma_Memcpy *EnginePtr);
+static void XZDma_MemcpyUnlock(XZDma_Memcpy *EnginePtr);
+static void XZDma_MemcpyDispatch(XZDma_Memcpy *EnginePtr);
+static void XZDma_MemcpyFill(XZDma_Memcpy *EnginePtr,
+				XZDma_MemcpyChan *ChanPtr);
+static u32 XZDma_MemcpyService(XZDma_MemcpyChan *ChanPtr);
+static void XZDma_MemcpyComplete(XZDma_MemcpyChan *ChanPtr, s32 Status);
+static void XZDma_MemcpyDoneHandler(void *CallBackRef);
+static void XZDma_MemcpyErrorHandler(void *CallBackRef, u32 Mask);
+
+/************************** Function Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* This function initializes a memcpy engine with an empty channel pool, the
+* default CPU copy threshold XZDMA_MEMCPY_CPU_THRESHOLD and the default chunk
+* size XZDMA_MEMCPY_CHUNK_SIZE.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XZDma_MemcpyInitialize(XZDma_Memcpy *EnginePtr)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(EnginePtr != NULL);
+
+	(void)memset(EnginePtr, 0, sizeof(XZDma_Memcpy));
+	EnginePtr->CpuThreshold = XZDMA_MEMCPY_CPU_THRESHOLD;
+	EnginePtr->ChunkSize = XZDMA_MEMCPY_CHUNK_SIZE;
+	EnginePtr->IsReady = (u32)(XIL_COMPONENT_IS_READY);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a ZDMA channel to the pool of the memcpy engine. The
+* channel is switched to linked list scatter gather mode and its done and
+* error callbacks are taken over by the engine. Its interrupt has to be
+* connected to XZDma_MemcpyIntrHandler() with InstancePtr as the callback
+* reference.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+* @param	InstancePtr is a pointer to an initialized XZDma instance.
+* @param	Dscr_MemPtr is the descriptor memory of the channel. It should
+*		be aligned to 64 bytes.
+* @param	NoOfBytes is the size of the descriptor memory. Each descriptor
+*		of a chain needs 64 bytes, XZDMA_MEMCPY_DSCR_MEM_SIZE allows
+*		chains of XZDMA_MEMCPY_MAX_BATCH descriptors.
+*
+* @return
+*		- XST_SUCCESS if the channel was added.
+*		- XST_FAILURE if the channel is not idle or the pool is full.
+*		- XST_INVALID_PARAM if the descriptor memory is too small.
+*
+* @note		Data and descriptor AXI attributes of the channel are left as
+*		configured by the application. Channels must be added before
+*		the first request is submitted.
+*
+******************************************************************************/
+s32 XZDma_MemcpyAddChan(XZDma_Memcpy *EnginePtr, XZDma *InstancePtr,
+				UINTPTR Dscr_MemPtr, u32 NoOfBytes)
+{
+	XZDma_MemcpyChan *ChanPtr;
+	u32 Count;
+	s32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady ==
+				(u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid(Dscr_MemPtr != 0x00U);
+
+	if (EnginePtr->NumChans >= XZDMA_MEMCPY_MAX_CHAN) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+	if ((NoOfBytes >> 1) < sizeof(XZDma_LlDscr)) {
+		Status = XST_INVALID_PARAM;
+		goto End;
+	}
+
+	Status = XZDma_SetMode(InstancePtr, TRUE, XZDMA_NORMAL_MODE);
+	if (Status != XST_SUCCESS) {
+		goto End;
+	}
+	Count = XZDma_CreateBDList(InstancePtr, XZDMA_LINKEDLIST,
+					Dscr_MemPtr, NoOfBytes);
+
+	ChanPtr = &EnginePtr->Chan[EnginePtr->NumChans];
+	(void)memset(ChanPtr, 0, sizeof(XZDma_MemcpyChan));
+	ChanPtr->InstancePtr = InstancePtr;
+	ChanPtr->EnginePtr = EnginePtr;
+	ChanPtr->MaxBatch = (Count < XZDMA_MEMCPY_MAX_BATCH) ?
+				Count : XZDMA_MEMCPY_MAX_BATCH;
+
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_DONE,
+			(void *)XZDma_MemcpyDoneHandler, ChanPtr);
+	(void)XZDma_SetCallBack(InstancePtr, XZDMA_HANDLER_ERROR,
+			(void *)XZDma_MemcpyErrorHandler, ChanPtr);
+	InstancePtr->IntrMask = XZDMA_MEMCPY_INTR_MASK;
+
+	EnginePtr->NumChans++;
+	Status = XST_SUCCESS;
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function sets the size thresholds of the memcpy engine.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+* @param	CpuThreshold is the request size below which the CPU copies
+*		the data instead of a channel. 0 sends every request to DMA.
+* @param	ChunkSize is the maximum number of bytes of one descriptor
+*		chain. Larger requests are split into chunks of this size,
+*		which are then copied by several channels in parallel.
+*
+* @return	None.
+*
+* @note		A small chunk size spreads single large copies over more
+*		channels at the cost of more interrupts.
+*
+******************************************************************************/
+void XZDma_MemcpySetThreshold(XZDma_Memcpy *EnginePtr, u32 CpuThreshold,
+				u32 ChunkSize)
+{
+	/* Verify arguments */
+	Xil_AssertVoid(EnginePtr != NULL);
+	Xil_AssertVoid(ChunkSize != 0x00U);
+	Xil_AssertVoid(ChunkSize <= XZDMA_WORD2_SIZE_MASK);
+
+	XZDma_MemcpyLock(EnginePtr);
+	EnginePtr->CpuThreshold = CpuThreshold;
+	EnginePtr->ChunkSize = ChunkSize;
+	XZDma_MemcpyUnlock(EnginePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function submits an array of copy requests to the memcpy engine.
+* Requests of at least the CPU threshold are queued and handed to all idle
+* channels right away. The remaining ones are then copied by the CPU while
+* the channels are busy, and their handlers are called before this function
+* returns.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+* @param	ReqPtr is a pointer to an array of requests. DstAddr, SrcAddr,
+*		Size, Handler and CallBackRef have to be filled in. The
+*		requests must not be modified until their handler is called.
+* @param	Num is the number of requests in the array.
+*
+* @return
+*		- XST_SUCCESS if all requests were accepted.
+*		- XST_FAILURE if a DMA request was given to an engine without
+*		  channels. Nothing has been submitted in that case.
+*
+* @note		Handlers of DMA requests run in the context of
+*		XZDma_MemcpyIntrHandler() or XZDma_MemcpyPoll().
+*
+******************************************************************************/
+s32 XZDma_MemcpyAsync(XZDma_Memcpy *EnginePtr, XZDma_MemcpyReq *ReqPtr,
+				u32 Num)
+{
+	XZDma_MemcpyReq *Req;
+	u32 Index;
+	u32 DmaCnt = 0U;
+	s32 Status = XST_SUCCESS;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+	Xil_AssertNonvoid(ReqPtr != NULL);
+	Xil_AssertNonvoid(Num != 0x00U);
+
+	for (Index = 0U; Index < Num; Index++) {
+		if ((ReqPtr[Index].Size != 0U) &&
+			(ReqPtr[Index].Size >= EnginePtr->CpuThreshold)) {
+			Xil_AssertNonvoid(ReqPtr[Index].SrcAddr != 0x00U);
+			Xil_AssertNonvoid(ReqPtr[Index].DstAddr != 0x00U);
+			DmaCnt++;
+		}
+	}
+	if ((DmaCnt != 0U) && (EnginePtr->NumChans == 0U)) {
+		Status = XST_FAILURE;
+		goto End;
+	}
+
+	if (DmaCnt != 0U) {
+		XZDma_MemcpyLock(EnginePtr);
+		for (Index = 0U; Index < Num; Index++) {
+			Req = &ReqPtr[Index];
+			if ((Req->Size == 0U) ||
+				(Req->Size < EnginePtr->CpuThreshold)) {
+				continue;
+			}
+			Req->Next = NULL;
+			Req->Offset = 0U;
+			Req->Outstanding = 0U;
+			Req->Status = XST_SUCCESS;
+			if (EnginePtr->Tail != NULL) {
+				EnginePtr->Tail->Next = Req;
+			}
+			else {
+				EnginePtr->Head = Req;
+			}
+			EnginePtr->Tail = Req;
+		}
+		XZDma_MemcpyDispatch(EnginePtr);
+		XZDma_MemcpyUnlock(EnginePtr);
+	}
+
+	/* Small copies overlap with the chains just started */
+	for (Index = 0U; Index < Num; Index++) {
+		Req = &ReqPtr[Index];
+		if ((Req->Size != 0U) &&
+			(Req->Size >= EnginePtr->CpuThreshold)) {
+			continue;
+		}
+		(void)memcpy((void *)Req->DstAddr, (const void *)Req->SrcAddr,
+				Req->Size);
+		EnginePtr->CpuBytes += Req->Size;
+		if (Req->Handler != NULL) {
+			Req->Handler(Req->CallBackRef, XST_SUCCESS);
+		}
+	}
+
+End:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function completes the descriptor chains of all channels which have
+* finished, for systems where the channel interrupts are not connected. The
+* request handlers are called from here and the freed channels are handed
+* the next queued requests.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	The number of descriptor chains completed by this call.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XZDma_MemcpyPoll(XZDma_Memcpy *EnginePtr)
+{
+	u32 Index;
+	u32 Count = 0U;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(EnginePtr != NULL);
+	Xil_AssertNonvoid(EnginePtr->IsReady == (u32)(XIL_COMPONENT_IS_READY));
+
+	XZDma_MemcpyLock(EnginePtr);
+	for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+		Count += XZDma_MemcpyService(&EnginePtr->Chan[Index]);
+	}
+	XZDma_MemcpyUnlock(EnginePtr);
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function is the interrupt handler of a pool channel. It retires the
+* descriptor chain of the channel, calls the request handlers and hands the
+* channel the next queued requests.
+*
+* @param	Instance is a pointer to the XZDma instance of the channel, as
+*		passed to XZDma_MemcpyAddChan().
+*
+* @return	None.
+*
+* @note		Connect this handler instead of XZDma_IntrHandler(), which
+*		clears the status it read only after the callbacks returned
+*		and so can drop the completion of a chain they started.
+*
+******************************************************************************/
+void XZDma_MemcpyIntrHandler(void *Instance)
+{
+	XZDma *InstancePtr = (XZDma *)((void *)Instance);
+	XZDma_MemcpyChan *ChanPtr;
+
+	/* Verify arguments */
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	ChanPtr = (XZDma_MemcpyChan *)InstancePtr->DoneRef;
+	if (((XZDma_Memcpy *)ChanPtr->EnginePtr)->LockDepth != 0U) {
+		/*
+		 * Raised before the lock masked the channel. The status stays
+		 * latched and XZDma_MemcpyUnlock() unmasks the channel again,
+		 * masking it here keeps the level interrupt from refiring.
+		 */
+		XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+			XZDMA_CH_IDS_OFFSET, XZDMA_IXR_ALL_INTR_MASK);
+		return;
+	}
+	(void)XZDma_MemcpyService(ChanPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This function tells whether the memcpy engine has no queued and no in
+* flight requests.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	TRUE if the engine is idle, FALSE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XZDma_MemcpyIsIdle(XZDma_Memcpy *EnginePtr)
+{
+	u32 Index;
+	u32 Idle;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(EnginePtr != NULL);
+
+	XZDma_MemcpyLock(EnginePtr);
+	Idle = (EnginePtr->Head == NULL) ? (u32)TRUE : (u32)FALSE;
+	for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+		if (EnginePtr->Chan[Index].Busy != FALSE) {
+			Idle = FALSE;
+		}
+	}
+	XZDma_MemcpyUnlock(EnginePtr);
+
+	return Idle;
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function masks the interrupts of all pool channels. The
+* interrupt mask of every instance is cleared as well, so that chains started
+* while the lock is held do not unmask their channel through XZDma_Start().
+* The interrupt mask register is read back, so the disable writes have
+* reached the channels before the queue is changed.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		Calls may be nested, only the outermost one masks. An
+*		interrupt already pending at the GIC may still be taken, the
+*		interrupt handlers check LockDepth and back off.
+*
+******************************************************************************/
+static void XZDma_MemcpyLock(XZDma_Memcpy *EnginePtr)
+{
+	UINTPTR BaseAddress;
+	u32 Index;
+
+	EnginePtr->LockDepth++;
+	if (EnginePtr->LockDepth == 1U) {
+		for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+			EnginePtr->Chan[Index].InstancePtr->IntrMask = 0U;
+			XZDma_WriteReg(EnginePtr->Chan[Index].InstancePtr->
+				Config.BaseAddress, XZDMA_CH_IDS_OFFSET,
+				XZDMA_IXR_ALL_INTR_MASK);
+		}
+		for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+			BaseAddress = EnginePtr->Chan[Index].InstancePtr->
+					Config.BaseAddress;
+			(void)XZDma_ReadReg(BaseAddress, XZDMA_CH_IMR_OFFSET);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function undoes XZDma_MemcpyLock() and unmasks the interrupts
+* of the channels with a chain in flight. Completions which happened while
+* the lock was held stay latched and are serviced right after. Completions
+* XZDma_IntrHandler() reported and cleared while the lock was held are
+* retired here.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_MemcpyUnlock(XZDma_Memcpy *EnginePtr)
+{
+	XZDma *InstancePtr;
+	u32 Index;
+
+	EnginePtr->LockDepth--;
+	if (EnginePtr->LockDepth == 0U) {
+		for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+			if (EnginePtr->Chan[Index].Deferred != 0U) {
+				(void)XZDma_MemcpyService(
+					&EnginePtr->Chan[Index]);
+			}
+		}
+		for (Index = 0U; Index < EnginePtr->NumChans; Index++) {
+			InstancePtr = EnginePtr->Chan[Index].InstancePtr;
+			InstancePtr->IntrMask = XZDMA_MEMCPY_INTR_MASK;
+			if (EnginePtr->Chan[Index].Busy != FALSE) {
+				XZDma_WriteReg(InstancePtr->Config.BaseAddress,
+					XZDMA_CH_IEN_OFFSET,
+					XZDMA_MEMCPY_INTR_MASK);
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function hands queued requests to the idle channels, one
+* descriptor chain per channel, starting with the channel after the one that
+* was served last.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+*
+* @return	None.
+*
+* @note		Called with the engine locked.
+*
+******************************************************************************/
+static void XZDma_MemcpyDispatch(XZDma_Memcpy *EnginePtr)
+{
+	XZDma_MemcpyChan *ChanPtr;
+	u32 Tried = 0U;
+
+	while ((EnginePtr->Head != NULL) && (Tried < EnginePtr->NumChans)) {
+		ChanPtr = &EnginePtr->Chan[EnginePtr->NextChan];
+		EnginePtr->NextChan++;
+		if (EnginePtr->NextChan == EnginePtr->NumChans) {
+			EnginePtr->NextChan = 0U;
+		}
+		Tried++;
+
+		if (ChanPtr->Busy != FALSE) {
+			continue;
+		}
+		XZDma_MemcpyFill(EnginePtr, ChanPtr);
+		ChanPtr->Busy = TRUE;
+		EnginePtr->ChainCnt++;
+		EnginePtr->DscrCnt += ChanPtr->BatchCnt;
+		(void)XZDma_Start(ChanPtr->InstancePtr, ChanPtr->Data,
+					ChanPtr->BatchCnt);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function packs the head of the queue into the descriptor
+* payload of a channel. It stops at the chunk size or at the descriptor
+* limit of the channel, whichever comes first. Requests are only unlinked
+* from the queue once their last byte has been packed.
+*
+* @param	EnginePtr is a pointer to the XZDma_Memcpy instance.
+* @param	ChanPtr is a pointer to the idle channel to be filled.
+*
+* @return	None.
+*
+* @note		Called with the engine locked and a non empty queue.
+*
+******************************************************************************/
+static void XZDma_MemcpyFill(XZDma_Memcpy *EnginePtr,
+				XZDma_MemcpyChan *ChanPtr)
+{
+	XZDma_MemcpyReq *Req;
+	XZDma_Transfer *Data;
+	u32 Bytes = 0U;
+	u32 Len;
+
+	ChanPtr->BatchCnt = 0U;
+	while ((EnginePtr->Head != NULL) &&
+		(ChanPtr->BatchCnt < ChanPtr->MaxBatch) &&
+		(Bytes < EnginePtr->ChunkSize)) {
+		Req = EnginePtr->Head;
+		Len = Req->Size - Req->Offset;
+		if (Len > (EnginePtr->ChunkSize - Bytes)) {
+			Len = EnginePtr->ChunkSize - Bytes;
+		}
+
+		Data = &ChanPtr->Data[ChanPtr->BatchCnt];
+		Data->SrcAddr = Req->SrcAddr + Req->Offset;
+		Data->DstAddr = Req->DstAddr + Req->Offset;
+		Data->Size = Len;
+		Data->SrcCoherent = 0U;
+		Data->DstCoherent = 0U;
+		Data->Pause = 0U;
+		ChanPtr->Req[ChanPtr->BatchCnt] = Req;
+		ChanPtr->BatchCnt++;
+
+		if (!ChanPtr->InstancePtr->Config.IsCacheCoherent) {
+			Xil_DCacheFlushRange((INTPTR)Data->SrcAddr, Len);
+			Xil_DCacheFlushRange((INTPTR)Data->DstAddr, Len);
+		}
+
+		Bytes += Len;
+		Req->Offset += Len;
+		Req->Outstanding++;
+		if (Req->Offset == Req->Size) {
+			EnginePtr->Head = Req->Next;
+			if (EnginePtr->Head == NULL) {
+				EnginePtr->Tail = NULL;
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function retires the descriptor chain of a channel if it has
+* finished. The done and error status is cleared first, because retiring
+* the chain restarts the channel with the next one.
+*
+* @param	ChanPtr is a pointer to the channel.
+*
+* @return	1 if a chain was retired, 0 otherwise.
+*
+* @note		Called with the engine locked or from the channel interrupt.
+*
+******************************************************************************/
+static u32 XZDma_MemcpyService(XZDma_MemcpyChan *ChanPtr)
+{
+	u32 Pending;
+
+	if (ChanPtr->Busy == FALSE) {
+		return 0U;
+	}
+	Pending = (XZDma_IntrGetStatus(ChanPtr->InstancePtr) |
+			ChanPtr->Deferred) & XZDMA_MEMCPY_INTR_MASK;
+	ChanPtr->Deferred = 0U;
+	if (Pending == 0U) {
+		return 0U;
+	}
+	XZDma_IntrClear(ChanPtr->InstancePtr, Pending);
+	ChanPtr->InstancePtr->ChannelState = XZDMA_IDLE;
+	XZDma_MemcpyComplete(ChanPtr,
+		((Pending & XZDMA_MEMCPY_AXI_ERR_MASK) != 0U) ?
+		(s32)XST_FAILURE : (s32)XST_SUCCESS);
+
+	return 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function retires the descriptor chain of a channel. Handlers
+* are called for the requests whose last chunk was part of the chain, then
+* the channel is refilled from the queue.
+*
+* @param	ChanPtr is a pointer to the channel that finished.
+* @param	Status is XST_SUCCESS or XST_FAILURE for the whole chain.
+*
+* @return	None.
+*
+* @note		The channel stays busy while the handlers run, so requests
+*		they submit cannot overwrite the chain being retired.
+*
+******************************************************************************/
+static void XZDma_MemcpyComplete(XZDma_MemcpyChan *ChanPtr, s32 Status)
+{
+	XZDma_Memcpy *EnginePtr = (XZDma_Memcpy *)ChanPtr->EnginePtr;
+	XZDma_MemcpyReq *Req;
+	u32 Index;
+
+	for (Index = 0U; Index < ChanPtr->BatchCnt; Index++) {
+		Req = ChanPtr->Req[Index];
+		if (!ChanPtr->InstancePtr->Config.IsCacheCoherent) {
+			Xil_DCacheInvalidateRange(
+				(INTPTR)ChanPtr->Data[Index].DstAddr,
+				ChanPtr->Data[Index].Size);
+		}
+		EnginePtr->DmaBytes += ChanPtr->Data[Index].Size;
+		if (Status != (s32)XST_SUCCESS) {
+			Req->Status = Status;
+		}
+		Req->Outstanding--;
+		if ((Req->Outstanding == 0U) && (Req->Offset == Req->Size) &&
+			(Req->Handler != NULL)) {
+			Req->Handler(Req->CallBackRef, Req->Status);
+		}
+	}
+
+	ChanPtr->BatchCnt = 0U;
+	ChanPtr->Busy = FALSE;
+	XZDma_MemcpyLock(EnginePtr);
+	XZDma_MemcpyDispatch(EnginePtr);
+	XZDma_MemcpyUnlock(EnginePtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function is the done callback of every pool channel, for
+* applications that still connect XZDma_IntrHandler(). The chain is retired
+* as in XZDma_MemcpyIntrHandler(), an AXI error latched together with the
+* done interrupt fails the whole chain.
+*
+* @param	CallBackRef is the XZDma_MemcpyChan of the channel.
+*
+* @return	None.
+*
+* @note		XZDma_IntrHandler() clears the status once this returns, so
+*		a completion reported while the engine is locked is kept in
+*		Deferred for XZDma_MemcpyUnlock().
+*
+******************************************************************************/
+static void XZDma_MemcpyDoneHandler(void *CallBackRef)
+{
+	XZDma_MemcpyChan *ChanPtr = (XZDma_MemcpyChan *)CallBackRef;
+
+	if (((XZDma_Memcpy *)ChanPtr->EnginePtr)->LockDepth != 0U) {
+		ChanPtr->Deferred |= XZDMA_IXR_DMA_DONE_MASK;
+		return;
+	}
+	(void)XZDma_MemcpyService(ChanPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* This static function is the error callback of every pool channel. AXI
+* errors stop the channel, so a chain still in flight is failed here. Errors
+* the done callback retired together with its chain have been cleared, so
+* they do not fail the chain that callback started.
+*
+* @param	CallBackRef is the XZDma_MemcpyChan of the channel.
+* @param	Mask is the pending error interrupts.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XZDma_MemcpyErrorHandler(void *CallBackRef, u32 Mask)
+{
+	XZDma_MemcpyChan *ChanPtr = (XZDma_MemcpyChan *)CallBackRef;
+
+	if ((Mask & XZDMA_MEMCPY_AXI_ERR_MASK) == 0U) {
+		return;
+	}
+	if (((XZDma_Memcpy *)ChanPtr->EnginePtr)->LockDepth != 0U) {
+		ChanPtr->Deferred |= Mask & XZDMA_MEMCPY_AXI_ERR_MASK;
+		return;
+	}
+	(void)XZDma_MemcpyService(ChanPtr);
+}
+/** @} */
@@ -0,0 +1,96 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*
+ * Helpers shared by the host benchmarks: test reporting, a monotonic clock,
+ * the time stamp counter and the cycle estimate of hosts without one. Each
+ * bench is a single program, so the helpers are static.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static int check_failures;
+
+/* Prints the result of a test and counts the failures */
+static inline void check(const char *name, int ok)
+{
+	printf("%-56s %s\n", name, ok ? "ok" : "FAIL");
+	if (!ok) {
+		check_failures++;
+	}
+}
+
+/* Prints the number of failed tests, returns the exit status of the bench */
+static inline int check_status(void)
+{
+	if (check_failures != 0) {
+		printf("%d test(s) failed\n", check_failures);
+		return 1;
+	}
+	return 0;
+}
+
+/* Monotonic time in ns */
+static inline double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Time stamp counter, 0 if the host has none */
+static inline uint64_t now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/*
+ * Cycles of a measurement: the time stamp counter difference, or on hosts
+ * without one the time in ns at the clock of mhz (option -m of the benches),
+ * 0 if that is not given either.
+ */
+static inline uint64_t bench_cycles(uint64_t cycles, double ns, double mhz)
+{
+	if (cycles == 0) {
+		cycles = (uint64_t)(ns * mhz / 1e3);
+	}
+	return cycles;
+}
+
+#endif
@@ -29,6 +29,30 @@
 /** Connection handle for a UDP Server session */
 
 #include "udp_perf_server.h"
+#include "xlwipconfig.h"
+#if defined(XLWIP_CONFIG_INCLUDE_GEM) && defined(XLWIP_CONFIG_EMAC_RX_STATS)
+#include "netif/xemacpsif.h"
+#define EMAC_RX_STATS
+typedef xemacpsif_rx_stats_t emac_rx_stats_t;
+#define emac_get_rx_stats	xemacpsif_get_rx_stats
+#define emac_reset_rx_stats	xemacpsif_reset_rx_stats
+#elif defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_DMA) && \
+	defined(XLWIP_CONFIG_EMAC_RX_STATS)
+#include "netif/xaxiemacif.h"
+#define EMAC_RX_STATS
+typedef xaxiemacif_rx_stats_t emac_rx_stats_t;
+#define emac_get_rx_stats	xaxiemacif_get_rx_stats
+#define emac_reset_rx_stats	xaxiemacif_reset_rx_stats
+#endif
+#ifdef EMAC_RX_STATS
+#ifdef __MICROBLAZE__
+/* no global timer, the adapter counts no ticks */
+#define EMAC_RX_TICKS_PER_SEC	0
+#else
+#include "xtime_l.h"
+#define EMAC_RX_TICKS_PER_SEC	COUNTS_PER_SECOND
+#endif
+#endif
 
 extern struct netif server_netif;
 static struct udp_pcb *pcb;
@@ -84,6 +108,52 @@ static void stats_buffer(char* outString,
 }
 
 
+#ifdef EMAC_RX_STATS
+/* Print the Rx rate seen by the Ethernet adapter since the last report */
+static void emac_rx_stats_report(double duration)
+{
+	emac_rx_stats_t stats;
+	double pps = 0, ticks_per_pkt = 0;
+	char rate[16], cost[64];
+
+	emac_get_rx_stats(&server_netif, &stats);
+	emac_reset_rx_stats(&server_netif);
+
+	if (duration)
+		pps = stats.rx_packets / duration;
+	stats_buffer(rate, pps, SPEED);
+	xil_printf("[%3d] emac rx  %spkts/sec  %u refill failures\n\r",
+			server.client_id, rate, stats.rx_refill_fail);
+	if (stats.rx_poll_wakeups)
+		xil_printf("[%3d] emac rx  %u poll passes  %u wakeups\n\r",
+				server.client_id, stats.rx_poll_passes,
+				stats.rx_poll_wakeups);
+	if (EMAC_RX_TICKS_PER_SEC == 0)
+		return;
+
+	if (stats.rx_packets)
+		ticks_per_pkt = (double)stats.rx_isr_ticks / stats.rx_packets;
+	sprintf(cost, "%.1f ticks/pkt (%.1f ns/pkt)", ticks_per_pkt,
+			(ticks_per_pkt * 1000000000.0) / EMAC_RX_TICKS_PER_SEC);
+	xil_printf("[%3d] emac rx  %s\n\r", server.client_id, cost);
+
+	/* budgeted polling: interrupt to poll latency */
+	if (stats.rx_poll_wakeups) {
+		sprintf(cost, "%.1f ns", ((double)stats.rx_poll_latency_ticks *
+				1000000000.0) / ((double)stats.rx_poll_wakeups *
+				EMAC_RX_TICKS_PER_SEC));
+		xil_printf("[%3d] emac rx  %s avg irq to poll\n\r",
+				server.client_id, cost);
+	}
+
+	/* longest stretch the Rx path kept interrupts disabled */
+	sprintf(cost, "%.1f ns", ((double)stats.rx_lock_max_ticks *
+			1000000000.0) / EMAC_RX_TICKS_PER_SEC);
+	xil_printf("[%3d] emac rx  %s max irq off\n\r",
+			server.client_id, cost);
+}
+#endif
+
 /** The report function of a TCP server session */
 static void udp_conn_report(u64_t diff,
 		enum report_type report_type)
@@ -127,6 +197,10 @@ static void udp_conn_report(u64_t diff,
 			(100.0 * cnt_dropped_datagrams)/total_packets);
 	xil_printf("[%3d] %s  %sBytes  %sbits/sec  %s\n\r", server.client_id,
 			time, data, perf, drop);
+#ifdef EMAC_RX_STATS
+	if (report_type == INTER_REPORT)
+		emac_rx_stats_report(duration);
+#endif
 
 	if (report_type == INTER_REPORT) {
 		server.i_report.last_report_time += duration;
@@ -156,6 +230,9 @@ static void reset_stats(void)
 	server.i_report.cnt_datagrams = 0;
 	server.i_report.cnt_dropped_datagrams = 0;
 	server.i_report.last_report_time = 0;
+#ifdef EMAC_RX_STATS
+	emac_reset_rx_stats(&server_netif);
+#endif
 }
 
 /** Receive data on a udp session */
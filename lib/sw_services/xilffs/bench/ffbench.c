@@ -0,0 +1,483 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffbench.c
+*		Host throughput benchmark of xilffs. ff.c, ffsystem.c and
+*		diskio.c are built for Linux with the RAM interface, the RAM
+*		disk accesses are counted through the RAMFS_TRACE hook of
+*		diskio.c and can be written to a trace file.
+*
+*		Every workload reports host time, the media commands and
+*		sectors it caused, and a modelled device time of
+*		(commands * cmd_us + sectors * sector_us), which is what a
+*		sector cache or fast seek changes on real media.
+*
+*		Usage: ffbench [-s file_mb] [-n dir_entries] [-r rand_ops]
+*		               [-c cmd_us] [-p sector_us] [-t trace.csv]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.0   agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ff.h"
+#include "ffstream.h"
+#include "diskio.h"
+#ifdef FILE_SYSTEM_USE_CACHE
+#include "ffcache.h"
+#endif
+
+#define HIST_BUCKETS	9U	/* Command sizes 1, 2, 4 .. 128, >128 sectors */
+#define SECTOR_SIZE		512U
+#define MAX_BUF			(128U * 1024U)
+
+typedef struct {
+	unsigned long long Cmds[2];		/* Read, write commands */
+	unsigned long long Sectors[2];	/* Read, write sectors */
+	unsigned long long Hist[2][HIST_BUCKETS];
+} BenchCnt;
+
+char *ffbench_ram;
+
+static BenchCnt Cnt;
+static FILE *TraceFile;
+static struct timespec StartTime;
+static double CmdUs = 100.0;		/* Default model: SD card in HS mode */
+static double SectorUs = 20.0;
+static unsigned int FileMb = 32U;
+static unsigned int DirEntries = 10000U;
+static unsigned int RandOps = 4096U;
+static unsigned int Seed = 1U;
+static BYTE Buf[MAX_BUF] __attribute__ ((aligned(64)));
+
+static double ElapsedNs(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)(Now.tv_sec - StartTime.tv_sec) * 1e9) +
+			(double)(Now.tv_nsec - StartTime.tv_nsec);
+}
+
+/*****************************************************************************/
+/**
+*
+* RAMFS_TRACE hook, called by diskio.c for every RAM disk access.
+*
+* @param	IsWrite - 0 for a read, 1 for a write
+* @param	Sector - Start sector
+* @param	Count - Sector count
+*
+******************************************************************************/
+void ffbench_trace(unsigned int IsWrite, unsigned int Sector,
+		unsigned int Count)
+{
+	unsigned int Bucket = 0U;
+
+	while ((Bucket < (HIST_BUCKETS - 1U)) && ((1U << Bucket) < Count)) {
+		Bucket++;
+	}
+
+	Cnt.Cmds[IsWrite]++;
+	Cnt.Sectors[IsWrite] += Count;
+	Cnt.Hist[IsWrite][Bucket]++;
+
+	if (TraceFile != NULL) {
+		fprintf(TraceFile, "%.0f,%c,%u,%u\n", ElapsedNs(),
+				(IsWrite != 0U) ? 'W' : 'R', Sector, Count);
+	}
+}
+
+static unsigned int Rand(void)
+{
+	/* xorshift32, reproducible across hosts */
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+static void Check(FRESULT Res, const char *What)
+{
+	if (Res != FR_OK) {
+		fprintf(stderr, "%s failed: %d\n", What, (int)Res);
+		exit(1);
+	}
+}
+
+static double Begin(void)
+{
+	memset(&Cnt, 0, sizeof(Cnt));
+	return ElapsedNs();
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints one result row.
+*
+* @param	Name - Workload name
+* @param	T0 - Start time returned by Begin
+* @param	Bytes - Payload bytes, 0 for metadata workloads
+* @param	Ops - Operations of metadata workloads
+*
+******************************************************************************/
+static void Report(const char *Name, double T0, unsigned long long Bytes,
+		unsigned long long Ops)
+{
+	double Ns = ElapsedNs() - T0;
+	double ModelMs = (((double)(Cnt.Cmds[0] + Cnt.Cmds[1]) * CmdUs) +
+			((double)(Cnt.Sectors[0] + Cnt.Sectors[1]) * SectorUs)) / 1000.0;
+	char Rate[32];
+
+	if (Bytes != 0U) {
+		snprintf(Rate, sizeof(Rate), "%9.1f MB/s", ((double)Bytes / 1048576.0) /
+				(Ns / 1e9));
+	} else {
+		snprintf(Rate, sizeof(Rate), "%9.0f op/s", (double)Ops / (Ns / 1e9));
+	}
+
+	printf("%-24s %s %9llu %10llu %9llu %10llu %11.1f", Name, Rate,
+			Cnt.Cmds[0], Cnt.Sectors[0], Cnt.Cmds[1], Cnt.Sectors[1],
+			ModelMs);
+	if (Bytes != 0U) {
+		printf(" %9.1f", ((double)Bytes / 1048576.0) / (ModelMs / 1000.0));
+	}
+	printf("\n");
+}
+
+static void SeqWrite(UINT BufSize)
+{
+	FIL File;
+	UINT Done;
+	unsigned long long Total = (unsigned long long)FileMb * 1048576U;
+	unsigned long long Pos;
+	char Name[32];
+	double T0;
+
+	T0 = Begin();
+	Check(f_open(&File, "seq.bin", FA_CREATE_ALWAYS | FA_WRITE), "f_open");
+	for (Pos = 0U; Pos < Total; Pos += BufSize) {
+		Check(f_write(&File, Buf, BufSize, &Done), "f_write");
+	}
+	Check(f_close(&File), "f_close");
+
+	snprintf(Name, sizeof(Name), "seq write %uK", BufSize / 1024U);
+	if (BufSize < 1024U) {
+		snprintf(Name, sizeof(Name), "seq write %u", BufSize);
+	}
+	Report(Name, T0, Total, 0U);
+}
+
+static void SeqRead(UINT BufSize)
+{
+	FIL File;
+	UINT Done;
+	unsigned long long Total = 0U;
+	char Name[32];
+	double T0;
+
+	T0 = Begin();
+	Check(f_open(&File, "seq.bin", FA_READ), "f_open");
+	do {
+		Check(f_read(&File, Buf, BufSize, &Done), "f_read");
+		Total += Done;
+	} while (Done == BufSize);
+	Check(f_close(&File), "f_close");
+
+	snprintf(Name, sizeof(Name), "seq read %uK", BufSize / 1024U);
+	if (BufSize < 1024U) {
+		snprintf(Name, sizeof(Name), "seq read %u", BufSize);
+	}
+	Report(Name, T0, Total, 0U);
+}
+
+static void Rand4K(BYTE IsWrite)
+{
+	FIL File;
+	UINT Done;
+	unsigned int Blocks = (FileMb * 1048576U) / 4096U;
+	unsigned int Op;
+	double T0;
+
+	T0 = Begin();
+	Check(f_open(&File, "seq.bin", (IsWrite != 0U) ?
+			(FA_READ | FA_WRITE) : FA_READ), "f_open");
+	for (Op = 0U; Op < RandOps; Op++) {
+		Check(f_lseek(&File, (FSIZE_t)(Rand() % Blocks) * 4096U), "f_lseek");
+		if (IsWrite != 0U) {
+			Check(f_write(&File, Buf, 4096U, &Done), "f_write");
+		} else {
+			Check(f_read(&File, Buf, 4096U, &Done), "f_read");
+		}
+	}
+	Check(f_close(&File), "f_close");
+
+	Report((IsWrite != 0U) ? "rand write 4K" : "rand read 4K", T0,
+			(unsigned long long)RandOps * 4096U, 0U);
+}
+
+#if FF_USE_FASTSEEK
+static void StreamRand4K(BYTE IsWrite)
+{
+	FIL File;
+	UINT Done;
+	unsigned int Blocks = (FileMb * 1048576U) / 4096U;
+	unsigned int Op;
+	double T0;
+
+	T0 = Begin();
+	Check(f_stream_open(&File, "seq.bin", (IsWrite != 0U) ?
+			(FA_READ | FA_WRITE) : FA_READ), "f_stream_open");
+	for (Op = 0U; Op < RandOps; Op++) {
+		Check(f_stream_lseek(&File, (FSIZE_t)(Rand() % Blocks) * 4096U),
+				"f_stream_lseek");
+		if (IsWrite != 0U) {
+			Check(f_stream_write(&File, Buf, 4096U, &Done), "f_stream_write");
+		} else {
+			Check(f_read(&File, Buf, 4096U, &Done), "f_read");
+		}
+	}
+	Check(f_stream_close(&File), "f_stream_close");
+
+	Report((IsWrite != 0U) ? "stream rand write 4K" : "stream rand read 4K",
+			T0, (unsigned long long)RandOps * 4096U, 0U);
+}
+
+static void StreamWrite(BYTE Expand)
+{
+	FIL File;
+	UINT Done;
+	unsigned long long Total = (unsigned long long)FileMb * 1048576U;
+	unsigned long long Pos;
+	double T0;
+
+	T0 = Begin();
+	Check(f_stream_open(&File, "stream.bin", FA_CREATE_ALWAYS | FA_WRITE),
+			"f_stream_open");
+	if (Expand != 0U) {
+		Check(f_stream_expand(&File, (FSIZE_t)Total), "f_stream_expand");
+	}
+	for (Pos = 0U; Pos < Total; Pos += MAX_BUF) {
+		Check(f_stream_write(&File, Buf, MAX_BUF, &Done), "f_stream_write");
+	}
+	Check(f_stream_close(&File), "f_stream_close");
+	Check(f_unlink("stream.bin"), "f_unlink");
+
+	Report((Expand != 0U) ? "stream write expand" : "stream write 128K", T0,
+			Total, 0U);
+}
+#endif
+
+static void SmallFiles(void)
+{
+	FIL File;
+	UINT Done;
+	unsigned int Index;
+	unsigned int Count = 1000U;
+	char Name[32];
+	double T0;
+
+	Check(f_mkdir("small"), "f_mkdir");
+
+	T0 = Begin();
+	for (Index = 0U; Index < Count; Index++) {
+		snprintf(Name, sizeof(Name), "small/S%07u.DAT", Index);
+		Check(f_open(&File, Name, FA_CREATE_NEW | FA_WRITE), "f_open");
+		Check(f_write(&File, Buf, 1024U, &Done), "f_write");
+		Check(f_close(&File), "f_close");
+	}
+	Report("small file create 1K", T0, 0U, Count);
+
+	T0 = Begin();
+	for (Index = 0U; Index < Count; Index++) {
+		snprintf(Name, sizeof(Name), "small/S%07u.DAT", Index);
+		Check(f_unlink(Name), "f_unlink");
+	}
+	Report("small file delete", T0, 0U, Count);
+}
+
+static void DirList(void)
+{
+	FIL File;
+	DIR Dir;
+	FILINFO Info;
+	unsigned int Index;
+	unsigned int Found = 0U;
+	char Name[32];
+	double T0;
+
+	Check(f_mkdir("big"), "f_mkdir");
+
+	T0 = Begin();
+	for (Index = 0U; Index < DirEntries; Index++) {
+		snprintf(Name, sizeof(Name), "big/E%07u.DAT", Index);
+		Check(f_open(&File, Name, FA_CREATE_NEW | FA_WRITE), "f_open");
+		Check(f_close(&File), "f_close");
+	}
+	Report("dir populate", T0, 0U, DirEntries);
+
+	T0 = Begin();
+	Check(f_opendir(&Dir, "big"), "f_opendir");
+	for (;;) {
+		Check(f_readdir(&Dir, &Info), "f_readdir");
+		if (Info.fname[0] == '\0') {
+			break;
+		}
+		Found++;
+	}
+	Check(f_closedir(&Dir), "f_closedir");
+	Report("dir list", T0, 0U, Found);
+	if (Found != DirEntries) {
+		fprintf(stderr, "dir list found %u of %u entries\n", Found,
+				DirEntries);
+		exit(1);
+	}
+
+	T0 = Begin();
+	for (Index = 0U; Index < 1000U; Index++) {
+		snprintf(Name, sizeof(Name), "big/E%07u.DAT", Rand() % DirEntries);
+		Check(f_stat(Name, &Info), "f_stat");
+	}
+	Report("dir lookup", T0, 0U, 1000U);
+}
+
+int main(int argc, char *argv[])
+{
+	static const UINT BufSizes[] = { 512U, 4096U, 32768U, 131072U };
+	BYTE Work[FF_MAX_SS];
+	FATFS Fs;
+	unsigned int Index;
+	int Opt;
+
+	while ((Opt = getopt(argc, argv, "s:n:r:c:p:t:")) != -1) {
+		switch (Opt) {
+		case 's':
+			FileMb = (unsigned int)atoi(optarg);
+			break;
+		case 'n':
+			DirEntries = (unsigned int)atoi(optarg);
+			break;
+		case 'r':
+			RandOps = (unsigned int)atoi(optarg);
+			break;
+		case 'c':
+			CmdUs = atof(optarg);
+			break;
+		case 'p':
+			SectorUs = atof(optarg);
+			break;
+		case 't':
+			TraceFile = fopen(optarg, "w");
+			if (TraceFile == NULL) {
+				perror(optarg);
+				return 1;
+			}
+			fprintf(TraceFile, "ns,op,sector,count\n");
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-s file_mb] [-n dir_entries] "
+					"[-r rand_ops] [-c cmd_us] [-p sector_us] "
+					"[-t trace.csv]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if ((FileMb == 0U) || (((unsigned long long)FileMb * 1048576U) >
+			(RAMFS_SIZE / 2U))) {
+		fprintf(stderr, "file size must be 1 to %u MB\n",
+				(unsigned int)(RAMFS_SIZE / 2U / 1048576U));
+		return 1;
+	}
+
+	ffbench_ram = malloc(RAMFS_SIZE);
+	if (ffbench_ram == NULL) {
+		perror("malloc");
+		return 1;
+	}
+	for (Index = 0U; Index < MAX_BUF; Index++) {
+		Buf[Index] = (BYTE)Rand();
+	}
+	clock_gettime(CLOCK_MONOTONIC, &StartTime);
+
+#if FF_FS_EXFAT
+	Check(f_mkfs("", FM_EXFAT, 0U, Work, sizeof(Work)), "f_mkfs");
+	printf("exFAT");
+#else
+	Check(f_mkfs("", FM_FAT32, 0U, Work, sizeof(Work)), "f_mkfs");
+	printf("FAT32");
+#endif
+	Check(f_mount(&Fs, "", 1), "f_mount");
+#ifdef FILE_SYSTEM_USE_CACHE
+	printf(", sector cache %ux%u, read-ahead %u",
+			(unsigned int)FILE_SYSTEM_CACHE_SETS,
+			(unsigned int)FILE_SYSTEM_CACHE_WAYS,
+			(unsigned int)FILE_SYSTEM_CACHE_READ_AHEAD);
+#endif
+	printf(", %u byte clusters", (unsigned int)Fs.csize * SECTOR_SIZE);
+	printf(", %u MB RAM disk, model %.0f us/cmd + %.1f us/sector\n\n",
+			(unsigned int)(RAMFS_SIZE / 1048576U), CmdUs, SectorUs);
+	printf("%-24s %14s %9s %10s %9s %10s %11s %9s\n", "workload", "host",
+			"rd cmds", "rd sect", "wr cmds", "wr sect", "model ms",
+			"model MB/s");
+
+	for (Index = 0U; Index < (sizeof(BufSizes) / sizeof(BufSizes[0])); Index++) {
+		SeqWrite(BufSizes[Index]);
+		SeqRead(BufSizes[Index]);
+	}
+	Rand4K(0U);
+	Rand4K(1U);
+#if FF_USE_FASTSEEK
+	StreamRand4K(0U);
+	StreamRand4K(1U);
+	StreamWrite(0U);
+	StreamWrite(1U);
+#endif
+	SmallFiles();
+	DirList();
+
+	Check(f_mount(NULL, "", 0), "f_unmount");
+	if (TraceFile != NULL) {
+		fclose(TraceFile);
+	}
+	free(ffbench_ram);
+
+	return 0;
+}
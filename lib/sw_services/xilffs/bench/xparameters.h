@@ -0,0 +1,72 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xparameters.h
+*		Host configuration of xilffs for the benchmark. The library
+*		options which select the file system variant (exFAT, sector
+*		cache) are passed on the compiler command line by the Makefile.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.0   agt  10/17/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define FILE_SYSTEM_INTERFACE_RAM
+
+#ifndef RAMFS_SIZE
+#define RAMFS_SIZE		(256U * 1024U * 1024U)
+#endif
+
+extern char *ffbench_ram;
+#define RAMFS_START_ADDR	ffbench_ram
+
+void ffbench_trace(unsigned int IsWrite, unsigned int Sector,
+		unsigned int Count);
+#define RAMFS_TRACE(IsWrite, Sector, Count) \
+		ffbench_trace((IsWrite), (Sector), (Count))
+
+#define FILE_SYSTEM_USE_MKFS
+#define FILE_SYSTEM_NUM_LOGIC_VOL	1
+#define FILE_SYSTEM_USE_STRFUNC		0
+#define FILE_SYSTEM_SET_FS_RPATH	0
+#define FILE_SYSTEM_WORD_ACCESS
+#define FILE_SYSTEM_USE_FASTSEEK
+#define FILE_SYSTEM_STREAMS		4U
+#define FILE_SYSTEM_STREAM_FRAGMENTS	32U
+
+#endif
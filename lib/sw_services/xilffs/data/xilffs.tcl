@@ -32,6 +32,9 @@
 # ----- ----  -------  -----------------------------------------------
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
+# 4.0   agt   10/17/26 Generate sector cache settings
+#       agt   10/17/26 Generate reentrancy setting for FreeRTOS
+#       agt   10/17/26 Generate fast seek stream settings
 #
 ##############################################################################
 
@@ -115,6 +118,10 @@ proc xgen_opts_file {libhandle} {
 	set use_strfunc [common::get_property CONFIG.use_strfunc $libhandle]
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
+	set enable_cache [common::get_property CONFIG.enable_cache $libhandle]
+	set enable_reentrant [common::get_property CONFIG.enable_reentrant $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
+	set os_type [hsi::get_os]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -197,6 +204,45 @@ proc xgen_opts_file {libhandle} {
 		if {$proc_type != "microblaze" && $word_access == true} {
 			puts $file_handle "\#define FILE_SYSTEM_WORD_ACCESS"
 		}
+
+		if {$enable_reentrant == true} {
+			if {$os_type == "freertos10_xilinx"} {
+				puts $file_handle "\#define FILE_SYSTEM_REENTRANT"
+			} else {
+				puts "WARNING : enable_reentrant needs FreeRTOS, \
+						building xilffs without reentrancy\n"
+			}
+		}
+
+		if {$enable_cache == true} {
+			set cache_sets [common::get_property CONFIG.cache_sets $libhandle]
+			set cache_ways [common::get_property CONFIG.cache_ways $libhandle]
+			set cache_read_ahead [common::get_property CONFIG.cache_read_ahead $libhandle]
+			if {$cache_sets < 1 || $cache_ways < 1} {
+				puts "WARNING : Invalid sector cache geometry, setting \
+						back to 16 sets of 4 ways\n"
+				set cache_sets 16
+				set cache_ways 4
+			}
+			puts $file_handle "\#define FILE_SYSTEM_USE_CACHE"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_SETS ${cache_sets}U"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_WAYS ${cache_ways}U"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_READ_AHEAD ${cache_read_ahead}U"
+		}
+
+		if {$use_fastseek == true} {
+			set stream_pool_size [common::get_property CONFIG.stream_pool_size $libhandle]
+			set stream_fragments [common::get_property CONFIG.stream_fragments $libhandle]
+			if {$stream_pool_size < 1 || $stream_fragments < 1} {
+				puts "WARNING : Invalid fast seek stream settings, setting \
+						back to 4 streams of 32 fragments\n"
+				set stream_pool_size 4
+				set stream_fragments 32
+			}
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+			puts $file_handle "\#define FILE_SYSTEM_STREAMS ${stream_pool_size}U"
+			puts $file_handle "\#define FILE_SYSTEM_STREAM_FRAGMENTS ${stream_fragments}U"
+		}
 	} else {
 		error  "ERROR: Invalid interface selected \n"
 	}
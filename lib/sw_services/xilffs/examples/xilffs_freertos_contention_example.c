@@ -0,0 +1,317 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xilffs_freertos_contention_example.c
+*
+*
+* @note This example measures concurrent writes of several FreeRTOS tasks to
+* the SD volumes. Each writer task writes its own file on volume
+* (task number % number of volumes). The writers run twice:
+*  - with one application mutex around every file system call, which is how
+*    the library had to be used before it was reentrant, and
+*  - with only the per-volume and per-drive locks of the library.
+* The aggregate throughput of both runs is printed, with two SD controllers
+* the second run writes both cards in parallel.
+*
+* To test this example the library has to be built with enable_reentrant
+* set, File System should not be in Read Only mode and USE_MKFS option should
+* be true. The volumes are formatted by the example.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.0   agt 10/17/26 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"	/* SDK generated parameters */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+#include "ff.h"
+
+/************************** Constant Definitions *****************************/
+
+#ifdef XPAR_XSDPS_1_DEVICE_ID
+#define NUM_VOLUMES		2U
+#else
+#define NUM_VOLUMES		1U
+#endif
+
+#define NUM_WRITERS		4U
+#define FILE_SIZE		(4U * 1024U * 1024U)
+#define CHUNK_SIZE		(16U * 1024U)
+#define WRITER_STACK	1024U
+#define WRITER_PRIORITY	(tskIDLE_PRIORITY + 1U)
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 Index;			/* Writer number */
+	u32 UseGlobalLock;	/* Serialize every call with GlobalLock */
+	s32 Status;			/* XST_SUCCESS once the file is written */
+} WriterArgs;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static void MainTask(void *Param);
+static void WriterTask(void *Param);
+static int RunWriters(u32 UseGlobalLock);
+
+/************************** Variable Definitions *****************************/
+static FATFS FatFs[NUM_VOLUMES];
+static FIL Files[NUM_WRITERS];
+static WriterArgs Args[NUM_WRITERS];
+static const char *Volumes[2] = { "0:/", "1:/" };
+static SemaphoreHandle_t GlobalLock;
+static SemaphoreHandle_t DoneSem;
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+static u8 WriteBuffer[CHUNK_SIZE];
+#pragma data_alignment = 4
+#else
+static u8 WriteBuffer[CHUNK_SIZE] __attribute__ ((aligned(32)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function which starts the scheduler with the task running the test.
+*
+* @param	None
+*
+* @return	XST_FAILURE if the scheduler could not be started.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	xil_printf("FreeRTOS File System Contention Example Test \r\n");
+
+	(void)xTaskCreate(MainTask, "main", WRITER_STACK, NULL,
+			WRITER_PRIORITY + 1U, NULL);
+	vTaskStartScheduler();
+
+	/* Only reached if there was not enough heap for the idle task */
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Formats and mounts the volumes, then runs the writers with and without the
+* application mutex.
+*
+* @param	Param is unused.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void MainTask(void *Param)
+{
+	BYTE Work[FF_MAX_SS];
+	FRESULT Res;
+	u32 Index;
+	int Status = XST_FAILURE;
+
+	(void)Param;
+
+	for (Index = 0U; Index < CHUNK_SIZE; Index++) {
+		WriteBuffer[Index] = (u8)Index;
+	}
+
+	GlobalLock = xSemaphoreCreateMutex();
+	DoneSem = xSemaphoreCreateCounting(NUM_WRITERS, 0U);
+	if ((GlobalLock == NULL) || (DoneSem == NULL)) {
+		goto Done;
+	}
+
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		Res = f_mount(&FatFs[Index], Volumes[Index], 0U);
+		if (Res != FR_OK) {
+			goto Done;
+		}
+		Res = f_mkfs(Volumes[Index], FM_FAT32, 0U, Work, sizeof(Work));
+		if (Res != FR_OK) {
+			goto Done;
+		}
+	}
+
+	if (RunWriters(1U) != XST_SUCCESS) {
+		goto Done;
+	}
+	if (RunWriters(0U) != XST_SUCCESS) {
+		goto Done;
+	}
+
+	Status = XST_SUCCESS;
+
+Done:
+	if (Status != XST_SUCCESS) {
+		xil_printf("FreeRTOS File System Contention Example Test failed \r\n");
+	} else {
+		xil_printf("Successfully ran FreeRTOS File System Contention Example Test \r\n");
+	}
+	vTaskDelete(NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts NUM_WRITERS writer tasks, waits for all of them and prints the
+* aggregate throughput.
+*
+* @param	UseGlobalLock is 1 to serialize all file system calls with one
+*		application mutex, 0 to rely on the library locks.
+*
+* @return	XST_SUCCESS if all writers succeeded, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int RunWriters(u32 UseGlobalLock)
+{
+	TickType_t Start;
+	TickType_t Ticks;
+	u32 Index;
+	u32 KBps;
+
+	Start = xTaskGetTickCount();
+
+	for (Index = 0U; Index < NUM_WRITERS; Index++) {
+		Args[Index].Index = Index;
+		Args[Index].UseGlobalLock = UseGlobalLock;
+		Args[Index].Status = XST_FAILURE;
+		if (xTaskCreate(WriterTask, "writer", WRITER_STACK, &Args[Index],
+				WRITER_PRIORITY, NULL) != pdPASS) {
+			return XST_FAILURE;
+		}
+	}
+
+	for (Index = 0U; Index < NUM_WRITERS; Index++) {
+		(void)xSemaphoreTake(DoneSem, portMAX_DELAY);
+	}
+
+	Ticks = xTaskGetTickCount() - Start;
+	if (Ticks == 0U) {
+		Ticks = 1U;
+	}
+	KBps = (u32)(((u64)NUM_WRITERS * FILE_SIZE / 1024U) *
+			configTICK_RATE_HZ / Ticks);
+
+	xil_printf("%s: %d writers on %d volume(s), %d ms, %d KB/s\r\n",
+			(UseGlobalLock != 0U) ? "global lock" : "volume locks",
+			(int)NUM_WRITERS, (int)NUM_VOLUMES,
+			(int)(Ticks * portTICK_PERIOD_MS), (int)KBps);
+
+	for (Index = 0U; Index < NUM_WRITERS; Index++) {
+		if (Args[Index].Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writer task. Writes FILE_SIZE bytes in CHUNK_SIZE pieces to its own file.
+*
+* @param	Param is a pointer to the WriterArgs of the task.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void WriterTask(void *Param)
+{
+	WriterArgs *ArgPtr = (WriterArgs *)Param;
+	FIL *FilePtr = &Files[ArgPtr->Index];
+	char Name[16] = "0:/W0.BIN";
+	UINT Written;
+	FRESULT Res;
+	u32 Offset;
+
+	Name[0] = Volumes[ArgPtr->Index % NUM_VOLUMES][0];
+	Name[4] = (char)('0' + ArgPtr->Index);
+
+	if (ArgPtr->UseGlobalLock != 0U) {
+		(void)xSemaphoreTake(GlobalLock, portMAX_DELAY);
+	}
+	Res = f_open(FilePtr, Name, FA_CREATE_ALWAYS | FA_WRITE);
+	if (ArgPtr->UseGlobalLock != 0U) {
+		(void)xSemaphoreGive(GlobalLock);
+	}
+
+	for (Offset = 0U; (Res == FR_OK) && (Offset < FILE_SIZE);
+			Offset += CHUNK_SIZE) {
+		if (ArgPtr->UseGlobalLock != 0U) {
+			(void)xSemaphoreTake(GlobalLock, portMAX_DELAY);
+		}
+		Res = f_write(FilePtr, WriteBuffer, CHUNK_SIZE, &Written);
+		if (ArgPtr->UseGlobalLock != 0U) {
+			(void)xSemaphoreGive(GlobalLock);
+		}
+		if ((Res == FR_OK) && (Written != CHUNK_SIZE)) {
+			Res = FR_DENIED;
+		}
+	}
+
+	if (ArgPtr->UseGlobalLock != 0U) {
+		(void)xSemaphoreTake(GlobalLock, portMAX_DELAY);
+	}
+	if (f_close(FilePtr) != FR_OK) {
+		Res = FR_DISK_ERR;
+	}
+	if (ArgPtr->UseGlobalLock != 0U) {
+		(void)xSemaphoreGive(GlobalLock);
+	}
+
+	if (Res == FR_OK) {
+		ArgPtr->Status = XST_SUCCESS;
+	}
+	(void)xSemaphoreGive(DoneSem);
+	vTaskDelete(NULL);
+}
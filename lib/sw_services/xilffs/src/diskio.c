@@ -53,6 +53,9 @@
 *		write files using ADMA2 in polled mode.
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
+*		If "enable_cache" is set in SDK, disk_read and disk_write go
+*		through the sector cache in ffcache.c and CTRL_SYNC writes
+*		the dirty sectors to the media.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -83,6 +86,14 @@
 *       mn   12/04/17 Resolve errors in XilFFS for ARMCC compiler
 * 3.9   mn   04/18/18 Resolve build warnings for xilffs library
 *       mn   07/06/18 Fix Cppcheck and Doxygen warnings
+* 4.0   agt  10/17/26 Added optional sector cache (ffcache.c) between
+*                     FatFs and the media backends.
+*       agt  10/17/26 Added RAMFS_TRACE hook to the RAM backend for the
+*                     host benchmark in ../bench.
+*       agt  10/17/26 Controller settings are kept per drive and every
+*                     drive access is locked when the library is built
+*                     reentrant, so volumes on different drives are
+*                     accessed in parallel.
 *
 * </pre>
 *
@@ -98,6 +109,9 @@
 #endif
 #include "sleep.h"
 #include "xil_printf.h"
+#ifdef FILE_SYSTEM_USE_CACHE
+#include "ffcache.h"
+#endif
 
 #define HIGH_SPEED_SUPPORT	0x01U
 #define WIDTH_4_BIT_SUPPORT	0x4U
@@ -118,6 +132,11 @@ static char *dataramfs = NULL;
 #define BLOCKSIZE       1U
 #define SECTORSIZE      512U
 #define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
+
+/* Called for every RAM disk access, defined by the host benchmark */
+#ifndef RAMFS_TRACE
+#define RAMFS_TRACE(IsWrite, Sector, Count)
+#endif
 #endif
 
 /*--------------------------------------------------------------------------
@@ -133,13 +152,26 @@ static DSTATUS Stat[2] = {STA_NOINIT, STA_NOINIT};	/* Disk status */
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 static XSdPs SdInstance[2];
-static u32 BaseAddress;
-static u32 CardDetect;
-static u32 WriteProtect;
+static u32 BaseAddress[2];
+static u32 CardDetect[2];
+static u32 WriteProtect[2];
 static u32 SlotType[2];
 static u8 HostCntrlrVer[2];
 #endif
 
+#if FF_FS_REENTRANT
+#define DISK_LOCK(pdrv)		ff_disk_lock(pdrv)
+#define DISK_UNLOCK(pdrv)	ff_disk_unlock(pdrv)
+#else
+#define DISK_LOCK(pdrv)		1
+#define DISK_UNLOCK(pdrv)
+#endif
+
+static DSTATUS media_initialize(BYTE pdrv);
+static DRESULT media_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+static DRESULT media_write(BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count);
+
 /*-----------------------------------------------------------------------*/
 /* Get Disk Status							*/
 /*-----------------------------------------------------------------------*/
@@ -166,37 +198,45 @@ DSTATUS disk_status (
 		BYTE pdrv	/* Drive number (0) */
 )
 {
-	DSTATUS s = Stat[pdrv];
+	DSTATUS s;
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	u32 StatusReg;
 	u32 DelayCount = 0;
+#endif
+
+	if (DISK_LOCK(pdrv) == 0) {
+		return STA_NOINIT;
+	}
+	s = Stat[pdrv];
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
 
 		if (SdInstance[pdrv].Config.BaseAddress == (u32)0) {
 #ifdef XPAR_XSDPS_1_DEVICE_ID
 				if(pdrv == 1) {
-						BaseAddress = XPAR_XSDPS_1_BASEADDR;
-						CardDetect = XPAR_XSDPS_1_HAS_CD;
-						WriteProtect = XPAR_XSDPS_1_HAS_WP;
+						BaseAddress[pdrv] = XPAR_XSDPS_1_BASEADDR;
+						CardDetect[pdrv] = XPAR_XSDPS_1_HAS_CD;
+						WriteProtect[pdrv] = XPAR_XSDPS_1_HAS_WP;
 				} else {
 #endif
-						BaseAddress = XPAR_XSDPS_0_BASEADDR;
-						CardDetect = XPAR_XSDPS_0_HAS_CD;
-						WriteProtect = XPAR_XSDPS_0_HAS_WP;
+						BaseAddress[pdrv] = XPAR_XSDPS_0_BASEADDR;
+						CardDetect[pdrv] = XPAR_XSDPS_0_HAS_CD;
+						WriteProtect[pdrv] = XPAR_XSDPS_0_HAS_WP;
 #ifdef XPAR_XSDPS_1_DEVICE_ID
 				}
 #endif
-				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress,
+				HostCntrlrVer[pdrv] = (u8)(XSdPs_ReadReg16(BaseAddress[pdrv],
 						XSDPS_HOST_CTRL_VER_OFFSET) & XSDPS_HC_SPEC_VER_MASK);
 				if (HostCntrlrVer[pdrv] == XSDPS_HC_SPEC_V3) {
-					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress,
+					SlotType[pdrv] = XSdPs_ReadReg(BaseAddress[pdrv],
 							XSDPS_CAPS_OFFSET) & XSDPS_CAPS_SLOT_TYPE_MASK;
 				} else {
 					SlotType[pdrv] = 0;
 				}
 		}
-		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+		StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 		if (SlotType[pdrv] != XSDPS_CAPS_EMB_SLOT) {
-			if (CardDetect) {
+			if (CardDetect[pdrv]) {
 				while ((StatusReg & XSDPS_PSR_CARD_INSRT_MASK) == 0U) {
 					if (DelayCount == 500U) {
 						s = STA_NODISK | STA_NOINIT;
@@ -205,12 +245,12 @@ DSTATUS disk_status (
 						/* Wait for 10 msec */
 						usleep(SD_CD_DELAY);
 						DelayCount++;
-						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress);
+						StatusReg = XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]);
 					}
 				}
 			}
 			s &= ~STA_NODISK;
-			if (WriteProtect) {
+			if (WriteProtect[pdrv]) {
 					if ((StatusReg & XSDPS_PSR_WPS_PL_MASK) == 0U){
 						s |= STA_PROTECT;
 						goto Label;
@@ -226,6 +266,7 @@ Label:
 		Stat[pdrv] = s;
 #endif
 
+		DISK_UNLOCK(pdrv);
 		return s;
 }
 
@@ -254,6 +295,34 @@ Label:
 DSTATUS disk_initialize (
 		BYTE pdrv	/* Physical drive number (0) */
 )
+{
+	DSTATUS s;
+
+	if (DISK_LOCK(pdrv) == 0) {
+		return STA_NOINIT;
+	}
+	s = media_initialize(pdrv);
+	DISK_UNLOCK(pdrv);
+
+	return s;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the host controller and the card of the drive, see
+* disk_initialize.
+*
+* @param	pdrv - Drive number
+*
+* @return	Status of the drive
+*
+* @note		Called by disk_initialize with the drive locked.
+*
+******************************************************************************/
+static DSTATUS media_initialize (
+		BYTE pdrv
+)
 {
 	DSTATUS s;
 #ifdef FILE_SYSTEM_INTERFACE_SD
@@ -272,7 +341,7 @@ DSTATUS disk_initialize (
 	}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-	if (CardDetect) {
+	if (CardDetect[pdrv]) {
 			/*
 			 * Card detection check
 			 * If the HC detects the No Card State, power will be cleared
@@ -280,7 +349,7 @@ DSTATUS disk_initialize (
 			while(!((XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK) ==
-					( XSdPs_GetPresentStatusReg((u32)BaseAddress) &
+					( XSdPs_GetPresentStatusReg((u32)BaseAddress[pdrv]) &
 					(XSDPS_PSR_CARD_DPL_MASK |
 					XSDPS_PSR_CARD_STABLE_MASK |
 					XSDPS_PSR_CARD_INSRT_MASK))));
@@ -316,6 +385,10 @@ DSTATUS disk_initialize (
 	s &= (~STA_NOINIT);
 
 	Stat[pdrv] = s;
+#ifdef FILE_SYSTEM_USE_CACHE
+	ff_cache_init(pdrv, media_read, media_write,
+			(DWORD)SdInstance[pdrv].SectorCount);
+#endif
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
@@ -325,6 +398,9 @@ DSTATUS disk_initialize (
 	/* Clearing No init Status for RAM */
 	s &= (~STA_NOINIT);
 	Stat[pdrv] = s;
+#ifdef FILE_SYSTEM_USE_CACHE
+	ff_cache_init(pdrv, media_read, media_write, (DWORD)SECTORCNT);
+#endif
 #endif
 
 	return s;
@@ -361,10 +437,7 @@ DRESULT disk_read (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status;
-	DWORD LocSector = sector;
-#endif
+	DRESULT res;
 
 	s = disk_status(pdrv);
 
@@ -375,7 +448,47 @@ DRESULT disk_read (
 		return RES_PARERR;
 	}
 
+	if (DISK_LOCK(pdrv) == 0) {
+		return RES_NOTRDY;
+	}
+#ifdef FILE_SYSTEM_USE_CACHE
+	res = ff_cache_read(pdrv, buff, sector, count);
+#else
+	res = media_read(pdrv, buff, sector, count);
+#endif
+	DISK_UNLOCK(pdrv);
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors from the media of the drive.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Read successful
+*		RES_ERROR	Read not successful
+*
+* @note		Called by disk_read or by the sector cache.
+*
+******************************************************************************/
+static DRESULT media_read (
+		BYTE pdrv,
+		BYTE *buff,
+		DWORD sector,
+		UINT count
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -388,10 +501,12 @@ DRESULT disk_read (
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	(void)pdrv;
+	RAMFS_TRACE(0U, sector, count);
 	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
 #endif
 
-    return RES_OK;
+	return RES_OK;
 }
 
 /*-----------------------------------------------------------------------*/
@@ -415,7 +530,16 @@ DRESULT disk_ioctl (
 	res = RES_ERROR;
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef FILE_SYSTEM_USE_CACHE
+			if (DISK_LOCK(pdrv) == 0) {
+				res = RES_NOTRDY;
+				break;
+			}
+			res = ff_cache_sync(pdrv);
+			DISK_UNLOCK(pdrv);
+#else
 			res = RES_OK;
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -437,6 +561,14 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+#ifdef FILE_SYSTEM_USE_CACHE
+		if (DISK_LOCK(pdrv) == 0) {
+			res = RES_NOTRDY;
+			break;
+		}
+		res = ff_cache_sync(pdrv);
+		DISK_UNLOCK(pdrv);
+#endif
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
 		*(WORD *)buff = BLOCKSIZE;
@@ -504,10 +636,7 @@ DRESULT disk_write (
 )
 {
 	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
-	s32 Status;
-	DWORD LocSector = sector;
-#endif
+	DRESULT res;
 
 	s = disk_status(pdrv);
 	if ((s & STA_NOINIT) != 0U) {
@@ -517,7 +646,47 @@ DRESULT disk_write (
 		return RES_PARERR;
 	}
 
+	if (DISK_LOCK(pdrv) == 0) {
+		return RES_NOTRDY;
+	}
+#ifdef FILE_SYSTEM_USE_CACHE
+	res = ff_cache_write(pdrv, buff, sector, count);
+#else
+	res = media_write(pdrv, buff, sector, count);
+#endif
+	DISK_UNLOCK(pdrv);
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the media of the drive.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write successful
+*		RES_ERROR	Write not successful
+*
+* @note		Called by disk_write or by the sector cache.
+*
+******************************************************************************/
+static DRESULT media_write (
+	BYTE pdrv,
+	const BYTE *buff,
+	DWORD sector,
+	UINT count
+)
+{
 #ifdef FILE_SYSTEM_INTERFACE_SD
+	s32 Status;
+	DWORD LocSector = sector;
+
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
@@ -527,10 +696,11 @@ DRESULT disk_write (
 	if (Status != XST_SUCCESS) {
 		return RES_ERROR;
 	}
-
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	(void)pdrv;
+	RAMFS_TRACE(1U, sector, count);
 	memcpy(dataramfs + (sector * SECTORSIZE), buff, count * SECTORSIZE);
 #endif
 
@@ -0,0 +1,541 @@
+/*-----------------------------------------------------------------------*/
+/* Sector cache between FatFs and the media backends                     */
+/*-----------------------------------------------------------------------*/
+
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffcache.c
+*		Set associative write-back sector cache used by diskio.c when
+*		"enable_cache" is set for the library.
+*
+*		Description:
+*		Each drive has FILE_SYSTEM_CACHE_SETS sets of
+*		FILE_SYSTEM_CACHE_WAYS sectors, a sector is cached in set
+*		(sector % FILE_SYSTEM_CACHE_SETS) so FAT and directory
+*		sectors and runs of file data spread over all sets.
+*		A read miss of a request which continues the previous read
+*		fetches FILE_SYSTEM_CACHE_READ_AHEAD sectors with one media
+*		command. Writes only update the cache; dirty sectors are
+*		written when they are replaced or on CTRL_SYNC, together with
+*		the dirty sectors adjacent to them as one multi-block write.
+*		Requests larger than FF_CACHE_BURST sectors go directly to
+*		the media and keep the cached copies coherent.
+*		The cache only depends on the media functions passed to
+*		ff_cache_init, so it can be built on a host against the RAM
+*		backend or a stub.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.0   agt  10/17/26 First release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include <string.h>
+#include "ffcache.h"
+
+#ifdef FILE_SYSTEM_USE_CACHE
+
+#define CL_VALID	0x01U	/* Line holds a sector */
+#define CL_DIRTY	0x02U	/* Line is newer than the media */
+
+#define NO_LINE		(-1)
+
+typedef struct {
+	BYTE	data[FF_CACHE_LINES][FF_CACHE_SS];	/* Cached sectors, line = set * ways + way */
+	BYTE	fetch[FF_CACHE_BURST * FF_CACHE_SS];	/* Read-ahead buffer */
+	BYTE	flush[FF_CACHE_BURST * FF_CACHE_SS];	/* Write-back buffer */
+	DWORD	sect[FF_CACHE_LINES];	/* Sector held by each line */
+	DWORD	age[FF_CACHE_LINES];	/* Last access stamp of each line */
+	BYTE	flag[FF_CACHE_LINES];	/* CL_VALID and CL_DIRTY of each line */
+	DWORD	clock;					/* Access stamp counter */
+	DWORD	next;					/* Sector following the last read */
+	DWORD	nsect;					/* Sector count of the media, 0 if unknown */
+	FF_CACHE_READ	rd;				/* Media read function */
+	FF_CACHE_WRITE	wr;				/* Media write function */
+	FF_CACHE_STATS	stats;
+} FF_CACHE;
+
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+static FF_CACHE Cache[FF_CACHE_DRIVES];
+#pragma data_alignment = 4
+#else
+static FF_CACHE Cache[FF_CACHE_DRIVES] __attribute__ ((aligned(64)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Looks up the line holding a sector.
+*
+* @param	c - Cache of the drive
+* @param	sector - Sector number
+*
+* @return	Line index, NO_LINE if the sector is not cached
+*
+******************************************************************************/
+static int find_line (
+	const FF_CACHE* c,
+	DWORD sector
+)
+{
+	UINT base = (UINT)(sector % FILE_SYSTEM_CACHE_SETS) * FILE_SYSTEM_CACHE_WAYS;
+	UINT way;
+
+	for (way = 0U; way < FILE_SYSTEM_CACHE_WAYS; way++) {
+		if (((c->flag[base + way] & CL_VALID) != 0U) &&
+				(c->sect[base + way] == sector)) {
+			return (int)(base + way);
+		}
+	}
+
+	return NO_LINE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks whether a sector is cached and dirty.
+*
+* @param	c - Cache of the drive
+* @param	sector - Sector number
+*
+* @return	Line index, NO_LINE if the sector is not cached or clean
+*
+******************************************************************************/
+static int find_dirty (
+	const FF_CACHE* c,
+	DWORD sector
+)
+{
+	int line = find_line(c, sector);
+
+	if ((line != NO_LINE) && ((c->flag[line] & CL_DIRTY) == 0U)) {
+		line = NO_LINE;
+	}
+
+	return line;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the run of dirty sectors containing a line with one media command.
+* The run extends from the line in both directions up to FF_CACHE_BURST
+* sectors.
+*
+* @param	pdrv - Drive number
+* @param	c - Cache of the drive
+* @param	line - Dirty line
+*
+* @return	RES_OK or the result of the media write
+*
+******************************************************************************/
+static DRESULT flush_run (
+	BYTE pdrv,
+	FF_CACHE* c,
+	int line
+)
+{
+	DWORD start = c->sect[line];
+	DRESULT res;
+	UINT n;
+	int l;
+
+	while ((start > 0U) && ((c->sect[line] - start) < (FF_CACHE_BURST - 1U)) &&
+			(find_dirty(c, start - 1U) != NO_LINE)) {
+		start--;
+	}
+
+	for (n = 0U; n < FF_CACHE_BURST; n++) {
+		l = find_dirty(c, start + n);
+		if (l == NO_LINE) {
+			break;
+		}
+		memcpy(&c->flush[n * FF_CACHE_SS], c->data[l], FF_CACHE_SS);
+	}
+
+	res = c->wr(pdrv, c->flush, start, n);
+	c->stats.media_writes++;
+	if (res != RES_OK) {
+		return res;
+	}
+
+	c->stats.written_back += n;
+	while (n > 0U) {
+		n--;
+		l = find_line(c, start + n);
+		c->flag[l] &= (BYTE)~CL_DIRTY;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Assigns a line to a sector which is not cached. An invalid way of the set
+* is used if there is one, otherwise the least recently used way, after
+* writing it to the media if it is dirty.
+*
+* @param	pdrv - Drive number
+* @param	c - Cache of the drive
+* @param	sector - Sector number
+* @param	res - Result of the write back in case of failure
+*
+* @return	Line index, NO_LINE if the replaced line could not be written
+*
+******************************************************************************/
+static int alloc_line (
+	BYTE pdrv,
+	FF_CACHE* c,
+	DWORD sector,
+	DRESULT* res
+)
+{
+	UINT base = (UINT)(sector % FILE_SYSTEM_CACHE_SETS) * FILE_SYSTEM_CACHE_WAYS;
+	UINT way;
+	int line = (int)base;
+
+	for (way = 0U; way < FILE_SYSTEM_CACHE_WAYS; way++) {
+		if ((c->flag[base + way] & CL_VALID) == 0U) {
+			line = (int)(base + way);
+			break;
+		}
+		if ((DWORD)(c->clock - c->age[base + way]) >
+				(DWORD)(c->clock - c->age[line])) {
+			line = (int)(base + way);
+		}
+	}
+
+	if ((c->flag[line] & CL_DIRTY) != 0U) {
+		*res = flush_run(pdrv, c, line);
+		if (*res != RES_OK) {
+			return NO_LINE;
+		}
+	}
+
+	c->sect[line] = sector;
+	c->flag[line] = CL_VALID;
+	c->age[line] = ++c->clock;
+
+	return line;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets up the cache of a drive. Any cached sector is dropped.
+*
+* @param	pdrv - Drive number
+* @param	rd - Media read function
+* @param	wr - Media write function
+* @param	nsect - Sector count of the media, read-ahead does not go
+*		beyond it. 0 if unknown.
+*
+* @return	None
+*
+******************************************************************************/
+void ff_cache_init (
+	BYTE pdrv,
+	FF_CACHE_READ rd,
+	FF_CACHE_WRITE wr,
+	DWORD nsect
+)
+{
+	FF_CACHE* c = &Cache[pdrv];
+
+	memset(c->sect, 0, sizeof(c->sect));
+	memset(c->age, 0, sizeof(c->age));
+	memset(c->flag, 0, sizeof(c->flag));
+	memset(&c->stats, 0, sizeof(c->stats));
+	c->clock = 0U;
+	c->next = 0xFFFFFFFFU;
+	c->nsect = nsect;
+	c->rd = rd;
+	c->wr = wr;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads sectors through the cache.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Read successful
+*		RES_PARERR	Invalid drive
+*		RES_ERROR	Media read or write back not successful
+*
+******************************************************************************/
+DRESULT ff_cache_read (
+	BYTE pdrv,
+	BYTE* buff,
+	DWORD sector,
+	UINT count
+)
+{
+	FF_CACHE* c;
+	DRESULT res;
+	DWORD s;
+	UINT fetch;
+	UINT i = 0U;
+	UINT k;
+	UINT n;
+	int l;
+	BYTE seq;
+
+	if (pdrv >= FF_CACHE_DRIVES) {
+		return RES_PARERR;
+	}
+	c = &Cache[pdrv];
+
+	if (count > FF_CACHE_BURST) {
+		/* Large read, take the data from the media and newer data from the cache */
+		res = c->rd(pdrv, buff, sector, count);
+		c->stats.media_reads++;
+		if (res != RES_OK) {
+			return res;
+		}
+		c->stats.read_misses += count;
+		for (i = 0U; i < count; i++) {
+			l = find_dirty(c, sector + i);
+			if (l != NO_LINE) {
+				memcpy(&buff[i * FF_CACHE_SS], c->data[l], FF_CACHE_SS);
+			}
+		}
+		c->next = sector + count;
+		return RES_OK;
+	}
+
+	seq = (sector == c->next) ? 1U : 0U;
+
+	while (i < count) {
+		s = sector + i;
+		l = find_line(c, s);
+		if (l != NO_LINE) {
+			memcpy(&buff[i * FF_CACHE_SS], c->data[l], FF_CACHE_SS);
+			c->age[l] = ++c->clock;
+			c->stats.read_hits++;
+			i++;
+			continue;
+		}
+
+		/* Missing run of the request, extended ahead for a sequential stream */
+		n = 1U;
+		while (((i + n) < count) && (find_line(c, s + n) == NO_LINE)) {
+			n++;
+		}
+		fetch = n;
+		if ((seq != 0U) && (fetch < FILE_SYSTEM_CACHE_READ_AHEAD)) {
+			fetch = FILE_SYSTEM_CACHE_READ_AHEAD;
+		}
+		if ((c->nsect != 0U) && ((s + fetch) > c->nsect)) {
+			fetch = ((s + n) < c->nsect) ? (UINT)(c->nsect - s) : n;
+		}
+
+		res = c->rd(pdrv, c->fetch, s, fetch);
+		c->stats.media_reads++;
+		if (res != RES_OK) {
+			return res;
+		}
+		c->stats.read_misses += n;
+		c->stats.read_ahead += fetch - n;
+		memcpy(&buff[i * FF_CACHE_SS], c->fetch, n * FF_CACHE_SS);
+
+		for (k = 0U; k < fetch; k++) {
+			/* Sectors ahead which are cached may be newer than the media */
+			if ((k >= n) && (find_line(c, s + k) != NO_LINE)) {
+				continue;
+			}
+			l = alloc_line(pdrv, c, s + k, &res);
+			if (l == NO_LINE) {
+				return res;
+			}
+			memcpy(c->data[l], &c->fetch[k * FF_CACHE_SS], FF_CACHE_SS);
+		}
+		i += n;
+	}
+
+	c->next = sector + count;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes sectors to the cache. Requests larger than FF_CACHE_BURST sectors
+* are written to the media directly.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write successful
+*		RES_PARERR	Invalid drive
+*		RES_ERROR	Media write or write back not successful
+*
+******************************************************************************/
+DRESULT ff_cache_write (
+	BYTE pdrv,
+	const BYTE* buff,
+	DWORD sector,
+	UINT count
+)
+{
+	FF_CACHE* c;
+	DRESULT res = RES_OK;
+	UINT i;
+	int l;
+
+	if (pdrv >= FF_CACHE_DRIVES) {
+		return RES_PARERR;
+	}
+	c = &Cache[pdrv];
+
+	if (count > FF_CACHE_BURST) {
+		res = c->wr(pdrv, buff, sector, count);
+		c->stats.media_writes++;
+		if (res != RES_OK) {
+			return res;
+		}
+		/* Cached copies are now the same as the media */
+		for (i = 0U; i < count; i++) {
+			l = find_line(c, sector + i);
+			if (l != NO_LINE) {
+				memcpy(c->data[l], &buff[i * FF_CACHE_SS], FF_CACHE_SS);
+				c->flag[l] &= (BYTE)~CL_DIRTY;
+			}
+		}
+		return RES_OK;
+	}
+
+	for (i = 0U; i < count; i++) {
+		l = find_line(c, sector + i);
+		if (l == NO_LINE) {
+			l = alloc_line(pdrv, c, sector + i, &res);
+			if (l == NO_LINE) {
+				return res;
+			}
+		} else {
+			c->age[l] = ++c->clock;
+		}
+		memcpy(c->data[l], &buff[i * FF_CACHE_SS], FF_CACHE_SS);
+		c->flag[l] |= CL_DIRTY;
+		c->stats.write_hits++;
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes all dirty sectors of a drive to the media in ascending sector order,
+* adjacent dirty sectors with one command.
+*
+* @param	pdrv - Drive number
+*
+* @return
+*		RES_OK		All dirty sectors written
+*		RES_PARERR	Invalid drive
+*		RES_ERROR	Media write not successful
+*
+******************************************************************************/
+DRESULT ff_cache_sync (
+	BYTE pdrv
+)
+{
+	FF_CACHE* c;
+	DRESULT res;
+	UINT i;
+	int l;
+
+	if (pdrv >= FF_CACHE_DRIVES) {
+		return RES_PARERR;
+	}
+	c = &Cache[pdrv];
+
+	for (;;) {
+		l = NO_LINE;
+		for (i = 0U; i < FF_CACHE_LINES; i++) {
+			if (((c->flag[i] & CL_DIRTY) != 0U) &&
+					((l == NO_LINE) || (c->sect[i] < c->sect[l]))) {
+				l = (int)i;
+			}
+		}
+		if (l == NO_LINE) {
+			break;
+		}
+		res = flush_run(pdrv, c, l);
+		if (res != RES_OK) {
+			return res;
+		}
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies the cache counters of a drive.
+*
+* @param	pdrv - Drive number
+* @param	stats - Pointer to the structure to contain the counters
+*
+* @return	None
+*
+******************************************************************************/
+void ff_cache_stats (
+	BYTE pdrv,
+	FF_CACHE_STATS* stats
+)
+{
+	if (pdrv < FF_CACHE_DRIVES) {
+		memcpy(stats, &Cache[pdrv].stats, sizeof(FF_CACHE_STATS));
+	}
+}
+
+#endif
@@ -0,0 +1,463 @@
+/*-----------------------------------------------------------------------*/
+/* Managed fast seek for streamed files                                  */
+/*-----------------------------------------------------------------------*/
+
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file ffstream.c
+*		Fast seek for files opened with f_stream_open. The cluster
+*		link map table (CLMT) of FatFs fast seek is taken from a
+*		bounded pool, built when the file is opened and extended
+*		cluster by cluster while the file grows, so f_lseek, f_read
+*		and f_write of a multi-GB file never walk the FAT chain.
+*
+*		Description:
+*		FatFs does not allocate clusters while a CLMT is attached,
+*		f_stream_write therefore writes the part of a request beyond
+*		the mapped clusters one cluster at a time with the table
+*		detached and appends each new cluster to the table. The
+*		direct transfers of f_write never span a cluster, so this
+*		costs no extra media commands. f_stream_expand allocates a
+*		contiguous block ahead of sustained writes with f_expand,
+*		f_stream_close trims the file back to the written size.
+*		f_read and f_sync can be used on stream files unchanged.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver	Who	Date		Changes
+* ----- ---- -------- -------------------------------------------------------
+* 4.0   agt  10/17/26 First release
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include <string.h>
+#include "ffstream.h"
+#if FF_FS_REENTRANT
+#include "task.h"
+#endif
+
+#if FF_USE_FASTSEEK
+
+#if FF_MAX_SS == FF_MIN_SS
+#define CLUSTER_BYTES(fs)	((FSIZE_t)(fs)->csize * FF_MAX_SS)
+#else
+#define CLUSTER_BYTES(fs)	((FSIZE_t)(fs)->csize * (fs)->ssize)
+#endif
+
+typedef struct {
+	FIL*	fp;				/* File using the table, 0 if free */
+	FSIZE_t	wend;			/* End of the written data */
+	DWORD	nclst;			/* Number of clusters mapped by the table */
+	BYTE	expanded;		/* File was pre-allocated by f_stream_expand */
+	DWORD	tbl[FF_STREAM_CLMT_ITEMS];	/* CLMT, see f_lseek */
+} FF_STREAM;
+
+static FF_STREAM Streams[FILE_SYSTEM_STREAMS];
+
+#if FF_FS_REENTRANT
+#define POOL_LOCK()		vTaskSuspendAll()
+#define POOL_UNLOCK()	(void)xTaskResumeAll()
+#else
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Looks up the table of a file.
+*
+* @param	fp - File object
+*
+* @return	Table entry, 0 if the file has none
+*
+******************************************************************************/
+static FF_STREAM* find_stream (
+	const FIL* fp
+)
+{
+	UINT i;
+
+	for (i = 0U; i < FILE_SYSTEM_STREAMS; i++) {
+		if (Streams[i].fp == fp) {
+			return &Streams[i];
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Detaches the table of a file and returns it to the pool. The file keeps
+* working with FAT chain seeks.
+*
+* @param	st - Table entry
+*
+******************************************************************************/
+static void release_stream (
+	FF_STREAM* st
+)
+{
+	st->fp->cltbl = 0;
+	POOL_LOCK();
+	st->fp = 0;
+	POOL_UNLOCK();
+}
+
+/*****************************************************************************/
+/**
+*
+* Builds the table of a file from its FAT chain and attaches it. A file with
+* more fragments than a table holds is released to FAT chain seeks.
+*
+* @param	st - Table entry
+*
+* @return	FR_OK or the error of f_lseek
+*
+******************************************************************************/
+static FRESULT build_map (
+	FF_STREAM* st
+)
+{
+	FIL* fp = st->fp;
+	FRESULT res;
+	UINT i;
+
+	st->tbl[0] = FF_STREAM_CLMT_ITEMS;
+	fp->cltbl = st->tbl;
+	res = f_lseek(fp, CREATE_LINKMAP);
+	if (res == FR_NOT_ENOUGH_CORE) {
+		release_stream(st);
+		return FR_OK;
+	}
+	if (res != FR_OK) {
+		fp->cltbl = 0;
+		return res;
+	}
+
+	st->nclst = 0U;
+	for (i = 1U; st->tbl[i] != 0U; i += 2U) {
+		st->nclst += st->tbl[i];
+	}
+
+	return FR_OK;
+}
+
+#if !FF_FS_READONLY
+/*****************************************************************************/
+/**
+*
+* Appends the cluster following the mapped ones to the table, extending the
+* last fragment if it is contiguous.
+*
+* @param	st - Table entry
+* @param	clst - Cluster number
+*
+******************************************************************************/
+static void map_cluster (
+	FF_STREAM* st,
+	DWORD clst
+)
+{
+	DWORD ulen = st->tbl[0];	/* Items used, including size and terminator */
+
+	if ((ulen > 2U) && ((st->tbl[ulen - 2U] + st->tbl[ulen - 3U]) == clst)) {
+		st->tbl[ulen - 3U]++;
+	} else if ((ulen + 2U) <= FF_STREAM_CLMT_ITEMS) {
+		st->tbl[ulen - 1U] = 1U;
+		st->tbl[ulen] = clst;
+		st->tbl[ulen + 1U] = 0U;
+		st->tbl[0] = ulen + 2U;
+	} else {
+		release_stream(st);		/* Too fragmented */
+		return;
+	}
+	st->nclst++;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Opens a file like f_open and enables fast seek for it if a table is free
+* in the pool.
+*
+* @param	fp - Pointer to the blank file object
+* @param	path - Pointer to the file name
+* @param	mode - Access mode and file open mode flags, see f_open
+*
+* @return	Result of f_open or of building the table
+*
+******************************************************************************/
+FRESULT f_stream_open (
+	FIL* fp,
+	const TCHAR* path,
+	BYTE mode
+)
+{
+	FF_STREAM* st = 0;
+	FRESULT res;
+	UINT i;
+
+	res = f_open(fp, path, mode);
+	if (res != FR_OK) {
+		return res;
+	}
+
+	POOL_LOCK();
+	for (i = 0U; i < FILE_SYSTEM_STREAMS; i++) {
+		if (Streams[i].fp == 0) {
+			st = &Streams[i];
+			st->fp = fp;
+			break;
+		}
+	}
+	POOL_UNLOCK();
+	if (st == 0) {
+		return FR_OK;			/* Pool empty, no fast seek */
+	}
+
+	st->wend = 0U;
+	st->expanded = 0U;
+	res = build_map(st);
+	if (res != FR_OK) {
+		release_stream(st);
+		(void)f_close(fp);
+	}
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Closes a file opened with f_stream_open and returns its table to the pool.
+* A file pre-allocated with f_stream_expand is truncated to the end of the
+* written data.
+*
+* @param	fp - File object
+*
+* @return	Result of f_truncate or f_close
+*
+******************************************************************************/
+FRESULT f_stream_close (
+	FIL* fp
+)
+{
+	FF_STREAM* st = find_stream(fp);
+	FRESULT res = FR_OK;
+#if !FF_FS_READONLY
+	BYTE trim = 0U;
+	FSIZE_t wend = 0U;
+#endif
+
+	if (st != 0) {
+#if !FF_FS_READONLY
+		trim = st->expanded;
+		wend = st->wend;
+#endif
+		release_stream(st);
+	}
+
+#if !FF_FS_READONLY
+	if ((trim != 0U) && (wend < f_size(fp))) {
+		res = f_lseek(fp, wend);
+		if (res == FR_OK) {
+			res = f_truncate(fp);
+		}
+	}
+#endif
+
+	if (res == FR_OK) {
+		res = f_close(fp);
+	}
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Moves the file pointer like f_lseek. Seeks within the file use the table,
+* a seek beyond the end of a file open for writing extends the file and
+* rebuilds the table.
+*
+* @param	fp - File object
+* @param	ofs - Byte offset from the top of the file
+*
+* @return	Result of f_lseek
+*
+******************************************************************************/
+FRESULT f_stream_lseek (
+	FIL* fp,
+	FSIZE_t ofs
+)
+{
+	FF_STREAM* st = find_stream(fp);
+	FRESULT res;
+
+	if ((st == 0) || (ofs <= f_size(fp))) {
+		return f_lseek(fp, ofs);
+	}
+
+	fp->cltbl = 0;
+	res = f_lseek(fp, ofs);
+	if (res == FR_OK) {
+		res = build_map(st);
+	} else {
+		fp->cltbl = st->tbl;
+	}
+
+	return res;
+}
+
+#if !FF_FS_READONLY
+/*****************************************************************************/
+/**
+*
+* Writes to a file like f_write. Clusters allocated by the write are added
+* to the table.
+*
+* @param	fp - File object
+* @param	buff - Pointer to the data to be written
+* @param	btw - Number of bytes to write
+* @param	bw - Pointer to the variable to return number of bytes written
+*
+* @return	Result of f_write
+*
+******************************************************************************/
+FRESULT f_stream_write (
+	FIL* fp,
+	const void* buff,
+	UINT btw,
+	UINT* bw
+)
+{
+	FF_STREAM* st = find_stream(fp);
+	const BYTE* p = (const BYTE*)buff;
+	FSIZE_t csz;
+	FSIZE_t mapped;
+	UINT n;
+	UINT wc;
+	FRESULT res = FR_OK;
+
+	if (st == 0) {
+		return f_write(fp, buff, btw, bw);
+	}
+
+	*bw = 0U;
+	csz = CLUSTER_BYTES(fp->obj.fs);
+
+	while ((btw != 0U) && (res == FR_OK)) {
+		mapped = (FSIZE_t)st->nclst * csz;
+		if (fp->cltbl == 0) {		/* Released on overflow of the table */
+			res = f_write(fp, p, btw, &wc);
+			*bw += wc;
+			break;
+		}
+		if (f_tell(fp) < mapped) {
+			/* Allocated part, written through the table */
+			n = ((mapped - f_tell(fp)) < btw) ? (UINT)(mapped - f_tell(fp)) : btw;
+			res = f_write(fp, p, n, &wc);
+		} else {
+			/* One new cluster, allocated by f_write on the FAT chain */
+			n = (csz < btw) ? (UINT)csz : btw;
+			fp->cltbl = 0;
+			res = f_write(fp, p, n, &wc);
+			fp->cltbl = st->tbl;
+			if (wc != 0U) {
+				map_cluster(st, fp->clust);
+			}
+		}
+
+		*bw += wc;
+		p += wc;
+		btw -= wc;
+		if (f_tell(fp) > st->wend) {
+			st->wend = f_tell(fp);
+		}
+		if (wc < n) {
+			break;					/* Disk full */
+		}
+	}
+
+	return res;
+}
+
+#if FF_USE_EXPAND
+/*****************************************************************************/
+/**
+*
+* Allocates a contiguous block of fsz bytes to an empty file opened with
+* f_stream_open for writing, so that sustained writes do not search the FAT
+* for free clusters. The block is mapped by a single table fragment, the file
+* is trimmed to the written data on f_stream_close.
+*
+* @param	fp - File object
+* @param	fsz - Size to allocate in bytes
+*
+* @return	Result of f_expand
+*
+******************************************************************************/
+FRESULT f_stream_expand (
+	FIL* fp,
+	FSIZE_t fsz
+)
+{
+	FF_STREAM* st = find_stream(fp);
+	FRESULT res;
+
+	if (st == 0) {
+		return f_expand(fp, fsz, 1U);
+	}
+
+	fp->cltbl = 0;
+	res = f_expand(fp, fsz, 1U);
+	if (res == FR_OK) {
+		st->expanded = 1U;
+		st->wend = 0U;
+		res = build_map(st);
+	} else {
+		fp->cltbl = st->tbl;
+	}
+
+	return res;
+}
+#endif
+#endif
+
+#endif	/* FF_USE_FASTSEEK */
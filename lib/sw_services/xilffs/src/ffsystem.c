@@ -5,6 +5,9 @@
 
 
 #include "ff.h"
+#if FF_FS_REENTRANT
+#include "task.h"
+#endif
 
 
 
@@ -56,8 +59,8 @@ int ff_cre_syncobj (	/* 1:Function succeeded, 0:Could not create the sync object
 )
 {
 	/* Win32 */
-	*sobj = CreateMutex(NULL, FALSE, NULL);
-	return (int)(*sobj != INVALID_HANDLE_VALUE);
+//	*sobj = CreateMutex(NULL, FALSE, NULL);
+//	return (int)(*sobj != INVALID_HANDLE_VALUE);
 
 	/* uITRON */
 //	T_CSEM csem = {TA_TPRI,1,1};
@@ -70,8 +73,9 @@ int ff_cre_syncobj (	/* 1:Function succeeded, 0:Could not create the sync object
 //	return (int)(err == OS_NO_ERR);
 
 	/* FreeRTOS */
-//	*sobj = xSemaphoreCreateMutex();
-//	return (int)(*sobj != NULL);
+	(void)vol;
+	*sobj = xSemaphoreCreateMutex();
+	return (int)(*sobj != NULL);
 
 	/* CMSIS-RTOS */
 //	*sobj = osMutexCreate(Mutex + vol);
@@ -92,7 +96,7 @@ int ff_del_syncobj (	/* 1:Function succeeded, 0:Could not delete due to an error
 )
 {
 	/* Win32 */
-	return (int)CloseHandle(sobj);
+//	return (int)CloseHandle(sobj);
 
 	/* uITRON */
 //	return (int)(del_sem(sobj) == E_OK);
@@ -103,8 +107,8 @@ int ff_del_syncobj (	/* 1:Function succeeded, 0:Could not delete due to an error
 //	return (int)(err == OS_NO_ERR);
 
 	/* FreeRTOS */
-//  vSemaphoreDelete(sobj);
-//	return 1;
+	vSemaphoreDelete(sobj);
+	return 1;
 
 	/* CMSIS-RTOS */
 //	return (int)(osMutexDelete(sobj) == osOK);
@@ -123,7 +127,7 @@ int ff_req_grant (	/* 1:Got a grant to access the volume, 0:Could not get a gran
 )
 {
 	/* Win32 */
-	return (int)(WaitForSingleObject(sobj, FF_FS_TIMEOUT) == WAIT_OBJECT_0);
+//	return (int)(WaitForSingleObject(sobj, FF_FS_TIMEOUT) == WAIT_OBJECT_0);
 
 	/* uITRON */
 //	return (int)(wai_sem(sobj) == E_OK);
@@ -134,7 +138,7 @@ int ff_req_grant (	/* 1:Got a grant to access the volume, 0:Could not get a gran
 //	return (int)(err == OS_NO_ERR);
 
 	/* FreeRTOS */
-//	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
+	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
 
 	/* CMSIS-RTOS */
 //	return (int)(osMutexWait(sobj, FF_FS_TIMEOUT) == osOK);
@@ -152,7 +156,7 @@ void ff_rel_grant (
 )
 {
 	/* Win32 */
-	ReleaseMutex(sobj);
+//	ReleaseMutex(sobj);
 
 	/* uITRON */
 //	sig_sem(sobj);
@@ -161,11 +165,56 @@ void ff_rel_grant (
 //	OSMutexPost(sobj);
 
 	/* FreeRTOS */
-//	xSemaphoreGive(sobj);
+	xSemaphoreGive(sobj);
 
 	/* CMSIS-RTOS */
 //	osMutexRelease(sobj);
 }
 
+
+
+/*------------------------------------------------------------------------*/
+/* Lock a Physical Drive                                                  */
+/*------------------------------------------------------------------------*/
+/* This function is called by diskio.c around every access to a physical
+/  drive. The volume locks above only serialize access to one volume, while
+/  several volumes (partitions) can be on the same drive and volumes on
+/  different drives are accessed in parallel. The lock is recursive since
+/  disk_read and disk_write call disk_status. When a 0 is returned, the
+/  disk function fails.
+*/
+
+static SemaphoreHandle_t DiskLock[FF_DISK_LOCKS];
+
+int ff_disk_lock (	/* 1:Got the drive, 0:Could not get the drive */
+	BYTE pdrv		/* Physical drive number */
+)
+{
+	if (pdrv >= FF_DISK_LOCKS) return 0;
+
+	if (DiskLock[pdrv] == NULL) {	/* Created on first use, disk functions have no init hook */
+		vTaskSuspendAll();
+		if (DiskLock[pdrv] == NULL) {
+			DiskLock[pdrv] = xSemaphoreCreateRecursiveMutex();
+		}
+		(void)xTaskResumeAll();
+		if (DiskLock[pdrv] == NULL) return 0;
+	}
+
+	return (int)(xSemaphoreTakeRecursive(DiskLock[pdrv], FF_FS_TIMEOUT) == pdTRUE);
+}
+
+
+/*------------------------------------------------------------------------*/
+/* Unlock a Physical Drive                                                */
+/*------------------------------------------------------------------------*/
+
+void ff_disk_unlock (
+	BYTE pdrv		/* Physical drive number */
+)
+{
+	(void)xSemaphoreGiveRecursive(DiskLock[pdrv]);
+}
+
 #endif
 
@@ -375,6 +375,9 @@ int ff_cre_syncobj (BYTE vol, FF_SYNC_t* sobj);	/* Create a sync object */
 int ff_req_grant (FF_SYNC_t sobj);		/* Lock sync object */
 void ff_rel_grant (FF_SYNC_t sobj);		/* Unlock sync object */
 int ff_del_syncobj (FF_SYNC_t sobj);	/* Delete a sync object */
+#define FF_DISK_LOCKS	2	/* Number of physical drives of diskio.c */
+int ff_disk_lock (BYTE pdrv);			/* Lock a physical drive */
+void ff_disk_unlock (BYTE pdrv);		/* Unlock a physical drive */
 #endif
 
 
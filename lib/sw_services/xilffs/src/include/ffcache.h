@@ -0,0 +1,103 @@
+/*-----------------------------------------------------------------------/
+/  Sector cache between FatFs and the media backends
+/-----------------------------------------------------------------------*/
+
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+#ifndef FFCACHE_DEFINED
+#define FFCACHE_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "diskio.h"
+#include "xparameters.h"
+
+/*---------------------------------------------------------------------------/
+/ Cache Configurations
+/---------------------------------------------------------------------------*/
+
+#ifndef FILE_SYSTEM_CACHE_SETS
+#define FILE_SYSTEM_CACHE_SETS		16U
+#endif
+/* Number of sets of the cache. Consecutive sectors map to consecutive sets. */
+
+#ifndef FILE_SYSTEM_CACHE_WAYS
+#define FILE_SYSTEM_CACHE_WAYS		4U
+#endif
+/* Number of sectors per set. The least recently used way is replaced. */
+
+#ifndef FILE_SYSTEM_CACHE_READ_AHEAD
+#define FILE_SYSTEM_CACHE_READ_AHEAD	8U
+#endif
+/* Number of sectors fetched on a miss of a sequential read stream. This is
+/  also the longest run of dirty sectors written back in one command and the
+/  request size above which reads and writes go directly to the media. */
+
+#define FF_CACHE_DRIVES		2U
+#define FF_CACHE_SS			512U
+#define FF_CACHE_LINES		(FILE_SYSTEM_CACHE_SETS * FILE_SYSTEM_CACHE_WAYS)
+
+#if FILE_SYSTEM_CACHE_READ_AHEAD < 2U
+#define FF_CACHE_BURST		2U
+#else
+#define FF_CACHE_BURST		FILE_SYSTEM_CACHE_READ_AHEAD
+#endif
+
+/* Media access functions of a drive */
+typedef DRESULT (*FF_CACHE_READ) (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+typedef DRESULT (*FF_CACHE_WRITE) (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+
+/* Cache counters */
+typedef struct {
+	DWORD	read_hits;		/* Sectors read from the cache */
+	DWORD	read_misses;	/* Sectors read from the media on request */
+	DWORD	read_ahead;		/* Sectors read from the media ahead of request */
+	DWORD	write_hits;		/* Sectors written to the cache */
+	DWORD	media_reads;	/* Read commands issued to the media */
+	DWORD	media_writes;	/* Write commands issued to the media */
+	DWORD	written_back;	/* Dirty sectors written to the media */
+} FF_CACHE_STATS;
+
+
+/*---------------------------------------*/
+/* Prototypes for cache functions        */
+
+void ff_cache_init (BYTE pdrv, FF_CACHE_READ rd, FF_CACHE_WRITE wr, DWORD nsect);
+DRESULT ff_cache_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
+DRESULT ff_cache_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+DRESULT ff_cache_sync (BYTE pdrv);
+void ff_cache_stats (BYTE pdrv, FF_CACHE_STATS* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -89,11 +89,19 @@ extern "C" {
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_EXPAND	0
+#if defined(FILE_SYSTEM_USE_FASTSEEK) && !defined(FILE_SYSTEM_READ_ONLY)
+#define FF_USE_EXPAND	1	/* 1:Enable */
+#else
+#define FF_USE_EXPAND	0	/* 0:Disable */
+#endif
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
@@ -144,7 +152,9 @@ extern "C" {
 */
 
 
-#ifdef FILE_SYSTEM_USE_LFN
+#if defined(FILE_SYSTEM_USE_LFN) && defined(FILE_SYSTEM_REENTRANT)
+#define	FF_USE_LFN	2		/* 0 to 3 */
+#elif defined(FILE_SYSTEM_USE_LFN)
 #define	FF_USE_LFN	1		/* 0 to 3 */
 #else
 #define	FF_USE_LFN	0		/* 0 to 3 */
@@ -347,9 +357,17 @@ extern "C" {
 /      lock control is independent of re-entrancy. */
 
 
+#ifdef FILE_SYSTEM_REENTRANT
+#include "FreeRTOS.h"
+#include "semphr.h"
+#define FF_FS_REENTRANT	1
+#define FF_FS_TIMEOUT	portMAX_DELAY
+#define FF_SYNC_t		SemaphoreHandle_t
+#else
 #define FF_FS_REENTRANT	0
 #define FF_FS_TIMEOUT	1000
 #define FF_SYNC_t		HANDLE
+#endif
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
 /  volume is always re-entrant and volume control functions, f_mount(), f_mkfs()
@@ -0,0 +1,83 @@
+/*-----------------------------------------------------------------------/
+/  Managed fast seek for streamed files
+/-----------------------------------------------------------------------*/
+
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+#ifndef FFSTREAM_DEFINED
+#define FFSTREAM_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ff.h"
+
+#if FF_USE_FASTSEEK
+
+/*---------------------------------------------------------------------------/
+/ Stream Configurations
+/---------------------------------------------------------------------------*/
+
+#ifndef FILE_SYSTEM_STREAMS
+#define FILE_SYSTEM_STREAMS				4U
+#endif
+/* Number of cluster link map tables in the pool, i.e. number of files which
+/  can be open with f_stream_open and fast seek at the same time. Files opened
+/  when the pool is empty work without fast seek. */
+
+#ifndef FILE_SYSTEM_STREAM_FRAGMENTS
+#define FILE_SYSTEM_STREAM_FRAGMENTS	32U
+#endif
+/* Number of fragments (contiguous cluster runs) one table can map. A file
+/  which gets more fragments falls back to FAT chain seeks. */
+
+#define FF_STREAM_CLMT_ITEMS	((FILE_SYSTEM_STREAM_FRAGMENTS * 2U) + 2U)
+
+
+/*---------------------------------------*/
+/* Prototypes for stream functions       */
+
+FRESULT f_stream_open (FIL* fp, const TCHAR* path, BYTE mode);
+FRESULT f_stream_close (FIL* fp);
+FRESULT f_stream_lseek (FIL* fp, FSIZE_t ofs);
+#if !FF_FS_READONLY
+FRESULT f_stream_write (FIL* fp, const void* buff, UINT btw, UINT* bw);
+#if FF_USE_EXPAND
+FRESULT f_stream_expand (FIL* fp, FSIZE_t fsz);
+#endif
+#endif
+
+#endif	/* FF_USE_FASTSEEK */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -45,6 +45,265 @@ struct mfs_open_file_struct mfs_open_files[MFS_MAX_OPEN_FILES];
 int mfs_num_open_files; /* the number of mfs_open_files */
 int mfs_current_dir; /* index of current directory block */
 
+#if MFS_DIR_HASH_SIZE > 0
+/**
+ * directory hash index: the entries of up to MFS_DIR_HASH_DIRS directories
+ * are kept in an open addressing table keyed by directory and name. A slot
+ * only points to an entry, it is used if the entry still has the name and
+ * is not deleted, so deleted and renamed entries need no removal from the
+ * table. The table is flushed when it fills up, when another directory has
+ * to be indexed and all MFS_DIR_HASH_DIRS are in use, and when a directory
+ * is deleted, as its blocks may be reused by other directories.
+ */
+#define MFS_DIR_HASH_DIRS 8
+/* directories with more entries than this are not indexed */
+#define MFS_DIR_HASH_MAX_USED ((MFS_DIR_HASH_SIZE / 4) * 3)
+
+struct mfs_dir_hash_slot {
+  int dir; /* first block of the directory, -1 if the slot is unused */
+  int dir_block; /* directory block that holds the entry */
+  int dir_index; /* index of the entry within dir_block */
+};
+static struct mfs_dir_hash_slot mfs_dir_hash[MFS_DIR_HASH_SIZE];
+static int mfs_dir_hash_used; /* used slots */
+static int mfs_dir_hash_dirs[MFS_DIR_HASH_DIRS]; /* indexed dirs, -1 if unused */
+
+/**
+ * empty the directory hash index
+ */
+static void dir_hash_flush(void) {
+  int i;
+  for (i = 0; i < MFS_DIR_HASH_SIZE; i++)
+    mfs_dir_hash[i].dir = -1;
+  for (i = 0; i < MFS_DIR_HASH_DIRS; i++)
+    mfs_dir_hash_dirs[i] = -1;
+  mfs_dir_hash_used = 0;
+}
+
+/**
+ * get the first slot to probe for a name
+ * @param dir is the first block of the directory
+ * @param name is the name of the entry
+ * @return index of the slot
+ */
+static int dir_hash_slot(int dir, const char *name) {
+  unsigned int hash = 2166136261U ^ (unsigned int)dir; /* FNV-1a */
+  while (*name != '\0') {
+    hash ^= (unsigned char)*name;
+    hash *= 16777619U;
+    name++;
+  }
+  return hash & (MFS_DIR_HASH_SIZE - 1);
+}
+
+/**
+ * add an entry to the directory hash index
+ * the index is flushed if it is full
+ * @param dir is the first block of the directory
+ * @param dir_block is the directory block of the entry
+ * @param dir_index is the index of the entry within dir_block
+ * @return 1 on success, 0 if the index was flushed
+ */
+static int dir_hash_insert(int dir, int dir_block, int dir_index) {
+  int i;
+  if (mfs_dir_hash_used >= MFS_DIR_HASH_MAX_USED) {
+    dir_hash_flush();
+    return 0;
+  }
+  i = dir_hash_slot(dir, mfs_file_system[dir_block].u.dir_data.dir_ent[dir_index].name);
+  while (mfs_dir_hash[i].dir != -1)
+    i = (i + 1) & (MFS_DIR_HASH_SIZE - 1);
+  mfs_dir_hash[i].dir = dir;
+  mfs_dir_hash[i].dir_block = dir_block;
+  mfs_dir_hash[i].dir_index = dir_index;
+  mfs_dir_hash_used++;
+  return 1;
+}
+
+/**
+ * check whether a directory is in the directory hash index
+ * @param dir is the first block of the directory
+ * @return 1 if it is, 0 otherwise
+ */
+static int dir_hash_indexed(int dir) {
+  int i;
+  for (i = 0; i < MFS_DIR_HASH_DIRS; i++) {
+    if (mfs_dir_hash_dirs[i] == dir)
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * add all entries of a directory to the directory hash index
+ * @param dir is the first block of the directory
+ * @return 1 on success, 0 if the directory is too large to be indexed
+ */
+static int dir_hash_add_dir(int dir) {
+  int numentriesleft = mfs_file_system[dir].u.dir_data.num_entries;
+  int dir_block = dir;
+  int dir_index = 0;
+  int i;
+
+  if (numentriesleft - mfs_file_system[dir].u.dir_data.num_deleted > MFS_DIR_HASH_MAX_USED)
+    return 0;
+  for (i = 0; i < MFS_DIR_HASH_DIRS && mfs_dir_hash_dirs[i] != -1; i++)
+    ;
+  if (i == MFS_DIR_HASH_DIRS ||
+      mfs_dir_hash_used + numentriesleft > MFS_DIR_HASH_MAX_USED) {
+    dir_hash_flush();
+    i = 0;
+  }
+  while (numentriesleft > 0) {
+    if (dir_index == MFS_MAX_LOCAL_ENT) { /* move to the next dir block */
+      dir_index = 0;
+      dir_block = mfs_file_system[dir_block].next_block;
+    }
+    if (mfs_file_system[dir_block].u.dir_data.dir_ent[dir_index].deleted != 'y' &&
+        !dir_hash_insert(dir, dir_block, dir_index))
+      return 0; /* num_deleted may overestimate the deleted entries */
+    dir_index++;
+    numentriesleft--;
+  }
+  mfs_dir_hash_dirs[i] = dir;
+  return 1;
+}
+
+/**
+ * look up a name in a directory through the directory hash index
+ * the directory is indexed if it is not yet
+ * @param dir is the first block of the directory
+ * @param name is the name of the entry
+ * @param dir_block is set to the directory block of the entry on success
+ * @param dir_index is set to the index of the entry within dir_block on success
+ * @return 1 if the entry was found, 0 if it does not exist,
+ * -1 if the directory cannot be indexed and has to be scanned
+ */
+static int dir_hash_lookup(int dir, const char *name, int *dir_block, int *dir_index) {
+  struct mfs_dir_ent_block *ent;
+  int i;
+
+  if (!dir_hash_indexed(dir) && !dir_hash_add_dir(dir))
+    return -1;
+  for (i = dir_hash_slot(dir, name); mfs_dir_hash[i].dir != -1;
+       i = (i + 1) & (MFS_DIR_HASH_SIZE - 1)) {
+    if (mfs_dir_hash[i].dir != dir)
+      continue;
+    ent = &mfs_file_system[mfs_dir_hash[i].dir_block].u.dir_data.dir_ent[mfs_dir_hash[i].dir_index];
+    if (ent->deleted != 'y' && !strcmp(ent->name, name)) {
+      *dir_block = mfs_dir_hash[i].dir_block;
+      *dir_index = mfs_dir_hash[i].dir_index;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * add a new or renamed entry to the directory hash index if its directory
+ * is indexed
+ * @param dir is the first block of the directory
+ * @param dir_block is the directory block of the entry
+ * @param dir_index is the index of the entry within dir_block
+ */
+static void dir_hash_update(int dir, int dir_block, int dir_index) {
+  if (dir_hash_indexed(dir))
+    dir_hash_insert(dir, dir_block, dir_index);
+}
+#endif
+
+#if MFS_SEEK_INDEX_ENTRIES > 0
+/**
+ * start the seek index of an open file with its first block
+ * @param fd is the descriptor of the open file
+ */
+static void seek_index_init(int fd) {
+  mfs_open_files[fd].num_mapped = 1;
+  mfs_open_files[fd].num_extents = 1;
+  mfs_open_files[fd].seek_index[0].first = 0;
+  mfs_open_files[fd].seek_index[0].block = mfs_open_files[fd].first_block;
+}
+
+/**
+ * add a block to the seek index of an open file
+ * only the block that follows the indexed blocks is added, if the index
+ * is full the blocks beyond it are found through the next_block chain
+ * @param fd is the descriptor of the open file
+ * @param block_num is the number of the block within the file
+ * @param block is the index of the block in the file system
+ */
+static void seek_index_add(int fd, unsigned int block_num, unsigned int block) {
+  struct mfs_open_file_struct *file = &mfs_open_files[fd];
+  struct mfs_seek_extent *last = &file->seek_index[file->num_extents - 1];
+  if (block_num != file->num_mapped)
+    return;
+  if (last->block + (block_num - last->first) == block) { /* extends the last extent */
+    file->num_mapped++;
+  }
+  else if (file->num_extents < MFS_SEEK_INDEX_ENTRIES) { /* starts a new extent */
+    file->seek_index[file->num_extents].first = block_num;
+    file->seek_index[file->num_extents].block = block;
+    file->num_extents++;
+    file->num_mapped++;
+  }
+}
+
+/**
+ * drop the blocks from num_blocks on from the seek index of an open file
+ * used when mfs_file_write replaces the rest of the block chain
+ * @param fd is the descriptor of the open file
+ * @param num_blocks is the number of blocks that remain indexed, at least 1
+ */
+static void seek_index_trim(int fd, unsigned int num_blocks) {
+  struct mfs_open_file_struct *file = &mfs_open_files[fd];
+  if (file->num_mapped > num_blocks) {
+    file->num_mapped = num_blocks;
+    while (file->seek_index[file->num_extents - 1].first >= num_blocks)
+      file->num_extents--;
+  }
+}
+
+/**
+ * get a block of an open file through its seek index
+ * blocks beyond the index are found by following the chain from the last
+ * indexed block or the current block, and are added to the index on the way
+ * @param fd is the descriptor of the open file
+ * @param block_num is the number of the block within the file
+ * @return index of the block in the file system
+ */
+static unsigned int seek_index_lookup(int fd, unsigned int block_num) {
+  struct mfs_open_file_struct *file = &mfs_open_files[fd];
+  unsigned int lo = 0;
+  unsigned int hi = file->num_extents - 1;
+  unsigned int mid;
+  unsigned int num;
+  unsigned int block;
+
+  if (block_num >= file->num_mapped && file->block_num >= file->num_mapped &&
+      file->block_num <= block_num) { /* beyond the index, after the current block */
+    block = file->current_block;
+    num = file->block_num;
+  }
+  else {
+    num = (block_num < file->num_mapped) ? block_num : file->num_mapped - 1;
+    while (lo < hi) { /* find the last extent that starts at or before num */
+      mid = (lo + hi + 1) / 2;
+      if (file->seek_index[mid].first <= num)
+        lo = mid;
+      else
+        hi = mid - 1;
+    }
+    block = file->seek_index[lo].block + (num - file->seek_index[lo].first);
+  }
+  while (num < block_num) {
+    block = mfs_file_system[block].next_block;
+    num++;
+    seek_index_add(fd, num, block);
+  }
+  return block;
+}
+#endif
+
 /**
  * initialize the file system;
  * this function must be called before any file system operations
@@ -103,6 +362,10 @@ else { // (init_type == MFSINIT_ROM_IMAGE)
   /* initialize current dir to the top level */
   mfs_current_dir = 0;
 
+#if MFS_DIR_HASH_SIZE > 0
+  dir_hash_flush();
+#endif
+
   /* initialize mfs_open_files */
   for (i = 0; i < MFS_MAX_OPEN_FILES; i++)
     mfs_open_files[i].mode = MFS_MODE_FREE;
@@ -128,10 +391,24 @@ void mfs_init_genimage(int numbytes, char *address, int init_type) {
     * is the given address plus 4.
     * Use these new values to call the mfs_init_fs function to do
     * the actual work
+    * mfsromgen images with contiguous files are identified by
+    * MFS_IMAGE_MAGIC_EXTENT and can only be used read-only
     */
+   if (!strncmp(address, MFS_IMAGE_MAGIC_EXTENT, 4))
+     init_type = MFSINIT_ROM_IMAGE;
    mfs_init_fs(numbytes-4, address+4, init_type);
 }
 
+/**
+ * get the number of block slots used by the data of a contiguous file
+ * @param file_block is the index of the MFS_BLOCK_TYPE_EXTENT block of the file
+ * @return number of block slots that follow file_block
+ */
+static int get_extent_slots(int file_block) {
+  return (mfs_file_system[file_block].block_size + sizeof(struct mfs_file_block) - 1) /
+    sizeof(struct mfs_file_block);
+}
+
 
 /**
  * Given a filename, get the directory block and the directory index within
@@ -154,11 +431,15 @@ void mfs_init_genimage(int numbytes, char *address, int init_type) {
  */
 static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_index, int *reuse_block, int *reuse_index) {
   /* *dir_index = 0; *dir_block = valid dir corresponding to filename prefixes processed so far, on entry to this proc */
+#if MFS_DIR_HASH_SIZE > 0
+  int dir = *dir_block;
+#endif
   int numentriesleft = mfs_file_system[*dir_block].u.dir_data.num_entries;
   char tmpfilename[MFS_MAX_FILENAME_LENGTH];
   int index = 0;
   int basename = 0;
   int looking_for_reuse = 0;
+  int found = 0;
 
   while(*filename != '/' && *filename != '\0') {
     tmpfilename[index] = *filename;
@@ -170,7 +451,17 @@ static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_inde
 	  basename = 1;
 	  looking_for_reuse = 1;
   }
-  while (numentriesleft > 0) {
+#if MFS_DIR_HASH_SIZE > 0
+  found = dir_hash_lookup(dir, tmpfilename, dir_block, dir_index);
+  if (found == 0 && basename == 0) { /* path prefix is wrong */
+    *dir_block = -1;
+    *dir_index = -1;
+    return 0;
+  }
+  /* if not found, scan to get the free and reusable entries for the caller */
+  found = (found == 1);
+#endif
+  while (!found && numentriesleft > 0) {
     if (*dir_index == MFS_MAX_LOCAL_ENT) { /* move to the next dir block */
       *dir_index = 0;
       *dir_block = mfs_file_system[*dir_block].next_block;
@@ -180,15 +471,8 @@ static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_inde
                 tmpfilename)) { /* found the entry */
       /* *dir_index = index; */
       /* *dir_block = dir; */
-      if (basename == 1) /* this is the base file name, ignore final '/' if present */
-        return 1;
-      else { /* tmpname is the current prefix, filename is the rest of the path */
-        *dir_block = mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].index;
-        *dir_index = 0;
-        filename++;
-        return(get_dir_ent_base(filename, dir_block, dir_index, reuse_block, reuse_index));
-      }
-
+      found = 1;
+      break;
     }
 	else if ((looking_for_reuse == 1) && (mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].deleted == 'y') && (basename == 1)) {
 		/* found a possible reuse block */
@@ -199,6 +483,16 @@ static int get_dir_ent_base(const char *filename,  int *dir_block, int *dir_inde
     *dir_index += 1;
     numentriesleft--;
   }
+  if (found) {
+    if (basename == 1) /* this is the base file name, ignore final '/' if present */
+      return 1;
+    else { /* tmpname is the current prefix, filename is the rest of the path */
+      *dir_block = mfs_file_system[*dir_block].u.dir_data.dir_ent[*dir_index].index;
+      *dir_index = 0;
+      filename++;
+      return(get_dir_ent_base(filename, dir_block, dir_index, reuse_block, reuse_index));
+    }
+  }
   if (basename == 1) { /* could not find the base name but path prefix is correct */
     return 0;
   }
@@ -509,6 +803,9 @@ static int create_file(const char *filename, int file_type) {
     mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].index = new_entry_index;
     set_filename(mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].name, get_basename(filename));
     mfs_file_system[new_dir_block].u.dir_data.dir_ent[new_dir_index].deleted = 'n';
+#if MFS_DIR_HASH_SIZE > 0
+    dir_hash_update(first_dir_block, new_dir_block, new_dir_index);
+#endif
     return new_entry_index;
   }
 }
@@ -554,6 +851,10 @@ static int delete_data_in_file(int file_index) {
       /* dir is not empty so cannot delete */
       return 0;
     }
+#if MFS_DIR_HASH_SIZE > 0
+    /* the blocks of this dir may be reused by other dirs */
+    dir_hash_flush();
+#endif
   }
   else { /* don't know what this is; cannot delete */
     return 0;
@@ -640,6 +941,9 @@ int mfs_rename_file(char *from_file, char *to_file) {
   if (get_dir_ent(from_file, &from_dir_block, &from_dir_index, &reuse_block, &reuse_index) &&
       !get_dir_ent(to_file, &to_dir_block, &to_dir_index, &reuse_block, &reuse_index)) {
     set_filename(mfs_file_system[from_dir_block].u.dir_data.dir_ent[from_dir_index].name, get_basename(to_file));
+#if MFS_DIR_HASH_SIZE > 0
+    dir_hash_update(get_first_dir_block(from_dir_block), from_dir_block, from_dir_index);
+#endif
     return 1;
   }
   return 0;
@@ -662,7 +966,8 @@ int mfs_exists_file(char *filename) {
     file_block = mfs_file_system[dir_block].u.dir_data.dir_ent[dir_index].index;
     if (mfs_file_system[file_block].block_type == MFS_BLOCK_TYPE_DIR)
       return 2;
-    else if (mfs_file_system[file_block].block_type == MFS_BLOCK_TYPE_FILE)
+    else if (mfs_file_system[file_block].block_type == MFS_BLOCK_TYPE_FILE ||
+             mfs_file_system[file_block].block_type == MFS_BLOCK_TYPE_EXTENT)
       return 1;
     else return 0;
   }
@@ -707,6 +1012,11 @@ int mfs_get_usage(int *num_blocks_used, int *num_blocks_free) {
       *num_blocks_free += 1;
     else
       *num_blocks_used += 1;
+    if (mfs_file_system[i].block_type == MFS_BLOCK_TYPE_EXTENT) {
+      /* skip the data of the contiguous file */
+      *num_blocks_used += get_extent_slots(i);
+      i += get_extent_slots(i);
+    }
   }
   return 1;
 }
@@ -783,6 +1093,8 @@ int mfs_dir_read(int fd, char **filename, int *filesize, int *filetype) {
       direntry_block =
 	mfs_file_system[dir_block].u.dir_data.dir_ent[dir_index].index;
       *filetype = mfs_file_system[direntry_block].block_type;
+      if (*filetype == MFS_BLOCK_TYPE_EXTENT)
+	*filetype = MFS_BLOCK_TYPE_FILE;
       if (*filetype == MFS_BLOCK_TYPE_DIR) {
 	*filesize =
 	  mfs_file_system[direntry_block].u.dir_data.num_entries
@@ -834,6 +1146,10 @@ int mfs_file_open(const char *filename, int mode) {
       mfs_open_files[current_index].current_block = mfs_open_files[current_index].first_block;
       mfs_open_files[current_index].mode = mode;
       mfs_open_files[current_index].offset = 0;
+      mfs_open_files[current_index].block_num = 0;
+#if MFS_SEEK_INDEX_ENTRIES > 0
+      seek_index_init(current_index);
+#endif
       return current_index;
     }
     else {
@@ -854,6 +1170,10 @@ int mfs_file_open(const char *filename, int mode) {
     mfs_open_files[current_index].current_block = dir_block;
     mfs_open_files[current_index].mode = MFS_MODE_WRITE;
     mfs_open_files[current_index].offset = 0;
+    mfs_open_files[current_index].block_num = 0;
+#if MFS_SEEK_INDEX_ENTRIES > 0
+    seek_index_init(current_index);
+#endif
     return current_index;
   }
   return -1;
@@ -873,38 +1193,86 @@ int mfs_file_open(const char *filename, int mode) {
 */
 int mfs_file_read(int fd, char *buf, int buflen) {
   int num_read = 0;
-  char *from_ptr = (char *) &(mfs_file_system[mfs_open_files[fd].current_block].u.block_data[mfs_open_files[fd].offset]);
-  int num_left ;
-  num_left =  mfs_file_system[mfs_open_files[fd].current_block].block_size ;
-  if (num_left > MFS_BLOCK_DATA_SIZE)
-    num_left = MFS_BLOCK_DATA_SIZE;
-  num_left -=  mfs_open_files[fd].offset ;
+  const char *from_ptr;
+  int num;
+
   while (buflen > 0) {
-    if (num_left == 0) { /* see if there is a next_block */
-      int next_block = mfs_file_system[mfs_open_files[fd].current_block].next_block;
-      if (next_block == 0) { /* nothing more to read */
-	break;
-      }
-      if (mfs_file_system[next_block].block_size == 0) { /* nothing more to read */
-	break;
-      }
-      from_ptr = (char *) &(mfs_file_system[next_block].u.block_data[0]);
-      num_left = mfs_file_system[next_block].block_size;
-      mfs_open_files[fd].current_block = next_block;
-      mfs_open_files[fd].offset = 0;
+    num = mfs_file_read_ptr(fd, &from_ptr, buflen);
+    if (num == 0) { /* nothing more to read */
+      break;
     }
-
-    *buf = *from_ptr;
-    buf++;
-    from_ptr++;
-    mfs_open_files[fd].offset += 1;
-    num_read++;
-    num_left--;
-    buflen--;
+    memcpy(buf, from_ptr, num);
+    buf += num;
+    num_read += num;
+    buflen -= num;
   }
   return num_read;
 }
 
+/**
+ * read characters from a file without copying them
+ * @param fd is a descriptor for the file from which the characters are read
+ * @param data is set to point to the characters within the file system
+ * @param maxlen is the maximum number of characters to read
+ * fd should be a valid index in mfs_open_files array
+ * Works only if fd points to a file and not a dir
+ * the characters are contiguous in memory: for a contiguous file of a ROM
+ * image this is the rest of the file, otherwise the rest of the current block
+ * the file position moves past the characters as with mfs_file_read
+ * @return num chars at data or 0 at end of file or for error
+*/
+int mfs_file_read_ptr(int fd, const char **data, int maxlen) {
+  struct mfs_open_file_struct *file;
+  long pos;
+  int num_left;
+  int next_block;
+
+  if (fd < 0 || fd >= MFS_MAX_OPEN_FILES || mfs_open_files[fd].mode == MFS_MODE_FREE || maxlen <= 0)
+    return 0;
+  file = &mfs_open_files[fd];
+
+  if (mfs_file_system[file->first_block].block_type == MFS_BLOCK_TYPE_EXTENT) {
+    /* the data of a contiguous file follows its first block */
+    pos = (long)file->block_num * MFS_BLOCK_DATA_SIZE + file->offset;
+    num_left = mfs_file_system[file->first_block].block_size - pos;
+    if (num_left > maxlen)
+      num_left = maxlen;
+    *data = (const char *)&mfs_file_system[file->first_block + 1] + pos;
+    pos += num_left;
+    file->block_num = pos / MFS_BLOCK_DATA_SIZE;
+    file->offset = pos % MFS_BLOCK_DATA_SIZE;
+    return num_left;
+  }
+
+  num_left = mfs_file_system[file->current_block].block_size;
+  if (num_left > MFS_BLOCK_DATA_SIZE)
+    num_left = MFS_BLOCK_DATA_SIZE;
+  num_left -= file->offset;
+  if (num_left == 0) { /* see if there is a next_block */
+    next_block = mfs_file_system[file->current_block].next_block;
+    if (next_block == 0) { /* nothing more to read */
+      return 0;
+    }
+    if (mfs_file_system[next_block].block_size == 0) { /* nothing more to read */
+      return 0;
+    }
+    num_left = mfs_file_system[next_block].block_size;
+    if (num_left > MFS_BLOCK_DATA_SIZE)
+      num_left = MFS_BLOCK_DATA_SIZE;
+    file->current_block = next_block;
+    file->offset = 0;
+    file->block_num += 1;
+#if MFS_SEEK_INDEX_ENTRIES > 0
+    seek_index_add(fd, file->block_num, next_block);
+#endif
+  }
+  if (num_left > maxlen)
+    num_left = maxlen;
+  *data = (const char *)&mfs_file_system[file->current_block].u.block_data[file->offset];
+  file->offset += num_left;
+  return num_left;
+}
+
 /**
  * write characters to a file
  * @param fd is a descriptor for the file to which the characters are written
@@ -931,6 +1299,12 @@ int mfs_file_write (int fd, const char *buf, int buflen) {
 	mfs_file_system[mfs_open_files[fd].current_block].next_block = new_block;
 	mfs_open_files[fd].current_block = new_block;
 	mfs_open_files[fd].offset = 0;
+	mfs_open_files[fd].block_num += 1;
+#if MFS_SEEK_INDEX_ENTRIES > 0
+	/* new_block replaces the rest of the chain, if any */
+	seek_index_trim(fd, mfs_open_files[fd].block_num);
+	seek_index_add(fd, mfs_open_files[fd].block_num, new_block);
+#endif
       }
       else { /* no space for new block  - return failure */
 	return 0;
@@ -987,17 +1361,17 @@ int mfs_file_close(int fd) {
 long mfs_file_lseek(int fd, long offset, int whence) {
   long local_offset;
   unsigned int local_block;
+  unsigned int block_num;
+#if MFS_SEEK_INDEX_ENTRIES == 0
+  unsigned int local_num;
+#endif
   if (fd <0 || fd >= MFS_MAX_OPEN_FILES || mfs_open_files[fd].mode == MFS_MODE_FREE)
     return -1;
   /* calculate value of offset from the beginning of the file */
   if (whence == MFS_SEEK_SET || whence == MFS_SEEK_CUR) {
     if (whence == MFS_SEEK_CUR) {
       /* add the size of all the previous blocks if any */
-      local_block = mfs_open_files[fd].first_block;
-      while (mfs_open_files[fd].current_block != local_block) {
-        local_block = mfs_file_system[local_block].next_block;
-        offset += MFS_BLOCK_DATA_SIZE;
-      }
+      offset += (long)mfs_open_files[fd].block_num * MFS_BLOCK_DATA_SIZE;
       /* add the offset within the current block */
       offset += mfs_open_files[fd].offset;
     } else {
@@ -1018,15 +1392,38 @@ long mfs_file_lseek(int fd, long offset, int whence) {
       offset += mfs_file_system[mfs_open_files[fd].first_block].block_size;
     }
   }
+  if (offset < 0) { /* attempting to seek before beginning of file */
+    return -1;
+  }
   /* at this point offset is a positive value, guaranteed to be within the file
    */
-  local_offset = offset;
-  local_block = mfs_open_files[fd].first_block;
-  while(local_offset >= MFS_BLOCK_DATA_SIZE) {
-    local_block = mfs_file_system[local_block].next_block;
-    local_offset -= MFS_BLOCK_DATA_SIZE;
+  block_num = offset / MFS_BLOCK_DATA_SIZE;
+  local_offset = offset % MFS_BLOCK_DATA_SIZE;
+  if (mfs_file_system[mfs_open_files[fd].first_block].block_type == MFS_BLOCK_TYPE_EXTENT) {
+    /* contiguous file, only block_num and offset are used */
+    local_block = mfs_open_files[fd].first_block;
+  }
+  else {
+#if MFS_SEEK_INDEX_ENTRIES > 0
+    local_block = seek_index_lookup(fd, block_num);
+#else
+    /* follow the chain from the current block if the new one is not before it */
+    if (block_num >= mfs_open_files[fd].block_num) {
+      local_block = mfs_open_files[fd].current_block;
+      local_num = mfs_open_files[fd].block_num;
+    }
+    else {
+      local_block = mfs_open_files[fd].first_block;
+      local_num = 0;
+    }
+    while (local_num < block_num) {
+      local_block = mfs_file_system[local_block].next_block;
+      local_num++;
+    }
+#endif
   }
   mfs_open_files[fd].current_block = local_block;
+  mfs_open_files[fd].block_num = block_num;
   mfs_open_files[fd].offset = local_offset;
   return offset;
 }
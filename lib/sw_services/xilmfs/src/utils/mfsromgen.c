@@ -0,0 +1,288 @@
+/******************************************************************************
+*
+* Copyright (C) 2026 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+
+/**
+ * mfsromgen - host tool that creates a read-only MFS image with every file
+ * stored contiguously (MFS_BLOCK_TYPE_EXTENT), so that mfs_file_read_ptr
+ * returns a whole file in one piece
+ *
+ * Usage: mfsromgen [-b] image.mfs file_or_dir ...
+ * the files and directories (recursively) are added to the root directory
+ * -b writes a big-endian image for big-endian MicroBlaze
+ *
+ * Build natively with
+ * gcc -O2 -I.. mfsromgen.c -o mfsromgen
+ * and load the image with
+ * mfs_init_genimage(image_size, image_address, MFSINIT_ROM_IMAGE)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "xilmfs.h"
+
+static struct mfs_file_block *blocks;
+static int num_blocks;
+static int max_blocks;
+
+/**
+ * allocate consecutive zeroed blocks at the end of the image
+ * @param count is the number of blocks
+ * @return index of the first block
+ */
+static int new_blocks(int count) {
+  int first = num_blocks;
+  if (num_blocks + count > max_blocks) {
+    while (num_blocks + count > max_blocks)
+      max_blocks = max_blocks ? max_blocks * 2 : 64;
+    blocks = realloc(blocks, max_blocks * sizeof(struct mfs_file_block));
+    if (blocks == NULL) {
+      fprintf(stderr, "mfsromgen: out of memory\n");
+      exit(1);
+    }
+  }
+  memset(&blocks[first], 0, count * sizeof(struct mfs_file_block));
+  num_blocks += count;
+  return first;
+}
+
+/**
+ * create a directory block with entries for .. and .
+ * @param parent is the index of the parent directory
+ * @return index of the new directory
+ */
+static int new_dir(int parent) {
+  int dir = new_blocks(1);
+  blocks[dir].block_type = MFS_BLOCK_TYPE_DIR;
+  blocks[dir].index = dir;
+  blocks[dir].u.dir_data.num_entries = 2;
+  strcpy(blocks[dir].u.dir_data.dir_ent[0].name, "..");
+  blocks[dir].u.dir_data.dir_ent[0].deleted = 'n';
+  blocks[dir].u.dir_data.dir_ent[0].index = parent;
+  strcpy(blocks[dir].u.dir_data.dir_ent[1].name, ".");
+  blocks[dir].u.dir_data.dir_ent[1].deleted = 'n';
+  blocks[dir].u.dir_data.dir_ent[1].index = dir;
+  return dir;
+}
+
+/**
+ * add an entry to a directory, as create_file of mfs_filesys.c does
+ * @param dir is the index of the first block of the directory
+ * @param name is the name of the entry
+ * @param index is the index of the first block of the file or dir
+ */
+static void add_entry(int dir, const char *name, int index) {
+  int last = dir;
+  int local;
+  int new_block;
+
+  if (strlen(name) >= MFS_MAX_FILENAME_LENGTH) {
+    fprintf(stderr, "mfsromgen: name too long: %s\n", name);
+    exit(1);
+  }
+  while (blocks[last].next_block != 0)
+    last = blocks[last].next_block;
+  local = (last == dir) ? blocks[dir].u.dir_data.num_entries : blocks[last].u.dir_data.num_entries;
+  if (local == MFS_MAX_LOCAL_ENT) { /* continue the directory in a new block */
+    new_block = new_blocks(1);
+    blocks[new_block].block_type = MFS_BLOCK_TYPE_DIR;
+    blocks[new_block].index = new_block;
+    blocks[new_block].prev_block = last;
+    blocks[last].next_block = new_block;
+    last = new_block;
+    local = 0;
+  }
+  strcpy(blocks[last].u.dir_data.dir_ent[local].name, name);
+  blocks[last].u.dir_data.dir_ent[local].deleted = 'n';
+  blocks[last].u.dir_data.dir_ent[local].index = index;
+  blocks[last].u.dir_data.num_entries += 1;
+  if (last != dir)
+    blocks[dir].u.dir_data.num_entries += 1;
+}
+
+/**
+ * add a file as an extent: one MFS_BLOCK_TYPE_EXTENT block followed by the
+ * data of the file
+ * @param path is the host path of the file
+ * @return index of the first block of the file
+ */
+static int add_file(const char *path) {
+  FILE *in = fopen(path, "rb");
+  long size;
+  int file;
+  int slots;
+
+  if (in == NULL || fseek(in, 0, SEEK_END) != 0 || (size = ftell(in)) < 0) {
+    fprintf(stderr, "mfsromgen: cannot read %s\n", path);
+    exit(1);
+  }
+  rewind(in);
+  slots = (size + sizeof(struct mfs_file_block) - 1) / sizeof(struct mfs_file_block);
+  file = new_blocks(1 + slots);
+  blocks[file].block_type = MFS_BLOCK_TYPE_EXTENT;
+  blocks[file].block_size = size;
+  blocks[file].index = file;
+  if (fread(&blocks[file + 1], 1, size, in) != (size_t)size) {
+    fprintf(stderr, "mfsromgen: cannot read %s\n", path);
+    exit(1);
+  }
+  fclose(in);
+  return file;
+}
+
+static int compare_names(const void *a, const void *b) {
+  return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/**
+ * add a file or a directory tree to a directory of the image
+ * @param dir is the index of the first block of the directory
+ * @param path is the host path
+ * @param name is the name of the entry in dir
+ */
+static void add_path(int dir, const char *path, const char *name) {
+  struct stat st;
+  struct dirent *ent;
+  DIR *host_dir;
+  char **names = NULL;
+  char *sub_path;
+  int num_names = 0;
+  int sub_dir;
+  int i;
+
+  if (stat(path, &st) != 0) {
+    fprintf(stderr, "mfsromgen: cannot stat %s\n", path);
+    exit(1);
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    add_entry(dir, name, add_file(path));
+    return;
+  }
+  sub_dir = new_dir(dir);
+  add_entry(dir, name, sub_dir);
+  host_dir = opendir(path);
+  if (host_dir == NULL) {
+    fprintf(stderr, "mfsromgen: cannot read %s\n", path);
+    exit(1);
+  }
+  while ((ent = readdir(host_dir)) != NULL) { /* sorted for reproducible images */
+    if (!strcmp(ent->d_name, ".") || !strcmp(ent->d_name, ".."))
+      continue;
+    names = realloc(names, (num_names + 1) * sizeof(char *));
+    names[num_names++] = strdup(ent->d_name);
+  }
+  closedir(host_dir);
+  qsort(names, num_names, sizeof(char *), compare_names);
+  for (i = 0; i < num_names; i++) {
+    sub_path = malloc(strlen(path) + strlen(names[i]) + 2);
+    sprintf(sub_path, "%s/%s", path, names[i]);
+    add_path(sub_dir, sub_path, names[i]);
+    free(sub_path);
+    free(names[i]);
+  }
+  free(names);
+}
+
+static void swap32(unsigned int *value) {
+  unsigned int v = *value;
+  *value = (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+static void swap16(short *value) {
+  unsigned short v = *value;
+  *value = (short)((v >> 8) | (v << 8));
+}
+
+/**
+ * convert the block headers and directory blocks to big-endian
+ */
+static void swap_image(void) {
+  int i = 0;
+  int j;
+  int type;
+  int slots;
+
+  while (i < num_blocks) {
+    type = blocks[i].block_type;
+    slots = (type == MFS_BLOCK_TYPE_EXTENT) ? (blocks[i].block_size +
+      sizeof(struct mfs_file_block) - 1) / sizeof(struct mfs_file_block) : 0;
+    if (type == MFS_BLOCK_TYPE_DIR) {
+      for (j = 0; j < MFS_MAX_LOCAL_ENT; j++)
+        swap32(&blocks[i].u.dir_data.dir_ent[j].index);
+      swap16(&blocks[i].u.dir_data.num_entries);
+      swap16(&blocks[i].u.dir_data.num_deleted);
+    }
+    swap32(&blocks[i].block_size);
+    swap32(&blocks[i].block_type);
+    swap32(&blocks[i].next_block);
+    swap32(&blocks[i].prev_block);
+    swap32(&blocks[i].index);
+    i += 1 + slots;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const char *base;
+  FILE *out;
+  int big_endian = 0;
+  int arg = 1;
+
+  if (arg < argc && !strcmp(argv[arg], "-b")) {
+    big_endian = 1;
+    arg++;
+  }
+  if (argc - arg < 2) {
+    fprintf(stderr, "Usage: mfsromgen [-b] image.mfs file_or_dir ...\n");
+    return 1;
+  }
+
+  /* block 0 is the root directory, its own parent */
+  new_dir(0);
+  for (arg++; arg < argc; arg++) {
+    base = strrchr(argv[arg], '/');
+    add_path(0, argv[arg], base ? base + 1 : argv[arg]);
+  }
+
+  printf("MFS block usage (used / free / total) = %d / 0 / %d\n", num_blocks, num_blocks);
+  printf("Size of memory is %lu bytes\n",
+         (unsigned long)(4 + num_blocks * sizeof(struct mfs_file_block)));
+  printf("Block size is %lu\n", (unsigned long)sizeof(struct mfs_file_block));
+
+  if (big_endian)
+    swap_image();
+  out = fopen(argv[big_endian ? 2 : 1], "wb");
+  if (out == NULL ||
+      fwrite(MFS_IMAGE_MAGIC_EXTENT, 1, 4, out) != 4 ||
+      fwrite(blocks, sizeof(struct mfs_file_block), num_blocks, out) != (size_t)num_blocks ||
+      fclose(out) != 0) {
+    fprintf(stderr, "mfsromgen: cannot write %s\n", argv[big_endian ? 2 : 1]);
+    return 1;
+  }
+  return 0;
+}
@@ -26,11 +26,119 @@
 *
 ******************************************************************************/
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "xilmfs.h"
 
 struct mfs_file_block efs[200];
 
+/**
+ * host benchmark of seeks and name lookups in a large file system
+ * run with "test_mfs_filesys bench [file_mb] [num_files]", build with
+ * -DMFS_SEEK_INDEX_ENTRIES=0 -DMFS_DIR_HASH_SIZE=0 to compare with the
+ * seek index and the directory hash index disabled
+ */
+static double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void bench_report(const char *name, double t0, int ops) {
+  printf("%-28s %8d ops %12.3f us/op\n", name, ops, (bench_now() - t0) / ops);
+}
+
+static int bench(int file_mb, int num_files) {
+  int num_blocks = file_mb * 2 * 1024 * 1024 / MFS_BLOCK_DATA_SIZE + num_files * 2 + 1024;
+  char *fs_mem = malloc(num_blocks * sizeof(struct mfs_file_block));
+  long file_size = (long)file_mb * 1024 * 1024;
+  char buf[4096];
+  char name[MFS_MAX_FILENAME_LENGTH];
+  long pos;
+  double t0;
+  int ops = 20000;
+  int fd;
+  int fd2;
+  int i;
+
+  if (fs_mem == NULL)
+    return 1;
+  memset(buf, 'x', sizeof(buf));
+  mfs_init_fs(num_blocks * sizeof(struct mfs_file_block), fs_mem, MFSINIT_NEW);
+  printf("MFS bench: %d MB file, %d files in one dir, seek index %d extents, dir index %d slots\n\n",
+         file_mb, num_files, MFS_SEEK_INDEX_ENTRIES, MFS_DIR_HASH_SIZE);
+
+  /* one contiguous file and one with interleaved (fragmented) blocks */
+  t0 = bench_now();
+  fd = mfs_file_open("big.bin", MFS_MODE_CREATE);
+  for (pos = 0; pos < file_size; pos += sizeof(buf))
+    mfs_file_write(fd, buf, sizeof(buf));
+  mfs_file_close(fd);
+  bench_report("write contiguous 4K", t0, file_size / sizeof(buf));
+  fd = mfs_file_open("frag.bin", MFS_MODE_CREATE);
+  fd2 = mfs_file_open("frag2.bin", MFS_MODE_CREATE);
+  for (pos = 0; pos < file_size / 4; pos += MFS_BLOCK_DATA_SIZE) {
+    mfs_file_write(fd, buf, MFS_BLOCK_DATA_SIZE);
+    mfs_file_write(fd2, buf, MFS_BLOCK_DATA_SIZE);
+  }
+  mfs_file_close(fd);
+  mfs_file_close(fd2);
+
+  srand(1);
+  fd = mfs_file_open("big.bin", MFS_MODE_READ);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++) {
+    mfs_file_lseek(fd, ((long)rand() * 64) % file_size, MFS_SEEK_SET);
+    mfs_file_read(fd, buf, 64);
+  }
+  bench_report("seek set + read 64", t0, ops);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++)
+    mfs_file_lseek(fd, 0, MFS_SEEK_CUR);
+  bench_report("seek cur (tell)", t0, ops);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++)
+    mfs_file_lseek(fd, -1 - (rand() % 4096), MFS_SEEK_END);
+  bench_report("seek end - 4K", t0, ops);
+  mfs_file_close(fd);
+
+  fd = mfs_file_open("frag.bin", MFS_MODE_READ);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++)
+    mfs_file_lseek(fd, ((long)rand() * 64) % (file_size / 4), MFS_SEEK_SET);
+  bench_report("seek set fragmented", t0, ops);
+  mfs_file_close(fd);
+
+  mfs_create_dir("dir");
+  mfs_change_dir("dir");
+  t0 = bench_now();
+  for (i = 0; i < num_files; i++) {
+    sprintf(name, "file%d", i);
+    mfs_file_close(mfs_file_open(name, MFS_MODE_CREATE));
+  }
+  bench_report("create in dir", t0, num_files);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++) {
+    sprintf(name, "file%d", rand() % num_files);
+    fd = mfs_file_open(name, MFS_MODE_READ);
+    if (fd < 0)
+      return 1;
+    mfs_file_close(fd);
+  }
+  bench_report("open + close", t0, ops);
+  t0 = bench_now();
+  for (i = 0; i < ops; i++) {
+    sprintf(name, "/dir/file%d", rand() % num_files);
+    mfs_exists_file(name);
+  }
+  bench_report("exists (absolute path)", t0, ops);
+  mfs_change_dir("/");
+
+  free(fs_mem);
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
   char buf[512];
   char buf2[512];
@@ -38,6 +146,8 @@ int main(int argc, char *argv[]) {
   int fdw;
   int tmp;
   int num_iter;
+  if (argc > 1 && !strcmp(argv[1], "bench"))
+    return bench(argc > 2 ? atoi(argv[2]) : 32, argc > 3 ? atoi(argv[3]) : 2000);
   mfs_init_fs(20*sizeof(struct mfs_file_block), (char *)efs, MFSINIT_NEW);
   fdr = mfs_file_open(".", MFS_MODE_READ);
   tmp = mfs_file_read(fdr, &(buf[0]), 512);
@@ -39,10 +39,23 @@ extern "C" {
 #define MFS_BLOCK_DATA_SIZE 512
 #define MFS_MAX_LOCAL_ENT 16
 /* block type definitions */
+#define MFS_BLOCK_TYPE_EXTENT 3
 #define MFS_BLOCK_TYPE_DIR 2
 #define MFS_BLOCK_TYPE_FILE 1
 #define MFS_BLOCK_TYPE_EMPTY 0
 
+/**
+ * MFS_BLOCK_TYPE_EXTENT is the first block of a file stored contiguously
+ * in a ROM image: its block_size is the file size and the data follows the
+ * block without block headers, in the next
+ * (block_size + sizeof(struct mfs_file_block) - 1) / sizeof(struct mfs_file_block)
+ * block slots. Such files are read only and are reported as
+ * MFS_BLOCK_TYPE_FILE by mfs_dir_read.
+ * Images with extent files start with MFS_IMAGE_MAGIC_EXTENT and are
+ * always initialized as MFSINIT_ROM_IMAGE by mfs_init_genimage.
+ */
+#define MFS_IMAGE_MAGIC_EXTENT "MFSC"
+
 /* MFS_MAX_FILENAME_LENGTH determines the size of mfs_dir_ent_block - see below */
 
 #define MFS_MAX_FILENAME_LENGTH 23
@@ -102,11 +115,52 @@ struct mfs_file_block {
 /* MFS_MODE_CREATE creates a new file and opens it with MFS_MODE_WRITE */
 #define MFS_MODE_CREATE 3
 #define MFS_MODE_FREE 8
+
+/**
+ * MFS_SEEK_INDEX_ENTRIES is the number of extents (runs of consecutive
+ * blocks) in the seek index of each open file. The index is filled while
+ * the file is read, written or seeked and lets mfs_file_lseek find a block
+ * without following the next_block chain. Files written in one go and
+ * mfsgen images are a single extent.
+ * 0 disables the index.
+ */
+#ifndef MFS_SEEK_INDEX_ENTRIES
+#define MFS_SEEK_INDEX_ENTRIES 16
+#endif
+
+/**
+ * MFS_DIR_HASH_SIZE is the number of slots (a power of 2) of the hash index
+ * of directory entries, which is filled with all entries of a directory
+ * when a name is first looked up in it. Lookups of existing names in an
+ * indexed directory do not scan the directory blocks. A directory is
+ * indexed if its entries fit in 3/4 of the slots.
+ * 0 disables the index and every lookup scans the directory blocks.
+ */
+#ifndef MFS_DIR_HASH_SIZE
+#define MFS_DIR_HASH_SIZE 512
+#endif
+
+/**
+ * an extent of the seek index: file block number first (counted from 0)
+ * is stored in block, the following file blocks up to the first of the
+ * next extent are stored in the blocks that follow it
+ */
+struct mfs_seek_extent {
+  unsigned int first; /* number of the first file block of the extent */
+  unsigned int block; /* index of that block in the file system */
+};
+
 struct mfs_open_file_struct {
   unsigned int first_block; /* first block of file */
   unsigned int current_block; /* currently accessed block */
   unsigned short offset; /* current offset within block */
   unsigned short mode ; /* read or write */
+  unsigned int block_num; /* number of current_block within the file */
+#if MFS_SEEK_INDEX_ENTRIES > 0
+  unsigned int num_mapped; /* file blocks 0 .. num_mapped-1 are indexed */
+  unsigned int num_extents; /* extents used in seek_index */
+  struct mfs_seek_extent seek_index[MFS_SEEK_INDEX_ENTRIES];
+#endif
 } ;
 
 /* number of mfs_file_blocks that can fit in the memory reserved for the file system */
@@ -145,7 +199,8 @@ extern int mfs_num_open_files; /* the number of open_files */
 void mfs_init_fs(int numbytes, char *address, int init_type) ;
 
 /**
- * initialize the file system with a file image generated by mfsgen;
+ * initialize the file system with a file image generated by mfsgen or by
+ * mfsromgen (see utils);
  * this function must be called before any file system operations
  * use mfs_init_fs instead of this function for other initialization
  * @param numbytes is the number of bytes allocated or reserved for this file sy
@@ -155,6 +210,7 @@ stem
  * @param init_type is one of
  * MFSINIT_IMAGE for creating read/write filesystem with predefined data
  * MFSINIT_ROM_IMAGE for creating read-only filesystem with predefined data
+ * images with contiguous files (MFS_IMAGE_MAGIC_EXTENT) are always read-only
  */
 void mfs_init_genimage(int numbytes, char *address, int init_type) ;
 
@@ -279,6 +335,20 @@ int mfs_file_open(const char *filename, int mode) ;
 */
 int mfs_file_read(int fd, char *buf, int buflen) ;
 
+/**
+ * read characters from a file without copying them
+ * @param fd is a descriptor for the file from which the characters are read
+ * @param data is set to point to the characters within the file system
+ * @param maxlen is the maximum number of characters to read
+ * fd should be a valid index in mfs_open_files array
+ * Works only if fd points to a file and not a dir
+ * the characters are contiguous in memory: for a contiguous file of a ROM
+ * image this is the rest of the file, otherwise the rest of the current block
+ * the file position moves past the characters as with mfs_file_read
+ * @return num chars at data or 0 at end of file or for error
+*/
+int mfs_file_read_ptr(int fd, const char **data, int maxlen) ;
+
 /**
  * write characters to a file
  * @param fd is a descriptor for the file to which the characters are written